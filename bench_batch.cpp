@@ -0,0 +1,92 @@
+// bench_batch.cpp - Streaming batch serialization vs one string per element
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "meta.h"
+#include "meta_csv.h"
+
+struct Row
+{
+    int id;
+    std::string account;
+    double amount;
+    bool settled;
+    int region;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Row::id>("id"),
+        meta::field<&Row::account>("account"),
+        meta::field<&Row::amount>("amount"),
+        meta::field<&Row::settled>("settled"),
+        meta::field<&Row::region>("region"));
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+// What serializeJson / toCSVWithHeader used to do
+std::string perElementJson(const std::vector<Row>& rows)
+{
+    std::stringstream os;
+    os << "[\n";
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        os << "  " << meta::toJson(rows[i]);
+        if (i < rows.size() - 1)
+            os << ",";
+        os << "\n";
+    }
+    os << "]\n";
+    return os.str();
+}
+
+std::string perElementCSV(const std::vector<Row>& rows)
+{
+    std::ostringstream oss;
+    oss << meta::toCSVHeader<Row>() << "\n";
+    for (const auto& row : rows)
+        oss << meta::toCSV(row) << "\n";
+    return oss.str();
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 500000;
+
+    std::vector<Row> rows;
+    rows.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int n = static_cast<int>(i);
+        rows.push_back({n, "acct-" + std::to_string(n % 9973), n * 0.01, n % 4 == 0, n % 12});
+    }
+
+    size_t bytes = 0;
+    double jsonOld = bestSeconds(3, [&] { bytes += perElementJson(rows).size(); });
+    double jsonNew = bestSeconds(3, [&] { bytes += meta::serializeJson(rows).size(); });
+    double csvOld = bestSeconds(3, [&] { bytes += perElementCSV(rows).size(); });
+    double csvNew = bestSeconds(3, [&] { bytes += meta::toCSVWithHeader(rows).size(); });
+
+    std::printf("payload: %zu rows\n\n", count);
+    std::printf("%-32s %10.4f s\n", "JSON, string per element", jsonOld);
+    std::printf("%-32s %10.4f s  (%.2fx)\n", "serializeJson (streamed)", jsonNew, jsonOld / jsonNew);
+    std::printf("%-32s %10.4f s\n", "CSV, string per row", csvOld);
+    std::printf("%-32s %10.4f s  (%.2fx)\n", "toCSVWithHeader (streamed)", csvNew, csvOld / csvNew);
+    std::printf("\n(bytes %zu)\n", bytes);
+    return 0;
+}
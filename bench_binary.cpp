@@ -0,0 +1,122 @@
+// bench_binary.cpp - toBinary / fromBinary and toProto / fromProto against toJson / fromJson
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "meta_binary.h"
+#include "meta_json.h"
+#include "meta_proto.h"
+
+struct Tick
+{
+    int instrument_id;
+    double bid_price;
+    double ask_price;
+    int bid_size;
+    int ask_size;
+    bool is_snapshot;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Tick::instrument_id>("instrument_id"),
+        meta::field<&Tick::bid_price>("bid_price"),
+        meta::field<&Tick::ask_price>("ask_price"),
+        meta::field<&Tick::bid_size>("bid_size"),
+        meta::field<&Tick::ask_size>("ask_size"),
+        meta::field<&Tick::is_snapshot>("is_snapshot"));
+};
+
+struct Order
+{
+    int64_t id;
+    std::string customer;
+    std::vector<int> quantities;
+    std::optional<std::string> note;
+    std::map<std::string, double> fees;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Order::id>("id"),
+        meta::field<&Order::customer>("customer"),
+        meta::field<&Order::quantities>("quantities"),
+        meta::field<&Order::note>("note"),
+        meta::field<&Order::fees>("fees"));
+};
+
+// Protobuf messages are structs, so the rows travel as `repeated T rows = 1`
+template <typename T>
+struct Batch
+{
+    std::vector<T> rows;
+
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&Batch::rows>("rows"));
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+template <typename T>
+void compare(const char* name, const std::vector<T>& rows)
+{
+    std::string json, binary, proto;
+    const Batch<T> batch{rows};
+    double toJsonSec = bestSeconds(5, [&] { json = meta::toJson(rows); });
+    double toBinarySec = bestSeconds(5, [&] { binary = meta::toBinary(rows); });
+    double toProtoSec = bestSeconds(5, [&] { proto = meta::toProto(batch); });
+
+    size_t n = 0;
+    double fromJsonSec = bestSeconds(5, [&] { n = meta::fromJson<std::vector<T>>(json).first->size(); });
+    double fromBinarySec = bestSeconds(5, [&] { n = meta::fromBinary<std::vector<T>>(binary).first->size(); });
+    if (n != rows.size())
+        std::printf("size mismatch\n");
+    double fromProtoSec = bestSeconds(5, [&] { n = meta::fromProto<Batch<T>>(proto).first->rows.size(); });
+    if (n != rows.size())
+        std::printf("size mismatch\n");
+
+    double count = static_cast<double>(rows.size());
+    std::printf("%s: %zu records\n", name, rows.size());
+    std::printf("  %-12s %10s %14s %14s\n", "", "bytes", "write ns/rec", "read ns/rec");
+    std::printf("  %-12s %10zu %14.1f %14.1f\n", "json", json.size(), toJsonSec * 1e9 / count,
+                fromJsonSec * 1e9 / count);
+    std::printf("  %-12s %10zu %14.1f %14.1f\n", "binary", binary.size(), toBinarySec * 1e9 / count,
+                fromBinarySec * 1e9 / count);
+    std::printf("  %-12s %10zu %14.1f %14.1f\n", "proto", proto.size(), toProtoSec * 1e9 / count,
+                fromProtoSec * 1e9 / count);
+    std::printf("  %-12s %9.1fx %13.1fx %13.1fx\n\n", "binary gain",
+                static_cast<double>(json.size()) / static_cast<double>(binary.size()), toJsonSec / toBinarySec,
+                fromJsonSec / fromBinarySec);
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 200000;
+
+    std::vector<Tick> ticks;
+    std::vector<Order> orders;
+    ticks.reserve(count);
+    orders.reserve(count / 4);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int n = static_cast<int>(i);
+        ticks.push_back({n % 1000, 100.0 + n % 97 * 0.25, 100.5 + n % 89 * 0.25, n % 500, n % 700, i % 100 == 0});
+        if (i % 4 == 0)
+            orders.push_back({static_cast<int64_t>(i) * 1000003, "customer-" + std::to_string(i % 977),
+                              {n % 7, n % 11, n % 13}, i % 3 ? std::nullopt : std::optional<std::string>("rush"),
+                              {{"shipping", 4.5}, {"tax", n % 50 * 0.1}}});
+    }
+
+    compare("Tick", ticks);
+    compare("Order", orders);
+    return 0;
+}
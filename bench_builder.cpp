@@ -0,0 +1,132 @@
+// bench_builder.cpp - Static (templated) vs virtual Builder dispatch on nested structs
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "meta.h"
+
+struct Address
+{
+    std::string city;
+    int zip;
+    std::pair<double, double> location;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Address::city>("city"),
+        meta::field<&Address::zip>("zip"),
+        meta::field<&Address::location>("location"));
+};
+
+struct Customer
+{
+    int id;
+    std::string name;
+    Address address;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Customer::id>("id"),
+        meta::field<&Customer::name>("name"),
+        meta::field<&Customer::address>("address"));
+};
+
+struct Line
+{
+    int sku;
+    int quantity;
+    double price;
+    bool backordered;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Line::sku>("sku"),
+        meta::field<&Line::quantity>("quantity"),
+        meta::field<&Line::price>("price"),
+        meta::field<&Line::backordered>("backordered"));
+};
+
+struct Order
+{
+    int id;
+    Customer customer;
+    std::vector<Line> lines;
+    std::optional<std::string> note;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Order::id>("id"),
+        meta::field<&Order::customer>("customer"),
+        meta::field<&Order::lines>("lines"),
+        meta::field<&Order::note>("note"));
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+// Picked at run time, so the compiler cannot see through the vtable
+std::unique_ptr<meta::Builder> makeBuilder(const std::string& format)
+{
+    if (format == "xml")
+        return std::make_unique<meta::XmlBuilder>();
+    return std::make_unique<meta::JsonBuilder>();
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 20000;
+
+    std::vector<Order> orders;
+    orders.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int n = static_cast<int>(i);
+        Order order{n, {n % 500, "customer-" + std::to_string(n % 500), {"city-" + std::to_string(n % 40), 10000 + n % 90000, {n * 0.01, -n * 0.02}}}, {}, std::nullopt};
+        for (int j = 0; j < 4; ++j)
+            order.lines.push_back({n * 4 + j, 1 + j, 9.99 + j, j == 3});
+        if (i % 5 == 0)
+            order.note = "gift wrap";
+        orders.push_back(std::move(order));
+    }
+
+    size_t bytes = 0;
+    auto run = [&](const char* label, int runs, auto&& serialize)
+    {
+        double best = bestSeconds(runs, [&] { bytes += serialize().size(); });
+        return std::make_pair(label, best);
+    };
+
+    std::vector<std::pair<const char*, double>> results;
+    results.push_back(run("toJson (static)", 5, [&] { return meta::toJson(orders); }));
+    results.push_back(run("JSON via Builder*", 5, [&]
+    {
+        auto builder = makeBuilder(argc > 2 ? argv[2] : "json");
+        meta::to(orders, builder.get());
+        return builder->result();
+    }));
+    results.push_back(run("toXml (static)", 5, [&] { return meta::toXml(orders); }));
+    results.push_back(run("XML via Builder*", 5, [&]
+    {
+        auto builder = makeBuilder(argc > 2 ? argv[2] : "xml");
+        meta::to(orders, builder.get());
+        return builder->result();
+    }));
+
+    std::printf("payload: %zu orders, %.2f MB JSON\n\n", count,
+                static_cast<double>(meta::toJson(orders).size()) / (1024.0 * 1024.0));
+    for (auto& [label, seconds] : results)
+        std::printf("%-28s %10.4f s\n", label, seconds);
+    std::printf("\nJSON speedup: %.2fx  XML speedup: %.2fx  (bytes %zu)\n",
+                results[1].second / results[0].second, results[3].second / results[2].second, bytes);
+    return 0;
+}
@@ -0,0 +1,85 @@
+// bench_csv.cpp - CSV export (serialize, toCSVWithHeader) and parseCSV, next to JSON for the same records
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "meta_csv.h"
+#include "meta_json.h"
+
+struct Row
+{
+    int id;
+    std::string account;
+    double amount;
+    bool settled;
+    std::string memo;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Row::id>("id"),
+        meta::field<&Row::account>("account"),
+        meta::field<&Row::amount>("amount"),
+        meta::field<&Row::settled>("settled"),
+        meta::field<&Row::memo>("memo"));
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    std::vector<Row> rows;
+    rows.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int n = static_cast<int>(i);
+        rows.push_back({n, "acct-" + std::to_string(n % 9973), n * 0.25, n % 4 == 0,
+                        n % 10 ? "settled by wire transfer" : "refund, partial"});
+    }
+    const std::string csv = meta::toCSVWithHeader(rows);
+    const std::string json = meta::serializeJson(rows);
+
+    size_t written = 0;
+    double serializeTime = bestSeconds(3, [&] { written += meta::serialize(rows).size(); });
+    double withHeaderTime = bestSeconds(3, [&] { written += meta::toCSVWithHeader(rows).size(); });
+    double jsonWrite = bestSeconds(3, [&] { written += meta::serializeJson(rows).size(); });
+
+    size_t parsed = 0;
+    double csvString = bestSeconds(3, [&] { parsed += meta::parseCSV<Row>(csv).first.size(); });
+    double csvStream = bestSeconds(3, [&]
+    {
+        std::istringstream in(csv);
+        parsed += meta::parseCSV<Row>(in).first.size();
+    });
+    double jsonRead = bestSeconds(3, [&] { parsed += meta::fromJson<std::vector<Row>>(json).first->size(); });
+
+    auto report = [&](const char* name, double seconds, size_t bytes)
+    {
+        std::printf("%-22s %10.3f %10.1f %12.0f\n", name, seconds * 1e3, bytes / seconds / 1e6, count / seconds);
+    };
+    std::printf("payload: %zu rows, CSV %zu bytes, JSON %zu bytes\n\n", count, csv.size(), json.size());
+    std::printf("%-22s %10s %10s %12s\n", "writer", "ms", "MB/s", "rows/s");
+    report("serialize", serializeTime, csv.size());
+    report("toCSVWithHeader", withHeaderTime, csv.size());
+    report("serializeJson", jsonWrite, json.size());
+    std::printf("\n%-22s %10s %10s %12s\n", "reader", "ms", "MB/s", "rows/s");
+    report("parseCSV(string_view)", csvString, csv.size());
+    report("parseCSV(istream)", csvStream, csv.size());
+    report("fromJson (same rows)", jsonRead, json.size());
+    return parsed == 0 || written == 0;
+}
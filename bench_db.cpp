@@ -0,0 +1,180 @@
+// bench_db.cpp - Bulk loads (insertSQL, prepared statements, batches, COPY) and reading results back with mapRows
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "meta_db.h"
+
+struct Trade
+{
+    int64_t id;
+    std::string symbol;
+    double price;
+    int quantity;
+    bool buy;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Trade::id>("id"),
+        meta::field<&Trade::symbol>("symbol"),
+        meta::field<&Trade::price>("price"),
+        meta::field<&Trade::quantity>("quantity"),
+        meta::field<&Trade::buy>("buy"));
+};
+
+template <> struct meta::MetaTuple<Trade>
+{
+    static constexpr auto& FieldsMeta = Trade::FieldsMeta;
+    static constexpr auto tableName = "trades";
+};
+
+// Stands in for a driver's bind calls: keeps a running checksum
+struct ChecksumBinder
+{
+    uint64_t sum = 0;
+    void bindNull(int i) { sum += static_cast<uint64_t>(i); }
+    void bindInt(int i, int64_t v) { sum += static_cast<uint64_t>(i) ^ static_cast<uint64_t>(v); }
+    void bindDouble(int i, double v) { sum += static_cast<uint64_t>(i) + static_cast<uint64_t>(v); }
+    void bindText(int i, std::string_view v) { sum += static_cast<uint64_t>(i) + v.size(); }
+};
+
+// Typed cells, as a binary-protocol driver hands them out
+class TradeResult
+{
+    const std::vector<Trade>& trades;
+    size_t current = size_t(-1);
+
+  public:
+    explicit TradeResult(const std::vector<Trade>& trades) : trades(trades) {}
+
+    int columnCount() const { return 5; }
+    std::string_view columnName(int c) const
+    {
+        static constexpr std::string_view names[] = {"id", "symbol", "price", "quantity", "buy"};
+        return names[c];
+    }
+    bool next() { return ++current < trades.size(); }
+    size_t rowCount() const { return trades.size(); }
+    bool isNull(int) const { return false; }
+    int64_t getInt(int c) const
+    {
+        const Trade& t = trades[current];
+        return c == 0 ? t.id : c == 3 ? t.quantity : t.buy;
+    }
+    double getDouble(int) const { return trades[current].price; }
+    std::string_view getText(int) const { return trades[current].symbol; }
+
+    // What reading every cell as a string costs
+    std::string cellString(int c) const
+    {
+        return c == 1 ? trades[current].symbol : c == 2 ? std::to_string(getDouble(c)) : std::to_string(getInt(c));
+    }
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    std::vector<Trade> trades;
+    trades.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        trades.push_back({static_cast<int64_t>(i), "SYM" + std::to_string(i % 500), 100.0 + i % 977 * 0.25,
+                          static_cast<int>(i % 1000), i % 2 == 0});
+
+    size_t bytes = 0;
+    double literal = bestSeconds(3, [&]
+    {
+        for (const Trade& t : trades)
+            bytes += meta::insertSQL(t).size();
+    });
+
+    uint64_t checksum = 0;
+    double prepared = bestSeconds(3, [&]
+    {
+        ChecksumBinder binder;
+        for (const Trade& t : trades)
+        {
+            bytes += meta::insertStatement<Trade>().size();
+            meta::bindFields(t, binder);
+        }
+        checksum += binder.sum;
+    });
+
+    double batched = bestSeconds(3, [&]
+    {
+        ChecksumBinder binder;
+        meta::insertBatch(trades, [&](std::string_view sql, auto&& bind)
+        {
+            bytes += sql.size();
+            bind(binder);
+        }, {.rowsPerStatement = 500});
+        checksum += binder.sum;
+    });
+
+    size_t copyText = 0, copyBinary = 0;
+    auto copyTo = [&](meta::CopyFormat format, size_t& total)
+    {
+        return bestSeconds(3, [&]
+        {
+            total = 0;
+            meta::CallbackSink sink([&](std::string_view block) { total += block.size(); });
+            meta::writeCopy(trades, sink, format);
+        });
+    };
+    double textCopy = copyTo(meta::CopyFormat::Text, copyText);
+    double binaryCopy = copyTo(meta::CopyFormat::Binary, copyBinary);
+    bytes += copyText + copyBinary;
+
+    size_t mapped = 0;
+    double viaStrings = bestSeconds(3, [&]
+    {
+        TradeResult result(trades);
+        std::vector<Trade> out;
+        out.reserve(result.rowCount());
+        while (result.next())
+        {
+            Trade t;
+            t.id = std::stoll(result.cellString(0));
+            t.symbol = result.cellString(1);
+            t.price = std::stod(result.cellString(2));
+            t.quantity = std::stoi(result.cellString(3));
+            t.buy = result.cellString(4) == "1";
+            out.push_back(std::move(t));
+        }
+        mapped += out.size();
+    });
+    double viaMapRows = bestSeconds(3, [&]
+    {
+        TradeResult result(trades);
+        mapped += meta::mapRows<Trade>(result).first.size();
+    });
+
+    std::printf("payload: %zu rows, 5 columns\n\n", count);
+    std::printf("%-32s %10s %12s %12s\n", "generator", "ms", "rows/s", "statements");
+    std::printf("%-32s %10.1f %12.0f %12zu\n", "insertSQL (literal SQL per row)", literal * 1e3, count / literal, count);
+    std::printf("%-32s %10.1f %12.0f %12zu\n", "insertStatement + bindFields", prepared * 1e3, count / prepared, count);
+    std::printf("%-32s %10.1f %12.0f %12zu\n", "insertBatch (500 rows)", batched * 1e3, count / batched,
+                (count + 499) / 500);
+    std::printf("\n%-32s %10s %12s %12s\n", "COPY stream", "ms", "rows/s", "MB");
+    std::printf("%-32s %10.1f %12.0f %12.1f\n", "text", textCopy * 1e3, count / textCopy, copyText / 1e6);
+    std::printf("%-32s %10.1f %12.0f %12.1f\n", "binary", binaryCopy * 1e3, count / binaryCopy, copyBinary / 1e6);
+    std::printf("\n%-32s %10s %12s\n", "result reader", "ms", "rows/s");
+    std::printf("%-32s %10.1f %12.0f\n", "string per cell", viaStrings * 1e3, count / viaStrings);
+    std::printf("%-32s %10.1f %12.0f\n", "mapRows", viaMapRows * 1e3, count / viaMapRows);
+    return bytes == 0 || checksum == 0 || mapped == 0;
+}
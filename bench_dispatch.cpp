@@ -0,0 +1,281 @@
+// bench_dispatch.cpp - Default field lookup vs KeyDispatch on a 64-field struct
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "meta.h"
+#include "meta_json.h"
+
+struct Telemetry
+{
+    int cpu_user;
+    double cpu_system;
+    int cpu_idle;
+    int cpu_iowait;
+    double cpu_steal;
+    int load_1m;
+    int load_5m;
+    double load_15m;
+    int mem_total;
+    int mem_free;
+    double mem_cached;
+    int mem_buffers;
+    int swap_total;
+    double swap_free;
+    int disk_read_bytes;
+    int disk_write_bytes;
+    double disk_read_ops;
+    int disk_write_ops;
+    int disk_queue;
+    double net_rx_bytes;
+    int net_tx_bytes;
+    int net_rx_packets;
+    double net_tx_packets;
+    int net_rx_errors;
+    int net_tx_errors;
+    double net_drops;
+    int tcp_established;
+    int tcp_time_wait;
+    double tcp_retransmits;
+    int udp_in;
+    int udp_out;
+    double open_files;
+    int threads;
+    int processes;
+    double context_switches;
+    int interrupts;
+    int uptime_seconds;
+    double boot_time;
+    int temperature_cpu;
+    int temperature_gpu;
+    double fan_rpm;
+    int power_watts;
+    int voltage_core;
+    double gpu_util;
+    int gpu_mem_used;
+    int gpu_mem_total;
+    double http_requests;
+    int http_errors_4xx;
+    int http_errors_5xx;
+    double http_latency_p50;
+    int http_latency_p90;
+    int http_latency_p99;
+    double db_connections;
+    int db_queries;
+    int db_slow_queries;
+    double cache_hits;
+    int cache_misses;
+    int queue_depth;
+    double queue_lag;
+    int gc_pauses;
+    int gc_time_ms;
+    double heap_used;
+    int heap_committed;
+    std::string hostname;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Telemetry::cpu_user>("cpu_user"),
+        meta::field<&Telemetry::cpu_system>("cpu_system"),
+        meta::field<&Telemetry::cpu_idle>("cpu_idle"),
+        meta::field<&Telemetry::cpu_iowait>("cpu_iowait"),
+        meta::field<&Telemetry::cpu_steal>("cpu_steal"),
+        meta::field<&Telemetry::load_1m>("load_1m"),
+        meta::field<&Telemetry::load_5m>("load_5m"),
+        meta::field<&Telemetry::load_15m>("load_15m"),
+        meta::field<&Telemetry::mem_total>("mem_total"),
+        meta::field<&Telemetry::mem_free>("mem_free"),
+        meta::field<&Telemetry::mem_cached>("mem_cached"),
+        meta::field<&Telemetry::mem_buffers>("mem_buffers"),
+        meta::field<&Telemetry::swap_total>("swap_total"),
+        meta::field<&Telemetry::swap_free>("swap_free"),
+        meta::field<&Telemetry::disk_read_bytes>("disk_read_bytes"),
+        meta::field<&Telemetry::disk_write_bytes>("disk_write_bytes"),
+        meta::field<&Telemetry::disk_read_ops>("disk_read_ops"),
+        meta::field<&Telemetry::disk_write_ops>("disk_write_ops"),
+        meta::field<&Telemetry::disk_queue>("disk_queue"),
+        meta::field<&Telemetry::net_rx_bytes>("net_rx_bytes"),
+        meta::field<&Telemetry::net_tx_bytes>("net_tx_bytes"),
+        meta::field<&Telemetry::net_rx_packets>("net_rx_packets"),
+        meta::field<&Telemetry::net_tx_packets>("net_tx_packets"),
+        meta::field<&Telemetry::net_rx_errors>("net_rx_errors"),
+        meta::field<&Telemetry::net_tx_errors>("net_tx_errors"),
+        meta::field<&Telemetry::net_drops>("net_drops"),
+        meta::field<&Telemetry::tcp_established>("tcp_established"),
+        meta::field<&Telemetry::tcp_time_wait>("tcp_time_wait"),
+        meta::field<&Telemetry::tcp_retransmits>("tcp_retransmits"),
+        meta::field<&Telemetry::udp_in>("udp_in"),
+        meta::field<&Telemetry::udp_out>("udp_out"),
+        meta::field<&Telemetry::open_files>("open_files"),
+        meta::field<&Telemetry::threads>("threads"),
+        meta::field<&Telemetry::processes>("processes"),
+        meta::field<&Telemetry::context_switches>("context_switches"),
+        meta::field<&Telemetry::interrupts>("interrupts"),
+        meta::field<&Telemetry::uptime_seconds>("uptime_seconds"),
+        meta::field<&Telemetry::boot_time>("boot_time"),
+        meta::field<&Telemetry::temperature_cpu>("temperature_cpu"),
+        meta::field<&Telemetry::temperature_gpu>("temperature_gpu"),
+        meta::field<&Telemetry::fan_rpm>("fan_rpm"),
+        meta::field<&Telemetry::power_watts>("power_watts"),
+        meta::field<&Telemetry::voltage_core>("voltage_core"),
+        meta::field<&Telemetry::gpu_util>("gpu_util"),
+        meta::field<&Telemetry::gpu_mem_used>("gpu_mem_used"),
+        meta::field<&Telemetry::gpu_mem_total>("gpu_mem_total"),
+        meta::field<&Telemetry::http_requests>("http_requests"),
+        meta::field<&Telemetry::http_errors_4xx>("http_errors_4xx"),
+        meta::field<&Telemetry::http_errors_5xx>("http_errors_5xx"),
+        meta::field<&Telemetry::http_latency_p50>("http_latency_p50"),
+        meta::field<&Telemetry::http_latency_p90>("http_latency_p90"),
+        meta::field<&Telemetry::http_latency_p99>("http_latency_p99"),
+        meta::field<&Telemetry::db_connections>("db_connections"),
+        meta::field<&Telemetry::db_queries>("db_queries"),
+        meta::field<&Telemetry::db_slow_queries>("db_slow_queries"),
+        meta::field<&Telemetry::cache_hits>("cache_hits"),
+        meta::field<&Telemetry::cache_misses>("cache_misses"),
+        meta::field<&Telemetry::queue_depth>("queue_depth"),
+        meta::field<&Telemetry::queue_lag>("queue_lag"),
+        meta::field<&Telemetry::gc_pauses>("gc_pauses"),
+        meta::field<&Telemetry::gc_time_ms>("gc_time_ms"),
+        meta::field<&Telemetry::heap_used>("heap_used"),
+        meta::field<&Telemetry::heap_committed>("heap_committed"),
+        meta::field<&Telemetry::hostname>("hostname"));
+};
+
+struct DispatchedTelemetry : Telemetry
+{
+    using Deser = meta::KeyDispatch<DispatchedTelemetry>;
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+template <typename T>
+double timeJson(const meta::JsonDocument& doc, int runs, size_t& checksum)
+{
+    return bestSeconds(runs, [&]
+    {
+        auto [parsed, result] = meta::fromJson<std::vector<T>>(doc);
+        checksum += parsed ? parsed->size() : 0;
+    });
+}
+
+template <typename T>
+double timeYaml(const YAML::Node& doc, int runs, size_t& checksum)
+{
+    return bestSeconds(runs, [&]
+    {
+        auto [parsed, result] = meta::reifyFromYaml<std::vector<T>>(doc);
+        checksum += parsed ? parsed->size() : 0;
+    });
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 2000;
+
+    std::vector<Telemetry> records(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto& t = records[i];
+        t.cpu_user = static_cast<int>(i) + 0;
+        t.cpu_system = static_cast<double>(i) * 0.51;
+        t.cpu_idle = static_cast<int>(i) + 2;
+        t.cpu_iowait = static_cast<int>(i) + 3;
+        t.cpu_steal = static_cast<double>(i) * 0.54;
+        t.load_1m = static_cast<int>(i) + 5;
+        t.load_5m = static_cast<int>(i) + 6;
+        t.load_15m = static_cast<double>(i) * 0.57;
+        t.mem_total = static_cast<int>(i) + 8;
+        t.mem_free = static_cast<int>(i) + 9;
+        t.mem_cached = static_cast<double>(i) * 0.60;
+        t.mem_buffers = static_cast<int>(i) + 11;
+        t.swap_total = static_cast<int>(i) + 12;
+        t.swap_free = static_cast<double>(i) * 0.63;
+        t.disk_read_bytes = static_cast<int>(i) + 14;
+        t.disk_write_bytes = static_cast<int>(i) + 15;
+        t.disk_read_ops = static_cast<double>(i) * 0.66;
+        t.disk_write_ops = static_cast<int>(i) + 17;
+        t.disk_queue = static_cast<int>(i) + 18;
+        t.net_rx_bytes = static_cast<double>(i) * 0.69;
+        t.net_tx_bytes = static_cast<int>(i) + 20;
+        t.net_rx_packets = static_cast<int>(i) + 21;
+        t.net_tx_packets = static_cast<double>(i) * 0.72;
+        t.net_rx_errors = static_cast<int>(i) + 23;
+        t.net_tx_errors = static_cast<int>(i) + 24;
+        t.net_drops = static_cast<double>(i) * 0.75;
+        t.tcp_established = static_cast<int>(i) + 26;
+        t.tcp_time_wait = static_cast<int>(i) + 27;
+        t.tcp_retransmits = static_cast<double>(i) * 0.78;
+        t.udp_in = static_cast<int>(i) + 29;
+        t.udp_out = static_cast<int>(i) + 30;
+        t.open_files = static_cast<double>(i) * 0.81;
+        t.threads = static_cast<int>(i) + 32;
+        t.processes = static_cast<int>(i) + 33;
+        t.context_switches = static_cast<double>(i) * 0.84;
+        t.interrupts = static_cast<int>(i) + 35;
+        t.uptime_seconds = static_cast<int>(i) + 36;
+        t.boot_time = static_cast<double>(i) * 0.87;
+        t.temperature_cpu = static_cast<int>(i) + 38;
+        t.temperature_gpu = static_cast<int>(i) + 39;
+        t.fan_rpm = static_cast<double>(i) * 0.90;
+        t.power_watts = static_cast<int>(i) + 41;
+        t.voltage_core = static_cast<int>(i) + 42;
+        t.gpu_util = static_cast<double>(i) * 0.93;
+        t.gpu_mem_used = static_cast<int>(i) + 44;
+        t.gpu_mem_total = static_cast<int>(i) + 45;
+        t.http_requests = static_cast<double>(i) * 0.96;
+        t.http_errors_4xx = static_cast<int>(i) + 47;
+        t.http_errors_5xx = static_cast<int>(i) + 48;
+        t.http_latency_p50 = static_cast<double>(i) * 0.99;
+        t.http_latency_p90 = static_cast<int>(i) + 50;
+        t.http_latency_p99 = static_cast<int>(i) + 51;
+        t.db_connections = static_cast<double>(i) * 1.02;
+        t.db_queries = static_cast<int>(i) + 53;
+        t.db_slow_queries = static_cast<int>(i) + 54;
+        t.cache_hits = static_cast<double>(i) * 1.05;
+        t.cache_misses = static_cast<int>(i) + 56;
+        t.queue_depth = static_cast<int>(i) + 57;
+        t.queue_lag = static_cast<double>(i) * 1.08;
+        t.gc_pauses = static_cast<int>(i) + 59;
+        t.gc_time_ms = static_cast<int>(i) + 60;
+        t.heap_used = static_cast<double>(i) * 1.11;
+        t.heap_committed = static_cast<int>(i) + 62;
+        t.hostname = "node-" + std::to_string(i);
+    }
+
+    std::string json = meta::toJson(records);
+    meta::JsonDocument doc(json);
+    YAML::Node yaml = YAML::Load(json);
+    std::printf("payload: %zu records x 64 fields, %.2f MB\n\n", count,
+                static_cast<double>(json.size()) / (1024.0 * 1024.0));
+
+    size_t checksum = 0;
+    double jsonLookup = timeJson<Telemetry>(doc, 5, checksum);
+    double jsonDispatch = timeJson<DispatchedTelemetry>(doc, 5, checksum);
+    double yamlLookup = timeYaml<Telemetry>(yaml, 3, checksum);
+    double yamlDispatch = timeYaml<DispatchedTelemetry>(yaml, 3, checksum);
+
+    auto row = [&](const char* name, double s)
+    {
+        std::printf("%-28s %10.3f ms %12.0f objects/s\n", name, s * 1e3, static_cast<double>(count) / s);
+    };
+    row("json  field lookup", jsonLookup);
+    row("json  KeyDispatch", jsonDispatch);
+    row("yaml  field lookup", yamlLookup);
+    row("yaml  KeyDispatch", yamlDispatch);
+    std::printf("\nspeedup: json %.1fx, yaml %.1fx  (checksum %zu)\n", jsonLookup / jsonDispatch,
+                yamlLookup / yamlDispatch, checksum);
+    return 0;
+}
@@ -0,0 +1,122 @@
+// bench_enum.cpp - Enum name lookups: EnumTraitsAuto tables vs std::unordered_map
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "meta.h"
+
+enum class Country
+{
+    Argentina, Australia, Austria, Belgium, Brazil, Canada, Chile, China, Denmark, Egypt, Finland, France,
+    Germany, Greece, India, Ireland, Italy, Japan, Kenya, Mexico, Netherlands, Norway, Peru, Poland,
+    Portugal, Spain, Sweden, Switzerland, Turkey, Ukraine, UnitedKingdom, UnitedStates
+};
+
+constexpr std::array CountryMapping = std::array{
+    std::pair{Country::Argentina, "AR"}, std::pair{Country::Australia, "AU"}, std::pair{Country::Austria, "AT"},
+    std::pair{Country::Belgium, "BE"}, std::pair{Country::Brazil, "BR"}, std::pair{Country::Canada, "CA"},
+    std::pair{Country::Chile, "CL"}, std::pair{Country::China, "CN"}, std::pair{Country::Denmark, "DK"},
+    std::pair{Country::Egypt, "EG"}, std::pair{Country::Finland, "FI"}, std::pair{Country::France, "FR"},
+    std::pair{Country::Germany, "DE"}, std::pair{Country::Greece, "GR"}, std::pair{Country::India, "IN"},
+    std::pair{Country::Ireland, "IE"}, std::pair{Country::Italy, "IT"}, std::pair{Country::Japan, "JP"},
+    std::pair{Country::Kenya, "KE"}, std::pair{Country::Mexico, "MX"}, std::pair{Country::Netherlands, "NL"},
+    std::pair{Country::Norway, "NO"}, std::pair{Country::Peru, "PE"}, std::pair{Country::Poland, "PL"},
+    std::pair{Country::Portugal, "PT"}, std::pair{Country::Spain, "ES"}, std::pair{Country::Sweden, "SE"},
+    std::pair{Country::Switzerland, "CH"}, std::pair{Country::Turkey, "TR"}, std::pair{Country::Ukraine, "UA"},
+    std::pair{Country::UnitedKingdom, "GB"}, std::pair{Country::UnitedStates, "US"},
+};
+
+template <> struct meta::EnumMapping<Country>
+{
+    static constexpr auto& mapping = CountryMapping;
+    using Type = meta::EnumTraitsAuto<Country, CountryMapping>;
+};
+
+using Traits = meta::EnumMapping<Country>::Type;
+
+// The lookups EnumTraitsAuto used to build at static initialization
+const std::unordered_map<Country, std::string> enumToString = []
+{
+    std::unordered_map<Country, std::string> m;
+    for (auto [e, s] : CountryMapping)
+        m[e] = s;
+    return m;
+}();
+
+const std::unordered_map<std::string, Country> stringToEnum = []
+{
+    std::unordered_map<std::string, Country> m;
+    for (auto [e, s] : CountryMapping)
+        m[s] = e;
+    return m;
+}();
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 5000000;
+
+    std::vector<Country> values(count);
+    std::vector<std::string> names(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        values[i] = CountryMapping[i * 7 % CountryMapping.size()].first;
+        names[i] = CountryMapping[i * 11 % CountryMapping.size()].second;
+    }
+
+    size_t total = 0;
+    double mapToString = bestSeconds(3, [&]
+    {
+        for (Country c : values)
+        {
+            auto it = enumToString.find(c);
+            total += it != enumToString.end() ? it->second.size() : 0;
+        }
+    });
+    double tableToString = bestSeconds(3, [&]
+    {
+        for (Country c : values)
+            total += Traits::name(c).size();
+    });
+    double mapFromString = bestSeconds(3, [&]
+    {
+        for (const std::string& s : names)
+        {
+            auto it = stringToEnum.find(s);
+            total += it != stringToEnum.end() ? static_cast<size_t>(it->second) : 0;
+        }
+    });
+    double tableFromString = bestSeconds(3, [&]
+    {
+        for (const std::string& s : names)
+            total += static_cast<size_t>(*Traits::fromString(s));
+    });
+
+    auto report = [&](const char* name, double mapSeconds, double tableSeconds)
+    {
+        std::printf("%-14s %12.2f %12.2f %8.1fx\n", name, mapSeconds * 1e3, tableSeconds * 1e3,
+                    mapSeconds / tableSeconds);
+    };
+    std::printf("payload: %zu lookups over %zu names\n\n", count, CountryMapping.size());
+    std::printf("%-14s %12s %12s %9s\n", "lookup", "map ms", "table ms", "speedup");
+    report("enum -> name", mapToString, tableToString);
+    report("name -> enum", mapFromString, tableFromString);
+    return total == 0;
+}
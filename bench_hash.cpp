@@ -0,0 +1,151 @@
+// bench_hash.cpp - deduplicating records with meta::hash / meta::EqualTo vs a hand-written hash
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+
+#include "meta.h"
+
+struct Tick
+{
+    int64_t instrument;
+    int64_t time;
+    int32_t price;
+    int32_t size;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Tick::instrument>("instrument"),
+        meta::field<&Tick::time>("time"),
+        meta::field<&Tick::price>("price"),
+        meta::field<&Tick::size>("size"));
+};
+
+struct Record
+{
+    std::string user;
+    std::string page;
+    int32_t status;
+    std::vector<int32_t> path;
+    int64_t receivedAt;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Record::user>("user"),
+        meta::field<&Record::page>("page"),
+        meta::field<&Record::status>("status"),
+        meta::field<&Record::path>("path"),
+        meta::field<&Record::receivedAt>("receivedAt", meta::NotCompared{}));
+};
+
+// What the structs needed before: std::hash per member, boost-style combine
+template <typename T>
+void combine(size_t& seed, const T& v)
+{
+    seed ^= std::hash<T>{}(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+struct TickHash
+{
+    size_t operator()(const Tick& t) const
+    {
+        size_t h = 0;
+        combine(h, t.instrument);
+        combine(h, t.time);
+        combine(h, t.price);
+        combine(h, t.size);
+        return h;
+    }
+};
+
+struct TickEqual
+{
+    bool operator()(const Tick& a, const Tick& b) const
+    {
+        return a.instrument == b.instrument && a.time == b.time && a.price == b.price && a.size == b.size;
+    }
+};
+
+struct RecordHash
+{
+    size_t operator()(const Record& r) const
+    {
+        size_t h = 0;
+        combine(h, r.user);
+        combine(h, r.page);
+        combine(h, r.status);
+        for (int32_t p : r.path)
+            combine(h, p);
+        return h;
+    }
+};
+
+struct RecordEqual
+{
+    bool operator()(const Record& a, const Record& b) const
+    {
+        return a.user == b.user && a.page == b.page && a.status == b.status && a.path == b.path;
+    }
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+template <typename T, typename H, typename E>
+double dedupe(const std::vector<T>& input, size_t& distinct)
+{
+    return bestSeconds(3, [&]
+    {
+        std::unordered_set<T, H, E> seen;
+        seen.reserve(input.size());
+        for (const T& v : input)
+            seen.insert(v);
+        distinct = seen.size();
+    });
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    std::vector<Tick> ticks;
+    std::vector<Record> records;
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t k = (i * 2654435761u) % (count / 2 + 1); // about half are duplicates
+        ticks.push_back({static_cast<int64_t>(k % 500), static_cast<int64_t>(k), static_cast<int32_t>(k % 9973), 100});
+        records.push_back({"user-" + std::to_string(k % 20000), "/catalogue/item/" + std::to_string(k),
+                           static_cast<int32_t>(200 + k % 3), {1, 2, static_cast<int32_t>(k % 7)},
+                           static_cast<int64_t>(i)});
+    }
+
+    size_t a = 0, b = 0, c = 0, d = 0;
+    double tickManual = dedupe<Tick, TickHash, TickEqual>(ticks, a);
+    double tickMeta = dedupe<Tick, meta::hash<Tick>, meta::EqualTo>(ticks, b);
+    double recordManual = dedupe<Record, RecordHash, RecordEqual>(records, c);
+    double recordMeta = dedupe<Record, meta::hash<Record>, meta::EqualTo>(records, d);
+
+    auto report = [&](const char* name, double seconds, double baseline)
+    {
+        std::printf("%-34s %10.2f %14.0f %8.2fx\n", name, seconds * 1e3, count / seconds, baseline / seconds);
+    };
+    std::printf("payload: %zu records, %zu / %zu distinct\n\n", count, b, d);
+    std::printf("%-34s %10s %14s %9s\n", "dedupe", "ms", "records/s", "speedup");
+    report("Tick, hand-written hash", tickManual, tickManual);
+    report("Tick, meta::hash (one block)", tickMeta, tickManual);
+    report("Record, hand-written hash", recordManual, recordManual);
+    report("Record, meta::hash", recordMeta, recordManual);
+    return a != b || c != d;
+}
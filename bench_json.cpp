@@ -0,0 +1,96 @@
+// bench_json.cpp - fromJson (native tape reader) vs reifyFromYaml on multi-MB JSON
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "meta.h"
+#include "meta_json.h"
+
+struct Location
+{
+    double lat;
+    double lon;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Location::lat>("lat"),
+        meta::field<&Location::lon>("lon"));
+};
+
+struct Record
+{
+    int id;
+    std::string host;
+    std::string service;
+    double latency;
+    bool healthy;
+    Location location;
+    std::vector<int> ports;
+    std::map<std::string, std::string> labels;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Record::id>("id"),
+        meta::field<&Record::host>("host"),
+        meta::field<&Record::service>("service"),
+        meta::field<&Record::latency>("latency"),
+        meta::field<&Record::healthy>("healthy"),
+        meta::field<&Record::location>("location"),
+        meta::field<&Record::ports>("ports"),
+        meta::field<&Record::labels>("labels"));
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 20000;
+
+    std::vector<Record> records;
+    records.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        records.push_back({static_cast<int>(i),
+                           "host-" + std::to_string(i) + ".example.com",
+                           "service-" + std::to_string(i % 17),
+                           0.25 * static_cast<double>(i % 1000),
+                           i % 3 != 0,
+                           {40.0 + static_cast<double>(i % 90), -70.0 - static_cast<double>(i % 90)},
+                           {80, 443, static_cast<int>(8000 + i % 1000)},
+                           {{"region", "us-east-" + std::to_string(i % 4)}, {"tier", "web"}}});
+    }
+
+    std::string json = meta::toJson(records);
+    double mb = static_cast<double>(json.size()) / (1024.0 * 1024.0);
+    std::printf("payload: %zu records, %.2f MB\n\n", count, mb);
+
+    size_t checksum = 0;
+    double native = bestSeconds(3, [&]
+    {
+        auto [parsed, result] = meta::fromJson<std::vector<Record>>(json);
+        checksum += parsed ? parsed->size() : 0;
+    });
+
+    double yaml = bestSeconds(1, [&]
+    {
+        auto [parsed, result] = meta::reifyFromYaml<std::vector<Record>>(json);
+        checksum += parsed ? parsed->size() : 0;
+    });
+
+    std::printf("%-28s %10.3f s %10.1f MB/s\n", "fromJson (native)", native, mb / native);
+    std::printf("%-28s %10.3f s %10.1f MB/s\n", "reifyFromYaml (yaml-cpp)", yaml, mb / yaml);
+    std::printf("\nspeedup: %.1fx  (checksum %zu)\n", yaml / native, checksum);
+    return 0;
+}
@@ -0,0 +1,92 @@
+// bench_json_write.cpp - toJson throughput on arrays of small records, and the cost of string escaping
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "meta.h"
+
+struct Tick
+{
+    int instrument_id;
+    double bid_price;
+    double ask_price;
+    int bid_size;
+    int ask_size;
+    bool is_snapshot;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Tick::instrument_id>("instrument_id"),
+        meta::field<&Tick::bid_price>("bid_price"),
+        meta::field<&Tick::ask_price>("ask_price"),
+        meta::field<&Tick::bid_size>("bid_size", meta::JsonColumn{"bidQuantity"}),
+        meta::field<&Tick::ask_size>("ask_size", meta::JsonColumn{"askQuantity"}),
+        meta::field<&Tick::is_snapshot>("is_snapshot"));
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 200000;
+
+    std::vector<Tick> ticks;
+    ticks.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int n = static_cast<int>(i);
+        ticks.push_back({n % 1000, 100.0 + n % 97 * 0.25, 100.5 + n % 89 * 0.25, n % 500, n % 700, i % 100 == 0});
+    }
+
+    size_t bytes = 0;
+    double seconds = bestSeconds(5, [&] { bytes = meta::toJson(ticks).size(); });
+
+    double mb = static_cast<double>(bytes) / (1024.0 * 1024.0);
+    std::printf("payload: %zu records, %.2f MB\n\n", count, mb);
+    std::printf("%-28s %10.4f s %10.1f MB/s %8.1f ns/record\n", "toJson", seconds, mb / seconds,
+                seconds * 1e9 / static_cast<double>(count));
+
+    // Escaping against a plain copy of the same strings
+    std::vector<std::string> clean, dirty;
+    for (size_t i = 0; i < count; ++i)
+    {
+        clean.push_back("customer " + std::to_string(i) + " - standard delivery, leave at front desk");
+        dirty.push_back("customer \"" + std::to_string(i) + "\"\tnote: <fragile> & \\ handle\n");
+    }
+    meta::StringSink sink;
+    auto run = [&](const char* name, const std::vector<std::string>& strings, auto&& write)
+    {
+        size_t in = 0;
+        for (const auto& str : strings)
+            in += str.size();
+        double t = bestSeconds(5, [&]
+        {
+            sink.clear();
+            for (const auto& str : strings)
+                write(str);
+        });
+        std::printf("%-28s %10.4f s %10.1f MB/s %8.1f ns/string\n", name, t, in / (1024.0 * 1024.0) / t,
+                    t * 1e9 / static_cast<double>(strings.size()));
+    };
+    std::printf("\n");
+    run("copy only (clean)", clean, [&](const std::string& str) { sink.write(str); });
+    run("JSON escape (clean)", clean, [&](const std::string& str) { meta::writeJsonEscaped(sink, str); });
+    run("XML escape (clean)", clean, [&](const std::string& str) { meta::writeXmlEscaped(sink, str); });
+    run("copy only (escapes)", dirty, [&](const std::string& str) { sink.write(str); });
+    run("JSON escape (escapes)", dirty, [&](const std::string& str) { meta::writeJsonEscaped(sink, str); });
+    run("XML escape (escapes)", dirty, [&](const std::string& str) { meta::writeXmlEscaped(sink, str); });
+    return 0;
+}
@@ -0,0 +1,107 @@
+// bench_numbers.cpp - Writing and reading numeric records: 64-bit integers and round-trip doubles
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "meta_csv.h"
+#include "meta_json.h"
+
+struct Tick
+{
+    int64_t time;
+    uint64_t sequence;
+    double bid;
+    double ask;
+    float weight;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Tick::time>("time"),
+        meta::field<&Tick::sequence>("sequence"),
+        meta::field<&Tick::bid>("bid"),
+        meta::field<&Tick::ask>("ask"),
+        meta::field<&Tick::weight>("weight"));
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 500000;
+
+    std::vector<Tick> ticks;
+    ticks.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        double mid = 100.0 + static_cast<double>(i % 100003) / 7.0;
+        ticks.push_back({1700000000000000000 + static_cast<int64_t>(i) * 1000, (1ull << 40) + i, mid - 0.01,
+                         mid + 0.01, static_cast<float>(i % 1000) / 3.0f});
+    }
+    const std::string json = meta::serializeJson(ticks);
+    const std::string csv = meta::toCSVWithHeader(ticks);
+
+    size_t written = 0;
+    size_t printfBytes = 0;
+    double jsonWrite = bestSeconds(3, [&] { written += meta::serializeJson(ticks).size(); });
+    double csvWrite = bestSeconds(3, [&] { written += meta::toCSVWithHeader(ticks).size(); });
+    double printfWrite = bestSeconds(3, [&]
+    {
+        // The same document through snprintf("%.17g"), the usual
+        // round-trip alternative to std::to_chars
+        std::string out;
+        char buf[160];
+        for (const Tick& t : ticks)
+        {
+            int n = std::snprintf(buf, sizeof(buf), "{\"time\":%lld,\"sequence\":%llu,\"bid\":%.17g,\"ask\":%.17g,\"weight\":%.9g},",
+                                  static_cast<long long>(t.time), static_cast<unsigned long long>(t.sequence), t.bid,
+                                  t.ask, static_cast<double>(t.weight));
+            out.append(buf, static_cast<size_t>(n));
+        }
+        printfBytes = out.size();
+        written += out.size();
+    });
+
+    size_t parsed = 0;
+    bool exact = true;
+    double jsonRead = bestSeconds(3, [&]
+    {
+        auto [back, ok] = meta::fromJson<std::vector<Tick>>(json);
+        parsed += back->size();
+        exact = exact && ok.valid && (*back)[count - 1].bid == ticks[count - 1].bid &&
+                (*back)[count - 1].sequence == ticks[count - 1].sequence;
+    });
+    double csvRead = bestSeconds(3, [&]
+    {
+        auto [back, ok] = meta::parseCSV<Tick>(csv);
+        parsed += back.size();
+        exact = exact && ok.valid && back[count - 1].ask == ticks[count - 1].ask;
+    });
+
+    auto report = [&](const char* name, double seconds, size_t bytes)
+    {
+        std::printf("%-22s %10.3f %10.1f %12.0f\n", name, seconds * 1e3, bytes / seconds / 1e6, count / seconds);
+    };
+    std::printf("payload: %zu ticks, JSON %zu bytes, CSV %zu bytes\n\n", count, json.size(), csv.size());
+    std::printf("%-22s %10s %10s %12s\n", "writer", "ms", "MB/s", "rows/s");
+    report("serializeJson", jsonWrite, json.size());
+    report("toCSVWithHeader", csvWrite, csv.size());
+    report("snprintf %.17g", printfWrite, printfBytes);
+    std::printf("\n%-22s %10s %10s %12s\n", "reader", "ms", "MB/s", "rows/s");
+    report("fromJson", jsonRead, json.size());
+    report("parseCSV", csvRead, csv.size());
+    std::printf("\nround trip exact: %s\n", exact ? "yes" : "no");
+    return parsed == 0 || written == 0 || !exact;
+}
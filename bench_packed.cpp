@@ -0,0 +1,92 @@
+// bench_packed.cpp - toBinary / fromBinary of a std::vector of a POD struct: tagged fields vs BinaryPacked
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "meta_binary.h"
+
+struct Tick
+{
+    int64_t time;
+    double bid;
+    double ask;
+    int32_t bidSize;
+    int32_t askSize;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Tick::time>("time"),
+        meta::field<&Tick::bid>("bid"),
+        meta::field<&Tick::ask>("ask"),
+        meta::field<&Tick::bidSize>("bidSize"),
+        meta::field<&Tick::askSize>("askSize"));
+};
+
+// The same record with the packed encoding
+struct PackedTick
+{
+    int64_t time;
+    double bid;
+    double ask;
+    int32_t bidSize;
+    int32_t askSize;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&PackedTick::time>("time"),
+        meta::field<&PackedTick::bid>("bid"),
+        meta::field<&PackedTick::ask>("ask"),
+        meta::field<&PackedTick::bidSize>("bidSize"),
+        meta::field<&PackedTick::askSize>("askSize"));
+};
+
+template <> struct meta::BinaryPacked<PackedTick> : std::true_type {};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+template <typename T>
+std::vector<T> makeTicks(size_t count)
+{
+    std::vector<T> ticks;
+    ticks.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        ticks.push_back({static_cast<int64_t>(1700000000000 + i), 100.0 + static_cast<double>(i % 97) / 16,
+                         100.5 + static_cast<double>(i % 89) / 16, static_cast<int32_t>(i % 5000),
+                         static_cast<int32_t>(i % 7000)});
+    return ticks;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    auto ticks = makeTicks<Tick>(count);
+    auto packed = makeTicks<PackedTick>(count);
+
+    size_t checksum = 0;
+    std::string tagged, block;
+    double writeTagged = bestSeconds(3, [&] { tagged = meta::toBinary(ticks); });
+    double writePacked = bestSeconds(3, [&] { block = meta::toBinary(packed); });
+    double readTagged = bestSeconds(3, [&] { checksum += meta::fromBinary<std::vector<Tick>>(tagged).first->size(); });
+    double readPacked = bestSeconds(3, [&] { checksum += meta::fromBinary<std::vector<PackedTick>>(block).first->size(); });
+
+    std::printf("payload: %zu ticks, %zu bytes in memory\n\n", count, count * sizeof(Tick));
+    std::printf("%-28s %10s %12s %12s\n", "", "bytes", "write ns/rec", "read ns/rec");
+    std::printf("%-28s %10zu %12.2f %12.2f\n", "binary, tagged fields", tagged.size(), writeTagged * 1e9 / count,
+                readTagged * 1e9 / count);
+    std::printf("%-28s %10zu %12.2f %12.2f\n", "binary, BinaryPacked", block.size(), writePacked * 1e9 / count,
+                readPacked * 1e9 / count);
+    std::printf("%-28s %10s %11.1fx %11.1fx\n", "packed gain", "", writeTagged / writePacked, readTagged / readPacked);
+    return checksum == 0;
+}
@@ -0,0 +1,95 @@
+// bench_parallel.cpp - Parallel batch serialization and deserialization from 1 to N threads
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "meta_parallel.h"
+
+struct Row
+{
+    int id;
+    std::string account;
+    double amount;
+    bool settled;
+    std::vector<int> codes;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Row::id>("id"),
+        meta::field<&Row::account>("account"),
+        meta::field<&Row::amount>("amount"),
+        meta::field<&Row::settled>("settled"),
+        meta::field<&Row::codes>("codes"));
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 500000;
+    unsigned maxThreads = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2]))
+                                   : std::max(4u, std::thread::hardware_concurrency());
+
+    std::vector<Row> rows;
+    rows.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int n = static_cast<int>(i);
+        rows.push_back({n, "acct-" + std::to_string(n % 9973), n * 0.01, n % 4 == 0, {n % 7, n % 11}});
+    }
+
+    size_t bytes = 0;
+    double jsonSerial = bestSeconds(3, [&] { bytes += meta::serializeJson(rows).size(); });
+    double csvSerial = bestSeconds(3, [&] { bytes += meta::serialize(rows).size(); });
+
+    std::printf("payload: %zu rows, hardware threads: %u\n\n", count, std::thread::hardware_concurrency());
+    std::printf("%-8s %14s %9s %14s %9s\n", "threads", "JSON s", "speedup", "CSV s", "speedup");
+    std::printf("%-8s %14.4f %9s %14.4f %9s\n", "serial", jsonSerial, "-", csvSerial, "-");
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        meta::ParallelOptions options{threads, 0};
+        double json = bestSeconds(3, [&] { bytes += meta::serializeJsonParallel(rows, options).size(); });
+        double csv = bestSeconds(3, [&] { bytes += meta::serializeParallel(rows, ",", options).size(); });
+        std::printf("%-8u %14.4f %8.2fx %14.4f %8.2fx\n", threads, json, jsonSerial / json, csv, csvSerial / csv);
+    }
+
+    // Reading the same document back: tokenize once, then time from()
+    std::string json = meta::serializeJson(rows);
+    meta::JsonDocument doc(json);
+    meta::JsonNode root(doc, 0);
+    double readSerial = bestSeconds(3, [&]
+    {
+        std::vector<Row> parsed;
+        meta::from(parsed, &root);
+        bytes += parsed.size();
+    });
+
+    std::printf("\n%-8s %14s %9s\n", "threads", "from() s", "speedup");
+    std::printf("%-8s %14.4f %9s\n", "serial", readSerial, "-");
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        double read = bestSeconds(3, [&]
+        {
+            std::vector<Row> parsed;
+            meta::fromParallel(parsed, &root, {threads, 0});
+            bytes += parsed.size();
+        });
+        std::printf("%-8u %14.4f %8.2fx\n", threads, read, readSerial / read);
+    }
+    std::printf("\n(bytes %zu)\n", bytes);
+    return 0;
+}
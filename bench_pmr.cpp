@@ -0,0 +1,138 @@
+// bench_pmr.cpp - fromJson per message: default allocator vs std::pmr fields on a monotonic arena
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <memory_resource>
+#include <vector>
+
+#include "meta.h"
+#include "meta_json.h"
+
+struct Line
+{
+    std::string sku;
+    int quantity;
+    double price;
+    std::vector<std::string> tags;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Line::sku>("sku"),
+        meta::field<&Line::quantity>("quantity"),
+        meta::field<&Line::price>("price"),
+        meta::field<&Line::tags>("tags"));
+};
+
+struct Order
+{
+    std::string id;
+    std::string customer;
+    std::vector<Line> lines;
+    std::map<std::string, std::string> attributes;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Order::id>("id"),
+        meta::field<&Order::customer>("customer"),
+        meta::field<&Order::lines>("lines"),
+        meta::field<&Order::attributes>("attributes"));
+};
+
+struct PmrLine
+{
+    std::pmr::string sku;
+    int quantity;
+    double price;
+    std::pmr::vector<std::pmr::string> tags;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&PmrLine::sku>("sku"),
+        meta::field<&PmrLine::quantity>("quantity"),
+        meta::field<&PmrLine::price>("price"),
+        meta::field<&PmrLine::tags>("tags"));
+};
+
+struct PmrOrder
+{
+    std::pmr::string id;
+    std::pmr::string customer;
+    std::pmr::vector<PmrLine> lines;
+    std::pmr::map<std::pmr::string, std::pmr::string> attributes;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&PmrOrder::id>("id"),
+        meta::field<&PmrOrder::customer>("customer"),
+        meta::field<&PmrOrder::lines>("lines"),
+        meta::field<&PmrOrder::attributes>("attributes"));
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 20000;
+
+    // 64 distinct messages of about 2 KB, each with ~50 strings too long for SSO
+    std::vector<std::string> messages;
+    for (int m = 0; m < 64; ++m)
+    {
+        Order order{"order-" + std::to_string(m) + "-2f1c9a7e4b3d", "customer-account-" + std::to_string(m * 7919), {}, {}};
+        for (int l = 0; l < 12; ++l)
+            order.lines.push_back({"sku-product-catalogue-" + std::to_string(m * 100 + l), l + 1, 9.99 * l,
+                                   {"category-household-goods", "warehouse-north-" + std::to_string(l % 3)}});
+        for (int a = 0; a < 8; ++a)
+            order.attributes["attribute-name-" + std::to_string(a)] = "attribute-value-long-enough-" + std::to_string(m);
+        messages.push_back(meta::toJson(order));
+    }
+
+    size_t checksum = 0;
+    double plain = bestSeconds(3, [&]
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto [order, result] = meta::fromJson<Order>(messages[i % messages.size()]);
+            checksum += order->lines.size();
+        }
+    });
+    double pmrDefault = bestSeconds(3, [&]
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto [order, result] = meta::fromJson<PmrOrder>(messages[i % messages.size()]);
+            checksum += order->lines.size();
+        }
+    });
+    std::vector<std::byte> buffer(64 * 1024);
+    double pmrArena = bestSeconds(3, [&]
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+            auto [order, result] = meta::fromJson<PmrOrder>(messages[i % messages.size()], &arena);
+            checksum += order->lines.size();
+        }
+    });
+
+    auto report = [&](const char* name, double seconds)
+    {
+        std::printf("%-34s %10.2f %12.0f %8.2fx\n", name, seconds * 1e3, count / seconds, plain / seconds);
+    };
+    std::printf("payload: %zu messages of ~%zu bytes\n\n", count, messages[0].size());
+    std::printf("%-34s %10s %12s %9s\n", "reader", "ms", "msgs/s", "vs std");
+    report("std types, default allocator", plain);
+    report("pmr types, default resource", pmrDefault);
+    report("pmr types, monotonic arena", pmrArena);
+    return checksum == 0;
+}
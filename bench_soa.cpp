@@ -0,0 +1,97 @@
+// bench_soa.cpp - Aggregating one or two fields: std::vector<T> vs meta::soa_vector<T>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "meta_soa.h"
+
+struct Person
+{
+    std::string name;
+    std::string email;
+    int age;
+    double salary;
+    double bonus;
+    bool active;
+    int64_t id;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Person::name>("name"),
+        meta::field<&Person::email>("email"),
+        meta::field<&Person::age>("age"),
+        meta::field<&Person::salary>("salary"),
+        meta::field<&Person::bonus>("bonus"),
+        meta::field<&Person::active>("active"),
+        meta::field<&Person::id>("id"));
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 2000000;
+
+    std::vector<Person> rows;
+    rows.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        int n = static_cast<int>(i);
+        rows.push_back({"person-" + std::to_string(n), "p" + std::to_string(n) + "@example.com", 20 + n % 50,
+                        1000.0 + n % 997, n % 13 * 0.5, n % 3 != 0, n});
+    }
+    meta::soa_vector<Person> soa(rows);
+
+    volatile double sink = 0;
+    double aosSum = bestSeconds(5, [&]
+    {
+        double total = 0;
+        for (const Person& p : rows)
+            total += p.salary;
+        sink = total;
+    });
+    double soaSum = bestSeconds(5, [&]
+    {
+        double total = 0;
+        for (double s : soa.column<&Person::salary>())
+            total += s;
+        sink = total;
+    });
+    double aosFilter = bestSeconds(5, [&]
+    {
+        double total = 0;
+        for (const Person& p : rows)
+            total += p.active ? p.salary + p.bonus : 0.0;
+        sink = total;
+    });
+    double soaFilter = bestSeconds(5, [&]
+    {
+        auto active = soa.column<&Person::active>();
+        auto salary = soa.column<&Person::salary>();
+        auto bonus = soa.column<&Person::bonus>();
+        double total = 0;
+        for (size_t i = 0; i < soa.size(); ++i)
+            total += active[i] ? salary[i] + bonus[i] : 0.0;
+        sink = total;
+    });
+
+    std::printf("payload: %zu rows, sizeof(Person) = %zu\n\n", count, sizeof(Person));
+    std::printf("%-28s %12s %12s %9s\n", "query", "vector ms", "soa ms", "speedup");
+    std::printf("%-28s %12.2f %12.2f %8.1fx\n", "sum(salary)", aosSum * 1e3, soaSum * 1e3, aosSum / soaSum);
+    std::printf("%-28s %12.2f %12.2f %8.1fx\n", "sum(salary+bonus) if active", aosFilter * 1e3, soaFilter * 1e3,
+                aosFilter / soaFilter);
+    return 0;
+}
@@ -0,0 +1,108 @@
+// bench_string_views.cpp - fromJson / fromBinary into std::string fields vs std::string_view fields
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "meta.h"
+#include "meta_binary.h"
+#include "meta_json.h"
+
+struct LogLine
+{
+    std::string timestamp;
+    std::string level;
+    std::string service;
+    std::string message;
+    std::vector<std::string> tags;
+    int code;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&LogLine::timestamp>("timestamp"),
+        meta::field<&LogLine::level>("level"),
+        meta::field<&LogLine::service>("service"),
+        meta::field<&LogLine::message>("message"),
+        meta::field<&LogLine::tags>("tags"),
+        meta::field<&LogLine::code>("code"));
+};
+
+struct LogLineView
+{
+    std::string_view timestamp;
+    std::string_view level;
+    std::string_view service;
+    std::string_view message;
+    std::vector<std::string_view> tags;
+    int code;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&LogLineView::timestamp>("timestamp"),
+        meta::field<&LogLineView::level>("level"),
+        meta::field<&LogLineView::service>("service"),
+        meta::field<&LogLineView::message>("message"),
+        meta::field<&LogLineView::tags>("tags"),
+        meta::field<&LogLineView::code>("code"));
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+    std::vector<std::string> json, binary;
+    for (int m = 0; m < 64; ++m)
+    {
+        LogLine line{"2024-03-0" + std::to_string(m % 9 + 1) + "T12:34:56.789Z", m % 5 ? "info" : "error",
+                     "checkout-service-" + std::to_string(m % 4),
+                     "request completed for customer account " + std::to_string(m * 7919) + " after retrying",
+                     {"region-eu-west-1", "deployment-canary-" + std::to_string(m % 3)}, 200 + m};
+        json.push_back(meta::toJson(line));
+        binary.push_back(meta::toBinary(line));
+    }
+
+    size_t checksum = 0;
+    auto run = [&]<typename T>(const std::vector<std::string>& input, auto parse)
+    {
+        return bestSeconds(3, [&]
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto [line, result] = parse.template operator()<T>(input[i % input.size()]);
+                checksum += line->message.size();
+            }
+        });
+    };
+    auto viaJson = []<typename T>(const std::string& s) { return meta::fromJson<T>(s); };
+    auto viaBinary = []<typename T>(const std::string& s) { return meta::fromBinary<T>(s); };
+
+    double jsonOwned = run.operator()<LogLine>(json, viaJson);
+    double jsonViews = run.operator()<LogLineView>(json, viaJson);
+    double binaryOwned = run.operator()<LogLine>(binary, viaBinary);
+    double binaryViews = run.operator()<LogLineView>(binary, viaBinary);
+
+    auto report = [&](const char* name, double seconds, double baseline)
+    {
+        std::printf("%-30s %10.2f %12.0f %8.2fx\n", name, seconds * 1e3, count / seconds, baseline / seconds);
+    };
+    std::printf("payload: %zu log lines of ~%zu bytes\n\n", count, json[0].size());
+    std::printf("%-30s %10s %12s %9s\n", "reader", "ms", "lines/s", "speedup");
+    report("fromJson, std::string", jsonOwned, jsonOwned);
+    report("fromJson, std::string_view", jsonViews, jsonOwned);
+    report("fromBinary, std::string", binaryOwned, binaryOwned);
+    report("fromBinary, std::string_view", binaryViews, binaryOwned);
+    return checksum == 0;
+}
@@ -0,0 +1,685 @@
+// bench_suite.cpp - Every format in both directions over representative shapes, saved and compared as baselines
+//
+//   bin/bench_suite [records] [--filter text] [--runs n] [--save file] [--compare file] [--threshold pct]
+//
+// Each case is timed as the best of --runs, after one untimed run that counts
+// heap allocations and the peak heap in use above what was live before it.
+// --save writes the results as a baseline; --compare prints objects/s against
+// one and exits 1 when a case is slower than the baseline by more than
+// --threshold percent (default 10). make bench-save / make bench-compare wrap
+// both for the default baseline file.
+#include <malloc.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <sys/resource.h>
+#include <variant>
+#include <vector>
+
+#include "meta.h"
+#include "meta_binary.h"
+#include "meta_csv.h"
+#include "meta_db.h"
+#include "meta_json.h"
+#include "meta_proto.h"
+
+// ============================================================================
+// Heap accounting
+// ============================================================================
+
+namespace
+{
+size_t allocationCount = 0;
+size_t liveBytes = 0;
+size_t peakBytes = 0;
+}
+
+void* operator new(size_t size)
+{
+    void* p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    ++allocationCount;
+    liveBytes += malloc_usable_size(p);
+    peakBytes = std::max(peakBytes, liveBytes);
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    if (!p)
+        return;
+    liveBytes -= malloc_usable_size(p);
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+
+// ============================================================================
+// Shapes
+// ============================================================================
+
+// A wide flat record, the kind that ends up as a CSV row or a table row
+struct Wide
+{
+    int64_t id;
+    std::string account;
+    std::string region;
+    std::string currency;
+    int quantity;
+    int priority;
+    uint32_t flags;
+    int64_t createdAt;
+    int64_t updatedAt;
+    double price;
+    double discount;
+    double tax;
+    double total;
+    float score;
+    bool active;
+    bool verified;
+    bool archived;
+    std::string email;
+    std::string note;
+    int version;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Wide::id>("id"),
+        meta::field<&Wide::account>("account"),
+        meta::field<&Wide::region>("region"),
+        meta::field<&Wide::currency>("currency"),
+        meta::field<&Wide::quantity>("quantity"),
+        meta::field<&Wide::priority>("priority"),
+        meta::field<&Wide::flags>("flags"),
+        meta::field<&Wide::createdAt>("createdAt"),
+        meta::field<&Wide::updatedAt>("updatedAt"),
+        meta::field<&Wide::price>("price"),
+        meta::field<&Wide::discount>("discount"),
+        meta::field<&Wide::tax>("tax"),
+        meta::field<&Wide::total>("total"),
+        meta::field<&Wide::score>("score"),
+        meta::field<&Wide::active>("active"),
+        meta::field<&Wide::verified>("verified"),
+        meta::field<&Wide::archived>("archived"),
+        meta::field<&Wide::email>("email"),
+        meta::field<&Wide::note>("note"),
+        meta::field<&Wide::version>("version"));
+};
+
+template <> struct meta::MetaTuple<Wide>
+{
+    static constexpr auto& FieldsMeta = Wide::FieldsMeta;
+    static constexpr auto tableName = "wide";
+};
+
+struct WideTable
+{
+    std::vector<Wide> records;
+
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&WideTable::records>("records"));
+};
+
+// Topology nesting in the style of example_super_super: regions > clusters > hosts > ports
+struct Port
+{
+    int port;
+    std::string protocol;
+    bool open;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Port::port>("port"),
+        meta::field<&Port::protocol>("protocol"),
+        meta::field<&Port::open>("open"));
+};
+
+struct Host
+{
+    std::string hostname;
+    std::vector<Port> ports;
+    std::map<std::string, std::string> labels;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Host::hostname>("hostname"),
+        meta::field<&Host::ports>("ports"),
+        meta::field<&Host::labels>("labels"));
+};
+
+struct Cluster
+{
+    std::string name;
+    std::vector<Host> hosts;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Cluster::name>("name"),
+        meta::field<&Cluster::hosts>("hosts"));
+};
+
+struct Region
+{
+    std::string name;
+    std::vector<Cluster> clusters;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Region::name>("name"),
+        meta::field<&Region::clusters>("clusters"));
+};
+
+struct Topology
+{
+    std::vector<Region> regions;
+
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&Topology::regions>("regions"));
+};
+
+// Few fields, large containers
+struct Series
+{
+    std::vector<int64_t> timestamps;
+    std::vector<double> samples;
+    std::map<std::string, int64_t> counters;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Series::timestamps>("timestamps"),
+        meta::field<&Series::samples>("samples"),
+        meta::field<&Series::counters>("counters"));
+};
+
+// Records that are mostly enums
+enum class Level
+{
+    Trace,
+    Debug,
+    Info,
+    Warning,
+    Error
+};
+
+enum class Category
+{
+    Network,
+    Storage,
+    Compute,
+    Security,
+    Billing,
+    Audit
+};
+
+constexpr std::array LevelMapping = std::array{
+    std::pair{Level::Trace, "trace"}, std::pair{Level::Debug, "debug"}, std::pair{Level::Info, "info"},
+    std::pair{Level::Warning, "warning"}, std::pair{Level::Error, "error"}};
+
+template <> struct meta::EnumMapping<Level>
+{
+    static constexpr auto& mapping = LevelMapping;
+    using Type = meta::EnumTraitsAuto<Level, LevelMapping>;
+};
+
+constexpr std::array CategoryMapping = std::array{
+    std::pair{Category::Network, "network"}, std::pair{Category::Storage, "storage"},
+    std::pair{Category::Compute, "compute"}, std::pair{Category::Security, "security"},
+    std::pair{Category::Billing, "billing"}, std::pair{Category::Audit, "audit"}};
+
+template <> struct meta::EnumMapping<Category>
+{
+    static constexpr auto& mapping = CategoryMapping;
+    using Type = meta::EnumTraitsAuto<Category, CategoryMapping>;
+};
+
+struct Event
+{
+    int id;
+    Level level;
+    Category category;
+    std::optional<Level> escalation;
+    std::vector<Category> tags;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Event::id>("id"),
+        meta::field<&Event::level>("level"),
+        meta::field<&Event::category>("category"),
+        meta::field<&Event::escalation>("escalation"),
+        meta::field<&Event::tags>("tags"));
+};
+
+struct EventLog
+{
+    std::vector<Event> events;
+
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&EventLog::events>("events"));
+};
+
+// Records that are one of several structs
+struct Login
+{
+    std::string user;
+    int64_t at;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Login::user>("user"),
+        meta::field<&Login::at>("at"));
+};
+
+struct Purchase
+{
+    std::string user;
+    std::string sku;
+    double price;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Purchase::user>("user"),
+        meta::field<&Purchase::sku>("sku"),
+        meta::field<&Purchase::price>("price"));
+};
+
+struct Refund
+{
+    std::string user;
+    std::string order;
+    double amount;
+    std::string reason;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Refund::user>("user"),
+        meta::field<&Refund::order>("order"),
+        meta::field<&Refund::amount>("amount"),
+        meta::field<&Refund::reason>("reason"));
+};
+
+using Activity = std::variant<Login, Purchase, Refund>;
+
+template <> struct meta::VariantTags<Activity>
+{
+    static constexpr std::array names{"login", "purchase", "refund"};
+};
+
+struct ActivityLog
+{
+    std::vector<Activity> activity;
+
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&ActivityLog::activity>("activity"));
+};
+
+WideTable makeWide(size_t n)
+{
+    WideTable table;
+    table.records.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto k = static_cast<int>(i);
+        table.records.push_back({static_cast<int64_t>(i) * 7919, "account-" + std::to_string(i % 5003),
+                                 i % 3 ? "eu-west-1" : "us-east-2", i % 2 ? "EUR" : "USD", k % 50 + 1, k % 5,
+                                 static_cast<uint32_t>(i * 2654435761u), 1700000000 + static_cast<int64_t>(i),
+                                 1700003600 + static_cast<int64_t>(i), 19.99 + k % 100, 0.05 * (k % 4), 0.2,
+                                 123.25 + k, 0.5f + static_cast<float>(k % 10), i % 2 == 0, i % 3 == 0, i % 17 == 0,
+                                 "user" + std::to_string(i) + "@example.com", "standard delivery", k % 9});
+    }
+    return table;
+}
+
+Topology makeTopology(size_t hosts)
+{
+    Topology topology;
+    size_t made = 0;
+    for (int r = 0; made < hosts; ++r)
+    {
+        Region& region = topology.regions.emplace_back(Region{"region-" + std::to_string(r), {}});
+        for (int c = 0; c < 8 && made < hosts; ++c)
+        {
+            Cluster& cluster = region.clusters.emplace_back(Cluster{region.name + "-cluster-" + std::to_string(c), {}});
+            for (int h = 0; h < 16 && made < hosts; ++h, ++made)
+            {
+                std::string name = cluster.name + "-host-" + std::to_string(h);
+                cluster.hosts.push_back({name,
+                                         {{22, "tcp", true}, {443, "tcp", true}, {8125, "udp", h % 2 == 0}},
+                                         {{"rack", "r" + std::to_string(h % 4)}, {"tier", h % 3 ? "web" : "db"}}});
+            }
+        }
+    }
+    return topology;
+}
+
+Series makeSeries(size_t n)
+{
+    Series series;
+    series.timestamps.reserve(n);
+    series.samples.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        series.timestamps.push_back(1700000000000 + static_cast<int64_t>(i) * 250);
+        series.samples.push_back(static_cast<double>(i % 1000) * 0.125 - 40.0);
+    }
+    for (size_t i = 0; i < n / 16; ++i)
+        series.counters["counter." + std::to_string(i)] = static_cast<int64_t>(i * i);
+    return series;
+}
+
+EventLog makeEvents(size_t n)
+{
+    EventLog log;
+    log.events.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        std::optional<Level> escalation;
+        if (i % 4 == 0)
+            escalation = Level::Error;
+        log.events.push_back({static_cast<int>(i), static_cast<Level>(i % 5), static_cast<Category>(i % 6), escalation,
+                              {static_cast<Category>(i % 6), static_cast<Category>((i + 3) % 6)}});
+    }
+    return log;
+}
+
+ActivityLog makeActivity(size_t n)
+{
+    ActivityLog log;
+    log.activity.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        std::string user = "user-" + std::to_string(i % 977);
+        switch (i % 3)
+        {
+        case 0: log.activity.emplace_back(Login{user, static_cast<int64_t>(i)}); break;
+        case 1: log.activity.emplace_back(Purchase{user, "sku-" + std::to_string(i % 31), 9.5}); break;
+        default: log.activity.emplace_back(Refund{user, "order-" + std::to_string(i), 9.5, "damaged"}); break;
+        }
+    }
+    return log;
+}
+
+// ============================================================================
+// Harness
+// ============================================================================
+
+struct Options
+{
+    size_t records = 20000;
+    int runs = 3;
+    std::string filter;
+    std::string save;
+    std::string compare;
+    double threshold = 10.0;
+};
+
+struct Result
+{
+    std::string name;
+    double seconds;
+    size_t bytes;
+    size_t objects;
+    double allocationsPerObject;
+    size_t peakBytes;
+
+    double megabytesPerSecond() const { return static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds; }
+    double objectsPerSecond() const { return static_cast<double>(objects) / seconds; }
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+class Suite
+{
+    Options options;
+    std::vector<Result> results;
+    size_t sink = 0;
+
+  public:
+    explicit Suite(Options options) : options(std::move(options)) {}
+
+    const std::vector<Result>& all() const { return results; }
+
+    // f() runs one case and returns a byte count to keep the work observable
+    template <typename F>
+    void run(const std::string& name, size_t bytes, size_t objects, F&& f)
+    {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+            return;
+
+        size_t allocationsBefore = allocationCount;
+        size_t liveBefore = liveBytes;
+        peakBytes = liveBytes;
+        sink += f();
+        size_t allocations = allocationCount - allocationsBefore;
+        size_t peak = peakBytes - liveBefore;
+
+        double seconds = bestSeconds(options.runs, [&] { sink += f(); });
+        results.push_back({name, seconds, bytes, objects, static_cast<double>(allocations) / objects, peak});
+        std::fprintf(stderr, ".");
+    }
+
+    size_t checksum() const { return sink; }
+};
+
+template <typename T>
+size_t checked(const std::pair<std::optional<T>, meta::ValidationResult>& parsed, const char* what)
+{
+    if (!parsed.second.valid)
+    {
+        std::fprintf(stderr, "%s: %s: %s\n", what, parsed.second.errors[0].first.c_str(), parsed.second.errors[0].second.c_str());
+        std::exit(2);
+    }
+    return 1;
+}
+
+enum Formats : unsigned
+{
+    Text = 1,   // JSON, YAML, XML
+    Binary = 2, // meta_binary.h
+    Proto = 4,  // meta_proto.h
+    Table = 8,  // CSV and insertSQL over the records
+};
+
+// Runs every format the shape supports in both directions it supports
+template <unsigned F, typename T>
+void runShape(Suite& suite, const std::string& shape, const T& data, size_t objects)
+{
+    if constexpr ((F & Text) != 0)
+    {
+        const std::string json = meta::toJson(data);
+        suite.run(shape + "/json/write", json.size(), objects, [&] { return meta::toJson(data).size(); });
+        suite.run(shape + "/json/read", json.size(), objects, [&] { return checked(meta::fromJson<T>(json), "json"); });
+
+        const std::string yaml = meta::toYaml(data);
+        suite.run(shape + "/yaml/write", yaml.size(), objects, [&] { return meta::toYaml(data).size(); });
+        suite.run(shape + "/yaml/read", yaml.size(), objects,
+                  [&] { return checked(meta::reifyFromYaml<T>(std::string_view(yaml)), "yaml"); });
+
+        const std::string xml = meta::toXml(data);
+        suite.run(shape + "/xml/write", xml.size(), objects, [&] { return meta::toXml(data).size(); });
+    }
+    if constexpr ((F & Binary) != 0)
+    {
+        const std::string binary = meta::toBinary(data);
+        suite.run(shape + "/binary/write", binary.size(), objects, [&] { return meta::toBinary(data).size(); });
+        suite.run(shape + "/binary/read", binary.size(), objects,
+                  [&] { return checked(meta::fromBinary<T>(binary), "binary"); });
+    }
+    if constexpr ((F & Proto) != 0)
+    {
+        const std::string proto = meta::toProto(data);
+        suite.run(shape + "/proto/write", proto.size(), objects, [&] { return meta::toProto(data).size(); });
+        suite.run(shape + "/proto/read", proto.size(), objects, [&] { return checked(meta::fromProto<T>(proto), "proto"); });
+    }
+    if constexpr ((F & Table) != 0)
+    {
+        using Row = typename decltype(data.records)::value_type;
+        const std::string csv = meta::toCSVWithHeader(data.records);
+        suite.run(shape + "/csv/write", csv.size(), objects, [&] { return meta::toCSVWithHeader(data.records).size(); });
+        suite.run(shape + "/csv/read", csv.size(), objects, [&]
+        {
+            auto [rows, result] = meta::parseCSV<Row>(csv);
+            if (!result.valid)
+            {
+                std::fprintf(stderr, "csv: %s: %s\n", result.errors[0].first.c_str(), result.errors[0].second.c_str());
+                std::exit(2);
+            }
+            return rows.size();
+        });
+
+        size_t sqlBytes = 0;
+        for (const Row& row : data.records)
+            sqlBytes += meta::insertSQL(row).size();
+        suite.run(shape + "/sql/insert", sqlBytes, objects, [&]
+        {
+            size_t total = 0;
+            for (const Row& row : data.records)
+                total += meta::insertSQL(row).size();
+            return total;
+        });
+    }
+}
+
+// ============================================================================
+// Baselines
+// ============================================================================
+
+// One line per case: name, seconds, bytes, objects, allocations per object, peak bytes
+void saveBaseline(const std::string& path, const std::vector<Result>& results)
+{
+    std::ofstream out(path);
+    for (const Result& r : results)
+        out << r.name << '\t' << r.seconds << '\t' << r.bytes << '\t' << r.objects << '\t' << r.allocationsPerObject
+            << '\t' << r.peakBytes << '\n';
+}
+
+std::map<std::string, Result> loadBaseline(const std::string& path)
+{
+    std::map<std::string, Result> baseline;
+    std::ifstream in(path);
+    if (!in)
+    {
+        std::fprintf(stderr, "can't read baseline %s\n", path.c_str());
+        std::exit(2);
+    }
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        Result r;
+        if (std::getline(fields, r.name, '\t') && fields >> r.seconds >> r.bytes >> r.objects >> r.allocationsPerObject >> r.peakBytes)
+            baseline[r.name] = r;
+    }
+    return baseline;
+}
+
+Options parseOptions(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string
+        {
+            if (i + 1 >= argc)
+            {
+                std::fprintf(stderr, "%s needs a value\n", arg.c_str());
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--filter")
+            options.filter = value();
+        else if (arg == "--runs")
+            options.runs = std::stoi(value());
+        else if (arg == "--save")
+            options.save = value();
+        else if (arg == "--compare")
+            options.compare = value();
+        else if (arg == "--threshold")
+            options.threshold = std::stod(value());
+        else
+            options.records = std::stoul(arg);
+    }
+    return options;
+}
+
+int main(int argc, char** argv)
+{
+    Options options = parseOptions(argc, argv);
+    size_t n = options.records;
+
+    Suite suite(options);
+    {
+        WideTable wide = makeWide(n);
+        runShape<Text | Binary | Proto | Table>(suite, "wide", wide, n);
+    }
+    {
+        Topology topology = makeTopology(n);
+        runShape<Text | Binary | Proto>(suite, "nested", topology, n);
+    }
+    {
+        Series series = makeSeries(n * 10);
+        runShape<Text | Binary | Proto>(suite, "bulk", series, n * 10);
+    }
+    {
+        EventLog events = makeEvents(n);
+        runShape<Text | Binary | Proto>(suite, "enums", events, n);
+    }
+    {
+        ActivityLog activity = makeActivity(n);
+        runShape<Text | Binary>(suite, "variants", activity, n);
+    }
+    std::fprintf(stderr, "\n");
+
+    std::map<std::string, Result> baseline;
+    if (!options.compare.empty())
+        baseline = loadBaseline(options.compare);
+
+    std::printf("records per shape: %zu (bulk: %zu elements), best of %d\n\n", n, n * 10, options.runs);
+    std::printf("%-22s %9s %9s %12s %10s %10s", "case", "ms", "MB/s", "objs/s", "allocs/obj", "peak KB");
+    std::printf(baseline.empty() ? "\n" : " %9s\n", "vs base");
+
+    int regressions = 0;
+    for (const Result& r : suite.all())
+    {
+        std::printf("%-22s %9.2f %9.1f %12.0f %10.2f %10zu", r.name.c_str(), r.seconds * 1e3, r.megabytesPerSecond(),
+                    r.objectsPerSecond(), r.allocationsPerObject, r.peakBytes / 1024);
+        if (baseline.empty())
+        {
+            std::printf("\n");
+            continue;
+        }
+        auto it = baseline.find(r.name);
+        if (it == baseline.end())
+        {
+            std::printf(" %9s\n", "new");
+            continue;
+        }
+        double ratio = r.objectsPerSecond() / it->second.objectsPerSecond();
+        bool slower = ratio < 1.0 - options.threshold / 100.0;
+        regressions += slower;
+        std::printf(" %8.2fx%s\n", ratio, slower ? "  SLOWER" : "");
+    }
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("\nmax resident: %ld KB (checksum %zu)\n", usage.ru_maxrss, suite.checksum());
+
+    if (!options.save.empty())
+    {
+        saveBaseline(options.save, suite.all());
+        std::printf("baseline saved to %s\n", options.save.c_str());
+    }
+    if (regressions > 0)
+    {
+        std::printf("%d case(s) more than %.0f%% slower than %s\n", regressions, options.threshold, options.compare.c_str());
+        return 1;
+    }
+    return 0;
+}
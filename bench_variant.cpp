@@ -0,0 +1,122 @@
+// bench_variant.cpp - Reading variants of structs: trial parsing vs VariantTags dispatch
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "meta_json.h"
+
+struct Login
+{
+    std::string user;
+    int64_t at;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Login::user>("user"),
+        meta::field<&Login::at>("at"));
+};
+
+struct Purchase
+{
+    std::string user;
+    std::string sku;
+    double price;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Purchase::user>("user"),
+        meta::field<&Purchase::sku>("sku"),
+        meta::field<&Purchase::price>("price"));
+};
+
+struct Refund
+{
+    std::string user;
+    std::string order;
+    double amount;
+    std::string reason;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Refund::user>("user"),
+        meta::field<&Refund::order>("order"),
+        meta::field<&Refund::amount>("amount"),
+        meta::field<&Refund::reason>("reason"));
+};
+
+struct Logout
+{
+    std::string user;
+    std::string session;
+    bool forced;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Logout::user>("user"),
+        meta::field<&Logout::session>("session"),
+        meta::field<&Logout::forced>("forced"));
+};
+
+// Same alternatives twice so one can be tagged and the other not
+template <int> struct Marker
+{
+    int marker;
+
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&Marker::marker>("marker"));
+};
+using TaggedEvent = std::variant<Login, Purchase, Refund, Logout, Marker<0>>;
+using UntaggedEvent = std::variant<Login, Purchase, Refund, Logout, Marker<1>>;
+
+template <> struct meta::VariantTags<TaggedEvent>
+{
+    static constexpr std::array names{"login", "purchase", "refund", "logout", "unused"};
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+    std::vector<TaggedEvent> tagged;
+    std::vector<UntaggedEvent> untagged;
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string user = "user-" + std::to_string(i % 977);
+        switch (i % 4)
+        {
+        case 0: tagged.emplace_back(Login{user, static_cast<int64_t>(i)}); break;
+        case 1: tagged.emplace_back(Purchase{user, "sku-" + std::to_string(i % 31), 9.5}); break;
+        case 2: tagged.emplace_back(Refund{user, "order-" + std::to_string(i), 9.5, "damaged"}); break;
+        default: tagged.emplace_back(Logout{user, "s" + std::to_string(i), i % 8 == 3}); break;
+        }
+        std::visit([&](const auto& e)
+        {
+            if constexpr (!std::is_same_v<std::decay_t<decltype(e)>, Marker<0>>)
+                untagged.emplace_back(e);
+        }, tagged.back());
+    }
+    const std::string taggedJson = meta::serializeJson(tagged);
+    const std::string untaggedJson = meta::serializeJson(untagged);
+
+    size_t parsed = 0;
+    double untaggedRead = bestSeconds(3, [&] { parsed += meta::fromJson<std::vector<UntaggedEvent>>(untaggedJson).first->size(); });
+    double taggedRead = bestSeconds(3, [&] { parsed += meta::fromJson<std::vector<TaggedEvent>>(taggedJson).first->size(); });
+
+    std::printf("payload: %zu events, untagged %zu bytes, tagged %zu bytes\n\n", count, untaggedJson.size(), taggedJson.size());
+    std::printf("%-26s %10s %12s\n", "reader", "ms", "events/s");
+    std::printf("%-26s %10.2f %12.0f\n", "untagged (trial parsing)", untaggedRead * 1e3, count / untaggedRead);
+    std::printf("%-26s %10.2f %12.0f\n", "VariantTags", taggedRead * 1e3, count / taggedRead);
+    std::printf("\nspeedup: %.1fx\n", untaggedRead / taggedRead);
+    return parsed == 0;
+}
@@ -0,0 +1,106 @@
+// bench_yaml.cpp - reifyFromYaml from parse events vs through a YAML::Load tree
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "meta.h"
+
+struct Limits
+{
+    int cpu;
+    int memory;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Limits::cpu>("cpu"),
+        meta::field<&Limits::memory>("memory"));
+};
+
+struct Service
+{
+    std::string name;
+    int replicas;
+    double weight;
+    bool canary;
+    Limits limits;
+    std::vector<std::string> hosts;
+    std::map<std::string, std::string> labels;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Service::name>("name"),
+        meta::field<&Service::replicas>("replicas"),
+        meta::field<&Service::weight>("weight"),
+        meta::field<&Service::canary>("canary"),
+        meta::field<&Service::limits>("limits"),
+        meta::field<&Service::hosts>("hosts"),
+        meta::field<&Service::labels>("labels"));
+};
+
+struct Fleet
+{
+    std::string region;
+    std::vector<Service> services;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Fleet::region>("region"),
+        meta::field<&Fleet::services>("services"));
+};
+
+template <typename F>
+double bestSeconds(int runs, F&& f)
+{
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 20000;
+
+    Fleet fleet{"eu-west", {}};
+    fleet.services.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string name = "service-" + std::to_string(i);
+        fleet.services.push_back({name, static_cast<int>(i % 12 + 1), 0.5 + static_cast<double>(i % 7), i % 9 == 0,
+                                  {static_cast<int>(i % 16 + 1), static_cast<int>(512 * (i % 32 + 1))},
+                                  {name + "-a.internal", name + "-b.internal"},
+                                  {{"team", "team-" + std::to_string(i % 40)}, {"tier", i % 2 ? "web" : "batch"}}});
+    }
+
+    const std::string yaml = meta::toYaml(fleet);
+    double mb = static_cast<double>(yaml.size()) / (1024.0 * 1024.0);
+    std::printf("payload: %zu services, %.2f MB\n\n", count, mb);
+
+    size_t checksum = 0;
+    double viaTree = bestSeconds(3, [&]
+    {
+        auto [parsed, result] = meta::reifyFromYaml<Fleet>(YAML::Load(yaml));
+        checksum += parsed ? parsed->services.size() : 0;
+    });
+    double viaEvents = bestSeconds(3, [&]
+    {
+        auto [parsed, result] = meta::reifyFromYaml<Fleet>(yaml);
+        checksum += parsed ? parsed->services.size() : 0;
+    });
+    double parseOnly = bestSeconds(3, [&]
+    {
+        meta::YamlDocument doc(yaml);
+        checksum += doc.eventCount();
+    });
+
+    std::printf("%-32s %10.3f s %10.1f MB/s\n", "YAML::Load + reifyFromYaml", viaTree, mb / viaTree);
+    std::printf("%-32s %10.3f s %10.1f MB/s\n", "reifyFromYaml (events)", viaEvents, mb / viaEvents);
+    std::printf("%-32s %10.3f s %10.1f MB/s\n", "  of which YamlDocument parse", parseOnly, mb / parseOnly);
+    std::printf("\nspeedup: %.1fx  (checksum %zu)\n", viaTree / viaEvents, checksum);
+    return checksum == 0;
+}
@@ -0,0 +1,267 @@
+// compile_bench.cpp - Compile time and object size per header, per reflected type and per format, and what
+// META_EXTERN_TEMPLATES saves a TU that uses types instantiated elsewhere
+//
+//   make bench-compile
+//   bin/compile_bench [--types n] [--cxx compiler] [--flags "compiler flags"]
+//
+// Probe TUs are generated under bin/compile_bench.d/ and compiled with -c from
+// the directory holding the headers. A format's cost per type is the compile
+// time and object size of a TU serializing n types, minus the same TU with
+// the types declared but not serialized, divided by n.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+struct Options
+{
+    int types = 8;
+    std::string cxx = "g++";
+    std::string flags = "-std=c++20 -O2 -DNDEBUG";
+    std::string ldflags = "-L/usr/local/lib -lyaml-cpp -pthread";
+};
+
+struct Compile
+{
+    double seconds;
+    size_t objectBytes;
+};
+
+const fs::path workDir = "bin/compile_bench.d";
+
+Compile compile(const Options& options, const std::string& name, const std::string& source)
+{
+    fs::path src = workDir / (name + ".cpp");
+    fs::path obj = workDir / (name + ".o");
+    std::ofstream(src) << source;
+    std::string command = options.cxx + " " + options.flags + " -I. -c " + src.string() + " -o " + obj.string();
+    auto start = std::chrono::steady_clock::now();
+    int status = std::system(command.c_str());
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (status != 0)
+    {
+        std::fprintf(stderr, "compile failed: %s\n", command.c_str());
+        std::exit(2);
+    }
+    return {elapsed.count(), static_cast<size_t>(fs::file_size(obj))};
+}
+
+// ============================================================================
+// Generated sources
+// ============================================================================
+
+const char* allHeaders = "#include \"meta.h\"\n#include \"meta_binary.h\"\n#include \"meta_csv.h\"\n"
+                         "#include \"meta_db.h\"\n#include \"meta_json.h\"\n#include \"meta_proto.h\"\n";
+
+// Type<k> has nested, container and optional fields; Row<k> is flat enough for CSV and SQL
+std::string declareTypes(int n)
+{
+    std::string s = "#include <map>\n#include <optional>\n#include <string>\n#include <vector>\n\n";
+    for (int k = 0; k < n; ++k)
+    {
+        std::string K = std::to_string(k);
+        s += "struct Inner" + K + "\n{\n    int x;\n    std::string label;\n\n"
+             "    static constexpr auto FieldsMeta = std::make_tuple(\n"
+             "        meta::field<&Inner" + K + "::x>(\"x\"),\n"
+             "        meta::field<&Inner" + K + "::label>(\"label\"));\n};\n\n";
+        s += "struct Type" + K + "\n{\n    int id;\n    double ratio;\n    bool enabled;\n    std::string name;\n"
+             "    std::vector<int> values;\n    std::map<std::string, int> counts;\n    std::optional<std::string> note;\n"
+             "    Inner" + K + " inner;\n\n"
+             "    static constexpr auto FieldsMeta = std::make_tuple(\n"
+             "        meta::field<&Type" + K + "::id>(\"id\"),\n"
+             "        meta::field<&Type" + K + "::ratio>(\"ratio\"),\n"
+             "        meta::field<&Type" + K + "::enabled>(\"enabled\"),\n"
+             "        meta::field<&Type" + K + "::name>(\"name\"),\n"
+             "        meta::field<&Type" + K + "::values>(\"values\"),\n"
+             "        meta::field<&Type" + K + "::counts>(\"counts\"),\n"
+             "        meta::field<&Type" + K + "::note>(\"note\"),\n"
+             "        meta::field<&Type" + K + "::inner>(\"inner\"));\n};\n\n";
+        s += "struct Row" + K + "\n{\n    int64_t id;\n    std::string name;\n    double amount;\n    bool paid;\n\n"
+             "    static constexpr auto FieldsMeta = std::make_tuple(\n"
+             "        meta::field<&Row" + K + "::id>(\"id\"),\n"
+             "        meta::field<&Row" + K + "::name>(\"name\"),\n"
+             "        meta::field<&Row" + K + "::amount>(\"amount\"),\n"
+             "        meta::field<&Row" + K + "::paid>(\"paid\"));\n};\n\n"
+             "template <> struct meta::MetaTuple<Row" + K + ">\n{\n"
+             "    static constexpr auto& FieldsMeta = Row" + K + "::FieldsMeta;\n"
+             "    static constexpr auto tableName = \"row" + K + "\";\n};\n\n";
+    }
+    return s;
+}
+
+struct Format
+{
+    const char* name;
+    const char* row;  // "Type" or "Row"
+    const char* list; // META_*_TEMPLATES
+    const char* use;  // statement over a `value` of the type, adding to `n`
+};
+
+const Format formats[] = {
+    {"yaml write", "Type", "META_CORE_TEMPLATES", "n += meta::toYaml(value).size();"},
+    {"yaml read", "Type", "META_CORE_TEMPLATES", "n += meta::reifyFromYaml<T>(std::string_view(text)).second.valid;"},
+    {"json write", "Type", "META_CORE_TEMPLATES", "n += meta::toJson(value).size();"},
+    {"json read", "Type", "META_JSON_TEMPLATES", "n += meta::fromJson<T>(std::string_view(text)).second.valid;"},
+    {"xml write", "Type", "META_CORE_TEMPLATES", "n += meta::toXml(value).size();"},
+    {"binary", "Type", "META_BINARY_TEMPLATES",
+     "n += meta::toBinary(value).size() + meta::fromBinary<T>(text).second.valid;"},
+    {"proto", "Type", "META_PROTO_TEMPLATES",
+     "n += meta::toProto(value).size() + meta::fromProto<T>(text).second.valid;"},
+    {"csv", "Row", "META_CSV_TEMPLATES",
+     "n += meta::toCSV(value).size() + meta::parseCSV<T>(std::string_view(text)).first.size();"},
+    {"sql", "Row", "META_DB_TEMPLATES", "n += meta::insertSQL(value).size() + meta::createTable<T>().size();"},
+};
+
+// One function per type running the given formats on it
+std::string useTypes(int n, const std::vector<const Format*>& used)
+{
+    std::string s;
+    for (const char* row : {"Type", "Row"})
+    {
+        bool any = std::any_of(used.begin(), used.end(), [&](const Format* f) { return std::string(f->row) == row; });
+        if (!any)
+            continue;
+        for (int k = 0; k < n; ++k)
+        {
+            std::string T = row + std::to_string(k);
+            s += "size_t use" + T + "(const std::string& text)\n{\n    using T = " + T + ";\n    T value{};\n    size_t n = 0;\n";
+            for (const Format* f : used)
+                if (std::string(f->row) == row)
+                    s += std::string("    ") + f->use + "\n";
+            s += "    return n;\n}\n\n";
+        }
+    }
+    return s;
+}
+
+std::vector<std::string> templateLists()
+{
+    std::vector<std::string> lists;
+    for (const Format& f : formats)
+        if (std::find(lists.begin(), lists.end(), f.list) == lists.end())
+            lists.push_back(f.list);
+    return lists;
+}
+
+std::string instantiations(int n, const char* macro, const char* terminator = ";")
+{
+    std::string s;
+    for (const std::string& list : templateLists())
+    {
+        bool rows = list == "META_CSV_TEMPLATES" || list == "META_DB_TEMPLATES";
+        for (int k = 0; k < n; ++k)
+            s += std::string(macro) + "(" + list + ", " + (rows ? "Row" : "Type") + std::to_string(k) + ")" + terminator + "\n";
+    }
+    return s;
+}
+
+// ============================================================================
+// Reports
+// ============================================================================
+
+void headers(const Options& options)
+{
+    std::printf("headers, each included on its own\n\n");
+    std::printf("%-18s %9s %11s\n", "header", "s", "object KB");
+    Compile empty = compile(options, "empty", "#include <string>\n");
+    std::printf("%-18s %9.2f %11.1f\n", "(<string> only)", empty.seconds, empty.objectBytes / 1024.0);
+    for (const char* header : {"meta.h", "meta_json.h", "meta_binary.h", "meta_proto.h", "meta_csv.h", "meta_db.h",
+                               "meta_soa.h", "meta_columnar.h", "meta_patch.h", "meta_parallel.h", "meta_lang.h"})
+    {
+        std::string name = fs::path(header).stem().string();
+        Compile c = compile(options, "header_" + name, std::string("#include \"") + header + "\"\n");
+        std::printf("%-18s %9.2f %11.1f\n", header, c.seconds, c.objectBytes / 1024.0);
+    }
+}
+
+void perType(const Options& options)
+{
+    int n = options.types;
+    std::string declarations = std::string(allHeaders) + declareTypes(n);
+    Compile base = compile(options, "types_only", declarations);
+
+    std::printf("\nper reflected type and format, %d types (declaring them alone: %.2f s, %.1f KB)\n\n", n, base.seconds,
+                base.objectBytes / 1024.0);
+    std::printf("%-18s %9s %11s\n", "format", "s/type", "KB/type");
+    for (const Format& f : formats)
+    {
+        std::string name = std::string("format_") + f.name;
+        std::replace(name.begin(), name.end(), ' ', '_');
+        Compile c = compile(options, name, declarations + useTypes(n, {&f}));
+        std::printf("%-18s %9.3f %11.1f\n", f.name, (c.seconds - base.seconds) / n,
+                    (static_cast<double>(c.objectBytes) - static_cast<double>(base.objectBytes)) / 1024.0 / n);
+    }
+}
+
+void externTemplates(const Options& options)
+{
+    int n = options.types;
+    std::vector<const Format*> all;
+    for (const Format& f : formats)
+        all.push_back(&f);
+    std::string declarations = std::string(allHeaders) + declareTypes(n);
+    std::string uses = useTypes(n, all);
+
+    std::string main = "int main()\n{\n    size_t n = 0;\n";
+    for (int k = 0; k < n; ++k)
+    {
+        std::string K = std::to_string(k);
+        main += "    n += useType" + K + "(meta::toJson(Type" + K + "{}));\n";
+        main += "    n += useRow" + K + "(meta::toCSV(Row" + K + "{}));\n";
+    }
+    main += "    return n == 0;\n}\n";
+
+    Compile implicit = compile(options, "consumer_implicit", declarations + uses + main);
+    Compile consumer = compile(options, "consumer_extern",
+                               declarations + instantiations(n, "META_EXTERN_TEMPLATES") + uses + main);
+    Compile provider = compile(options, "provider", declarations + instantiations(n, "META_INSTANTIATE_TEMPLATES"));
+
+    std::printf("\nextern templates, a TU using every format on %d types\n\n", n);
+    std::printf("%-36s %9s %11s\n", "TU", "s", "object KB");
+    std::printf("%-36s %9.2f %11.1f\n", "consumer, instantiating implicitly", implicit.seconds, implicit.objectBytes / 1024.0);
+    std::printf("%-36s %9.2f %11.1f\n", "consumer, META_EXTERN_TEMPLATES", consumer.seconds, consumer.objectBytes / 1024.0);
+    std::printf("%-36s %9.2f %11.1f\n", "META_INSTANTIATE_TEMPLATES, once", provider.seconds, provider.objectBytes / 1024.0);
+    std::printf("\nsaved per consumer TU: %.2f s, %.1f KB\n", implicit.seconds - consumer.seconds,
+                (static_cast<double>(implicit.objectBytes) - static_cast<double>(consumer.objectBytes)) / 1024.0);
+
+    // The extern consumer must link against the instantiating TU alone
+    fs::path exe = workDir / "linked";
+    std::string command = options.cxx + " " + (workDir / "consumer_extern.o").string() + " " +
+                          (workDir / "provider.o").string() + " -o " + exe.string() + " " + options.ldflags;
+    bool linked = std::system(command.c_str()) == 0 && std::system(exe.string().c_str()) == 0;
+    std::printf("consumer + instantiating TU link and run: %s\n", linked ? "ok" : "FAILED");
+    if (!linked)
+        std::exit(1);
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string arg = argv[i];
+        if (arg == "--types")
+            options.types = std::max(1, std::stoi(argv[i + 1]));
+        else if (arg == "--cxx")
+            options.cxx = argv[i + 1];
+        else if (arg == "--flags")
+            options.flags = argv[i + 1];
+        else if (arg == "--ldflags")
+            options.ldflags = argv[i + 1];
+    }
+    fs::create_directories(workDir);
+    std::printf("%s %s\n\n", options.cxx.c_str(), options.flags.c_str());
+
+    headers(options);
+    perType(options);
+    externTemplates(options);
+    return 0;
+}
@@ -0,0 +1,68 @@
+// example_batch.cpp - Streaming whole ranges through one builder and one sink
+#include <cassert>
+#include <deque>
+#include <iostream>
+#include <ranges>
+#include <span>
+
+#include "meta.h"
+#include "meta_csv.h"
+
+struct Order
+{
+    int id;
+    std::string customer;
+    double total;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Order::id>("id"),
+        meta::field<&Order::customer>("customer"),
+        meta::field<&Order::total>("total"));
+};
+
+Order makeOrder(int i)
+{
+    return {i, "customer-" + std::to_string(i % 3), i * 2.5};
+}
+
+int main()
+{
+    std::cout << "Batch serialization\n";
+    std::cout << "===================\n\n";
+
+    std::vector<Order> orders;
+    for (int i = 0; i < 4; ++i)
+        orders.push_back(makeOrder(i));
+
+    // Test 1: Same layout as before, for any container
+    std::cout << "Test 1: serializeJson\n";
+    std::string json = meta::serializeJson(orders);
+    assert(json.starts_with("[\n  {\"id\":0,") && json.ends_with("}\n]\n"));
+    assert(meta::serializeJson(std::deque<Order>(orders.begin(), orders.end())) == json);
+    assert(meta::serializeJson(std::span<const Order>(orders)) == json);
+    assert(meta::serializeJson(std::vector<Order>{}) == "[\n]\n");
+    std::cout << json << "\n";
+
+    // Test 2: Lazy views are serialized without materializing them
+    std::cout << "Test 2: Views\n";
+    auto generated = std::views::iota(0, 4) | std::views::transform(makeOrder);
+    assert(meta::serializeJson(generated) == json);
+    auto large = orders | std::views::filter([](const Order& o) { return o.total > 4; });
+    std::string filtered = meta::toCSVWithHeader(large);
+    assert(filtered == "\"id\",\"customer\",\"total\"\n2,\"customer-2\",5\n3,\"customer-0\",7.5\n");
+    std::cout << filtered << "\n";
+
+    // Test 3: Straight into a sink
+    std::cout << "Test 3: Sinks\n";
+    meta::ChunkSink chunks(64);
+    meta::serialize(generated, chunks);
+    assert(chunks.str() == meta::serialize(orders));
+    assert(chunks.chunks().size() > 1);
+    meta::StringSink csv;
+    meta::serializeAdvanced(orders, csv, ";", false, false);
+    assert(csv.view().starts_with("0;customer-0;0\n"));
+    std::cout << csv.view() << "\n";
+
+    std::cout << "All batch tests passed\n";
+    return 0;
+}
@@ -0,0 +1,171 @@
+// example_binary.cpp - Compact binary encoding: round trips, schema evolution and errors
+#include <cassert>
+#include <iostream>
+
+#include "meta_binary.h"
+
+enum class Status { Active, Suspended, Closed };
+
+constexpr std::array StatusMapping = std::array{
+    std::pair{Status::Active, "active"},
+    std::pair{Status::Suspended, "suspended"},
+    std::pair{Status::Closed, "closed"},
+};
+
+template <> struct meta::EnumMapping<Status>
+{
+    static constexpr auto& mapping = StatusMapping;
+    using Type = meta::EnumTraitsAuto<Status, StatusMapping>;
+};
+
+struct Address
+{
+    std::string city;
+    int zip;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Address::city>("city"),
+        meta::field<&Address::zip>("zip"));
+
+    bool operator==(const Address&) const = default;
+};
+
+struct Customer
+{
+    int64_t id;
+    std::string name;
+    Status status;
+    double balance;
+    float score;
+    std::optional<Address> address;
+    std::vector<std::optional<int>> history;
+    std::map<std::string, Address> branches;
+    std::set<uint16_t> ports;
+    std::variant<int, std::string> ref;
+    std::tuple<bool, char, std::string> extra;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Customer::id>("id"),
+        meta::field<&Customer::name>("name", meta::StringLength<1, 64>{}),
+        meta::field<&Customer::status>("status"),
+        meta::field<&Customer::balance>("balance"),
+        meta::field<&Customer::score>("score"),
+        meta::field<&Customer::address>("address"),
+        meta::field<&Customer::history>("history"),
+        meta::field<&Customer::branches>("branches"),
+        meta::field<&Customer::ports>("ports"),
+        meta::field<&Customer::ref>("ref"),
+        meta::field<&Customer::extra>("extra"));
+};
+
+// Two versions of one message: v2 adds a field and renumbers nothing
+struct ContactV1
+{
+    int id;
+    std::string name;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&ContactV1::id>("id", meta::BinaryTag<1>{}),
+        meta::field<&ContactV1::name>("name", meta::BinaryTag<2>{}));
+};
+
+struct ContactV2
+{
+    std::optional<std::string> email;
+    int id;
+    std::string name;
+    std::vector<std::string> phones;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&ContactV2::email>("email", meta::BinaryTag<7>{}),
+        meta::field<&ContactV2::id>("id", meta::BinaryTag<1>{}, meta::BoundsCheck<0, 1000>{}),
+        meta::field<&ContactV2::name>("name", meta::BinaryTag<2>{}),
+        meta::field<&ContactV2::phones>("phones", meta::BinaryTag<3>{}));
+};
+
+static_assert(meta::BinaryFields<ContactV2>::tags == std::array<uint32_t, 4>{7, 1, 2, 3});
+static_assert(meta::binarySchemaHash<ContactV1>() != meta::binarySchemaHash<ContactV2>());
+static_assert(meta::zigzagEncode(-1) == 1 && meta::zigzagDecode(meta::zigzagEncode(-123456)) == -123456);
+
+int main()
+{
+    std::cout << "Binary encoding\n";
+    std::cout << "===============\n\n";
+
+    // Test 1: Round trip of every supported shape
+    std::cout << "Test 1: Round trip\n";
+    Customer c{-42,
+               "Ada Lovelace",
+               Status::Suspended,
+               -1234.5,
+               0.25f,
+               Address{"London", 12345},
+               {1, std::nullopt, -300},
+               {{"north", {"York", 1}}, {"south", {"Brighton", 2}}},
+               {22, 443, 65535},
+               std::string("ref-7"),
+               {true, 'x', std::string(300, 'z')}};
+
+    std::string bytes = meta::toBinary(c);
+    auto [copy, ok] = meta::fromBinary<Customer>(bytes);
+    assert(ok.valid && copy);
+    assert(meta::checkForEquality(c, *copy));
+    assert(meta::toJson(c) == meta::toJson(*copy));
+    std::string json = meta::toJson(c);
+    std::cout << "  " << bytes.size() << " bytes binary, " << json.size() << " bytes JSON\n\n";
+
+    // Test 2: Fields are matched by tag, unknown ones are skipped
+    std::cout << "Test 2: Schema evolution\n";
+    ContactV2 v2{"ada@example.com", 7, "Ada", {"555-0100"}};
+    auto [old, oldResult] = meta::fromBinary<ContactV1>(meta::toBinary(v2));
+    assert(oldResult.valid && old->id == 7 && old->name == "Ada");
+
+    ContactV1 v1{8, "Bob"};
+    std::string v1Bytes = meta::toBinary(v1);
+    auto [upgraded, upResult] = meta::fromBinary<ContactV2>(v1Bytes);
+    assert(!upResult.valid && upResult.errors.size() == 1 && upResult.errors[0].first == "phones");
+    std::cout << "  v1 -> v2: " << upResult.errors[0].first << ": " << upResult.errors[0].second << "\n";
+
+    assert(meta::binaryFingerprintOf(v1Bytes) == meta::binaryFingerprint<ContactV1>());
+    auto [strict, strictResult] = meta::fromBinary<ContactV1>(meta::toBinary(v2), {.requireSameSchema = true});
+    assert(!strict && strictResult.errors[0].second == "Schema fingerprint mismatch");
+    std::cout << "  fingerprints " << std::hex << meta::binaryFingerprint<ContactV1>() << " / "
+              << meta::binaryFingerprint<ContactV2>() << std::dec << "\n\n";
+
+    // Test 3: Validation attributes and corrupt data
+    std::cout << "Test 3: Errors\n";
+    ContactV2 invalid{std::nullopt, 5000, "Eve", {}};
+    auto [rejected, rejectedResult] = meta::fromBinary<ContactV2>(meta::toBinary(invalid));
+    assert(!rejected && rejectedResult.errors.size() == 1 && rejectedResult.errors[0].first == "id");
+    std::cout << "  " << rejectedResult.errors[0].first << ": " << rejectedResult.errors[0].second << "\n";
+
+    for (size_t cut : {bytes.size() - 1, bytes.size() / 2, size_t(12)})
+    {
+        auto [truncated, result] = meta::fromBinary<Customer>(std::string_view(bytes).substr(0, cut));
+        assert(!truncated && !result.valid);
+        std::cout << "  cut at " << cut << ": " << result.errors.back().first << ": "
+                  << result.errors.back().second << "\n";
+    }
+
+    auto [notBinary, notBinaryResult] = meta::fromBinary<Customer>(json);
+    assert(!notBinary && notBinaryResult.errors[0].first == "binary");
+
+    std::string wrongType = meta::toBinary(std::vector<int64_t>{1, int64_t(1) << 40});
+    auto [narrow, narrowResult] = meta::fromBinary<std::vector<int>>(wrongType);
+    assert(!narrow && narrowResult.errors[0].first == "[1]");
+    std::cout << "  " << narrowResult.errors[0].first << ": " << narrowResult.errors[0].second << "\n\n";
+
+    // Test 4: Large payloads need multi-byte length prefixes
+    std::cout << "Test 4: Large values\n";
+    std::vector<Address> many;
+    for (int i = 0; i < 10000; ++i)
+        many.push_back({"city-" + std::to_string(i), i});
+    meta::StringSink sink;
+    meta::toBinary(many, sink);
+    auto [manyCopy, manyResult] = meta::fromBinary<std::vector<Address>>(sink.view());
+    assert(manyResult.valid && *manyCopy == many);
+    std::cout << "  " << sink.size() << " bytes binary, " << meta::toJson(many).size() << " bytes JSON\n";
+
+    std::cout << "\nAll binary tests passed\n";
+    return 0;
+}
@@ -0,0 +1,235 @@
+// example_builder_pool.cpp - Builders reset and reused across calls, so small documents don't allocate
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "meta.h"
+#include "meta_csv.h"
+#include "meta_json.h"
+
+// Count every heap allocation made by the program (Test 5 allocates from
+// several threads)
+static std::atomic<size_t> allocations = 0;
+
+void* operator new(size_t size)
+{
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+struct Response
+{
+    int32_t id;
+    std::string status;
+    double latency;
+    std::vector<int32_t> codes;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Response::id>("id"),
+        meta::field<&Response::status>("status"),
+        meta::field<&Response::latency>("latency"),
+        meta::field<&Response::codes>("codes"));
+};
+
+// Serializes its payload with toJson while the outer document is being
+// written, so two JSON builders are leased at once
+struct Envelope
+{
+    Response payload;
+
+    struct Ser
+    {
+        template <typename B>
+        static void write(const Envelope& e, B& b)
+        {
+            b.startMap();
+            b.key("payload");
+            b.writeString(meta::toJson(e.payload));
+            b.endMap();
+        }
+    };
+
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&Envelope::payload>("payload"));
+};
+
+// Serializes from its destructor, which runs after the thread's pool has
+// been destroyed when it was constructed first
+struct LateWriter
+{
+    const Response& response;
+    std::atomic<bool>& wrote;
+
+    ~LateWriter()
+    {
+        std::string json = meta::toJson(response);
+        std::string yaml = meta::toYaml(response);
+        wrote = json == R"({"id":42,"status":"ok","latency":1.25,"codes":[200,201,204]})" &&
+                yaml.starts_with("id: 42") && meta::BuilderPool<meta::JsonBuilder>::idleCount() == 0;
+    }
+};
+
+// Heap allocations made by f(); f runs once before counting, so the pools
+// and the output strings have grown to size
+template <typename F>
+size_t allocationsOf(F&& f)
+{
+    f();
+    size_t before = allocations;
+    for (int i = 0; i < 100; ++i)
+        f();
+    return allocations - before;
+}
+
+int main()
+{
+    std::cout << "Builder pool\n";
+    std::cout << "============\n\n";
+
+    const Response response{42, "ok", 1.25, {200, 201, 204}};
+
+    // Test 1: reset() starts a new document on the same buffer
+    std::cout << "Test 1: reset()\n";
+    {
+        meta::JsonBuilder builder;
+        meta::to(std::vector<Response>(50, response), builder);
+        size_t grown = builder.capacity();
+        assert(grown > 2000);
+
+        builder.reset();
+        assert(builder.view().empty());
+        meta::to(response, builder);
+        assert(builder.capacity() == grown && builder.view() == meta::toJson(response));
+
+        meta::XmlBuilder xml;
+        meta::to(response, xml);
+        xml.finish();
+        std::string first(xml.view());
+        xml.reset();
+        meta::to(response, xml);
+        xml.finish();
+        assert(xml.view() == first && first == meta::toXml(response));
+
+        meta::YamlBuilder yaml;
+        meta::to(response, yaml);
+        yaml.reset();
+        meta::to(response, yaml);
+        assert(yaml.view() == meta::toYaml(response));
+
+        meta::CSVBuilder csv;
+        meta::to(response, csv);
+        csv.reset();
+        meta::to(response, csv);
+        assert(csv.view() == meta::toCSV(response));
+        std::cout << "  " << builder.view() << "\n\n";
+    }
+
+    // Test 2: Serializing into the same string again doesn't allocate
+    std::cout << "Test 2: Steady state\n";
+    {
+        std::string out;
+        assert(allocationsOf([&] { meta::toJson(response, out); }) == 0);
+        assert(out == meta::toJson(response));
+        assert(allocationsOf([&] { meta::toXml(response, out); }) == 0);
+        assert(allocationsOf([&] { meta::toCSV(response, out); }) == 0);
+        assert(out == meta::toCSV(response));
+
+        // A returned string allocates itself, and nothing else
+        assert(allocationsOf([&] { return meta::toJson(response); }) == 100);
+
+        // yaml-cpp can't reset an emitter, so YAML keeps the buffer and
+        // stream but still builds one per document
+        size_t fresh = allocationsOf([&] { meta::YamlBuilder yaml; meta::to(response, yaml); });
+        size_t pooled = allocationsOf([&] { meta::toYaml(response, out); });
+        assert(pooled < fresh && out == meta::toYaml(response));
+        std::cout << "  JSON, XML, CSV: 0 allocations per call; YAML: fewer than a fresh builder\n\n";
+    }
+
+    // Test 3: Leases nest, and their builders go back to the pool
+    std::cout << "Test 3: Nesting\n";
+    {
+        using Pool = meta::BuilderPool<meta::JsonBuilder>;
+        std::string outer = meta::toJson(Envelope{response});
+        assert(outer.starts_with(R"({"payload":"{\"id\":42,\"status\":\"ok\",)"));
+        assert(Pool::idleCount() == 2);
+        {
+            auto a = Pool::lease();
+            auto b = Pool::lease();
+            assert(&*a != &*b && Pool::idleCount() == 0);
+            meta::to(response, *a);
+        }
+        // Back reset
+        auto c = Pool::lease();
+        assert(c->view().empty() && Pool::idleCount() == 1);
+        std::cout << "  " << outer << "\n\n";
+    }
+
+    // Test 4: Large documents don't pin their buffers to the pool
+    std::cout << "Test 4: Retain limit\n";
+    {
+        using Pool = meta::BuilderPool<meta::JsonBuilder>;
+        std::vector<Response> many(5000, response);
+        std::string big = meta::toJson(many);
+        assert(big.size() > Pool::retainLimit);
+        {
+            auto a = Pool::lease();
+            auto b = Pool::lease();
+            assert(a->capacity() <= Pool::retainLimit && b->capacity() <= Pool::retainLimit);
+        }
+        assert(Pool::idleCount() == 2);
+        std::cout << "  " << big.size() << " bytes handed over, pooled buffers stay under "
+                  << Pool::retainLimit << "\n\n";
+    }
+
+    // Test 5: Each thread has a pool of its own
+    std::cout << "Test 5: Threads\n";
+    {
+        const std::string expected = meta::toJson(response);
+        std::vector<std::thread> threads;
+        std::vector<int> matches(4, 0);
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back(
+                [&, t]
+                {
+                    std::string out;
+                    for (int i = 0; i < 2000; ++i)
+                    {
+                        meta::toJson(response, out);
+                        matches[t] += out == expected;
+                    }
+                    assert(meta::BuilderPool<meta::JsonBuilder>::idleCount() == 1);
+                });
+        for (auto& thread : threads)
+            thread.join();
+        for (int m : matches)
+            assert(m == 2000);
+        std::cout << "  4 threads x 2000 documents\n\n";
+    }
+
+    // Test 6: Serializing from a thread_local destructor after the pool is gone
+    std::cout << "Test 6: Thread exit\n";
+    {
+        std::atomic<bool> wrote{false};
+        std::thread(
+            [&]
+            {
+                thread_local LateWriter late{response, wrote};
+                meta::toJson(response);
+                meta::toYaml(response);
+            })
+            .join();
+        assert(wrote);
+        std::cout << "  written with builders of its own\n";
+    }
+
+    std::cout << "\nAll builder pool tests passed\n";
+    return 0;
+}
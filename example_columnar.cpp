@@ -0,0 +1,139 @@
+// example_columnar.cpp - Columnar files: typed column views over mmap, schema matching and errors
+#include <cassert>
+#include <iostream>
+#include <numeric>
+
+#include "meta_columnar.h"
+
+enum class Side { Buy, Sell };
+
+constexpr std::array SideMapping = std::array{
+    std::pair{Side::Buy, "buy"},
+    std::pair{Side::Sell, "sell"},
+};
+
+template <> struct meta::EnumMapping<Side>
+{
+    static constexpr auto& mapping = SideMapping;
+    using Type = meta::EnumTraitsAuto<Side, SideMapping>;
+};
+
+struct Trade
+{
+    int64_t id;
+    std::string venue;
+    double price;
+    uint32_t quantity;
+    Side side;
+    bool cancelled;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Trade::id>("id"),
+        meta::field<&Trade::venue>("venue"),
+        meta::field<&Trade::price>("price"),
+        meta::field<&Trade::quantity>("quantity"),
+        meta::field<&Trade::side>("side"),
+        meta::field<&Trade::cancelled>("cancelled"));
+};
+
+// Reads two of Trade's columns, declared in another order
+struct PriceOnly
+{
+    double price;
+    int64_t id;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&PriceOnly::price>("price"),
+        meta::field<&PriceOnly::id>("id"));
+};
+
+struct WrongType
+{
+    float price;
+
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&WrongType::price>("price"));
+};
+
+struct Missing
+{
+    int64_t id;
+    std::string trader;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Missing::id>("id"),
+        meta::field<&Missing::trader>("trader"));
+};
+
+static_assert(meta::ColumnarFields<Trade>::indexOf<&Trade::price>() == 2);
+static_assert(meta::columnKindOf<Side>() == meta::ColumnKind::Enum);
+
+int main()
+{
+    std::cout << "Columnar files\n";
+    std::cout << "==============\n\n";
+
+    std::vector<Trade> trades;
+    for (int i = 0; i < 100000; ++i)
+        trades.push_back({i, i % 3 ? "XNAS" : "XLON-" + std::to_string(i), 100.0 + i * 0.01,
+                          static_cast<uint32_t>(i % 500), i % 2 ? Side::Sell : Side::Buy, i % 97 == 0});
+
+    // Test 1: Round trip in memory
+    std::cout << "Test 1: Round trip\n";
+    std::string bytes = meta::toColumnar(trades);
+    auto [table, ok] = meta::readColumnar<Trade>(bytes);
+    assert(ok.valid && table && table->size() == trades.size());
+    std::vector<Trade> copy = table->rowsVector();
+    for (size_t i = 0; i < trades.size(); ++i)
+        assert(meta::checkForEquality(trades[i], copy[i]));
+    auto [none, noneOk] = meta::readColumnar<Trade>(meta::toColumnar(std::vector<Trade>{}));
+    assert(noneOk.valid && none->empty() && none->column<&Trade::venue>().empty());
+    std::cout << "  " << trades.size() << " rows, " << bytes.size() << " bytes\n\n";
+
+    // Test 2: Scanning single columns of a mapped file
+    std::cout << "Test 2: Mapped column views\n";
+    auto path = std::filesystem::temp_directory_path() / "example_columnar.col";
+    meta::writeColumnarFile(trades, path);
+    assert(std::filesystem::file_size(path) == bytes.size());
+    auto [mapped, mappedOk] = meta::openColumnar<Trade>(path);
+    assert(mappedOk.valid && mapped);
+
+    std::span<const double> prices = mapped->column<&Trade::price>();
+    assert(reinterpret_cast<uintptr_t>(prices.data()) % meta::columnarAlignment == 0);
+    double total = std::accumulate(prices.begin(), prices.end(), 0.0);
+    std::span<const Side> sides = mapped->column<&Trade::side>();
+    auto sells = std::count(sides.begin(), sides.end(), Side::Sell);
+    std::span<const uint8_t> cancelled = mapped->column<&Trade::cancelled>();
+    auto cancels = std::count(cancelled.begin(), cancelled.end(), 1);
+    meta::StringColumn venues = mapped->column<&Trade::venue>();
+    assert(venues.size() == trades.size() && venues[0] == "XLON-0" && venues[1] == "XNAS");
+    assert(sells == 50000 && cancels == 1031);
+    assert(mapped->row(777).price == trades[777].price && mapped->row(99999).venue == trades[99999].venue);
+    std::cout << "  sum(price) = " << total << ", " << sells << " sells, " << cancels << " cancelled\n\n";
+
+    // Test 3: Columns are matched by name and type
+    std::cout << "Test 3: Schema matching\n";
+    auto [prices2, pricesOk] = meta::openColumnar<PriceOnly>(path);
+    assert(pricesOk.valid && prices2->row(5).id == 5 && prices2->row(5).price == trades[5].price);
+
+    auto [wrong, wrongResult] = meta::readColumnar<WrongType>(bytes);
+    assert(!wrong && wrongResult.errors[0].first == "price");
+    std::cout << "  " << wrongResult.errors[0].first << ": " << wrongResult.errors[0].second << "\n";
+    auto [missing, missingResult] = meta::readColumnar<Missing>(bytes);
+    assert(!missing && missingResult.errors.size() == 1 && missingResult.errors[0].first == "trader");
+    std::cout << "  " << missingResult.errors[0].first << ": " << missingResult.errors[0].second << "\n\n";
+
+    // Test 4: Damaged files
+    std::cout << "Test 4: Errors\n";
+    for (size_t cut : {bytes.size() - 1, size_t(200), size_t(20), size_t(3)})
+    {
+        auto [truncated, result] = meta::readColumnar<Trade>(std::string_view(bytes).substr(0, cut));
+        assert(!truncated && !result.valid);
+        std::cout << "  cut at " << cut << ": " << result.errors[0].first << ": " << result.errors[0].second << "\n";
+    }
+    auto [absent, absentResult] = meta::openColumnar<Trade>(path.string() + ".missing");
+    assert(!absent && absentResult.errors[0].first == "columnar");
+    std::filesystem::remove(path);
+
+    std::cout << "\nAll columnar tests passed\n";
+    return 0;
+}
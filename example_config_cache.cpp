@@ -0,0 +1,268 @@
+// example_config_cache.cpp - A config file kept loaded with ConfigCache, reloaded only as far as it changed
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "meta.h"
+#include "meta_config.h"
+
+struct Limits
+{
+    int32_t rps;
+    int32_t burst;
+    std::map<std::string, int32_t> routes;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Limits::rps>("rps", meta::BoundsCheck<1, 100000>{}),
+        meta::field<&Limits::burst>("burst"),
+        meta::field<&Limits::routes>("routes"));
+};
+
+struct Upstream
+{
+    std::string host;
+    int32_t port;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Upstream::host>("host"),
+        meta::field<&Upstream::port>("port"));
+};
+
+struct Config
+{
+    std::string service;
+    Limits limits;
+    std::vector<Upstream> upstreams;
+    std::optional<std::filesystem::path> logDir;
+    std::optional<int32_t> workers = 4;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Config::service>("service"),
+        meta::field<&Config::limits>("limits"),
+        meta::field<&Config::upstreams>("upstreams"),
+        meta::field<&Config::logDir>("logDir"),
+        meta::field<&Config::workers>("workers"));
+};
+
+const std::filesystem::path file = std::filesystem::temp_directory_path() / "example_config_cache.yaml";
+
+// Each write gets a modification time of its own, however fast they come
+void writeConfig(const std::string& text)
+{
+    static auto stamp = std::filesystem::file_time_type::clock::now();
+    std::ofstream(file, std::ios::binary | std::ios::trunc) << text;
+    stamp += std::chrono::seconds(1);
+    std::filesystem::last_write_time(file, stamp);
+}
+
+std::string configText(int rps, const std::string& extraRoute = "")
+{
+    std::string text = "# billing gateway\n"
+                       "service: billing\n"
+                       "limits:\n"
+                       "  rps: " + std::to_string(rps) + "\n"
+                       "  burst: " + std::to_string(rps * 2) + "\n"
+                       "  routes:\n"
+                       "    /pay: 50\n";
+    if (!extraRoute.empty())
+        text += "    " + extraRoute + ": 10\n";
+    text += "upstreams:\n"
+            "- host: pay-1\n"
+            "  port: 9000\n"
+            "- host: pay-2\n"
+            "  port: 9000\n"
+            "logDir: /var/log/billing\n";
+    return text;
+}
+
+int main()
+{
+    std::cout << "Config cache\n";
+    std::cout << "============\n\n";
+
+    // Test 1: Nothing is read or parsed until the file changes
+    std::cout << "Test 1: Unchanged files\n";
+    {
+        writeConfig(configText(100));
+        meta::ConfigCache<Config> config(file);
+        assert(config.version() == 0 && config.get()->workers == 4);
+
+        auto result = config.reload();
+        assert(result.valid && config.version() == 1);
+        auto loaded = config.get();
+        assert(loaded->service == "billing" && loaded->limits.rps == 100 && loaded->upstreams.size() == 2);
+        assert(*loaded->logDir == std::filesystem::path("/var/log/billing") && loaded->workers == 4);
+
+        // Same size and time: not even opened
+        assert(config.reload().valid && config.get() == loaded);
+        // Written again byte for byte: read, hashed, left alone
+        writeConfig(configText(100));
+        assert(config.reload().valid && config.get() == loaded);
+        // Only a comment changed: parsed by no one
+        std::string commented = configText(100);
+        commented.insert(commented.find("upstreams:"), "# two replicas\n");
+        writeConfig(commented);
+        assert(config.reload().valid && config.get() == loaded && config.version() == 1);
+
+        auto stats = config.stats();
+        assert(stats.polls == 4 && stats.fullReads == 1 && stats.notModified == 1 && stats.sameContent == 2);
+        std::cout << "  4 polls, 1 parse, 1 stat-only, 2 skipped by hash\n\n";
+    }
+
+    // Test 2: A change reads only the sections it touched
+    std::cout << "Test 2: Incremental reload\n";
+    {
+        writeConfig(configText(100, "/refund"));
+        meta::ConfigCache<Config> config(file);
+        assert(config.reload().valid);
+        auto before = config.get();
+        assert(before->limits.routes.size() == 2);
+
+        writeConfig(configText(250));
+        assert(config.reload().valid && config.version() == 2);
+        auto after = config.get();
+        auto stats = config.stats();
+        assert(stats.partialReads == 1 && stats.sectionsRead == 1);
+        assert(after->limits.rps == 250 && after->limits.burst == 500);
+        // A route dropped inside the section is gone, not left over
+        assert(after->limits.routes.size() == 1 && after->limits.routes.count("/pay"));
+        // Untouched sections carried over; the old version is still intact
+        assert(after->upstreams[1].host == "pay-2" && after->service == "billing");
+        assert(before->limits.rps == 100 && before->limits.routes.size() == 2);
+
+        // Dropping a top-level key, or aliases, means a full read
+        std::string fewer = configText(250);
+        fewer.erase(fewer.find("logDir:"));
+        writeConfig(fewer);
+        assert(config.reload().valid && !config.get()->logDir && config.stats().fullReads == 2);
+
+        writeConfig("service: billing\nlimits: &l\n  rps: 7\n  burst: 14\n  routes: {}\nupstreams: []\n");
+        assert(config.reload().valid && config.get()->limits.rps == 7 && config.stats().fullReads == 3);
+
+        // In a block scalar, comment-like and blank lines are text
+        std::string banner = "service: |\n  billing\n  # tier 1\n" + configText(250).substr(configText(250).find("limits:"));
+        writeConfig(banner);
+        assert(config.reload().valid && config.get()->service == "billing\n# tier 1\n");
+        banner.replace(banner.find("# tier 1"), 8, "# tier 2");
+        writeConfig(banner);
+        assert(config.reload().valid && config.get()->service == "billing\n# tier 2\n");
+        banner.insert(banner.find("  # tier 2"), "\n");
+        writeConfig(banner);
+        assert(config.reload().valid && config.get()->service == "billing\n\n# tier 2\n");
+        assert(config.stats().partialReads == 3 && config.stats().sameContent == 0);
+        std::cout << "  1 of 4 sections reparsed; removals and aliases fall back to a full read\n\n";
+    }
+
+    // Test 3: Callbacks follow the fields diff() finds changed
+    std::cout << "Test 3: Change callbacks\n";
+    {
+        writeConfig(configText(100));
+        meta::ConfigCache<Config> config(file);
+        std::vector<std::string> calls;
+        std::string lastPatch;
+        config.onChange<&Config::limits>(
+            [&](const Limits& before, const Limits& after)
+            { calls.push_back("limits " + std::to_string(before.rps) + " -> " + std::to_string(after.rps)); });
+        config.onChange<&Config::upstreams>([&](const auto&, const auto& after)
+                                            { calls.push_back("upstreams x" + std::to_string(after.size())); });
+        // Callbacks run without the cache locked
+        config.onChange([&](const Config&, const Config&, std::string_view patch)
+                        { lastPatch = patch; assert(config.stats().polls > 0); });
+
+        assert(config.reload().valid);
+        assert(calls.size() == 2 && calls[0] == "limits 0 -> 100" && calls[1] == "upstreams x2");
+        calls.clear();
+
+        writeConfig(configText(200));
+        assert(config.reload().valid);
+        assert(calls.size() == 1 && calls[0] == "limits 100 -> 200");
+        assert(lastPatch == R"([{"op":"replace","path":"/limits/rps","value":200},)"
+                            R"({"op":"replace","path":"/limits/burst","value":400}])");
+        std::cout << "  " << calls[0] << "\n  " << lastPatch << "\n";
+
+        // A section rewritten to the same values is read, but not published
+        calls.clear();
+        std::string reformatted = configText(200);
+        reformatted.replace(reformatted.find("  rps: 200"), 10, "  rps:   200");
+        writeConfig(reformatted);
+        assert(config.reload().valid && config.version() == 2 && calls.empty());
+        assert(config.stats().partialReads == 2);
+        std::cout << "\n";
+    }
+
+    // Test 4: A bad file never replaces a good version
+    std::cout << "Test 4: Rejected versions\n";
+    {
+        writeConfig(configText(100));
+        meta::ConfigCache<Config> config(file);
+        assert(config.reload().valid);
+        auto good = config.get();
+
+        writeConfig(configText(0));
+        auto result = config.reload();
+        assert(!result.valid && config.get() == good && config.version() == 1);
+        std::cout << "  " << result.errors[0].first << ": " << result.errors[0].second << "\n";
+        // Not skipped as unchanged next time: still read, and still rejected
+        assert(!config.reload().valid && config.stats().failed == 2 && config.stats().notModified == 0);
+
+        writeConfig("service: [billing\n");
+        assert(!config.reload().valid && config.get() == good);
+
+        // The fix is read against the last good version
+        writeConfig(configText(300));
+        assert(config.reload().valid && config.get()->limits.rps == 300 && config.stats().partialReads == 1);
+
+        std::filesystem::remove(file);
+        result = config.reload();
+        assert(!result.valid && result.errors[0].first == "file" && config.get()->limits.rps == 300);
+        std::cout << "\n";
+    }
+
+    // Test 5: Readers on other threads never wait and never see half a version
+    std::cout << "Test 5: Watching\n";
+    {
+        writeConfig(configText(1));
+        meta::ConfigCache<Config> config(file);
+        assert(config.reload().valid);
+        config.watch(std::chrono::milliseconds(1));
+
+        std::atomic<bool> done{false};
+        std::atomic<size_t> torn{0};
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 3; ++i)
+            readers.emplace_back(
+                [&]
+                {
+                    while (!done)
+                    {
+                        auto now = config.get();
+                        torn += now->limits.burst != 2 * now->limits.rps || now->upstreams.size() != 2;
+                    }
+                });
+
+        for (int rps = 2; rps <= 20; ++rps)
+        {
+            writeConfig(configText(rps));
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (config.get()->limits.rps != rps && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            assert(config.get()->limits.rps == rps);
+        }
+        config.stop();
+        done = true;
+        for (auto& reader : readers)
+            reader.join();
+        assert(torn == 0 && config.version() == 20);
+        std::cout << "  19 edits picked up by the watcher, 3 readers, no torn reads\n";
+    }
+
+    std::filesystem::remove(file);
+    std::cout << "\nAll config cache tests passed\n";
+    return 0;
+}
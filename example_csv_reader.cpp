@@ -0,0 +1,168 @@
+// example_csv_reader.cpp - parseCSV: header mapping, quoting, streams and per-row validation
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <sstream>
+
+#include "meta_csv.h"
+
+enum class Level { Junior, Senior, Lead };
+
+constexpr std::array LevelMapping = std::array{
+    std::pair{Level::Junior, "junior"},
+    std::pair{Level::Senior, "senior"},
+    std::pair{Level::Lead, "lead"},
+};
+
+template <> struct meta::EnumMapping<Level>
+{
+    static constexpr auto& mapping = LevelMapping;
+    using Type = meta::EnumTraitsAuto<Level, LevelMapping>;
+};
+
+struct Employee
+{
+    std::string name;
+    int age;
+    double rating;
+    bool remote;
+    Level level;
+    std::optional<std::string> team;
+    uint64_t badge;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Employee::name>("name", meta::CsvColumn{"Full Name"}, meta::StringLength<1, 40>{}),
+        meta::field<&Employee::age>("age", meta::BoundsCheck<16, 99>{}),
+        meta::field<&Employee::rating>("rating"),
+        meta::field<&Employee::remote>("remote"),
+        meta::field<&Employee::level>("level"),
+        meta::field<&Employee::team>("team"),
+        meta::field<&Employee::badge>("badge"));
+};
+
+std::vector<Employee> sample()
+{
+    return {
+        {"Ada Lovelace", 36, 4.5, true, Level::Lead, "Engines", 18151210},
+        {"Smith, \"Bob\"", 41, 3.25, false, Level::Senior, std::nullopt, 42},
+        {"Line\nBreak", 23, 5, true, Level::Junior, "", 2147483647},
+    };
+}
+
+bool same(const std::vector<Employee>& a, const std::vector<Employee>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (!meta::checkForEquality(a[i], b[i]))
+            return false;
+    return true;
+}
+
+int main()
+{
+    std::cout << "Reading CSV\n";
+    std::cout << "===========\n\n";
+
+    // Test 1: What the writers produce reads back
+    std::cout << "Test 1: Round trip\n";
+    const std::vector<Employee> people = sample();
+    const std::string csv = meta::toCSVWithHeader(people);
+    std::cout << csv;
+    auto [loaded, ok] = meta::parseCSV<Employee>(csv);
+    assert(ok.valid && same(loaded, people));
+    std::string semicolons = csv;
+    std::replace(semicolons.begin(), semicolons.end(), ',', ';');
+    auto [semi, semiOk] = meta::parseCSV<Employee>(semicolons, {.delimiter = ';'});
+    assert(semiOk.valid && semi.size() == 3 && semi[1].name == "Smith; \"Bob\"");
+    std::cout << "\n";
+
+    // Test 2: Columns are found by header name
+    std::cout << "Test 2: Header mapping\n";
+    std::string reordered = "\xEF\xBB\xBF"
+                            "badge,level,extra,remote,Full Name,rating,age\r\n"
+                            "7,lead,ignored,1,Grace,4.75,45\r\n"
+                            "\r\n"
+                            "8,junior,,false,\"Linus \"\"T\"\"\",3,22\r\n";
+    auto [mapped, mappedOk] = meta::parseCSV<Employee>(reordered);
+    assert(mappedOk.valid && mapped.size() == 2);
+    assert(mapped[0].name == "Grace" && mapped[0].badge == 7 && mapped[0].remote && !mapped[0].team);
+    assert(mapped[1].name == "Linus \"T\"" && mapped[1].level == Level::Junior && mapped[1].age == 22);
+    auto [headless, headlessOk] = meta::parseCSV<Employee>("Eve,30,1.5,true,senior,Ops,9\n", {.hasHeader = false});
+    assert(headlessOk.valid && headless[0].team == "Ops" && headless[0].badge == 9);
+    std::cout << "  " << mapped[1].name << " from column \"Full Name\"\n\n";
+
+    // Test 3: A stream gives the same rows for any chunk size
+    std::cout << "Test 3: Streams\n";
+    std::vector<Employee> many;
+    for (int i = 0; i < 2000; ++i)
+        many.push_back({"Person \"" + std::to_string(i) + "\", esq.", 20 + i % 50, i * 0.5, i % 2 == 0,
+                        static_cast<Level>(i % 3), i % 5 ? std::optional<std::string>("T\n" + std::to_string(i % 7)) : std::nullopt,
+                        static_cast<uint64_t>(i) * 1000003 % 2147483647});
+    const std::string large = meta::toCSVWithHeader(many);
+    for (size_t chunk : {size_t(1), size_t(7), size_t(4096)})
+    {
+        std::istringstream in(large);
+        auto [streamed, streamOk] = meta::parseCSV<Employee>(in, {}, chunk);
+        assert(streamOk.valid && same(streamed, many));
+    }
+    std::cout << "  " << many.size() << " rows, " << large.size() << " bytes\n\n";
+
+    // Test 4: Bad rows are dropped and reported
+    std::cout << "Test 4: Errors\n";
+    std::string bad = "Full Name,age,rating,remote,level,team,badge\n"
+                      ",30,1,true,lead,,1\n"
+                      "Kim,12,1,true,lead,,2\n"
+                      "Lee,x,1,yes,boss,,3\n"
+                      "Max,30,1,true\n"
+                      "\"Ned\"x,30,1,true,lead,,4\n"
+                      "Ok,30,1,true,lead,,-5\n"
+                      "Fine,30,1,true,lead,,6\n";
+    auto [kept, badResult] = meta::parseCSV<Employee>(bad);
+    assert(!badResult.valid && kept.size() == 1 && kept[0].name == "Fine");
+    for (const auto& [path, message] : badResult.errors)
+        std::cout << "  " << path << ": " << message << "\n";
+    assert(badResult.errors[0].first == "[0].name" && badResult.errors[1].first == "[1].age");
+    assert(badResult.errors[2].first == "[2].age" && badResult.errors.back().first == "[5].badge");
+
+    auto [none, missingResult] = meta::parseCSV<Employee>("name,age\nAda,36\n");
+    assert(none.empty() && missingResult.errors[0].first == "name");
+    std::cout << "  " << missingResult.errors[0].first << ": " << missingResult.errors[0].second << "\n\n";
+
+    // Test 5: A quote still open at the end of the input is an error, not a short read
+    std::cout << "Test 5: Unterminated quotes\n";
+    const std::string header = "Full Name,age,rating,remote,level,team,badge\n";
+    for (const std::string& tail : {std::string("Al,30,1,true,lead,,1\n\"Bo,30,1,true,lead,,2\nCy,30,1,true,lead,,3\n"),
+                                    std::string("Al,30,1,true,lead,,1\n\"Bo\"\"")})
+    {
+        const std::string text = header + tail;
+        auto [cut, cutResult] = meta::parseCSV<Employee>(text);
+        assert(!cutResult.valid && cut.size() == 1 && cutResult.errors.size() == 1);
+        assert(cutResult.errors[0].first == "[1]" && cutResult.errors[0].second == "Unterminated quoted field");
+        for (size_t chunk : {size_t(1), size_t(4), size_t(4096)})
+        {
+            std::istringstream in(text);
+            auto [streamed, streamResult] = meta::parseCSV<Employee>(in, {}, chunk);
+            assert(!streamResult.valid && streamed.size() == 1 && streamResult.errors == cutResult.errors);
+        }
+    }
+    auto [noHeader, noHeaderResult] = meta::parseCSV<Employee>("\"Full Name,age\n");
+    assert(noHeader.empty() && !noHeaderResult.valid && noHeaderResult.errors.size() == 1);
+    {
+        meta::FailFast quick;
+        auto [first, firstResult] = meta::parseCSV<Employee>(header + "\"Al\n");
+        assert(first.empty() && firstResult.errors.size() == 1);
+    }
+    // Input handed to the reader but never completed is reported by finish()
+    meta::CSVReader<Employee> reader({});
+    std::string partial = header + "Al,30,1,true,lead,\"Ops";
+    reader.consume(partial.data(), partial.data() + partial.size(), false);
+    auto [unread, unreadResult] = reader.finish();
+    assert(unread.empty() && !unreadResult.valid);
+    auto [opened, openResult] = meta::parseCSV<Employee>(header + "\"Bo,30\n");
+    std::cout << "  " << openResult.errors[0].first << ": " << openResult.errors[0].second << "\n";
+    std::cout << "  " << unreadResult.errors[0].second << "\n";
+
+    std::cout << "\nAll CSV reader tests passed\n";
+    return 0;
+}
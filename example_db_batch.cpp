@@ -0,0 +1,113 @@
+// example_db_batch.cpp - Parameterized INSERT statements, field binding and multi-row batches
+#include <cassert>
+#include <iostream>
+#include <variant>
+
+#include "meta_db.h"
+
+enum class Role { Admin, User };
+
+constexpr std::array RoleMapping = std::array{
+    std::pair{Role::Admin, "admin"},
+    std::pair{Role::User, "user"},
+};
+
+template <> struct meta::EnumMapping<Role>
+{
+    static constexpr auto& mapping = RoleMapping;
+    using Type = meta::EnumTraitsAuto<Role, RoleMapping>;
+};
+
+struct Account
+{
+    int64_t id;
+    std::string email;
+    double balance;
+    bool active;
+    Role role;
+    std::optional<std::string> note;
+
+    static constexpr auto tableName = "accounts";
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Account::id>("id"),
+        meta::field<&Account::email>("email", meta::SqlColumn{"email_address"}),
+        meta::field<&Account::balance>("balance"),
+        meta::field<&Account::active>("active"),
+        meta::field<&Account::role>("role"),
+        meta::field<&Account::note>("note"));
+};
+
+// Records each bound parameter, as a database driver would receive it
+struct RecordingBinder
+{
+    using Value = std::variant<std::monostate, int64_t, double, std::string>;
+    std::vector<std::pair<int, Value>> params;
+
+    void bindNull(int i) { params.emplace_back(i, std::monostate{}); }
+    void bindInt(int i, int64_t v) { params.emplace_back(i, v); }
+    void bindDouble(int i, double v) { params.emplace_back(i, v); }
+    void bindText(int i, std::string_view v) { params.emplace_back(i, std::string(v)); }
+};
+
+// The statement text is a constant expression for constexpr field tables
+static_assert(meta::InsertStatementText<Account, meta::SqlParamStyle::Question>::size() ==
+              std::string_view("INSERT INTO accounts (id, email_address, balance, active, role, note) "
+                               "VALUES (?, ?, ?, ?, ?, ?)").size());
+
+int main()
+{
+    std::cout << "Prepared inserts\n";
+    std::cout << "================\n\n";
+
+    // Test 1: One statement per type
+    std::cout << "Test 1: Statements\n";
+    std::string_view sql = meta::insertStatement<Account>();
+    std::cout << "  " << sql << "\n";
+    assert(sql == "INSERT INTO accounts (id, email_address, balance, active, role, note) VALUES (?, ?, ?, ?, ?, ?)");
+    assert(meta::insertStatement<Account>().data() == sql.data());
+    std::string_view pg = meta::insertStatement<Account, meta::SqlParamStyle::Dollar>();
+    assert(pg.ends_with("VALUES ($1, $2, $3, $4, $5, $6)"));
+    std::string two = meta::insertStatement<Account>(2, meta::SqlParamStyle::Dollar);
+    std::cout << "  " << two << "\n";
+    assert(two.ends_with("($1, $2, $3, $4, $5, $6), ($7, $8, $9, $10, $11, $12)"));
+    std::cout << "\n";
+
+    // Test 2: Values are bound by type, not formatted into the SQL
+    std::cout << "Test 2: Binding\n";
+    Account alice{9000000000, "o'brien@example.com", 12.5, true, Role::Admin, std::nullopt};
+    RecordingBinder binder;
+    int next = meta::bindFields(alice, binder);
+    assert(next == 7 && binder.params.size() == 6);
+    assert(std::get<int64_t>(binder.params[0].second) == 9000000000);
+    assert(std::get<std::string>(binder.params[1].second) == "o'brien@example.com");
+    assert(std::get<double>(binder.params[2].second) == 12.5);
+    assert(std::get<int64_t>(binder.params[3].second) == 1);
+    assert(std::get<std::string>(binder.params[4].second) == "admin");
+    assert(std::holds_alternative<std::monostate>(binder.params[5].second) && binder.params[5].first == 6);
+    std::cout << "  6 parameters, quote kept as data\n\n";
+
+    // Test 3: Batches
+    std::cout << "Test 3: Batch insert\n";
+    std::vector<Account> accounts;
+    for (int i = 0; i < 250; ++i)
+        accounts.push_back({i, "user" + std::to_string(i) + "@example.com", i * 1.5, i % 2 == 0, Role::User,
+                            i % 3 ? std::optional<std::string>("n" + std::to_string(i)) : std::nullopt});
+    std::vector<std::string> statements;
+    size_t bound = 0;
+    int64_t lastId = -1;
+    size_t count = meta::insertBatch(accounts, [&](std::string_view text, auto&& bind)
+    {
+        statements.emplace_back(text);
+        RecordingBinder b;
+        bind(b);
+        bound += b.params.size();
+        lastId = std::get<int64_t>(b.params[b.params.size() - 6].second);
+    }, {.rowsPerStatement = 100});
+    assert(count == 3 && statements.size() == 3);
+    assert(statements[0] == statements[1] && statements[2] == meta::insertStatement<Account>(50));
+    assert(bound == 250 * 6 && lastId == 249);
+    std::cout << "  " << accounts.size() << " rows in " << count << " statements, " << bound << " parameters\n";
+
+    std::cout << "\nAll prepared insert tests passed\n";
+    return 0;
+}
@@ -0,0 +1,120 @@
+// example_db_copy.cpp - COPY ... FROM STDIN streams in text and binary format
+#include <cassert>
+#include <iostream>
+
+#include "meta_db.h"
+
+enum class Side { Buy, Sell };
+
+constexpr std::array SideMapping = std::array{
+    std::pair{Side::Buy, "buy"},
+    std::pair{Side::Sell, "sell"},
+};
+
+template <> struct meta::EnumMapping<Side>
+{
+    static constexpr auto& mapping = SideMapping;
+    using Type = meta::EnumTraitsAuto<Side, SideMapping>;
+};
+
+struct Fill
+{
+    int64_t id;
+    int quantity;
+    double price;
+    float fee;
+    bool settled;
+    std::string venue;
+    Side side;
+    std::optional<std::string> note;
+
+    static constexpr auto tableName = "fills";
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Fill::id>("id"),
+        meta::field<&Fill::quantity>("quantity", meta::SqlColumn{"qty"}),
+        meta::field<&Fill::price>("price"),
+        meta::field<&Fill::fee>("fee"),
+        meta::field<&Fill::settled>("settled"),
+        meta::field<&Fill::venue>("venue"),
+        meta::field<&Fill::side>("side"),
+        meta::field<&Fill::note>("note"));
+};
+
+// Reads the big-endian integer at p
+uint64_t readBig(std::string_view bytes, size_t& p, int width)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < width; ++i)
+        v = v << 8 | static_cast<unsigned char>(bytes[p++]);
+    return v;
+}
+
+int main()
+{
+    std::cout << "COPY streams\n";
+    std::cout << "============\n\n";
+
+    const std::vector<Fill> fills = {
+        {1, 100, 10.25, 0.5f, true, "NYSE", Side::Buy, std::nullopt},
+        {9000000000, -3, 0.1, 0, false, "tab\there\\new\nline", Side::Sell, "late"},
+    };
+
+    // Test 1: Statements
+    std::cout << "Test 1: Statements\n";
+    std::cout << "  " << meta::copyStatement<Fill>() << "\n";
+    assert(meta::copyStatement<Fill>() == "COPY fills (id, qty, price, fee, settled, venue, side, note) FROM STDIN");
+    assert(meta::copyStatement<Fill>(meta::CopyFormat::Binary).ends_with("FROM STDIN WITH (FORMAT binary)"));
+    std::cout << "\n";
+
+    // Test 2: Text format
+    std::cout << "Test 2: Text\n";
+    meta::StringSink text;
+    size_t written = meta::writeCopy(fills, text);
+    std::string copy = text.take();
+    std::cout << copy;
+    assert(written == 2);
+    assert(copy == "1\t100\t10.25\t0.5\tt\tNYSE\tbuy\t\\N\n"
+                   "9000000000\t-3\t0.1\t0\tf\ttab\\there\\\\new\\nline\tsell\tlate\n");
+    std::cout << "\n";
+
+    // Test 3: Binary format
+    std::cout << "Test 3: Binary\n";
+    meta::StringSink binary;
+    meta::writeCopy(fills, binary, meta::CopyFormat::Binary);
+    std::string bytes = binary.take();
+    assert(bytes.compare(0, 11, std::string("PGCOPY\n\377\r\n\0", 11)) == 0);
+    size_t p = 19;
+    assert(readBig(bytes, p, 2) == 8);
+    assert(readBig(bytes, p, 4) == 8 && readBig(bytes, p, 8) == 1);                   // int8
+    assert(readBig(bytes, p, 4) == 4 && readBig(bytes, p, 4) == 100);                 // int4
+    assert(readBig(bytes, p, 4) == 8 && readBig(bytes, p, 8) == std::bit_cast<uint64_t>(10.25));
+    assert(readBig(bytes, p, 4) == 4 && readBig(bytes, p, 4) == std::bit_cast<uint32_t>(0.5f));
+    assert(readBig(bytes, p, 4) == 1 && bytes[p++] == 1);                             // bool
+    assert(readBig(bytes, p, 4) == 4 && bytes.substr(p, 4) == "NYSE");
+    p += 4;
+    assert(readBig(bytes, p, 4) == 3 && bytes.substr(p, 3) == "buy");
+    p += 3;
+    assert(readBig(bytes, p, 4) == 0xFFFFFFFF);                                       // NULL
+    assert(bytes.substr(bytes.size() - 2) == "\xFF\xFF");
+    std::cout << "  " << bytes.size() << " bytes for " << fills.size() << " rows\n\n";
+
+    // Test 4: Constant memory through a CallbackSink
+    std::cout << "Test 4: Streaming\n";
+    std::vector<Fill> many(10000, fills[1]);
+    size_t blocks = 0, total = 0, largest = 0;
+    meta::CallbackSink sink([&](std::string_view block)
+    {
+        ++blocks;
+        total += block.size();
+        largest = std::max(largest, block.size());
+    }, 4096);
+    meta::CopyWriter<Fill> writer(sink, meta::CopyFormat::Binary);
+    for (const Fill& f : many)
+        writer.write(f);
+    writer.finish();
+    assert(writer.rows() == many.size() && largest <= 4096);
+    std::cout << "  " << total << " bytes in " << blocks << " blocks of at most " << largest << "\n";
+
+    std::cout << "\nAll COPY tests passed\n";
+    return 0;
+}
@@ -0,0 +1,175 @@
+// example_db_rows.cpp - mapRows: query results into structs through typed cell accessors
+#include <cassert>
+#include <iostream>
+#include <variant>
+
+#include "meta_db.h"
+
+enum class Tier { Free, Pro };
+
+constexpr std::array TierMapping = std::array{
+    std::pair{Tier::Free, "free"},
+    std::pair{Tier::Pro, "pro"},
+};
+
+template <> struct meta::EnumMapping<Tier>
+{
+    static constexpr auto& mapping = TierMapping;
+    using Type = meta::EnumTraitsAuto<Tier, TierMapping>;
+};
+
+struct Customer
+{
+    int64_t id;
+    std::string name;
+    double credit;
+    bool active;
+    Tier tier;
+    std::optional<int> age;
+    uint8_t flags;
+
+    static constexpr auto tableName = "customers";
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Customer::id>("id"),
+        meta::field<&Customer::name>("name", meta::SqlColumn{"full_name"}, meta::StringLength<1, 20>{}),
+        meta::field<&Customer::credit>("credit"),
+        meta::field<&Customer::active>("active"),
+        meta::field<&Customer::tier>("tier"),
+        meta::field<&Customer::age>("age"),
+        meta::field<&Customer::flags>("flags"));
+};
+
+// Character-typed columns: range-checked as the integers they are
+struct Grade
+{
+    char letter;
+    int8_t delta;
+    std::optional<signed char> bonus;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Grade::letter>("letter"),
+        meta::field<&Grade::delta>("delta"),
+        meta::field<&Grade::bonus>("bonus"));
+};
+
+// An in-memory result set with the accessors a driver wrapper would have
+class MemoryResult
+{
+  public:
+    using Cell = std::variant<std::monostate, int64_t, double, std::string>;
+
+    MemoryResult(std::vector<std::string> columns, std::vector<std::vector<Cell>> rows)
+        : columns(std::move(columns)), rows(std::move(rows))
+    {
+    }
+
+    int columnCount() const { return static_cast<int>(columns.size()); }
+    std::string_view columnName(int c) const { return columns[c]; }
+    bool next() { return ++current < rows.size(); }
+    bool isNull(int c) const { return std::holds_alternative<std::monostate>(cell(c)); }
+    int64_t getInt(int c) const { return std::get<int64_t>(cell(c)); }
+    double getDouble(int c) const
+    {
+        return std::holds_alternative<double>(cell(c)) ? std::get<double>(cell(c)) : static_cast<double>(getInt(c));
+    }
+    std::string_view getText(int c) const { return std::get<std::string>(cell(c)); }
+
+  private:
+    std::vector<std::string> columns;
+    std::vector<std::vector<Cell>> rows;
+    size_t current = size_t(-1);
+
+    const Cell& cell(int c) const { return rows[current][c]; }
+};
+
+// The same, reporting its size up front like PQntuples
+class CountedResult : public MemoryResult
+{
+    size_t count;
+
+  public:
+    CountedResult(std::vector<std::string> columns, std::vector<std::vector<Cell>> rows)
+        : MemoryResult(std::move(columns), rows), count(rows.size())
+    {
+    }
+    size_t rowCount() const { return count; }
+};
+
+int main()
+{
+    std::cout << "Mapping result rows\n";
+    std::cout << "===================\n\n";
+
+    using Cell = MemoryResult::Cell;
+    std::vector<std::string> columns = {"ID", "full_name", "tier", "credit", "active", "age", "flags", "created_at"};
+
+    // Test 1: Columns are matched by name, in any order
+    std::cout << "Test 1: Mapping\n";
+    MemoryResult result(columns, {
+        {int64_t{1}, std::string("Ada"), std::string("pro"), 12.5, int64_t{1}, int64_t{36}, int64_t{3}, std::string("2024")},
+        {int64_t{9000000000}, std::string("Grace"), std::string("free"), int64_t{0}, int64_t{0}, Cell{}, int64_t{0}, Cell{}},
+    });
+    auto [customers, ok] = meta::mapRows<Customer>(result);
+    assert(ok.valid && customers.size() == 2);
+    assert(customers[0].name == "Ada" && customers[0].tier == Tier::Pro && customers[0].age == 36);
+    assert(customers[1].id == 9000000000 && !customers[1].age && customers[1].credit == 0 && !customers[1].active);
+    for (const auto& c : customers)
+        std::cout << "  " << c.id << " " << c.name << " credit " << c.credit << "\n";
+    std::cout << "\n";
+
+    // Test 2: Rows are reserved ahead
+    std::cout << "Test 2: Reserve\n";
+    std::vector<std::vector<Cell>> many;
+    for (int i = 0; i < 1000; ++i)
+        many.push_back({int64_t{i}, "c" + std::to_string(i), std::string("free"), i * 0.5, int64_t{1}, Cell{},
+                        int64_t{i % 7}, Cell{}});
+    CountedResult counted(columns, many);
+    auto [reserved, reservedOk] = meta::mapRows<Customer>(counted);
+    assert(reservedOk.valid && reserved.size() == 1000 && reserved.capacity() == 1000);
+    MemoryResult uncounted(columns, many);
+    auto [hinted, hintedOk] = meta::mapRows<Customer>(uncounted, {.expectedRows = 1000});
+    assert(hintedOk.valid && hinted.capacity() == 1000);
+    std::cout << "  " << reserved.size() << " rows, capacity " << reserved.capacity() << "\n\n";
+
+    // Test 3: Bad cells and missing columns
+    std::cout << "Test 3: Errors\n";
+    MemoryResult bad(columns, {
+        {int64_t{1}, std::string(""), std::string("pro"), 1.0, int64_t{1}, Cell{}, int64_t{0}, Cell{}},
+        {int64_t{2}, std::string("Bo"), std::string("gold"), 1.0, int64_t{1}, Cell{}, int64_t{300}, Cell{}},
+        {Cell{}, std::string("Cy"), std::string("pro"), 1.0, int64_t{1}, Cell{}, int64_t{0}, Cell{}},
+        {int64_t{4}, std::string("Di"), std::string("pro"), 1.0, int64_t{1}, Cell{}, int64_t{0}, Cell{}},
+    });
+    auto [kept, badResult] = meta::mapRows<Customer>(bad);
+    for (const auto& [path, message] : badResult.errors)
+        std::cout << "  " << path << ": " << message << "\n";
+    assert(!badResult.valid && kept.size() == 1 && kept[0].id == 4);
+    assert(badResult.errors.size() == 4 && badResult.errors[0].first == "[0].name");
+    assert(badResult.errors[1].first == "[1].tier" && badResult.errors[2].second == "Value out of range");
+    assert(badResult.errors[3].first == "[2].id" && badResult.errors[3].second == "Unexpected NULL");
+
+    MemoryResult partial({"id", "name"}, {{int64_t{1}, std::string("x")}});
+    auto [none, missingResult] = meta::mapRows<Customer>(partial);
+    assert(none.empty() && missingResult.errors[0].first == "name");
+    std::cout << "  " << missingResult.errors[0].first << ": " << missingResult.errors[0].second << "\n";
+
+    std::cout << "\n";
+
+    // Test 4: char and int8_t columns
+    std::cout << "Test 4: Character-typed columns\n";
+    MemoryResult grades({"letter", "delta", "bonus"}, {
+        {int64_t{'A'}, int64_t{-128}, int64_t{5}},
+        {int64_t{'B'}, int64_t{127}, Cell{}},
+        {int64_t{'C'}, int64_t{128}, Cell{}},
+        {int64_t{'D'}, int64_t{0}, int64_t{-200}},
+    });
+    auto [graded, gradeResult] = meta::mapRows<Grade>(grades);
+    assert(graded.size() == 2 && graded[0].letter == 'A' && graded[0].delta == -128 && graded[0].bonus == 5);
+    assert(graded[1].letter == 'B' && graded[1].delta == 127 && !graded[1].bonus);
+    assert(gradeResult.errors.size() == 2 && gradeResult.errors[0].first == "[2].delta" &&
+           gradeResult.errors[1].first == "[3].bonus" && gradeResult.errors[1].second == "Value out of range");
+    std::cout << "  " << graded[0].letter << graded[1].letter << " read; "
+              << gradeResult.errors[0].first << ", " << gradeResult.errors[1].first << " out of range\n";
+
+    std::cout << "\nAll row mapping tests passed\n";
+    return 0;
+}
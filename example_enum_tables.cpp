@@ -0,0 +1,124 @@
+// example_enum_tables.cpp - EnumTraitsAuto lookups are compile-time tables
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+
+#include "meta.h"
+#include "meta_json.h"
+
+enum class Color { Red, Green, Blue };
+
+constexpr std::array ColorMapping = std::array{
+    std::pair{Color::Red, "red"},
+    std::pair{Color::Green, "green"},
+    std::pair{Color::Blue, "blue"},
+};
+
+template <> struct meta::EnumMapping<Color>
+{
+    static constexpr auto& mapping = ColorMapping;
+    using Type = meta::EnumTraitsAuto<Color, ColorMapping>;
+};
+
+// Values far apart - looked up by binary search instead of a dense array
+enum class Status : int64_t { Failed = -1000000000000, Pending = 0, Done = 7, Archived = 1LL << 40 };
+
+constexpr std::array StatusMapping = std::array{
+    std::pair{Status::Archived, "archived"},
+    std::pair{Status::Failed, "failed"},
+    std::pair{Status::Done, "done"},
+    std::pair{Status::Pending, "pending"},
+    std::pair{Status::Done, "complete"}, // alias: reads as Done, Done writes as "done"
+};
+
+template <> struct meta::EnumMapping<Status>
+{
+    static constexpr auto& mapping = StatusMapping;
+    using Type = meta::EnumTraitsAuto<Status, StatusMapping>;
+};
+
+enum class Flag : uint8_t { None = 0, Low = 1, High = 255 };
+
+constexpr std::array FlagMapping = std::array{
+    std::pair{Flag::None, "none"},
+    std::pair{Flag::Low, "low"},
+    std::pair{Flag::High, "high"},
+};
+
+template <> struct meta::EnumMapping<Flag>
+{
+    static constexpr auto& mapping = FlagMapping;
+    using Type = meta::EnumTraitsAuto<Flag, FlagMapping>;
+};
+
+using ColorTraits = meta::EnumMapping<Color>::Type;
+using StatusTraits = meta::EnumMapping<Status>::Type;
+using FlagTraits = meta::EnumMapping<Flag>::Type;
+
+// Every lookup is a constant expression
+static_assert(ColorTraits::name(Color::Green) == "green");
+static_assert(ColorTraits::fromString("blue") == Color::Blue);
+static_assert(!ColorTraits::fromString("Blue"));
+static_assert(ColorTraits::name(static_cast<Color>(9)).empty());
+static_assert(ColorTraits::validValuesView() == "red, green, blue");
+static_assert(StatusTraits::name(Status::Failed) == "failed");
+static_assert(StatusTraits::name(Status::Done) == "done");
+static_assert(StatusTraits::fromString("complete") == Status::Done);
+static_assert(!StatusTraits::contains(static_cast<Status>(8)));
+static_assert(FlagTraits::name(Flag::High) == "high");
+static_assert(FlagTraits::fromString("low") == Flag::Low);
+
+struct Ticket
+{
+    Color color;
+    Status status;
+    Flag flag;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Ticket::color>("color"),
+        meta::field<&Ticket::status>("status"),
+        meta::field<&Ticket::flag>("flag"));
+};
+
+int main()
+{
+    std::cout << "Enum lookup tables\n";
+    std::cout << "==================\n\n";
+
+    // Test 1: Name and value lookups
+    std::cout << "Test 1: Lookups\n";
+    for (auto [value, name] : StatusMapping)
+        assert(StatusTraits::fromString(name) == value);
+    assert(StatusTraits::toString(Status::Archived) == "archived");
+    assert(StatusTraits::toString(static_cast<Status>(1)).empty());
+    assert(meta::toEnum<Color>(std::string("red")) == Color::Red);
+    assert(meta::enumValues<Flag>().size() == 3);
+    using meta::operator<<;
+    std::ostringstream os;
+    os << Color::Blue << " " << Status::Failed << " " << Flag::High;
+    assert(os.str() == "blue failed high");
+    std::cout << "  " << os.str() << "\n";
+    std::cout << "  valid statuses: " << StatusTraits::validValues() << "\n\n";
+
+    // Test 2: Round trip through JSON
+    std::cout << "Test 2: JSON\n";
+    Ticket ticket{Color::Green, Status::Archived, Flag::High};
+    std::string json = meta::toJson(ticket);
+    std::cout << "  " << json << "\n";
+    assert(json == R"({"color":"green","status":"archived","flag":"high"})");
+    auto [copy, ok] = meta::fromJson<Ticket>(R"({"color":"blue","status":"complete","flag":"none"})");
+    assert(ok.valid && copy->color == Color::Blue && copy->status == Status::Done && copy->flag == Flag::None);
+    std::cout << "\n";
+
+    // Test 3: Unknown names list the valid ones
+    std::cout << "Test 3: Errors\n";
+    auto [none, bad] = meta::fromJson<Ticket>(R"({"color":"purple","status":"done","flag":"low"})");
+    assert(!none && !bad.valid);
+    std::cout << "  " << bad.errors[0].first << ": " << bad.errors[0].second << "\n";
+    assert(bad.errors[0].first == "color");
+    assert(bad.errors[0].second == "Unknown enum value: 'purple'. Valid values are: red, green, blue");
+
+    std::cout << "\nAll enum table tests passed\n";
+    return 0;
+}
@@ -0,0 +1,84 @@
+// example_escaping.cpp - JSON and XML builders escape strings and keys
+#include <cassert>
+#include <iostream>
+#include <map>
+
+#include "meta.h"
+#include "meta_json.h"
+
+struct Note
+{
+    std::string title;
+    std::string body;
+    std::map<std::string, int> tags;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Note::title>("title"),
+        meta::field<&Note::body>("body", meta::JsonColumn{"body\ttext"}),
+        meta::field<&Note::tags>("tags"));
+};
+
+// Constant-expression key fragments follow the same rules as writeString
+static_assert(meta::jsonEscapedSize("a\"b\n\x01") == 1 + 2 + 1 + 2 + 6);
+
+std::string json(std::string_view s)
+{
+    meta::StringSink sink;
+    meta::writeJsonEscaped(sink, s);
+    return sink.take();
+}
+
+std::string xml(std::string_view s)
+{
+    meta::StringSink sink;
+    meta::writeXmlEscaped(sink, s);
+    return sink.take();
+}
+
+int main()
+{
+    std::cout << "String escaping\n";
+    std::cout << "===============\n\n";
+
+    // Test 1: JSON escapes
+    std::cout << "Test 1: JSON\n";
+    assert(json("plain text") == "plain text");
+    assert(json("say \"hi\"") == "say \\\"hi\\\"");
+    assert(json("C:\\path") == "C:\\\\path");
+    assert(json("a\nb\tc\r\b\f") == "a\\nb\\tc\\r\\b\\f");
+    assert(json(std::string("\x01\x1f\0", 3)) == "\\u0001\\u001f\\u0000");
+    assert(json("caf\xc3\xa9 \x7f") == "caf\xc3\xa9 \x7f");
+    // Escapes on either side of the 16-byte blocks
+    std::string longText = std::string(15, 'x') + "\"" + std::string(16, 'y') + "\n";
+    assert(json(longText) == std::string(15, 'x') + "\\\"" + std::string(16, 'y') + "\\n");
+
+    Note note{"Quote \"this\"", "line 1\nline 2\\", {{"k\"ey", 1}, {"new\nline", 2}}};
+    std::string doc = meta::toJson(note);
+    std::cout << "  " << doc << "\n";
+    assert(doc == R"({"title":"Quote \"this\"","body\ttext":"line 1\nline 2\\","tags":{"k\"ey":1,"new\nline":2}})");
+    std::cout << "\n";
+
+    // Test 2: Every byte survives toJson -> fromJson
+    std::cout << "Test 2: Round trip\n";
+    std::string all;
+    for (int c = 1; c < 256; ++c)
+        all += static_cast<char>(c);
+    std::vector<std::string> strings{all, "", "\"", "\\\\\\", std::string(40, '"'), longText};
+    auto [copy, ok] = meta::fromJson<std::vector<std::string>>(meta::toJson(strings));
+    assert(ok.valid && *copy == strings);
+    std::cout << "  " << strings.size() << " strings, " << all.size() << " distinct bytes\n\n";
+
+    // Test 3: XML text
+    std::cout << "Test 3: XML\n";
+    assert(xml("plain text") == "plain text");
+    assert(xml("a < b && c > d") == "a &lt; b &amp;&amp; c &gt; d");
+    assert(xml("\"it's\"") == "&quot;it&apos;s&quot;");
+    assert(xml("tab\tnew\nline\r") == "tab\tnew\nline\r");
+    assert(xml("bell\x07") == "bell&#x07;");
+    std::string x = meta::toXml(Note{"<b>bold</b> & more", "", {}});
+    assert(x.find("&lt;b&gt;bold&lt;/b&gt; &amp; more") != std::string::npos);
+    std::cout << "  " << xml("if (a < b && c > d)") << "\n";
+
+    std::cout << "\nAll escaping tests passed\n";
+    return 0;
+}
@@ -0,0 +1,107 @@
+// example_extern_templates.cpp - Declaring a type's serializers extern and instantiating them once
+//
+// In a real build the META_EXTERN_TEMPLATES lines sit in the header that
+// declares the type and the META_INSTANTIATE_TEMPLATES lines in one .cpp;
+// here both are in one TU (make bench-compile links them as two).
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "meta.h"
+#include "meta_binary.h"
+#include "meta_csv.h"
+#include "meta_db.h"
+#include "meta_json.h"
+#include "meta_proto.h"
+
+struct Endpoint
+{
+    std::string host;
+    int port;
+    std::vector<std::string> tags;
+    std::map<std::string, std::string> labels;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Endpoint::host>("host"),
+        meta::field<&Endpoint::port>("port", meta::BoundsCheck<1, 65535>{}),
+        meta::field<&Endpoint::tags>("tags"),
+        meta::field<&Endpoint::labels>("labels"));
+};
+
+struct Account
+{
+    int64_t id;
+    std::string owner;
+    double balance;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Account::id>("id"),
+        meta::field<&Account::owner>("owner"),
+        meta::field<&Account::balance>("balance"));
+};
+
+template <> struct meta::MetaTuple<Account>
+{
+    static constexpr auto& FieldsMeta = Account::FieldsMeta;
+    static constexpr auto tableName = "accounts";
+};
+
+// What a header would declare
+META_EXTERN_TEMPLATES(META_CORE_TEMPLATES, Endpoint);
+META_EXTERN_TEMPLATES(META_JSON_TEMPLATES, Endpoint);
+META_EXTERN_TEMPLATES(META_BINARY_TEMPLATES, Endpoint);
+META_EXTERN_TEMPLATES(META_PROTO_TEMPLATES, Endpoint);
+META_EXTERN_TEMPLATES(META_CSV_TEMPLATES, Account);
+META_EXTERN_TEMPLATES(META_DB_TEMPLATES, Account);
+
+// What the one instantiating TU would define
+META_INSTANTIATE_TEMPLATES(META_CORE_TEMPLATES, Endpoint);
+META_INSTANTIATE_TEMPLATES(META_JSON_TEMPLATES, Endpoint);
+META_INSTANTIATE_TEMPLATES(META_BINARY_TEMPLATES, Endpoint);
+META_INSTANTIATE_TEMPLATES(META_PROTO_TEMPLATES, Endpoint);
+META_INSTANTIATE_TEMPLATES(META_CSV_TEMPLATES, Account);
+META_INSTANTIATE_TEMPLATES(META_DB_TEMPLATES, Account);
+
+int main()
+{
+    std::cout << "Extern templates\n";
+    std::cout << "================\n\n";
+
+    Endpoint endpoint{"api.internal", 8443, {"tls", "public"}, {{"team", "edge"}}};
+
+    // Test 1: The text formats go through the instantiated entry points
+    std::cout << "Test 1: YAML, JSON and XML\n";
+    std::string json = meta::toJson(endpoint);
+    auto [fromJson, jsonOk] = meta::fromJson<Endpoint>(json);
+    auto [fromYaml, yamlOk] = meta::reifyFromYaml<Endpoint>(meta::toYaml(endpoint));
+    assert(jsonOk.valid && yamlOk.valid);
+    assert(meta::toJson(*fromJson) == json && meta::toJson(*fromYaml) == json);
+    assert(meta::toXml(endpoint).find("api.internal") != std::string::npos);
+    Endpoint reloaded;
+    auto bad = meta::fromJson(reloaded, R"({"host":"x","port":0,"tags":[],"labels":{}})");
+    assert(!bad.valid && bad.errors[0].first == "port");
+    std::cout << "  " << json.size() << " bytes of JSON, " << bad.errors[0].first << ": " << bad.errors[0].second
+              << "\n\n";
+
+    // Test 2: Binary and protobuf
+    std::cout << "Test 2: Binary and protobuf\n";
+    auto [fromBinary, binaryOk] = meta::fromBinary<Endpoint>(meta::toBinary(endpoint));
+    auto [fromProto, protoOk] = meta::fromProto<Endpoint>(meta::toProto(endpoint));
+    assert(binaryOk.valid && protoOk.valid);
+    assert(meta::toJson(*fromBinary) == json && meta::toJson(*fromProto) == json);
+    std::cout << "  round trips match\n\n";
+
+    // Test 3: CSV and SQL for a flat record
+    std::cout << "Test 3: CSV and SQL\n";
+    Account account{42, "ops", 12.5};
+    std::string csv = meta::toCSVHeader<Account>() + "\n" + meta::toCSV(account) + "\n";
+    auto [rows, csvOk] = meta::parseCSV<Account>(csv);
+    assert(csvOk.valid && rows.size() == 1 && rows[0].owner == "ops" && rows[0].id == 42);
+    std::string insert = meta::insertSQL(account);
+    assert(insert.find("INSERT INTO accounts") == 0);
+    std::cout << "  " << insert << "\n";
+
+    std::cout << "\nAll extern template tests passed\n";
+    return 0;
+}
@@ -0,0 +1,102 @@
+// example_fail_fast.cpp - ValidationResult on the success path, and FailFast stopping at the first error
+#include <cassert>
+#include <iostream>
+
+#include "meta.h"
+#include "meta_csv.h"
+#include "meta_json.h"
+#include "meta_parallel.h"
+
+struct Item
+{
+    std::string sku;
+    int quantity;
+    double price;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Item::sku>("sku", meta::StringLength<1, 8>{}),
+        meta::field<&Item::quantity>("quantity", meta::BoundsCheck<1, 100>{}),
+        meta::field<&Item::price>("price"));
+};
+
+struct Order
+{
+    std::string id;
+    std::vector<Item> items;
+    std::map<std::string, int> discounts;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Order::id>("id"),
+        meta::field<&Order::items>("items"),
+        meta::field<&Order::discounts>("discounts"));
+};
+
+// A valid result is a flag and an empty pointer
+static_assert(sizeof(meta::ValidationResult) == 2 * sizeof(void*));
+
+const char* badOrder = R"({"id":"o-1","items":[
+    {"sku":"a","quantity":1,"price":1},
+    {"sku":"","quantity":500,"price":"free"},
+    {"sku":"toolongsku","quantity":2,"price":2}],
+    "discounts":{"spring":"x"}})";
+
+int main()
+{
+    std::cout << "Fail-fast validation\n";
+    std::cout << "====================\n\n";
+
+    // Test 1: Every error by default
+    std::cout << "Test 1: All errors\n";
+    auto [all, allResult] = meta::fromJson<Order>(badOrder);
+    assert(!allResult.valid && allResult.errors.size() == 5);
+    for (const auto& [path, message] : allResult.errors)
+        std::cout << "  " << path << ": " << message << "\n";
+    assert(allResult.errors[0].first == "items.[1].sku" && allResult.errors.back().first == "discounts.spring");
+    std::cout << "\n";
+
+    // Test 2: Only the first one under FailFast
+    std::cout << "Test 2: First error\n";
+    {
+        meta::FailFast quick;
+        auto [first, firstResult] = meta::fromJson<Order>(badOrder);
+        assert(!firstResult.valid && firstResult.errors.size() == 1);
+        assert(firstResult.errors[0] == allResult.errors[0]);
+        std::cout << "  " << firstResult.errors[0].first << ": " << firstResult.errors[0].second << "\n";
+
+        Order order;
+        meta::JsonDocument doc(badOrder);
+        meta::JsonNode root(doc, 0);
+        auto partial = meta::from(order, &root);
+        assert(partial.errors.size() == 1 && order.items.size() == 1 && order.discounts.empty());
+
+        auto [rows, csvResult] = meta::parseCSV<Item>("sku,quantity,price\nok,1,1\n,0,x\nlong-sku-x,1,1\n");
+        assert(csvResult.errors.size() == 1 && csvResult.errors[0].first == "[1].sku" && rows.size() == 1);
+    }
+    auto [again, againResult] = meta::fromJson<Order>(badOrder);
+    assert(againResult.errors.size() == 5);
+    std::cout << "\n";
+
+    // Test 3: Parallel reads stop at the same element
+    std::cout << "Test 3: Parallel\n";
+    std::string many = "[";
+    for (int i = 0; i < 4000; ++i)
+        many += std::string(i ? "," : "") + R"({"sku":"s)" + std::to_string(i % 100) + R"(","quantity":)" +
+                std::to_string(i % 997 == 996 ? 0 : 1 + i % 100) + R"(,"price":1})";
+    many += "]";
+    meta::JsonDocument doc(many);
+    meta::JsonNode root(doc, 0);
+    std::vector<Item> sequential;
+    auto seqResult = meta::from(sequential, &root);
+    assert(seqResult.errors.size() == 4 && sequential.size() == 3996);
+    {
+        meta::FailFast quick;
+        std::vector<Item> parallel;
+        auto parResult = meta::fromParallel(parallel, &root, {.threads = 4, .chunkSize = 100});
+        assert(parResult.errors.size() == 1 && parResult.errors[0].first == "[996].quantity");
+        assert(parallel.size() == 996);
+        std::cout << "  " << parResult.errors[0].first << " after " << parallel.size() << " items\n";
+    }
+
+    std::cout << "\nAll fail-fast tests passed\n";
+    return 0;
+}
@@ -0,0 +1,119 @@
+// example_hash_compare.cpp - meta::hash, meta::equal and meta::less generated from FieldsMeta
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "meta.h"
+
+using meta::operator<<;
+
+// Every byte is a compared integer, so it is hashed and compared as one block
+struct Point
+{
+    int32_t x;
+    int32_t y;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Point::x>("x"),
+        meta::field<&Point::y>("y"));
+};
+
+enum class Kind
+{
+    Click,
+    View
+};
+
+constexpr std::array<std::pair<Kind, std::string_view>, 2> KindMapping = {{
+    {Kind::Click, "click"},
+    {Kind::View, "view"},
+}};
+
+template <> struct meta::EnumMapping<Kind>
+{
+    static constexpr auto& mapping = KindMapping;
+    using Type = meta::EnumTraitsAuto<Kind, KindMapping>;
+};
+
+struct Event
+{
+    std::string user;
+    Kind kind;
+    std::vector<Point> path;
+    std::map<std::string, int> counters;
+    std::optional<double> score;
+    int64_t receivedAt;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Event::user>("user"),
+        meta::field<&Event::kind>("kind"),
+        meta::field<&Event::path>("path"),
+        meta::field<&Event::counters>("counters"),
+        meta::field<&Event::score>("score"),
+        meta::field<&Event::receivedAt>("receivedAt", meta::NotCompared{}));
+};
+
+int main()
+{
+    std::cout << "Generated hash and comparisons\n";
+    std::cout << "==============================\n\n";
+
+    Event a{"alice", Kind::Click, {{1, 2}, {3, 4}}, {{"retries", 1}}, 0.5, 1000};
+    Event b = a;
+    b.receivedAt = 2000;
+
+    // Test 1: Equality ignores NotCompared fields and agrees with the hash
+    std::cout << "Test 1: Equality and hash\n";
+    assert(meta::equal(a, b) && meta::hash<Event>{}(a) == meta::hash<Event>{}(b));
+    Event c = a;
+    c.path[1].y = 5;
+    assert(!meta::equal(a, c) && meta::hash<Event>{}(a) != meta::hash<Event>{}(c));
+    c = a;
+    c.score.reset();
+    assert(!meta::equal(a, c));
+    static_assert(meta::comparedAsBytes<Point>() && !meta::comparedAsBytes<Event>());
+    assert(meta::equal(Point{1, 2}, Point{1, 2}) && !meta::equal(Point{1, 2}, Point{2, 1}));
+
+    std::unordered_map<std::string, int> left{{"a", 1}, {"b", 2}, {"c", 3}};
+    std::unordered_map<std::string, int> right(left.begin(), left.end(), 64);
+    assert(meta::equal(left, right) && meta::hash<decltype(left)>{}(left) == meta::hash<decltype(right)>{}(right));
+    assert(meta::hash<double>{}(0.0) == meta::hash<double>{}(-0.0));
+    std::cout << "  hash(a) == hash(b): " << std::boolalpha << (meta::hash<Event>{}(a) == meta::hash<Event>{}(b)) << "\n\n";
+
+    // Test 2: Ordering is field by field, in declaration order
+    std::cout << "Test 2: Ordering\n";
+    std::vector<Event> events;
+    for (const char* user : {"carol", "alice", "bob"})
+        for (Kind kind : {Kind::View, Kind::Click})
+            events.push_back({user, kind, {{static_cast<int32_t>(events.size()), 0}}, {}, std::nullopt, 0});
+    std::sort(events.begin(), events.end(), meta::less);
+    assert(events.front().user == "alice" && events.front().kind == Kind::Click && events.back().user == "carol");
+    assert(std::is_sorted(events.begin(), events.end(), meta::less));
+    assert(!meta::less(a, b) && !meta::less(b, a));
+    Event empty = a;
+    empty.score.reset();
+    assert(meta::less(empty, a));
+    std::set<Event, meta::Less> ordered(events.begin(), events.end());
+    assert(ordered.size() == events.size());
+    for (const Event& e : events)
+        std::cout << "  " << e.user << " " << e.kind << "\n";
+
+    // Test 3: Deduplicating through an unordered_set
+    std::cout << "\nTest 3: Dedupe\n";
+    std::unordered_set<Event, meta::hash<Event>, meta::EqualTo> seen;
+    for (int i = 0; i < 1000; ++i)
+        seen.insert({"user-" + std::to_string(i % 10), i % 2 ? Kind::Click : Kind::View, {{i % 3, 0}}, {}, std::nullopt, i});
+    assert(seen.size() == 30);
+    std::unordered_set<Point, meta::hash<Point>, meta::EqualTo> points{{1, 2}, {1, 2}, {2, 1}};
+    assert(points.size() == 2);
+    std::cout << "  1000 events, " << seen.size() << " distinct\n";
+
+    std::cout << "\nAll hash and comparison tests passed\n";
+    return 0;
+}
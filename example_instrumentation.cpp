@@ -0,0 +1,165 @@
+// example_instrumentation.cpp - Probes on the from()/to() struct walkers: per-type and per-field events
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "meta.h"
+#include "meta_json.h"
+
+struct Limits
+{
+    int cpu;
+    int memory;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Limits::cpu>("cpu"),
+        meta::field<&Limits::memory>("memory", meta::BoundsCheck<1, 65536>{}));
+};
+
+struct Service
+{
+    std::string name;
+    Limits limits;
+    std::vector<std::string> hosts;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Service::name>("name"),
+        meta::field<&Service::limits>("limits"),
+        meta::field<&Service::hosts>("hosts"));
+};
+
+// Records every event in order
+struct Recorder
+{
+    static inline std::vector<std::string> log;
+    static inline std::vector<meta::ProbeEvent> exits;
+
+    static void enterType(const meta::ProbeEvent& e) { log.push_back("enter " + std::string(e.type)); }
+    static void exitType(const meta::ProbeEvent& e)
+    {
+        log.push_back("exit " + std::string(e.type));
+        exits.push_back(e);
+    }
+    static void enterField(const meta::ProbeEvent& e) { log.push_back("  enter " + std::string(e.field)); }
+    static void exitField(const meta::ProbeEvent& e)
+    {
+        log.push_back("  exit " + std::string(e.field));
+        exits.push_back(e);
+    }
+
+    static void clear()
+    {
+        log.clear();
+        exits.clear();
+    }
+
+    static const meta::ProbeEvent& exitOf(std::string_view field)
+    {
+        for (const auto& e : exits)
+            if (e.field == field)
+                return e;
+        throw std::runtime_error("no event for " + std::string(field));
+    }
+};
+
+template <> struct meta::Instrumented<Service>
+{
+    using Probe = Recorder;
+};
+
+// A wide config with one field that dominates the parse
+struct Settings
+{
+    std::string region;
+    int retries;
+    bool verbose;
+    std::vector<int> hugeTable;
+    std::map<std::string, std::string> labels;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Settings::region>("region"),
+        meta::field<&Settings::retries>("retries"),
+        meta::field<&Settings::verbose>("verbose"),
+        meta::field<&Settings::hugeTable>("hugeTable"),
+        meta::field<&Settings::labels>("labels"));
+};
+
+template <> struct meta::Instrumented<Settings>
+{
+    using Probe = meta::FieldProfile;
+};
+
+int main()
+{
+    std::cout << "Instrumentation\n";
+    std::cout << "===============\n\n";
+
+    const std::string json = R"({"name":"api","limits":{"cpu":2,"memory":512},"hosts":["a","b","c"]})";
+
+    // Test 1: Reads report the type, then each field, in nesting order
+    std::cout << "Test 1: Read events\n";
+    auto [service, ok] = meta::fromJson<Service>(json);
+    assert(ok.valid && service->hosts.size() == 3);
+    assert((Recorder::log == std::vector<std::string>{"enter Service", "  enter name", "  exit name", "  enter limits",
+                                                      "  exit limits", "  enter hosts", "  exit hosts", "exit Service"}));
+    // Limits has no probe of its own, so it only shows up as Service's field
+    assert(Recorder::exitOf("limits").nodes == 5 && Recorder::exitOf("hosts").nodes == 4);
+    assert(Recorder::exits.back().field.empty() && Recorder::exits.back().nodes == 14);
+    for (const auto& line : Recorder::log)
+        std::cout << "  " << line << "\n";
+
+    auto [fromYaml, yamlOk] = meta::reifyFromYaml<Service>(meta::toYaml(*service));
+    assert(yamlOk.valid && Recorder::exits.back().field.empty() && Recorder::exits.back().nodes == 14);
+    std::cout << "\n";
+
+    // Test 2: Validation failures are counted on the field they happen under
+    std::cout << "Test 2: Errors\n";
+    Recorder::clear();
+    auto [bad, badResult] = meta::fromJson<Service>(R"({"name":"api","limits":{"cpu":"x","memory":0},"hosts":[]})");
+    assert(!bad && badResult.errors.size() == 2);
+    assert(Recorder::exitOf("limits").errors == 2 && Recorder::exitOf("name").errors == 0);
+    assert(Recorder::exits.back().errors == 2);
+    std::cout << "  limits: " << Recorder::exitOf("limits").errors << " errors\n\n";
+
+    // Test 3: Writes report the bytes each field produced
+    std::cout << "Test 3: Write events\n";
+    Recorder::clear();
+    std::string out = meta::toJson(*service);
+    assert(out == json);
+    const auto& whole = Recorder::exits.back();
+    assert(whole.walk == meta::ProbeWalk::Write && whole.bytes == out.size());
+    assert(Recorder::exitOf("limits").bytes == std::string(R"({"cpu":2,"memory":512})").size());
+    assert(Recorder::exitOf("hosts").bytes == std::string(R"(["a","b","c"])").size());
+    Recorder::clear();
+    std::string yaml = meta::toYaml(*service);
+    assert(Recorder::exits.back().bytes > 0 && Recorder::exitOf("hosts").bytes > 0);
+    for (const char* f : {"name", "limits", "hosts"})
+        std::cout << "  " << f << ": " << Recorder::exitOf(f).bytes << " bytes of YAML\n";
+    std::cout << "\n";
+
+    // Test 4: FieldProfile finds the field the time goes to
+    std::cout << "Test 4: FieldProfile\n";
+    Settings settings{"eu-west", 3, false, std::vector<int>(200000, 7), {{"team", "core"}}};
+    std::string big = meta::toJson(settings);
+    for (int i = 0; i < 3; ++i)
+    {
+        auto [parsed, result] = meta::fromJson<Settings>(big);
+        assert(result.valid && parsed->hugeTable.size() == 200000);
+    }
+    auto rows = meta::FieldProfile::slowest();
+    assert(rows.size() == 10);
+    auto readRows = rows;
+    std::erase_if(readRows, [](const auto& row) { return std::get<0>(row.first) != meta::ProbeWalk::Read; });
+    const auto& [key, totals] = readRows.front();
+    assert(std::get<2>(key) == "hugeTable" && totals.calls == 3 && totals.nodes == 3 * 200001);
+    std::chrono::nanoseconds all{};
+    for (const auto& row : readRows)
+        all += row.second.elapsed;
+    assert(totals.elapsed * 2 > all);
+    std::cout << "  slowest read field: " << std::get<2>(key) << ", " << totals.nodes << " nodes in " << totals.calls
+              << " reads\n";
+
+    std::cout << "\nAll instrumentation tests passed\n";
+    return 0;
+}
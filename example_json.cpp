@@ -0,0 +1,134 @@
+// example_json.cpp - Deserialize JSON with the native reader in meta_json.h
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "meta.h"
+#include "meta_json.h"
+
+enum class Role { Admin, Developer, Guest };
+
+constexpr std::array RoleMapping = std::array{
+    std::pair{Role::Admin, "admin"},
+    std::pair{Role::Developer, "developer"},
+    std::pair{Role::Guest, "guest"},
+};
+
+template <> struct meta::EnumMapping<Role>
+{
+    static constexpr auto& mapping = RoleMapping;
+    using Type = meta::EnumTraitsAuto<Role, RoleMapping>;
+};
+
+struct Address
+{
+    std::string street;
+    std::string city;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Address::street>("street"),
+        meta::field<&Address::city>("city"));
+};
+
+struct Person
+{
+    std::string name;
+    int age;
+    double score;
+    bool active;
+    Role role;
+    Address address;
+    std::vector<std::string> tags;
+    std::map<std::string, int> limits;
+    std::optional<std::string> nickname;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Person::name>("name"),
+        meta::field<&Person::age>("age"),
+        meta::field<&Person::score>("score"),
+        meta::field<&Person::active>("active"),
+        meta::field<&Person::role>("role"),
+        meta::field<&Person::address>("address"),
+        meta::field<&Person::tags>("tags"),
+        meta::field<&Person::limits>("limits"),
+        meta::field<&Person::nickname>("nickname"));
+};
+
+void printErrors(const meta::ValidationResult& result)
+{
+    for (const auto& [field, msg] : result.errors)
+        std::cout << "  - " << (field.empty() ? "<root>" : field) << ": " << msg << "\n";
+}
+
+int main()
+{
+    std::cout << "Native JSON Deserialization\n";
+    std::cout << "===========================\n\n";
+
+    // Test 1: Full document
+    std::cout << "Test 1: Nested document\n";
+    std::string json = R"({
+        "name": "Alice \"Al\" Smith",
+        "age": 28,
+        "score": 91.5e-1,
+        "active": true,
+        "role": "developer",
+        "address": {"street": "123 Main St", "city": "Zürich"},
+        "tags": ["c++", "yaml", "json"],
+        "limits": {"cpu": 4, "memory": 2048},
+        "nickname": null
+    })";
+
+    auto [person, result] = meta::fromJson<Person>(json);
+    assert(person && result.valid);
+    assert(person->name == "Alice \"Al\" Smith");
+    assert(person->age == 28);
+    assert(person->score == 9.15);
+    assert(person->role == Role::Developer);
+    assert(person->address.city == "Z\xC3\xBCrich");
+    assert(person->tags.size() == 3 && person->tags[2] == "json");
+    assert(person->limits.at("memory") == 2048);
+    assert(!person->nickname);
+    std::cout << meta::toYaml(*person) << "\n\n";
+
+    // Test 2: Round trip through toJson
+    std::cout << "Test 2: toJson -> fromJson round trip\n";
+    person->name = "Bob";
+    person->nickname = "bobby";
+    std::string out = meta::toJson(*person);
+    auto [again, r2] = meta::fromJson<Person>(out);
+    assert(again && r2.valid);
+    assert(meta::toJson(*again) == out);
+    std::cout << out << "\n\n";
+
+    // Test 3: Top-level arrays
+    std::cout << "Test 3: Array of structs\n";
+    auto [addresses, r3] = meta::fromJson<std::vector<Address>>(
+        R"([{"street":"1 A St","city":"Boston"},{"street":"2 B St","city":"Austin"}])");
+    assert(addresses && addresses->size() == 2 && (*addresses)[1].city == "Austin");
+    std::cout << "  parsed " << addresses->size() << " addresses\n\n";
+
+    // Test 4: Type errors are reported with paths
+    std::cout << "Test 4: Validation errors\n";
+    auto [bad, r4] = meta::fromJson<Person>(R"({
+        "name": "Carol", "age": "old", "score": 1, "active": true, "role": "boss",
+        "address": {"street": "x", "city": 7}, "tags": [], "limits": {}
+    })");
+    assert(!bad && !r4.valid);
+    printErrors(r4);
+    std::cout << "\n";
+
+    // Test 5: Syntax errors
+    std::cout << "Test 5: Malformed JSON\n";
+    for (const char* text : {R"({"name": "x",})", R"([1, 2)", R"({"a": 01})", R"("\q")"})
+    {
+        auto [none, r5] = meta::fromJson<std::vector<int>>(text);
+        assert(!none && !r5.valid);
+        printErrors(r5);
+    }
+
+    std::cout << "\nAll JSON tests passed\n";
+    return 0;
+}
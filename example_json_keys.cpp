@@ -0,0 +1,113 @@
+// example_json_keys.cpp - Precomputed JSON key fragments and JsonColumn overrides
+#include <cassert>
+#include <iostream>
+
+#include "meta.h"
+#include "meta_json.h"
+#include "meta_patch.h"
+#include "meta_stream.h"
+
+struct Account
+{
+    int account_id;
+    std::string display_name;
+    double balance;
+    std::vector<int> tags;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Account::account_id>("account_id", meta::JsonColumn{"accountId"}),
+        meta::field<&Account::display_name>("display_name", meta::JsonColumn{"displayName"}),
+        meta::field<&Account::balance>("balance"),
+        meta::field<&Account::tags>("tags", meta::JsonColumn{"tag\"list"}));
+};
+
+// Fields declared `inline const` are only known at run time
+struct Legacy
+{
+    int id;
+    std::string name;
+};
+
+namespace meta
+{
+namespace LegacyFields
+{
+inline const auto FieldsMeta = std::make_tuple(
+    meta::field<&Legacy::id>("id", meta::JsonColumn{"legacyId"}),
+    meta::field<&Legacy::name>("name"));
+}
+
+template <> struct MetaTuple<Legacy>
+{
+    static inline const auto& FieldsMeta = LegacyFields::FieldsMeta;
+};
+} // namespace meta
+
+// The whole key table is a compile-time constant
+constexpr auto keys = meta::JsonKeyTable<Account>::build();
+static_assert(std::string_view(keys.text.data(), keys.offsets[1]) == R"(,"accountId":)");
+static_assert(keys.offsets.back() == keys.text.size());
+static_assert(meta::ConstexprFields<Account>);
+static_assert(!meta::ConstexprFields<Legacy>);
+
+int main()
+{
+    std::cout << "JSON key fragments\n";
+    std::cout << "==================\n\n";
+
+    // Test 1: JsonColumn names (escaped) in JSON, C++ names elsewhere
+    std::cout << "Test 1: JsonColumn overrides\n";
+    Account account{7, "Ada", 12.5, {1, 2}};
+    std::string json = meta::toJson(account);
+    assert(json == R"({"accountId":7,"displayName":"Ada","balance":12.5,"tag\"list":[1,2]})");
+    assert(meta::toYaml(account).find("display_name: Ada") != std::string::npos);
+    std::cout << "  " << json << "\n\n";
+
+    // Test 2: The Builder* path writes the same keys
+    std::cout << "Test 2: Virtual path\n";
+    meta::JsonBuilder builder;
+    meta::to(account, static_cast<meta::Builder*>(&builder));
+    assert(builder.result() == json);
+    std::cout << "  identical\n\n";
+
+    // Test 3: Runtime field tables build their fragments once
+    std::cout << "Test 3: inline const FieldsMeta\n";
+    std::string legacy = meta::toJson(std::vector<Legacy>{{1, "a"}, {2, "b"}});
+    assert(legacy == R"([{"legacyId":1,"name":"a"},{"legacyId":2,"name":"b"}])");
+    assert(meta::FieldIndex<Legacy>::find("name") == 1);
+    std::cout << "  " << legacy << "\n\n";
+
+    // Test 4: Readers match the same names (C++ names still read YAML)
+    std::cout << "Test 4: Round trip\n";
+    {
+        auto [copy, result] = meta::fromJson<Account>(json);
+        assert(result.valid && copy->account_id == 7 && copy->display_name == "Ada" && copy->tags.size() == 2);
+        auto [fromYaml, yamlResult] = meta::reifyFromYaml<Account>(meta::toYaml(account));
+        assert(yamlResult.valid && fromYaml->display_name == "Ada");
+        auto [legacyCopy, legacyResult] = meta::fromJson<std::vector<Legacy>>(legacy);
+        assert(legacyResult.valid && (*legacyCopy)[1].id == 2);
+
+        // The C++ name is not a JSON key
+        auto [missing, missingResult] = meta::fromJson<Account>(R"({"account_id":7,"display_name":"Ada","balance":1,"tag\"list":[]})");
+        assert(!missingResult.valid && missingResult.errors[0].second == "Missing required field");
+
+        meta::JsonObjectStream<Account> stream;
+        stream.feed(json.substr(0, 20));
+        stream.feed(json.substr(20));
+        auto [streamed, streamResult] = stream.finish();
+        assert(streamResult.valid && streamed->display_name == "Ada");
+
+        // Patches address fields by their JSON names
+        Account renamed = account;
+        renamed.display_name = "Grace";
+        std::string patch = meta::diff(account, renamed);
+        assert(patch == R"([{"op":"replace","path":"/displayName","value":"Grace"}])");
+        Account patched = account;
+        assert(meta::apply(patched, patch).valid && patched.display_name == "Grace");
+        assert(!meta::apply(patched, R"([{"op":"replace","path":"/display_name","value":"x"}])").valid);
+        std::cout << "  " << patch << "\n";
+    }
+
+    std::cout << "\nAll JSON key tests passed\n";
+    return 0;
+}
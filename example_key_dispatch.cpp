@@ -0,0 +1,100 @@
+// example_key_dispatch.cpp - Perfect-hash field dispatch with meta::KeyDispatch
+#include <cassert>
+#include <iostream>
+
+#include "meta.h"
+#include "meta_json.h"
+
+constexpr std::array<std::string_view, 3> Regions = {"us-east", "us-west", "eu-central"};
+
+struct Probe
+{
+    std::string host;
+    int port;
+    double latency;
+    bool healthy;
+    std::string region;
+    std::optional<std::string> note;
+    std::vector<int> samples;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Probe::host>("host"),
+        meta::field<&Probe::port>("port", meta::BoundsCheck<1, 65535>{}),
+        meta::field<&Probe::latency>("latency"),
+        meta::field<&Probe::healthy>("healthy"),
+        meta::field<&Probe::region>("region", meta::Whitelist<Regions>{}),
+        meta::field<&Probe::note>("note"),
+        meta::field<&Probe::samples>("samples"));
+};
+
+// Same fields, dispatched by key
+struct DispatchedProbe : Probe
+{
+    using Deser = meta::KeyDispatch<DispatchedProbe>;
+};
+
+// The index is a compile-time constant
+static_assert(meta::FieldIndex<Probe>::find("host") == 0);
+static_assert(meta::FieldIndex<Probe>::find("samples") == 6);
+static_assert(meta::FieldIndex<Probe>::find("hostname") == -1);
+static_assert(meta::FieldIndex<Probe>::find("") == -1);
+
+void printErrors(const meta::ValidationResult& result)
+{
+    for (const auto& [field, msg] : result.errors)
+        std::cout << "  - " << field << ": " << msg << "\n";
+}
+
+int main()
+{
+    std::cout << "Key-dispatch deserialization\n";
+    std::cout << "============================\n\n";
+
+    // Test 1: Both paths produce the same object
+    std::cout << "Test 1: Default vs KeyDispatch\n";
+    const char* json = R"({"samples": [3, 1, 4], "latency": 0.25, "host": "db-1",
+                           "extra": {"ignored": true}, "port": 5432, "healthy": true,
+                           "region": "us-west"})";
+    auto [a, ra] = meta::fromJson<Probe>(json);
+    auto [b, rb] = meta::fromJson<DispatchedProbe>(json);
+    assert(a && b && ra.valid && rb.valid);
+    assert(meta::toJson(*a) == meta::toJson(static_cast<const Probe&>(*b)));
+    std::cout << "  " << meta::toJson(*a) << "\n\n";
+
+    // Test 2: Missing required fields and attribute validation still apply
+    std::cout << "Test 2: Errors through KeyDispatch\n";
+    auto [c, rc] = meta::fromJson<DispatchedProbe>(
+        R"({"host": "db-2", "port": 70000, "region": "mars", "samples": "none"})");
+    assert(!c && !rc.valid);
+    printErrors(rc);
+    std::cout << "\n";
+
+    // Test 3: YAML documents dispatch the same way
+    std::cout << "Test 3: YAML\n";
+    auto [d, rd] = meta::reifyFromYaml<DispatchedProbe>(std::string(R"(
+host: cache-1
+port: 6379
+latency: 0.01
+healthy: false
+region: eu-central
+samples: [1, 2]
+note: warm standby
+)"));
+    assert(d && rd.valid && d->note == "warm standby" && d->samples.size() == 2);
+    std::cout << meta::toYaml(static_cast<const Probe&>(*d)) << "\n\n";
+
+    // Test 4: reifyFromYaml's unknown / missing key check uses the same index
+    std::cout << "Test 4: Unknown and missing keys\n";
+    auto [e, re] = meta::reifyFromYaml<Probe>(std::string(R"(
+host: web-1
+prot: 80
+latency: 1.5
+healthy: true
+region: us-east
+samples: []
+)"));
+    printErrors(re);
+
+    std::cout << "\nAll key-dispatch tests passed\n";
+    return 0;
+}
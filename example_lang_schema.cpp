@@ -0,0 +1,189 @@
+// example_lang_schema.cpp - JSON Schema, proto3 and Python/Rust binary decoders generated at compile time
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <set>
+#include <variant>
+#include <vector>
+
+#include "meta.h"
+#include "meta_binary.h"
+#include "meta_lang.h"
+#include "meta_proto.h"
+
+enum class Side : int8_t { Buy = 1, Sell = 2 };
+
+constexpr std::array SideMapping = std::array{
+    std::pair{Side::Buy, "buy"},
+    std::pair{Side::Sell, "sell"},
+};
+
+template <> struct meta::EnumMapping<Side>
+{
+    static constexpr auto& mapping = SideMapping;
+    using Type = meta::EnumTraitsAuto<Side, SideMapping>;
+};
+
+constexpr std::array<std::string_view, 3> Venues{"xnas", "xnys", "bats"};
+
+struct Fill
+{
+    int64_t time;
+    double price;
+    int32_t size;
+    int16_t venue;
+    Side side;
+    bool auction;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Fill::time>("time"),
+        meta::field<&Fill::price>("price"),
+        meta::field<&Fill::size>("size"),
+        meta::field<&Fill::venue>("venue"),
+        meta::field<&Fill::side>("side"),
+        meta::field<&Fill::auction>("auction"));
+};
+
+template <> struct meta::BinaryPacked<Fill> : std::true_type {};
+
+struct Account
+{
+    std::string owner;
+    uint16_t region;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Account::owner>("owner", meta::StringLength<1, 32>{}),
+        meta::field<&Account::region>("region"));
+};
+
+using Ref = std::variant<int64_t, std::string>;
+
+struct Order
+{
+    int32_t id;
+    std::string venue;
+    int32_t qty;
+    Side side;
+    std::optional<std::string> note;
+    Account account;
+    std::vector<Fill> fills;
+    std::map<std::string, double> fees;
+    std::set<int32_t> flags;
+    std::vector<std::optional<int32_t>> history;
+    std::pair<int32_t, std::string> route;
+    Ref ref;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Order::id>("id", meta::ProtoField<1, meta::ProtoEncoding::ZigZag>{}),
+        meta::field<&Order::venue>("venue", meta::Whitelist<Venues>{}, meta::JsonColumn{"exchange"}),
+        meta::field<&Order::qty>("qty", meta::BoundsCheck<1, 1000000>{}),
+        meta::field<&Order::side>("side"),
+        meta::field<&Order::note>("note", meta::BinaryTag<20>{}),
+        meta::field<&Order::account>("account"),
+        meta::field<&Order::fills>("fills"),
+        meta::field<&Order::fees>("fees"),
+        meta::field<&Order::flags>("flags"),
+        meta::field<&Order::history>("history"),
+        meta::field<&Order::route>("route"),
+        meta::field<&Order::ref>("ref"));
+};
+
+// Everything a protobuf message can hold
+struct Quote
+{
+    int32_t id;
+    uint64_t seq;
+    int64_t delta;
+    uint32_t checksum;
+    Side side;
+    std::optional<double> bid;
+    std::vector<std::string> tags;
+    std::map<int32_t, Account> accounts;
+    Account owner;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Quote::id>("id"),
+        meta::field<&Quote::seq>("seq"),
+        meta::field<&Quote::delta>("delta", meta::ProtoField<3, meta::ProtoEncoding::ZigZag>{}),
+        meta::field<&Quote::checksum>("checksum", meta::ProtoField<4, meta::ProtoEncoding::Fixed>{}),
+        meta::field<&Quote::side>("side"),
+        meta::field<&Quote::bid>("bid"),
+        meta::field<&Quote::tags>("tags"),
+        meta::field<&Quote::accounts>("accounts"),
+        meta::field<&Quote::owner>("owner"));
+};
+
+bool contains(std::string_view text, std::string_view part)
+{
+    return text.find(part) != std::string_view::npos;
+}
+
+// Baked in as constants, not built at startup
+static constexpr std::string_view orderSchema = meta::jsonSchema<Order>();
+static constexpr std::string_view quoteProto = meta::protoSchema<Quote>();
+static constexpr std::string_view orderPython = meta::pythonCodec<Order>();
+static constexpr std::string_view orderRust = meta::rustCodec<Order>();
+
+static_assert(orderSchema.starts_with("{\n  \"$schema\": \"https://json-schema.org/draft/2020-12/schema\""));
+static_assert(quoteProto.starts_with("syntax = \"proto3\";"));
+
+int main()
+{
+    std::cout << "Language schemas\n";
+    std::cout << "================\n\n";
+
+    // Test 1: JSON Schema follows toJson's names and shapes
+    std::cout << "Test 1: JSON Schema\n";
+    assert(contains(orderSchema, R"("$ref": "#/$defs/Order")"));
+    assert(contains(orderSchema, R"("exchange": {"type": "string", "enum": ["xnas", "xnys", "bats"]})"));
+    assert(contains(orderSchema, R"("qty": {"type": "integer", "minimum": 1, "maximum": 1000000})"));
+    assert(contains(orderSchema, R"("note": {"anyOf": [{"type": "string"}, {"type": "null"}]})"));
+    assert(contains(orderSchema, R"("owner": {"type": "string", "minLength": 1, "maxLength": 32})"));
+    assert(contains(orderSchema, R"("Side": {"type": "string", "enum": ["buy", "sell"]})"));
+    assert(contains(orderSchema, R"("flags": {"type": "array", "items": {"type": "integer", "minimum": -2147483648, )"
+                                 R"("maximum": 2147483647}, "uniqueItems": true})"));
+    assert(contains(orderSchema, R"("fees": {"type": "object", "additionalProperties": {"type": "number"}})"));
+    assert(contains(orderSchema, R"("required": ["id", "exchange", "qty", "side", "account", )"));
+    // Nested definitions come before the struct that uses them
+    assert(orderSchema.find("\"Account\": {") < orderSchema.find("\"Order\": {"));
+    std::cout << "  " << orderSchema.size() << " bytes\n\n";
+
+    // Test 2: proto3 uses the field numbers and encodings of meta_proto.h
+    std::cout << "Test 2: proto3\n";
+    assert(contains(quoteProto, "enum Side {\n  SIDE_UNSPECIFIED = 0;\n  SIDE_BUY = 1;\n  SIDE_SELL = 2;\n}\n"));
+    assert(contains(quoteProto, "message Account {\n  string owner = 1;\n  uint32 region = 2;\n}\n"));
+    for (const char* line : {"  int32 id = 1;", "  uint64 seq = 2;", "  sint64 delta = 3;", "  fixed32 checksum = 4;",
+                             "  Side side = 5;", "  optional double bid = 6;", "  repeated string tags = 7;",
+                             "  map<int32, Account> accounts = 8;", "  Account owner = 9;"})
+        assert(contains(quoteProto, line));
+    std::cout << quoteProto << "\n";
+
+    // Test 3: The Python decoder matches the binary layout
+    std::cout << "Test 3: Python codec\n";
+    std::string fingerprint = meta::lang_detail::hexText(meta::binaryFingerprint<Order>());
+    assert(contains(orderPython, "FINGERPRINT = " + fingerprint + "\n"));
+    assert(contains(orderPython, "class Side(enum.IntEnum):\n    buy = 1\n    sell = 2\n"));
+    assert(contains(orderPython, "    _LAYOUT = struct.Struct(\"<qdihb?\")\n"));
+    // Packed sequences are one block; optional fields are written bare
+    assert(contains(orderPython, "obj.fills = r.records(Fill._LAYOUT, Fill._row)"));
+    assert(contains(orderPython, "            elif key == 82:\n                obj.note = r.string()\n"));
+    assert(contains(orderPython, "obj.history = r.seq(lambda r: r.opt(Reader.sint))"));
+    assert(contains(orderPython, "obj.ref_ = r.variant((Reader.sint, Reader.string,))"));
+    std::cout << "  " << orderPython.size() << " bytes, fingerprint " << fingerprint << "\n\n";
+
+    // Test 4: Rust, the same layout through a Decode trait
+    std::cout << "Test 4: Rust codec\n";
+    assert(contains(orderRust, "pub const FINGERPRINT: u64 = " + fingerprint + ";\n"));
+    assert(contains(orderRust, "#[repr(i8)]\npub enum Side {\n    buy = 1,\n    sell = 2,\n}\n"));
+    assert(contains(orderRust, "pub enum OneOf1 {\n    V0(i64),\n    V1(String),\n}\n"));
+    assert(contains(orderRust, "    pub fills: Vec<Fill>,\n    pub fees: BTreeMap<String, f64>,\n"
+                               "    pub flags: BTreeSet<i32>,\n    pub history: Vec<Option<i32>>,\n"
+                               "    pub route: (i32, String,),\n    pub ref_: OneOf1,\n"));
+    assert(contains(orderRust, "    pub const PACKED_SIZE: usize = 24;\n"));
+    assert(contains(orderRust, "                82 => obj.note = Some(Decode::decode(r)?),\n"));
+    std::cout << "  " << orderRust.size() << " bytes\n";
+
+    std::cout << "\nAll language schema tests passed\n";
+    return 0;
+}
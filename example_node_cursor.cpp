@@ -0,0 +1,99 @@
+// example_node_cursor.cpp - Node navigation through stack cursors allocates nothing
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+
+#include "meta.h"
+#include "meta_json.h"
+
+// Count every heap allocation made by the program
+static size_t allocations = 0;
+
+void* operator new(size_t size)
+{
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+struct Sample
+{
+    int id;
+    int value;
+    double weight;
+    bool ok;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Sample::id>("id"),
+        meta::field<&Sample::value>("value"),
+        meta::field<&Sample::weight>("weight"),
+        meta::field<&Sample::ok>("ok"));
+};
+
+int main()
+{
+    std::cout << "Allocation-free Node navigation\n";
+    std::cout << "===============================\n\n";
+
+    std::vector<Sample> samples;
+    for (int i = 0; i < 10000; ++i)
+        samples.push_back({i, i * 7, i * 0.5, i % 2 == 0});
+    std::string json = meta::toJson(samples);
+
+    // Tokenize up front so only the from() walk is measured
+    meta::JsonDocument doc(json);
+    meta::JsonNode root(doc, 0);
+
+    std::vector<Sample> parsed;
+    size_t before = allocations;
+    auto result = meta::from(parsed, &root);
+    size_t walk = allocations - before;
+
+    assert(result.valid && parsed.size() == samples.size());
+    assert(parsed.back().value == 9999 * 7);
+
+    std::cout << "JSON: " << parsed.size() << " records x 4 fields, " << walk
+              << " allocation(s) during from()\n";
+
+    // The only allocation is the target vector's own storage
+    assert(walk == 1);
+
+    // Missing children come back as nullptr rather than a throwaway node
+    meta::NodeCursor cursor;
+    meta::JsonDocument small(R"({"a": [1, 2]})");
+    meta::JsonNode top(small, 0);
+    assert(top.at("b", cursor) == nullptr);
+    assert(top.at("a", cursor) != nullptr && cursor->size() == 2);
+
+    // YAML documents are walked the same way
+    YAML::Node yaml = YAML::Load("{x: 1, y: [2, 3]}");
+    meta::YamlNode ynode(yaml);
+    size_t keys = 0;
+    ynode.forEachEntry([&](std::string_view, meta::Node*) { ++keys; });
+    assert(keys == 2 && ynode.at("y", cursor)->size() == 2);
+
+    // Integer map keys are read from the entry's key without a copy. As
+    // with std::stoi, "+5" is 5; unlike it, "5 " and "5x" are rejected.
+    std::map<int, std::string> codes;
+    meta::JsonDocument keyed(R"({"+5": "five", "-3": "minus three", "404": "not found"})");
+    meta::JsonNode keyedRoot(keyed, 0);
+    assert(meta::from(codes, &keyedRoot).valid);
+    assert(codes.size() == 3 && codes[5] == "five" && codes[-3] == "minus three");
+    for (const char* bad : {R"({"5x": ""})", R"({"5 ": ""})", R"({"+-5": ""})", R"({"": ""})"})
+    {
+        meta::JsonDocument invalid(bad);
+        meta::JsonNode invalidRoot(invalid, 0);
+        auto keyResult = meta::from(codes, &invalidRoot);
+        assert(!keyResult.valid && keyResult.errors[0].second == "Invalid key format");
+    }
+    std::cout << "Integer keys: +5, -3 and 404 read; 5x, \"5 \", +-5 and \"\" rejected\n";
+
+    std::cout << "\nAll cursor tests passed\n";
+    return 0;
+}
@@ -0,0 +1,175 @@
+// example_output_sinks.cpp - Builders writing straight into pluggable output sinks
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+
+#include "meta.h"
+#include "meta_csv.h"
+
+struct Reading
+{
+    std::string sensor;
+    int sequence;
+    double value;
+    bool calibrated;
+    std::vector<int> raw;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Reading::sensor>("sensor"),
+        meta::field<&Reading::sequence>("sequence"),
+        meta::field<&Reading::value>("value"),
+        meta::field<&Reading::calibrated>("calibrated"),
+        meta::field<&Reading::raw>("raw"));
+};
+
+int main()
+{
+    std::cout << "Output sinks\n";
+    std::cout << "============\n\n";
+
+    std::vector<Reading> readings;
+    for (int i = 0; i < 2000; ++i)
+        readings.push_back({"s" + std::to_string(i % 7), i, i * 0.125, i % 3 == 0, {i, -i}});
+    const std::string expected = meta::toJson(readings);
+
+    // Test 1: Growable buffer, handed back without a copy
+    std::cout << "Test 1: StringSink\n";
+    meta::StringSink buffer;
+    meta::toJson(readings, buffer);
+    assert(buffer.view() == expected);
+    const char* storage = buffer.data();
+    std::string taken = buffer.take();
+    assert(taken.data() == storage && taken == expected);
+    assert(buffer.size() == 0);
+    std::cout << "  " << taken.size() << " bytes, taken in place\n\n";
+
+    // Test 2: Caller-supplied buffer, with overflow reported
+    std::cout << "Test 2: FixedBufferSink\n";
+    char fixed[256];
+    meta::FixedBufferSink small(fixed, sizeof(fixed));
+    meta::toJson(readings[1], small);
+    assert(small.view() == meta::toJson(readings[1]));
+    std::cout << "  " << small.view() << "\n";
+
+    bool overflowed = false;
+    try
+    {
+        meta::FixedBufferSink tooSmall(fixed, sizeof(fixed));
+        meta::toJson(readings, tooSmall);
+    }
+    catch (const std::length_error&)
+    {
+        overflowed = true;
+    }
+    assert(overflowed);
+    std::cout << "  overflow throws std::length_error\n\n";
+
+    // Test 3: Chunk list - no reallocation, ready for writev
+    std::cout << "Test 3: ChunkSink\n";
+    meta::ChunkSink chunks(4096);
+    meta::toJson(readings, chunks);
+    assert(chunks.chunks().size() > 1 && chunks.str() == expected);
+    std::cout << "  " << chunks.chunks().size() << " chunks of up to 4096 bytes\n\n";
+
+    // Test 4: File descriptor, both buffered and gathered
+    std::cout << "Test 4: FdSink / ChunkSink::writeTo\n";
+    FILE* tmp = std::tmpfile();
+    int fd = fileno(tmp);
+    {
+        meta::FdSink file(fd, 1024);
+        meta::toJson(readings, file);
+        assert(file.bytesWritten() == expected.size());
+    }
+    chunks.writeTo(fd);
+
+    std::string readBack(expected.size() * 2, '\0');
+    std::rewind(tmp);
+    assert(std::fread(readBack.data(), 1, readBack.size(), tmp) == readBack.size());
+    std::fclose(tmp);
+    assert(readBack == expected + expected);
+    std::cout << "  " << readBack.size() << " bytes written and read back\n\n";
+
+    // Test 5: XML, YAML and CSV builders accept the same sinks
+    std::cout << "Test 5: Other formats\n";
+    meta::StringSink xml, yaml, csv;
+    meta::toXml(readings[2], xml);
+    meta::toYaml(readings[2], yaml);
+    meta::toCSV(readings[2], csv);
+    assert(xml.view() == meta::toXml(readings[2]));
+    assert(yaml.view() == meta::toYaml(readings[2]));
+    assert(csv.view() == meta::toCSV(readings[2]));
+    std::cout << "  " << csv.view() << "\n";
+
+    std::cout << "\n";
+
+    // Test 6: stdio and iostream destinations
+    std::cout << "Test 6: FileSink / StreamSink\n";
+    FILE* out = std::tmpfile();
+    {
+        meta::FileSink file(out, 1024);
+        meta::toYaml(readings, file);
+        meta::serialize(readings, file);
+    }
+    std::string fileContents(static_cast<size_t>(std::ftell(out)), '\0');
+    std::rewind(out);
+    assert(std::fread(fileContents.data(), 1, fileContents.size(), out) == fileContents.size());
+    std::fclose(out);
+    assert(fileContents == meta::toYaml(readings) + meta::serialize(readings));
+
+    std::ostringstream os;
+    {
+        meta::StreamSink stream(os, 1024);
+        meta::toXml(readings, stream);
+        assert(stream.bytesWritten() == meta::toXml(readings).size());
+    }
+    assert(os.str() == meta::toXml(readings));
+    std::cout << "  " << fileContents.size() << " bytes through FILE*, " << os.str().size()
+              << " through std::ostream\n\n";
+
+    // Test 7: Every format reaches the destination while it is being
+    // written, one buffer at a time
+    std::cout << "Test 7: Bounded buffering\n";
+    for (const char* format : {"json", "yaml", "xml", "csv"})
+    {
+        size_t blocks = 0, largest = 0, total = 0;
+        meta::CallbackSink sink([&](std::string_view block)
+        {
+            ++blocks;
+            largest = std::max(largest, block.size());
+            total += block.size();
+        }, 4096);
+        std::string_view f = format;
+        if (f == "json")
+            meta::toJson(readings, sink);
+        else if (f == "yaml")
+            meta::toYaml(readings, sink);
+        else if (f == "xml")
+            meta::toXml(readings, sink);
+        else
+        {
+            meta::serialize(readings, sink);
+            sink.flush();
+        }
+        assert(blocks > 10 && largest <= 4096 && total == sink.bytesWritten());
+        std::cout << "  " << format << ": " << total << " bytes in " << blocks << " blocks\n";
+    }
+
+    // Write errors surface from every builder
+    bool failed = false;
+    try
+    {
+        meta::FdSink closed(-1, 64);
+        meta::toYaml(readings, closed);
+    }
+    catch (const std::system_error& e)
+    {
+        failed = e.code() == std::errc::bad_file_descriptor;
+    }
+    assert(failed);
+    std::cout << "  a failed write throws std::system_error\n";
+
+    std::cout << "\nAll output sink tests passed\n";
+    return 0;
+}
@@ -0,0 +1,169 @@
+// example_packed.cpp - PodLayout structs and the packed binary encoding
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "meta_binary.h"
+#include "meta_columnar.h"
+#include "meta_soa.h"
+
+enum class Side : uint8_t { Buy, Sell };
+
+constexpr std::array SideMapping = std::array{
+    std::pair{Side::Buy, "buy"},
+    std::pair{Side::Sell, "sell"},
+};
+
+template <> struct meta::EnumMapping<Side>
+{
+    static constexpr auto& mapping = SideMapping;
+    using Type = meta::EnumTraitsAuto<Side, SideMapping>;
+};
+
+struct Tick
+{
+    int64_t time;
+    double price;
+    int32_t size;
+    int16_t venue;
+    Side side;
+    bool auction;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Tick::time>("time"),
+        meta::field<&Tick::price>("price"),
+        meta::field<&Tick::size>("size", meta::BoundsCheck<1, 1000000>{}),
+        meta::field<&Tick::venue>("venue"),
+        meta::field<&Tick::side>("side"),
+        meta::field<&Tick::auction>("auction"));
+};
+
+template <> struct meta::BinaryPacked<Tick> : std::true_type {};
+
+struct Quote
+{
+    double bid;
+    double ask;
+    uint32_t bidSize;
+    uint32_t askSize;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Quote::bid>("bid"),
+        meta::field<&Quote::ask>("ask"),
+        meta::field<&Quote::bidSize>("bidSize"),
+        meta::field<&Quote::askSize>("askSize"));
+};
+
+template <> struct meta::BinaryPacked<Quote> : std::true_type {};
+
+// Listed in a different order than declared: packed field by field
+struct Swapped
+{
+    int32_t low;
+    int32_t high;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Swapped::high>("high"),
+        meta::field<&Swapped::low>("low"));
+};
+
+template <> struct meta::BinaryPacked<Swapped> : std::true_type {};
+
+// Padding after `flag` keeps this one out of the packed paths
+struct Padded
+{
+    bool flag;
+    int64_t value;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Padded::flag>("flag"),
+        meta::field<&Padded::value>("value"));
+};
+
+struct Book
+{
+    std::string symbol;
+    std::vector<Tick> ticks;
+    Quote last;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Book::symbol>("symbol"),
+        meta::field<&Book::ticks>("ticks"),
+        meta::field<&Book::last>("last"));
+};
+
+std::vector<Tick> makeTicks(size_t n)
+{
+    std::vector<Tick> ticks;
+    for (size_t i = 0; i < n; ++i)
+        ticks.push_back({static_cast<int64_t>(1700000000000 + i), 100.25 + static_cast<double>(i % 50) / 8,
+                         static_cast<int32_t>(100 * (i % 9 + 1)), static_cast<int16_t>(i % 4),
+                         i % 3 ? Side::Buy : Side::Sell, i % 10 == 0});
+    return ticks;
+}
+
+int main()
+{
+    std::cout << "Packed POD structs\n";
+    std::cout << "==================\n\n";
+
+    // Test 1: Layout detection
+    std::cout << "Test 1: PodLayout\n";
+    static_assert(meta::PodLayout<Tick> && meta::PodLayout<Quote>);
+    static_assert(!meta::PodLayout<Padded> && !meta::PodLayout<Book>);
+    assert(meta::podFieldsInOrder<Tick>() && !meta::podFieldsInOrder<Swapped>());
+    std::cout << "  Tick: " << sizeof(Tick) << " bytes, fields in order\n\n";
+
+    // Test 2: A vector of packed structs is one block
+    std::cout << "Test 2: Binary\n";
+    Book book{"ACME", makeTicks(1000), {100.0, 100.5, 300, 200}};
+    std::string bytes = meta::toBinary(book);
+    auto [copy, ok] = meta::fromBinary<Book>(bytes, {.requireSameSchema = true});
+    assert(ok.valid && copy->ticks.size() == 1000 && copy->symbol == "ACME" && copy->last.askSize == 200);
+    assert(std::memcmp(copy->ticks.data(), book.ticks.data(), 1000 * sizeof(Tick)) == 0);
+    assert(bytes.size() < 1000 * sizeof(Tick) + 64);
+
+    std::string quotes = meta::toBinary(std::vector<Quote>(500, Quote{1.5, 2.5, 10, 20}));
+    auto [readQuotes, quotesOk] = meta::fromBinary<std::vector<Quote>>(quotes);
+    assert(quotesOk.valid && readQuotes->size() == 500 && (*readQuotes)[499].bid == 1.5);
+    std::string swapped = meta::toBinary(std::vector<Swapped>{{1, 2}, {3, 4}});
+    assert(swapped.substr(swapped.size() - 16, 4) == std::string("\x02\0\0\0", 4));
+    auto [readSwapped, swappedOk] = meta::fromBinary<std::vector<Swapped>>(swapped);
+    assert(swappedOk.valid && (*readSwapped)[1].low == 3 && (*readSwapped)[1].high == 4);
+    std::cout << "  " << book.ticks.size() << " ticks in " << bytes.size() << " bytes\n\n";
+
+    // Test 3: Records are still validated
+    std::cout << "Test 3: Errors\n";
+    Book bad = book;
+    bad.ticks.resize(3);
+    bad.ticks[1].size = 0;
+    std::string badBytes = meta::toBinary(bad);
+    // The ticks block ends where `last` (key, length, 24 bytes) starts
+    size_t ticksEnd = badBytes.size() - 2 - sizeof(Quote);
+    size_t sideAt = ticksEnd - sizeof(Tick) + offsetof(Tick, side);
+    badBytes[sideAt] = 7;
+    auto [rejected, errors] = meta::fromBinary<Book>(badBytes);
+    assert(!rejected && errors.errors.size() == 2);
+    assert(errors.errors[0].first == "ticks.[1].size" && errors.errors[1].first == "ticks.[2].side");
+    for (const auto& [path, message] : errors.errors)
+        std::cout << "  " << path << ": " << message << "\n";
+    auto [truncated, truncatedResult] = meta::fromBinary<Book>(std::string_view(bytes).substr(0, 200));
+    assert(!truncated && !truncatedResult.valid);
+
+    // Test 4: The columnar containers take the same records
+    std::cout << "\nTest 4: Columns\n";
+    meta::soa_vector<Tick> soa(book.ticks);
+    assert(soa.size() == 1000 && soa.column<&Tick::price>()[9] == book.ticks[9].price);
+    std::vector<Tick> back = soa.to_vector();
+    assert(std::memcmp(back.data(), book.ticks.data(), 1000 * sizeof(Tick)) == 0);
+    std::string file = meta::toColumnar(book.ticks);
+    auto [table, tableOk] = meta::readColumnar<Tick>(file);
+    assert(tableOk.valid);
+    std::vector<Tick> fromTable = table->rowsVector();
+    assert(std::memcmp(fromTable.data(), book.ticks.data(), 1000 * sizeof(Tick)) == 0);
+    std::cout << "  " << soa.size() << " rows through soa_vector and a columnar table\n";
+
+    std::cout << "\nAll packed struct tests passed\n";
+    return 0;
+}
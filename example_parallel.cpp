@@ -0,0 +1,199 @@
+// example_parallel.cpp - Parallel batch serialization and reading match the sequential path
+#include <cassert>
+#include <iostream>
+#include <memory_resource>
+#include <stdexcept>
+
+#include "meta_parallel.h"
+
+struct Item
+{
+    int id;
+    std::string label;
+    std::vector<double> weights;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Item::id>("id", meta::BoundsCheck<-1, 1000000>{}),
+        meta::field<&Item::label>("label", meta::StringLength<1, 32>{}),
+        meta::field<&Item::weights>("weights"));
+};
+
+struct Tag
+{
+    std::pmr::string name;
+
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&Tag::name>("name"));
+};
+
+// Keys newer writers add are noted, not failed
+struct Reading
+{
+    int sensor;
+    double value;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Reading::sensor>("sensor"),
+        meta::field<&Reading::value>("value"));
+};
+
+template <> struct meta::UnknownFieldPolicy<Reading>
+{
+    static constexpr auto value = meta::UnknownFields::Collect;
+};
+
+// Refuses to serialize negative ids
+struct Checked : Item
+{
+    struct Ser
+    {
+        static void write(const Checked& obj, meta::Builder* b)
+        {
+            if (obj.id < 0)
+                throw std::invalid_argument("negative id " + std::to_string(obj.id));
+            meta::to(static_cast<const Item&>(obj), b);
+        }
+    };
+};
+
+int main()
+{
+    std::cout << "Parallel serialization\n";
+    std::cout << "======================\n\n";
+
+    std::vector<Item> items;
+    for (int i = 0; i < 5000; ++i)
+        items.push_back({i, "item-" + std::to_string(i), {i * 0.5, -i * 0.25}});
+
+    // Test 1: Identical output for any thread count / chunk size
+    std::cout << "Test 1: Same bytes as the sequential path\n";
+    const std::string json = meta::serializeJson(items);
+    const std::string csv = meta::toCSVWithHeader(items);
+    const std::string rows = meta::serialize(items, ";");
+    for (unsigned threads : {1u, 2u, 4u})
+    {
+        for (size_t chunk : {0ul, 1ul, 333ul, 10000ul})
+        {
+            meta::ParallelOptions options{threads, chunk};
+            assert(meta::serializeJsonParallel(items, options) == json);
+            assert(meta::toCSVWithHeaderParallel(items, options) == csv);
+            assert(meta::serializeParallel(items, ";", options) == rows);
+        }
+    }
+    std::cout << "  " << json.size() << " bytes JSON, " << csv.size() << " bytes CSV\n\n";
+
+    // Test 2: Straight into a sink
+    std::cout << "Test 2: ChunkSink output\n";
+    meta::ChunkSink sink;
+    meta::serializeJsonParallel(items, sink, {4, 250});
+    assert(sink.str() == json);
+    std::cout << "  " << sink.chunks().size() << " chunks\n\n";
+
+    // Test 3: A worker's exception reaches the caller
+    std::cout << "Test 3: Exceptions\n";
+    std::vector<Checked> checked(2000);
+    for (int i = 0; i < 2000; ++i)
+        checked[i].id = i == 1500 ? -1 : i;
+    bool caught = false;
+    try
+    {
+        meta::serializeJsonParallel(checked, {4, 100});
+    }
+    catch (const std::invalid_argument& e)
+    {
+        caught = true;
+        std::cout << "  caught: " << e.what() << "\n";
+    }
+    assert(caught);
+    std::cout << "\n";
+
+    // Test 4: Reading a top-level sequence in parallel
+    std::cout << "Test 4: fromJsonParallel\n";
+    auto [loaded, ok] = meta::fromJsonParallel<Item>(json, {4, 128});
+    assert(loaded && ok.valid && meta::serializeJson(*loaded) == json);
+
+    items[10].id = -5;
+    items[4000].label = "";
+    std::string broken = meta::toJson(items);
+    meta::JsonDocument doc(broken);
+    meta::JsonNode root(doc, 0);
+
+    std::vector<Item> sequential, parallel;
+    auto expected = meta::from(sequential, &root);
+    auto merged = meta::fromParallel(parallel, &root, {4, 128});
+    assert(!merged.valid && merged.errors == expected.errors);
+    assert(parallel.size() == sequential.size() && parallel.size() == items.size() - 2);
+    for (const auto& [path, message] : merged.errors)
+        std::cout << "  " << path << ": " << message << "\n";
+
+    // YAML nodes can't be shared across threads and are read sequentially
+    YAML::Node yaml = YAML::Load("[{id: 1, label: a, weights: []}, {id: 2, label: b, weights: [1.5]}]");
+    meta::YamlNode ynode(yaml);
+    std::vector<Item> fromYaml;
+    assert(meta::fromParallel(fromYaml, &ynode, {4, 1}).valid && fromYaml.size() == 2);
+    std::cout << "\n";
+
+    // Test 5: An arena belongs to one thread, so reading into it is sequential
+    std::cout << "Test 5: ArenaScope\n";
+    {
+        std::string tags = "[";
+        for (int i = 0; i < 500; ++i)
+            tags += std::string(i ? "," : "") + R"({"name":"a tag too long for small strings )" + std::to_string(i) + R"("})";
+        tags += "]";
+        meta::JsonDocument tagDoc(tags);
+        meta::JsonNode tagRoot(tagDoc, 0);
+
+        std::pmr::monotonic_buffer_resource arena;
+        std::vector<Tag> read;
+        {
+            meta::ArenaScope scope(&arena);
+            assert(meta::fromParallel(read, &tagRoot, {4, 16}).valid && read.size() == 500);
+        }
+        for (const auto& tag : read)
+            assert(tag.name.get_allocator().resource() == &arena);
+        std::cout << "  " << read.size() << " elements, all on the arena\n\n";
+    }
+
+    // Test 6: Keys skipped on the workers reach the caller's UnknownFieldLog
+    std::cout << "Test 6: UnknownFieldLog\n";
+    {
+        std::string readings = "[";
+        for (int i = 0; i < 1000; ++i)
+        {
+            readings += std::string(i ? "," : "") + R"({"sensor":)" + std::to_string(i) + R"(,"value":1.5)";
+            if (i % 10 == 3)
+                readings += R"(,"unit":"C")";
+            if (i >= 700)
+                readings += R"(,"site":"north")";
+            readings += i == 850 ? R"(,"value":"x"})" : "}";
+        }
+        readings += "]";
+        meta::JsonDocument readingDoc(readings);
+        meta::JsonNode readingRoot(readingDoc, 0);
+
+        for (bool failFast : {false, true})
+        {
+            meta::FailFast scope(failFast);
+            std::vector<Reading> sequential, parallel;
+            meta::UnknownFieldLog expected;
+            auto expectedResult = meta::from(sequential, &readingRoot);
+            {
+                meta::UnknownFieldLog log;
+                auto result = meta::fromParallel(parallel, &readingRoot, {4, 64});
+                assert(result.errors == expectedResult.errors && parallel.size() == sequential.size());
+                assert(log.entries().size() == expected.entries().size());
+                for (size_t i = 0; i < log.entries().size(); ++i)
+                    assert(log.entries()[i].key == expected.entries()[i].key &&
+                           log.entries()[i].count == expected.entries()[i].count);
+            }
+            assert(!expected.empty());
+        }
+        meta::UnknownFieldLog log;
+        std::vector<Reading> parallel;
+        meta::fromParallel(parallel, &readingRoot, {4, 64});
+        std::cout << "  " << log.entries()[0].key << " x" << log.entries()[0].count << ", "
+                  << log.entries()[1].key << " x" << log.entries()[1].count << "\n";
+    }
+
+    std::cout << "\nAll parallel tests passed\n";
+    return 0;
+}
@@ -0,0 +1,120 @@
+// example_patch.cpp - JSON Patch between two versions of a struct, and replaying it on a replica
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "meta.h"
+#include "meta_patch.h"
+
+struct Limits
+{
+    int cpu;
+    int memory;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Limits::cpu>("cpu"),
+        meta::field<&Limits::memory>("memory"));
+};
+
+struct Service
+{
+    std::string name;
+    int replicas;
+    Limits limits;
+    std::vector<std::string> hosts;
+    std::map<std::string, std::string> labels;
+    std::optional<std::string> owner;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Service::name>("name"),
+        meta::field<&Service::replicas>("replicas", meta::BoundsCheck<0, 100>{}),
+        meta::field<&Service::limits>("limits"),
+        meta::field<&Service::hosts>("hosts"),
+        meta::field<&Service::labels>("labels"),
+        meta::field<&Service::owner>("owner"));
+};
+
+struct Fleet
+{
+    std::string region;
+    std::vector<Service> services;
+    std::map<int, std::string> zones;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Fleet::region>("region"),
+        meta::field<&Fleet::services>("services"),
+        meta::field<&Fleet::zones>("zones"));
+};
+
+Fleet makeFleet(size_t count)
+{
+    Fleet fleet{"eu-west", {}, {{1, "eu-west-1a"}, {2, "eu-west-1b"}}};
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string name = "service-" + std::to_string(i);
+        fleet.services.push_back({name, 3, {2, 4096}, {name + "-a", name + "-b"}, {{"tier", "web"}}, std::nullopt});
+    }
+    return fleet;
+}
+
+int main()
+{
+    std::cout << "Diff and patch\n";
+    std::cout << "==============\n\n";
+
+    // Test 1: Only the changed fields are in the patch
+    std::cout << "Test 1: Diff\n";
+    Fleet before = makeFleet(3);
+    Fleet after = before;
+    after.services[1].replicas = 5;
+    after.services[1].labels["team"] = "core";
+    after.services[2].labels.erase("tier");
+    after.services[0].owner = "ops";
+    after.services[0].hosts.pop_back();
+    after.services.push_back({"edge", 1, {1, 512}, {}, {}, std::nullopt});
+    after.zones[3] = "eu-west-1c";
+    std::string patch = meta::diff(before, after);
+    std::cout << "  " << patch << "\n\n";
+    assert(patch.find(R"({"op":"replace","path":"/services/1/replicas","value":5})") != std::string::npos);
+    assert(patch.find(R"({"op":"remove","path":"/services/0/hosts/1"})") != std::string::npos);
+    assert(patch.find(R"({"op":"add","path":"/zones/3","value":"eu-west-1c"})") != std::string::npos);
+    assert(meta::diff(before, before) == "[]");
+
+    // Test 2: Applying the patch reproduces the new version
+    std::cout << "Test 2: Apply\n";
+    Fleet replica = before;
+    auto result = meta::apply(replica, patch);
+    assert(result.valid && meta::toJson(replica) == meta::toJson(after));
+    assert(meta::diff(replica, after) == "[]");
+    auto undo = meta::apply(replica, meta::diff(after, before));
+    assert(undo.valid && meta::toJson(replica) == meta::toJson(before));
+
+    Fleet large = makeFleet(2000);
+    Fleet changed = large;
+    changed.services[1234].limits.memory = 8192;
+    std::string small = meta::diff(large, changed);
+    std::string full = meta::toJson(changed);
+    assert(meta::apply(large, small).valid && meta::toJson(large) == full);
+    std::cout << "  " << small.size() << " byte patch for a " << full.size() << " byte document\n\n";
+
+    // Test 3: Ops that don't fit the object
+    std::cout << "Test 3: Errors\n";
+    Fleet target = before;
+    auto bounds = meta::apply(target, R"([{"op":"replace","path":"/services/0/replicas","value":500}])");
+    assert(!bounds.valid && bounds.errors[0].first == "services.[0].replicas");
+    auto missing = meta::apply(target, R"([{"op":"replace","path":"/services/9/name","value":"x"}])");
+    assert(!missing.valid && missing.errors[0].first == "services.[9]");
+    auto unknown = meta::apply(target, R"([{"op":"add","path":"/services/0/extra","value":1}])");
+    assert(!unknown.valid && unknown.errors[0].first == "services.[0].extra");
+    auto required = meta::apply(target, R"([{"op":"remove","path":"/region"}])");
+    assert(!required.valid && required.errors[0].first == "region");
+    auto move = meta::apply(target, R"([{"op":"move","from":"/region","path":"/services/0/name"}])");
+    assert(!move.valid && move.errors[0].first == "patch");
+    for (const auto* r : {&bounds, &missing, &unknown, &required, &move})
+        std::cout << "  " << r->errors[0].first << ": " << r->errors[0].second << "\n";
+
+    std::cout << "\nAll patch tests passed\n";
+    return 0;
+}
@@ -0,0 +1,163 @@
+// example_pmr.cpp - std::pmr fields and reading a whole message into one arena
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <vector>
+
+#include "meta.h"
+#include "meta_json.h"
+
+struct Line
+{
+    std::pmr::string sku;
+    int quantity;
+    std::pmr::vector<std::pmr::string> tags;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Line::sku>("sku"),
+        meta::field<&Line::quantity>("quantity"),
+        meta::field<&Line::tags>("tags"));
+};
+
+struct Order
+{
+    std::pmr::string id;
+    std::pmr::vector<Line> lines;
+    std::pmr::map<std::pmr::string, std::pmr::string> notes;
+    std::pmr::set<int> flags;
+    std::optional<std::pmr::string> coupon;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Order::id>("id"),
+        meta::field<&Order::lines>("lines"),
+        meta::field<&Order::notes>("notes"),
+        meta::field<&Order::flags>("flags"),
+        meta::field<&Order::coupon>("coupon"));
+};
+
+// The same message with the default allocator
+struct PlainLine
+{
+    std::string sku;
+    int quantity;
+    std::vector<std::string> tags;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&PlainLine::sku>("sku"),
+        meta::field<&PlainLine::quantity>("quantity"),
+        meta::field<&PlainLine::tags>("tags"));
+};
+
+struct PlainOrder
+{
+    std::string id;
+    std::vector<PlainLine> lines;
+    std::map<std::string, std::string> notes;
+    std::set<int> flags;
+    std::optional<std::string> coupon;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&PlainOrder::id>("id"),
+        meta::field<&PlainOrder::lines>("lines"),
+        meta::field<&PlainOrder::notes>("notes"),
+        meta::field<&PlainOrder::flags>("flags"),
+        meta::field<&PlainOrder::coupon>("coupon"));
+};
+
+// Counts what reaches the default pmr resource
+struct CountingResource : std::pmr::memory_resource
+{
+    size_t allocations = 0;
+
+    void* do_allocate(size_t bytes, size_t align) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t align) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+};
+
+const char* orderJson = R"({"id":"order-0000000000001","lines":[
+  {"sku":"widget-with-a-long-name","quantity":2,"tags":["blue","fragile-handle-with-care"]},
+  {"sku":"gadget-with-a-long-name","quantity":1,"tags":[]}],
+  "notes":{"gift-message-for-recipient":"happy birthday, see you soon","delivery":"leave at the door please"},
+  "flags":[3,1,2],"coupon":"SPRING-SALE-2024-FIFTEEN"})";
+
+bool onArena(std::pmr::memory_resource* arena, const Order& order)
+{
+    bool ok = order.id.get_allocator().resource() == arena && order.lines.get_allocator().resource() == arena &&
+              order.notes.get_allocator().resource() == arena && order.flags.get_allocator().resource() == arena &&
+              order.coupon->get_allocator().resource() == arena;
+    for (const Line& line : order.lines)
+    {
+        ok = ok && line.sku.get_allocator().resource() == arena && line.tags.get_allocator().resource() == arena;
+        for (const auto& tag : line.tags)
+            ok = ok && tag.get_allocator().resource() == arena;
+    }
+    for (const auto& [key, value] : order.notes)
+        ok = ok && key.get_allocator().resource() == arena && value.get_allocator().resource() == arena;
+    return ok;
+}
+
+int main()
+{
+    std::cout << "PMR containers\n";
+    std::cout << "==============\n\n";
+
+    CountingResource counting;
+    std::pmr::set_default_resource(&counting);
+
+    // Test 1: pmr fields read and write like their std counterparts
+    std::cout << "Test 1: Same as std types\n";
+    auto [order, ok] = meta::fromJson<Order>(orderJson);
+    auto [plain, plainOk] = meta::fromJson<PlainOrder>(orderJson);
+    assert(ok.valid && plainOk.valid);
+    assert(meta::toJson(*order) == meta::toJson(*plain));
+    assert(order->lines[0].tags[1] == "fragile-handle-with-care" && order->notes.at("delivery").size() == 24);
+    assert(order->flags.size() == 3 && *order->coupon == "SPRING-SALE-2024-FIFTEEN");
+    assert(counting.allocations > 0);
+    std::cout << "  " << counting.allocations << " allocations from the default resource\n\n";
+
+    // Test 2: Everything in the message comes from the arena
+    std::cout << "Test 2: Arena\n";
+    char buffer[16384];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    counting.allocations = 0;
+    {
+        auto [fromArena, arenaOk] = meta::fromJson<Order>(orderJson, &arena);
+        assert(arenaOk.valid && onArena(&arena, *fromArena));
+        assert(meta::toJson(*fromArena) == meta::toJson(*plain));
+    }
+    assert(counting.allocations == 0);
+    arena.release();
+
+    std::string yaml = meta::toYaml(*plain);
+    auto [fromYaml, yamlOk] = meta::reifyFromYaml<Order>(yaml, &arena);
+    assert(yamlOk.valid && onArena(&arena, *fromYaml) && meta::toJson(*fromYaml) == meta::toJson(*plain));
+    assert(counting.allocations == 0);
+    std::cout << "  0 allocations outside the arena\n\n";
+
+    // Test 3: Reading into an object under an ArenaScope
+    std::cout << "Test 3: ArenaScope\n";
+    std::pmr::monotonic_buffer_resource second;
+    Order reused;
+    {
+        meta::ArenaScope scope(&second);
+        assert(meta::fromJson(reused, orderJson).valid);
+    }
+    assert(onArena(&second, reused));
+    assert(meta::ArenaScope::resource() == nullptr);
+    auto [bad, badResult] = meta::fromJson<Order>(R"({"id":"x","lines":[{"sku":1}]})", &arena);
+    assert(!bad && badResult.errors[0].first == "lines.[0].sku");
+    std::cout << "  " << badResult.errors[0].first << ": " << badResult.errors[0].second << "\n";
+
+    std::pmr::set_default_resource(nullptr);
+    std::cout << "\nAll PMR tests passed\n";
+    return 0;
+}
@@ -0,0 +1,285 @@
+// example_proto.cpp - Protobuf wire format from FieldsMeta and ProtoField attributes
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+
+#include "meta_proto.h"
+
+using meta::ProtoEncoding;
+using meta::ProtoField;
+
+// The examples from the protobuf encoding guide
+struct Test1
+{
+    int32_t a;
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&Test1::a>("a", ProtoField<1>{}));
+};
+
+struct Test2
+{
+    std::string b;
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&Test2::b>("b", ProtoField<2>{}));
+};
+
+struct Test3
+{
+    Test1 c;
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&Test3::c>("c", ProtoField<3>{}));
+};
+
+struct Test4
+{
+    std::vector<int32_t> d;
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&Test4::d>("d", ProtoField<4>{}));
+};
+
+// message Reading {
+//   string sensor = 1;
+//   sint32 delta = 2;
+//   repeated double values = 3;
+//   map<string, int32> labels = 4;
+//   optional bool calibrated = 5;
+// }
+struct Reading
+{
+    std::string sensor;
+    int32_t delta;
+    std::vector<double> values;
+    std::map<std::string, int32_t> labels;
+    std::optional<bool> calibrated;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Reading::sensor>("sensor", ProtoField<1>{}, meta::StringLength<1, 16>{}),
+        meta::field<&Reading::delta>("delta", ProtoField<2, ProtoEncoding::ZigZag>{}),
+        meta::field<&Reading::values>("values", ProtoField<3>{}),
+        meta::field<&Reading::labels>("labels", ProtoField<4>{}),
+        meta::field<&Reading::calibrated>("calibrated", ProtoField<5>{}));
+};
+
+struct Point
+{
+    int32_t x;
+    int32_t y;
+    uint64_t stamp;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Point::x>("x"),
+        meta::field<&Point::y>("y", ProtoField<2, ProtoEncoding::ZigZag>{}),
+        meta::field<&Point::stamp>("stamp", ProtoField<3, ProtoEncoding::Fixed>{}));
+};
+
+struct Segment
+{
+    Point from;
+    Point to;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Segment::from>("from"),
+        meta::field<&Segment::to>("to"));
+};
+
+// enum Status { STATUS_UNSPECIFIED = 0; ACTIVE = 1; PAUSED = 2; }
+enum class Status : int32_t { Active = 1, Paused = 2 };
+
+constexpr std::array StatusMapping = std::array{
+    std::pair{Status::Active, "active"},
+    std::pair{Status::Paused, "paused"},
+};
+
+template <> struct meta::EnumMapping<Status>
+{
+    static constexpr auto& mapping = StatusMapping;
+    using Type = meta::EnumTraitsAuto<Status, StatusMapping>;
+};
+
+enum class Priority : uint8_t { Low = 1, High = 2 };
+
+constexpr std::array PriorityMapping = std::array{
+    std::pair{Priority::Low, "low"},
+    std::pair{Priority::High, "high"},
+};
+
+template <> struct meta::EnumMapping<Priority>
+{
+    static constexpr auto& mapping = PriorityMapping;
+    using Type = meta::EnumTraitsAuto<Priority, PriorityMapping>;
+};
+
+// message Job { Status status = 1; repeated Status history = 2; Priority priority = 3; }
+struct Job
+{
+    Status status;
+    std::vector<Status> history;
+    Priority priority;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Job::status>("status"),
+        meta::field<&Job::history>("history"),
+        meta::field<&Job::priority>("priority"));
+};
+
+// Messages too big for a one-byte length, nested
+struct Leaf
+{
+    std::string text;
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&Leaf::text>("text"));
+};
+
+struct Branch
+{
+    Leaf leaf;
+    std::vector<Leaf> leaves;
+    std::map<std::string, Leaf> named;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Branch::leaf>("leaf"),
+        meta::field<&Branch::leaves>("leaves"),
+        meta::field<&Branch::named>("named"));
+};
+
+struct Tree
+{
+    Branch left;
+    std::optional<Branch> right;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Tree::left>("left"),
+        meta::field<&Tree::right>("right"));
+};
+
+// Sizes known from the field types alone
+static_assert(meta::protoMaxSize<Point>() == (1 + 10) + (1 + 5) + (1 + 8));
+static_assert(meta::protoMaxSize<Segment>() == 2 * (1 + 1 + 26));
+static_assert(meta::protoMaxSize<Reading>() == meta::protoUnbounded);
+static_assert(meta::ProtoFields<Point>::numbers == std::array<uint32_t, 3>{1, 2, 3});
+// Only messages with lengths past one byte need the sizing pass
+static_assert(!meta::protoMeasured<Segment>() && meta::protoMeasured<Tree>() && !meta::protoMeasured<Reading>());
+
+std::string hex(std::string_view bytes)
+{
+    std::string out;
+    char buf[4];
+    for (unsigned char c : bytes)
+    {
+        std::snprintf(buf, sizeof(buf), "%02x", c);
+        out += buf;
+    }
+    return out;
+}
+
+std::string unhex(std::string_view text)
+{
+    std::string out;
+    for (size_t i = 0; i + 1 < text.size(); i += 2)
+        out += static_cast<char>(std::stoi(std::string(text.substr(i, 2)), nullptr, 16));
+    return out;
+}
+
+int main()
+{
+    std::cout << "Protobuf wire format\n";
+    std::cout << "====================\n\n";
+
+    // Test 1: Bytes from the protobuf encoding guide
+    std::cout << "Test 1: Reference encodings\n";
+    assert(hex(meta::toProto(Test1{150})) == "089601");
+    assert(hex(meta::toProto(Test2{"testing"})) == "120774657374696e67");
+    assert(hex(meta::toProto(Test3{{150}})) == "1a03089601");
+    assert(hex(meta::toProto(Test4{{3, 270, 86942}})) == "2206038e029ea705");
+    assert(hex(meta::toProto(Test1{-1})) == "08ffffffffffffffffff01");
+    assert(meta::toProto(Test1{0}).empty());
+    std::cout << "  Test4 {d: [3, 270, 86942]} = " << hex(meta::toProto(Test4{{3, 270, 86942}})) << "\n\n";
+
+    // Test 2: Same bytes as protoc (protoc --encode=Reading)
+    std::cout << "Test 2: protoc compatibility\n";
+    const std::string fromProtoc = unhex("0a02743110051a10000000000000e03f000000000000004022080a04726f6f6d10072800");
+    Reading reading{"t1", -3, {0.5, 2.0}, {{"room", 7}}, false};
+    assert(meta::toProto(reading) == fromProtoc);
+    assert(meta::protoSize(reading) == fromProtoc.size());
+    auto [decoded, ok] = meta::fromProto<Reading>(fromProtoc);
+    assert(ok.valid && decoded->delta == -3 && decoded->labels.at("room") == 7 && decoded->calibrated == false);
+    std::cout << "  " << hex(fromProtoc) << "\n\n";
+
+    // Test 3: Parsing rules - unpacked repeated, merging, unknown fields
+    std::cout << "Test 3: Parsing rules\n";
+    // values as two unpacked doubles, then sensor twice (last wins), then unknown field 9
+    std::string input = unhex("19000000000000f03f190000000000000040") + unhex("0a027431") + unhex("0a027432") +
+                        unhex("4807");
+    auto [parsed, parsedOk] = meta::fromProto<Reading>(input);
+    assert(parsedOk.valid && parsed->values == (std::vector<double>{1.0, 2.0}) && parsed->sensor == "t2");
+    // Concatenated messages merge: nested messages field by field
+    std::string merged = meta::toProto(Segment{{1, 0, 0}, {0, 0, 0}}) + meta::toProto(Segment{{0, -2, 0}, {0, 0, 9}});
+    auto [segment, segmentOk] = meta::fromProto<Segment>(merged);
+    assert(segmentOk.valid && segment->from.x == 1 && segment->from.y == -2 && segment->to.stamp == 9);
+    std::cout << "  unpacked, repeated and merged input accepted\n\n";
+
+    // Test 4: Errors
+    std::cout << "Test 4: Errors\n";
+    auto [invalid, invalidResult] = meta::fromProto<Reading>(unhex("10051a08"));
+    assert(!invalid && !invalidResult.valid);
+    for (const auto& [path, message] : invalidResult.errors)
+        std::cout << "  " << path << ": " << message << "\n";
+    auto [mismatch, mismatchResult] = meta::fromProto<Reading>(unhex("0805"));
+    assert(!mismatch && mismatchResult.errors[0].first == "sensor");
+    std::cout << "  " << mismatchResult.errors[0].first << ": " << mismatchResult.errors[0].second << "\n";
+    auto [tooLong, tooLongResult] = meta::fromProto<Reading>(meta::toProto(Reading{std::string(20, 'x'), 0, {}, {}, {}}));
+    assert(!tooLong && tooLongResult.errors[0].first == "sensor");
+    std::cout << "  " << tooLongResult.errors[0].first << ": " << tooLongResult.errors[0].second << "\n";
+
+    std::cout << "\n";
+
+    // Test 5: Enum numbers this build doesn't know are kept
+    std::cout << "Test 5: Open enums\n";
+    // status = 7, history = [1, 0, 9] packed
+    std::string newer = unhex("0807") + unhex("1203010009");
+    auto [job, jobOk] = meta::fromProto<Job>(newer);
+    assert(jobOk.valid && static_cast<int32_t>(job->status) == 7);
+    assert(job->history.size() == 3 && job->history[0] == Status::Active && static_cast<int32_t>(job->history[1]) == 0 &&
+           static_cast<int32_t>(job->history[2]) == 9);
+    assert(meta::toProto(*job) == newer);
+    // ...as far as the C++ type can hold them
+    auto [tooBig, tooBigResult] = meta::fromProto<Job>(unhex("18ac02"));
+    assert(!tooBig && tooBigResult.errors[0].first == "priority");
+    std::cout << "  status 7, history [1, 0, 9] read and written back as " << hex(meta::toProto(*job)) << "\n";
+    std::cout << "  " << tooBigResult.errors[0].first << ": " << tooBigResult.errors[0].second << "\n";
+
+    std::cout << "\n";
+
+    // Test 6: Nested lengths of any size, from one sizing pass
+    std::cout << "Test 6: Nested messages\n";
+    {
+        // tag, varint length, payload
+        auto delimited = [](int tag, const std::string& payload)
+        {
+            std::string out(1, static_cast<char>(tag << 3 | 2));
+            for (size_t n = payload.size(); ; n >>= 7)
+            {
+                out += static_cast<char>(n >= 0x80 ? (n & 0x7f) | 0x80 : n);
+                if (n < 0x80)
+                    break;
+            }
+            return out + payload;
+        };
+        Leaf small{"leaf"}, big{std::string(200, 'x')};
+        Branch branch{big, {small, big, small}, {{"a", small}, {"b", big}}};
+        Tree tree{branch, Branch{small, {}, {}}};
+
+        std::string leaves;
+        for (const Leaf& leaf : branch.leaves)
+            leaves += delimited(2, meta::toProto(leaf));
+        std::string named = delimited(3, delimited(1, "a") + delimited(2, meta::toProto(small))) +
+                            delimited(3, delimited(1, "b") + delimited(2, meta::toProto(big)));
+        std::string left = delimited(1, meta::toProto(big)) + leaves + named;
+        assert(meta::toProto(branch) == left);
+        std::string expected = delimited(1, left) + delimited(2, meta::toProto(*tree.right));
+        std::string bytes = meta::toProto(tree);
+        assert(bytes == expected && meta::protoSize(tree) == bytes.size());
+
+        auto [copy, copyOk] = meta::fromProto<Tree>(bytes);
+        assert(copyOk.valid && copy->left.named.at("b").text == big.text && copy->right->leaf.text == "leaf");
+        std::cout << "  " << bytes.size() << " bytes, " << left.size() << " in the left branch\n";
+    }
+
+    std::cout << "\nAll protobuf tests passed\n";
+    return 0;
+}
@@ -0,0 +1,93 @@
+// example_reload.cpp - Parsed objects are built in place, and reloads can refill an existing object
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "meta.h"
+#include "meta_json.h"
+
+// Counts copies so the tests can check the public API never makes one
+struct Tracked
+{
+    static inline int copies = 0;
+
+    std::string id;
+
+    Tracked() = default;
+    Tracked(const Tracked& other) : id(other.id) { ++copies; }
+    Tracked(Tracked&&) = default;
+    Tracked& operator=(const Tracked& other)
+    {
+        id = other.id;
+        ++copies;
+        return *this;
+    }
+    Tracked& operator=(Tracked&&) = default;
+
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&Tracked::id>("id"));
+};
+
+struct Config
+{
+    std::string name;
+    std::vector<int> ports;
+    std::vector<std::string> hosts;
+    Tracked owner;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Config::name>("name"),
+        meta::field<&Config::ports>("ports"),
+        meta::field<&Config::hosts>("hosts"),
+        meta::field<&Config::owner>("owner"));
+};
+
+int main()
+{
+    std::cout << "Loading and reloading\n";
+    std::cout << "=====================\n\n";
+
+    const std::string yaml = "name: edge\nports: [80, 443]\nhosts: [a, b, c]\nowner: {id: ops}\n";
+    const std::string json = R"({"name":"edge","ports":[80,443],"hosts":["a","b","c"],"owner":{"id":"ops"}})";
+
+    // Test 1: The result is constructed inside the optional
+    std::cout << "Test 1: No copies\n";
+    auto [fromYaml, yamlOk] = meta::reifyFromYaml<Config>(yaml);
+    auto [fromNode, nodeOk] = meta::reifyFromYaml<Config>(YAML::Load(yaml));
+    auto [fromJson, jsonOk] = meta::fromJson<Config>(json);
+    assert(yamlOk.valid && nodeOk.valid && jsonOk.valid);
+    assert(fromYaml->owner.id == "ops" && fromNode->hosts.size() == 3 && fromJson->ports[1] == 443);
+    assert(Tracked::copies == 0);
+    std::cout << "  " << Tracked::copies << " copies of the parsed object\n\n";
+
+    // Test 2: Reload into the same object, keeping its buffers
+    std::cout << "Test 2: Reload\n";
+    Config live;
+    live.ports.reserve(64);
+    const int* buffer = live.ports.data();
+    for (int generation = 0; generation < 3; ++generation)
+    {
+        std::string next = "name: gen" + std::to_string(generation) + "\nports: [" + std::to_string(8000 + generation) +
+                           ", 9000]\nhosts: [h]\nowner: {id: team}\n";
+        auto result = meta::reifyFromYaml(live, next);
+        assert(result.valid && live.name == "gen" + std::to_string(generation) && live.ports[0] == 8000 + generation);
+    }
+    assert(live.ports.data() == buffer && live.ports.capacity() == 64);
+    assert(meta::fromJson(live, json).valid && live.name == "edge" && live.ports.data() == buffer);
+    assert(Tracked::copies == 0);
+    std::cout << "  " << live.name << " on " << live.ports.size() << " ports, buffer reused\n\n";
+
+    // Test 3: A reused YamlDocument and failed reloads
+    std::cout << "Test 3: Errors\n";
+    meta::YamlDocument doc;
+    doc.parse("name: parsed-once\nports: []\nhosts: []\nowner: {id: x}\n");
+    assert(meta::reifyFromYaml(live, doc).valid && live.name == "parsed-once" && live.ports.empty());
+    auto bad = meta::reifyFromYaml(live, "name: [oops\n");
+    assert(!bad.valid && bad.errors[0].first == "yaml" && live.name == "parsed-once");
+    auto missing = meta::fromJson(live, R"({"name":"partial"})");
+    assert(!missing.valid && live.name == "partial");
+    for (const auto& [path, message] : missing.errors)
+        std::cout << "  " << path << ": " << message << "\n";
+
+    std::cout << "\nAll reload tests passed\n";
+    return 0;
+}
@@ -0,0 +1,113 @@
+// example_soa.cpp - soa_vector: per-field columns, row proxies and the existing serializers
+#include <cassert>
+#include <iostream>
+#include <numeric>
+
+#include "meta_csv.h"
+#include "meta_json.h"
+#include "meta_parallel.h"
+#include "meta_soa.h"
+
+enum class Dept { Eng, Sales, Ops };
+
+constexpr std::array DeptMapping = std::array{
+    std::pair{Dept::Eng, "eng"},
+    std::pair{Dept::Sales, "sales"},
+    std::pair{Dept::Ops, "ops"},
+};
+
+template <> struct meta::EnumMapping<Dept>
+{
+    static constexpr auto& mapping = DeptMapping;
+    using Type = meta::EnumTraitsAuto<Dept, DeptMapping>;
+};
+
+struct Person
+{
+    std::string name;
+    int age;
+    double salary;
+    bool active;
+    Dept dept;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Person::name>("name", meta::StringLength<1, 32>{}),
+        meta::field<&Person::age>("age", meta::BoundsCheck<0, 150>{}),
+        meta::field<&Person::salary>("salary"),
+        meta::field<&Person::active>("active"),
+        meta::field<&Person::dept>("dept"));
+};
+
+static_assert(std::ranges::random_access_range<meta::soa_vector<Person>>);
+static_assert(meta::soa_vector<Person>::indexOf<&Person::salary>() == 2);
+
+int main()
+{
+    std::cout << "Struct of arrays\n";
+    std::cout << "================\n\n";
+
+    std::vector<Person> rows;
+    for (int i = 0; i < 10000; ++i)
+        rows.push_back({"p" + std::to_string(i), 20 + i % 40, 1000.0 + i, i % 3 != 0, static_cast<Dept>(i % 3)});
+
+    // Test 1: Conversion and whole-record operations
+    std::cout << "Test 1: Records\n";
+    meta::soa_vector<Person> people(rows);
+    assert(people.size() == rows.size());
+    std::vector<Person> back = people.to_vector();
+    for (size_t i = 0; i < rows.size(); ++i)
+        assert(meta::checkForEquality(rows[i], back[i]));
+
+    people.push_back(Person{"Ada", 36, 9000.0, true, Dept::Eng});
+    people.emplace_back("Bob", 41, 4000.0, false, Dept::Ops);
+    assert(people.size() == rows.size() + 2 && people.back().get<&Person::name>() == "Bob");
+    people.pop_back();
+    Person ada = people.back();
+    assert(ada.name == "Ada" && ada.age == 36 && ada.dept == Dept::Eng);
+
+    people[0] = ada;
+    people[1].get<&Person::age>() = 99;
+    assert(people[0].get<&Person::name>() == "Ada" && people[1].get<&Person::age>() == 99);
+    people[0] = rows[0];
+    people[1].get<&Person::age>() = rows[1].age;
+    people.pop_back();
+    std::cout << "  " << people.size() << " rows\n\n";
+
+    // Test 2: One column at a time
+    std::cout << "Test 2: Column spans\n";
+    std::span<const double> salaries = std::as_const(people).column<&Person::salary>();
+    double total = std::accumulate(salaries.begin(), salaries.end(), 0.0);
+    std::span<bool> active = people.column<&Person::active>();
+    auto activeCount = std::count(active.begin(), active.end(), true);
+    for (int& age : people.column<&Person::age>())
+        age += 1;
+    assert(people[5].get<&Person::age>() == rows[5].age + 1);
+    for (int& age : people.column<&Person::age>())
+        age -= 1;
+    assert(activeCount == 6666 && total == 10000 * 1000.0 + 9999.0 * 10000 / 2);
+    std::cout << "  sum(salary) = " << total << ", " << activeCount << " active\n\n";
+
+    // Test 3: Serializers see the same records as std::vector<Person>
+    std::cout << "Test 3: Serializers\n";
+    assert(meta::toJson(people) == meta::toJson(rows));
+    assert(meta::toYaml(people) == meta::toYaml(rows));
+    assert(meta::serializeJson(people) == meta::serializeJson(rows));
+    assert(meta::toCSVWithHeader(people) == meta::toCSVWithHeader(rows));
+    assert(meta::serializeJsonParallel(people, {4, 500}) == meta::serializeJson(rows));
+
+    std::vector<Person> few(rows.begin(), rows.begin() + 3);
+    auto [loaded, ok] = meta::fromJson<meta::soa_vector<Person>>(meta::toJson(few));
+    assert(ok.valid && loaded->size() == 3 && loaded->to_vector()[2].name == "p2");
+    std::cout << meta::toCSVWithHeader(meta::soa_vector<Person>(few));
+
+    few[1].age = 200;
+    few[2].name = "";
+    auto [rejected, rejectedResult] = meta::fromJson<meta::soa_vector<Person>>(meta::toJson(few));
+    assert(!rejected);
+    for (const auto& [path, message] : rejectedResult.errors)
+        std::cout << "  " << path << ": " << message << "\n";
+    assert(rejectedResult.errors[0].first == "[1].age" && rejectedResult.errors[1].first == "[2].name");
+
+    std::cout << "\nAll soa_vector tests passed\n";
+    return 0;
+}
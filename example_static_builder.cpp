@@ -0,0 +1,97 @@
+// example_static_builder.cpp - Builders as template parameters, with Builder as the type-erased fallback
+#include <cassert>
+#include <iostream>
+
+#include "meta.h"
+
+struct Point
+{
+    int x;
+    int y;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Point::x>("x"),
+        meta::field<&Point::y>("y"));
+};
+
+struct Shape
+{
+    std::string name;
+    std::vector<Point> points;
+    std::optional<double> area;
+    std::map<std::string, bool> flags;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Shape::name>("name"),
+        meta::field<&Shape::points>("points"),
+        meta::field<&Shape::area>("area"),
+        meta::field<&Shape::flags>("flags"));
+};
+
+// A builder outside namespace meta that does not derive from meta::Builder:
+// it only has to provide the event methods
+struct StatsBuilder
+{
+    int scalars = 0;
+    int keys = 0;
+    int depth = 0;
+    int maxDepth = 0;
+
+    void writeInt(int) { ++scalars; }
+    void writeDouble(double) { ++scalars; }
+    void writeBool(bool) { ++scalars; }
+    void writeString(const std::string&) { ++scalars; }
+    void writeNull() { ++scalars; }
+    void startSeq(const std::string& = "") { maxDepth = std::max(maxDepth, ++depth); }
+    void endSeq() { --depth; }
+    void startFlowSeq() { startSeq(); }
+    void endFlowSeq() { endSeq(); }
+    void startMap(const std::string& = "") { maxDepth = std::max(maxDepth, ++depth); }
+    void endMap() { --depth; }
+    void key(const std::string&) { ++keys; }
+};
+
+static_assert(meta::BuilderLike<StatsBuilder>);
+static_assert(meta::BuilderLike<meta::Builder>);
+static_assert(!meta::BuilderLike<int>);
+
+int main()
+{
+    std::cout << "Static builder dispatch\n";
+    std::cout << "=======================\n\n";
+
+    Shape shape{"triangle", {{0, 0}, {4, 0}, {0, 3}}, 6.0, {{"closed", true}, {"filled", false}}};
+
+    // Test 1: Static dispatch into a user-defined builder
+    std::cout << "Test 1: StatsBuilder\n";
+    StatsBuilder stats;
+    meta::to(shape, stats);
+    assert(stats.scalars == 1 + 6 + 1 + 2);
+    assert(stats.keys == 4 + 6 + 2);
+    assert(stats.depth == 0 && stats.maxDepth == 3);
+    std::cout << "  " << stats.scalars << " scalars, " << stats.keys << " keys, depth "
+              << stats.maxDepth << "\n\n";
+
+    // Test 2: Static and virtual paths produce the same document
+    std::cout << "Test 2: JsonBuilder& vs Builder*\n";
+    meta::JsonBuilder direct;
+    meta::to(shape, direct);
+    meta::JsonBuilder erased;
+    meta::to(shape, static_cast<meta::Builder*>(&erased));
+    std::string json = direct.result();
+    assert(json == erased.result() && json == meta::toJson(shape));
+    std::cout << "  " << json << "\n\n";
+
+    // Test 3: Runtime format selection over a static builder
+    std::cout << "Test 3: BuilderRef\n";
+    StatsBuilder counted;
+    meta::BuilderRef<StatsBuilder> ref(counted);
+    meta::Builder* selected = &ref;
+    meta::to(shape, selected);
+    assert(counted.scalars == stats.scalars && counted.keys == stats.keys);
+    assert(selected->result().empty());
+    std::cout << "  counted " << counted.scalars << " scalars through the vtable\n";
+
+    std::cout << "\nAll static builder tests passed\n";
+    return 0;
+}
@@ -0,0 +1,239 @@
+// example_stream.cpp - Reading JSON and YAML as it arrives, one chunk at a time
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+#include "meta.h"
+#include "meta_json.h"
+#include "meta_stream.h"
+
+struct Order
+{
+    int id;
+    std::string item;
+    int qty;
+    std::vector<std::string> tags;
+    std::optional<std::string> note;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Order::id>("id"),
+        meta::field<&Order::item>("item"),
+        meta::field<&Order::qty>("qty", meta::BoundsCheck<1, 100>{}),
+        meta::field<&Order::tags>("tags"),
+        meta::field<&Order::note>("note"));
+};
+
+struct Batch
+{
+    std::string source;
+    int version;
+    std::vector<Order> orders;
+    std::vector<int> checksums;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Batch::source>("source"),
+        meta::field<&Batch::version>("version"),
+        meta::field<&Batch::orders>("orders"),
+        meta::field<&Batch::checksums>("checksums"));
+};
+
+std::vector<Order> makeOrders(int n)
+{
+    std::vector<Order> orders;
+    for (int i = 0; i < n; ++i)
+        orders.push_back({i, "item \"" + std::to_string(i) + "\" \\ [x]", 1 + i % 100, {"a,b", "{c}"},
+                          i % 3 ? std::nullopt : std::optional<std::string>("café ✓")});
+    return orders;
+}
+
+// Feeds text in pieces of `size` bytes
+template <typename Stream>
+void feedIn(Stream& stream, std::string_view text, size_t size)
+{
+    for (size_t at = 0; at < text.size(); at += size)
+        stream.feed(text.substr(at, size));
+}
+
+int main()
+{
+    std::cout << "Streaming\n";
+    std::cout << "=========\n\n";
+
+    const auto orders = makeOrders(40);
+    const std::string json = meta::toJson(orders);
+
+    // Test 1: Any chunking gives the same elements as reading the whole array
+    std::cout << "Test 1: JSON array, every chunk size\n";
+    for (size_t size = 1; size <= json.size(); size += size < 16 ? 1 : 97)
+    {
+        std::vector<Order> got;
+        auto stream = meta::streamJsonArray<Order>([&](Order&& order, size_t i) {
+            assert(i == got.size());
+            got.push_back(std::move(order));
+        });
+        feedIn(stream, json, size);
+        auto result = stream.finish();
+        assert(result.valid && stream.count() == orders.size());
+        assert(meta::toJson(got) == json);
+    }
+    std::cout << "  " << orders.size() << " orders, " << json.size() << " bytes\n\n";
+
+    // Test 2: Elements are handed over before the input ends
+    std::cout << "Test 2: Delivery as elements complete\n";
+    {
+        size_t delivered = 0;
+        auto stream = meta::streamJsonArray<Order>([&](Order&&) { ++delivered; });
+        std::string first = meta::toJson(orders[0]);
+        stream.feed("[" + first + "," + first.substr(0, 10));
+        assert(delivered == 1);
+        stream.feed(first.substr(10) + "]");
+        assert(delivered == 2 && stream.finish().valid);
+        std::cout << "  1 order before the second chunk, 2 after\n\n";
+    }
+
+    // Test 3: Memory is bounded by one element, not the document
+    std::cout << "Test 3: Bounded buffering\n";
+    {
+        const auto many = makeOrders(5000);
+        const std::string big = meta::toJson(many);
+        size_t largest = 0;
+        for (const auto& order : many)
+            largest = std::max(largest, meta::toJson(order).size());
+        size_t peak = 0;
+        size_t delivered = 0;
+        auto stream = meta::streamJsonArray<Order>([&](Order&&) { ++delivered; });
+        for (size_t at = 0; at < big.size(); at += 4096)
+        {
+            stream.feed(std::string_view(big).substr(at, 4096));
+            peak = std::max(peak, stream.buffered());
+        }
+        assert(stream.finish().valid && delivered == many.size());
+        assert(peak <= largest);
+        std::cout << "  " << big.size() << " bytes read holding at most " << peak << "\n\n";
+    }
+
+    // Test 4: A bad element is left out and reported; the rest still arrive
+    std::cout << "Test 4: Element errors\n";
+    {
+        std::vector<int> ids;
+        auto stream = meta::streamJsonArray<Order>([&](Order&& order) { ids.push_back(order.id); });
+        feedIn(stream,
+               R"([{"id":1,"item":"a","qty":5,"tags":[]},)"
+               R"({"id":2,"item":"b","qty":500,"tags":[]},)"
+               R"({"id":3,"item":"c","qty":,"tags":[]},)"
+               R"({"id":4,"item":"d","qty":5,"tags":["x"]}])",
+               5);
+        auto result = stream.finish();
+        assert(!result.valid && result.errors.size() == 2);
+        assert((ids == std::vector<int>{1, 4}));
+        assert(result.errors[0].first == "[1].qty");
+        assert(result.errors[1].first == "[2]" && result.errors[1].second == "Unexpected character at offset 104");
+        std::cout << "  " << result.errors[1].first << ": " << result.errors[1].second << "\n";
+
+        meta::FailFast quick;
+        ids.clear();
+        auto strict = meta::streamJsonArray<Order>([&](Order&& order) { ids.push_back(order.id); });
+        strict.feed(R"([{"id":1,"item":"a","qty":0,"tags":[]},{"id":2,"item":"b","qty":5,"tags":[]}])");
+        auto stopped = strict.finish();
+        assert(!stopped.valid && stopped.errors.size() == 1 && ids.empty());
+        std::cout << "\n";
+    }
+
+    // Test 5: Malformed or unfinished input
+    std::cout << "Test 5: Structural errors\n";
+    for (auto [text, expected] : std::vector<std::pair<std::string, std::string>>{
+             {R"({"id":1})", "Expected a JSON array at offset 0"},
+             {R"([{"id":1,"item":"a","qty":5,"tags":[]})", "Unexpected end of input at offset 38"},
+             {"[1,]", "Trailing comma at offset 3"},
+             {"[[1}]", "Mismatched bracket at offset 3"},
+             {"[] []", "Trailing characters after JSON value at offset 3"}})
+    {
+        auto stream = meta::streamJsonArray<Order>([](Order&&) {});
+        feedIn(stream, text, 2);
+        auto result = stream.finish();
+        assert(!result.valid && result.errors.back().first == "json" && result.errors.back().second == expected);
+        std::cout << "  " << result.errors.back().second << "\n";
+    }
+    std::cout << "\n";
+
+    // Test 6: A top-level object is read member by member
+    std::cout << "Test 6: JSON object\n";
+    {
+        Batch batch{"edge-1", 3, makeOrders(25), std::vector<int>(1000, 7)};
+        const std::string text = meta::toJson(batch);
+        for (size_t size : {1, 3, 64, 4096})
+        {
+            meta::JsonObjectStream<Batch> stream;
+            feedIn(stream, text, size);
+            auto [loaded, result] = stream.finish();
+            assert(result.valid && meta::toJson(*loaded) == text);
+        }
+
+        meta::JsonObjectStream<Batch> partial;
+        partial.feed(R"({"source":"edge-2","extra":{"x":[1,2]},"orders":[],"checksums":[]})");
+        auto [missing, missingResult] = partial.finish();
+        assert(!missing && missingResult.errors.size() == 1 && missingResult.errors[0].first == "version");
+        std::cout << "  " << text.size() << " bytes; without version: " << missingResult.errors[0].second << "\n\n";
+    }
+
+    // Test 7: A YAML block sequence, entry by entry
+    std::cout << "Test 7: YAML sequence\n";
+    {
+        const std::string yaml = meta::toYaml(orders);
+        for (size_t size : {size_t(1), size_t(7), size_t(256), yaml.size()})
+        {
+            std::vector<Order> got;
+            auto stream = meta::streamYamlSequence<Order>([&](Order&& order) { got.push_back(std::move(order)); });
+            feedIn(stream, "---\n# orders\n" + yaml + "\n", size);
+            auto result = stream.finish();
+            assert(result.valid && meta::toJson(got) == json);
+        }
+
+        std::vector<int> ids;
+        auto stream = meta::streamYamlSequence<Order>([&](Order&& order) { ids.push_back(order.id); });
+        feedIn(stream,
+               "- id: 1\n  item: a\n  qty: 5\n  tags: []\n"
+               "- id: 2\n  item: b\n  qty: 7\n  tags: [x, y\n"
+               "- id: 3\n  item: c\n  qty: 9\n  tags:\n    - z\n",
+               3);
+        auto result = stream.finish();
+        assert((ids == std::vector<int>{1, 3}) && result.errors.size() == 1 && result.errors[0].first == "[1]");
+        assert(result.errors[0].second.find("line 9") != std::string::npos);
+        std::cout << "  " << result.errors[0].first << ": " << result.errors[0].second << "\n";
+
+        // A flow sequence can't be split, so it is read when the input ends
+        std::vector<int> flow;
+        auto whole = meta::streamYamlSequence<Order>([&](Order&& order) { flow.push_back(order.id); });
+        feedIn(whole, "[{id: 5, item: e, qty: 1, tags: []},\n {id: 6, item: f, qty: 2, tags: []}]\n", 4);
+        assert(whole.finish().valid && (flow == std::vector<int>{5, 6}));
+        std::cout << "\n";
+    }
+
+    // Test 8: A YAML mapping into a struct
+    std::cout << "Test 8: YAML object\n";
+    {
+        Batch batch{"edge-1", 3, makeOrders(10), {1, 2, 3}};
+        const std::string yaml = meta::toYaml(batch);
+        for (size_t size : {size_t(1), size_t(5), yaml.size()})
+        {
+            meta::YamlObjectStream<Batch> stream;
+            feedIn(stream, yaml, size);
+            auto [loaded, result] = stream.finish();
+            assert(result.valid && meta::toJson(*loaded) == meta::toJson(batch));
+        }
+
+        meta::YamlObjectStream<Batch> stream;
+        feedIn(stream, "source: edge-3\nversion: 4\nregion: eu\norders:\n- id: 1\n  item: a\n  qty: 0\n  tags: []\n"
+                       "checksums: [9]\n", 6);
+        auto [loaded, result] = stream.finish();
+        assert(!loaded && result.errors.size() == 2);
+        assert(result.errors[0].first == "region" && result.errors[1].first == "orders.[0].qty");
+        for (const auto& [field, error] : result.errors)
+            std::cout << "  " << field << ": " << error << "\n";
+    }
+
+    std::cout << "\nAll streaming tests passed\n";
+    return 0;
+}
@@ -0,0 +1,107 @@
+// example_string_views.cpp - std::string_view and byte span fields that point into the input buffer
+#include <cassert>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "meta.h"
+#include "meta_binary.h"
+#include "meta_json.h"
+
+struct LogLine
+{
+    std::string_view level;
+    std::string_view message;
+    std::vector<std::string_view> tags;
+    std::optional<std::string_view> trace;
+    int code;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&LogLine::level>("level"),
+        meta::field<&LogLine::message>("message"),
+        meta::field<&LogLine::tags>("tags"),
+        meta::field<&LogLine::trace>("trace"),
+        meta::field<&LogLine::code>("code"));
+};
+
+// The same record with owning strings
+struct OwnedLogLine
+{
+    std::string level;
+    std::string message;
+    std::vector<std::string> tags;
+    std::optional<std::string> trace;
+    int code;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&OwnedLogLine::level>("level"),
+        meta::field<&OwnedLogLine::message>("message"),
+        meta::field<&OwnedLogLine::tags>("tags"),
+        meta::field<&OwnedLogLine::trace>("trace"),
+        meta::field<&OwnedLogLine::code>("code"));
+};
+
+struct Blob
+{
+    std::string_view name;
+    std::span<const std::byte> payload;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Blob::name>("name"),
+        meta::field<&Blob::payload>("payload"));
+};
+
+bool inside(std::string_view buffer, std::string_view view)
+{
+    return view.data() >= buffer.data() && view.data() + view.size() <= buffer.data() + buffer.size();
+}
+
+int main()
+{
+    std::cout << "Borrowed string fields\n";
+    std::cout << "======================\n\n";
+
+    // Test 1: JSON strings are views of the input
+    std::cout << "Test 1: JSON\n";
+    const std::string json =
+        R"({"level":"warn","message":"disk almost full","tags":["disk","node-7"],"trace":"a1b2","code":507})";
+    auto [line, ok] = meta::fromJson<LogLine>(json);
+    assert(ok.valid && line->level == "warn" && line->tags[1] == "node-7" && line->trace == "a1b2");
+    assert(inside(json, line->level) && inside(json, line->message) && inside(json, line->tags[0]) &&
+           inside(json, *line->trace));
+    auto [owned, ownedOk] = meta::fromJson<OwnedLogLine>(json);
+    assert(ownedOk.valid && meta::toJson(*line) == meta::toJson(*owned) && meta::toJson(*line) == json);
+    std::cout << "  " << line->level << ": " << line->message << "\n\n";
+
+    // Test 2: Binary strings and byte spans are views of the input
+    std::cout << "Test 2: Binary\n";
+    std::string bytes = meta::toBinary(*owned);
+    auto [fromBytes, bytesOk] = meta::fromBinary<LogLine>(bytes, {.requireSameSchema = true});
+    assert(bytesOk.valid && inside(bytes, fromBytes->message) && inside(bytes, fromBytes->tags[1]));
+    assert(meta::toJson(*fromBytes) == json);
+
+    const char raw[] = {'\x00', '\x01', '\xfe', '\xff'};
+    Blob blob{"firmware", std::as_bytes(std::span(raw))};
+    std::string blobBytes = meta::toBinary(blob);
+    auto [readBlob, blobOk] = meta::fromBinary<Blob>(blobBytes);
+    assert(blobOk.valid && readBlob->name == "firmware" && readBlob->payload.size() == 4);
+    assert(readBlob->payload[2] == std::byte{0xfe});
+    assert(inside(blobBytes, {reinterpret_cast<const char*>(readBlob->payload.data()), readBlob->payload.size()}));
+    std::cout << "  " << readBlob->name << ": " << readBlob->payload.size() << " bytes\n\n";
+
+    // Test 3: Strings that can't be borrowed
+    std::cout << "Test 3: Errors\n";
+    auto [escaped, escapedResult] =
+        meta::fromJson<LogLine>(R"({"level":"info","message":"line\nbreak","tags":[],"code":0})");
+    assert(!escaped && escapedResult.errors.size() == 1 && escapedResult.errors[0].first == "message");
+    std::cout << "  " << escapedResult.errors[0].first << ": " << escapedResult.errors[0].second << "\n";
+    auto [wrongType, wrongResult] = meta::fromJson<LogLine>(R"({"level":1,"message":"m","tags":[],"code":0})");
+    assert(!wrongType && wrongResult.errors[0].second == "Expected string");
+    auto [yaml, yamlResult] = meta::reifyFromYaml<LogLine>("level: info\nmessage: m\ntags: []\ncode: 0\n");
+    assert(!yaml && yamlResult.errors[0].first == "level");
+    std::cout << "  yaml " << yamlResult.errors[0].first << ": " << yamlResult.errors[0].second << "\n";
+
+    std::cout << "\nAll borrowed string tests passed\n";
+    return 0;
+}
@@ -0,0 +1,115 @@
+// example_tagged_variant.cpp - VariantTags: variants written with a type tag and read back by it
+#include <cassert>
+#include <iostream>
+
+#include "meta.h"
+#include "meta_json.h"
+
+struct Circle
+{
+    double radius;
+
+    static constexpr auto FieldsMeta = std::make_tuple(meta::field<&Circle::radius>("radius"));
+};
+
+struct Rect
+{
+    double width;
+    double height;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Rect::width>("width"),
+        meta::field<&Rect::height>("height"));
+};
+
+// Same fields as Rect, so the untagged encoding can't tell them apart
+struct Ellipse
+{
+    double width;
+    double height;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Ellipse::width>("width"),
+        meta::field<&Ellipse::height>("height"));
+};
+
+using Shape = std::variant<std::monostate, Circle, Rect, Ellipse>;
+
+template <> struct meta::VariantTags<Shape>
+{
+    static constexpr std::array names{"none", "circle", "rect", "ellipse"};
+    static constexpr std::string_view key = "kind";
+};
+
+// Defaults: "type" and "value"
+using Setting = std::variant<int, std::string, std::vector<int>>;
+
+template <> struct meta::VariantTags<Setting>
+{
+    static constexpr std::array names{"int", "text", "list"};
+};
+
+using Untagged = std::variant<Rect, Ellipse>;
+
+struct Drawing
+{
+    std::string name;
+    std::vector<Shape> shapes;
+    std::map<std::string, Setting> settings;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Drawing::name>("name"),
+        meta::field<&Drawing::shapes>("shapes"),
+        meta::field<&Drawing::settings>("settings"));
+};
+
+int main()
+{
+    std::cout << "Tagged variants\n";
+    std::cout << "===============\n\n";
+
+    // Test 1: The tag picks the alternative
+    std::cout << "Test 1: JSON\n";
+    Drawing drawing{"plan", {Circle{1.5}, Rect{2, 3}, Ellipse{2, 3}, std::monostate{}},
+                    {{"depth", 3}, {"label", std::string("north")}, {"grid", std::vector<int>{1, 2}}}};
+    std::string json = meta::toJson(drawing);
+    std::cout << "  " << json << "\n";
+    assert(json.find(R"({"kind":"circle","value":{"radius":1.5}})") != std::string::npos);
+    assert(json.find(R"({"kind":"none"})") != std::string::npos);
+    assert(json.find(R"("label":{"type":"text","value":"north"})") != std::string::npos);
+    auto [copy, ok] = meta::fromJson<Drawing>(json);
+    assert(ok.valid && copy->shapes.size() == 4);
+    assert(std::get<Circle>(copy->shapes[0]).radius == 1.5);
+    assert(std::holds_alternative<Rect>(copy->shapes[1]) && std::holds_alternative<Ellipse>(copy->shapes[2]));
+    assert(std::holds_alternative<std::monostate>(copy->shapes[3]));
+    assert(std::get<std::vector<int>>(copy->settings["grid"]).size() == 2);
+
+    // Untagged variants still take the first alternative that parses
+    auto [guess, guessOk] = meta::fromJson<Untagged>(meta::toJson(Untagged{Ellipse{1, 1}}));
+    assert(guessOk.valid && std::holds_alternative<Rect>(*guess));
+    std::cout << "\n";
+
+    // Test 2: YAML
+    std::cout << "Test 2: YAML\n";
+    std::string yaml = meta::toYaml(drawing);
+    auto [fromYaml, yamlOk] = meta::reifyFromYaml<Drawing>(yaml);
+    assert(yamlOk.valid && std::get<Ellipse>(fromYaml->shapes[2]).height == 3);
+    assert(std::get<std::string>(fromYaml->settings["label"]) == "north");
+    std::cout << "  " << fromYaml->shapes.size() << " shapes, " << fromYaml->settings.size() << " settings\n\n";
+
+    // Test 3: Errors name the tag or the value
+    std::cout << "Test 3: Errors\n";
+    auto [bad, badResult] = meta::fromJson<Drawing>(
+        R"({"name":"x","shapes":[{"kind":"square"},{"value":{}},{"kind":"circle","value":{"radius":"big"}},)"
+        R"({"kind":"rect"}],"settings":{}})");
+    assert(!badResult.valid && badResult.errors.size() == 4);
+    for (const auto& [path, message] : badResult.errors)
+        std::cout << "  " << path << ": " << message << "\n";
+    assert(badResult.errors[0].first == "shapes.[0].kind");
+    assert(badResult.errors[1].second == "Missing variant tag");
+    assert(badResult.errors[2].first == "shapes.[2].value.radius");
+    assert(badResult.errors[3].first == "shapes.[3].value");
+
+    std::cout << "\nAll tagged variant tests passed\n";
+    return 0;
+}
@@ -0,0 +1,248 @@
+// example_unknown_fields.cpp - Older readers skipping, noting or rejecting fields added by newer writers
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "meta.h"
+#include "meta_binary.h"
+#include "meta_json.h"
+#include "meta_proto.h"
+
+// What a new release writes
+namespace v2
+{
+struct Plugin
+{
+    std::string name;
+    bool enabled;
+    std::map<std::string, std::string> settings;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Plugin::name>("name"),
+        meta::field<&Plugin::enabled>("enabled"),
+        meta::field<&Plugin::settings>("settings"));
+};
+
+struct Config
+{
+    std::string service;
+    int32_t port;
+    std::vector<Plugin> plugins;
+    std::vector<double> weights;
+    std::string region;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Config::service>("service"),
+        meta::field<&Config::port>("port"),
+        meta::field<&Config::plugins>("plugins"),
+        meta::field<&Config::weights>("weights"),
+        meta::field<&Config::region>("region", meta::BinaryTag<40>{}, meta::ProtoField<40>{}));
+};
+} // namespace v2
+
+// What the release before it reads
+namespace v1
+{
+struct Plugin
+{
+    std::string name;
+    bool enabled;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Plugin::name>("name"),
+        meta::field<&Plugin::enabled>("enabled"));
+};
+
+struct Config
+{
+    std::string service;
+    int32_t port;
+    std::vector<Plugin> plugins;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Config::service>("service"),
+        meta::field<&Config::port>("port"),
+        meta::field<&Config::plugins>("plugins"));
+};
+} // namespace v1
+
+// Plugins may grow settings we want to hear about; Config stays quiet
+template <> struct meta::UnknownFieldPolicy<v1::Plugin>
+{
+    static constexpr auto value = meta::UnknownFields::Collect;
+};
+
+// A listener has to be understood exactly or not at all
+struct Listener
+{
+    std::string host;
+    int32_t port;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Listener::host>("host"),
+        meta::field<&Listener::port>("port"));
+};
+
+template <> struct meta::UnknownFieldPolicy<Listener>
+{
+    static constexpr auto value = meta::UnknownFields::Error;
+};
+
+struct Gateway
+{
+    std::string name;
+    std::vector<Listener> listeners;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Gateway::name>("name"),
+        meta::field<&Gateway::listeners>("listeners"));
+};
+
+struct ListenerV2
+{
+    std::string host;
+    int32_t port;
+    bool tls;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&ListenerV2::host>("host"),
+        meta::field<&ListenerV2::port>("port"),
+        meta::field<&ListenerV2::tls>("tls"));
+};
+
+struct GatewayV2
+{
+    std::string name;
+    std::vector<ListenerV2> listeners;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&GatewayV2::name>("name"),
+        meta::field<&GatewayV2::listeners>("listeners"));
+};
+
+v2::Config makeConfig()
+{
+    v2::Config config{"billing", 8443, {}, {0.5, 0.25, 0.25}, "eu-west"};
+    for (int i = 0; i < 50; ++i)
+        config.plugins.push_back({"plugin-" + std::to_string(i), i % 2 == 0, {{"level", "debug"}, {"ttl", "30"}}});
+    return config;
+}
+
+bool sameAsWritten(const v1::Config& read, const v2::Config& written)
+{
+    if (read.service != written.service || read.port != written.port || read.plugins.size() != written.plugins.size())
+        return false;
+    for (size_t i = 0; i < read.plugins.size(); ++i)
+        if (read.plugins[i].name != written.plugins[i].name || read.plugins[i].enabled != written.plugins[i].enabled)
+            return false;
+    return true;
+}
+
+int main()
+{
+    std::cout << "Unknown fields\n";
+    std::cout << "==============\n\n";
+
+    const v2::Config written = makeConfig();
+    const std::string json = meta::toJson(written);
+    const std::string binary = meta::toBinary(written);
+    const std::string proto = meta::toProto(written);
+
+    // Test 1: An older reader takes what it knows from every format
+    std::cout << "Test 1: v2 documents read as v1\n";
+    {
+        auto [fromJson, jsonResult] = meta::fromJson<v1::Config>(json);
+        assert(jsonResult.valid && jsonResult.errors.empty() && sameAsWritten(*fromJson, written));
+
+        auto [fromBinary, binaryResult] = meta::fromBinary<v1::Config>(binary);
+        assert(binaryResult.valid && binaryResult.errors.empty() && sameAsWritten(*fromBinary, written));
+
+        auto [fromProto, protoResult] = meta::fromProto<v1::Config>(proto);
+        assert(protoResult.valid && protoResult.errors.empty() && sameAsWritten(*fromProto, written));
+
+        // reifyFromYaml lists a document's unknown top-level keys, as it always has
+        auto [fromYaml, yamlResult] = meta::reifyFromYaml<v1::Config>(meta::toYaml(written));
+        assert(yamlResult.valid && sameAsWritten(*fromYaml, written));
+        assert(yamlResult.errors.size() == 2 && yamlResult.errors[0].first == "weights" &&
+               yamlResult.errors[1].first == "region");
+        std::cout << "  JSON, binary, protobuf and YAML: " << fromJson->plugins.size() << " plugins\n\n";
+    }
+
+    // Test 2: Collect notes each skipped key once per type, with a count
+    std::cout << "Test 2: Collect\n";
+    {
+        meta::UnknownFieldLog log;
+        auto [config, result] = meta::fromJson<v1::Config>(json);
+        assert(result.valid && result.errors.empty() && sameAsWritten(*config, written));
+        // Config has no policy, so its own new keys aren't noted
+        assert(log.entries().size() == 1 && log.count("v1::Plugin", "settings") == 50);
+        for (const auto& entry : log.entries())
+            std::cout << "  json:   " << entry.type << " '" << entry.key << "' x" << entry.count << "\n";
+
+        // The binary formats note the tag. In protobuf every map entry is
+        // a field of its own, so two settings are skipped twice.
+        log.clear();
+        assert(meta::fromBinary<v1::Config>(binary).second.valid);
+        assert(log.entries().size() == 1 && log.count("v1::Plugin", "3") == 50);
+        log.clear();
+        assert(meta::fromProto<v1::Config>(proto).second.valid);
+        assert(log.entries().size() == 1 && log.count("v1::Plugin", "3") == 100);
+        std::cout << "  binary: v1::Plugin tag 3 x50, protobuf: x100\n";
+
+        // A nested log takes over while it is alive
+        log.clear();
+        {
+            meta::UnknownFieldLog inner;
+            assert(meta::fromJson<v1::Config>(json).second.valid);
+            assert(inner.count("v1::Plugin", "settings") == 50);
+        }
+        assert(log.empty());
+        std::cout << "\n";
+    }
+
+    // Test 3: Error rejects the struct that doesn't understand its input
+    std::cout << "Test 3: Error\n";
+    {
+        GatewayV2 newer{"edge", {{"0.0.0.0", 80, false}, {"0.0.0.0", 443, true}}};
+
+        auto [fromJson, jsonResult] = meta::fromJson<Gateway>(meta::toJson(newer));
+        assert(!fromJson && jsonResult.errors.size() == 2);
+        assert(jsonResult.errors[0].first == "listeners.[0].tls" && jsonResult.errors[1].first == "listeners.[1].tls");
+        std::cout << "  json:   " << jsonResult.errors[0].first << ": " << jsonResult.errors[0].second << "\n";
+
+        auto [fromBinary, binaryResult] = meta::fromBinary<Gateway>(meta::toBinary(newer));
+        assert(!fromBinary && binaryResult.errors.size() == 2);
+        std::cout << "  binary: " << binaryResult.errors[1].first << ": " << binaryResult.errors[1].second << "\n";
+
+        // Only the strict type cares; the same document without the new
+        // field is fine
+        Gateway older{"edge", {{"0.0.0.0", 80}}};
+        assert(meta::fromJson<Gateway>(meta::toJson(older)).second.valid);
+        assert(meta::fromBinary<Gateway>(meta::toBinary(older)).second.valid);
+        std::cout << "\n";
+    }
+
+    // Test 4: A skipped subtree is never converted, only stepped over
+    std::cout << "Test 4: Skipped values aren't read\n";
+    {
+        // Numbers out of range for every type and a broken escape: errors if
+        // they were read into fields, never looked at when skipped
+        std::string odd = R"({"service":"billing","weights":[1e999999,[[[-1e999999]]]],)"
+                          R"("region":"\ud800 alone","port":8443,"plugins":[]})";
+        auto [config, result] = meta::fromJson<v1::Config>(odd);
+        assert(result.valid && config->port == 8443 && config->plugins.empty());
+
+        // Keys in document order are found in one pass around the unknown ones
+        std::string wide = R"({"service":"billing")";
+        for (int i = 0; i < 200; ++i)
+            wide += ",\"extra" + std::to_string(i) + "\":{\"deep\":[1,2,{\"x\":[3]}]}";
+        wide += R"(,"port":1,"plugins":[{"name":"a","enabled":true}]})";
+        auto [wideConfig, wideResult] = meta::fromJson<v1::Config>(wide);
+        assert(wideResult.valid && wideConfig->port == 1 && wideConfig->plugins.size() == 1);
+        std::cout << "  200 unknown subtrees between known fields, result valid\n";
+    }
+
+    std::cout << "\nAll unknown field tests passed\n";
+    return 0;
+}
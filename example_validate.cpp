@@ -0,0 +1,198 @@
+// example_validate.cpp - meta::validate and meta::isValid on objects built in code, one at a time or in batches
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "meta.h"
+#include "meta_json.h"
+#include "meta_soa.h"
+
+enum class Side { Buy, Sell };
+
+constexpr std::array SideMapping = std::array{
+    std::pair{Side::Buy, "buy"},
+    std::pair{Side::Sell, "sell"},
+};
+
+template <> struct meta::EnumMapping<Side>
+{
+    static constexpr auto& mapping = SideMapping;
+    using Type = meta::EnumTraitsAuto<Side, SideMapping>;
+};
+
+// Longer than a handful, so it is searched through its sorted copy
+constexpr std::array<std::string_view, 12> Symbols{"MSFT", "AAPL", "NVDA", "AMZN", "GOOG", "META",
+                                                   "TSLA", "AVGO", "ORCL", "ADBE", "CRM",  "INTC"};
+
+// Counts how often its message is formatted
+struct LotSize
+{
+    static inline int formatted = 0;
+
+    static constexpr bool check(int32_t qty) { return qty % 100 == 0; }
+
+    static std::string message(int32_t qty)
+    {
+        ++formatted;
+        return std::to_string(qty) + " is not a whole lot";
+    }
+};
+
+// Written against the older interface: validate() only
+struct NotBlank
+{
+    static bool validate(const std::string& value, std::string& error)
+    {
+        if (value.find_first_not_of(' ') != std::string::npos)
+            return true;
+        error = "Blank";
+        return false;
+    }
+};
+
+struct Order
+{
+    int32_t id;
+    std::string symbol;
+    int32_t qty;
+    double price;
+    Side side;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Order::id>("id", meta::BoundsCheck<1, 1000000>{}),
+        meta::field<&Order::symbol>("symbol", meta::Whitelist<Symbols>{}),
+        meta::field<&Order::qty>("qty", meta::BoundsCheck<1, 10000>{}, LotSize{}),
+        meta::field<&Order::price>("price", meta::BoundsCheck<0, 100000>{}),
+        meta::field<&Order::side>("side"));
+};
+
+struct Book
+{
+    std::string desk;
+    std::vector<Order> orders;
+    std::map<std::string, Order> pending;
+    std::optional<Order> last;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Book::desk>("desk", meta::StringLength<1, 16>{}, NotBlank{}),
+        meta::field<&Book::orders>("orders"),
+        meta::field<&Book::pending>("pending"),
+        meta::field<&Book::last>("last"));
+};
+
+std::vector<Order> makeOrders(size_t n)
+{
+    std::vector<Order> orders;
+    for (size_t i = 0; i < n; ++i)
+        orders.push_back({static_cast<int32_t>(i + 1), std::string(Symbols[i % Symbols.size()]),
+                          static_cast<int32_t>(100 * (1 + i % 50)), 10.0 + static_cast<double>(i % 90), Side::Buy});
+    return orders;
+}
+
+std::string describe(const meta::ValidationResult& result)
+{
+    std::string text;
+    for (const auto& [field, error] : result.errors)
+        text += "  " + field + ": " + error + "\n";
+    return text;
+}
+
+int main()
+{
+    std::cout << "Validation\n";
+    std::cout << "==========\n\n";
+
+    // Test 1: The errors from() would report, for an object built in code
+    std::cout << "Test 1: validate() on a struct\n";
+    {
+        Book book{"rates", makeOrders(3), {}, std::nullopt};
+        assert(meta::validate(book).valid && meta::isValid(book));
+
+        book.orders[1].qty = 250;
+        book.orders[2].symbol = "IBM";
+        book.pending["late"] = {7, "AAPL", 0, -1.0, Side::Sell};
+        book.last = Order{0, "MSFT", 100, 1.0, Side::Buy};
+        auto result = meta::validate(book);
+        assert(!result.valid && !meta::isValid(book));
+
+        // Reading the same document back reports the same paths and messages
+        auto [read, readResult] = meta::fromJson<Book>(meta::toJson(book));
+        assert(readResult.errors == result.errors);
+        std::cout << describe(result) << "\n";
+    }
+
+    // Test 2: Messages are only built when there is something to report
+    std::cout << "Test 2: No formatting on the way to a yes/no\n";
+    {
+        auto orders = makeOrders(1000);
+        orders[10].qty = 150;
+        orders[900].qty = 50;
+        LotSize::formatted = 0;
+        assert(!meta::isValid(orders));
+        assert(LotSize::formatted == 0);
+        auto result = meta::validate(orders);
+        assert(LotSize::formatted == 2 && result.errors.size() == 2);
+        std::cout << "  isValid formatted " << 0 << " messages, validate " << LotSize::formatted << "\n\n";
+    }
+
+    // Test 3: Whitelists are sorted once; their message keeps the declared order
+    std::cout << "Test 3: Whitelist\n";
+    {
+        using Allowed = meta::Whitelist<Symbols>;
+        static_assert(Allowed::sorted.front() == "AAPL" && Allowed::sorted.back() == "TSLA");
+        for (auto symbol : Symbols)
+            assert(Allowed::check(std::string(symbol)));
+        assert(!Allowed::check(std::string("IBM")) && !Allowed::check(std::string("")));
+        assert(!Allowed::check(std::string("ZZZZ")) && !Allowed::check(std::string("A")));
+        std::string error;
+        assert(!Allowed::validate(std::string("IBM"), error));
+        assert(error == "Value not in whitelist: {MSFT, AAPL, NVDA, AMZN, GOOG, META, TSLA, AVGO, ORCL, ADBE, CRM, INTC}");
+        std::cout << "  " << error << "\n\n";
+    }
+
+    // Test 4: A batch gives the same result as checking each record in turn
+    std::cout << "Test 4: Batches\n";
+    {
+        auto orders = makeOrders(20000);
+        orders[3].price = -5;
+        orders[4711].id = 0;
+        orders[4711].side = static_cast<Side>(7);
+        orders[19999].symbol = "IBM";
+
+        meta::ValidationResult oneByOne;
+        for (size_t i = 0; i < orders.size(); ++i)
+            meta::appendElementErrors(oneByOne, i, meta::validate(orders[i]));
+
+        auto batch = meta::validate(std::span<const Order>(orders));
+        assert(batch.errors == oneByOne.errors && batch.errors.size() == 4);
+        assert(meta::validate(orders).errors == batch.errors);
+        assert(!meta::isValid(std::span<const Order>(orders)));
+        std::cout << describe(batch);
+
+        // Columns of a soa_vector are checked one array at a time
+        meta::soa_vector<Order> columns(orders);
+        assert(meta::validate(columns).errors == batch.errors && !meta::isValid(columns));
+        columns[3].get<&Order::price>() = 5;
+        columns[4711].get<&Order::id>() = 1;
+        columns[4711].get<&Order::side>() = Side::Sell;
+        columns[19999].get<&Order::symbol>() = "INTC";
+        assert(meta::isValid(columns) && meta::validate(columns).valid);
+        std::cout << "  " << orders.size() << " records as a vector, a span and a soa_vector\n\n";
+    }
+
+    // Test 5: Attributes with only validate() still run
+    std::cout << "Test 5: Older attributes\n";
+    {
+        Book blank{"   ", {}, {}, std::nullopt};
+        auto result = meta::validate(blank);
+        assert(result.errors.size() == 1 && result.errors[0] == std::make_pair(std::string("desk"), std::string("Blank")));
+        assert(meta::fromJson<Book>(meta::toJson(blank)).second.errors == result.errors);
+        std::cout << describe(result);
+    }
+
+    std::cout << "\nAll validation tests passed\n";
+    return 0;
+}
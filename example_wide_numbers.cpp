@@ -0,0 +1,120 @@
+// example_wide_numbers.cpp - 64-bit integers and round-trip doubles through every format
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+
+#include "meta.h"
+#include "meta_csv.h"
+#include "meta_json.h"
+
+struct Sample
+{
+    int64_t id;
+    uint64_t mask;
+    uint32_t count;
+    int16_t delta;
+    double value;
+    float ratio;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Sample::id>("id"),
+        meta::field<&Sample::mask>("mask"),
+        meta::field<&Sample::count>("count"),
+        meta::field<&Sample::delta>("delta"),
+        meta::field<&Sample::value>("value"),
+        meta::field<&Sample::ratio>("ratio"));
+};
+
+// Implements writeInt only, as builders written before the 64-bit events do
+struct IntOnlyBuilder : meta::Builder
+{
+    std::string out;
+    void writeInt(int v) override { out += "i" + std::to_string(v) + " "; }
+    void writeDouble(double v) override { out += "d" + std::to_string(v) + " "; }
+    void writeBool(bool) override {}
+    void writeString(const std::string&) override {}
+    void writeNull() override {}
+    void startSeq(const std::string& = "") override {}
+    void endSeq() override {}
+    void startMap(const std::string& = "") override {}
+    void endMap() override {}
+    void key(const std::string&) override {}
+    std::string result() override { return out; }
+};
+
+bool same(const Sample& a, const Sample& b)
+{
+    return a.id == b.id && a.mask == b.mask && a.count == b.count && a.delta == b.delta &&
+           a.value == b.value && a.ratio == b.ratio;
+}
+
+int main()
+{
+    std::cout << "Wide integers and doubles\n";
+    std::cout << "=========================\n\n";
+
+    const std::vector<Sample> samples = {
+        {INT64_MIN, UINT64_MAX, UINT32_MAX, -32768, 0.1, 0.1f},
+        {INT64_MAX, 1ull << 63, 3000000000u, 32767, 1.0 / 3.0, 1.0f / 3.0f},
+        {-5000000000, 0, 0, 0, DBL_MAX, FLT_MIN},
+        {42, 42, 42, 42, 5e-324, 16777216.0f},
+    };
+
+    // Test 1: JSON
+    std::cout << "Test 1: JSON\n";
+    std::string json = meta::toJson(samples[0]);
+    std::cout << "  " << json << "\n";
+    assert(json == R"({"id":-9223372036854775808,"mask":18446744073709551615,"count":4294967295,)"
+                   R"("delta":-32768,"value":0.1,"ratio":0.1})");
+    auto [fromJson, jsonOk] = meta::fromJson<std::vector<Sample>>(meta::toJson(samples));
+    assert(jsonOk.valid && fromJson->size() == samples.size());
+    for (size_t i = 0; i < samples.size(); ++i)
+        assert(same((*fromJson)[i], samples[i]));
+    std::cout << "  " << meta::toJson(samples[1].value) << " " << meta::toJson(samples[2].value) << "\n\n";
+
+    // Test 2: YAML, CSV and XML
+    std::cout << "Test 2: YAML, CSV, XML\n";
+    std::string yaml = meta::toYaml(samples[1]);
+    std::cout << yaml << "\n";
+    assert(yaml.find("mask: 9223372036854775808") != std::string::npos);
+    assert(yaml.find("value: 0.3333333333333333\n") != std::string::npos);
+    auto [fromYaml, yamlOk] = meta::reifyFromYaml<std::vector<Sample>>(meta::toYaml(samples));
+    assert(yamlOk.valid);
+    for (size_t i = 0; i < samples.size(); ++i)
+        assert(same((*fromYaml)[i], samples[i]));
+
+    auto [fromCsv, csvOk] = meta::parseCSV<Sample>(meta::toCSVWithHeader(samples));
+    assert(csvOk.valid && fromCsv.size() == samples.size());
+    for (size_t i = 0; i < samples.size(); ++i)
+        assert(same(fromCsv[i], samples[i]));
+    std::cout << "  " << meta::toCSV(samples[0]) << "\n";
+
+    std::string xml = meta::toXml(samples[2]);
+    assert(xml.find("<id>-5000000000") != std::string::npos);
+    assert(xml.find("<value>1.7976931348623157e+308") != std::string::npos);
+    std::cout << "\n";
+
+    // Test 3: Out-of-range values are rejected, not wrapped
+    std::cout << "Test 3: Range checks\n";
+    auto [narrow, narrowResult] = meta::fromJson<Sample>(
+        R"({"id":1,"mask":-1,"count":4294967296,"delta":40000,"value":1,"ratio":1})");
+    assert(!narrow && !narrowResult.valid && narrowResult.errors.size() == 3);
+    for (const auto& [path, message] : narrowResult.errors)
+        std::cout << "  " << path << ": " << message << "\n";
+    assert(narrowResult.errors[0].first == "mask" && narrowResult.errors[2].second == "Integer out of range");
+    auto [tooBig, tooBigResult] = meta::fromJson<int64_t>("9223372036854775808");
+    assert(!tooBig && !tooBigResult.valid);
+    std::cout << "\n";
+
+    // Test 4: Builders that only implement writeInt
+    std::cout << "Test 4: Fallback for older builders\n";
+    IntOnlyBuilder old;
+    meta::to(int64_t{7}, old);
+    meta::to(uint64_t{1} << 40, old);
+    std::cout << "  " << old.out << "\n";
+    assert(old.out == "i7 d1099511627776.000000 ");
+
+    std::cout << "\nAll wide number tests passed\n";
+    return 0;
+}
@@ -0,0 +1,123 @@
+// example_yaml_events.cpp - reifyFromYaml reads yaml-cpp's parse events without building a YAML::Node tree
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "meta.h"
+
+struct Limits
+{
+    int cpu;
+    int memory;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Limits::cpu>("cpu"),
+        meta::field<&Limits::memory>("memory"));
+};
+
+struct Service
+{
+    std::string name;
+    int replicas;
+    Limits limits;
+    std::vector<std::string> hosts;
+    std::map<std::string, std::string> labels;
+    std::optional<std::string> owner;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Service::name>("name"),
+        meta::field<&Service::replicas>("replicas"),
+        meta::field<&Service::limits>("limits"),
+        meta::field<&Service::hosts>("hosts"),
+        meta::field<&Service::labels>("labels"),
+        meta::field<&Service::owner>("owner"));
+};
+
+struct Fleet
+{
+    std::string region;
+    std::vector<Service> services;
+    std::optional<std::string> note;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Fleet::region>("region"),
+        meta::field<&Fleet::services>("services"),
+        meta::field<&Fleet::note>("note"));
+};
+
+const char* fleetYaml = R"(
+region: eu-west
+defaults: &limits
+  cpu: 2
+  memory: 4096
+services:
+  - name: api
+    replicas: 3
+    limits: *limits
+    hosts: [api-1, api-2, "api 3"]
+    labels: {tier: web, team: core}
+    owner: ~
+  - name: worker
+    replicas: 0x10
+    limits: {cpu: 8, memory: 16384}
+    hosts:
+      - w-1
+    labels: {}
+    owner: "ops"
+note: |
+  two services
+  one region
+)";
+
+int main()
+{
+    std::cout << "YAML event reader\n";
+    std::cout << "=================\n\n";
+
+    // Test 1: Same result as the YAML::Node path
+    std::cout << "Test 1: Parity with YAML::Load\n";
+    auto [fleet, ok] = meta::reifyFromYaml<Fleet>(fleetYaml);
+    auto [viaNode, nodeOk] = meta::reifyFromYaml<Fleet>(YAML::Load(fleetYaml));
+    assert(ok.valid && nodeOk.valid);
+    assert(meta::toYaml(*fleet) == meta::toYaml(*viaNode));
+    assert(ok.errors == nodeOk.errors && ok.errors.size() == 1 && ok.errors[0].first == "defaults");
+    const Service& api = fleet->services[0];
+    assert(api.limits.cpu == 2 && api.limits.memory == 4096 && api.hosts[2] == "api 3");
+    assert(!api.owner && api.labels.at("team") == "core");
+    assert(fleet->services[1].replicas == 16 && fleet->note == "two services\none region\n");
+    std::cout << "  " << fleet->services.size() << " services in " << fleet->region << ", "
+              << ok.errors[0].first << ": " << ok.errors[0].second << "\n\n";
+
+    // Test 2: The tape
+    std::cout << "Test 2: Events\n";
+    meta::YamlDocument doc("a: [1, {b: 2}]\nc: &x hello\nd: *x\n");
+    assert(doc[0].type == meta::YamlEventType::Map && doc[0].length == 3 && doc[0].next == doc.eventCount());
+    assert(doc[2].type == meta::YamlEventType::Sequence && doc[2].length == 2);
+    assert(doc.scalar(doc[doc.eventCount() - 1]) == "hello");
+    meta::YamlDocumentNode root(doc, 0);
+    assert(root.keys() == (std::vector<std::string>{"a", "c", "d"}));
+    meta::NodeCursor a, b;
+    assert(root.at("a", a)->at(1, b)->size() == 1);
+    std::cout << "  " << doc.eventCount() << " events\n\n";
+
+    // Test 3: Unknown and missing fields in one pass
+    std::cout << "Test 3: Errors\n";
+    auto [bad, badResult] = meta::reifyFromYaml<Fleet>("extra: 1\nservices:\n  - name: x\n    replicas: many\n");
+    assert(!bad && !badResult.valid);
+    for (const auto& [path, message] : badResult.errors)
+        std::cout << "  " << path << ": " << message << "\n";
+    assert(badResult.errors.size() == 6);
+    assert(badResult.errors[0].first == "extra" && badResult.errors[1].first == "services.[0].replicas");
+    assert(badResult.errors.back().first == "region");
+
+    auto [empty, emptyResult] = meta::reifyFromYaml<Fleet>("");
+    assert(!empty && emptyResult.errors[0].second == "Expected map for struct");
+    auto [broken, brokenResult] = meta::reifyFromYaml<Fleet>("region: [unclosed\n");
+    assert(!broken && brokenResult.errors[0].first == "yaml");
+    std::cout << "  yaml: " << brokenResult.errors[0].second << "\n";
+
+    std::cout << "\nAll YAML event reader tests passed\n";
+    return 0;
+}
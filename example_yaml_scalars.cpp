@@ -0,0 +1,88 @@
+// example_yaml_scalars.cpp - YamlNode scalar conversion matches yaml-cpp without throwing
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <variant>
+
+#include "meta.h"
+
+template <typename T>
+std::optional<T> reference(const YAML::Node& node)
+{
+    try { return node.as<T>(); }
+    catch (...) { return {}; }
+}
+
+template <typename T>
+bool same(const std::optional<T>& a, const std::optional<T>& b)
+{
+    if (a.has_value() != b.has_value())
+        return false;
+    if constexpr (std::is_floating_point_v<T>)
+        return !a || (std::isnan(*a) && std::isnan(*b)) || *a == *b;
+    else
+        return !a || *a == *b;
+}
+
+struct Setting
+{
+    std::string name;
+    std::variant<int, double, bool, std::string> value;
+
+    static constexpr auto FieldsMeta = std::make_tuple(
+        meta::field<&Setting::name>("name"),
+        meta::field<&Setting::value>("value"));
+};
+
+int main()
+{
+    std::cout << "YAML scalar conversion\n";
+    std::cout << "======================\n\n";
+
+    const char* scalars[] = {
+        "0", "42", "-17", "+8", "007", "08", "0x1F", "-0x10", "0X7fffffff", "2147483647",
+        "2147483648", "-2147483648", "-2147483649", "12abc", "1 2", "12 ", " 12", "", "-", "+",
+        "0x", "3.14", "-2.5e3", ".5", "5.", "1e", "+-1", "inf", "nan", ".inf", "-.Inf", ".NaN",
+        "true", "True", "TRUE", "tRUE", "yes", "Yes", "NO", "on", "Off", "y", "N", "maybe",
+        "hello", "null"};
+    const char* documents[] = {"v: ~", "v:", "v: [1, 2]", "v: {a: 1}", "v: '42'", "v: \"yes\""};
+
+    std::vector<YAML::Node> nodes;
+    for (const char* text : scalars)
+        nodes.push_back(YAML::Node(std::string(text)));
+    for (const char* text : documents)
+        nodes.push_back(YAML::Load(text)["v"]);
+
+    size_t checked = 0;
+    for (const auto& node : nodes)
+    {
+        meta::YamlNode ynode(node);
+
+        bool ok = same(ynode.asInt(), reference<int>(node)) &&
+                  same(ynode.asDouble(), reference<double>(node)) &&
+                  same(ynode.asBool(), reference<bool>(node)) &&
+                  same(ynode.asString(), reference<std::string>(node));
+        if (!ok)
+            std::cout << "  mismatch for '" << YAML::Dump(node) << "'\n";
+        assert(ok);
+        ++checked;
+    }
+    std::cout << "  " << checked << " scalars convert exactly like node.as<T>()\n\n";
+
+    // Variants try each alternative in turn; mismatches are now plain branches
+    auto [settings, result] = meta::reifyFromYaml<std::vector<Setting>>(std::string(R"(
+- {name: retries, value: 3}
+- {name: ratio, value: 0.75}
+- {name: verbose, value: true}
+- {name: label, value: primary}
+)"));
+    assert(settings && result.valid);
+    assert(std::get<int>((*settings)[0].value) == 3);
+    assert(std::get<double>((*settings)[1].value) == 0.75);
+    assert(std::get<bool>((*settings)[2].value));
+    assert(std::get<std::string>((*settings)[3].value) == "primary");
+    std::cout << meta::toYaml(*settings) << "\n";
+
+    std::cout << "\nAll scalar tests passed\n";
+    return 0;
+}
@@ -6,7 +6,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <iterator>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -64,6 +67,67 @@ struct CleanName
     std::string_view name;
 };
 
+// Left out of meta::hash, meta::equal and meta::less (caches, timestamps)
+struct NotCompared
+{
+};
+
+// Wire tag for the binary format (meta_binary.h). Fields without one are
+// tagged with their 1-based declaration position; give every field an
+// explicit tag before reordering or removing fields.
+template <uint32_t N>
+struct BinaryTag
+{
+    static_assert(N > 0 && N < (1u << 29), "binary tags must be in [1, 2^29)");
+    static constexpr uint32_t value = N;
+};
+
+template <typename Attr>
+struct binary_tag_of
+{
+    static constexpr uint32_t get(uint32_t fallback) { return fallback; }
+};
+
+template <uint32_t N>
+struct binary_tag_of<BinaryTag<N>>
+{
+    static constexpr uint32_t get(uint32_t) { return N; }
+};
+
+// Protobuf field number and integer encoding (meta_proto.h). Integers are
+// written as int32/int64/uint32/uint64 by default; ZigZag selects
+// sint32/sint64 and Fixed selects (s)fixed32/(s)fixed64. Fields without
+// one are numbered by their 1-based declaration position.
+enum class ProtoEncoding
+{
+    Default,
+    ZigZag,
+    Fixed
+};
+
+template <uint32_t N, ProtoEncoding E = ProtoEncoding::Default>
+struct ProtoField
+{
+    static_assert(N > 0 && N < (1u << 29), "protobuf field numbers must be in [1, 2^29)");
+    static_assert(N < 19000 || N > 19999, "protobuf reserves field numbers 19000-19999");
+    static constexpr uint32_t number = N;
+    static constexpr ProtoEncoding encoding = E;
+};
+
+template <typename Attr>
+struct proto_field_of
+{
+    static constexpr uint32_t number(uint32_t fallback) { return fallback; }
+    static constexpr ProtoEncoding encoding(ProtoEncoding fallback) { return fallback; }
+};
+
+template <uint32_t N, ProtoEncoding E>
+struct proto_field_of<ProtoField<N, E>>
+{
+    static constexpr uint32_t number(uint32_t) { return N; }
+    static constexpr ProtoEncoding encoding(ProtoEncoding) { return E; }
+};
+
 // Properties flags
 enum Prop : uint8_t
 {
@@ -129,21 +193,39 @@ struct Props
 template <typename T>
 concept Numeric = std::is_arithmetic_v<T>;
 
+// Each attribute below splits its test from its message: check() says
+// whether a value passes and costs no allocation, message() formats the
+// error for a value that didn't. validate() is the two together, for
+// attributes written against the older interface.
+
 template <auto Min, auto Max>
 struct BoundsCheck
 {
     static constexpr auto min = Min;
     static constexpr auto max = Max;
     
+    // Both comparisons are always made, so a loop of checks has no
+    // branches and vectorizes
     template <Numeric T>  // Now requires numeric type!
+    static constexpr bool check(const T& value)
+    {
+        return !((value < Min) | (value > Max));
+    }
+
+    template <Numeric T>
+    static std::string message(const T& value)
+    {
+        return "Value " + std::to_string(value) + " out of bounds [" +
+               std::to_string(Min) + ", " + std::to_string(Max) + "]";
+    }
+
+    template <Numeric T>
     static bool validate(const T& value, std::string& error)
     {
-        if (value < Min || value > Max) {
-            error = "Value " + std::to_string(value) + " out of bounds [" +
-                    std::to_string(Min) + ", " + std::to_string(Max) + "]";
-            return false;
-        }
-        return true;
+        if (check(value))
+            return true;
+        error = message(value);
+        return false;
     }
 };
 
@@ -154,44 +236,96 @@ struct StringLength
     static constexpr size_t max = Max;
     
     // Explicitly requires std::string
+    static constexpr bool check(const std::string& value)
+    {
+        return !((value.length() < Min) | (value.length() > Max));
+    }
+
+    static std::string message(const std::string& value)
+    {
+        return "String length " + std::to_string(value.length()) +
+               " out of bounds [" + std::to_string(Min) + ", " + std::to_string(Max) + "]";
+    }
+
     static bool validate(const std::string& value, std::string& error)
     {
-        if (value.length() < Min || value.length() > Max) {
-            error = "String length " + std::to_string(value.length()) +
-                    " out of bounds [" + std::to_string(Min) + ", " + std::to_string(Max) + "]";
-            return false;
-        }
-        return true;
+        if (check(value))
+            return true;
+        error = message(value);
+        return false;
     }
 };
 
 template <const auto& AllowedValues>
 struct Whitelist
 {
+    using Element = std::remove_cvref_t<decltype(*std::begin(AllowedValues))>;
+    static constexpr size_t count = std::size(AllowedValues);
+
+    // Integer and string lists are sorted at compile time; past a handful
+    // of entries a binary search beats comparing against each in turn
+    using Key = std::conditional_t<std::is_integral_v<Element>, Element, std::string_view>;
+    static constexpr bool sortable = std::is_integral_v<Element> || std::is_convertible_v<Element, std::string_view>;
+
+    static constexpr auto sorted = []
+    {
+        std::array<Key, sortable ? count : 0> keys{};
+        if constexpr (sortable)
+        {
+            std::copy(std::begin(AllowedValues), std::end(AllowedValues), keys.begin());
+            std::sort(keys.begin(), keys.end());
+        }
+        return keys;
+    }();
+
     template <typename T>
-    static bool validate(const T& value, std::string& error)
+    static bool check(const T& value)
     {
-        for (const auto& allowed : AllowedValues) {
-            if (value == allowed) return true;
+        if constexpr (sortable && count > 8 && requires { value < sorted[0]; sorted[0] < value; })
+        {
+            auto it = std::lower_bound(sorted.begin(), sorted.end(), value);
+            return it != sorted.end() && !(value < *it);
         }
-        
-        // Simple: just use operator<< for everything
-        std::ostringstream oss;
-        oss << "Value not in whitelist: {";
-        bool first = true;
-        for (const auto& allowed : AllowedValues) {
-
-        if (!first) oss << ", ";
-            first = false;
-            oss << allowed;
+        else
+        {
+            for (const auto& allowed : AllowedValues) {
+                if (value == allowed) return true;
+            }
+            return false;
         }
-        oss << "}";
-        error = oss.str();
+    }
+
+    // The list is formatted once, the first time a value is rejected
+    template <typename T>
+    static std::string message(const T&)
+    {
+        // Simple: just use operator<< for everything
+        static const std::string text = []
+        {
+            std::ostringstream oss;
+            oss << "Value not in whitelist: {";
+            bool first = true;
+            for (const auto& allowed : AllowedValues) {
+                if (!first) oss << ", ";
+                first = false;
+                oss << allowed;
+            }
+            oss << "}";
+            return oss.str();
+        }();
+        return text;
+    }
+
+    template <typename T>
+    static bool validate(const T& value, std::string& error)
+    {
+        if (check(value))
+            return true;
+        error = message(value);
         return false;
     }
 };
 
-
 // ============================================================================
 // TYPE NAME EXTRACTION
 // ============================================================================
@@ -205,7 +339,9 @@ constexpr std::string_view type_name()
     constexpr std::string_view suffix = "]";
     
     constexpr auto start = func.find(prefix) + prefix.size();
-    constexpr auto end = func.rfind(suffix);
+    // GCC goes on to list the other typedefs it used: "[with T = X; std::string_view = ...]"
+    constexpr auto semicolon = func.find(';', start);
+    constexpr auto end = semicolon < func.rfind(suffix) ? semicolon : func.rfind(suffix);
     
     return func.substr(start, end - start);
     
@@ -324,7 +460,7 @@ struct Field
     }
     
     // Convenience getters for column names
-    std::string_view getSqlColumn() const
+    constexpr std::string_view getSqlColumn() const
     {
         if constexpr (has<SqlColumn>) {
             return std::get<SqlColumn>(attributes).name;
@@ -333,7 +469,7 @@ struct Field
         }
     }
     
-    std::string_view getCsvColumn() const
+    constexpr std::string_view getCsvColumn() const
     {
         if constexpr (has<CsvColumn>) {
             return std::get<CsvColumn>(attributes).name;
@@ -342,7 +478,7 @@ struct Field
         }
     }
     
-    std::string_view getJsonProperty() const
+    constexpr std::string_view getJsonProperty() const
     {
         if constexpr (has<JsonColumn>) {
             return std::get<JsonColumn>(attributes).name;
@@ -350,6 +486,29 @@ struct Field
             return fieldName;
         }
     }
+
+    // BinaryTag<N> if present, else the field's 1-based position
+    static constexpr uint32_t getBinaryTag(uint32_t position)
+    {
+        uint32_t tag = position;
+        ((tag = binary_tag_of<Attrs>::get(tag)), ...);
+        return tag;
+    }
+
+    // ProtoField<N> if present, else the field's 1-based position
+    static constexpr uint32_t getProtoField(uint32_t position)
+    {
+        uint32_t number = position;
+        ((number = proto_field_of<Attrs>::number(number)), ...);
+        return number;
+    }
+
+    static constexpr ProtoEncoding getProtoEncoding()
+    {
+        ProtoEncoding encoding = ProtoEncoding::Default;
+        ((encoding = proto_field_of<Attrs>::encoding(encoding)), ...);
+        return encoding;
+    }
 };
 
 // ============================================================================
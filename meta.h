@@ -13,26 +13,57 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
 #include <deque>
 #include <filesystem>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <optional>
+#include <ranges>
 #include <set>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 #include <cstdint>
+#include <yaml-cpp/eventhandler.h>
 #include <yaml-cpp/yaml.h>
 
 #include "field.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
 
 namespace meta
 {
@@ -44,6 +75,16 @@ namespace meta
 template <typename T>
 concept IntegerType = std::is_integral_v<T> && !std::is_same_v<T, bool>;
 
+// The signed/unsigned standard integer type with T's width. std::in_range
+// rejects the character types, so range checks go through this.
+template <IntegerType T>
+using StandardInteger = std::conditional_t<std::is_signed_v<T>, std::make_signed_t<T>, std::make_unsigned_t<T>>;
+
+// True when every T converts to int without loss
+template <IntegerType T>
+constexpr bool fitsInInt = std::in_range<int>(std::numeric_limits<StandardInteger<T>>::min()) &&
+                           std::in_range<int>(std::numeric_limits<StandardInteger<T>>::max());
+
 template <typename T>
 concept FloatingPointType = std::is_floating_point_v<T>;
 
@@ -72,7 +113,10 @@ concept HasFields = HasDirectFields<T> || HasMetaTupleFields<T>;
 
 // Concept for catching structs without metadata
 template <typename T>
-concept StructWithoutMetadata = !HasFields<T> && std::is_class_v<T> && !std::is_same_v<T, std::string>;
+concept StringType = std::is_same_v<T, std::basic_string<char, std::char_traits<char>, typename T::allocator_type>>;
+
+template <typename T>
+concept StructWithoutMetadata = !HasFields<T> && std::is_class_v<T> && !StringType<T>;
 
 template <typename T>
 constexpr decltype(auto) get_fields()
@@ -91,59 +135,265 @@ constexpr decltype(auto) get_fields()
 // ENUM SUPPORT
 //============================================================
 
+//============================================================
+// NAME TABLES - compile-time perfect hash over a set of names
+//============================================================
+// NameTable<N>::build(names) lays N distinct names out so find(key) gives
+// the key's position (or -1) with one pass over its bytes and a single
+// string compare. The table is built by hash-and-displace at compile time:
+// keys are grouped into buckets, and each bucket gets a seed that places
+// all of its keys in free slots.
+
+constexpr uint32_t fieldNameHash(std::string_view s)
+{
+    uint32_t h = 2166136261u;
+    for (char c : s)
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+constexpr uint32_t fieldHashMix(uint32_t h, uint32_t seed)
+{
+    h ^= seed * 0x9E3779B9u;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+template <size_t N>
+struct NameTable
+{
+    static constexpr size_t buckets = N / 2 + 1;
+    static constexpr size_t slots = std::bit_ceil(N * 2 + 1);
+
+    std::array<std::string_view, N> names{};
+    std::array<uint32_t, buckets> seeds{};
+    std::array<uint16_t, slots> entries{}; // name index + 1, 0 = empty
+    bool ok = true;                        // false when a name repeats
+
+    static constexpr NameTable build(const std::array<std::string_view, N>& names)
+    {
+        NameTable t;
+        t.names = names;
+
+        std::array<uint32_t, N> hashes{};
+        std::array<size_t, buckets> bucketSize{};
+        for (size_t i = 0; i < N; ++i)
+        {
+            for (size_t j = 0; j < i; ++j)
+                if (t.names[i] == t.names[j])
+                    t.ok = false;
+            hashes[i] = fieldNameHash(t.names[i]);
+            ++bucketSize[hashes[i] % buckets];
+        }
+        if (!t.ok)
+            return t;
+
+        // Place the largest buckets first while the table is still empty
+        for (size_t size = N; size > 0; --size)
+        {
+            for (size_t b = 0; b < buckets; ++b)
+            {
+                if (bucketSize[b] != size)
+                    continue;
+
+                bool placed = false;
+                for (uint32_t seed = 1; seed < (1u << 20) && !placed; ++seed)
+                {
+                    std::array<size_t, N> taken{};
+                    size_t n = 0;
+                    placed = true;
+                    for (size_t i = 0; i < N && placed; ++i)
+                    {
+                        if (hashes[i] % buckets != b)
+                            continue;
+                        size_t slot = fieldHashMix(hashes[i], seed) & (slots - 1);
+                        if (t.entries[slot] != 0)
+                            placed = false;
+                        for (size_t k = 0; k < n && placed; ++k)
+                            if (taken[k] == slot)
+                                placed = false;
+                        taken[n++] = slot;
+                    }
+                    if (!placed)
+                        continue;
+
+                    t.seeds[b] = seed;
+                    for (size_t i = 0; i < N; ++i)
+                        if (hashes[i] % buckets == b)
+                            t.entries[fieldHashMix(hashes[i], seed) & (slots - 1)] =
+                                static_cast<uint16_t>(i + 1);
+                }
+                if (!placed)
+                    t.ok = false;
+            }
+        }
+        return t;
+    }
+
+    constexpr int find(std::string_view key) const
+    {
+        if constexpr (N == 0)
+            return -1;
+        else
+        {
+            uint32_t h = fieldNameHash(key);
+            uint16_t entry = entries[fieldHashMix(h, seeds[h % buckets]) & (slots - 1)];
+            if (entry == 0 || names[entry - 1] != key)
+                return -1;
+            return entry - 1;
+        }
+    }
+};
+
 // Enum support - register your enums by specializing EnumMapping
 template <typename T> struct EnumMapping;
 
+// Lookups over a constexpr {value, name} array, all built at compile time:
+// value -> name through a dense array over [min, max] when that range is
+// small (binary search over the values otherwise), name -> value through
+// a NameTable. Names must be unique; a value listed twice (an alias) reads
+// from every name and writes as the first.
 template <typename EnumT, auto& MappingArray> struct EnumTraitsAuto
 {
     inline static constexpr auto& mapping = MappingArray;
+    static constexpr size_t count = std::size(MappingArray);
+
+  private:
+    using Key = std::conditional_t<std::is_signed_v<std::underlying_type_t<EnumT>>, int64_t, uint64_t>;
 
-    inline static const std::unordered_map<EnumT, std::string> enumToString = []()
+    static constexpr Key keyOf(EnumT e) { return static_cast<Key>(static_cast<std::underlying_type_t<EnumT>>(e)); }
+
+    static constexpr std::array<std::string_view, count> names = []
     {
-        std::unordered_map<EnumT, std::string> m;
-        for (auto [e, s] : mapping)
-            m[e] = s;
-        return m;
+        std::array<std::string_view, count> n{};
+        for (size_t i = 0; i < count; ++i)
+            n[i] = mapping[i].second;
+        return n;
     }();
 
-    inline static const std::unordered_map<std::string, EnumT> stringToEnum = []()
+    static constexpr NameTable<count> byName = NameTable<count>::build(names);
+    static_assert(byName.ok, "Enum names must be unique");
+
+    static constexpr Key minKey = []
     {
-        std::unordered_map<std::string, EnumT> m;
-        for (auto [e, s] : mapping)
-            m[s] = e;
-        return m;
+        Key k = count ? keyOf(mapping[0].first) : 0;
+        for (auto [e, _] : mapping)
+            k = std::min(k, keyOf(e));
+        return k;
     }();
 
-    static std::string toString(EnumT e)
+    static constexpr Key maxKey = []
     {
-        auto it = enumToString.find(e);
-        return it != enumToString.end() ? it->second : "";
-    }
+        Key k = count ? keyOf(mapping[0].first) : 0;
+        for (auto [e, _] : mapping)
+            k = std::max(k, keyOf(e));
+        return k;
+    }();
+
+    static constexpr bool dense = static_cast<uint64_t>(maxKey) - static_cast<uint64_t>(minKey) < 4 * count + 16;
+
+    // Dense: index + 1 of the first name for each value in [min, max].
+    // Sparse: mapping indices sorted by value.
+    static constexpr auto byValue = []
+    {
+        if constexpr (dense)
+        {
+            std::array<uint16_t, static_cast<size_t>(static_cast<uint64_t>(maxKey) - static_cast<uint64_t>(minKey)) + 1>
+                slots{};
+            for (size_t i = count; i-- > 0;)
+                slots[static_cast<uint64_t>(keyOf(mapping[i].first)) - static_cast<uint64_t>(minKey)] =
+                    static_cast<uint16_t>(i + 1);
+            return slots;
+        }
+        else
+        {
+            std::array<uint16_t, count> order{};
+            for (size_t i = 0; i < count; ++i)
+                order[i] = static_cast<uint16_t>(i);
+            std::sort(order.begin(), order.end(), [](uint16_t a, uint16_t b)
+                      {
+                          Key ka = keyOf(mapping[a].first), kb = keyOf(mapping[b].first);
+                          return ka != kb ? ka < kb : a < b;
+                      });
+            return order;
+        }
+    }();
 
-    static std::optional<EnumT> fromString(const std::string& s)
+    static constexpr int indexOf(EnumT e)
     {
-        auto it = stringToEnum.find(s);
-        return it != stringToEnum.end() ? std::optional(it->second) : std::nullopt;
+        Key k = keyOf(e);
+        if (count == 0 || k < minKey || k > maxKey)
+            return -1;
+        if constexpr (dense)
+            return byValue[static_cast<uint64_t>(k) - static_cast<uint64_t>(minKey)] - 1;
+        else
+        {
+            auto it = std::lower_bound(byValue.begin(), byValue.end(), k,
+                                       [](uint16_t i, Key key) { return keyOf(mapping[i].first) < key; });
+            return it != byValue.end() && keyOf(mapping[*it].first) == k ? *it : -1;
+        }
     }
 
-    template <typename Func> static void forEach(Func f)
+    static constexpr size_t validValuesSize()
     {
-        for (auto [e, _] : mapping)
-            f(e);
+        size_t n = count > 1 ? 2 * (count - 1) : 0;
+        for (auto name : names)
+            n += name.size();
+        return n;
     }
 
-    static std::string validValues()
+    static constexpr std::array<char, validValuesSize()> validValuesText = []
     {
-        std::string out;
-        bool first = true;
-        for (auto [_, s] : mapping)
+        std::array<char, validValuesSize()> text{};
+        size_t pos = 0;
+        for (size_t i = 0; i < count; ++i)
         {
-            if (!first) out += ", ";
-            first = false;
-            out += s;
+            if (i)
+            {
+                text[pos++] = ',';
+                text[pos++] = ' ';
+            }
+            for (char c : names[i])
+                text[pos++] = c;
         }
-        return out;
+        return text;
+    }();
+
+  public:
+    // Name of e, "" when e isn't in the mapping
+    static constexpr std::string_view name(EnumT e)
+    {
+        int i = indexOf(e);
+        return i < 0 ? std::string_view() : names[i];
+    }
+
+    static constexpr bool contains(EnumT e) { return indexOf(e) >= 0; }
+
+    static std::string toString(EnumT e) { return std::string(name(e)); }
+
+    static constexpr std::optional<EnumT> fromString(std::string_view s)
+    {
+        int i = byName.find(s);
+        return i < 0 ? std::nullopt : std::optional<EnumT>(mapping[i].first);
+    }
+
+    template <typename Func> static void forEach(Func f)
+    {
+        for (auto [e, _] : mapping)
+            f(e);
     }
+
+    // "a, b, c"
+    static constexpr std::string_view validValuesView() { return {validValuesText.data(), validValuesText.size()}; }
+
+    static std::string validValues() { return std::string(validValuesView()); }
 };
 
 template <typename EnumT>
@@ -153,1099 +403,4601 @@ template <typename EnumT>
     requires RegisteredEnum<EnumT>
 std::ostream& operator<<(std::ostream& os, EnumT e);
 
-struct ValidationResult
-{
-    bool valid = true;
-    std::vector<std::pair<std::string, std::string>> errors;
-    
-    void addError(std::string_view fieldName, std::string_view message)
-    {
-        valid = false;
-        errors.push_back({std::string(fieldName), std::string(message)});
-    }
-};
+// Tagged variants - specialize VariantTags to write a variant as
+// {"type": "<tag>", "value": <alternative>} and read it back by its tag
+// instead of trying every alternative in turn:
+//
+//   template <> struct meta::VariantTags<Shape>
+//   {
+//       static constexpr std::array names{"circle", "rect"}; // one per alternative
+//       static constexpr std::string_view key = "kind";      // optional, default "type"
+//       static constexpr std::string_view valueKey = "data"; // optional, default "value"
+//   };
+//
+// A std::monostate alternative is written as the tag alone.
+template <typename V> struct VariantTags;
 
-  
-// Abstract interfaces for format-agnostic serialization
-struct Node
-{
-    virtual ~Node() = default;
-    virtual std::optional<int> asInt() const = 0;
-    virtual std::optional<double> asDouble() const = 0;
-    virtual std::optional<bool> asBool() const = 0;
-    virtual std::optional<std::string> asString() const = 0;
-    virtual bool isSequence() const = 0;
-    virtual bool isMap() const = 0;
-    virtual bool isNull() const = 0;
-    virtual size_t size() const = 0;
-    virtual std::unique_ptr<Node> at(size_t i) const = 0;
-    virtual std::unique_ptr<Node> at(std::string k) const = 0;
-    virtual std::vector<std::string> keys() const = 0;
+template <typename V>
+concept TaggedVariant = requires {
+    std::size(VariantTags<V>::names);
+    std::string_view(VariantTags<V>::names[0]);
 };
 
-struct Builder
+template <TaggedVariant V> constexpr std::string_view variantTagKey()
 {
-    virtual ~Builder() = default;
-    virtual void writeInt(int v) = 0;
-    virtual void writeDouble(double v) = 0;
-    virtual void writeBool(bool v) = 0;
-    virtual void writeString(const std::string& v) = 0;
-    virtual void writeNull() = 0;
-    virtual void startSeq(const std::string& elemType = "") = 0;
-    virtual void endSeq() = 0;
-    virtual void startFlowSeq() { startSeq(""); }
-    virtual void endFlowSeq() { endSeq(); }
-    virtual void startMap(const std::string& valueType = "") = 0;
-    virtual void endMap() = 0;
-    virtual void key(const std::string& k) = 0;
-    virtual std::string result() = 0;
-};
+    if constexpr (requires { std::string_view(VariantTags<V>::key); })
+        return VariantTags<V>::key;
+    else
+        return "type";
+}
 
-// YAML implementation
-class YamlNode : public Node
+template <TaggedVariant V> constexpr std::string_view variantValueKey()
 {
-    YAML::Node node;
+    if constexpr (requires { std::string_view(VariantTags<V>::valueKey); })
+        return VariantTags<V>::valueKey;
+    else
+        return "value";
+}
 
+// (path, message) pairs of a ValidationResult. An empty list is a single
+// null pointer, so results on the success path never allocate; the vector
+// is created with the first error. Iterators are plain pointers.
+class ValidationErrors
+{
   public:
-    YamlNode(YAML::Node n) : node(n) {}
+    using value_type = std::pair<std::string, std::string>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
 
-    std::optional<int> asInt() const override
+    ValidationErrors() = default;
+    ValidationErrors(std::initializer_list<value_type> init)
     {
-        try { return node.as<int>(); }
-        catch (...) { return {}; }
+        if (init.size())
+            items = std::make_unique<std::vector<value_type>>(init);
     }
-
-    std::optional<double> asDouble() const override
+    ValidationErrors(const ValidationErrors& other)
+        : items(other.empty() ? nullptr : std::make_unique<std::vector<value_type>>(*other.items))
     {
-        try { return node.as<double>(); }
-        catch (...) { return {}; }
     }
-
-    std::optional<bool> asBool() const
+    ValidationErrors(ValidationErrors&&) noexcept = default;
+    ValidationErrors& operator=(const ValidationErrors& other)
     {
-        try { return node.as<bool>(); }
-        catch (...) { return {}; }
+        if (this != &other)
+            items = other.empty() ? nullptr : std::make_unique<std::vector<value_type>>(*other.items);
+        return *this;
     }
+    ValidationErrors& operator=(ValidationErrors&&) noexcept = default;
 
-    std::optional<std::string> asString() const override
+    size_t size() const { return items ? items->size() : 0; }
+    bool empty() const { return size() == 0; }
+
+    iterator begin() { return items ? items->data() : nullptr; }
+    iterator end() { return begin() + size(); }
+    const_iterator begin() const { return items ? items->data() : nullptr; }
+    const_iterator end() const { return begin() + size(); }
+
+    value_type& operator[](size_t i) { return (*items)[i]; }
+    const value_type& operator[](size_t i) const { return (*items)[i]; }
+    value_type& front() { return items->front(); }
+    const value_type& front() const { return items->front(); }
+    value_type& back() { return items->back(); }
+    const value_type& back() const { return items->back(); }
+
+    void push_back(value_type e) { storage().push_back(std::move(e)); }
+
+    template <typename... Args> value_type& emplace_back(Args&&... args)
     {
-        try { return node.as<std::string>(); }
-        catch (...) { return {}; }
+        return storage().emplace_back(std::forward<Args>(args)...);
     }
 
-    bool isSequence() const override { return node.IsSequence(); }
-    bool isMap() const override { return node.IsMap(); }
-    bool isNull() const override { return node.IsNull(); }
-    size_t size() const override { return node.size(); }
-
-    std::unique_ptr<Node> at(size_t i) const override
+    template <typename It> iterator insert(const_iterator pos, It first, It last)
     {
-        return std::make_unique<YamlNode>(node[i]);
+        auto& v = storage();
+        auto at = v.begin() + (pos ? pos - v.data() : 0);
+        return v.data() + (v.insert(at, first, last) - v.begin());
     }
 
-    std::unique_ptr<Node> at(std::string k) const override
+    void reserve(size_t n) { storage().reserve(n); }
+    void clear() { items.reset(); }
+
+    bool operator==(const ValidationErrors& other) const
     {
-        if (!node[k])
-            return nullptr;
-        return std::make_unique<YamlNode>(node[k]);
+        return std::equal(begin(), end(), other.begin(), other.end());
     }
 
-    std::vector<std::string> keys() const override
+  private:
+    std::unique_ptr<std::vector<value_type>> items;
+
+    std::vector<value_type>& storage()
     {
-        std::vector<std::string> k;
-        for (auto& item : node)
-            if (item.first.IsScalar())
-                k.push_back(item.first.as<std::string>());
-        return k;
+        if (!items)
+            items = std::make_unique<std::vector<value_type>>();
+        return *items;
     }
 };
 
-class YamlBuilder : public Builder
+struct ValidationResult
 {
-    YAML::Emitter out;
+    bool valid = true;
+    ValidationErrors errors;
 
-  public:
-    void writeInt(int v) override
+    void addError(std::string_view fieldName, std::string_view message)
     {
-        out << v;
+        valid = false;
+        errors.emplace_back(std::string(fieldName), std::string(message));
     }
 
-    void writeDouble(double v) override
+    // Move another result's errors in, re-rooted under `prefix` ("" stays
+    // "prefix", "name" becomes "prefix.name"). Paths are only touched when
+    // there are errors, and the first batch is taken over without copying.
+    void addErrorsUnder(std::string_view prefix, ValidationResult&& other)
     {
-        out << v;
+        if (other.valid)
+            return;
+        valid = false;
+        for (auto& [f, e] : other.errors)
+        {
+            if (f.empty())
+                f.assign(prefix);
+            else if (!prefix.empty())
+            {
+                f.insert(0, 1, '.');
+                f.insert(0, prefix);
+            }
+        }
+        if (errors.empty())
+            errors = std::move(other.errors);
+        else
+            errors.insert(errors.end(), std::make_move_iterator(other.errors.begin()),
+                          std::make_move_iterator(other.errors.end()));
     }
+};
 
-    void writeBool(bool v) override
-    {
-        out << v;
-    }
+// from() calls made on this thread stop at the first error while a FailFast
+// is alive. The result still says where that error is; nothing after it is
+// read, and containers keep the elements parsed before it.
+//
+//   meta::FailFast quick;
+//   auto [config, result] = meta::fromJson<Config>(text);
+class FailFast
+{
+    bool previous;
 
-    void writeString(const std::string& v) override
-    {
-        out << v;
-    }
+  public:
+    explicit FailFast(bool on = true) : previous(active()) { active() = on; }
+    ~FailFast() { active() = previous; }
+    FailFast(const FailFast&) = delete;
+    FailFast& operator=(const FailFast&) = delete;
 
-    void writeNull() override
+    static bool& active()
     {
-        out << YAML::Null;
+        thread_local bool on = false;
+        return on;
     }
 
-    void startSeq(const std::string& elemType = "") override
-    {
-        out << YAML::BeginSeq;
-    }
+    // True once `result` holds an error and the caller should stop
+    static bool stop(const ValidationResult& result) { return !result.valid && active(); }
+};
 
-    void endSeq() override
-    {
-        out << YAML::EndSeq;
-    }
+// from() calls made on this thread put every std::pmr string and container
+// they fill on `resource` while an ArenaScope is alive, so a whole message
+// can come from one arena and be released with it. The arena must outlive
+// the objects read under it.
+//
+//   std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+//   auto [message, result] = meta::fromJson<Message>(text, &arena);
+class ArenaScope
+{
+    std::pmr::memory_resource* previous;
 
-    void startFlowSeq() override
-    {
-        out << YAML::Flow << YAML::BeginSeq;
-    }
+  public:
+    explicit ArenaScope(std::pmr::memory_resource* r) : previous(resource()) { resource() = r; }
+    ~ArenaScope() { resource() = previous; }
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
 
-    void endFlowSeq() override
+    static std::pmr::memory_resource*& resource()
     {
-        out << YAML::EndSeq;
+        thread_local std::pmr::memory_resource* current = nullptr;
+        return current;
     }
+};
 
-    void startMap(const std::string& valueType = "") override
-    {
-        out << YAML::BeginMap;
-    }
+template <typename C>
+concept PmrAllocated = requires { typename C::allocator_type; } &&
+                       std::is_same_v<typename C::allocator_type, std::pmr::polymorphic_allocator<typename C::value_type>>;
 
-    void endMap() override
+// Rebuilds an empty pmr container on the ArenaScope resource unless it is
+// already there. Containers can't change allocator once built, so the old
+// object is destroyed and a new one constructed in its place.
+template <typename C>
+void useArena(C& obj)
+{
+    if constexpr (PmrAllocated<C>)
     {
-        out << YAML::EndMap;
+        std::pmr::memory_resource* r = ArenaScope::resource();
+        if (r && obj.get_allocator().resource() != r)
+        {
+            std::destroy_at(&obj);
+            std::construct_at(&obj, typename C::allocator_type(r));
+        }
     }
+}
 
-    void key(const std::string& k) override
-    {
-        out << YAML::Key << k << YAML::Value;
-    }
+// A value-initialized element for a container; allocator-aware element
+// types get the container's allocator
+template <typename T, typename A>
+T makeElement(const A& alloc)
+{
+    return std::make_obj_using_allocator<T>(alloc);
+}
 
-    std::string result() override 
-    { 
-        return out.c_str(); 
-    }
+// What a struct reader does with a key (or, in meta_binary.h and
+// meta_proto.h, a tag) that none of T's fields has. By default such keys
+// are skipped: JSON and YAML tapes jump over the whole subtree and the
+// binary readers over its length prefix, so the fields a newer writer
+// adds cost an older reader next to nothing. A type can ask for more:
+//
+//   template <> struct meta::UnknownFieldPolicy<Config>
+//   {
+//       static constexpr auto value = meta::UnknownFields::Error;
+//   };
+//
+// The policy is the type's own, so a strict Config may hold a lenient
+// Plugin section. A type with any policy but Ignore has all of its keys
+// walked once through FieldIndex instead of looking up each field.
+enum class UnknownFields : uint8_t
+{
+    Ignore,  // skipped
+    Collect, // skipped, and the key noted in the thread's UnknownFieldLog
+    Error    // "Unknown field" error; the read fails
 };
 
-  
-  
-class JsonBuilder : public Builder
+template <typename T> struct UnknownFieldPolicy;
+
+template <typename T>
+concept DeclaresUnknownFields = requires { UnknownFieldPolicy<T>::value; };
+
+template <typename T>
+constexpr UnknownFields unknownFieldsOf()
 {
-    std::ostringstream out;
-    bool needsComma = false;
+    if constexpr (DeclaresUnknownFields<T>)
+        return UnknownFieldPolicy<T>::value;
+    else
+        return UnknownFields::Ignore;
+}
 
-    void comma()
+// Keys skipped under UnknownFields::Collect are noted here, one entry per
+// type and key, while an UnknownFieldLog is alive on the thread. Nothing is
+// allocated for keys seen before, so a log can stay up for a whole stream.
+//
+//   meta::UnknownFieldLog log;
+//   auto [config, result] = meta::fromJson<Config>(text);
+//   for (const auto& entry : log.entries())
+//       warn(entry.type, entry.key, entry.count);
+class UnknownFieldLog
+{
+  public:
+    struct Entry
     {
-        if (needsComma)
-            out << ",";
-        needsComma = true;
-    }
+        std::string_view type; // type_name<T>() of the struct holding the key
+        std::string key;       // the key, or in binary and protobuf the tag number
+        size_t count = 0;      // times it was skipped
+    };
 
-  public:
-    void writeInt(int v) override { comma(); out << v; }
-    void writeDouble(double v) override { comma(); out << v; }
-    void writeBool(bool v) override { comma(); out << (v ? "true" : "false"); }
-    void writeString(const std::string& v) override { comma(); out << "\"" << v << "\""; }
-    void writeNull() override { comma(); out << "null"; }
+    UnknownFieldLog() : previous(current()) { current() = this; }
+    ~UnknownFieldLog() { current() = previous; }
+    UnknownFieldLog(const UnknownFieldLog&) = delete;
+    UnknownFieldLog& operator=(const UnknownFieldLog&) = delete;
 
-    void startSeq(const std::string& = "") override
+    const std::vector<Entry>& entries() const { return seen; }
+    bool empty() const { return seen.empty(); }
+    void clear() { seen.clear(); }
+
+    // Times `key` was skipped in `type`, 0 if never
+    size_t count(std::string_view type, std::string_view key) const
     {
-        if (needsComma) out << ",";
-        out << "[";
-        needsComma = false;
+        for (const Entry& e : seen)
+            if (e.type == type && e.key == key)
+                return e.count;
+        return 0;
     }
 
-    void endSeq() override { out << "]"; needsComma = true; }
-
-    void startMap(const std::string& = "") override
+    // Adds entries noted in another log, as if they had been noted here
+    // after the ones already in
+    void merge(const std::vector<Entry>& more)
     {
-        if (needsComma) out << ",";
-        out << "{";
-        needsComma = false;
+        for (const Entry& m : more)
+        {
+            auto it = std::find_if(seen.begin(), seen.end(),
+                                   [&](const Entry& e) { return e.type == m.type && e.key == m.key; });
+            if (it != seen.end())
+                it->count += m.count;
+            else
+                seen.push_back(m);
+        }
     }
 
-    void endMap() override { out << "}"; needsComma = true; }
+    // The log keys are noted in on this thread, or nullptr
+    static UnknownFieldLog* active() { return current(); }
 
-    void key(const std::string& k) override
+    static void note(std::string_view type, std::string_view key)
     {
-        comma();
-        out << "\"" << k << "\":";
-        needsComma = false;
+        if (UnknownFieldLog* log = current())
+        {
+            // New fields come a few at a time, so a linear scan is enough
+            for (Entry& e : log->seen)
+                if (e.type == type && e.key == key)
+                    return static_cast<void>(++e.count);
+            log->seen.push_back({type, std::string(key), 1});
+        }
     }
 
-    std::string result() override
+  private:
+    UnknownFieldLog* previous;
+    std::vector<Entry> seen;
+
+    static UnknownFieldLog*& current()
     {
-        return out.str();
+        thread_local UnknownFieldLog* log = nullptr;
+        return log;
     }
 };
 
-class XmlBuilder : public Builder
+// Applies T's policy to a key that is not one of its fields. Without a
+// policy of its own, `list` puts the key in result.errors and leaves the
+// result valid, as reifyFromYaml does for a document's top-level keys.
+template <typename T>
+void unknownField(std::string_view key, ValidationResult& result, bool list = false)
 {
-    std::ostringstream out;
-    int indentLevel = 0;
+    constexpr UnknownFields policy = unknownFieldsOf<T>();
+    if constexpr (policy == UnknownFields::Collect)
+        UnknownFieldLog::note(type_name<T>(), key);
+    else if constexpr (policy == UnknownFields::Error)
+        result.addError(key, "Unknown field - not in struct definition");
+    else if constexpr (!DeclaresUnknownFields<T>)
+    {
+        if (list)
+            result.errors.emplace_back(std::string(key), "Unknown field - not in struct definition");
+    }
+}
 
-    void indent()
+// The same for a numbered field of the binary formats. The error is the
+// struct's own ("" under its path), as the tag has no name.
+template <typename T>
+void unknownField(uint64_t tag, ValidationResult& result)
+{
+    constexpr UnknownFields policy = unknownFieldsOf<T>();
+    if constexpr (policy != UnknownFields::Ignore)
     {
-        for (int i = 0; i < indentLevel; ++i)
-            out << "  ";
+        char text[24];
+        auto end = std::to_chars(text, text + sizeof(text), tag).ptr;
+        std::string_view number(text, static_cast<size_t>(end - text));
+        if constexpr (policy == UnknownFields::Collect)
+            UnknownFieldLog::note(type_name<T>(), number);
+        else
+            result.addError("", "Unknown field tag " + std::string(number) + " - not in struct definition");
     }
+}
 
-  public:
-    XmlBuilder() { out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<root>\n"; indentLevel++; }
+class NodeCursor;
 
-    void writeInt(int v) override { out << v; }
-    void writeDouble(double v) override { out << v; }
-    void writeBool(bool v) override { out << (v ? "true" : "false"); }
-    void writeString(const std::string& v) override { out << v; }
-    void writeNull() override { /* XML nulls are empty elements */ }
+// Which names a document gives struct fields: the declared field name, or
+// the JsonColumn override JSON documents are written with
+enum class KeyNames
+{
+    Field,
+    Json
+};
 
-    void startSeq(const std::string& = "") override
+// Abstract interfaces for format-agnostic serialization
+struct Node
+{
+    // Receives map entries from visitEntries(); return false to stop early
+    struct EntryVisitor
     {
-        out << "\n";
-        indent();
-        out << "<sequence>\n";
-        indentLevel++;
-    }
+        virtual bool entry(std::string_view key, Node* value) = 0;
 
-    void endSeq() override
+      protected:
+        ~EntryVisitor() = default;
+    };
+
+    virtual ~Node() = default;
+    virtual std::optional<int> asInt() const = 0;
+    virtual std::optional<double> asDouble() const = 0;
+    // Integers past int's range; nodes that only implement asInt() read
+    // whatever fits in an int
+    virtual std::optional<int64_t> asInt64() const
     {
-        indentLevel--;
-        indent();
-        out << "</sequence>";
+        auto v = asInt();
+        return v ? std::optional<int64_t>(*v) : std::nullopt;
     }
-
-    void startMap(const std::string& = "") override
+    virtual std::optional<uint64_t> asUInt64() const
     {
-        out << "\n";
-        indent();
-        out << "<map>\n";
-        indentLevel++;
+        auto v = asInt();
+        if (!v || *v < 0)
+            return {};
+        return static_cast<uint64_t>(*v);
+    }
+    virtual std::optional<bool> asBool() const = 0;
+    virtual std::optional<std::string> asString() const = 0;
+    // The string value without copying it when the document holds it as
+    // text; otherwise it is built in scratch. Valid while the node is.
+    virtual std::optional<std::string_view> asStringView(std::string& scratch) const
+    {
+        auto v = asString();
+        if (!v)
+            return {};
+        scratch = std::move(*v);
+        return std::string_view(scratch);
     }
+    // The string's bytes exactly as they sit in the caller's input buffer,
+    // for std::string_view fields; nullopt when the value isn't a string or
+    // the document doesn't keep it verbatim (it had to be decoded or copied)
+    virtual std::optional<std::string_view> asSourceView() const { return {}; }
+    // Document nodes in this value, itself and map keys included; 0 when the
+    // document can't tell without walking it (reported to probes, see
+    // Instrumented)
+    virtual size_t subtreeSize() const { return 0; }
+    virtual bool isSequence() const = 0;
+    virtual bool isMap() const = 0;
+    virtual bool isNull() const = 0;
+    virtual size_t size() const = 0;
 
-    void endMap() override
+    // Children are constructed inside caller-owned storage and returned
+    // (nullptr when missing), so walking a document never allocates
+    virtual Node* at(size_t i, NodeCursor& out) const = 0;
+    virtual Node* at(std::string_view k, NodeCursor& out) const = 0;
+
+    // The names at(key) and the map entries know fields by
+    virtual KeyNames keyNames() const { return KeyNames::Field; }
+
+    // An independent copy of this view (read position included) that
+    // another thread may use while this one is in use, or nullptr when the
+    // document doesn't allow concurrent reads
+    virtual Node* concurrentView(NodeCursor&) const { return nullptr; }
+
+    // Visit every key/value pair of a map in document order
+    virtual void visitEntries(EntryVisitor& visitor) const = 0;
+
+    // forEachEntry([](std::string_view key, Node* value) { ... })
+    // The callback may return bool to stop early
+    template <typename F>
+    void forEachEntry(F&& f) const
     {
-        indentLevel--;
-        indent();
-        out << "</map>";
+        struct Adapter final : EntryVisitor
+        {
+            F& fn;
+            explicit Adapter(F& fn) : fn(fn) {}
+
+            bool entry(std::string_view key, Node* value) override
+            {
+                if constexpr (std::is_same_v<decltype(fn(key, value)), bool>)
+                    return fn(key, value);
+                else
+                {
+                    fn(key, value);
+                    return true;
+                }
+            }
+        } adapter(f);
+        visitEntries(adapter);
     }
 
-    void key(const std::string& k) override
+    std::vector<std::string> keys() const
     {
-        indent();
-        out << "<" << k << ">";
+        std::vector<std::string> k;
+        forEachEntry([&](std::string_view key, Node*) { k.emplace_back(key); });
+        return k;
     }
+};
 
-    void startFlowSeq() override { startSeq(); }
-    void endFlowSeq() override { endSeq(); }
+// Stack storage for the child handed out by Node::at(). Backends construct
+// their node type in place; it is destroyed when the cursor is reused or
+// goes out of scope.
+class NodeCursor
+{
+  public:
+    static constexpr size_t capacity = 96;
 
-    std::string result() override
+    NodeCursor() = default;
+    NodeCursor(const NodeCursor&) = delete;
+    NodeCursor& operator=(const NodeCursor&) = delete;
+    ~NodeCursor() { reset(); }
+
+    template <typename N, typename... Args>
+    N* emplace(Args&&... args)
     {
-        return out.str() + "\n</root>\n";
+        static_assert(std::is_base_of_v<Node, N>, "NodeCursor only holds meta::Node implementations");
+        static_assert(sizeof(N) <= capacity && alignof(N) <= alignof(std::max_align_t),
+                      "Node implementation does not fit in NodeCursor");
+        reset();
+        N* n = new (storage) N(std::forward<Args>(args)...);
+        current = n;
+        return n;
     }
+
+    void reset()
+    {
+        if (current)
+        {
+            current->~Node();
+            current = nullptr;
+        }
+    }
+
+    Node* get() const { return current; }
+    Node* operator->() const { return current; }
+    explicit operator bool() const { return current != nullptr; }
+
+  private:
+    alignas(std::max_align_t) std::byte storage[capacity];
+    Node* current = nullptr;
 };
 
 //============================================================
-// DESERIALIZATION (from)
+// OUTPUT SINKS
 //============================================================
+// Builders append to an [cur, end) window that the sink owns; the virtual
+// hook only runs when the window is exhausted, the same split as
+// std::streambuf but without locales or sentries. Numbers are formatted
+// with std::to_chars.
 
-// Forward declare main template
-template <typename T> ValidationResult from(T& obj, Node* node);
-
-// Primitive integer types - all convert through asInt()
-template <IntegerType T>
-ValidationResult from(T& obj, Node* node)
+class OutputSink
 {
-    auto val = node->asInt();
-    if (!val)
+  public:
+    virtual ~OutputSink() = default;
+
+    void write(const char* data, size_t n)
     {
-        ValidationResult r;
-        r.addError("", "Expected integer");
-        return r;
+        if (static_cast<size_t>(end - cur) < n)
+        {
+            overflow(data, n);
+            return;
+        }
+        std::memcpy(cur, data, n);
+        cur += n;
     }
-    obj = static_cast<T>(*val);
-    return ValidationResult();
-}
 
-// Floating point types
-template <FloatingPointType T>
-ValidationResult from(T& obj, Node* node)
-{
-    auto val = node->asDouble();
-    if (!val)
+    void write(std::string_view s) { write(s.data(), s.size()); }
+
+    void put(char c)
     {
-        ValidationResult r;
-        r.addError("", "Expected number");
-        return r;
+        if (cur == end)
+            makeRoom(1);
+        *cur++ = c;
     }
-    obj = static_cast<T>(*val);
-    return ValidationResult();
-}
 
-// Bool
-template <> inline ValidationResult from(bool& obj, Node* node)
-{
-    auto val = node->asBool();
-    if (!val)
+    template <IntegerType N> void writeInteger(N v)
     {
-        ValidationResult r;
-        r.addError("", "Expected boolean");
-        return r;
+        char buf[24];
+        auto r = std::to_chars(buf, buf + sizeof(buf), v);
+        write(buf, static_cast<size_t>(r.ptr - buf));
     }
-    obj = *val;
-    return ValidationResult();
-}
 
-// String
-template <> inline ValidationResult from(std::string& obj, Node* node)
-{
-    auto val = node->asString();
-    if (!val)
+    // Shortest digits that read back as the same double
+    void writeDouble(double v)
     {
-        ValidationResult r;
-        r.addError("", "Expected string");
-        return r;
+        char buf[32];
+        auto r = std::to_chars(buf, buf + sizeof(buf), v);
+        write(buf, static_cast<size_t>(r.ptr - buf));
     }
-    obj = *val;
-    return ValidationResult();
-}
 
-// Enum
-template <RegisteredEnum EnumT>
-ValidationResult from(EnumT& obj, Node* node)
-{
-    auto str = node->asString();
-    if (!str)
+    // Push buffered bytes to their destination (no-op for in-memory sinks)
+    virtual void flush() {}
+
+    // Bytes written through the sink so far, flushed or not (0 for sinks
+    // that don't count)
+    virtual size_t bytesWritten() const { return 0; }
+
+  protected:
+    char* cur = nullptr;
+    char* end = nullptr;
+
+    // Make at least n contiguous bytes available at cur
+    virtual void makeRoom(size_t n) = 0;
+
+    // Slow path for a write larger than the current window
+    virtual void overflow(const char* data, size_t n)
     {
-        ValidationResult r;
-        r.addError("", "Expected string for enum");
-        return r;
+        while (n > 0)
+        {
+            if (cur == end)
+                makeRoom(1);
+            size_t chunk = std::min(n, static_cast<size_t>(end - cur));
+            std::memcpy(cur, data, chunk);
+            cur += chunk;
+            data += chunk;
+            n -= chunk;
+        }
     }
+};
 
-    auto value = EnumMapping<EnumT>::Type::fromString(*str);
-    if (!value)
+// Growable contiguous buffer; take() hands the storage over without a copy
+class StringSink final : public OutputSink
+{
+  public:
+    explicit StringSink(size_t initialCapacity = 256)
     {
-        ValidationResult r;
-        std::string validVals = EnumMapping<EnumT>::Type::validValues();
-        r.addError("", "Unknown enum value: '" + *str + "'. Valid values are: " + validVals);
-        return r;
+        buf.resize(initialCapacity);
+        rebind(0);
     }
-    obj = *value;
-    return ValidationResult();
-}
 
-// Vector
-template <typename T>
-ValidationResult from(std::vector<T>& obj, Node* node)
-{
-    if (!node->isSequence())
+    StringSink(const StringSink&) = delete;
+    StringSink& operator=(const StringSink&) = delete;
+
+    size_t size() const { return static_cast<size_t>(cur - buf.data()); }
+    size_t bytesWritten() const override { return size(); }
+    const char* data() const { return buf.data(); }
+    std::string_view view() const { return {buf.data(), size()}; }
+
+    std::string take()
     {
-        ValidationResult r;
-        r.addError("", "Expected sequence");
-        return r;
+        buf.resize(size());
+        std::string out = std::move(buf);
+        buf = std::string();
+        rebind(0);
+        return out;
     }
 
-    obj.clear();
-    ValidationResult result;
-    for (size_t i = 0; i < node->size(); ++i)
+    // Discard the contents but keep the capacity
+    void clear() { cur = buf.data(); }
+
+    size_t capacity() const { return buf.size(); }
+
+    void reserve(size_t capacity)
     {
-        T elem{};
-        auto elemResult = from(elem, node->at(i).get());
-        if (!elemResult.valid)
+        if (capacity > buf.size())
         {
-            for (auto& [f, e] : elemResult.errors)
-                result.addError("[" + std::to_string(i) + "]" + (f.empty() ? "" : "." + f), e);
-        }
-        else
-        {
-            obj.push_back(std::move(elem));
+            size_t used = size();
+            buf.resize(capacity);
+            rebind(used);
         }
     }
-    return result;
-}
 
-// Deque
-template <typename T>
-ValidationResult from(std::deque<T>& obj, Node* node)
-{
-    if (!node->isSequence())
+  protected:
+    void makeRoom(size_t n) override
     {
-        ValidationResult r;
-        r.addError("", "Expected sequence");
-        return r;
+        size_t used = size();
+        buf.resize(std::max({buf.size() * 2, used + n, size_t(256)}));
+        rebind(used);
     }
 
-    obj.clear();
-    ValidationResult result;
-    for (size_t i = 0; i < node->size(); ++i)
+  private:
+    std::string buf;
+
+    void rebind(size_t used)
     {
-        T elem{};
-        auto elemResult = from(elem, node->at(i).get());
-        if (!elemResult.valid)
-        {
-            for (auto& [f, e] : elemResult.errors)
-                result.addError("[" + std::to_string(i) + "]" + (f.empty() ? "" : "." + f), e);
-        }
-        else
-        {
-            obj.push_back(std::move(elem));
-        }
+        cur = buf.data() + used;
+        end = buf.data() + buf.size();
     }
-    return result;
-}
+};
 
-// Set
-template <typename T>
-ValidationResult from(std::set<T>& obj, Node* node)
+// Writes into caller-owned memory; throws std::length_error when it is full
+class FixedBufferSink final : public OutputSink
 {
-    if (!node->isSequence())
+  public:
+    FixedBufferSink(char* buffer, size_t capacity) : begin(buffer)
     {
-        ValidationResult r;
-        r.addError("", "Expected sequence");
-        return r;
+        cur = buffer;
+        end = buffer + capacity;
     }
 
-    obj.clear();
-    ValidationResult result;
-    for (size_t i = 0; i < node->size(); ++i)
+    size_t size() const { return static_cast<size_t>(cur - begin); }
+    size_t bytesWritten() const override { return size(); }
+    std::string_view view() const { return {begin, size()}; }
+
+  protected:
+    void makeRoom(size_t) override
     {
-        T elem{};
-        auto elemResult = from(elem, node->at(i).get());
-        if (!elemResult.valid)
-        {
-            for (auto& [f, e] : elemResult.errors)
-                result.addError("[" + std::to_string(i) + "]" + (f.empty() ? "" : "." + f), e);
-        }
-        else
-        {
-            obj.insert(std::move(elem));
-        }
+        throw std::length_error("FixedBufferSink: output exceeds the supplied buffer");
     }
-    return result;
-}
 
-// Map
-template <typename K, typename V>
-ValidationResult from(std::map<K, V>& obj, Node* node)
+  private:
+    char* begin;
+};
+
+// List of fixed-size chunks: growing never moves bytes already written,
+// and the chunks can go straight to writev()
+class ChunkSink final : public OutputSink
 {
-    if (!node->isMap())
+  public:
+    explicit ChunkSink(size_t chunkSize = 64 * 1024) : chunkSize(chunkSize) {}
+
+    ChunkSink(const ChunkSink&) = delete;
+    ChunkSink& operator=(const ChunkSink&) = delete;
+
+    std::vector<std::string_view> chunks() const
     {
-        ValidationResult r;
-        r.addError("", "Expected map");
-        return r;
+        std::vector<std::string_view> views;
+        views.reserve(list.size());
+        for (size_t i = 0; i < list.size(); ++i)
+            views.emplace_back(list[i].data.get(), usedIn(i));
+        return views;
     }
 
-    obj.clear();
-    ValidationResult result;
-    for (const auto& k : node->keys())
+    size_t size() const
     {
-        K key;
-        if constexpr (std::is_same_v<K, std::string>)
-        {
-            key = k;
-        }
-        else if constexpr (std::is_integral_v<K>)
+        size_t total = 0;
+        for (size_t i = 0; i < list.size(); ++i)
+            total += usedIn(i);
+        return total;
+    }
+
+    size_t bytesWritten() const override { return size(); }
+
+    std::string str() const
+    {
+        std::string out;
+        out.reserve(size());
+        for (auto chunk : chunks())
+            out.append(chunk);
+        return out;
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    // Gather-write every chunk to fd; throws std::system_error on failure
+    void writeTo(int fd) const
+    {
+        auto views = chunks();
+        std::vector<iovec> iov;
+        iov.reserve(views.size());
+        for (auto v : views)
+            if (!v.empty())
+                iov.push_back({const_cast<char*>(v.data()), v.size()});
+
+        size_t first = 0;
+        while (first < iov.size())
         {
-            try { key = static_cast<K>(std::stoi(k)); }
-            catch (...)
+            int count = static_cast<int>(std::min<size_t>(iov.size() - first, IOV_MAX));
+            ssize_t n = ::writev(fd, iov.data() + first, count);
+            if (n < 0)
             {
-                result.addError(k, "Invalid key format");
-                continue;
+                if (errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category(), "ChunkSink: writev failed");
+            }
+            // Skip what was written, resuming mid-chunk after a short write
+            size_t written = static_cast<size_t>(n);
+            while (first < iov.size() && written >= iov[first].iov_len)
+                written -= iov[first++].iov_len;
+            if (written > 0)
+            {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + written;
+                iov[first].iov_len -= written;
             }
-        }
-
-        V value{};
-        auto valueResult = from(value, node->at(k).get());
-        if (!valueResult.valid)
-        {
-            for (auto& [f, e] : valueResult.errors)
-                result.addError(k + (f.empty() ? "" : "." + f), e);
-        }
-        else
-        {
-            obj[key] = std::move(value);
         }
     }
-    return result;
-}
+#endif
 
-// Unordered map
-template <typename K, typename V>
-ValidationResult from(std::unordered_map<K, V>& obj, Node* node)
-{
-    if (!node->isMap())
+  protected:
+    void makeRoom(size_t n) override
     {
-        ValidationResult r;
-        r.addError("", "Expected map");
-        return r;
+        if (!list.empty())
+            list.back().used = static_cast<size_t>(cur - list.back().data.get());
+        size_t capacity = std::max(chunkSize, n);
+        list.push_back({std::unique_ptr<char[]>(new char[capacity]), 0});
+        cur = list.back().data.get();
+        end = cur + capacity;
     }
 
-    obj.clear();
+  private:
+    struct Chunk
+    {
+        std::unique_ptr<char[]> data;
+        size_t used;
+    };
+
+    size_t chunkSize;
+    std::vector<Chunk> list;
+
+    size_t usedIn(size_t i) const
+    {
+        return i + 1 == list.size() ? static_cast<size_t>(cur - list[i].data.get()) : list[i].used;
+    }
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+// Buffered writes to a file descriptor (file, pipe, socket). The
+// descriptor is not closed; flush() throws std::system_error on failure.
+class FdSink final : public OutputSink
+{
+  public:
+    explicit FdSink(int fd, size_t bufferSize = 64 * 1024)
+        : fd(fd), capacity(std::max(bufferSize, size_t(64))), buffer(new char[capacity])
+    {
+        cur = buffer.get();
+        end = cur + capacity;
+    }
+
+    FdSink(const FdSink&) = delete;
+    FdSink& operator=(const FdSink&) = delete;
+
+    ~FdSink() override
+    {
+        try { flush(); }
+        catch (...) {}
+    }
+
+    void flush() override
+    {
+        size_t pending = static_cast<size_t>(cur - buffer.get());
+        cur = buffer.get();
+        writeAll(buffer.get(), pending);
+    }
+
+    size_t bytesWritten() const override { return written + static_cast<size_t>(cur - buffer.get()); }
+
+  protected:
+    void makeRoom(size_t) override { flush(); }
+
+    // A block at least as large as the buffer goes out with what is
+    // buffered in one writev, without being copied
+    void overflow(const char* data, size_t n) override
+    {
+        if (n < capacity)
+        {
+            flush();
+            std::memcpy(cur, data, n);
+            cur += n;
+            return;
+        }
+        size_t pending = static_cast<size_t>(cur - buffer.get());
+        cur = buffer.get();
+        iovec iov[2] = {{buffer.get(), pending}, {const_cast<char*>(data), n}};
+        writeAll(pending ? iov : iov + 1, pending ? 2 : 1);
+    }
+
+  private:
+    int fd;
+    size_t capacity;
+    std::unique_ptr<char[]> buffer;
+    size_t written = 0;
+
+    void writeAll(const char* data, size_t n)
+    {
+        iovec iov{const_cast<char*>(data), n};
+        writeAll(&iov, 1);
+    }
+
+    void writeAll(iovec* iov, int count)
+    {
+        while (count > 0)
+        {
+            ssize_t r = count == 1 ? ::write(fd, iov->iov_base, iov->iov_len) : ::writev(fd, iov, count);
+            if (r < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category(), "FdSink: write failed");
+            }
+            written += static_cast<size_t>(r);
+            // Resume mid-block after a short write
+            size_t done = static_cast<size_t>(r);
+            while (count > 0 && done >= iov->iov_len)
+            {
+                done -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+            if (count > 0)
+            {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + done;
+                iov->iov_len -= done;
+            }
+        }
+    }
+};
+#endif
+
+// Buffered writes to a stdio stream. The FILE is not closed; flush()
+// hands the buffer to fwrite and fflushes, and throws std::system_error
+// when either fails.
+class FileSink final : public OutputSink
+{
+  public:
+    explicit FileSink(std::FILE* file, size_t bufferSize = 64 * 1024)
+        : file(file), capacity(std::max(bufferSize, size_t(64))), buffer(new char[capacity])
+    {
+        cur = buffer.get();
+        end = cur + capacity;
+    }
+
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    ~FileSink() override
+    {
+        try { flush(); }
+        catch (...) {}
+    }
+
+    void flush() override
+    {
+        size_t pending = static_cast<size_t>(cur - buffer.get());
+        cur = buffer.get();
+        writeAll(buffer.get(), pending);
+        if (std::fflush(file) != 0)
+            throw std::system_error(errno, std::generic_category(), "FileSink: fflush failed");
+    }
+
+    size_t bytesWritten() const override { return written + static_cast<size_t>(cur - buffer.get()); }
+
+  protected:
+    void makeRoom(size_t) override
+    {
+        size_t pending = static_cast<size_t>(cur - buffer.get());
+        cur = buffer.get();
+        writeAll(buffer.get(), pending);
+    }
+
+    void overflow(const char* data, size_t n) override
+    {
+        makeRoom(0);
+        if (n >= capacity)
+        {
+            writeAll(data, n);
+            return;
+        }
+        std::memcpy(cur, data, n);
+        cur += n;
+    }
+
+  private:
+    std::FILE* file;
+    size_t capacity;
+    std::unique_ptr<char[]> buffer;
+    size_t written = 0;
+
+    void writeAll(const char* data, size_t n)
+    {
+        size_t r = n ? std::fwrite(data, 1, n, file) : 0;
+        written += r;
+        if (r != n)
+            throw std::system_error(errno, std::generic_category(), "FileSink: fwrite failed");
+    }
+};
+
+// Buffered writes to a std::ostream. flush() writes the buffer and
+// flushes the stream, and throws std::ios_base::failure once the stream
+// has gone bad.
+class StreamSink final : public OutputSink
+{
+  public:
+    explicit StreamSink(std::ostream& os, size_t bufferSize = 64 * 1024)
+        : os(os), capacity(std::max(bufferSize, size_t(64))), buffer(new char[capacity])
+    {
+        cur = buffer.get();
+        end = cur + capacity;
+    }
+
+    StreamSink(const StreamSink&) = delete;
+    StreamSink& operator=(const StreamSink&) = delete;
+
+    ~StreamSink() override
+    {
+        try { flush(); }
+        catch (...) {}
+    }
+
+    void flush() override
+    {
+        makeRoom(0);
+        os.flush();
+        check();
+    }
+
+    size_t bytesWritten() const override { return written + static_cast<size_t>(cur - buffer.get()); }
+
+  protected:
+    void makeRoom(size_t) override
+    {
+        size_t pending = static_cast<size_t>(cur - buffer.get());
+        cur = buffer.get();
+        writeAll(buffer.get(), pending);
+    }
+
+    void overflow(const char* data, size_t n) override
+    {
+        makeRoom(0);
+        if (n >= capacity)
+        {
+            writeAll(data, n);
+            return;
+        }
+        std::memcpy(cur, data, n);
+        cur += n;
+    }
+
+  private:
+    std::ostream& os;
+    size_t capacity;
+    std::unique_ptr<char[]> buffer;
+    size_t written = 0;
+
+    void writeAll(const char* data, size_t n)
+    {
+        if (n == 0)
+            return;
+        os.write(data, static_cast<std::streamsize>(n));
+        check();
+        written += n;
+    }
+
+    void check() const
+    {
+        if (!os)
+            throw std::ios_base::failure("StreamSink: write failed");
+    }
+};
+
+// Buffered writes handed to a callback, one full buffer at a time: for
+// client APIs that take blocks of data (PQputCopyData, a socket library,
+// a compressor). The callback takes std::string_view; what it throws
+// propagates out of write() or flush(). The destructor doesn't send
+// anything, so flush() once the last byte is written.
+template <typename F>
+class CallbackSink final : public OutputSink
+{
+  public:
+    explicit CallbackSink(F fn, size_t bufferSize = 64 * 1024)
+        : fn(std::move(fn)), capacity(std::max(bufferSize, size_t(64))), buffer(new char[capacity])
+    {
+        cur = buffer.get();
+        end = cur + capacity;
+    }
+
+    CallbackSink(const CallbackSink&) = delete;
+    CallbackSink& operator=(const CallbackSink&) = delete;
+
+    void flush() override
+    {
+        size_t pending = static_cast<size_t>(cur - buffer.get());
+        cur = buffer.get();
+        if (pending)
+        {
+            fn(std::string_view(buffer.get(), pending));
+            sent += pending;
+        }
+    }
+
+    size_t bytesWritten() const override { return sent + static_cast<size_t>(cur - buffer.get()); }
+
+  protected:
+    void makeRoom(size_t) override { flush(); }
+
+    void overflow(const char* data, size_t n) override
+    {
+        flush();
+        if (n >= capacity)
+        {
+            fn(std::string_view(data, n));
+            sent += n;
+            return;
+        }
+        std::memcpy(cur, data, n);
+        cur += n;
+    }
+
+  private:
+    F fn;
+    size_t capacity;
+    std::unique_ptr<char[]> buffer;
+    size_t sent = 0;
+};
+
+// Key of a struct field: its name, and the JSON fragment `,"name":`
+// (JsonColumn override applied, escaped) built at compile time
+struct FieldKey
+{
+    std::string_view name;
+    std::string_view json;
+};
+
+struct Builder
+{
+    virtual ~Builder() = default;
+    virtual void writeInt(int v) = 0;
+    // Integers that don't fit in an int. Builders that only implement
+    // writeInt get in-range values through it and the rest as a double.
+    virtual void writeInt64(int64_t v)
+    {
+        if (std::in_range<int>(v))
+            writeInt(static_cast<int>(v));
+        else
+            writeDouble(static_cast<double>(v));
+    }
+    virtual void writeUInt64(uint64_t v)
+    {
+        if (std::in_range<int>(v))
+            writeInt(static_cast<int>(v));
+        else
+            writeDouble(static_cast<double>(v));
+    }
+    virtual void writeDouble(double v) = 0;
+    virtual void writeBool(bool v) = 0;
+    virtual void writeString(const std::string& v) = 0;
+    virtual void writeNull() = 0;
+    virtual void startSeq(const std::string& elemType = "") = 0;
+    virtual void endSeq() = 0;
+    virtual void startFlowSeq() { startSeq(""); }
+    virtual void endFlowSeq() { endSeq(); }
+    virtual void startMap(const std::string& valueType = "") = 0;
+    virtual void endMap() = 0;
+    virtual void key(const std::string& k) = 0;
+    virtual void fieldKey(const FieldKey& k) { key(std::string(k.name)); }
+    // Write any trailing document bytes and flush the sink
+    virtual void finish() {}
+    // Output of a builder writing into its own buffer, handed over without a copy
+    virtual std::string result() = 0;
+    // Bytes output so far, for probes (see Instrumented); 0 when unknown
+    virtual size_t bytesWritten() const { return 0; }
+};
+
+// Anything with Builder's event methods. to() is templated on it, so a
+// concrete (or final) builder gets every event inlined; Builder itself
+// satisfies it and dispatches through the vtable.
+template <typename B>
+concept BuilderLike = requires(B& b, const std::string& s) {
+    b.writeInt(1);
+    b.writeDouble(1.0);
+    b.writeBool(true);
+    b.writeString(s);
+    b.writeNull();
+    b.startSeq(s);
+    b.endSeq();
+    b.startFlowSeq();
+    b.endFlowSeq();
+    b.startMap(s);
+    b.endMap();
+    b.key(s);
+};
+
+// Type-erases a static builder for code that picks the format at run time
+template <BuilderLike B>
+class BuilderRef final : public Builder
+{
+    B& inner;
+
+  public:
+    explicit BuilderRef(B& inner) : inner(inner) {}
+
+    void writeInt(int v) override { inner.writeInt(v); }
+
+    void writeInt64(int64_t v) override
+    {
+        if constexpr (requires { inner.writeInt64(v); })
+            inner.writeInt64(v);
+        else
+            Builder::writeInt64(v);
+    }
+
+    void writeUInt64(uint64_t v) override
+    {
+        if constexpr (requires { inner.writeUInt64(v); })
+            inner.writeUInt64(v);
+        else
+            Builder::writeUInt64(v);
+    }
+
+    void writeDouble(double v) override { inner.writeDouble(v); }
+    void writeBool(bool v) override { inner.writeBool(v); }
+    void writeString(const std::string& v) override { inner.writeString(v); }
+    void writeNull() override { inner.writeNull(); }
+    void startSeq(const std::string& t = "") override { inner.startSeq(t); }
+    void endSeq() override { inner.endSeq(); }
+    void startFlowSeq() override { inner.startFlowSeq(); }
+    void endFlowSeq() override { inner.endFlowSeq(); }
+    void startMap(const std::string& t = "") override { inner.startMap(t); }
+    void endMap() override { inner.endMap(); }
+    void key(const std::string& k) override { inner.key(k); }
+
+    void fieldKey(const FieldKey& k) override
+    {
+        if constexpr (requires { inner.fieldKey(k); })
+            inner.fieldKey(k);
+        else
+            inner.key(std::string(k.name));
+    }
+
+    void finish() override
+    {
+        if constexpr (requires { inner.finish(); })
+            inner.finish();
+    }
+
+    std::string result() override
+    {
+        if constexpr (requires { inner.result(); })
+            return inner.result();
+        else
+            return {};
+    }
+
+    size_t bytesWritten() const override
+    {
+        if constexpr (requires { inner.bytesWritten(); })
+            return inner.bytesWritten();
+        else
+            return 0;
+    }
+};
+
+//============================================================
+// YAML SCALAR CONVERSION
+//============================================================
+// Non-throwing equivalents of yaml-cpp's convert<T>::decode. They accept the
+// same spellings (0x / leading-0 octal integers, .inf / .nan, y/yes/true/on
+// in lower, UPPER or Capitalized case) but reject with a branch instead of
+// a stringstream and a thrown YAML::BadConversion.
+
+inline std::string_view trimTrailingSpace(std::string_view s)
+{
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\n' ||
+                          s.back() == '\r' || s.back() == '\f' || s.back() == '\v'))
+        s.remove_suffix(1);
+    return s;
+}
+
+template <IntegerType T>
+std::optional<T> parseYamlInteger(std::string_view s)
+{
+    s = trimTrailingSpace(s);
+    size_t i = 0;
+    bool negative = false;
+    if (i < s.size() && (s[i] == '+' || s[i] == '-'))
+    {
+        negative = s[i] == '-';
+        ++i;
+    }
+    if (negative && std::is_unsigned_v<T>)
+        return {};
+
+    int base = 10;
+    if (s.size() - i > 1 && s[i] == '0' && (s[i + 1] == 'x' || s[i + 1] == 'X'))
+    {
+        base = 16;
+        i += 2;
+    }
+    else if (s.size() - i > 1 && s[i] == '0')
+    {
+        base = 8;
+        ++i;
+    }
+    if (i >= s.size())
+        return {};
+
+    unsigned long long magnitude = 0;
+    const char* end = s.data() + s.size();
+    auto [ptr, ec] = std::from_chars(s.data() + i, end, magnitude, base);
+    if (ec != std::errc() || ptr != end)
+        return {};
+
+    using Wide = std::make_unsigned_t<T>;
+    if (negative)
+    {
+        if (magnitude > static_cast<unsigned long long>(std::numeric_limits<T>::max()) + 1)
+            return {};
+        return static_cast<T>(static_cast<Wide>(0) - static_cast<Wide>(magnitude));
+    }
+    if (magnitude > static_cast<unsigned long long>(std::numeric_limits<T>::max()))
+        return {};
+    return static_cast<T>(magnitude);
+}
+
+template <FloatingPointType T>
+std::optional<T> parseYamlFloat(std::string_view s)
+{
+    s = trimTrailingSpace(s);
+    if (s == ".inf" || s == ".Inf" || s == ".INF" || s == "+.inf" || s == "+.Inf" || s == "+.INF")
+        return std::numeric_limits<T>::infinity();
+    if (s == "-.inf" || s == "-.Inf" || s == "-.INF")
+        return -std::numeric_limits<T>::infinity();
+    if (s == ".nan" || s == ".NaN" || s == ".NAN")
+        return std::numeric_limits<T>::quiet_NaN();
+
+    size_t i = (!s.empty() && s[0] == '+') ? 1 : 0;
+    size_t digit = (i < s.size() && s[i] == '-') ? i + 1 : i;
+    if (digit >= s.size() || (i == 1 && digit != i))
+        return {};
+    // from_chars also takes "inf"/"nan"; plain YAML numbers start with a digit or '.'
+    if (s[digit] != '.' && (s[digit] < '0' || s[digit] > '9'))
+        return {};
+
+    T value{};
+    const char* end = s.data() + s.size();
+    auto [ptr, ec] = std::from_chars(s.data() + i, end, value);
+    if (ec != std::errc() || ptr != end)
+        return {};
+    return value;
+}
+
+inline std::optional<bool> parseYamlBool(std::string_view s)
+{
+    auto lower = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c + 32) : c; };
+    auto isLower = [](char c) { return c >= 'a' && c <= 'z'; };
+    auto isUpper = [](char c) { return c >= 'A' && c <= 'Z'; };
+
+    if (s.empty() || s.size() > 5)
+        return {};
+
+    // yaml-cpp only accepts lower, UPPER and Capitalized spellings
+    bool allLower = true, restLower = true, restUpper = true;
+    for (size_t i = 0; i < s.size(); ++i)
+    {
+        allLower = allLower && isLower(s[i]);
+        if (i > 0)
+        {
+            restLower = restLower && isLower(s[i]);
+            restUpper = restUpper && isUpper(s[i]);
+        }
+    }
+    if (!allLower && !(isUpper(s[0]) && (restLower || restUpper)))
+        return {};
+
+    char buf[5];
+    for (size_t i = 0; i < s.size(); ++i)
+        buf[i] = lower(s[i]);
+    std::string_view folded(buf, s.size());
+
+    if (folded == "y" || folded == "yes" || folded == "true" || folded == "on")
+        return true;
+    if (folded == "n" || folded == "no" || folded == "false" || folded == "off")
+        return false;
+    return {};
+}
+
+//============================================================
+// STRING ESCAPING
+//============================================================
+// JSON strings escape quotes, backslashes and control characters; XML
+// text escapes & < > " ' and writes other control characters as character
+// references. Input is scanned 16 bytes at a time (SSE2, with a scalar
+// fallback) for the first byte that needs escaping, and each clean run is
+// copied with one write, so text with nothing to escape costs one pass.
+
+// The two-character escape JSON defines for c, or "" if it has none
+constexpr std::string_view jsonShortEscape(char c)
+{
+    switch (c)
+    {
+    case '"': return "\\\"";
+    case '\\': return "\\\\";
+    case '\b': return "\\b";
+    case '\f': return "\\f";
+    case '\n': return "\\n";
+    case '\r': return "\\r";
+    case '\t': return "\\t";
+    default: return {};
+    }
+}
+
+constexpr bool jsonNeedsEscape(char c)
+{
+    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+constexpr bool xmlNeedsEscape(char c)
+{
+    return c == '&' || c == '<' || c == '>' || c == '"' || c == '\'' || static_cast<unsigned char>(c) < 0x20;
+}
+
+#if defined(__SSE2__)
+// Bit i set when byte i of v is below 0x20
+inline unsigned controlMask(__m128i v)
+{
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1f)), v)));
+}
+#endif
+
+// Length of the leading run of [p, p + n) that JSON can take as is
+inline size_t jsonCleanPrefix(const char* p, size_t n)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        unsigned mask = controlMask(v) | static_cast<unsigned>(_mm_movemask_epi8(
+                                             _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash))));
+        if (mask)
+            return i + std::countr_zero(mask);
+    }
+#endif
+    while (i < n && !jsonNeedsEscape(p[i]))
+        ++i;
+    return i;
+}
+
+inline size_t xmlCleanPrefix(const char* p, size_t n)
+{
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i amp = _mm_set1_epi8('&');
+    const __m128i lt = _mm_set1_epi8('<');
+    const __m128i gt = _mm_set1_epi8('>');
+    const __m128i quot = _mm_set1_epi8('"');
+    const __m128i apos = _mm_set1_epi8('\'');
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, amp), _mm_cmpeq_epi8(v, lt)),
+                                   _mm_or_si128(_mm_cmpeq_epi8(v, gt),
+                                                _mm_or_si128(_mm_cmpeq_epi8(v, quot), _mm_cmpeq_epi8(v, apos))));
+        unsigned mask = controlMask(v) | static_cast<unsigned>(_mm_movemask_epi8(hit));
+        if (mask)
+            return i + std::countr_zero(mask);
+    }
+#endif
+    while (i < n && !xmlNeedsEscape(p[i]))
+        ++i;
+    return i;
+}
+
+// s as the inside of a JSON string literal
+inline void writeJsonEscaped(OutputSink& out, std::string_view s)
+{
+    static constexpr char hex[] = "0123456789abcdef";
+    const char* p = s.data();
+    size_t n = s.size();
+    while (true)
+    {
+        size_t clean = jsonCleanPrefix(p, n);
+        out.write(p, clean);
+        if (clean == n)
+            return;
+        const char c = p[clean];
+        if (auto e = jsonShortEscape(c); !e.empty())
+            out.write(e);
+        else
+        {
+            const auto u = static_cast<unsigned char>(c);
+            const char e6[] = {'\\', 'u', '0', '0', hex[u >> 4], hex[u & 0xF]};
+            out.write(e6, sizeof(e6));
+        }
+        p += clean + 1;
+        n -= clean + 1;
+    }
+}
+
+// s as XML character data
+inline void writeXmlEscaped(OutputSink& out, std::string_view s)
+{
+    static constexpr char hex[] = "0123456789abcdef";
+    const char* p = s.data();
+    size_t n = s.size();
+    while (true)
+    {
+        size_t clean = xmlCleanPrefix(p, n);
+        out.write(p, clean);
+        if (clean == n)
+            return;
+        const char c = p[clean];
+        switch (c)
+        {
+        case '&': out.write("&amp;"); break;
+        case '<': out.write("&lt;"); break;
+        case '>': out.write("&gt;"); break;
+        case '"': out.write("&quot;"); break;
+        case '\'': out.write("&apos;"); break;
+        case '\t':
+        case '\n':
+        case '\r': out.put(c); break;
+        default:
+        {
+            const auto u = static_cast<unsigned char>(c);
+            const char ref[] = {'&', '#', 'x', hex[u >> 4], hex[u & 0xF], ';'};
+            out.write(ref, sizeof(ref));
+        }
+        }
+        p += clean + 1;
+        n -= clean + 1;
+    }
+}
+
+// YAML implementation
+class YamlNode : public Node
+{
+    YAML::Node node;
+
+  public:
+    YamlNode(YAML::Node n) : node(n) {}
+
+    std::optional<int> asInt() const override
+    {
+        if (!node.IsScalar())
+            return {};
+        return parseYamlInteger<int>(node.Scalar());
+    }
+
+    std::optional<int64_t> asInt64() const override
+    {
+        if (!node.IsScalar())
+            return {};
+        return parseYamlInteger<int64_t>(node.Scalar());
+    }
+
+    std::optional<uint64_t> asUInt64() const override
+    {
+        if (!node.IsScalar())
+            return {};
+        return parseYamlInteger<uint64_t>(node.Scalar());
+    }
+
+    std::optional<double> asDouble() const override
+    {
+        if (!node.IsScalar())
+            return {};
+        return parseYamlFloat<double>(node.Scalar());
+    }
+
+    std::optional<bool> asBool() const override
+    {
+        if (!node.IsScalar())
+            return {};
+        return parseYamlBool(node.Scalar());
+    }
+
+    // Same as node.as<std::string>(): null reads as "null"
+    std::optional<std::string> asString() const override
+    {
+        if (node.IsNull())
+            return std::string("null");
+        if (!node.IsScalar())
+            return {};
+        return node.Scalar();
+    }
+
+    std::optional<std::string_view> asStringView(std::string&) const override
+    {
+        if (node.IsNull())
+            return std::string_view("null");
+        if (!node.IsScalar())
+            return {};
+        return std::string_view(node.Scalar());
+    }
+
+    bool isSequence() const override { return node.IsSequence(); }
+    bool isMap() const override { return node.IsMap(); }
+    bool isNull() const override { return node.IsNull(); }
+    size_t size() const override { return node.size(); }
+
+    Node* at(size_t i, NodeCursor& out) const override
+    {
+        if (!node.IsSequence() || i >= node.size())
+            return nullptr;
+        return out.emplace<YamlNode>(node[i]);
+    }
+
+    Node* at(std::string_view k, NodeCursor& out) const override
+    {
+        if (!node.IsMap())
+            return nullptr;
+        for (auto it = node.begin(); it != node.end(); ++it)
+            if (it->first.IsScalar() && it->first.Scalar() == k)
+                return out.emplace<YamlNode>(it->second);
+        return nullptr;
+    }
+
+    void visitEntries(EntryVisitor& visitor) const override
+    {
+        if (!node.IsMap())
+            return;
+        NodeCursor value;
+        for (auto it = node.begin(); it != node.end(); ++it)
+        {
+            if (!it->first.IsScalar())
+                continue;
+            if (!visitor.entry(it->first.Scalar(), value.emplace<YamlNode>(it->second)))
+                return;
+        }
+    }
+};
+
+//============================================================
+// YAML EVENT DOCUMENT - yaml-cpp parse events on a flat tape
+//============================================================
+// YamlDocument receives yaml-cpp's parser events and records them as one
+// YamlEvent per value, in document order, with every scalar appended to a
+// single text buffer. No YAML::Node tree is built. Containers store the
+// index one past their subtree in `next`, so skipping a value is O(1), and
+// an alias is a copy of its anchor's events. YamlDocumentNode reads the
+// tape exactly as YamlNode reads the equivalent YAML::Node.
+
+enum class YamlEventType : uint8_t
+{
+    Null,
+    Scalar,
+    Sequence,
+    Map
+};
+
+struct YamlEvent
+{
+    uint32_t begin = 0;  // offset into text for scalars
+    uint32_t length = 0; // byte length for scalars, element/pair count for containers
+    uint32_t next = 0;   // index of the first event after this value's subtree
+    YamlEventType type = YamlEventType::Null;
+};
+
+class YamlDocument final : private YAML::EventHandler
+{
+  public:
+    YamlDocument() = default;
+    explicit YamlDocument(std::string_view yaml) { parse(yaml); }
+
+    // Reads the first document in `yaml` (an empty input reads as null);
+    // throws YAML::Exception on malformed input
+    void parse(std::string_view yaml)
+    {
+        tape.clear();
+        text.clear();
+        anchors.clear();
+        open.clear();
+        tape.reserve(yaml.size() / 16 + 1);
+        text.reserve(yaml.size() / 2);
+
+        ViewBuffer buffer(yaml);
+        std::istream in(&buffer);
+        YAML::Parser parser(in);
+        if (!parser.HandleNextDocument(*this) || tape.empty())
+        {
+            tape.clear();
+            tape.push_back({0, 0, 1, YamlEventType::Null});
+        }
+    }
+
+    const YamlEvent& operator[](uint32_t i) const { return tape[i]; }
+    size_t eventCount() const { return tape.size(); }
+
+    std::string_view scalar(const YamlEvent& e) const { return std::string_view(text).substr(e.begin, e.length); }
+
+  private:
+    // Lets YAML::Parser read a string_view without copying it
+    struct ViewBuffer : std::streambuf
+    {
+        explicit ViewBuffer(std::string_view s)
+        {
+            char* p = const_cast<char*>(s.data());
+            setg(p, p, p + s.size());
+        }
+    };
+
+    struct Open
+    {
+        uint32_t index;
+        uint32_t children;
+        YAML::anchor_t anchor;
+    };
+
+    std::vector<YamlEvent> tape;
+    std::string text;
+    std::vector<uint32_t> anchors; // anchor id -> event index (0 = unset or still open)
+    std::vector<Open> open;
+
+    uint32_t push(YamlEventType type, uint32_t begin = 0, uint32_t length = 0)
+    {
+        if (tape.size() >= std::numeric_limits<uint32_t>::max())
+            throw YAML::Exception(YAML::Mark::null_mark(), "YAML document too large");
+        tape.push_back({begin, length, static_cast<uint32_t>(tape.size() + 1), type});
+        return static_cast<uint32_t>(tape.size() - 1);
+    }
+
+    void remember(YAML::anchor_t anchor, uint32_t index)
+    {
+        if (anchor == YAML::NullAnchor)
+            return;
+        if (anchors.size() <= anchor)
+            anchors.resize(anchor + 1, 0);
+        anchors[anchor] = index + 1;
+    }
+
+    // A finished value counts towards its parent
+    void completed()
+    {
+        if (!open.empty())
+            ++open.back().children;
+    }
+
+    void start(YamlEventType type, YAML::anchor_t anchor)
+    {
+        open.push_back({push(type), 0, anchor});
+    }
+
+    void end()
+    {
+        Open o = open.back();
+        open.pop_back();
+        YamlEvent& e = tape[o.index];
+        e.length = e.type == YamlEventType::Map ? o.children / 2 : o.children;
+        e.next = static_cast<uint32_t>(tape.size());
+        remember(o.anchor, o.index);
+        completed();
+    }
+
+    void OnDocumentStart(const YAML::Mark&) override {}
+    void OnDocumentEnd() override {}
+
+    void OnNull(const YAML::Mark&, YAML::anchor_t anchor) override
+    {
+        remember(anchor, push(YamlEventType::Null));
+        completed();
+    }
+
+    void OnScalar(const YAML::Mark& mark, const std::string&, YAML::anchor_t anchor,
+                  const std::string& value) override
+    {
+        if (text.size() + value.size() > std::numeric_limits<uint32_t>::max())
+            throw YAML::Exception(mark, "YAML document too large");
+        uint32_t begin = static_cast<uint32_t>(text.size());
+        text += value;
+        remember(anchor, push(YamlEventType::Scalar, begin, static_cast<uint32_t>(value.size())));
+        completed();
+    }
+
+    void OnAlias(const YAML::Mark& mark, YAML::anchor_t anchor) override
+    {
+        if (anchor >= anchors.size() || anchors[anchor] == 0)
+            throw YAML::Exception(mark, "alias refers to an anchor that is not complete");
+        uint32_t first = anchors[anchor] - 1;
+        uint32_t last = tape[first].next;
+        uint32_t shift = static_cast<uint32_t>(tape.size()) - first;
+        for (uint32_t i = first; i < last; ++i)
+        {
+            YamlEvent e = tape[i];
+            e.next += shift;
+            tape.push_back(e);
+        }
+        completed();
+    }
+
+    void OnSequenceStart(const YAML::Mark&, const std::string&, YAML::anchor_t anchor,
+                         YAML::EmitterStyle::value) override
+    {
+        start(YamlEventType::Sequence, anchor);
+    }
+
+    void OnSequenceEnd() override { end(); }
+
+    void OnMapStart(const YAML::Mark&, const std::string&, YAML::anchor_t anchor,
+                    YAML::EmitterStyle::value) override
+    {
+        start(YamlEventType::Map, anchor);
+    }
+
+    void OnMapEnd() override { end(); }
+};
+
+class YamlDocumentNode : public Node
+{
+    const YamlDocument* doc;
+    uint32_t index;
+
+    // Sequential at(i) calls resume from the last element instead of
+    // re-walking the sequence from the start
+    mutable uint32_t cachedElement = 0;
+    mutable uint32_t cachedEvent = 0;
+
+    // at(key) searches from the entry after the last hit, wrapping around,
+    // so fields read in document order skip the keys in between once
+    // instead of rescanning them for every field
+    mutable uint32_t cachedEntry = 0;
+    mutable uint32_t cachedKey = 0;
+
+    const YamlEvent& event() const { return (*doc)[index]; }
+
+    // The text of a non-null scalar, nullopt otherwise
+    std::optional<std::string_view> scalar() const
+    {
+        if (event().type != YamlEventType::Scalar)
+            return {};
+        return doc->scalar(event());
+    }
+
+  public:
+    YamlDocumentNode(const YamlDocument& d, uint32_t i) : doc(&d), index(i) {}
+
+    std::optional<int> asInt() const override
+    {
+        auto s = scalar();
+        return s ? parseYamlInteger<int>(*s) : std::nullopt;
+    }
+
+    std::optional<int64_t> asInt64() const override
+    {
+        auto s = scalar();
+        return s ? parseYamlInteger<int64_t>(*s) : std::nullopt;
+    }
+
+    std::optional<uint64_t> asUInt64() const override
+    {
+        auto s = scalar();
+        return s ? parseYamlInteger<uint64_t>(*s) : std::nullopt;
+    }
+
+    std::optional<double> asDouble() const override
+    {
+        auto s = scalar();
+        return s ? parseYamlFloat<double>(*s) : std::nullopt;
+    }
+
+    std::optional<bool> asBool() const override
+    {
+        auto s = scalar();
+        return s ? parseYamlBool(*s) : std::nullopt;
+    }
+
+    // Same as YamlNode: null reads as "null"
+    std::optional<std::string> asString() const override
+    {
+        if (event().type == YamlEventType::Null)
+            return std::string("null");
+        auto s = scalar();
+        return s ? std::optional<std::string>(*s) : std::nullopt;
+    }
+
+    std::optional<std::string_view> asStringView(std::string&) const override
+    {
+        if (event().type == YamlEventType::Null)
+            return std::string_view("null");
+        return scalar();
+    }
+
+    size_t subtreeSize() const override { return event().next - index; }
+    bool isSequence() const override { return event().type == YamlEventType::Sequence; }
+    bool isMap() const override { return event().type == YamlEventType::Map; }
+    bool isNull() const override { return event().type == YamlEventType::Null; }
+
+    size_t size() const override
+    {
+        const YamlEvent& e = event();
+        return (e.type == YamlEventType::Sequence || e.type == YamlEventType::Map) ? e.length : 0;
+    }
+
+    Node* at(size_t i, NodeCursor& out) const override
+    {
+        const YamlEvent& e = event();
+        if (e.type != YamlEventType::Sequence || i >= e.length)
+            return nullptr;
+
+        uint32_t element = 0;
+        uint32_t ev = index + 1;
+        if (cachedEvent != 0 && i >= cachedElement)
+        {
+            element = cachedElement;
+            ev = cachedEvent;
+        }
+        for (; element < i; ++element)
+            ev = (*doc)[ev].next;
+
+        cachedElement = element;
+        cachedEvent = ev;
+        return out.emplace<YamlDocumentNode>(*doc, ev);
+    }
+
+    Node* at(std::string_view k, NodeCursor& out) const override
+    {
+        const YamlEvent& e = event();
+        if (e.type != YamlEventType::Map)
+            return nullptr;
+
+        uint32_t entry = cachedKey ? cachedEntry : 0;
+        uint32_t ev = cachedKey ? cachedKey : index + 1;
+        for (uint32_t n = 0; n < e.length; ++n, ++entry)
+        {
+            if (entry == e.length)
+            {
+                entry = 0;
+                ev = index + 1;
+            }
+            const YamlEvent& key = (*doc)[ev];
+            ev = (*doc)[key.next].next;
+            if (key.type == YamlEventType::Scalar && doc->scalar(key) == k)
+            {
+                cachedEntry = entry + 1;
+                cachedKey = ev;
+                return out.emplace<YamlDocumentNode>(*doc, key.next);
+            }
+        }
+        return nullptr;
+    }
+
+    // The tape is immutable once parsed; only the at(i) cache is per view
+    Node* concurrentView(NodeCursor& out) const override
+    {
+        return out.emplace<YamlDocumentNode>(*this);
+    }
+
+    void visitEntries(EntryVisitor& visitor) const override
+    {
+        const YamlEvent& e = event();
+        if (e.type != YamlEventType::Map)
+            return;
+
+        NodeCursor value;
+        uint32_t ev = index + 1;
+        for (uint32_t n = 0; n < e.length; ++n)
+        {
+            const YamlEvent& key = (*doc)[ev];
+            if (key.type == YamlEventType::Scalar &&
+                !visitor.entry(doc->scalar(key), value.emplace<YamlDocumentNode>(*doc, key.next)))
+                return;
+            ev = (*doc)[key.next].next;
+        }
+    }
+};
+
+class YamlBuilder final : public Builder
+{
+    // Hands the emitter's output to the sink as it is produced, so a large
+    // document is never held in memory
+    struct SinkStream : std::streambuf
+    {
+        OutputSink& sink;
+        std::ostream stream;
+
+        // badbit rethrows what the sink throws instead of swallowing it
+        explicit SinkStream(OutputSink& s) : sink(s), stream(this) { stream.exceptions(std::ios::badbit); }
+
+        int_type overflow(int_type c) override
+        {
+            if (c != traits_type::eof())
+                sink.put(static_cast<char>(c));
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char* s, std::streamsize n) override
+        {
+            sink.write(s, static_cast<size_t>(n));
+            return n;
+        }
+    };
+
+    StringSink buffer;
+    OutputSink* sink;
+    std::unique_ptr<SinkStream> target;
+    YAML::Emitter out;
+
+  public:
+    YamlBuilder() : YamlBuilder(buffer) {}
+    explicit YamlBuilder(OutputSink& sink)
+        : sink(&sink), target(std::make_unique<SinkStream>(sink)), out(target->stream)
+    {
+    }
+
+    // Ready for the next document, keeping the buffer and the stream on
+    // it. yaml-cpp can't rewind an emitter, so that one is built again.
+    void reset()
+    {
+        buffer.clear();
+        std::destroy_at(&out);
+        std::construct_at(&out, target->stream);
+    }
+
+    // What has been written so far into the builder's own buffer
+    std::string_view view() const { return buffer.view(); }
+    size_t capacity() const { return buffer.capacity(); }
+
+    void writeInt(int v) override
+    {
+        out << v;
+    }
+
+    void writeInt64(int64_t v) override
+    {
+        out << static_cast<long long>(v);
+    }
+
+    void writeUInt64(uint64_t v) override
+    {
+        out << static_cast<unsigned long long>(v);
+    }
+
+    // yaml-cpp prints max_digits10 digits (0.1 as 0.10000000000000001), so
+    // finite values go out as their shortest round-trip form instead
+    void writeDouble(double v) override
+    {
+        if (!std::isfinite(v))
+        {
+            out << v;
+            return;
+        }
+        char buf[32];
+        auto r = std::to_chars(buf, buf + sizeof(buf), v);
+        out << std::string(buf, r.ptr);
+    }
+
+    void writeBool(bool v) override
+    {
+        out << v;
+    }
+
+    void writeString(const std::string& v) override
+    {
+        out << v;
+    }
+
+    void writeNull() override
+    {
+        out << YAML::Null;
+    }
+
+    void startSeq(const std::string& elemType = "") override
+    {
+        out << YAML::BeginSeq;
+    }
+
+    void endSeq() override
+    {
+        out << YAML::EndSeq;
+    }
+
+    void startFlowSeq() override
+    {
+        out << YAML::Flow << YAML::BeginSeq;
+    }
+
+    void endFlowSeq() override
+    {
+        out << YAML::EndSeq;
+    }
+
+    void startMap(const std::string& valueType = "") override
+    {
+        out << YAML::BeginMap;
+    }
+
+    void endMap() override
+    {
+        out << YAML::EndMap;
+    }
+
+    void key(const std::string& k) override
+    {
+        out << YAML::Key << k << YAML::Value;
+    }
+
+    void finish() override { sink->flush(); }
+
+    std::string result() override { return buffer.take(); }
+
+    size_t bytesWritten() const override { return out.size(); }
+};
+
+  
+  
+class JsonBuilder final : public Builder
+{
+    StringSink buffer;
+    OutputSink& out;
+    bool needsComma = false;
+
+    void comma()
+    {
+        if (needsComma)
+            out.put(',');
+        needsComma = true;
+    }
+
+  public:
+    JsonBuilder() : out(buffer) {}
+    explicit JsonBuilder(OutputSink& sink) : out(sink) {}
+
+    void writeInt(int v) override { comma(); out.writeInteger(v); }
+    void writeInt64(int64_t v) override { comma(); out.writeInteger(v); }
+    void writeUInt64(uint64_t v) override { comma(); out.writeInteger(v); }
+    void writeDouble(double v) override { comma(); out.writeDouble(v); }
+    void writeBool(bool v) override { comma(); out.write(v ? "true" : "false"); }
+    void writeString(const std::string& v) override
+    {
+        comma();
+        out.put('"');
+        writeJsonEscaped(out, v);
+        out.put('"');
+    }
+    void writeNull() override { comma(); out.write("null"); }
+
+    void startSeq(const std::string& = "") override
+    {
+        if (needsComma) out.put(',');
+        out.put('[');
+        needsComma = false;
+    }
+
+    void endSeq() override { out.put(']'); needsComma = true; }
+
+    void startMap(const std::string& = "") override
+    {
+        if (needsComma) out.put(',');
+        out.put('{');
+        needsComma = false;
+    }
+
+    void endMap() override { out.put('}'); needsComma = true; }
+
+    // Start the next top-level value without a comma, for callers that
+    // write their own separators between values
+    void resetSeparator() { needsComma = false; }
+
+    // Ready for the next document; the buffer keeps its capacity
+    void reset()
+    {
+        buffer.clear();
+        needsComma = false;
+    }
+
+    // What has been written so far into the builder's own buffer
+    std::string_view view() const { return buffer.view(); }
+    size_t capacity() const { return buffer.capacity(); }
+
+    void key(const std::string& k) override
+    {
+        comma();
+        out.put('"');
+        writeJsonEscaped(out, k);
+        out.write("\":");
+        needsComma = false;
+    }
+
+    // One copy of the precomputed fragment, comma included when needed
+    void fieldKey(const FieldKey& k) override
+    {
+        out.write(needsComma ? k.json : k.json.substr(1));
+        needsComma = false;
+    }
+
+    void finish() override { out.flush(); }
+
+    std::string result() override
+    {
+        return buffer.take();
+    }
+
+    size_t bytesWritten() const override { return out.bytesWritten(); }
+};
+
+class XmlBuilder final : public Builder
+{
+    StringSink buffer;
+    OutputSink& out;
+    int indentLevel = 0;
+    bool finished = false;
+
+    void indent()
+    {
+        for (int i = 0; i < indentLevel; ++i)
+            out.write("  ");
+    }
+
+    void prolog()
+    {
+        out.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<root>\n");
+        indentLevel++;
+    }
+
+  public:
+    XmlBuilder() : out(buffer) { prolog(); }
+    explicit XmlBuilder(OutputSink& sink) : out(sink) { prolog(); }
+
+    void writeInt(int v) override { out.writeInteger(v); }
+    void writeInt64(int64_t v) override { out.writeInteger(v); }
+    void writeUInt64(uint64_t v) override { out.writeInteger(v); }
+    void writeDouble(double v) override { out.writeDouble(v); }
+    void writeBool(bool v) override { out.write(v ? "true" : "false"); }
+    void writeString(const std::string& v) override { writeXmlEscaped(out, v); }
+    void writeNull() override { /* XML nulls are empty elements */ }
+
+    void startSeq(const std::string& = "") override
+    {
+        out.put('\n');
+        indent();
+        out.write("<sequence>\n");
+        indentLevel++;
+    }
+
+    void endSeq() override
+    {
+        indentLevel--;
+        indent();
+        out.write("</sequence>");
+    }
+
+    void startMap(const std::string& = "") override
+    {
+        out.put('\n');
+        indent();
+        out.write("<map>\n");
+        indentLevel++;
+    }
+
+    void endMap() override
+    {
+        indentLevel--;
+        indent();
+        out.write("</map>");
+    }
+
+    void key(const std::string& k) override
+    {
+        indent();
+        out.put('<');
+        out.write(k);
+        out.put('>');
+    }
+
+    void startFlowSeq() override { startSeq(); }
+    void endFlowSeq() override { endSeq(); }
+
+    // Ready for the next document, prolog written; the buffer keeps its
+    // capacity
+    void reset()
+    {
+        buffer.clear();
+        indentLevel = 0;
+        finished = false;
+        prolog();
+    }
+
+    // What has been written so far into the builder's own buffer
+    std::string_view view() const { return buffer.view(); }
+    size_t capacity() const { return buffer.capacity(); }
+
+    void finish() override
+    {
+        if (!finished)
+            out.write("\n</root>\n");
+        finished = true;
+        out.flush();
+    }
+
+    std::string result() override
+    {
+        finish();
+        return buffer.take();
+    }
+
+    size_t bytesWritten() const override { return out.bytesWritten(); }
+};
+
+//============================================================
+// BUILDER POOL - builders reused across calls on a thread
+//============================================================
+// toJson, toYaml, toXml and toCSV lease a builder from the calling
+// thread's pool instead of setting one up per call, so a steady stream of
+// small documents reuses the same buffers (and for YAML, the same output
+// stream). Nothing is shared between threads, so nothing is locked.
+//
+//   {
+//       auto builder = meta::BuilderPool<meta::JsonBuilder>::lease();
+//       meta::to(response, *builder);
+//       socket.send(builder->view());
+//   }   // reset and back in the pool
+//
+// Leases nest: a to() that serializes something else on the way (a Ser
+// hook calling toJson) is handed a second builder. A builder whose buffer
+// grew past retainLimit gives its buffer to the result or, if it still
+// has it when it comes back, is dropped rather than kept. Once the
+// thread's pool has been destroyed (toJson called from a static or
+// thread_local destructor that runs after it), every lease gets a builder
+// of its own.
+template <typename B>
+class BuilderPool
+{
+    // Trivially destructible, so still readable after the pool is gone
+    static bool& destroyed()
+    {
+        thread_local bool gone = false;
+        return gone;
+    }
+
+    struct Idle
+    {
+        std::vector<std::unique_ptr<B>> builders;
+        ~Idle() { destroyed() = true; }
+    };
+
+    // nullptr once the thread's pool has been destroyed
+    static std::vector<std::unique_ptr<B>>* idle()
+    {
+        if (destroyed())
+            return nullptr;
+        thread_local Idle pool;
+        return &pool.builders;
+    }
+
+  public:
+    static constexpr size_t retainLimit = 64 * 1024;
+
+    class Lease
+    {
+        std::unique_ptr<B> builder;
+
+      public:
+        explicit Lease(std::unique_ptr<B> b) : builder(std::move(b)) {}
+        Lease(Lease&&) = default;
+        Lease& operator=(Lease&&) = delete;
+
+        ~Lease()
+        {
+            if (!builder || builder->capacity() > retainLimit)
+                return;
+            if (auto* free = idle())
+            {
+                builder->reset();
+                free->push_back(std::move(builder));
+            }
+        }
+
+        B& operator*() const { return *builder; }
+        B* operator->() const { return builder.get(); }
+
+        // The document as a string: copied out of a buffer the pool will
+        // keep, or handed over whole from one it would drop
+        std::string take()
+        {
+            if (builder->capacity() > retainLimit)
+                return builder->result();
+            return std::string(builder->view());
+        }
+    };
+
+    static Lease lease()
+    {
+        auto* free = idle();
+        if (!free || free->empty())
+            return Lease(std::make_unique<B>());
+        Lease lease(std::move(free->back()));
+        free->pop_back();
+        return lease;
+    }
+
+    // Builders waiting on this thread
+    static size_t idleCount()
+    {
+        auto* free = idle();
+        return free ? free->size() : 0;
+    }
+};
+
+//============================================================
+// FIELD INDEX - compile-time perfect hash over field names
+//============================================================
+// FieldIndex<T>::find(key) maps a document key to the position of the
+// matching field in get_fields<T>() (or -1) through a NameTable;
+// FieldIndex<T, KeyNames::Json> matches JsonColumn names instead.
+
+template <typename T>
+constexpr size_t field_count_v = std::tuple_size_v<std::decay_t<decltype(get_fields<T>())>>;
+
+// Reads every field name, so it is only a constant expression when the
+// field table is `static constexpr`
+template <typename T>
+constexpr bool fieldNamesReadable()
+{
+    return [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        return (true && ... && (std::string_view(std::get<I>(get_fields<T>()).fieldName).size() >= 0));
+    }(std::make_index_sequence<field_count_v<T>>{});
+}
+
+// Field tables declared `inline const` (as generated MetaTuple
+// specializations may be) can't be indexed at compile time; lookups over
+// them fall back to runtime scans
+template <typename T>
+concept ConstexprFields = requires { typename std::bool_constant<fieldNamesReadable<T>()>; };
+
+// The name a document with the given KeyNames knows field by
+template <typename F>
+constexpr std::string_view keyName(const F& field, KeyNames names)
+{
+    return names == KeyNames::Json ? field.getJsonProperty() : std::string_view(field.fieldName);
+}
+
+template <typename T, KeyNames Names = KeyNames::Field>
+struct FieldIndex
+{
+    static constexpr size_t count = field_count_v<T>;
+
+    static constexpr NameTable<count> build()
+    {
+        std::array<std::string_view, count> names{};
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            ((names[I] = keyName(std::get<I>(get_fields<T>()), Names)), ...);
+        }(std::make_index_sequence<count>{});
+        return NameTable<count>::build(names);
+    }
+
+    static constexpr NameTable<count> table = build();
+
+    static constexpr int find(std::string_view key)
+    {
+        if constexpr (!ConstexprFields<T>)
+        {
+            int found = -1;
+            int i = 0;
+            std::apply([&](const auto&... field)
+                       { (..., (found < 0 && key == keyName(field, Names) ? found = i++ : i++)); },
+                       get_fields<T>());
+            return found;
+        }
+        else
+        {
+            static_assert(table.ok, "Field names must be unique");
+            return table.find(key);
+        }
+    }
+};
+
+// The field a key of `node`'s document names, or -1
+template <typename T>
+int findField(std::string_view key, const Node* node)
+{
+    if (node->keyNames() == KeyNames::Json)
+        return FieldIndex<T, KeyNames::Json>::find(key);
+    return FieldIndex<T>::find(key);
+}
+
+//============================================================
+// JSON KEY FRAGMENTS
+//============================================================
+// JsonKeys<T>::fragment(i) is `,"name":` for field i - JsonColumn name when
+// present, JSON-escaped - laid out in one constexpr buffer so writing a key
+// is a single memcpy.
+
+constexpr size_t jsonEscapedSize(std::string_view s)
+{
+    size_t n = 0;
+    for (char c : s)
+        n += !jsonNeedsEscape(c) ? 1 : !jsonShortEscape(c).empty() ? 2 : 6;
+    return n;
+}
+
+constexpr size_t jsonKeyFragmentSize(std::string_view name)
+{
+    return jsonEscapedSize(name) + 4; // ,"":
+}
+
+// Writes `,"name":` at out; returns the number of bytes written
+template <typename It>
+constexpr size_t writeJsonKeyFragment(It out, std::string_view name)
+{
+    constexpr char hex[] = "0123456789abcdef";
+    It start = out;
+    *out++ = ',';
+    *out++ = '"';
+    for (char c : name)
+    {
+        auto u = static_cast<unsigned char>(c);
+        if (!jsonNeedsEscape(c))
+            *out++ = c;
+        else if (auto e = jsonShortEscape(c); !e.empty())
+        {
+            for (char x : e)
+                *out++ = x;
+        }
+        else
+        {
+            for (char e : {'\\', 'u', '0', '0', hex[u >> 4], hex[u & 0xF]})
+                *out++ = e;
+        }
+    }
+    *out++ = '"';
+    *out++ = ':';
+    return static_cast<size_t>(out - start);
+}
+
+template <typename T>
+constexpr std::array<std::string_view, field_count_v<T>> jsonFieldNames()
+{
+    return [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        return std::array<std::string_view, field_count_v<T>>{
+            std::get<I>(get_fields<T>()).getJsonProperty()...};
+    }(std::make_index_sequence<field_count_v<T>>{});
+}
+
+template <typename T>
+struct JsonKeyTable
+{
+    static constexpr size_t count = field_count_v<T>;
+
+    static constexpr size_t totalSize()
+    {
+        size_t n = 0;
+        for (auto name : jsonFieldNames<T>())
+            n += jsonKeyFragmentSize(name);
+        return n;
+    }
+
+    std::array<char, totalSize()> text{};
+    std::array<size_t, count + 1> offsets{};
+
+    static constexpr JsonKeyTable build()
+    {
+        JsonKeyTable t;
+        size_t pos = 0;
+        auto names = jsonFieldNames<T>();
+        for (size_t i = 0; i < count; ++i)
+        {
+            t.offsets[i] = pos;
+            pos += writeJsonKeyFragment(t.text.begin() + pos, names[i]);
+        }
+        t.offsets[count] = pos;
+        return t;
+    }
+};
+
+template <typename T>
+struct JsonKeys
+{
+    static std::string_view fragment(size_t i)
+    {
+        if constexpr (ConstexprFields<T>)
+        {
+            static constexpr JsonKeyTable<T> table = JsonKeyTable<T>::build();
+            return {table.text.data() + table.offsets[i], table.offsets[i + 1] - table.offsets[i]};
+        }
+        else
+        {
+            // Built once, on first use
+            static const std::vector<std::string> fragments = []
+            {
+                std::vector<std::string> out;
+                std::apply([&](const auto&... field)
+                           {
+                               (..., [&](std::string_view name)
+                                {
+                                    std::string& f = out.emplace_back(jsonKeyFragmentSize(name), '\0');
+                                    writeJsonKeyFragment(f.begin(), name);
+                                }(field.getJsonProperty()));
+                           },
+                           get_fields<T>());
+                return out;
+            }();
+            return fragments[i];
+        }
+    }
+};
+
+//============================================================
+// INSTRUMENTATION
+//============================================================
+// The struct walkers in from() and to() report on T while
+// Instrumented<T> names a probe for it:
+//
+//   struct ConfigMetrics
+//   {
+//       static void exitField(const meta::ProbeEvent& e)
+//       {
+//           registry.histogram("parse_ns", {e.type, e.field}).record(e.elapsed.count());
+//       }
+//   };
+//   template <> struct meta::Instrumented<Config> { using Probe = ConfigMetrics; };
+//
+// A probe is a policy class defining any of enterType, exitType,
+// enterField and exitField as static functions taking a ProbeEvent; the
+// enter/exit pairs nest, so they map straight onto tracing spans. Types
+// left on NoProbe compile to the plain walkers, so the hooks cost nothing
+// until a type opts in. A field's event covers its whole value, nested
+// structs included; give those a probe too to break them down further.
+// Only the meta.h walkers report (meta_binary.h and meta_proto.h have
+// their own), and Ser/Deser hooks get type events but no field events
+// unless they go through readField.
+struct NoProbe
+{
+};
+
+template <typename T> struct Instrumented
+{
+    using Probe = NoProbe;
+};
+
+template <typename T>
+concept HasProbe = !std::is_same_v<typename Instrumented<T>::Probe, NoProbe>;
+
+enum class ProbeWalk
+{
+    Read,
+    Write
+};
+
+struct ProbeEvent
+{
+    ProbeWalk walk;
+    std::string_view type;
+    std::string_view field; // empty for type events
+
+    // Filled in for the exit hooks
+    std::chrono::nanoseconds elapsed{};
+    size_t nodes = 0;  // read: document nodes in the value, keys included (0 when the document can't tell)
+    size_t errors = 0; // read: errors reported for the value
+    size_t bytes = 0;  // write: bytes output (0 when the builder can't tell)
+};
+
+// Runs work between Probe's enter and exit hooks; work fills in the
+// counts, the elapsed time is measured around it
+template <typename Probe, typename F>
+void probed(ProbeEvent event, F&& work)
+{
+    bool isField = !event.field.empty();
+    if constexpr (requires { Probe::enterField(event); })
+        if (isField)
+            Probe::enterField(event);
+    if constexpr (requires { Probe::enterType(event); })
+        if (!isField)
+            Probe::enterType(event);
+
+    auto start = std::chrono::steady_clock::now();
+    work(event);
+    event.elapsed = std::chrono::steady_clock::now() - start;
+
+    if constexpr (requires { Probe::exitField(event); })
+        if (isField)
+            Probe::exitField(event);
+    if constexpr (requires { Probe::exitType(event); })
+        if (!isField)
+            Probe::exitType(event);
+}
+
+template <typename B>
+size_t probeBytes(const B& b)
+{
+    if constexpr (requires { b.bytesWritten(); })
+        return b.bytesWritten();
+    else
+        return 0;
+}
+
+// A ready-made probe that sums the field events of every type pointing at
+// it, per thread, for finding the fields a read or write spends its time in
+struct FieldProfile
+{
+    struct Totals
+    {
+        size_t calls = 0;
+        std::chrono::nanoseconds elapsed{};
+        size_t nodes = 0;
+        size_t errors = 0;
+        size_t bytes = 0;
+    };
+
+    using Key = std::tuple<ProbeWalk, std::string_view, std::string_view>;
+
+    static std::map<Key, Totals>& totals()
+    {
+        thread_local std::map<Key, Totals> table;
+        return table;
+    }
+
+    static void exitField(const ProbeEvent& e)
+    {
+        Totals& t = totals()[Key{e.walk, e.type, e.field}];
+        ++t.calls;
+        t.elapsed += e.elapsed;
+        t.nodes += e.nodes;
+        t.errors += e.errors;
+        t.bytes += e.bytes;
+    }
+
+    // Fields by time spent, slowest first
+    static std::vector<std::pair<Key, Totals>> slowest()
+    {
+        std::vector<std::pair<Key, Totals>> rows(totals().begin(), totals().end());
+        std::sort(rows.begin(), rows.end(),
+                  [](const auto& a, const auto& b) { return a.second.elapsed > b.second.elapsed; });
+        return rows;
+    }
+};
+
+//============================================================
+// DESERIALIZATION (from)
+//============================================================
+
+// Forward declare main template
+template <typename T> ValidationResult from(T& obj, Node* node);
+
+// Primitive integer types - through asInt() when T fits in an int,
+// otherwise asInt64() / asUInt64()
+template <IntegerType T>
+ValidationResult from(T& obj, Node* node)
+{
+    auto read = [node]
+    {
+        if constexpr (fitsInInt<T>)
+            return node->asInt();
+        else if constexpr (std::is_signed_v<T>)
+            return node->asInt64();
+        else
+            return node->asUInt64();
+    };
+    auto val = read();
+    ValidationResult r;
+    if (!val)
+        r.addError("", "Expected integer");
+    else if (!std::in_range<StandardInteger<T>>(*val))
+        r.addError("", "Integer out of range");
+    else
+        obj = static_cast<T>(*val);
+    return r;
+}
+
+// Floating point types
+template <FloatingPointType T>
+ValidationResult from(T& obj, Node* node)
+{
+    auto val = node->asDouble();
+    if (!val)
+    {
+        ValidationResult r;
+        r.addError("", "Expected number");
+        return r;
+    }
+    obj = static_cast<T>(*val);
+    return ValidationResult();
+}
+
+// Bool
+template <> inline ValidationResult from(bool& obj, Node* node)
+{
+    auto val = node->asBool();
+    if (!val)
+    {
+        ValidationResult r;
+        r.addError("", "Expected boolean");
+        return r;
+    }
+    obj = *val;
+    return ValidationResult();
+}
+
+// Strings, with any allocator
+template <typename S>
+ValidationResult readString(S& obj, Node* node)
+{
+    std::string scratch;
+    auto val = node->asStringView(scratch);
+    if (!val)
+    {
+        ValidationResult r;
+        r.addError("", "Expected string");
+        return r;
+    }
+    useArena(obj);
+    obj.assign(val->data(), val->size());
+    return ValidationResult();
+}
+
+template <> inline ValidationResult from(std::string& obj, Node* node)
+{
+    return readString(obj, node);
+}
+
+template <StringType S>
+    requires(!std::is_same_v<S, std::string>)
+ValidationResult from(S& obj, Node* node)
+{
+    return readString(obj, node);
+}
+
+// Borrowed strings and blobs point into the input buffer, so they're only
+// valid while it is. Strings the document had to decode (escaped JSON) or
+// copy (YAML) can't be borrowed and are reported instead.
+inline ValidationResult readSourceView(std::string_view& out, Node* node)
+{
+    ValidationResult r;
+    if (auto v = node->asSourceView())
+        out = *v;
+    else if (std::string scratch; node->asStringView(scratch))
+        r.addError("", "String is not stored verbatim in the input; read it into a std::string");
+    else
+        r.addError("", "Expected string");
+    return r;
+}
+
+inline ValidationResult from(std::string_view& obj, Node* node)
+{
+    return readSourceView(obj, node);
+}
+
+inline ValidationResult from(std::span<const std::byte>& obj, Node* node)
+{
+    std::string_view v;
+    ValidationResult r = readSourceView(v, node);
+    if (r.valid)
+        obj = std::as_bytes(std::span(v.data(), v.size()));
+    return r;
+}
+
+// Enum
+template <RegisteredEnum EnumT>
+ValidationResult from(EnumT& obj, Node* node)
+{
+    auto str = node->asString();
+    if (!str)
+    {
+        ValidationResult r;
+        r.addError("", "Expected string for enum");
+        return r;
+    }
+
+    auto value = EnumMapping<EnumT>::Type::fromString(*str);
+    if (!value)
+    {
+        ValidationResult r;
+        std::string validVals = EnumMapping<EnumT>::Type::validValues();
+        r.addError("", "Unknown enum value: '" + *str + "'. Valid values are: " + validVals);
+        return r;
+    }
+    obj = *value;
+    return ValidationResult();
+}
+
+// Element i's errors, re-rooted under "[i]"
+inline void appendElementErrors(ValidationResult& result, size_t i, ValidationResult&& elem)
+{
+    char prefix[24] = "[";
+    auto r = std::to_chars(prefix + 1, prefix + sizeof(prefix) - 1, i);
+    *r.ptr++ = ']';
+    result.addErrorsUnder(std::string_view(prefix, static_cast<size_t>(r.ptr - prefix)), std::move(elem));
+}
+
+inline void appendElementErrors(ValidationResult& result, size_t i, const ValidationResult& elem)
+{
+    appendElementErrors(result, i, ValidationResult(elem));
+}
+
+// Vector
+template <typename T, typename A>
+ValidationResult from(std::vector<T, A>& obj, Node* node)
+{
+    if (!node->isSequence())
+    {
+        ValidationResult r;
+        r.addError("", "Expected sequence");
+        return r;
+    }
+
+    useArena(obj);
+    obj.clear();
+    obj.reserve(node->size());
+    ValidationResult result;
+    const size_t count = node->size();
+    NodeCursor child;
+    for (size_t i = 0; i < count; ++i)
+    {
+        T elem = makeElement<T>(obj.get_allocator());
+        auto elemResult = from(elem, node->at(i, child));
+        if (!elemResult.valid)
+        {
+            appendElementErrors(result, i, std::move(elemResult));
+            if (FailFast::active())
+                break;
+        }
+        else
+        {
+            obj.push_back(std::move(elem));
+        }
+    }
+    return result;
+}
+
+// Deque
+template <typename T, typename A>
+ValidationResult from(std::deque<T, A>& obj, Node* node)
+{
+    if (!node->isSequence())
+    {
+        ValidationResult r;
+        r.addError("", "Expected sequence");
+        return r;
+    }
+
+    useArena(obj);
+    obj.clear();
+    ValidationResult result;
+    const size_t count = node->size();
+    NodeCursor child;
+    for (size_t i = 0; i < count; ++i)
+    {
+        T elem = makeElement<T>(obj.get_allocator());
+        auto elemResult = from(elem, node->at(i, child));
+        if (!elemResult.valid)
+        {
+            appendElementErrors(result, i, std::move(elemResult));
+            if (FailFast::active())
+                break;
+        }
+        else
+        {
+            obj.push_back(std::move(elem));
+        }
+    }
+    return result;
+}
+
+// Set
+template <typename T, typename C, typename A>
+ValidationResult from(std::set<T, C, A>& obj, Node* node)
+{
+    if (!node->isSequence())
+    {
+        ValidationResult r;
+        r.addError("", "Expected sequence");
+        return r;
+    }
+
+    useArena(obj);
+    obj.clear();
+    ValidationResult result;
+    const size_t count = node->size();
+    NodeCursor child;
+    for (size_t i = 0; i < count; ++i)
+    {
+        T elem = makeElement<T>(obj.get_allocator());
+        auto elemResult = from(elem, node->at(i, child));
+        if (!elemResult.valid)
+        {
+            appendElementErrors(result, i, std::move(elemResult));
+            if (FailFast::active())
+                break;
+        }
+        else
+        {
+            obj.insert(std::move(elem));
+        }
+    }
+    return result;
+}
+
+// An integer map key: the whole key must be the number. A leading '+' is
+// taken, as std::stoi did; whitespace and trailing characters are not.
+template <typename K>
+bool parseIntegerKey(std::string_view k, K& key)
+{
+    if (k.size() > 1 && k[0] == '+' && k[1] != '-')
+        k.remove_prefix(1);
+    auto [ptr, ec] = std::from_chars(k.data(), k.data() + k.size(), key);
+    return ec == std::errc() && ptr == k.data() + k.size();
+}
+
+// Map
+template <typename K, typename V, typename C, typename A>
+ValidationResult from(std::map<K, V, C, A>& obj, Node* node)
+{
+    if (!node->isMap())
+    {
+        ValidationResult r;
+        r.addError("", "Expected map");
+        return r;
+    }
+
+    useArena(obj);
+    obj.clear();
+    ValidationResult result;
+    node->forEachEntry([&](std::string_view k, Node* valueNode)
+    {
+        K key = makeElement<K>(obj.get_allocator());
+        if constexpr (StringType<K>)
+        {
+            key.assign(k.data(), k.size());
+        }
+        else if constexpr (std::is_integral_v<K>)
+        {
+            if (!parseIntegerKey(k, key))
+            {
+                result.addError(k, "Invalid key format");
+                return !FailFast::active();
+            }
+        }
+
+        V value = makeElement<V>(obj.get_allocator());
+        auto valueResult = from(value, valueNode);
+        if (!valueResult.valid)
+        {
+            result.addErrorsUnder(k, std::move(valueResult));
+            return !FailFast::active();
+        }
+        obj[std::move(key)] = std::move(value);
+        return true;
+    });
+    return result;
+}
+
+// Unordered map
+template <typename K, typename V, typename H, typename E, typename A>
+ValidationResult from(std::unordered_map<K, V, H, E, A>& obj, Node* node)
+{
+    if (!node->isMap())
+    {
+        ValidationResult r;
+        r.addError("", "Expected map");
+        return r;
+    }
+
+    useArena(obj);
+    obj.clear();
+    ValidationResult result;
+    node->forEachEntry([&](std::string_view k, Node* valueNode)
+    {
+        K key = makeElement<K>(obj.get_allocator());
+        if constexpr (StringType<K>)
+        {
+            key.assign(k.data(), k.size());
+        }
+        else if constexpr (std::is_integral_v<K>)
+        {
+            if (!parseIntegerKey(k, key))
+            {
+                result.addError(k, "Invalid key format");
+                return !FailFast::active();
+            }
+        }
+
+        V value = makeElement<V>(obj.get_allocator());
+        auto valueResult = from(value, valueNode);
+        if (!valueResult.valid)
+        {
+            result.addErrorsUnder(k, std::move(valueResult));
+            return !FailFast::active();
+        }
+        obj[std::move(key)] = std::move(value);
+        return true;
+    });
+    return result;
+}
+
+
+template <typename T>
+ValidationResult from(std::optional<T>& obj, Node* node)
+{
+    if (node->isNull())
+    {
+        obj = std::nullopt;
+        return ValidationResult();
+    }
+
+    T value{};
+    auto result = from(value, node);
+    if (result.valid)
+        obj = std::move(value);
+    return result;
+}
+
+
+// Tagged variant: look the alternative up by tag and parse only that one
+template <typename... Types, size_t... I>
+ValidationResult fromTaggedVariant(std::variant<Types...>& obj, Node* node, std::index_sequence<I...>)
+{
+    using V = std::variant<Types...>;
+    constexpr auto& names = VariantTags<V>::names;
+    static_assert(std::size(names) == sizeof...(Types), "VariantTags needs one name per alternative");
+    constexpr std::string_view tagKey = variantTagKey<V>();
+    constexpr std::string_view valueKey = variantValueKey<V>();
+
+    ValidationResult result;
+    if (!node->isMap())
+    {
+        result.addError("", "Expected map for tagged variant");
+        return result;
+    }
+
+    NodeCursor tagCursor;
+    Node* tagNode = node->at(tagKey, tagCursor);
+    std::optional<std::string> tag = tagNode ? tagNode->asString() : std::nullopt;
+    if (!tag)
+    {
+        result.addError(tagKey, "Missing variant tag");
+        return result;
+    }
+
+    size_t index = sizeof...(Types);
+    for (size_t i = 0; i < std::size(names) && index == sizeof...(Types); ++i)
+        if (std::string_view(names[i]) == *tag)
+            index = i;
+    if (index == sizeof...(Types))
+    {
+        std::string validVals;
+        for (std::string_view name : names)
+            validVals += (validVals.empty() ? "" : ", ") + std::string(name);
+        result.addError(tagKey, "Unknown variant tag: '" + *tag + "'. Valid tags are: " + validVals);
+        return result;
+    }
+
+    NodeCursor valueCursor;
+    Node* valueNode = node->at(valueKey, valueCursor);
+    using Reader = ValidationResult (*)(V&, Node*);
+    static constexpr Reader readers[] = {[](V& v, Node* n) -> ValidationResult
+    {
+        using Alt = std::variant_alternative_t<I, V>;
+        if constexpr (std::is_same_v<Alt, std::monostate>)
+        {
+            v.template emplace<I>();
+            return ValidationResult();
+        }
+        else
+        {
+            ValidationResult r;
+            if (!n)
+            {
+                r.addError(variantValueKey<V>(), "Missing variant value");
+                return r;
+            }
+            Alt value{};
+            auto parsed = from(value, n);
+            if (parsed.valid)
+                v.template emplace<I>(std::move(value));
+            r.addErrorsUnder(variantValueKey<V>(), std::move(parsed));
+            return r;
+        }
+    }...};
+    return readers[index](obj, valueNode);
+}
+
+template <typename... Types>
+ValidationResult from(std::variant<Types...>& obj, Node* node)
+{
+    if constexpr (TaggedVariant<std::variant<Types...>>)
+        return fromTaggedVariant(obj, node, std::index_sequence_for<Types...>{});
+    else
+    {
+        ValidationResult result;
+        bool success = false;
+
+        // Try each type in order until one succeeds. A failed attempt's
+        // errors are dropped, so it stops at its first one.
+        auto try_parse = [&]<typename T>() {
+            if (success) return;
+
+            T value{};
+            FailFast quick;
+            auto parse_result = from(value, node);
+            if (parse_result.valid) {
+                obj = std::move(value);
+                success = true;
+            }
+        };
+
+        (try_parse.template operator()<Types>(), ...);
+
+        if (!success) {
+            result.addError("", "Could not parse as any variant type");
+        }
+
+        return result;
+    }
+}
+
+// Pair
+template <typename K, typename V>
+ValidationResult from(std::pair<K, V>& obj, Node* node)
+{
+    if (!node->isSequence() || node->size() != 2)
+    {
+        ValidationResult r;
+        r.addError("", "Expected 2-element sequence for pair");
+        return r;
+    }
+
+    ValidationResult result;
+    NodeCursor child;
+    result.addErrorsUnder("[0]", from(obj.first, node->at(0, child)));
+    if (FailFast::stop(result))
+        return result;
+    result.addErrorsUnder("[1]", from(obj.second, node->at(1, child)));
+    return result;
+}
+
+// Tuple
+template <typename... Args>
+ValidationResult from(std::tuple<Args...>& obj, Node* node)
+{
+    constexpr size_t N = sizeof...(Args);
+    if (!node->isSequence() || node->size() != N)
+    {
+        ValidationResult r;
+        r.addError("", "Expected " + std::to_string(N) + "-element sequence for tuple");
+        return r;
+    }
+
+    ValidationResult result;
+    size_t idx = 0;
+    NodeCursor child;
+    std::apply(
+        [&](auto&... args)
+        {
+            (..., [&](auto& arg)
+             {
+                 if (FailFast::stop(result))
+                     return;
+                 auto elemResult = from(arg, node->at(idx, child));
+                 if (!elemResult.valid)
+                     appendElementErrors(result, idx, std::move(elemResult));
+                 idx++;
+             }(args));
+        },
+        obj);
+    return result;
+}
+
+// Run a field's validation attributes (BoundsCheck, StringLength,
+// Whitelist, etc.) against its value; true when all of them pass. With
+// Report, failures are added to *result; without, nothing is formatted.
+template <bool Report, typename V, typename FieldT>
+bool checkFieldAttributes(const V& value, const FieldT& field, ValidationResult* result)
+{
+    bool ok = true;
+    std::apply([&](auto&&... attrs) {
+        (..., [&](auto& attr) {
+            using AttrType = std::decay_t<decltype(attr)>;
+            if constexpr (requires { { AttrType::check(value) } -> std::convertible_to<bool>; AttrType::message(value); }) {
+                bool passed = AttrType::check(value);
+                if constexpr (Report) {
+                    if (!passed)
+                        result->addError(field.fieldName, AttrType::message(value));
+                }
+                ok &= passed;
+            }
+            // Attributes with only a validate() method
+            else if constexpr (requires { AttrType::validate(value, std::declval<std::string&>()); }) {
+                std::string error;
+                bool passed = AttrType::validate(value, error);
+                if constexpr (Report) {
+                    if (!passed)
+                        result->addError(field.fieldName, error);
+                }
+                ok &= passed;
+            }
+        }(attrs));
+    }, field.attributes);
+    return ok;
+}
+
+// The same against the value just read into obj
+template <typename T, typename FieldT>
+void validateFieldAttributes(const T& obj, const FieldT& field, ValidationResult& result)
+{
+    checkFieldAttributes<true>(obj.*(field.memberPtr), field, &result);
+}
+
+// Deserialize one field from its document node and validate it
+template <typename T, typename FieldT>
+void readFieldValue(T& obj, const FieldT& field, Node* fieldNode, ValidationResult& result)
+{
+    auto fieldResult = from(obj.*(field.memberPtr), fieldNode);
+    if (!fieldResult.valid)
+    {
+        result.addErrorsUnder(field.fieldName, std::move(fieldResult));
+        if (FailFast::active())
+            return;
+    }
+    validateFieldAttributes(obj, field, result);
+}
+
+template <typename T, typename FieldT>
+void readField(T& obj, const FieldT& field, Node* fieldNode, ValidationResult& result)
+{
+    if constexpr (HasProbe<T>)
+    {
+        probed<typename Instrumented<T>::Probe>({ProbeWalk::Read, type_name<T>(), field.fieldName}, [&](ProbeEvent& e)
+        {
+            size_t before = result.errors.size();
+            readFieldValue(obj, field, fieldNode, result);
+            e.nodes = fieldNode->subtreeSize();
+            e.errors = result.errors.size() - before;
+        });
+    }
+    else
+        readFieldValue(obj, field, fieldNode, result);
+}
+
+// Runs read() for a whole T between T's type events
+template <HasProbe T, typename F>
+ValidationResult probedRead(Node* node, F&& read)
+{
     ValidationResult result;
-    for (const auto& k : node->keys())
+    probed<typename Instrumented<T>::Probe>({ProbeWalk::Read, type_name<T>(), {}}, [&](ProbeEvent& e)
+    {
+        result = read();
+        e.nodes = node->subtreeSize();
+        e.errors = result.errors.size();
+    });
+    return result;
+}
+
+template <HasFields T>
+ValidationResult readStruct(T& obj, Node* node);
+
+template <typename T>
+struct KeyDispatch;
+
+// Structs with fields
+template <HasFields T>
+ValidationResult from(T& obj, Node* node)
+{
+    if constexpr (HasProbe<T>)
+        return probedRead<T>(node, [&] { return readStruct(obj, node); });
+    else
+        return readStruct(obj, node);
+}
+
+template <HasFields T>
+ValidationResult readStruct(T& obj, Node* node)
+{
+    if constexpr (requires { typename T::Deser; })
+    {
+        return T::Deser::read(obj, node);
+    }
+    else if constexpr (unknownFieldsOf<T>() != UnknownFields::Ignore)
+    {
+        // Looking fields up would never see the keys that aren't fields
+        return KeyDispatch<T>::read(obj, node);
+    }
+    else
+    {
+        if (!node->isMap())
+        {
+            ValidationResult r;
+            r.addError("", "Expected map for struct");
+            return r;
+        }
+
+        ValidationResult result;
+        NodeCursor child;
+        const KeyNames names = node->keyNames();
+        std::apply(
+            [&](auto&&... fields)
+            {
+                (..., [&](auto& field)
+                 {
+                     if (FailFast::stop(result))
+                         return;
+                     Node* fieldNode = node->at(keyName(field, names), child);
+                     if (!fieldNode)
+                     {
+                         if (field.requirement == Requirement::Required)
+                             result.addError(field.fieldName, "Missing required field");
+                         return;
+                     }
+                     readField(obj, field, fieldNode, result);
+                 }(fields));
+            },
+            get_fields<T>());
+        return result;
+    }
+}
+
+// Key-dispatch deserializer for wide structs. Instead of looking every
+// declared field up in the document, it walks the document's keys once and
+// jumps straight to the matching member through FieldIndex<T>. Keys that
+// are not fields go to T's UnknownFieldPolicy; with none, they are skipped
+// or, with reportUnknown, listed as errors that leave the result valid.
+// Opt in per type:
+//
+//   struct Telemetry {
+//       ...
+//       static constexpr auto FieldsMeta = std::make_tuple(...);
+//       using Deser = meta::KeyDispatch<Telemetry>;
+//   };
+template <typename T>
+struct KeyDispatch
+{
+    using Handler = void (*)(T&, Node*, ValidationResult&);
+
+    template <size_t I>
+    static void readAt(T& obj, Node* fieldNode, ValidationResult& result)
     {
-        K key;
-        if constexpr (std::is_same_v<K, std::string>)
+        readField(obj, std::get<I>(get_fields<T>()), fieldNode, result);
+    }
+
+    template <size_t... I>
+    static constexpr std::array<Handler, sizeof...(I)> makeHandlers(std::index_sequence<I...>)
+    {
+        return {&readAt<I>...};
+    }
+
+    static ValidationResult read(T& obj, Node* node, bool reportUnknown = false)
+    {
+        static_assert(HasFields<T>, "KeyDispatch requires T::FieldsMeta or meta::MetaTuple<T>::FieldsMeta");
+        constexpr size_t count = field_count_v<T>;
+        static constexpr auto handlers = makeHandlers(std::make_index_sequence<count>{});
+
+        if (!node->isMap())
         {
-            key = k;
+            ValidationResult r;
+            r.addError("", "Expected map for struct");
+            return r;
         }
-        else if constexpr (std::is_integral_v<K>)
+
+        ValidationResult result;
+        std::array<bool, count> seen{};
+        node->forEachEntry([&](std::string_view key, Node* value)
         {
-            try { key = static_cast<K>(std::stoi(k)); }
-            catch (...)
+            int idx = findField<T>(key, node);
+            if (idx < 0)
             {
-                result.addError(k, "Invalid key format");
-                continue;
+                unknownField<T>(key, result, reportUnknown);
+                return !FailFast::stop(result);
             }
+            seen[idx] = true;
+            handlers[idx](obj, value, result);
+            return !FailFast::stop(result);
+        });
+        if (FailFast::stop(result))
+            return result;
+
+        size_t i = 0;
+        std::apply([&](auto&&... fields) {
+            (..., [&](auto& field) {
+                if (!seen[i++] && field.requirement == Requirement::Required)
+                    result.addError(field.fieldName, "Missing required field");
+            }(fields));
+        }, get_fields<T>());
+        return result;
+    }
+};
+
+// Catch-all for structs without metadata - gives compile-time error instead of linker error
+template <StructWithoutMetadata T>
+ValidationResult from(T& obj, Node* node)
+{
+    static_assert(HasFields<T>,
+                  "ERROR: Type must have T::FieldsMeta or meta::MetaTuple<T>::FieldsMeta defined");
+    return ValidationResult{};
+}
+
+//============================================================
+// SERIALIZATION (to)
+//============================================================
+
+// Declared up front so the container overloads find each other through
+// ordinary lookup, not only ADL, when B lives outside namespace meta
+template <IntegerType T, BuilderLike B> void to(const T& obj, B& b);
+template <FloatingPointType T, BuilderLike B> void to(const T& obj, B& b);
+template <BuilderLike B> void to(const bool& obj, B& b);
+template <BuilderLike B> void to(const std::string& obj, B& b);
+template <StringType S, BuilderLike B> requires(!std::is_same_v<S, std::string>) void to(const S& obj, B& b);
+template <BuilderLike B> void to(const std::string_view& obj, B& b);
+template <BuilderLike B> void to(const std::span<const std::byte>& obj, B& b);
+template <RegisteredEnum EnumT, BuilderLike B> void to(const EnumT& obj, B& b);
+template <typename T, typename A, BuilderLike B> void to(const std::vector<T, A>& obj, B& b);
+template <typename T, typename A, BuilderLike B> void to(const std::deque<T, A>& obj, B& b);
+template <typename T, typename C, typename A, BuilderLike B> void to(const std::set<T, C, A>& obj, B& b);
+template <typename K, typename V, typename C, typename A, BuilderLike B> void to(const std::map<K, V, C, A>& obj, B& b);
+template <typename K, typename V, typename H, typename E, typename A, BuilderLike B>
+void to(const std::unordered_map<K, V, H, E, A>& obj, B& b);
+template <typename T, BuilderLike B> void to(const std::optional<T>& obj, B& b);
+template <typename... Types, BuilderLike B> void to(const std::variant<Types...>& obj, B& b);
+template <typename K, typename V, BuilderLike B> void to(const std::pair<K, V>& obj, B& b);
+template <typename... Args, BuilderLike B> void to(const std::tuple<Args...>& obj, B& b);
+template <HasFields T, BuilderLike B> void to(const T& obj, B& b);
+template <BuilderLike B> void to(const std::filesystem::path& obj, B& b);
+
+// Primitive integer types - int when T fits in one, otherwise the 64-bit
+// events (or, for a static builder without them, Builder's fallback)
+template <IntegerType T, BuilderLike B>
+void to(const T& obj, B& b)
+{
+    if constexpr (fitsInInt<T>)
+        b.writeInt(static_cast<int>(obj));
+    else if constexpr (std::is_signed_v<T> && requires { b.writeInt64(int64_t{}); })
+        b.writeInt64(static_cast<int64_t>(obj));
+    else if constexpr (std::is_unsigned_v<T> && requires { b.writeUInt64(uint64_t{}); })
+        b.writeUInt64(static_cast<uint64_t>(obj));
+    else if (std::in_range<int>(static_cast<StandardInteger<T>>(obj)))
+        b.writeInt(static_cast<int>(obj));
+    else
+        b.writeDouble(static_cast<double>(obj));
+}
+
+// Floating point types. A float is widened through its shortest decimal
+// form so 0.1f writes as 0.1 rather than 0.10000000149011612.
+template <FloatingPointType T, BuilderLike B>
+void to(const T& obj, B& b)
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        char buf[32];
+        auto r = std::to_chars(buf, buf + sizeof(buf), obj);
+        double wide = obj;
+        std::from_chars(buf, r.ptr, wide);
+        b.writeDouble(wide);
+    }
+    else
+        b.writeDouble(static_cast<double>(obj));
+}
+
+// Bool
+template <BuilderLike B>
+void to(const bool& obj, B& b)
+{
+    b.writeBool(obj);
+}
+
+// String
+template <BuilderLike B>
+void to(const std::string& obj, B& b)
+{
+    b.writeString(obj);
+}
+
+template <StringType S, BuilderLike B>
+    requires(!std::is_same_v<S, std::string>)
+void to(const S& obj, B& b)
+{
+    b.writeString(std::string(obj.data(), obj.size()));
+}
+
+template <BuilderLike B>
+void to(const std::string_view& obj, B& b)
+{
+    b.writeString(std::string(obj));
+}
+
+// A blob is written as a string of its bytes
+template <BuilderLike B>
+void to(const std::span<const std::byte>& obj, B& b)
+{
+    b.writeString(std::string(reinterpret_cast<const char*>(obj.data()), obj.size()));
+}
+
+// Enum
+template <RegisteredEnum EnumT, BuilderLike B>
+void to(const EnumT& obj, B& b)
+{
+    b.writeString(EnumMapping<EnumT>::Type::toString(obj));
+}
+
+// Vector
+template <typename T, typename A, BuilderLike B>
+void to(const std::vector<T, A>& obj, B& b)
+{
+    b.startSeq(typeid(T).name());
+    for (const auto& e : obj)
+        to(e, b);
+    b.endSeq();
+}
+
+// Deque
+template <typename T, typename A, BuilderLike B>
+void to(const std::deque<T, A>& obj, B& b)
+{
+    b.startSeq(typeid(T).name());
+    for (const auto& e : obj)
+        to(e, b);
+    b.endSeq();
+}
+
+// Set
+template <typename T, typename C, typename A, BuilderLike B>
+void to(const std::set<T, C, A>& obj, B& b)
+{
+    b.startSeq(typeid(T).name());
+    for (const auto& e : obj)
+        to(e, b);
+    b.endSeq();
+}
+
+// Map
+template <typename K, typename V, typename C, typename A, BuilderLike B>
+void to(const std::map<K, V, C, A>& obj, B& b)
+{
+    b.startMap(typeid(V).name());
+    for (const auto& [k, v] : obj)
+    {
+        if constexpr (std::is_same_v<K, std::string>)
+        {
+            b.key(k);
+        }
+        else if constexpr (StringType<K>)
+        {
+            b.key(std::string(k.data(), k.size()));
+        }
+        else if constexpr (std::is_integral_v<K>)
+        {
+            b.key(std::to_string(k));
         }
+        to(v, b);
+    }
+    b.endMap();
+}
 
-        V value{};
-        auto valueResult = from(value, node->at(k).get());
-        if (!valueResult.valid)
+// Unordered map
+template <typename K, typename V, typename H, typename E, typename A, BuilderLike B>
+void to(const std::unordered_map<K, V, H, E, A>& obj, B& b)
+{
+    b.startMap(typeid(V).name());
+    for (const auto& [k, v] : obj)
+    {
+        if constexpr (std::is_same_v<K, std::string>)
+        {
+            b.key(k);
+        }
+        else if constexpr (StringType<K>)
+        {
+            b.key(std::string(k.data(), k.size()));
+        }
+        else if constexpr (std::is_integral_v<K>)
         {
-            for (auto& [f, e] : valueResult.errors)
-                result.addError(k + (f.empty() ? "" : "." + f), e);
+            b.key(std::to_string(k));
         }
+        to(v, b);
+    }
+    b.endMap();
+}
+
+// Optional
+template <typename T, BuilderLike B>
+void to(const std::optional<T>& obj, B& b)
+{
+    if (obj)
+        to(*obj, b);
+    else
+        b.writeNull();
+}
+
+// Variant
+template <typename... Types, BuilderLike B>
+void to(const std::variant<Types...>& obj, B& b)
+{
+    using V = std::variant<Types...>;
+    if constexpr (TaggedVariant<V>)
+    {
+        std::visit([&b, index = obj.index()](const auto& value) {
+            b.startMap();
+            b.key(std::string(variantTagKey<V>()));
+            b.writeString(std::string(VariantTags<V>::names[index]));
+            if constexpr (!std::is_same_v<std::decay_t<decltype(value)>, std::monostate>)
+            {
+                b.key(std::string(variantValueKey<V>()));
+                to(value, b);
+            }
+            b.endMap();
+        }, obj);
+    }
+    else
+    {
+        std::visit([&b](const auto& value) {
+            to(value, b);
+        }, obj);
+    }
+}
+
+// Pair
+template <typename K, typename V, BuilderLike B>
+void to(const std::pair<K, V>& obj, B& b)
+{
+    b.startFlowSeq();
+    to(obj.first, b);
+    to(obj.second, b);
+    b.endFlowSeq();
+}
+
+// Tuple
+template <typename... Args, BuilderLike B>
+void to(const std::tuple<Args...>& obj, B& b)
+{
+    b.startFlowSeq();
+    std::apply([&b](const auto&... args)
+               { (..., [&b](const auto& arg) { to(arg, b); }(args)); },
+               obj);
+    b.endFlowSeq();
+}
+
+template <HasFields T, BuilderLike B>
+void writeStruct(const T& obj, B& b);
+
+// Structs with fields
+template <HasFields T, BuilderLike B>
+void to(const T& obj, B& b)
+{
+    if constexpr (HasProbe<T>)
+    {
+        probed<typename Instrumented<T>::Probe>({ProbeWalk::Write, type_name<T>(), {}}, [&](ProbeEvent& e)
+        {
+            size_t before = probeBytes(b);
+            writeStruct(obj, b);
+            e.bytes = probeBytes(b) - before;
+        });
+    }
+    else
+        writeStruct(obj, b);
+}
+
+template <HasFields T, BuilderLike B>
+void writeStruct(const T& obj, B& b)
+{
+    if constexpr (requires { typename T::Ser; })
+    {
+        // Hooks written against the virtual interface still get a Builder*
+        if constexpr (requires { T::Ser::write(obj, b); })
+            T::Ser::write(obj, b);
+        else
+            T::Ser::write(obj, static_cast<Builder*>(&b));
+    }
+    else
+    {
+        b.startMap("");
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (..., [&]
+             {
+                 const auto& field = std::get<I>(get_fields<T>());
+                 const FieldKey k{field.fieldName, JsonKeys<T>::fragment(I)};
+                 if constexpr (requires { b.fieldKey(k); })
+                     b.fieldKey(k);
+                 else
+                     b.key(std::string(k.name));
+                 if constexpr (HasProbe<T>)
+                 {
+                     probed<typename Instrumented<T>::Probe>({ProbeWalk::Write, type_name<T>(), field.fieldName},
+                                                             [&](ProbeEvent& e)
+                     {
+                         size_t before = probeBytes(b);
+                         to(obj.*(field.memberPtr), b);
+                         e.bytes = probeBytes(b) - before;
+                     });
+                 }
+                 else
+                     to(obj.*(field.memberPtr), b);
+             }());
+        }(std::make_index_sequence<field_count_v<T>>{});
+        b.endMap();
+    }
+}
+
+// Catch-all for structs without metadata - gives compile-time error instead of linker error
+template <StructWithoutMetadata T, BuilderLike B>
+void to(const T& obj, B& b)
+{
+    static_assert(HasFields<T>,
+                  "ERROR: Type must have T::FieldsMeta or meta::MetaTuple<T>::FieldsMeta defined");
+}
+
+// Filesystem path support
+template <> inline ValidationResult from(std::filesystem::path& obj, Node* node)
+{
+    auto str = node->asString();
+    if (!str)
+    {
+        ValidationResult r;
+        r.addError("path", "Must be string");
+        return r;
+    }
+    obj = std::filesystem::path(*str);
+    return ValidationResult();
+}
+
+template <BuilderLike B>
+void to(const std::filesystem::path& obj, B& b)
+{
+    b.writeString(obj.string());
+}
+
+// Type-erased entry point: the format is chosen at run time and every
+// event goes through Builder's vtable
+template <typename T>
+void to(const T& obj, Builder* b)
+{
+    to(obj, *b);
+}
+
+//============================================================
+// PUBLIC API
+//============================================================
+
+
+// Reads a whole YAML document into obj. A struct's keys are walked once:
+// each one is read into its field as it comes, keys that are not fields
+// go to T's UnknownFieldPolicy or, without one, are listed (the result
+// stays valid), and required fields never seen are missing. Types with
+// their own Deser check unknown keys up front.
+template <typename T>
+concept CustomDeser = requires { typename T::Deser; } && !std::is_same_v<typename T::Deser, KeyDispatch<T>>;
+
+template <typename T>
+ValidationResult readYamlDocument(T& obj, Node* root)
+{
+    if constexpr (HasFields<T> && !CustomDeser<T>)
+    {
+        if (!root->isMap())
+            return from(obj, root);
+        if constexpr (HasProbe<T>)
+            return probedRead<T>(root, [&] { return KeyDispatch<T>::read(obj, root, true); });
         else
+            return KeyDispatch<T>::read(obj, root, true);
+    }
+    else
+    {
+        ValidationResult unknown;
+        if constexpr (HasFields<T>)
+            root->forEachEntry([&](std::string_view key, Node*)
+            {
+                if (findField<T>(key, root) < 0)
+                    unknownField<T>(key, unknown, true);
+            });
+        ValidationResult result = from(obj, root);
+        if (!unknown.errors.empty())
         {
-            obj[key] = std::move(value);
+            result.errors.insert(result.errors.begin(), unknown.errors.begin(), unknown.errors.end());
+            result.valid = result.valid && unknown.valid;
         }
+        return result;
     }
-    return result;
 }
 
+// Builds a {optional<T>, ValidationResult} result in place: T is
+// constructed inside the optional, filled by read(obj) and dropped again
+// when invalid, so the parsed object is never copied or moved
+template <typename T, typename F>
+std::pair<std::optional<T>, ValidationResult> readInPlace(F&& read)
+{
+    std::pair<std::optional<T>, ValidationResult> out;
+    out.second = read(out.first.emplace());
+    if (!out.second.valid)
+        out.first.reset();
+    return out;
+}
+
+// The T& overloads read into an existing object, so a long-lived config
+// can be reloaded into the containers it already has. Keys absent from
+// the document leave their members as they were, and a failed read may
+// leave obj partly updated.
+template <typename T>
+ValidationResult reifyFromYaml(T& obj, const YAML::Node& node)
+{
+    try
+    {
+        YamlNode root(node);
+        return readYamlDocument(obj, &root);
+    }
+    catch (const std::exception& e)
+    {
+        ValidationResult result;
+        result.addError("yaml", std::string(e.what()));
+        return result;
+    }
+}
+
+template <typename T>
+ValidationResult reifyFromYaml(T& obj, const YamlDocument& doc)
+{
+    YamlDocumentNode root(doc, 0);
+    return readYamlDocument(obj, &root);
+}
+
+// Parses straight from yaml-cpp's event stream; no YAML::Node is built
+template <typename T>
+ValidationResult reifyFromYaml(T& obj, std::string_view yaml)
+{
+    try
+    {
+        YamlDocument doc(yaml);
+        return reifyFromYaml(obj, doc);
+    }
+    catch (const std::exception& e)
+    {
+        ValidationResult result;
+        result.addError("yaml", std::string(e.what()));
+        return result;
+    }
+}
+
+template <typename T>
+std::pair<std::optional<T>, ValidationResult> reifyFromYaml(const YAML::Node& node)
+{
+    return readInPlace<T>([&](T& obj) { return reifyFromYaml(obj, node); });
+}
+
+template <typename T>
+std::pair<std::optional<T>, ValidationResult> reifyFromYaml(const YamlDocument& doc)
+{
+    return readInPlace<T>([&](T& obj) { return reifyFromYaml(obj, doc); });
+}
 
 template <typename T>
-ValidationResult from(std::optional<T>& obj, Node* node)
+std::pair<std::optional<T>, ValidationResult> reifyFromYaml(std::string_view yaml)
 {
-    if (node->isNull())
-    {
-        obj = std::nullopt;
-        return ValidationResult();
-    }
+    return readInPlace<T>([&](T& obj) { return reifyFromYaml(obj, yaml); });
+}
 
-    T value{};
-    auto result = from(value, node);
-    if (result.valid)
-        obj = std::move(value);
-    return result;
+// Every std::pmr string and container in the result is allocated from
+// resource (see ArenaScope)
+template <typename T>
+std::pair<std::optional<T>, ValidationResult> reifyFromYaml(std::string_view yaml, std::pmr::memory_resource* resource)
+{
+    ArenaScope arena(resource);
+    return reifyFromYaml<T>(yaml);
 }
 
+template <typename T> std::string toYaml(const T& obj)
+{
+    auto builder = BuilderPool<YamlBuilder>::lease();
+    to(obj, *builder);
+    return builder.take();
+}
 
-template <typename... Types>
-ValidationResult from(std::variant<Types...>& obj, Node* node)
+// Replaces out's contents, reusing its capacity: with a pooled builder,
+// serializing into the same string again doesn't allocate once both
+// have grown to the size of the documents
+template <typename T> void toYaml(const T& obj, std::string& out)
 {
-    ValidationResult result;
-    bool success = false;
-    
-    // Try each type in order until one succeeds
-    auto try_parse = [&]<typename T>() {
-        if (success) return;
-        
-        T value{};
-        auto parse_result = from(value, node);
-        if (parse_result.valid) {
-            obj = std::move(value);
-            success = true;
-        }
-    };
-    
-    (try_parse.template operator()<Types>(), ...);
-    
-    if (!success) {
-        result.addError("", "Could not parse as any variant type");
-    }
-    
-    return result;
+    auto builder = BuilderPool<YamlBuilder>::lease();
+    to(obj, *builder);
+    out.assign(builder->view());
 }
 
-// Pair
-template <typename K, typename V>
-ValidationResult from(std::pair<K, V>& obj, Node* node)
+template <typename T> void toYaml(const T& obj, OutputSink& sink)
 {
-    if (!node->isSequence() || node->size() != 2)
-    {
-        ValidationResult r;
-        r.addError("", "Expected 2-element sequence for pair");
-        return r;
-    }
+    YamlBuilder builder(sink);
+    to(obj, builder);
+    builder.finish();
+}
 
-    ValidationResult result;
-    auto firstResult = from(obj.first, node->at(0).get());
-    if (!firstResult.valid)
+template <typename T> std::string toJson(const T& obj)
+{
+    auto builder = BuilderPool<JsonBuilder>::lease();
+    to(obj, *builder);
+    return builder.take();
+}
+
+template <typename T> void toJson(const T& obj, std::string& out)
+{
+    auto builder = BuilderPool<JsonBuilder>::lease();
+    to(obj, *builder);
+    out.assign(builder->view());
+}
+
+template <typename T> void toJson(const T& obj, OutputSink& sink)
+{
+    JsonBuilder builder(sink);
+    to(obj, builder);
+    builder.finish();
+}
+
+// Output size for a batch, guessed from its first element; 0 when the
+// range can't be measured without consuming it
+template <typename R, typename Measure>
+size_t estimateBatchSize(R& objects, Measure&& measure)
+{
+    if constexpr (std::ranges::sized_range<R> && std::ranges::forward_range<R>)
     {
-        for (auto& [f, e] : firstResult.errors)
-            result.addError("[0]" + (f.empty() ? "" : "." + f), e);
+        size_t n = static_cast<size_t>(std::ranges::size(objects));
+        if (n == 0)
+            return 0;
+        size_t perElement = measure(*std::ranges::begin(objects));
+        return perElement * n + perElement * n / 8 + 64;
     }
+    else
+        return 0;
+}
 
-    auto secondResult = from(obj.second, node->at(1).get());
-    if (!secondResult.valid)
+// One JsonBuilder streams every element of any input range into sink,
+// laid out as "[\n  {...},\n  {...}\n]\n"
+template <std::ranges::input_range R>
+void serializeJson(R&& objects, OutputSink& sink)
+{
+    JsonBuilder builder(sink);
+    sink.write("[\n");
+    bool first = true;
+    for (const auto& obj : objects)
     {
-        for (auto& [f, e] : secondResult.errors)
-            result.addError("[1]" + (f.empty() ? "" : "." + f), e);
+        sink.write(first ? "  " : ",\n  ");
+        first = false;
+        builder.resetSeparator();
+        to(obj, builder);
     }
+    sink.write(first ? "]\n" : "\n]\n");
+    builder.finish();
+}
 
-    return result;
+template <std::ranges::input_range R>
+std::string serializeJson(R&& objects)
+{
+    StringSink sink;
+    sink.reserve(estimateBatchSize(objects, [](const auto& obj) { return toJson(obj).size() + 4; }));
+    serializeJson(objects, sink);
+    return sink.take();
 }
 
-// Tuple
-template <typename... Args>
-ValidationResult from(std::tuple<Args...>& obj, Node* node)
+template <typename T> std::string toXml(const T& obj)
 {
-    constexpr size_t N = sizeof...(Args);
-    if (!node->isSequence() || node->size() != N)
-    {
-        ValidationResult r;
-        r.addError("", "Expected " + std::to_string(N) + "-element sequence for tuple");
-        return r;
-    }
+    auto builder = BuilderPool<XmlBuilder>::lease();
+    to(obj, *builder);
+    builder->finish();
+    return builder.take();
+}
 
-    ValidationResult result;
-    size_t idx = 0;
-    std::apply(
-        [&](auto&... args)
-        {
-            (..., [&](auto& arg)
-             {
-                 auto elemResult = from(arg, node->at(idx).get());
-                 if (!elemResult.valid)
-                 {
-                     for (auto& [f, e] : elemResult.errors)
-                         result.addError("[" + std::to_string(idx) + "]" + (f.empty() ? "" : "." + f), e);
-                 }
-                 idx++;
-             }(args));
-        },
-        obj);
-    return result;
+template <typename T> void toXml(const T& obj, std::string& out)
+{
+    auto builder = BuilderPool<XmlBuilder>::lease();
+    to(obj, *builder);
+    builder->finish();
+    out.assign(builder->view());
 }
 
-// Structs with fields
-template <HasFields T>
-ValidationResult from(T& obj, Node* node)
+template <typename T> void toXml(const T& obj, OutputSink& sink)
 {
-    if constexpr (requires { typename T::Deser; })
-    {
-        return T::Deser::read(obj, node);
-    }
-    else
-    {
-        if (!node->isMap())
-        {
-            ValidationResult r;
-            r.addError("", "Expected map for struct");
-            return r;
-        }
+    XmlBuilder builder(sink);
+    to(obj, builder);
+    builder.finish();
+}
 
-        ValidationResult result;
+template <typename T> std::string toString(const T& obj)
+{
+    return toYaml(obj);
+}
+
+//============================================================
+// EXPLICIT INSTANTIATION
+//============================================================
+// Every TU that serializes a type instantiates the whole from/to tree for
+// it. To compile a type's serializers once instead, declare them extern
+// where the type is declared and instantiate them in a single TU, both at
+// global scope:
+//
+//   // config.h
+//   META_EXTERN_TEMPLATES(META_CORE_TEMPLATES, Config);
+//   META_EXTERN_TEMPLATES(META_JSON_TEMPLATES, Config);   // meta_json.h
+//
+//   // config.cpp
+//   META_INSTANTIATE_TEMPLATES(META_CORE_TEMPLATES, Config);
+//   META_INSTANTIATE_TEMPLATES(META_JSON_TEMPLATES, Config);
+//
+// Each format header defines a META_<FORMAT>_TEMPLATES list of its entry
+// points (META_JSON_, META_BINARY_, META_PROTO_, META_CSV_, META_DB_).
+// Only those entry points are covered: calling from()/to() or the batch
+// functions directly still instantiates them in the calling TU.
+#define META_EXTERN_TEMPLATES(list, ...) list(extern template, __VA_ARGS__)
+#define META_INSTANTIATE_TEMPLATES(list, ...) list(template, __VA_ARGS__)
+
+// toYaml, toJson, toXml and reifyFromYaml
+#define META_CORE_TEMPLATES(prefix, ...)                                                                              \
+    prefix std::string meta::toYaml<__VA_ARGS__>(const __VA_ARGS__&);                                                 \
+    prefix void meta::toYaml<__VA_ARGS__>(const __VA_ARGS__&, meta::OutputSink&);                                     \
+    prefix void meta::toYaml<__VA_ARGS__>(const __VA_ARGS__&, std::string&);                                          \
+    prefix std::string meta::toJson<__VA_ARGS__>(const __VA_ARGS__&);                                                 \
+    prefix void meta::toJson<__VA_ARGS__>(const __VA_ARGS__&, meta::OutputSink&);                                     \
+    prefix void meta::toJson<__VA_ARGS__>(const __VA_ARGS__&, std::string&);                                          \
+    prefix std::string meta::toXml<__VA_ARGS__>(const __VA_ARGS__&);                                                  \
+    prefix void meta::toXml<__VA_ARGS__>(const __VA_ARGS__&, meta::OutputSink&);                                      \
+    prefix void meta::toXml<__VA_ARGS__>(const __VA_ARGS__&, std::string&);                                           \
+    prefix meta::ValidationResult meta::reifyFromYaml<__VA_ARGS__>(__VA_ARGS__&, const YAML::Node&);                  \
+    prefix meta::ValidationResult meta::reifyFromYaml<__VA_ARGS__>(__VA_ARGS__&, const meta::YamlDocument&);          \
+    prefix meta::ValidationResult meta::reifyFromYaml<__VA_ARGS__>(__VA_ARGS__&, std::string_view);                   \
+    prefix std::pair<std::optional<__VA_ARGS__>, meta::ValidationResult> meta::reifyFromYaml<__VA_ARGS__>(            \
+        const YAML::Node&);                                                                                           \
+    prefix std::pair<std::optional<__VA_ARGS__>, meta::ValidationResult> meta::reifyFromYaml<__VA_ARGS__>(            \
+        const meta::YamlDocument&);                                                                                   \
+    prefix std::pair<std::optional<__VA_ARGS__>, meta::ValidationResult> meta::reifyFromYaml<__VA_ARGS__>(            \
+        std::string_view)
+
+//============================================================
+// POD LAYOUT
+//============================================================
+// A struct is PodLayout when it is trivially copyable and its listed fields
+// are arithmetic or enum values covering every byte of it (no padding, no
+// unlisted members), so the record is exactly its fields' bytes and can be
+// copied as memory instead of field by field (see BinaryPacked in
+// meta_binary.h).
+
+template <typename Fields>
+struct FieldsLayout;
+
+template <typename... F>
+struct FieldsLayout<std::tuple<F...>>
+{
+    static constexpr size_t bytes = (sizeof(typename std::remove_cvref_t<F>::MemberType) + ... + 0);
+    static constexpr bool scalar = ((std::is_arithmetic_v<typename std::remove_cvref_t<F>::MemberType> ||
+                                     std::is_enum_v<typename std::remove_cvref_t<F>::MemberType>) && ...);
+};
+
+template <typename T>
+using FieldsLayoutOf = FieldsLayout<std::remove_cvref_t<decltype(get_fields<T>())>>;
+
+template <typename T>
+concept PodLayout = HasFields<T> && std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> &&
+                    FieldsLayoutOf<T>::scalar && FieldsLayoutOf<T>::bytes == sizeof(T);
+
+// Whether the fields sit back to back in FieldsMeta order, so the record's
+// bytes are its fields in declaration order. Offsets aren't available at
+// compile time; this is worked out once per type.
+template <PodLayout T>
+bool podFieldsInOrder()
+{
+    static const bool inOrder = []
+    {
+        T probe{};
+        const char* base = reinterpret_cast<const char*>(&probe);
+        size_t expected = 0;
+        bool ok = true;
         std::apply(
             [&](auto&&... fields)
             {
                 (..., [&](auto& field)
                  {
-                     auto fieldNode = node->at(std::string(field.fieldName));
-                     if (!fieldNode)
-                     {
-                         if (field.requirement == Requirement::Required)
-                             result.addError(field.fieldName, "Missing required field");
-                         return;
-                     }
-                     auto fieldResult = from(obj.*(field.memberPtr), fieldNode.get());
-                     if (!fieldResult.valid)
-                         for (auto& [f, e] : fieldResult.errors)
-                             result.addError(std::string(field.fieldName) + (f.empty() ? "" : "." + f), e);
-                     
-                     // Run validation attributes (BoundsCheck, StringLength, Whitelist, etc.)
-                     std::apply([&](auto&&... attrs) {
-                         (..., [&](auto& attr) {
-                             using AttrType = std::decay_t<decltype(attr)>;
-                             // Check if this attribute has a validate() method
-                             if constexpr (requires { AttrType::validate(obj.*(field.memberPtr), std::declval<std::string&>()); }) {
-                                 std::string error;
-                                 if (!AttrType::validate(obj.*(field.memberPtr), error)) {
-                                     result.addError(field.fieldName, error);
-                                 }
-                             }
-                         }(attrs));
-                     }, field.attributes);
+                     const auto& member = probe.*(field.memberPtr);
+                     ok = ok && reinterpret_cast<const char*>(&member) - base == static_cast<std::ptrdiff_t>(expected);
+                     expected += sizeof(member);
                  }(fields));
             },
             get_fields<T>());
-        return result;
+        return ok;
+    }();
+    return inOrder;
+}
+
+//============================================================
+// HASHING AND COMPARISON
+//============================================================
+// meta::hash<T>, meta::equal and meta::less built from FieldsMeta, in
+// field order, skipping fields marked NotCompared:
+//
+//   std::unordered_set<Record, meta::hash<Record>, meta::EqualTo> seen;
+//   std::sort(rows.begin(), rows.end(), meta::less);
+//
+// Structs whose listed fields are integers and enums covering every byte
+// (no padding, nothing excluded) are hashed and compared as one block of
+// memory, as are vectors of them. Unordered containers hash the same in
+// any iteration order and have no ordering for less.
+
+constexpr uint64_t hashMix(uint64_t h, uint64_t v)
+{
+    h = (h ^ v) * 0xBF58476D1CE4E5B9ull;
+    return h ^ (h >> 31);
+}
+
+// Eight bytes at a time; the last (partial) word is read with fixed-size
+// loads that may overlap the previous one, mixed with the length
+inline uint64_t hashBytes(const void* data, size_t n, uint64_t h)
+{
+    const char* p = static_cast<const char*>(data);
+    uint64_t w = 0;
+    if (n > 8)
+    {
+        const char* last = p + n - 8;
+        for (; p < last; p += 8)
+        {
+            std::memcpy(&w, p, 8);
+            h = hashMix(h, w);
+        }
+        std::memcpy(&w, last, 8);
+    }
+    else if (n >= 4)
+    {
+        uint32_t lo, hi;
+        std::memcpy(&lo, p, 4);
+        std::memcpy(&hi, p + n - 4, 4);
+        w = lo | uint64_t{hi} << 32;
     }
+    else if (n > 0)
+        w = uint64_t{static_cast<unsigned char>(p[0])} | uint64_t{static_cast<unsigned char>(p[n / 2])} << 8 |
+            uint64_t{static_cast<unsigned char>(p[n - 1])} << 16;
+    return hashMix(hashMix(h, w), n);
 }
 
-// Catch-all for structs without metadata - gives compile-time error instead of linker error
-template <StructWithoutMetadata T>
-ValidationResult from(T& obj, Node* node)
+template <typename T> constexpr bool comparedAsBytes();
+
+template <typename FieldT>
+constexpr bool isCompared = !std::remove_cvref_t<FieldT>::template has<NotCompared>;
+
+template <typename Fields>
+struct ComparedLayout;
+
+template <typename... F>
+struct ComparedLayout<std::tuple<F...>>
 {
-    static_assert(HasFields<T>,
-                  "ERROR: Type must have T::FieldsMeta or meta::MetaTuple<T>::FieldsMeta defined");
-    return ValidationResult{};
+    static constexpr size_t bytes = (sizeof(typename std::remove_cvref_t<F>::MemberType) + ... + 0);
+    static constexpr bool asBytes =
+        ((isCompared<F> && comparedAsBytes<typename std::remove_cvref_t<F>::MemberType>()) && ...);
+};
+
+// True when two values are equal exactly when their bytes are
+template <typename T>
+constexpr bool comparedAsBytes()
+{
+    if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+        return std::has_unique_object_representations_v<T>;
+    else if constexpr (HasFields<T>)
+    {
+        using Layout = ComparedLayout<std::remove_cvref_t<decltype(get_fields<T>())>>;
+        return std::has_unique_object_representations_v<T> && Layout::bytes == sizeof(T) && Layout::asBytes;
+    }
+    else
+        return false;
 }
 
-//============================================================
-// SERIALIZATION (to)
-//============================================================
+template <typename T> uint64_t hashValue(const T& v, uint64_t h);
+template <StringType S> uint64_t hashValue(const S& v, uint64_t h);
+inline uint64_t hashValue(const std::string_view& v, uint64_t h);
+template <typename T, typename A> uint64_t hashValue(const std::vector<T, A>& v, uint64_t h);
+template <typename T, typename A> uint64_t hashValue(const std::deque<T, A>& v, uint64_t h);
+template <typename T, typename C, typename A> uint64_t hashValue(const std::set<T, C, A>& v, uint64_t h);
+template <typename K, typename V, typename C, typename A> uint64_t hashValue(const std::map<K, V, C, A>& v, uint64_t h);
+template <typename K, typename V, typename H, typename E, typename A>
+uint64_t hashValue(const std::unordered_map<K, V, H, E, A>& v, uint64_t h);
+template <typename T> uint64_t hashValue(const std::optional<T>& v, uint64_t h);
+template <typename... Types> uint64_t hashValue(const std::variant<Types...>& v, uint64_t h);
+template <typename K, typename V> uint64_t hashValue(const std::pair<K, V>& v, uint64_t h);
+template <typename... Args> uint64_t hashValue(const std::tuple<Args...>& v, uint64_t h);
+template <HasFields T> uint64_t hashValue(const T& v, uint64_t h);
+
+// Scalars; anything else goes through std::hash
+template <typename T>
+uint64_t hashValue(const T& v, uint64_t h)
+{
+    if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+        return hashMix(h, static_cast<uint64_t>(v));
+    else if constexpr (std::is_floating_point_v<T>)
+        return hashMix(h, std::bit_cast<uint64_t>(v == 0 ? 0.0 : static_cast<double>(v))); // -0.0 == 0.0
+    else
+        return hashMix(h, std::hash<T>{}(v));
+}
 
-// Forward declare main template
-template <typename T> void to(const T& obj, Builder* b);
+template <StringType S>
+uint64_t hashValue(const S& v, uint64_t h)
+{
+    return hashBytes(v.data(), v.size(), h);
+}
 
-// Primitive integer types - all write as int
-template <IntegerType T>
-void to(const T& obj, Builder* b)
+inline uint64_t hashValue(const std::string_view& v, uint64_t h)
 {
-    b->writeInt(static_cast<int>(obj));
+    return hashBytes(v.data(), v.size(), h);
 }
 
-// Floating point types
-template <FloatingPointType T>
-void to(const T& obj, Builder* b)
+template <typename Range>
+uint64_t hashRange(const Range& v, uint64_t h)
 {
-    b->writeDouble(static_cast<double>(obj));
+    h = hashMix(h, v.size());
+    if constexpr (std::ranges::contiguous_range<Range> && comparedAsBytes<std::ranges::range_value_t<Range>>())
+        return hashBytes(std::ranges::data(v), v.size() * sizeof(std::ranges::range_value_t<Range>), h);
+    else
+    {
+        for (const auto& e : v)
+            h = hashValue(e, h);
+        return h;
+    }
 }
 
-// Bool
-template <> inline void to(const bool& obj, Builder* b)
+template <typename T, typename A>
+uint64_t hashValue(const std::vector<T, A>& v, uint64_t h)
 {
-    b->writeBool(obj);
+    return hashRange(v, h);
 }
 
-// String
-template <> inline void to(const std::string& obj, Builder* b)
+template <typename T, typename A>
+uint64_t hashValue(const std::deque<T, A>& v, uint64_t h)
 {
-    b->writeString(obj);
+    return hashRange(v, h);
 }
 
-// Enum
-template <RegisteredEnum EnumT>
-void to(const EnumT& obj, Builder* b)
+template <typename T, typename C, typename A>
+uint64_t hashValue(const std::set<T, C, A>& v, uint64_t h)
 {
-    b->writeString(EnumMapping<EnumT>::Type::toString(obj));
+    return hashRange(v, h);
 }
 
-// Vector
-template <typename T>
-void to(const std::vector<T>& obj, Builder* b)
+template <typename K, typename V, typename C, typename A>
+uint64_t hashValue(const std::map<K, V, C, A>& v, uint64_t h)
 {
-    b->startSeq(typeid(T).name());
-    for (const auto& e : obj)
-        to(e, b);
-    b->endSeq();
+    return hashRange(v, h);
 }
 
-// Deque
-template <typename T>
-void to(const std::deque<T>& obj, Builder* b)
+// Entries hashed on their own and summed, so iteration order doesn't matter
+template <typename K, typename V, typename H, typename E, typename A>
+uint64_t hashValue(const std::unordered_map<K, V, H, E, A>& v, uint64_t h)
 {
-    b->startSeq(typeid(T).name());
-    for (const auto& e : obj)
-        to(e, b);
-    b->endSeq();
+    uint64_t sum = 0;
+    for (const auto& entry : v)
+        sum += hashValue(entry, 0);
+    return hashMix(hashMix(h, v.size()), sum);
 }
 
-// Set
 template <typename T>
-void to(const std::set<T>& obj, Builder* b)
+uint64_t hashValue(const std::optional<T>& v, uint64_t h)
 {
-    b->startSeq(typeid(T).name());
-    for (const auto& e : obj)
-        to(e, b);
-    b->endSeq();
+    return v ? hashValue(*v, hashMix(h, 1)) : hashMix(h, 0);
+}
+
+template <typename... Types>
+uint64_t hashValue(const std::variant<Types...>& v, uint64_t h)
+{
+    return std::visit([&](const auto& alt) { return hashValue(alt, hashMix(h, v.index())); }, v);
 }
 
-// Map
 template <typename K, typename V>
-void to(const std::map<K, V>& obj, Builder* b)
+uint64_t hashValue(const std::pair<K, V>& v, uint64_t h)
 {
-    b->startMap(typeid(V).name());
-    for (const auto& [k, v] : obj)
+    return hashValue(v.second, hashValue(v.first, h));
+}
+
+template <typename... Args>
+uint64_t hashValue(const std::tuple<Args...>& v, uint64_t h)
+{
+    std::apply([&](const auto&... e) { ((h = hashValue(e, h)), ...); }, v);
+    return h;
+}
+
+template <HasFields T>
+uint64_t hashValue(const T& v, uint64_t h)
+{
+    if constexpr (comparedAsBytes<T>())
+        return hashBytes(&v, sizeof(T), h);
+    else
     {
-        if constexpr (std::is_same_v<K, std::string>)
-        {
-            b->key(k);
-        }
-        else if constexpr (std::is_integral_v<K>)
-        {
-            b->key(std::to_string(k));
-        }
-        to(v, b);
+        std::apply(
+            [&](auto&&... fields)
+            {
+                (..., [&](auto& field)
+                 {
+                     if constexpr (isCompared<decltype(field)>)
+                         h = hashValue(v.*(field.memberPtr), h);
+                 }(fields));
+            },
+            get_fields<T>());
+        return h;
     }
-    b->endMap();
 }
 
-// Unordered map
-template <typename K, typename V>
-void to(const std::unordered_map<K, V>& obj, Builder* b)
+template <typename T> bool equalValue(const T& a, const T& b);
+template <typename T, typename A> bool equalValue(const std::vector<T, A>& a, const std::vector<T, A>& b);
+template <typename T, typename A> bool equalValue(const std::deque<T, A>& a, const std::deque<T, A>& b);
+template <typename T, typename C, typename A> bool equalValue(const std::set<T, C, A>& a, const std::set<T, C, A>& b);
+template <typename K, typename V, typename C, typename A>
+bool equalValue(const std::map<K, V, C, A>& a, const std::map<K, V, C, A>& b);
+template <typename K, typename V, typename H, typename E, typename A>
+bool equalValue(const std::unordered_map<K, V, H, E, A>& a, const std::unordered_map<K, V, H, E, A>& b);
+template <typename T> bool equalValue(const std::optional<T>& a, const std::optional<T>& b);
+template <typename... Types> bool equalValue(const std::variant<Types...>& a, const std::variant<Types...>& b);
+template <typename K, typename V> bool equalValue(const std::pair<K, V>& a, const std::pair<K, V>& b);
+template <typename... Args> bool equalValue(const std::tuple<Args...>& a, const std::tuple<Args...>& b);
+template <HasFields T> bool equalValue(const T& a, const T& b);
+
+template <typename T>
+bool equalValue(const T& a, const T& b)
 {
-    b->startMap(typeid(V).name());
-    for (const auto& [k, v] : obj)
-    {
-        if constexpr (std::is_same_v<K, std::string>)
-        {
-            b->key(k);
-        }
-        else if constexpr (std::is_integral_v<K>)
-        {
-            b->key(std::to_string(k));
-        }
-        to(v, b);
+    return a == b;
+}
+
+template <typename Range>
+bool equalRange(const Range& a, const Range& b)
+{
+    if (a.size() != b.size())
+        return false;
+    if constexpr (std::ranges::contiguous_range<Range> && comparedAsBytes<std::ranges::range_value_t<Range>>())
+        return a.empty() || std::memcmp(std::ranges::data(a), std::ranges::data(b),
+                                        a.size() * sizeof(std::ranges::range_value_t<Range>)) == 0;
+    else
+        return std::equal(a.begin(), a.end(), b.begin(),
+                          [](const auto& x, const auto& y) { return equalValue(x, y); });
+}
+
+template <typename T, typename A>
+bool equalValue(const std::vector<T, A>& a, const std::vector<T, A>& b)
+{
+    return equalRange(a, b);
+}
+
+template <typename T, typename A>
+bool equalValue(const std::deque<T, A>& a, const std::deque<T, A>& b)
+{
+    return equalRange(a, b);
+}
+
+template <typename T, typename C, typename A>
+bool equalValue(const std::set<T, C, A>& a, const std::set<T, C, A>& b)
+{
+    return equalRange(a, b);
+}
+
+template <typename K, typename V, typename C, typename A>
+bool equalValue(const std::map<K, V, C, A>& a, const std::map<K, V, C, A>& b)
+{
+    return equalRange(a, b);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+bool equalValue(const std::unordered_map<K, V, H, E, A>& a, const std::unordered_map<K, V, H, E, A>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (const auto& [k, v] : a)
+    {
+        auto it = b.find(k);
+        if (it == b.end() || !equalValue(v, it->second))
+            return false;
     }
-    b->endMap();
+    return true;
 }
 
-// Optional
 template <typename T>
-void to(const std::optional<T>& obj, Builder* b)
+bool equalValue(const std::optional<T>& a, const std::optional<T>& b)
 {
-    if (obj)
-        to(*obj, b);
-    else
-        b->writeNull();
+    return a && b ? equalValue(*a, *b) : a.has_value() == b.has_value();
 }
 
-// Variant
 template <typename... Types>
-void to(const std::variant<Types...>& obj, Builder* b)
+bool equalValue(const std::variant<Types...>& a, const std::variant<Types...>& b)
 {
-    std::visit([b](const auto& value) {
-        to(value, b);
-    }, obj);
+    if (a.index() != b.index())
+        return false;
+    return std::visit([&](const auto& alt) { return equalValue(alt, std::get<std::decay_t<decltype(alt)>>(b)); }, a);
 }
 
-// Pair
 template <typename K, typename V>
-void to(const std::pair<K, V>& obj, Builder* b)
+bool equalValue(const std::pair<K, V>& a, const std::pair<K, V>& b)
 {
-    b->startFlowSeq();
-    to(obj.first, b);
-    to(obj.second, b);
-    b->endFlowSeq();
+    return equalValue(a.first, b.first) && equalValue(a.second, b.second);
 }
 
-// Tuple
 template <typename... Args>
-void to(const std::tuple<Args...>& obj, Builder* b)
+bool equalValue(const std::tuple<Args...>& a, const std::tuple<Args...>& b)
 {
-    b->startFlowSeq();
-    std::apply([b](const auto&... args)
-               { (..., [b](const auto& arg) { to(arg, b); }(args)); },
-               obj);
-    b->endFlowSeq();
+    return [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        return (equalValue(std::get<I>(a), std::get<I>(b)) && ...);
+    }(std::index_sequence_for<Args...>{});
 }
 
-// Structs with fields
+// Stops at the first field that differs
 template <HasFields T>
-void to(const T& obj, Builder* b)
+bool equalValue(const T& a, const T& b)
 {
-    if constexpr (requires { typename T::Ser; })
-    {
-        T::Ser::write(obj, b);
-    }
+    if constexpr (comparedAsBytes<T>())
+        return std::memcmp(&a, &b, sizeof(T)) == 0;
     else
-    {
-        b->startMap("");
-        std::apply(
+        return std::apply(
             [&](auto&&... fields)
             {
-                (..., [&](auto& field)
-                 {
-                     b->key(std::string(field.fieldName));
-                     to(obj.*(field.memberPtr), b);
-                 }(fields));
+                return (... && [&](auto& field)
+                        {
+                            if constexpr (isCompared<decltype(field)>)
+                                return equalValue(a.*(field.memberPtr), b.*(field.memberPtr));
+                            else
+                                return true;
+                        }(fields));
             },
             get_fields<T>());
-        b->endMap();
-    }
 }
 
-// Catch-all for structs without metadata - gives compile-time error instead of linker error
-template <StructWithoutMetadata T>
-void to(const T& obj, Builder* b)
+// Three-way comparisons: negative, zero or positive
+template <typename T> int compareValue(const T& a, const T& b);
+template <typename T, typename A> int compareValue(const std::vector<T, A>& a, const std::vector<T, A>& b);
+template <typename T, typename A> int compareValue(const std::deque<T, A>& a, const std::deque<T, A>& b);
+template <typename T, typename C, typename A> int compareValue(const std::set<T, C, A>& a, const std::set<T, C, A>& b);
+template <typename K, typename V, typename C, typename A>
+int compareValue(const std::map<K, V, C, A>& a, const std::map<K, V, C, A>& b);
+template <typename T> int compareValue(const std::optional<T>& a, const std::optional<T>& b);
+template <typename... Types> int compareValue(const std::variant<Types...>& a, const std::variant<Types...>& b);
+template <typename K, typename V> int compareValue(const std::pair<K, V>& a, const std::pair<K, V>& b);
+template <typename... Args> int compareValue(const std::tuple<Args...>& a, const std::tuple<Args...>& b);
+template <HasFields T> int compareValue(const T& a, const T& b);
+
+template <typename T>
+int compareValue(const T& a, const T& b)
 {
-    static_assert(HasFields<T>,
-                  "ERROR: Type must have T::FieldsMeta or meta::MetaTuple<T>::FieldsMeta defined");
+    if constexpr (StringType<T> || std::is_same_v<T, std::string_view>)
+        return a.compare(b);
+    else
+        return a < b ? -1 : b < a ? 1 : 0;
 }
 
-// Filesystem path support
-template <> inline ValidationResult from(std::filesystem::path& obj, Node* node)
+template <typename Range>
+int compareRange(const Range& a, const Range& b)
 {
-    auto str = node->asString();
-    if (!str)
-    {
-        ValidationResult r;
-        r.addError("path", "Must be string");
-        return r;
-    }
-    obj = std::filesystem::path(*str);
-    return ValidationResult();
+    auto x = a.begin();
+    auto y = b.begin();
+    for (; x != a.end() && y != b.end(); ++x, ++y)
+        if (int c = compareValue(*x, *y))
+            return c;
+    return x != a.end() ? 1 : y != b.end() ? -1 : 0;
 }
 
-template <> inline void to(const std::filesystem::path& obj, Builder* b)
+template <typename T, typename A>
+int compareValue(const std::vector<T, A>& a, const std::vector<T, A>& b)
 {
-    b->writeString(obj.string());
+    return compareRange(a, b);
 }
 
-//============================================================
-// PUBLIC API
-//============================================================
-
+template <typename T, typename A>
+int compareValue(const std::deque<T, A>& a, const std::deque<T, A>& b)
+{
+    return compareRange(a, b);
+}
 
-template <typename T>
-std::pair<std::optional<T>, ValidationResult> reifyFromYaml(const YAML::Node& node)
+template <typename T, typename C, typename A>
+int compareValue(const std::set<T, C, A>& a, const std::set<T, C, A>& b)
 {
-    ValidationResult validation;
-    
-    if constexpr (HasFields<T>)
-    {
-        // Collect known field names and check which are required
-        std::set<std::string> known_fields;
-        std::set<std::string> required_fields;
-        std::set<std::string> yaml_fields;
-        
-        // Get all YAML keys
-        if (node.IsMap()) {
-            for (const auto& kv : node) {
-                std::string key = kv.first.as<std::string>();
-                yaml_fields.insert(key);
-            }
-        }
-        
-        
-        // Check each field in struct
-        std::apply([&](auto&&... fields) {
-            ([&](auto&& field) {
-                std::string field_name(field.fieldName);
-                known_fields.insert(field_name);
-                
-                // Check if field is required (not optional)
-                using FieldType = typename std::decay_t<decltype(field)>::MemberType;
-                if constexpr (!is_optional_v<FieldType>) {
-                    required_fields.insert(field_name);
-                }
-            }(fields), ...);
-        }, get_fields<T>());
-        
-        
-        // CHECK 1: Unknown fields in YAML (not in struct)
-        for (const auto& yaml_field : yaml_fields) {
-            if (known_fields.find(yaml_field) == known_fields.end()) {
-                validation.errors.push_back({
-                    yaml_field,
-                    "Unknown field - not in struct definition"
-                });
-            } else {
-            }
-        }
-        
-        // CHECK 2: Missing required fields (in struct but not in YAML)
-        for (const auto& req_field : required_fields) {
-            if (yaml_fields.find(req_field) == yaml_fields.end()) {
-                validation.errors.push_back({
-                    req_field,
-                    "Missing required field"
-                });
-            } else {
-            }
-        }
-        
-        // If pre-validation failed, return early
-	// if (!validation.errors.empty()) {
-        //    validation.valid = false;
-        //    return {std::nullopt, validation};
-        //}
-        
-    }
-    
-    // Now do the actual parsing
-    try
-    {
-        YamlNode ynode(node);
-        T obj{};
-        auto result = from(obj, &ynode);
-        
-        // Merge any parsing errors with our validation errors
-        validation.errors.insert(validation.errors.end(), 
-                                result.errors.begin(), 
-                                result.errors.end());
-        validation.valid = result.valid;
-        
-        return result.valid ? std::make_pair(std::optional(obj), validation)
-                            : std::make_pair(std::nullopt, validation);
-    }
-    catch (const std::exception& e)
-    {
-        validation.addError("yaml", std::string(e.what()));
-        validation.valid = false;
-        return {std::nullopt, validation};
-    }
+    return compareRange(a, b);
 }
 
+template <typename K, typename V, typename C, typename A>
+int compareValue(const std::map<K, V, C, A>& a, const std::map<K, V, C, A>& b)
+{
+    return compareRange(a, b);
+}
 
+// An empty optional sorts first
 template <typename T>
-std::pair<std::optional<T>, ValidationResult> reifyFromYaml(const std::string& yaml)
+int compareValue(const std::optional<T>& a, const std::optional<T>& b)
 {
-    try
-    {
-        YAML::Node node = YAML::Load(yaml);
-        return reifyFromYaml<T>(node);  // ← Call the version with validation!
-    }
-    catch (const std::exception& e)
-    {
-        ValidationResult result;
-        result.addError("yaml", std::string(e.what()));
-        return {std::nullopt, result};
-    }
+    return a && b ? compareValue(*a, *b) : static_cast<int>(a.has_value()) - static_cast<int>(b.has_value());
 }
 
-
-template <typename T> std::string toYaml(const T& obj)
+template <typename... Types>
+int compareValue(const std::variant<Types...>& a, const std::variant<Types...>& b)
 {
-    YamlBuilder builder;
-    to(obj, &builder);
-    return builder.result();
+    if (a.index() != b.index())
+        return a.index() < b.index() ? -1 : 1;
+    return std::visit([&](const auto& alt) { return compareValue(alt, std::get<std::decay_t<decltype(alt)>>(b)); }, a);
 }
 
-template <typename T> std::string toJson(const T& obj)
+template <typename K, typename V>
+int compareValue(const std::pair<K, V>& a, const std::pair<K, V>& b)
 {
-    JsonBuilder builder;
-    to(obj, &builder);
-    return builder.result();
+    if (int c = compareValue(a.first, b.first))
+        return c;
+    return compareValue(a.second, b.second);
 }
 
-template <typename T>
-std::string serializeJson(const std::vector<T>& objects)
+template <typename... Args>
+int compareValue(const std::tuple<Args...>& a, const std::tuple<Args...>& b)
 {
-    std::stringstream os;
-    os << "[\n";
-    
-    for (size_t i = 0; i < objects.size(); ++i)
+    int c = 0;
+    [&]<size_t... I>(std::index_sequence<I...>)
     {
-        os << "  " << toJson(objects[i]);
-        if (i < objects.size() - 1)
-            os << ",";
-        os << "\n";
-    }
-    
-    os << "]\n";
-    return os.str();
+        (void)(((c = compareValue(std::get<I>(a), std::get<I>(b))) == 0) && ...);
+    }(std::index_sequence_for<Args...>{});
+    return c;
 }
 
-
-template <typename T> std::string toXml(const T& obj)
+// Field by field in declaration order, stopping at the first difference
+template <HasFields T>
+int compareValue(const T& a, const T& b)
 {
-    XmlBuilder builder;
-    to(obj, &builder);
-    return builder.result();
+    int c = 0;
+    std::apply(
+        [&](auto&&... fields)
+        {
+            (void)(... && [&](auto& field)
+                   {
+                       if constexpr (isCompared<decltype(field)>)
+                           c = compareValue(a.*(field.memberPtr), b.*(field.memberPtr));
+                       return c == 0;
+                   }(fields));
+        },
+        get_fields<T>());
+    return c;
 }
 
-template <typename T> std::string toString(const T& obj)
+template <typename T>
+struct hash
 {
-    return toYaml(obj);
-}
+    size_t operator()(const T& v) const { return static_cast<size_t>(hashValue(v, 0)); }
+};
+
+struct EqualTo
+{
+    template <typename T>
+    bool operator()(const T& a, const T& b) const
+    {
+        return equalValue(a, b);
+    }
+};
+
+struct Less
+{
+    template <typename T>
+    bool operator()(const T& a, const T& b) const
+    {
+        return compareValue(a, b) < 0;
+    }
+};
+
+inline constexpr EqualTo equal{};
+inline constexpr Less less{};
 
 template <typename T> bool checkForEquality(const T& a, const T& b)
 {
@@ -1272,7 +5024,7 @@ template <typename EnumT>
     requires RegisteredEnum<EnumT>
 std::ostream& operator<<(std::ostream& os, EnumT e)
 {
-    os << EnumMapping<EnumT>::Type::toString(e);
+    os << EnumMapping<EnumT>::Type::name(e);
     return os;
 }
 
@@ -1292,6 +5044,382 @@ std::vector<EnumT> enumValues()
     return values;
 }
 
+//============================================================
+// VALIDATION
+//============================================================
+// meta::validate runs the checks from() makes while reading - field
+// attributes and registered enum values - on objects that never came
+// through a parser, with the same error paths:
+//
+//   meta::ValidationResult result = meta::validate(config);
+//   if (!meta::isValid(std::span(orders)))   // formats no messages
+//       quarantine(orders);
+//
+// Attributes answer pass/fail apart from formatting their message (see
+// field.h), so messages are only built for values that fail, and isValid
+// never builds any. A batch is checked by ValidationPlan<T>: one field and
+// attribute at a time across all records, without branching on the
+// outcome, after which only the records that failed are walked again for
+// their messages.
+
+template <bool Report, typename T> bool checkValue(const T& v, ValidationResult* result);
+template <bool Report, typename T> bool checkValue(const std::optional<T>& v, ValidationResult* result);
+template <bool Report, typename T, typename A> bool checkValue(const std::vector<T, A>& v, ValidationResult* result);
+template <bool Report, typename T, typename A> bool checkValue(const std::deque<T, A>& v, ValidationResult* result);
+template <bool Report, typename T, typename C, typename A>
+bool checkValue(const std::set<T, C, A>& v, ValidationResult* result);
+template <bool Report, typename T, size_t N> bool checkValue(const std::array<T, N>& v, ValidationResult* result);
+template <bool Report, typename K, typename V, typename C, typename A>
+bool checkValue(const std::map<K, V, C, A>& v, ValidationResult* result);
+template <bool Report, typename K, typename V, typename H, typename E, typename A>
+bool checkValue(const std::unordered_map<K, V, H, E, A>& v, ValidationResult* result);
+template <bool Report, typename... Types> bool checkValue(const std::variant<Types...>& v, ValidationResult* result);
+template <bool Report, typename K, typename V> bool checkValue(const std::pair<K, V>& v, ValidationResult* result);
+template <bool Report, typename... Args> bool checkValue(const std::tuple<Args...>& v, ValidationResult* result);
+template <bool Report, HasFields T> bool checkValue(const T& v, ValidationResult* result);
+
+// Scalars: only registered enums can hold a value that isn't allowed
+template <bool Report, typename T>
+bool checkValue(const T& v, ValidationResult* result)
+{
+    if constexpr (RegisteredEnum<T>)
+    {
+        bool ok = EnumMapping<T>::Type::contains(v);
+        if constexpr (Report)
+        {
+            if (!ok)
+                result->addError("", "Unknown enum value. Valid values are: " + EnumMapping<T>::Type::validValues());
+        }
+        return ok;
+    }
+    else
+        return true;
+}
+
+template <bool Report, typename T>
+bool checkValue(const std::optional<T>& v, ValidationResult* result)
+{
+    return !v || checkValue<Report>(*v, result);
+}
+
+// Elements reported under "[i]", as from() does
+template <bool Report, typename Range>
+bool checkElements(const Range& range, ValidationResult* result)
+{
+    bool ok = true;
+    size_t i = 0;
+    for (const auto& e : range)
+    {
+        if constexpr (Report)
+        {
+            ValidationResult r;
+            if (!checkValue<true>(e, &r))
+            {
+                appendElementErrors(*result, i, std::move(r));
+                ok = false;
+            }
+        }
+        else
+            ok &= checkValue<false>(e, nullptr);
+        ++i;
+    }
+    return ok;
+}
+
+template <bool Report, typename T, typename A>
+bool checkValue(const std::vector<T, A>& v, ValidationResult* result)
+{
+    return checkElements<Report>(v, result);
+}
+
+template <bool Report, typename T, typename A>
+bool checkValue(const std::deque<T, A>& v, ValidationResult* result)
+{
+    return checkElements<Report>(v, result);
+}
+
+template <bool Report, typename T, typename C, typename A>
+bool checkValue(const std::set<T, C, A>& v, ValidationResult* result)
+{
+    return checkElements<Report>(v, result);
+}
+
+template <bool Report, typename T, size_t N>
+bool checkValue(const std::array<T, N>& v, ValidationResult* result)
+{
+    return checkElements<Report>(v, result);
+}
+
+// Values reported under their key, or "[i]" for keys with no text form
+template <bool Report, typename Map>
+bool checkEntries(const Map& map, ValidationResult* result)
+{
+    bool ok = true;
+    size_t i = 0;
+    for (const auto& [key, value] : map)
+    {
+        if constexpr (Report)
+        {
+            ValidationResult r;
+            if (!checkValue<true>(value, &r))
+            {
+                using K = std::remove_cvref_t<decltype(key)>;
+                if constexpr (StringType<K> || std::is_same_v<K, std::string_view>)
+                    result->addErrorsUnder(std::string_view(key.data(), key.size()), std::move(r));
+                else if constexpr (std::is_integral_v<K>)
+                    result->addErrorsUnder(std::to_string(key), std::move(r));
+                else
+                    appendElementErrors(*result, i, std::move(r));
+                ok = false;
+            }
+        }
+        else
+            ok &= checkValue<false>(value, nullptr);
+        ++i;
+    }
+    return ok;
+}
+
+template <bool Report, typename K, typename V, typename C, typename A>
+bool checkValue(const std::map<K, V, C, A>& v, ValidationResult* result)
+{
+    return checkEntries<Report>(v, result);
+}
+
+template <bool Report, typename K, typename V, typename H, typename E, typename A>
+bool checkValue(const std::unordered_map<K, V, H, E, A>& v, ValidationResult* result)
+{
+    return checkEntries<Report>(v, result);
+}
+
+// Tagged variants report under their value key, like from()
+template <bool Report, typename... Types>
+bool checkValue(const std::variant<Types...>& v, ValidationResult* result)
+{
+    using V = std::variant<Types...>;
+    return std::visit([&](const auto& alt)
+    {
+        if constexpr (Report && TaggedVariant<V>)
+        {
+            ValidationResult r;
+            bool ok = checkValue<true>(alt, &r);
+            result->addErrorsUnder(variantValueKey<V>(), std::move(r));
+            return ok;
+        }
+        else
+            return checkValue<Report>(alt, result);
+    }, v);
+}
+
+template <bool Report, typename K, typename V>
+bool checkValue(const std::pair<K, V>& v, ValidationResult* result)
+{
+    return checkValue<Report>(std::tie(v.first, v.second), result);
+}
+
+template <bool Report, typename... Args>
+bool checkValue(const std::tuple<Args...>& v, ValidationResult* result)
+{
+    bool ok = true;
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (..., [&]
+        {
+            if constexpr (Report)
+            {
+                ValidationResult r;
+                if (!checkValue<true>(std::get<I>(v), &r))
+                {
+                    appendElementErrors(*result, I, std::move(r));
+                    ok = false;
+                }
+            }
+            else
+                ok &= checkValue<false>(std::get<I>(v), nullptr);
+        }());
+    }(std::index_sequence_for<Args...>{});
+    return ok;
+}
+
+// Each field's value, then its attributes, in field order
+template <bool Report, HasFields T>
+bool checkValue(const T& obj, ValidationResult* result)
+{
+    bool ok = true;
+    std::apply(
+        [&](auto&&... fields)
+        {
+            (..., [&](auto& field)
+             {
+                 const auto& value = obj.*(field.memberPtr);
+                 if constexpr (Report)
+                 {
+                     ValidationResult nested;
+                     ok &= checkValue<true>(value, &nested);
+                     result->addErrorsUnder(field.fieldName, std::move(nested));
+                 }
+                 else
+                     ok &= checkValue<false>(value, nullptr);
+                 ok &= checkFieldAttributes<Report>(value, field, result);
+             }(fields));
+        },
+        get_fields<T>());
+    return ok;
+}
+
+// The checks of a batch of T, run a block of records at a time. Each
+// check of each field is first a flat loop over the block that only
+// accumulates whether anything failed, so it has no branches on the data
+// and vectorizes; in the rare block where something did fail, the same
+// loops flag the records. get(integral_constant<I>, i) is field I of
+// record i: a member of rows[i], or in meta_soa.h an element of column I.
+template <HasFields T>
+struct ValidationPlan
+{
+    static constexpr size_t blockSize = 1024;
+
+    // True when field I passes for every record in [begin, end); with
+    // Mark, bad[i - begin] is set for the records where it doesn't
+    template <bool Mark, size_t I, typename Get>
+    static bool checkField(size_t begin, size_t end, Get& get, uint8_t* bad)
+    {
+        const auto& field = std::get<I>(get_fields<T>());
+        using M = typename std::decay_t<decltype(field)>::MemberType;
+
+        // Accumulated as unsigned: a bool accumulator keeps GCC from
+        // vectorizing the loop
+        unsigned failed = 0;
+        auto each = [&](auto fails)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                unsigned f = fails(static_cast<const M&>(get(std::integral_constant<size_t, I>{}, i)));
+                if constexpr (Mark)
+                    bad[i - begin] |= static_cast<uint8_t>(f);
+                else
+                    failed |= f;
+            }
+        };
+
+        // Checks inside the value (nested structs, enums)
+        if constexpr (!std::is_arithmetic_v<M> && !StringType<M>)
+            each([](const M& m) { return !checkValue<false>(m, nullptr); });
+
+        std::apply([&](auto&&... attrs) {
+            (..., [&](auto& attr) {
+                using AttrType = std::decay_t<decltype(attr)>;
+                if constexpr (requires(const M& m) { { AttrType::check(m) } -> std::convertible_to<bool>; })
+                    each([](const M& m) { return !AttrType::check(m); });
+                else if constexpr (requires(const M& m) { AttrType::validate(m, std::declval<std::string&>()); })
+                {
+                    std::string error;
+                    each([&error](const M& m) { return !AttrType::validate(m, error); });
+                }
+            }(attrs));
+        }, field.attributes);
+        return !failed;
+    }
+
+    // Calls invalid(i) for each record i < n that fails a check, in
+    // order, until it returns false
+    template <typename Get, typename F>
+    static void scan(size_t n, Get get, F&& invalid)
+    {
+        constexpr auto fields = std::make_index_sequence<field_count_v<T>>{};
+        uint8_t bad[blockSize];
+        for (size_t begin = 0; begin < n; begin += blockSize)
+        {
+            size_t end = std::min(n, begin + blockSize);
+            bool passes = [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                return (checkField<false, I>(begin, end, get, nullptr) && ...);
+            }(fields);
+            if (passes)
+                continue;
+
+            std::fill_n(bad, end - begin, uint8_t{0});
+            [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                (..., checkField<true, I>(begin, end, get, bad));
+            }(fields);
+            for (size_t i = begin; i < end; ++i)
+                if (bad[i - begin] && !invalid(i))
+                    return;
+        }
+    }
+
+    // Field access for an array of records
+    static auto rows(const T* data)
+    {
+        return [data]<size_t I>(std::integral_constant<size_t, I>, size_t i) -> decltype(auto)
+        {
+            return (data[i].*(std::get<I>(get_fields<T>()).memberPtr));
+        };
+    }
+};
+
+// Calls invalid(i) for each element of rows that fails a check
+template <typename T, typename F>
+void scanInvalid(std::span<const T> rows, F&& invalid)
+{
+    if constexpr (HasFields<T>)
+        ValidationPlan<T>::scan(rows.size(), ValidationPlan<T>::rows(rows.data()), invalid);
+    else
+    {
+        for (size_t i = 0; i < rows.size(); ++i)
+            if (!checkValue<false>(rows[i], nullptr) && !invalid(i))
+                return;
+    }
+}
+
+template <typename T>
+ValidationResult validate(std::span<const T> rows)
+{
+    ValidationResult result;
+    scanInvalid(rows, [&](size_t i)
+    {
+        ValidationResult r;
+        checkValue<true>(rows[i], &r);
+        appendElementErrors(result, i, std::move(r));
+        return true;
+    });
+    return result;
+}
+
+template <typename T>
+bool isValid(std::span<const T> rows)
+{
+    bool valid = true;
+    scanInvalid(rows, [&](size_t) { return valid = false; });
+    return valid;
+}
+
+// A vector or other contiguous range of records is checked as a batch
+template <typename T>
+concept ValidatedAsBatch = std::ranges::contiguous_range<T> && std::ranges::sized_range<T> &&
+                           !std::is_convertible_v<const T&, std::string_view>;
+
+template <typename T>
+ValidationResult validate(const T& obj)
+{
+    if constexpr (ValidatedAsBatch<T>)
+        return validate(std::span<const std::ranges::range_value_t<T>>(std::ranges::data(obj), std::ranges::size(obj)));
+    else
+    {
+        ValidationResult result;
+        checkValue<true>(obj, &result);
+        return result;
+    }
+}
+
+template <typename T>
+bool isValid(const T& obj)
+{
+    if constexpr (ValidatedAsBatch<T>)
+        return isValid(std::span<const std::ranges::range_value_t<T>>(std::ranges::data(obj), std::ranges::size(obj)));
+    else
+        return checkValue<false>(obj, nullptr);
+}
 
   
 } // namespace meta
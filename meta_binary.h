@@ -0,0 +1,1543 @@
+/*
+ * meta_binary.h - Compact binary encoding for meta.h
+ *
+ * Encodes anything meta.h can reflect into a tagged binary format built
+ * from the same FieldsMeta tables, and reads it straight back from the
+ * bytes without going through the Node interface.
+ *
+ * Supports:
+ * - Varint integers (zigzag for signed types), little-endian floats
+ * - Length-prefixed strings, sequences, maps, tuples and variants
+ * - Struct fields tagged by declaration position or meta::BinaryTag<N>;
+ *   unknown tags are skipped over their length and empty optionals are
+ *   left out, so fields can be added without breaking or slowing older
+ *   readers (meta::UnknownFieldPolicy can note or reject them instead)
+ * - A schema fingerprint (field tags, names and types) in the header
+ * - The same validation attributes and error paths as from()
+ *
+ * Usage:
+ *   #include "meta_binary.h"
+ *
+ *   std::string bytes = meta::toBinary(person);
+ *   auto [copy, result] = meta::fromBinary<Person>(bytes);
+ *
+ *   // Reject documents written from a different schema
+ *   meta::fromBinary<Person>(bytes, {.requireSameSchema = true});
+ *
+ * Layout: 'M' 'B' 0x01, fingerprint (8 bytes LE), value
+ *   bool, integer, enum   varint (signed values zigzag encoded)
+ *   float / double        4 / 8 bytes little endian
+ *   string, path          varint length, bytes
+ *   anything else         varint byte length, then
+ *     vector/deque/set      varint count, elements
+ *     map/unordered_map     varint count, key/value pairs
+ *     pair/tuple            elements in order
+ *     variant               varint alternative index, value
+ *     optional              0, or 1 followed by the value
+ *     struct                (varint (tag << 2 | wire type), value)...
+ *     packed struct         fields, fixed width little endian, in order
+ *     sequence of those     varint count, packed structs
+ *
+ * Ser/Deser hooks are not consulted: the field table is the schema.
+ *
+ * Only structs specialized as BinaryPacked use the packed layouts; see
+ * PACKED STRUCTS below.
+ *
+ * std::string_view and std::span<const std::byte> fields have the same
+ * encoding as std::string but are read without copying: they point into the
+ * buffer given to fromBinary and are only valid while it is.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "meta.h"
+
+namespace meta
+{
+
+// ============================================================================
+// WIRE TYPES
+// ============================================================================
+
+// Stored in the low two bits of a field key, so readers can skip fields
+// they don't know
+enum class BinaryWire : uint8_t
+{
+    Varint = 0,
+    Fixed64 = 1,
+    Delimited = 2,
+    Fixed32 = 3
+};
+
+inline constexpr char binaryMagic[2] = {'M', 'B'};
+inline constexpr uint8_t binaryVersion = 1;
+inline constexpr size_t binaryHeaderSize = 3 + 8;
+
+template <typename T>
+constexpr BinaryWire binaryWireOf()
+{
+    if constexpr (std::is_same_v<T, bool> || IntegerType<T> || std::is_enum_v<T>)
+        return BinaryWire::Varint;
+    else if constexpr (std::is_same_v<T, float>)
+        return BinaryWire::Fixed32;
+    else if constexpr (FloatingPointType<T>)
+        return BinaryWire::Fixed64;
+    else
+        return BinaryWire::Delimited;
+}
+
+// Optional fields are written as their value, or not at all
+template <typename M>
+constexpr BinaryWire binaryFieldWireOf()
+{
+    if constexpr (is_optional_v<M>)
+        return binaryWireOf<typename M::value_type>();
+    else
+        return binaryWireOf<M>();
+}
+
+constexpr uint64_t zigzagEncode(int64_t v)
+{
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+constexpr int64_t zigzagDecode(uint64_t v)
+{
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+constexpr size_t varintSize(uint64_t v)
+{
+    return (static_cast<size_t>(std::bit_width(v | 1)) + 6) / 7;
+}
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+class BinaryWriter
+{
+  public:
+    explicit BinaryWriter(size_t initialCapacity = 256) { grow(initialCapacity); }
+    BinaryWriter(const BinaryWriter&) = delete;
+    BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+    void put(uint8_t c)
+    {
+        char* p = room(1);
+        *p = static_cast<char>(c);
+        cur = p + 1;
+    }
+
+    void varint(uint64_t v)
+    {
+        char* p = room(10);
+        for (; v >= 0x80; v >>= 7)
+            *p++ = static_cast<char>(v | 0x80);
+        *p++ = static_cast<char>(v);
+        cur = p;
+    }
+
+    void fixed32(uint32_t v) { fixed(v); }
+    void fixed64(uint64_t v) { fixed(v); }
+
+    void bytes(const char* data, size_t n)
+    {
+        char* p = room(n);
+        if (n)
+            std::memcpy(p, data, n);
+        cur = p + n;
+    }
+
+    // A length-prefixed value: beginDelimited() reserves one length byte
+    // and returns where the payload starts; endDelimited() fills the length
+    // in, moving the payload up if it needs a longer varint (>= 128 bytes)
+    size_t beginDelimited()
+    {
+        put(0);
+        return size();
+    }
+
+    void endDelimited(size_t start)
+    {
+        size_t len = size() - start;
+        if (len < 0x80)
+        {
+            buf[start - 1] = static_cast<char>(len);
+            return;
+        }
+        size_t extra = varintSize(len) - 1;
+        room(extra);
+        char* payload = buf.data() + start;
+        std::memmove(payload + extra, payload, len);
+        char* end = cur + extra;
+        cur = payload - 1;
+        varint(len);
+        cur = end;
+    }
+
+    size_t size() const { return static_cast<size_t>(cur - buf.data()); }
+    std::string_view view() const { return {buf.data(), size()}; }
+    void clear() { cur = buf.data(); }
+
+    // Moves the encoded bytes out; the writer starts over empty
+    std::string take()
+    {
+        buf.resize(size());
+        std::string out = std::move(buf);
+        buf.clear();
+        cur = limit = buf.data();
+        return out;
+    }
+
+  private:
+    // Little-endian fixed-width value
+    template <typename U>
+    void fixed(U v)
+    {
+        char* p = room(sizeof(U));
+        if constexpr (std::endian::native == std::endian::little)
+            std::memcpy(p, &v, sizeof(U));
+        else
+            for (size_t i = 0; i < sizeof(U); ++i)
+                p[i] = static_cast<char>(v >> (8 * i));
+        cur = p + sizeof(U);
+    }
+
+    char* room(size_t n)
+    {
+        if (static_cast<size_t>(limit - cur) < n)
+            grow(n);
+        return cur;
+    }
+
+    void grow(size_t n)
+    {
+        size_t used = cur ? size() : 0;
+        buf.resize(std::max({buf.size() * 2, used + n, size_t(256)}));
+        cur = buf.data() + used;
+        limit = buf.data() + buf.size();
+    }
+
+    std::string buf;
+    char* cur = nullptr;
+    char* limit = nullptr;
+};
+
+// ============================================================================
+// READER
+// ============================================================================
+
+// Bounds-checked cursor over the encoded bytes. Structural errors
+// (truncation, bad lengths) are reported once through fail() and stop the
+// read; errors in individual values are left to the decoders.
+class BinaryReader
+{
+  public:
+    BinaryReader(const char* data, size_t size) : p(data), end(data + size) {}
+
+    bool failed() const { return broken; }
+    bool atEnd() const { return p == end; }
+    size_t remaining() const { return static_cast<size_t>(end - p); }
+
+    bool fail(ValidationResult& result, std::string_view message)
+    {
+        if (!broken)
+            result.addError("", message);
+        broken = true;
+        p = end;
+        return false;
+    }
+
+    bool varint(uint64_t& v, ValidationResult& result)
+    {
+        if (p != end && static_cast<uint8_t>(*p) < 0x80)
+        {
+            v = static_cast<uint8_t>(*p++);
+            return true;
+        }
+        v = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (p == end)
+                return fail(result, "Truncated binary data");
+            uint8_t byte = static_cast<uint8_t>(*p++);
+            v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (byte < 0x80)
+                return shift < 63 || byte <= 1 ? true : fail(result, "Malformed varint");
+        }
+        return fail(result, "Malformed varint");
+    }
+
+    bool fixed32(uint32_t& v, ValidationResult& result) { return fixed(v, result); }
+    bool fixed64(uint64_t& v, ValidationResult& result) { return fixed(v, result); }
+
+    // The next n bytes
+    bool raw(size_t n, const char*& out, ValidationResult& result)
+    {
+        if (n > remaining())
+            return fail(result, "Truncated binary data");
+        out = p;
+        p += n;
+        return true;
+    }
+
+    // A varint length followed by that many bytes
+    bool lengthPrefixed(std::string_view& out, ValidationResult& result)
+    {
+        uint64_t len;
+        if (!varint(len, result))
+            return false;
+        if (len > remaining())
+            return fail(result, "Truncated binary data");
+        out = {p, static_cast<size_t>(len)};
+        p += len;
+        return true;
+    }
+
+    // Narrows the reader to the next delimited payload. leave() restores the
+    // outer bound and skips whatever the payload had left over, such as
+    // fields added by a newer writer.
+    bool enter(const char*& outerEnd, ValidationResult& result)
+    {
+        uint64_t len;
+        if (!varint(len, result))
+            return false;
+        if (len > remaining())
+            return fail(result, "Truncated binary data");
+        outerEnd = end;
+        end = p + len;
+        return true;
+    }
+
+    void leave(const char* outerEnd)
+    {
+        if (broken)
+            return;
+        p = end;
+        end = outerEnd;
+    }
+
+    // Consumes the next varint if it equals key
+    bool nextKeyIs(uint64_t key)
+    {
+        if (key < 0x80)
+        {
+            if (p == end || static_cast<uint8_t>(*p) != key)
+                return false;
+            ++p;
+            return true;
+        }
+        const char* q = p;
+        for (; key >= 0x80; key >>= 7)
+            if (q == end || static_cast<uint8_t>(*q++) != ((key & 0x7F) | 0x80))
+                return false;
+        if (q == end || static_cast<uint8_t>(*q++) != key)
+            return false;
+        p = q;
+        return true;
+    }
+
+    bool skip(BinaryWire wire, ValidationResult& result)
+    {
+        uint64_t v;
+        std::string_view s;
+        switch (wire)
+        {
+        case BinaryWire::Varint:
+            return varint(v, result);
+        case BinaryWire::Fixed64:
+            return remaining() >= 8 ? (p += 8, true) : fail(result, "Truncated binary data");
+        case BinaryWire::Delimited:
+            return lengthPrefixed(s, result);
+        case BinaryWire::Fixed32:
+            return remaining() >= 4 ? (p += 4, true) : fail(result, "Truncated binary data");
+        }
+        return fail(result, "Unknown wire type");
+    }
+
+  private:
+    template <typename U>
+    bool fixed(U& v, ValidationResult& result)
+    {
+        if (remaining() < sizeof(U))
+            return fail(result, "Truncated binary data");
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            std::memcpy(&v, p, sizeof(U));
+        }
+        else
+        {
+            v = 0;
+            for (size_t i = 0; i < sizeof(U); ++i)
+                v |= static_cast<U>(static_cast<uint8_t>(p[i])) << (8 * i);
+        }
+        p += sizeof(U);
+        return true;
+    }
+
+    const char* p;
+    const char* end;
+    bool broken = false;
+};
+
+// ============================================================================
+// FIELD TAGS
+// ============================================================================
+
+template <typename T>
+struct BinaryFields
+{
+    using Tuple = std::decay_t<decltype(get_fields<T>())>;
+    static constexpr size_t count = std::tuple_size_v<Tuple>;
+
+    template <size_t I>
+    using FieldAt = std::tuple_element_t<I, Tuple>;
+
+    static constexpr auto tags = []<size_t... I>(std::index_sequence<I...>)
+    {
+        return std::array<uint32_t, count>{FieldAt<I>::getBinaryTag(I + 1)...};
+    }(std::make_index_sequence<count>{});
+
+    static constexpr bool uniqueTags()
+    {
+        for (size_t i = 0; i < count; ++i)
+            for (size_t j = i + 1; j < count; ++j)
+                if (tags[i] == tags[j])
+                    return false;
+        return true;
+    }
+    static_assert(uniqueTags(), "Two fields share a binary tag; check the BinaryTag<N> attributes");
+
+    // Fields normally arrive in declaration order, so the one after the
+    // previous match is tried first
+    static int find(uint32_t tag, size_t hint)
+    {
+        if (hint < count && tags[hint] == tag)
+            return static_cast<int>(hint);
+        for (size_t i = 0; i < count; ++i)
+            if (tags[i] == tag)
+                return static_cast<int>(i);
+        return -1;
+    }
+};
+
+// ============================================================================
+// PACKED STRUCTS
+// ============================================================================
+// Specialize BinaryPacked for a PodLayout struct to write it as its fields'
+// fixed-width little-endian bytes in declaration order, with no tags, and a
+// sequence of it as one block: a count followed by sizeof(T) bytes per
+// element. On little-endian targets whose layout matches that is a single
+// memcpy each way; elsewhere each field is copied (and byte-swapped).
+// Packing gives up tag-based evolution - adding, removing or reordering
+// fields changes the layout - so it is opt-in; the schema fingerprint marks
+// packed structs.
+//
+//   template <> struct meta::BinaryPacked<Tick> : std::true_type {};
+
+template <typename T>
+struct BinaryPacked : std::false_type
+{
+};
+
+template <typename T>
+concept PackedBinary = HasFields<T> && BinaryPacked<T>::value;
+
+template <typename T>
+constexpr bool packedAsMemory()
+{
+    static_assert(PodLayout<T>, "BinaryPacked structs need a PodLayout: arithmetic and enum fields covering every byte");
+    return std::endian::native == std::endian::little;
+}
+
+template <typename M>
+void storePacked(char* out, const M& v)
+{
+    std::memcpy(out, &v, sizeof(M));
+    if constexpr (std::endian::native == std::endian::big)
+        std::reverse(out, out + sizeof(M));
+}
+
+template <typename M>
+void loadPacked(const char* in, M& v)
+{
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        char swapped[sizeof(M)];
+        std::reverse_copy(in, in + sizeof(M), swapped);
+        std::memcpy(&v, swapped, sizeof(M));
+    }
+    else
+        std::memcpy(&v, in, sizeof(M));
+}
+
+template <PackedBinary T>
+void packRecord(const T& obj, char* out)
+{
+    if (packedAsMemory<T>() && podFieldsInOrder<T>())
+        return static_cast<void>(std::memcpy(out, &obj, sizeof(T)));
+    std::apply(
+        [&](auto&&... fields)
+        {
+            (..., [&](auto& field)
+             {
+                 storePacked(out, obj.*(field.memberPtr));
+                 out += sizeof(obj.*(field.memberPtr));
+             }(fields));
+        },
+        get_fields<T>());
+}
+
+// bool bytes are checked before the record is loaded; enum values and the
+// fields' validation attributes after. Errors are relative to the record.
+template <PackedBinary T>
+bool unpackRecord(T& obj, const char* in, ValidationResult& result)
+{
+    size_t first = result.errors.size();
+    size_t offset = 0;
+    std::apply(
+        [&](auto&&... fields)
+        {
+            (..., [&](auto& field)
+             {
+                 using M = typename std::decay_t<decltype(field)>::MemberType;
+                 if constexpr (std::is_same_v<M, bool>)
+                 {
+                     if (static_cast<uint8_t>(in[offset]) > 1)
+                         result.addError(field.fieldName, "Expected 0 or 1 for bool");
+                 }
+                 offset += sizeof(M);
+             }(fields));
+        },
+        get_fields<T>());
+    if (result.errors.size() != first)
+        return false;
+
+    if (packedAsMemory<T>() && podFieldsInOrder<T>())
+        std::memcpy(&obj, in, sizeof(T));
+    else
+        std::apply(
+            [&](auto&&... fields)
+            {
+                (..., [&](auto& field)
+                 {
+                     loadPacked(in, obj.*(field.memberPtr));
+                     in += sizeof(obj.*(field.memberPtr));
+                 }(fields));
+            },
+            get_fields<T>());
+
+    std::apply(
+        [&](auto&&... fields)
+        {
+            (..., [&](auto& field)
+             {
+                 using M = typename std::decay_t<decltype(field)>::MemberType;
+                 if constexpr (RegisteredEnum<M>)
+                 {
+                     if (!EnumMapping<M>::Type::contains(obj.*(field.memberPtr)))
+                         result.addError(field.fieldName, "Unknown enum value. Valid values are: " +
+                                                              EnumMapping<M>::Type::validValues());
+                 }
+                 validateFieldAttributes(obj, field, result);
+             }(fields));
+        },
+        get_fields<T>());
+    return result.errors.size() == first;
+}
+
+// Whether a loaded record still has to be checked: bool or enum fields, or
+// attributes to run
+template <typename Fields>
+struct PackedChecks;
+
+template <typename... F>
+struct PackedChecks<std::tuple<F...>>
+{
+    template <typename Field, typename M = typename Field::MemberType>
+    static constexpr bool needed =
+        std::is_same_v<M, bool> || std::is_enum_v<M> || std::tuple_size_v<decltype(Field::attributes)> > 0;
+
+    static constexpr bool value = (needed<std::remove_cvref_t<F>> || ...);
+};
+
+template <PackedBinary T>
+constexpr bool packedNeedsChecks = PackedChecks<std::remove_cvref_t<decltype(get_fields<T>())>>::value;
+
+// ============================================================================
+// SCHEMA FINGERPRINT
+// ============================================================================
+// FNV-1a over a walk of the type: scalar kinds and widths, container
+// shapes, and for every struct field its tag, name and type. Constant for
+// types whose field tables are `static constexpr`. Deeply nested (or
+// recursive) types are only followed to a fixed depth.
+
+inline constexpr uint64_t fnvOffset = 14695981039346656037ull;
+inline constexpr uint64_t fnvPrime = 1099511628211ull;
+inline constexpr int binarySchemaDepth = 16;
+
+constexpr uint64_t schemaMix(uint64_t h, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i)
+        h = (h ^ ((v >> (8 * i)) & 0xFF)) * fnvPrime;
+    return h;
+}
+
+constexpr uint64_t schemaMix(uint64_t h, std::string_view s)
+{
+    h = schemaMix(h, s.size());
+    for (char c : s)
+        h = (h ^ static_cast<uint8_t>(c)) * fnvPrime;
+    return h;
+}
+
+template <typename T, int Depth = 0> constexpr uint64_t binarySchemaHash(uint64_t h = fnvOffset);
+
+template <int D, IntegerType T> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<T>);
+template <int D, FloatingPointType T> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<T>);
+template <int D> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<bool>);
+template <int D> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::string>);
+template <int D> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::string_view>);
+template <int D> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::span<const std::byte>>);
+template <int D> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::filesystem::path>);
+template <int D, RegisteredEnum EnumT> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<EnumT>);
+template <int D, typename T> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::vector<T>>);
+template <int D, typename T> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::deque<T>>);
+template <int D, typename T> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::set<T>>);
+template <int D, typename K, typename V> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::map<K, V>>);
+template <int D, typename K, typename V> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::unordered_map<K, V>>);
+template <int D, typename T> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::optional<T>>);
+template <int D, typename... Types> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::variant<Types...>>);
+template <int D, typename K, typename V> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::pair<K, V>>);
+template <int D, typename... Args> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::tuple<Args...>>);
+template <int D, HasFields T> constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<T>);
+
+template <int D, IntegerType T>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<T>)
+{
+    return schemaMix(schemaMix(h, std::is_signed_v<T> ? 'i' : 'u'), sizeof(T));
+}
+
+template <int D, FloatingPointType T>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<T>)
+{
+    return schemaMix(schemaMix(h, 'f'), std::is_same_v<T, float> ? 4 : 8);
+}
+
+template <int D>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<bool>)
+{
+    return schemaMix(h, 'b');
+}
+
+template <int D>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::string>)
+{
+    return schemaMix(h, 's');
+}
+
+// Borrowed text has the same schema as std::string, so either can read the other
+template <int D>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::string_view>)
+{
+    return schemaMix(h, 's');
+}
+
+template <int D>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::span<const std::byte>>)
+{
+    return schemaMix(h, 'y');
+}
+
+template <int D>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::filesystem::path>)
+{
+    return schemaMix(h, 's');
+}
+
+template <int D, RegisteredEnum EnumT>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<EnumT>)
+{
+    return schemaMix(h, 'e');
+}
+
+template <int D, typename T>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::vector<T>>)
+{
+    return binarySchemaHash<T, D + 1>(schemaMix(h, 'q'));
+}
+
+template <int D, typename T>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::deque<T>>)
+{
+    return binarySchemaHash<T, D + 1>(schemaMix(h, 'q'));
+}
+
+template <int D, typename T>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::set<T>>)
+{
+    return binarySchemaHash<T, D + 1>(schemaMix(h, 'q'));
+}
+
+template <int D, typename K, typename V>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::map<K, V>>)
+{
+    return binarySchemaHash<V, D + 1>(binarySchemaHash<K, D + 1>(schemaMix(h, 'm')));
+}
+
+template <int D, typename K, typename V>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::unordered_map<K, V>>)
+{
+    return binarySchemaHash<V, D + 1>(binarySchemaHash<K, D + 1>(schemaMix(h, 'm')));
+}
+
+template <int D, typename T>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::optional<T>>)
+{
+    return binarySchemaHash<T, D + 1>(schemaMix(h, 'o'));
+}
+
+template <int D, typename... Types>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::variant<Types...>>)
+{
+    h = schemaMix(schemaMix(h, 'v'), sizeof...(Types));
+    ((h = binarySchemaHash<Types, D + 1>(h)), ...);
+    return h;
+}
+
+template <int D, typename K, typename V>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::pair<K, V>>)
+{
+    return binarySchemaHash<V, D + 1>(binarySchemaHash<K, D + 1>(schemaMix(schemaMix(h, 't'), 2)));
+}
+
+template <int D, typename... Args>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<std::tuple<Args...>>)
+{
+    h = schemaMix(schemaMix(h, 't'), sizeof...(Args));
+    ((h = binarySchemaHash<Args, D + 1>(h)), ...);
+    return h;
+}
+
+template <int D, HasFields T>
+constexpr uint64_t binarySchemaOf(uint64_t h, std::type_identity<T>)
+{
+    h = schemaMix(h, PackedBinary<T> ? 'P' : 'S');
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (..., [&]
+         {
+             const auto& field = std::get<I>(get_fields<T>());
+             using M = typename std::decay_t<decltype(field)>::MemberType;
+             h = schemaMix(schemaMix(h, BinaryFields<T>::tags[I]), std::string_view(field.fieldName));
+             h = binarySchemaHash<M, D + 1>(h);
+         }());
+    }(std::make_index_sequence<field_count_v<T>>{});
+    return schemaMix(h, 'E');
+}
+
+template <typename T, int Depth>
+constexpr uint64_t binarySchemaHash(uint64_t h)
+{
+    if constexpr (Depth > binarySchemaDepth)
+        return schemaMix(h, '~');
+    else
+        return binarySchemaOf<Depth>(h, std::type_identity<T>{});
+}
+
+// The fingerprint written into every toBinary() header for T
+template <typename T>
+uint64_t binaryFingerprint()
+{
+    if constexpr (requires { typename std::integral_constant<uint64_t, binarySchemaHash<T>()>; })
+    {
+        return std::integral_constant<uint64_t, binarySchemaHash<T>()>::value;
+    }
+    else
+    {
+        static const uint64_t fingerprint = binarySchemaHash<T>();
+        return fingerprint;
+    }
+}
+
+// ============================================================================
+// ENCODING
+// ============================================================================
+
+template <IntegerType T> void encodeBinary(const T& obj, BinaryWriter& w);
+template <FloatingPointType T> void encodeBinary(const T& obj, BinaryWriter& w);
+inline void encodeBinary(const bool& obj, BinaryWriter& w);
+inline void encodeBinary(const std::string& obj, BinaryWriter& w);
+inline void encodeBinary(const std::string_view& obj, BinaryWriter& w);
+inline void encodeBinary(const std::span<const std::byte>& obj, BinaryWriter& w);
+inline void encodeBinary(const std::filesystem::path& obj, BinaryWriter& w);
+template <RegisteredEnum EnumT> void encodeBinary(const EnumT& obj, BinaryWriter& w);
+template <typename T> void encodeBinary(const std::vector<T>& obj, BinaryWriter& w);
+template <typename T> void encodeBinary(const std::deque<T>& obj, BinaryWriter& w);
+template <typename T> void encodeBinary(const std::set<T>& obj, BinaryWriter& w);
+template <typename K, typename V> void encodeBinary(const std::map<K, V>& obj, BinaryWriter& w);
+template <typename K, typename V> void encodeBinary(const std::unordered_map<K, V>& obj, BinaryWriter& w);
+template <typename T> void encodeBinary(const std::optional<T>& obj, BinaryWriter& w);
+template <typename... Types> void encodeBinary(const std::variant<Types...>& obj, BinaryWriter& w);
+template <typename K, typename V> void encodeBinary(const std::pair<K, V>& obj, BinaryWriter& w);
+template <typename... Args> void encodeBinary(const std::tuple<Args...>& obj, BinaryWriter& w);
+template <HasFields T> void encodeBinary(const T& obj, BinaryWriter& w);
+
+template <IntegerType T>
+void encodeBinary(const T& obj, BinaryWriter& w)
+{
+    if constexpr (std::is_signed_v<T>)
+        w.varint(zigzagEncode(obj));
+    else
+        w.varint(obj);
+}
+
+template <FloatingPointType T>
+void encodeBinary(const T& obj, BinaryWriter& w)
+{
+    if constexpr (std::is_same_v<T, float>)
+        w.fixed32(std::bit_cast<uint32_t>(obj));
+    else
+        w.fixed64(std::bit_cast<uint64_t>(static_cast<double>(obj)));
+}
+
+inline void encodeBinary(const bool& obj, BinaryWriter& w)
+{
+    w.put(obj ? 1 : 0);
+}
+
+inline void encodeBinary(const std::string& obj, BinaryWriter& w)
+{
+    w.varint(obj.size());
+    w.bytes(obj.data(), obj.size());
+}
+
+inline void encodeBinary(const std::string_view& obj, BinaryWriter& w)
+{
+    w.varint(obj.size());
+    w.bytes(obj.data(), obj.size());
+}
+
+inline void encodeBinary(const std::span<const std::byte>& obj, BinaryWriter& w)
+{
+    w.varint(obj.size());
+    w.bytes(reinterpret_cast<const char*>(obj.data()), obj.size());
+}
+
+inline void encodeBinary(const std::filesystem::path& obj, BinaryWriter& w)
+{
+    encodeBinary(obj.string(), w);
+}
+
+template <RegisteredEnum EnumT>
+void encodeBinary(const EnumT& obj, BinaryWriter& w)
+{
+    w.varint(zigzagEncode(static_cast<int64_t>(static_cast<std::underlying_type_t<EnumT>>(obj))));
+}
+
+template <typename C>
+void encodeBinarySequence(const C& obj, BinaryWriter& w)
+{
+    using T = typename C::value_type;
+    if constexpr (PackedBinary<T>)
+    {
+        size_t bytes = obj.size() * sizeof(T);
+        w.varint(varintSize(obj.size()) + bytes);
+        w.varint(obj.size());
+        if constexpr (std::ranges::contiguous_range<C>)
+        {
+            if (packedAsMemory<T>() && podFieldsInOrder<T>())
+                return w.bytes(reinterpret_cast<const char*>(obj.data()), bytes);
+        }
+        char record[sizeof(T)];
+        for (const T& elem : obj)
+        {
+            packRecord(elem, record);
+            w.bytes(record, sizeof(T));
+        }
+        return;
+    }
+    size_t start = w.beginDelimited();
+    w.varint(obj.size());
+    for (const auto& elem : obj)
+        encodeBinary(elem, w);
+    w.endDelimited(start);
+}
+
+template <typename T>
+void encodeBinary(const std::vector<T>& obj, BinaryWriter& w)
+{
+    encodeBinarySequence(obj, w);
+}
+
+template <typename T>
+void encodeBinary(const std::deque<T>& obj, BinaryWriter& w)
+{
+    encodeBinarySequence(obj, w);
+}
+
+template <typename T>
+void encodeBinary(const std::set<T>& obj, BinaryWriter& w)
+{
+    encodeBinarySequence(obj, w);
+}
+
+template <typename C>
+void encodeBinaryMap(const C& obj, BinaryWriter& w)
+{
+    size_t start = w.beginDelimited();
+    w.varint(obj.size());
+    for (const auto& [k, v] : obj)
+    {
+        encodeBinary(k, w);
+        encodeBinary(v, w);
+    }
+    w.endDelimited(start);
+}
+
+template <typename K, typename V>
+void encodeBinary(const std::map<K, V>& obj, BinaryWriter& w)
+{
+    encodeBinaryMap(obj, w);
+}
+
+template <typename K, typename V>
+void encodeBinary(const std::unordered_map<K, V>& obj, BinaryWriter& w)
+{
+    encodeBinaryMap(obj, w);
+}
+
+// Optional elements carry a presence byte; optional struct fields are
+// simply left out when empty (see encodeBinaryField)
+template <typename T>
+void encodeBinary(const std::optional<T>& obj, BinaryWriter& w)
+{
+    size_t start = w.beginDelimited();
+    w.put(obj ? 1 : 0);
+    if (obj)
+        encodeBinary(*obj, w);
+    w.endDelimited(start);
+}
+
+template <typename... Types>
+void encodeBinary(const std::variant<Types...>& obj, BinaryWriter& w)
+{
+    size_t start = w.beginDelimited();
+    w.varint(obj.index());
+    std::visit([&](const auto& value) { encodeBinary(value, w); }, obj);
+    w.endDelimited(start);
+}
+
+template <typename K, typename V>
+void encodeBinary(const std::pair<K, V>& obj, BinaryWriter& w)
+{
+    size_t start = w.beginDelimited();
+    encodeBinary(obj.first, w);
+    encodeBinary(obj.second, w);
+    w.endDelimited(start);
+}
+
+template <typename... Args>
+void encodeBinary(const std::tuple<Args...>& obj, BinaryWriter& w)
+{
+    size_t start = w.beginDelimited();
+    std::apply([&](const auto&... args) { (..., encodeBinary(args, w)); }, obj);
+    w.endDelimited(start);
+}
+
+template <typename T, size_t I>
+void encodeBinaryField(const T& obj, BinaryWriter& w)
+{
+    const auto& field = std::get<I>(get_fields<T>());
+    using M = typename std::decay_t<decltype(field)>::MemberType;
+    constexpr uint64_t key = (uint64_t(BinaryFields<T>::tags[I]) << 2) | uint64_t(binaryFieldWireOf<M>());
+
+    const auto& value = obj.*(field.memberPtr);
+    if constexpr (is_optional_v<M>)
+    {
+        if (!value)
+            return;
+        w.varint(key);
+        encodeBinary(*value, w);
+    }
+    else
+    {
+        w.varint(key);
+        encodeBinary(value, w);
+    }
+}
+
+template <HasFields T>
+void encodeBinary(const T& obj, BinaryWriter& w)
+{
+    if constexpr (PackedBinary<T>)
+    {
+        char record[sizeof(T)];
+        packRecord(obj, record);
+        w.varint(sizeof(T));
+        return w.bytes(record, sizeof(T));
+    }
+    size_t start = w.beginDelimited();
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (..., encodeBinaryField<T, I>(obj, w));
+    }(std::make_index_sequence<field_count_v<T>>{});
+    w.endDelimited(start);
+}
+
+// ============================================================================
+// DECODING
+// ============================================================================
+// decodeBinary(obj, reader, result) reads one value and adds its errors to
+// result with paths relative to that value; containers and structs then
+// re-root what a nested value added (prefixErrors), producing the same
+// paths as from(). Once the reader has failed every decoder returns at once.
+
+template <IntegerType T> void decodeBinary(T& obj, BinaryReader& r, ValidationResult& result);
+template <FloatingPointType T> void decodeBinary(T& obj, BinaryReader& r, ValidationResult& result);
+inline void decodeBinary(bool& obj, BinaryReader& r, ValidationResult& result);
+inline void decodeBinary(std::string& obj, BinaryReader& r, ValidationResult& result);
+inline void decodeBinary(std::string_view& obj, BinaryReader& r, ValidationResult& result);
+inline void decodeBinary(std::span<const std::byte>& obj, BinaryReader& r, ValidationResult& result);
+inline void decodeBinary(std::filesystem::path& obj, BinaryReader& r, ValidationResult& result);
+template <RegisteredEnum EnumT> void decodeBinary(EnumT& obj, BinaryReader& r, ValidationResult& result);
+template <typename T> void decodeBinary(std::vector<T>& obj, BinaryReader& r, ValidationResult& result);
+template <typename T> void decodeBinary(std::deque<T>& obj, BinaryReader& r, ValidationResult& result);
+template <typename T> void decodeBinary(std::set<T>& obj, BinaryReader& r, ValidationResult& result);
+template <typename K, typename V> void decodeBinary(std::map<K, V>& obj, BinaryReader& r, ValidationResult& result);
+template <typename K, typename V> void decodeBinary(std::unordered_map<K, V>& obj, BinaryReader& r, ValidationResult& result);
+template <typename T> void decodeBinary(std::optional<T>& obj, BinaryReader& r, ValidationResult& result);
+template <typename... Types> void decodeBinary(std::variant<Types...>& obj, BinaryReader& r, ValidationResult& result);
+template <typename K, typename V> void decodeBinary(std::pair<K, V>& obj, BinaryReader& r, ValidationResult& result);
+template <typename... Args> void decodeBinary(std::tuple<Args...>& obj, BinaryReader& r, ValidationResult& result);
+template <HasFields T> void decodeBinary(T& obj, BinaryReader& r, ValidationResult& result);
+
+// Puts a field name, map key or "[i]" in front of the errors added since
+// result.errors[first]
+inline void prefixErrors(ValidationResult& result, size_t first, std::string_view prefix)
+{
+    for (size_t i = first; i < result.errors.size(); ++i)
+    {
+        auto& path = result.errors[i].first;
+        path = std::string(prefix) + (path.empty() ? "" : "." + path);
+    }
+}
+
+inline std::string elementPath(uint64_t i)
+{
+    return "[" + std::to_string(i) + "]";
+}
+
+template <IntegerType T>
+void decodeBinary(T& obj, BinaryReader& r, ValidationResult& result)
+{
+    uint64_t raw;
+    if (!r.varint(raw, result))
+        return;
+
+    if constexpr (std::is_signed_v<T>)
+    {
+        int64_t v = zigzagDecode(raw);
+        if (v < std::numeric_limits<T>::min() || v > std::numeric_limits<T>::max())
+            return result.addError("", "Integer out of range: " + std::to_string(v));
+        obj = static_cast<T>(v);
+    }
+    else
+    {
+        if (raw > std::numeric_limits<T>::max())
+            return result.addError("", "Integer out of range: " + std::to_string(raw));
+        obj = static_cast<T>(raw);
+    }
+}
+
+template <FloatingPointType T>
+void decodeBinary(T& obj, BinaryReader& r, ValidationResult& result)
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        uint32_t bits;
+        if (r.fixed32(bits, result))
+            obj = std::bit_cast<float>(bits);
+    }
+    else
+    {
+        uint64_t bits;
+        if (r.fixed64(bits, result))
+            obj = static_cast<T>(std::bit_cast<double>(bits));
+    }
+}
+
+inline void decodeBinary(bool& obj, BinaryReader& r, ValidationResult& result)
+{
+    uint64_t v;
+    if (!r.varint(v, result))
+        return;
+    if (v > 1)
+        return result.addError("", "Expected 0 or 1 for bool");
+    obj = v == 1;
+}
+
+inline void decodeBinary(std::string& obj, BinaryReader& r, ValidationResult& result)
+{
+    std::string_view bytes;
+    if (r.lengthPrefixed(bytes, result))
+        obj.assign(bytes);
+}
+
+// Views into the fromBinary buffer
+inline void decodeBinary(std::string_view& obj, BinaryReader& r, ValidationResult& result)
+{
+    r.lengthPrefixed(obj, result);
+}
+
+inline void decodeBinary(std::span<const std::byte>& obj, BinaryReader& r, ValidationResult& result)
+{
+    std::string_view bytes;
+    if (r.lengthPrefixed(bytes, result))
+        obj = std::as_bytes(std::span(bytes.data(), bytes.size()));
+}
+
+inline void decodeBinary(std::filesystem::path& obj, BinaryReader& r, ValidationResult& result)
+{
+    std::string_view bytes;
+    if (r.lengthPrefixed(bytes, result))
+        obj = std::filesystem::path(bytes);
+}
+
+template <RegisteredEnum EnumT>
+void decodeBinary(EnumT& obj, BinaryReader& r, ValidationResult& result)
+{
+    uint64_t raw;
+    if (!r.varint(raw, result))
+        return;
+    auto value = static_cast<EnumT>(static_cast<std::underlying_type_t<EnumT>>(zigzagDecode(raw)));
+    if (EnumMapping<EnumT>::Type::contains(value))
+    {
+        obj = value;
+        return;
+    }
+    result.addError("", "Unknown enum value: " + std::to_string(zigzagDecode(raw)) +
+                            ". Valid values are: " + EnumMapping<EnumT>::Type::validValues());
+}
+
+// Reads the count of a sequence or map; every element takes at least one
+// byte, which bounds what a corrupt count can make us reserve
+inline bool readBinaryCount(BinaryReader& r, uint64_t& count, ValidationResult& result)
+{
+    if (!r.varint(count, result))
+        return false;
+    return count <= r.remaining() || r.fail(result, "Element count exceeds the data");
+}
+
+// A count and then the packed records back to back
+template <typename C>
+void decodePackedSequence(C& obj, BinaryReader& r, ValidationResult& result)
+{
+    using T = typename C::value_type;
+    const char* outer;
+    uint64_t count;
+    const char* in;
+    if (!r.enter(outer, result) || !r.varint(count, result))
+        return;
+    if (count > r.remaining() / sizeof(T) || r.remaining() != count * sizeof(T))
+        return static_cast<void>(r.fail(result, "Packed sequence size mismatch"));
+    r.raw(count * sizeof(T), in, result);
+    r.leave(outer);
+
+    if constexpr (std::ranges::contiguous_range<C> && requires { obj.resize(count); })
+    {
+        if (!packedNeedsChecks<T> && packedAsMemory<T>() && podFieldsInOrder<T>())
+        {
+            obj.resize(count);
+            return static_cast<void>(std::memcpy(obj.data(), in, count * sizeof(T)));
+        }
+    }
+    if constexpr (requires { obj.reserve(count); })
+        obj.reserve(count);
+    for (uint64_t i = 0; i < count; ++i, in += sizeof(T))
+    {
+        size_t first = result.errors.size();
+        T elem{};
+        if (!unpackRecord(elem, in, result))
+            prefixErrors(result, first, elementPath(i));
+        else if constexpr (requires { obj.push_back(elem); })
+            obj.push_back(elem);
+        else
+            obj.insert(elem);
+    }
+}
+
+// Same contract as from() for sequences: invalid elements are left out and
+// their errors reported under "[i]"
+template <typename C>
+void decodeBinarySequence(C& obj, BinaryReader& r, ValidationResult& result)
+{
+    using T = typename C::value_type;
+    obj.clear();
+    if constexpr (PackedBinary<T>)
+        return decodePackedSequence(obj, r, result);
+    const char* outer;
+    uint64_t count;
+    if (!r.enter(outer, result) || !readBinaryCount(r, count, result))
+        return;
+    if constexpr (requires { obj.reserve(count); })
+        obj.reserve(count);
+
+    for (uint64_t i = 0; i < count && !r.failed(); ++i)
+    {
+        size_t first = result.errors.size();
+        T elem{};
+        decodeBinary(elem, r, result);
+        if (result.errors.size() != first)
+            prefixErrors(result, first, elementPath(i));
+        else if constexpr (requires { obj.push_back(std::move(elem)); })
+            obj.push_back(std::move(elem));
+        else
+            obj.insert(std::move(elem));
+    }
+    r.leave(outer);
+}
+
+template <typename T>
+void decodeBinary(std::vector<T>& obj, BinaryReader& r, ValidationResult& result)
+{
+    decodeBinarySequence(obj, r, result);
+}
+
+template <typename T>
+void decodeBinary(std::deque<T>& obj, BinaryReader& r, ValidationResult& result)
+{
+    decodeBinarySequence(obj, r, result);
+}
+
+template <typename T>
+void decodeBinary(std::set<T>& obj, BinaryReader& r, ValidationResult& result)
+{
+    decodeBinarySequence(obj, r, result);
+}
+
+// Entries with errors are left out and reported under their key (string
+// keys) or their position
+template <typename C>
+void decodeBinaryMap(C& obj, BinaryReader& r, ValidationResult& result)
+{
+    using K = typename C::key_type;
+    using V = typename C::mapped_type;
+    obj.clear();
+    const char* outer;
+    uint64_t count;
+    if (!r.enter(outer, result) || !readBinaryCount(r, count, result))
+        return;
+
+    for (uint64_t i = 0; i < count && !r.failed(); ++i)
+    {
+        size_t first = result.errors.size();
+        K key{};
+        V value{};
+        decodeBinary(key, r, result);
+        decodeBinary(value, r, result);
+        if (result.errors.size() == first)
+            obj[std::move(key)] = std::move(value);
+        else if constexpr (std::is_same_v<K, std::string>)
+            prefixErrors(result, first, key);
+        else
+            prefixErrors(result, first, elementPath(i));
+    }
+    r.leave(outer);
+}
+
+template <typename K, typename V>
+void decodeBinary(std::map<K, V>& obj, BinaryReader& r, ValidationResult& result)
+{
+    decodeBinaryMap(obj, r, result);
+}
+
+template <typename K, typename V>
+void decodeBinary(std::unordered_map<K, V>& obj, BinaryReader& r, ValidationResult& result)
+{
+    decodeBinaryMap(obj, r, result);
+}
+
+template <typename T>
+void decodeBinary(std::optional<T>& obj, BinaryReader& r, ValidationResult& result)
+{
+    const char* outer;
+    uint64_t present;
+    if (!r.enter(outer, result) || !r.varint(present, result))
+        return;
+    obj = std::nullopt;
+    if (present)
+    {
+        size_t first = result.errors.size();
+        T value{};
+        decodeBinary(value, r, result);
+        if (result.errors.size() == first)
+            obj = std::move(value);
+    }
+    r.leave(outer);
+}
+
+template <typename... Types>
+void decodeBinary(std::variant<Types...>& obj, BinaryReader& r, ValidationResult& result)
+{
+    const char* outer;
+    uint64_t index;
+    if (!r.enter(outer, result) || !r.varint(index, result))
+        return;
+    if (index >= sizeof...(Types))
+    {
+        result.addError("", "Variant index out of range: " + std::to_string(index));
+    }
+    else
+    {
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (void)((index == I && (decodeBinary(obj.template emplace<I>(), r, result), true)) || ...);
+        }(std::index_sequence_for<Types...>{});
+    }
+    r.leave(outer);
+}
+
+template <typename K, typename V>
+void decodeBinary(std::pair<K, V>& obj, BinaryReader& r, ValidationResult& result)
+{
+    const char* outer;
+    if (!r.enter(outer, result))
+        return;
+    size_t first = result.errors.size();
+    decodeBinary(obj.first, r, result);
+    prefixErrors(result, first, "[0]");
+    first = result.errors.size();
+    decodeBinary(obj.second, r, result);
+    prefixErrors(result, first, "[1]");
+    r.leave(outer);
+}
+
+template <typename... Args>
+void decodeBinary(std::tuple<Args...>& obj, BinaryReader& r, ValidationResult& result)
+{
+    const char* outer;
+    if (!r.enter(outer, result))
+        return;
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (..., [&]
+         {
+             size_t first = result.errors.size();
+             decodeBinary(std::get<I>(obj), r, result);
+             prefixErrors(result, first, elementPath(I));
+         }());
+    }(std::index_sequence_for<Args...>{});
+    r.leave(outer);
+}
+
+template <typename T>
+struct BinaryFieldReader
+{
+    using Handler = void (*)(T&, BinaryReader&, BinaryWire, ValidationResult&);
+
+    template <size_t I>
+    using Member = typename BinaryFields<T>::template FieldAt<I>::MemberType;
+
+    template <size_t I>
+    static constexpr uint64_t key = (uint64_t(BinaryFields<T>::tags[I]) << 2) | uint64_t(binaryFieldWireOf<Member<I>>());
+
+    // Reads field I's value (its key already consumed) and validates it
+    template <size_t I>
+    static void read(T& obj, BinaryReader& r, ValidationResult& result)
+    {
+        const auto& field = std::get<I>(get_fields<T>());
+        auto& member = obj.*(field.memberPtr);
+        size_t first = result.errors.size();
+        if constexpr (is_optional_v<Member<I>>)
+        {
+            typename Member<I>::value_type value{};
+            decodeBinary(value, r, result);
+            if (result.errors.size() == first)
+                member = std::move(value);
+        }
+        else
+        {
+            decodeBinary(member, r, result);
+        }
+        prefixErrors(result, first, field.fieldName);
+        if (!r.failed())
+            validateFieldAttributes(obj, field, result);
+    }
+
+    template <size_t I>
+    static void readAt(T& obj, BinaryReader& r, BinaryWire wire, ValidationResult& result)
+    {
+        if (wire == binaryFieldWireOf<Member<I>>())
+            return read<I>(obj, r, result);
+        result.addError(std::get<I>(get_fields<T>()).fieldName, "Wire type mismatch");
+        r.skip(wire, result);
+    }
+
+    static constexpr auto handlers = []<size_t... I>(std::index_sequence<I...>)
+    {
+        return std::array<Handler, sizeof...(I)>{&readAt<I>...};
+    }(std::make_index_sequence<field_count_v<T>>{});
+};
+
+template <HasFields T>
+void decodeBinary(T& obj, BinaryReader& r, ValidationResult& result)
+{
+    using Fields = BinaryFields<T>;
+    using Reader = BinaryFieldReader<T>;
+    const char* outer;
+    if (!r.enter(outer, result))
+        return;
+    if constexpr (PackedBinary<T>)
+    {
+        const char* in;
+        if (r.remaining() != sizeof(T))
+            return static_cast<void>(r.fail(result, "Packed struct size mismatch"));
+        r.raw(sizeof(T), in, result);
+        r.leave(outer);
+        unpackRecord(obj, in, result);
+        return;
+    }
+
+    // Fast path: the fields in declaration order, as toBinary() writes
+    // them, with absent optionals passed over. Whatever follows (other
+    // writers' orders, unknown tags) goes through the keyed loop below.
+    std::array<bool, Fields::count> seen{};
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (void)(... && [&]
+        {
+            if (!r.nextKeyIs(Reader::template key<I>))
+                return is_optional_v<typename Reader::template Member<I>>;
+            seen[I] = true;
+            Reader::template read<I>(obj, r, result);
+            return !r.failed();
+        }());
+    }(std::make_index_sequence<Fields::count>{});
+
+    size_t hint = 0;
+    while (!r.atEnd())
+    {
+        uint64_t key;
+        if (!r.varint(key, result))
+            return;
+        auto wire = static_cast<BinaryWire>(key & 3);
+        int idx = key >> 2 <= UINT32_MAX ? Fields::find(static_cast<uint32_t>(key >> 2), hint) : -1;
+        if (idx < 0)
+        {
+            if (!r.skip(wire, result))
+                return;
+            unknownField<T>(key >> 2, result);
+            continue;
+        }
+        seen[idx] = true;
+        hint = static_cast<size_t>(idx) + 1;
+        Reader::handlers[idx](obj, r, wire, result);
+        if (r.failed())
+            return;
+    }
+
+    size_t i = 0;
+    std::apply([&](auto&&... fields) {
+        (..., [&](auto& field) {
+            if (!seen[i++] && field.requirement == Requirement::Required)
+                result.addError(field.fieldName, "Missing required field");
+        }(fields));
+    }, get_fields<T>());
+    r.leave(outer);
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+struct BinaryReadOptions
+{
+    // Fail unless the header's fingerprint matches binaryFingerprint<T>()
+    bool requireSameSchema = false;
+};
+
+template <typename T>
+void toBinary(const T& obj, BinaryWriter& w)
+{
+    w.bytes(binaryMagic, 2);
+    w.put(binaryVersion);
+    w.fixed64(binaryFingerprint<T>());
+    encodeBinary(obj, w);
+}
+
+template <typename T>
+std::string toBinary(const T& obj)
+{
+    BinaryWriter w;
+    toBinary(obj, w);
+    return w.take();
+}
+
+template <typename T>
+void toBinary(const T& obj, OutputSink& sink)
+{
+    BinaryWriter w;
+    toBinary(obj, w);
+    sink.write(w.view());
+    sink.flush();
+}
+
+// The fingerprint stored in a toBinary() document, if data is one
+inline std::optional<uint64_t> binaryFingerprintOf(std::string_view data)
+{
+    if (data.size() < binaryHeaderSize || data[0] != binaryMagic[0] || data[1] != binaryMagic[1] ||
+        static_cast<uint8_t>(data[2]) != binaryVersion)
+        return std::nullopt;
+    uint64_t fingerprint = 0;
+    for (int i = 0; i < 8; ++i)
+        fingerprint |= static_cast<uint64_t>(static_cast<uint8_t>(data[3 + i])) << (8 * i);
+    return fingerprint;
+}
+
+template <typename T>
+std::pair<std::optional<T>, ValidationResult> fromBinary(std::string_view data, const BinaryReadOptions& options = {})
+{
+    ValidationResult result;
+    auto fingerprint = binaryFingerprintOf(data);
+    if (!fingerprint)
+    {
+        result.addError("binary", "Not a meta binary document");
+        return {std::nullopt, std::move(result)};
+    }
+    if (options.requireSameSchema && *fingerprint != binaryFingerprint<T>())
+    {
+        result.addError("binary", "Schema fingerprint mismatch");
+        return {std::nullopt, std::move(result)};
+    }
+
+    BinaryReader r(data.data() + binaryHeaderSize, data.size() - binaryHeaderSize);
+    T obj{};
+    decodeBinary(obj, r, result);
+    if (result.valid && !r.atEnd())
+        result.addError("binary", "Unexpected data after the value");
+    if (!result.valid)
+        return {std::nullopt, std::move(result)};
+    return {std::optional<T>(std::move(obj)), std::move(result)};
+}
+
+// toBinary and fromBinary, for META_EXTERN_TEMPLATES / META_INSTANTIATE_TEMPLATES in meta.h
+#define META_BINARY_TEMPLATES(prefix, ...)                                                                            \
+    prefix void meta::toBinary<__VA_ARGS__>(const __VA_ARGS__&, meta::BinaryWriter&);                                 \
+    prefix std::string meta::toBinary<__VA_ARGS__>(const __VA_ARGS__&);                                               \
+    prefix void meta::toBinary<__VA_ARGS__>(const __VA_ARGS__&, meta::OutputSink&);                                   \
+    prefix std::pair<std::optional<__VA_ARGS__>, meta::ValidationResult> meta::fromBinary<__VA_ARGS__>(               \
+        std::string_view, const meta::BinaryReadOptions&)
+
+} // namespace meta
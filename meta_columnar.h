@@ -0,0 +1,640 @@
+/*
+ * meta_columnar.h - Memory-mapped columnar files for vectors of reflected structs
+ *
+ * Writes a std::vector<T> as one contiguous column per field, laid out
+ * from the same FieldsMeta table meta_csv.h uses for its rows, and reads
+ * it back through mmap without parsing: each column is a typed view
+ * straight into the mapped pages, so scanning one column of a large file
+ * only touches that column's pages.
+ *
+ * Supports:
+ * - Integer, floating point and registered enum fields as fixed-width
+ *   columns (std::span<const double> for a double field)
+ * - bool fields as one byte per row (std::span<const uint8_t>)
+ * - std::string fields as row offsets plus one blob (StringColumn)
+ * - Columns matched by field name, so files with extra columns, or with
+ *   columns in another order, still open
+ *
+ * Usage:
+ *   #include "meta_columnar.h"
+ *
+ *   meta::writeColumnarFile(trades, "trades.col");
+ *
+ *   auto [table, result] = meta::openColumnar<Trade>("trades.col");
+ *   double total = 0;
+ *   for (double price : table->column<&Trade::price>())
+ *       total += price;
+ *   std::string_view venue = table->column<&Trade::venue>()[42];
+ *   Trade t = table->row(42);
+ *
+ * Layout (native byte order, recorded in the header):
+ *   'M' 'C' version byte-order, u32 column count, u64 row count
+ *   per column: u8 kind, u8 width, u16 name length, u32 reserved,
+ *               u64 offset, u64 size, name padded to 8 bytes
+ *   column data, each starting on a 64-byte boundary
+ *     fixed width   rows * width bytes
+ *     string        u64 offsets[rows + 1], then the concatenated bytes
+ *
+ * Fields of any other type are rejected at compile time.
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "meta.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace meta
+{
+
+// ============================================================================
+// COLUMN TYPES
+// ============================================================================
+
+enum class ColumnKind : uint8_t
+{
+    Signed = 1,
+    Unsigned = 2,
+    Float = 3,
+    Bool = 4,
+    Enum = 5,
+    String = 6
+};
+
+inline constexpr char columnarMagic[2] = {'M', 'C'};
+inline constexpr uint8_t columnarVersion = 1;
+inline constexpr uint8_t columnarByteOrder = std::endian::native == std::endian::little ? 1 : 2;
+inline constexpr size_t columnarHeaderSize = 16;
+inline constexpr size_t columnarEntrySize = 24;
+inline constexpr size_t columnarAlignment = 64;
+
+template <typename T>
+concept ColumnarScalar = IntegerType<T> || FloatingPointType<T> || std::is_same_v<T, bool> || RegisteredEnum<T>;
+
+template <typename T>
+concept ColumnarType = ColumnarScalar<T> || std::is_same_v<T, std::string>;
+
+// What a fixed-width column holds in the file and in its view
+template <ColumnarScalar M>
+using ColumnStorage = std::conditional_t<std::is_same_v<M, bool>, uint8_t, M>;
+
+template <ColumnarType M>
+constexpr ColumnKind columnKindOf()
+{
+    if constexpr (std::is_same_v<M, std::string>)
+        return ColumnKind::String;
+    else if constexpr (std::is_same_v<M, bool>)
+        return ColumnKind::Bool;
+    else if constexpr (RegisteredEnum<M>)
+        return ColumnKind::Enum;
+    else if constexpr (FloatingPointType<M>)
+        return ColumnKind::Float;
+    else if constexpr (std::is_signed_v<M>)
+        return ColumnKind::Signed;
+    else
+        return ColumnKind::Unsigned;
+}
+
+template <ColumnarType M>
+constexpr uint8_t columnWidthOf()
+{
+    if constexpr (std::is_same_v<M, std::string>)
+        return sizeof(uint64_t);
+    else
+        return sizeof(ColumnStorage<M>);
+}
+
+template <typename T>
+struct ColumnarFields
+{
+    using Tuple = std::decay_t<decltype(get_fields<T>())>;
+    static constexpr size_t count = field_count_v<T>;
+
+    template <size_t I>
+    using Member = typename std::tuple_element_t<I, Tuple>::MemberType;
+
+    static_assert([]<size_t... I>(std::index_sequence<I...>) { return (ColumnarType<Member<I>> && ...); }(
+                      std::make_index_sequence<count>{}),
+                  "Columnar fields must be integers, floating point, bool, registered enums or std::string");
+
+    // Position of the field declared with member pointer P
+    template <auto P>
+    static constexpr size_t indexOf()
+    {
+        size_t index = count;
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (..., [&]
+             {
+                 constexpr auto member = std::tuple_element_t<I, Tuple>::memberPtr;
+                 if constexpr (std::is_same_v<std::remove_cv_t<decltype(member)>, std::remove_cv_t<decltype(P)>>)
+                 {
+                     if (member == P)
+                         index = I;
+                 }
+             }());
+        }(std::make_index_sequence<count>{});
+        return index;
+    }
+};
+
+// ============================================================================
+// WRITING
+// ============================================================================
+
+namespace columnar_detail
+{
+
+constexpr uint64_t alignUp(uint64_t n)
+{
+    return (n + columnarAlignment - 1) & ~uint64_t(columnarAlignment - 1);
+}
+
+template <typename V>
+void putRaw(std::string& out, V v)
+{
+    char buf[sizeof(V)];
+    std::memcpy(buf, &v, sizeof(V));
+    out.append(buf, sizeof(V));
+}
+
+template <typename V>
+V getRaw(const char* p)
+{
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+inline void pad(OutputSink& sink, uint64_t& written, uint64_t to)
+{
+    static constexpr char zeros[columnarAlignment] = {};
+    while (written < to)
+    {
+        size_t n = static_cast<size_t>(std::min<uint64_t>(to - written, sizeof(zeros)));
+        sink.write(zeros, n);
+        written += n;
+    }
+}
+
+// Copies one field of every row into the sink through a small staging buffer
+template <typename T, size_t I>
+void writeColumn(const std::vector<T>& rows, OutputSink& sink)
+{
+    using M = typename ColumnarFields<T>::template Member<I>;
+    const auto& field = std::get<I>(get_fields<T>());
+
+    if constexpr (std::is_same_v<M, std::string>)
+    {
+        uint64_t offsets[512];
+        uint64_t offset = 0;
+        size_t n = 0;
+        auto push = [&](uint64_t v)
+        {
+            offsets[n++] = v;
+            if (n == std::size(offsets))
+            {
+                sink.write(reinterpret_cast<const char*>(offsets), sizeof(offsets));
+                n = 0;
+            }
+        };
+        push(0);
+        for (const T& row : rows)
+            push(offset += field.get(row).size());
+        sink.write(reinterpret_cast<const char*>(offsets), n * sizeof(uint64_t));
+        for (const T& row : rows)
+            sink.write(field.get(row));
+    }
+    else
+    {
+        using S = ColumnStorage<M>;
+        S values[4096 / sizeof(S)];
+        size_t n = 0;
+        for (const T& row : rows)
+        {
+            values[n++] = static_cast<S>(field.get(row));
+            if (n == std::size(values))
+            {
+                sink.write(reinterpret_cast<const char*>(values), sizeof(values));
+                n = 0;
+            }
+        }
+        sink.write(reinterpret_cast<const char*>(values), n * sizeof(S));
+    }
+}
+
+} // namespace columnar_detail
+
+template <HasFields T>
+void toColumnar(const std::vector<T>& rows, OutputSink& sink)
+{
+    using Fields = ColumnarFields<T>;
+    const uint64_t count = rows.size();
+
+    // Column sizes first: the directory in front records every offset
+    std::array<uint64_t, Fields::count> sizes{};
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (..., [&]
+         {
+             using M = typename Fields::template Member<I>;
+             if constexpr (std::is_same_v<M, std::string>)
+             {
+                 uint64_t bytes = 0;
+                 for (const T& row : rows)
+                     bytes += std::get<I>(get_fields<T>()).get(row).size();
+                 sizes[I] = (count + 1) * sizeof(uint64_t) + bytes;
+             }
+             else
+             {
+                 sizes[I] = count * sizeof(ColumnStorage<M>);
+             }
+         }());
+    }(std::make_index_sequence<Fields::count>{});
+
+    std::string header;
+    header.append(columnarMagic, 2);
+    header.push_back(static_cast<char>(columnarVersion));
+    header.push_back(static_cast<char>(columnarByteOrder));
+    columnar_detail::putRaw(header, static_cast<uint32_t>(Fields::count));
+    columnar_detail::putRaw(header, count);
+
+    uint64_t directorySize = 0;
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        ((directorySize += columnarEntrySize +
+                           ((std::string_view(std::get<I>(get_fields<T>()).fieldName).size() + 7) & ~size_t(7))),
+         ...);
+    }(std::make_index_sequence<Fields::count>{});
+
+    uint64_t offset = columnar_detail::alignUp(columnarHeaderSize + directorySize);
+    std::array<uint64_t, Fields::count> offsets{};
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (..., [&]
+         {
+             using M = typename Fields::template Member<I>;
+             std::string_view name = std::get<I>(get_fields<T>()).fieldName;
+             offsets[I] = offset;
+             header.push_back(static_cast<char>(columnKindOf<M>()));
+             header.push_back(static_cast<char>(columnWidthOf<M>()));
+             columnar_detail::putRaw(header, static_cast<uint16_t>(name.size()));
+             columnar_detail::putRaw(header, uint32_t(0));
+             columnar_detail::putRaw(header, offset);
+             columnar_detail::putRaw(header, sizes[I]);
+             header.append(name);
+             header.append(((name.size() + 7) & ~size_t(7)) - name.size(), '\0');
+             offset = columnar_detail::alignUp(offset + sizes[I]);
+         }());
+    }(std::make_index_sequence<Fields::count>{});
+
+    uint64_t written = header.size();
+    sink.write(header);
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (..., [&]
+         {
+             columnar_detail::pad(sink, written, offsets[I]);
+             columnar_detail::writeColumn<T, I>(rows, sink);
+             written += sizes[I];
+         }());
+    }(std::make_index_sequence<Fields::count>{});
+    sink.flush();
+}
+
+template <HasFields T>
+std::string toColumnar(const std::vector<T>& rows)
+{
+    StringSink sink;
+    toColumnar(rows, sink);
+    return sink.take();
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// Throws std::system_error if the file can't be created or written
+template <HasFields T>
+void writeColumnarFile(const std::vector<T>& rows, const std::filesystem::path& path)
+{
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), "writeColumnarFile: cannot create " + path.string());
+    try
+    {
+        FdSink sink(fd, 1 << 20);
+        toColumnar(rows, sink);
+    }
+    catch (...)
+    {
+        ::close(fd);
+        throw;
+    }
+    if (::close(fd) != 0)
+        throw std::system_error(errno, std::generic_category(), "writeColumnarFile: close failed");
+}
+#endif
+
+// ============================================================================
+// READING
+// ============================================================================
+
+#if defined(__unix__) || defined(__APPLE__)
+// A read-only mapping of a whole file, unmapped on destruction
+class MappedFile
+{
+  public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        if (base)
+            ::munmap(base, length);
+    }
+
+    static std::shared_ptr<const MappedFile> open(const std::filesystem::path& path, std::string& error)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            error = "Cannot open " + path.string() + ": " + std::strerror(errno);
+            return nullptr;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            error = "Cannot stat " + path.string() + ": " + std::strerror(errno);
+            ::close(fd);
+            return nullptr;
+        }
+        std::shared_ptr<MappedFile> file(new MappedFile);
+        file->length = static_cast<size_t>(st.st_size);
+        if (file->length > 0)
+        {
+            void* p = ::mmap(nullptr, file->length, PROT_READ, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                error = "Cannot map " + path.string() + ": " + std::strerror(errno);
+                ::close(fd);
+                return nullptr;
+            }
+            file->base = p;
+        }
+        ::close(fd);
+        return file;
+    }
+
+    std::string_view bytes() const { return {static_cast<const char*>(base), length}; }
+
+  private:
+    MappedFile() = default;
+
+    void* base = nullptr;
+    size_t length = 0;
+};
+#endif
+
+// One std::string field: row i is blob[offsets[i], offsets[i + 1])
+class StringColumn
+{
+  public:
+    StringColumn() = default;
+    StringColumn(const char* offsets, const char* blob, size_t rows, uint64_t blobSize)
+        : offsets(offsets), blob(blob), rows(rows), blobSize(blobSize)
+    {
+    }
+
+    size_t size() const { return rows; }
+    bool empty() const { return rows == 0; }
+
+    // Offsets are clamped to the blob, so a corrupt file can't read past it
+    std::string_view operator[](size_t i) const
+    {
+        uint64_t begin = std::min(columnar_detail::getRaw<uint64_t>(offsets + i * sizeof(uint64_t)), blobSize);
+        uint64_t end = std::min(columnar_detail::getRaw<uint64_t>(offsets + (i + 1) * sizeof(uint64_t)), blobSize);
+        return {blob + begin, static_cast<size_t>(std::max(begin, end) - begin)};
+    }
+
+  private:
+    const char* offsets = nullptr;
+    const char* blob = nullptr;
+    size_t rows = 0;
+    uint64_t blobSize = 0;
+};
+
+// Typed, zero-copy views over a columnar file holding std::vector<T>
+template <HasFields T>
+class ColumnarTable
+{
+    using Fields = ColumnarFields<T>;
+
+  public:
+    size_t size() const { return rows; }
+    bool empty() const { return rows == 0; }
+
+    // std::span<const ColumnStorage<M>> for fixed-width fields, StringColumn for strings
+    template <auto P>
+    auto column() const
+    {
+        constexpr size_t I = Fields::template indexOf<P>();
+        static_assert(I < Fields::count, "Member is not listed in FieldsMeta");
+        using M = typename Fields::template Member<I>;
+        if constexpr (std::is_same_v<M, std::string>)
+        {
+            return StringColumn(columns[I], columns[I] + (rows + 1) * sizeof(uint64_t), rows, blobSizes[I]);
+        }
+        else
+        {
+            using S = ColumnStorage<M>;
+            return std::span<const S>(reinterpret_cast<const S*>(columns[I]), rows);
+        }
+    }
+
+    // Materializes row i
+    T row(size_t i) const
+    {
+        T obj{};
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (..., [&]
+             {
+                 constexpr auto member = std::tuple_element_t<I, typename Fields::Tuple>::memberPtr;
+                 using M = typename Fields::template Member<I>;
+                 if constexpr (std::is_same_v<M, std::string>)
+                     obj.*member = std::string(column<member>()[i]);
+                 else if constexpr (std::is_same_v<M, bool>)
+                     obj.*member = column<member>()[i] != 0;
+                 else
+                     obj.*member = column<member>()[i];
+             }());
+        }(std::make_index_sequence<Fields::count>{});
+        return obj;
+    }
+
+    std::vector<T> rowsVector() const
+    {
+        std::vector<T> out;
+        out.reserve(rows);
+        for (size_t i = 0; i < rows; ++i)
+            out.push_back(row(i));
+        return out;
+    }
+
+  private:
+    template <HasFields U>
+    friend std::pair<std::optional<ColumnarTable<U>>, ValidationResult> readColumnar(std::string_view data);
+#if defined(__unix__) || defined(__APPLE__)
+    template <HasFields U>
+    friend std::pair<std::optional<ColumnarTable<U>>, ValidationResult> openColumnar(const std::filesystem::path& path);
+
+    std::shared_ptr<const MappedFile> file;
+#endif
+    size_t rows = 0;
+    std::array<const char*, Fields::count> columns{};
+    std::array<uint64_t, Fields::count> blobSizes{};
+};
+
+// Checks the header and directory against T and points a table at the
+// columns. Only the header, the directory and two offsets per string column
+// are read; data stays where it is and must outlive the table.
+template <HasFields T>
+std::pair<std::optional<ColumnarTable<T>>, ValidationResult> readColumnar(std::string_view data)
+{
+    using Fields = ColumnarFields<T>;
+    using columnar_detail::getRaw;
+    ValidationResult result;
+    auto fail = [&](std::string_view path, std::string_view message)
+    {
+        result.addError(path, message);
+        return std::pair<std::optional<ColumnarTable<T>>, ValidationResult>{std::nullopt, std::move(result)};
+    };
+
+    const char* base = data.data();
+    const uint64_t size = data.size();
+    if (size < columnarHeaderSize || base[0] != columnarMagic[0] || base[1] != columnarMagic[1] ||
+        static_cast<uint8_t>(base[2]) != columnarVersion)
+        return fail("columnar", "Not a meta columnar file");
+    if (static_cast<uint8_t>(base[3]) != columnarByteOrder)
+        return fail("columnar", "Byte order mismatch");
+
+    const uint32_t columnCount = getRaw<uint32_t>(base + 4);
+    const uint64_t rows = getRaw<uint64_t>(base + 8);
+
+    struct Entry
+    {
+        ColumnKind kind;
+        uint8_t width;
+        uint64_t offset;
+        uint64_t size;
+        std::string_view name;
+    };
+    std::vector<Entry> entries;
+    uint64_t pos = columnarHeaderSize;
+    for (uint32_t c = 0; c < columnCount; ++c)
+    {
+        if (size - pos < columnarEntrySize)
+            return fail("columnar", "Truncated column directory");
+        const char* e = base + pos;
+        Entry entry{static_cast<ColumnKind>(e[0]), static_cast<uint8_t>(e[1]), getRaw<uint64_t>(e + 8),
+                    getRaw<uint64_t>(e + 16), {}};
+        const uint64_t nameLength = getRaw<uint16_t>(e + 2);
+        pos += columnarEntrySize;
+        if (size - pos < nameLength)
+            return fail("columnar", "Truncated column directory");
+        entry.name = std::string_view(base + pos, nameLength);
+        pos += std::min((nameLength + 7) & ~uint64_t(7), size - pos);
+        if (entry.offset > size || entry.size > size - entry.offset)
+            return fail(entry.name, "Column extends past the end of the file");
+        entries.push_back(entry);
+    }
+
+    ColumnarTable<T> table;
+    table.rows = static_cast<size_t>(rows);
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (..., [&]
+         {
+             using M = typename Fields::template Member<I>;
+             const char* fieldName = std::get<I>(get_fields<T>()).fieldName;
+             auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry& e) { return e.name == fieldName; });
+             if (it == entries.end())
+             {
+                 result.addError(fieldName, "Missing column");
+                 return;
+             }
+             if (it->kind != columnKindOf<M>() || it->width != columnWidthOf<M>())
+             {
+                 result.addError(fieldName, "Column type mismatch");
+                 return;
+             }
+             const char* column = base + it->offset;
+             if constexpr (std::is_same_v<M, std::string>)
+             {
+                 if (rows >= it->size / sizeof(uint64_t))
+                 {
+                     result.addError(fieldName, "Column size does not match the row count");
+                     return;
+                 }
+                 const uint64_t offsetsSize = (rows + 1) * sizeof(uint64_t);
+                 if (getRaw<uint64_t>(column) != 0 ||
+                     getRaw<uint64_t>(column + rows * sizeof(uint64_t)) != it->size - offsetsSize)
+                 {
+                     result.addError(fieldName, "Corrupt string offsets");
+                     return;
+                 }
+                 table.blobSizes[I] = it->size - offsetsSize;
+             }
+             else
+             {
+                 if (it->size / sizeof(ColumnStorage<M>) != rows || it->size % sizeof(ColumnStorage<M>) != 0)
+                 {
+                     result.addError(fieldName, "Column size does not match the row count");
+                     return;
+                 }
+                 if (reinterpret_cast<uintptr_t>(column) % alignof(ColumnStorage<M>) != 0)
+                 {
+                     result.addError(fieldName, "Column is not aligned");
+                     return;
+                 }
+             }
+             table.columns[I] = column;
+         }());
+    }(std::make_index_sequence<Fields::count>{});
+
+    if (!result.valid)
+        return {std::nullopt, std::move(result)};
+    return {std::optional<ColumnarTable<T>>(std::move(table)), std::move(result)};
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// Maps path read-only; the table keeps the mapping alive
+template <HasFields T>
+std::pair<std::optional<ColumnarTable<T>>, ValidationResult> openColumnar(const std::filesystem::path& path)
+{
+    std::string error;
+    auto file = MappedFile::open(path, error);
+    if (!file)
+    {
+        ValidationResult result;
+        result.addError("columnar", error);
+        return {std::nullopt, std::move(result)};
+    }
+    auto opened = readColumnar<T>(file->bytes());
+    if (opened.first)
+        opened.first->file = std::move(file);
+    return opened;
+}
+#endif
+
+} // namespace meta
@@ -0,0 +1,582 @@
+/*
+ * meta_config.h - A YAML config file kept loaded, reloaded as it changes
+ *
+ * ConfigCache<T> owns the current version of a config read with
+ * reifyFromYaml and replaces it when the file changes. Readers take the
+ * version of the moment with get() and keep it for as long as they hold
+ * the pointer; they never wait on a reload.
+ *
+ * Supports:
+ * - Polling with reload(), or a watcher thread with watch(interval)
+ * - No read at all while the file's size and modification time are as
+ *   last seen, and no parse while its content hashes the same or only its
+ *   comments have changed
+ * - Incremental reparse: only the top-level sections whose text changed
+ *   are read, into a copy of the current version
+ * - Callbacks per field, run only when diff() finds that field changed,
+ *   and for the whole object with the JSON Patch between the versions
+ *
+ * Usage:
+ *   #include "meta_config.h"
+ *
+ *   meta::ConfigCache<Config> config("/etc/billing.yaml");
+ *   config.onChange<&Config::limits>([](const Limits& before, const Limits& after) { ... });
+ *   auto result = config.reload();           // first load
+ *   config.watch(std::chrono::seconds(2));   // then every two seconds
+ *
+ *   std::shared_ptr<const Config> now = config.get();   // from any thread
+ *
+ * A section is a key at column 0 of a block mapping and the lines below
+ * it; a changed section's member is reset to its default and read from
+ * the section alone. When the top-level keys can't be told apart that way
+ * (a flow mapping, a "---" marker, anchors or aliases that may reach
+ * across sections), a key has gone from the file or T reads itself
+ * through a Deser hook, the whole file is read into a fresh copy of the
+ * defaults instead. So is every file the first time.
+ *
+ * A version that fails to read or validate is never published: get()
+ * keeps returning the last good one and reload() returns the errors. Nor
+ * is one that diff() finds equal to the current version.
+ * A file that fails is read again on every poll until it reads.
+ * Callbacks run on the thread that reloads, after the new version is
+ * published and before reload() returns, without the cache's lock held;
+ * they may call get(), version(), stats() and onChange() but not
+ * reload() or watch().
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "meta.h"
+#include "meta_patch.h"
+
+namespace meta
+{
+
+// ============================================================================
+// SECTIONS
+// ============================================================================
+
+namespace config_detail
+{
+
+// A top-level key and the text from its line up to the next key
+struct Section
+{
+    std::string key;
+    std::string_view text;
+    uint64_t hash; // of its significant lines
+};
+
+// Anything that may be an anchor or an alias. Over-eager on purpose
+// ("a * b" counts): a false alarm only costs a full read.
+inline bool mayAlias(std::string_view text)
+{
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] != '&' && text[i] != '*')
+            continue;
+        char before = i == 0 ? '\n' : text[i - 1];
+        if (before == '\n' || before == ' ' || before == '\t' || before == '[' || before == '{' ||
+            before == ',' || before == '-' || before == ':')
+            return true;
+    }
+    return false;
+}
+
+// Whether a line opens a block scalar: its last token before any comment
+// is a "|" or ">" header ("|", ">-", "|2+"...). Over-eager like mayAlias:
+// a false alarm only hashes lines that could have been skipped.
+inline bool opensBlockScalar(std::string_view line)
+{
+    line = line.substr(0, line.find(" #"));
+    size_t end = line.find_last_not_of(" \t\r\n");
+    if (end == std::string_view::npos)
+        return false;
+    line = line.substr(0, end + 1);
+    size_t start = line.find_last_of(" \t");
+    std::string_view token = line.substr(start == std::string_view::npos ? 0 : start + 1);
+    return (token[0] == '|' || token[0] == '>') &&
+           token.find_first_not_of("-+0123456789", 1) == std::string_view::npos;
+}
+
+// Hash of the lines that are more than blank or a comment, so moving
+// comments around doesn't count as a change. Inside a block scalar those
+// lines are text, and are hashed like the rest.
+inline uint64_t significantHash(std::string_view text)
+{
+    uint64_t h = 0;
+    size_t blockIndent = std::string_view::npos; // of the line opening the block scalar we're in
+    for (size_t line = 0; line < text.size();)
+    {
+        size_t next = text.find('\n', line);
+        next = next == std::string_view::npos ? text.size() : next + 1;
+        std::string_view content = text.substr(line, next - line);
+        size_t first = content.find_first_not_of(" \t\r\n");
+        if (blockIndent != std::string_view::npos && (first == std::string_view::npos || first > blockIndent))
+            h = hashBytes(content.data(), content.size(), h);
+        else
+        {
+            blockIndent = std::string_view::npos;
+            if (first != std::string_view::npos && content[first] != '#')
+            {
+                h = hashBytes(content.data(), content.size(), h);
+                if (opensBlockScalar(content))
+                    blockIndent = first;
+            }
+        }
+        line = next;
+    }
+    return h;
+}
+
+// Splits a block mapping at its column-0 keys. Leading comments and blank
+// lines belong to no section; "- " items at column 0 belong to the key
+// above them. False when the document isn't laid out that way or repeats
+// a key.
+inline bool splitSections(std::string_view text, std::vector<Section>& out)
+{
+    out.clear();
+    size_t start = std::string_view::npos;
+    auto close = [&](size_t end)
+    {
+        if (start != std::string_view::npos)
+        {
+            out.back().text = text.substr(start, end - start);
+            out.back().hash = significantHash(out.back().text);
+        }
+    };
+
+    for (size_t line = 0; line < text.size();)
+    {
+        size_t next = text.find('\n', line);
+        next = next == std::string_view::npos ? text.size() : next + 1;
+        std::string_view content = text.substr(line, next - line);
+        while (!content.empty() && (content.back() == '\n' || content.back() == '\r'))
+            content.remove_suffix(1);
+
+        char first = content.empty() ? ' ' : content[0];
+        bool item = first == '-' && (content.size() == 1 || content[1] == ' ');
+        if (first == ' ' || first == '\t' || first == '#' || (item && start != std::string_view::npos))
+        {
+            line = next;
+            continue;
+        }
+        if (std::string_view("-?:{}[]&*!|>'\"%@`,").find(first) != std::string_view::npos)
+            return false;
+
+        size_t colon = content.find(": ");
+        if (colon == std::string_view::npos && content.back() == ':')
+            colon = content.size() - 1;
+        if (colon == std::string_view::npos)
+            return false;
+        std::string_view key = content.substr(0, colon);
+        while (!key.empty() && key.back() == ' ')
+            key.remove_suffix(1);
+        for (const auto& section : out)
+            if (section.key == key)
+                return false;
+
+        close(line);
+        out.push_back({std::string(key), {}, 0});
+        start = line;
+        line = next;
+    }
+    close(text.size());
+    return true;
+}
+
+inline bool readFile(const std::filesystem::path& path, std::string& out)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::ostringstream content;
+    content << file.rdbuf();
+    out = std::move(content).str();
+    return !file.bad();
+}
+
+} // namespace config_detail
+
+// ============================================================================
+// CONFIG CACHE
+// ============================================================================
+
+// What reload() has done so far
+struct ConfigStats
+{
+    size_t polls = 0;
+    size_t notModified = 0;    // size and modification time as before: not read
+    size_t sameContent = 0;    // read, but hashed the same: not parsed
+    size_t fullReads = 0;
+    size_t partialReads = 0;
+    size_t sectionsRead = 0;   // sections parsed by partial reads
+    size_t failed = 0;
+};
+
+template <HasFields T>
+class ConfigCache
+{
+    using Fields = std::decay_t<decltype(get_fields<T>())>;
+    static constexpr size_t fieldCount = std::tuple_size_v<Fields>;
+
+    using FieldListener = std::function<void(const T&, const T&)>;
+    using Listener = std::function<void(const T&, const T&, std::string_view)>;
+
+    std::filesystem::path file;
+    const T defaults;
+    std::atomic<std::shared_ptr<const T>> current;
+    std::atomic<uint64_t> published{0};
+
+    // Everything below is only touched under `writer`
+    mutable std::mutex writer;
+    // The last file read into a version that was accepted; a file that
+    // failed is read again on the next poll
+    bool seen = false;
+    uintmax_t lastSize = 0;
+    std::filesystem::file_time_type lastTime;
+    uint64_t lastHash = 0;
+    std::string text;                          // the published version's file
+    std::vector<config_detail::Section> sections; // into text; empty when it didn't split
+    ConfigStats counts;
+    std::array<std::vector<FieldListener>, fieldCount> fieldListeners;
+    std::vector<Listener> listeners;
+
+    // Taken before `writer` is let go and held while callbacks run
+    std::mutex notifying;
+
+    std::jthread watcher;
+
+    void accept(uintmax_t size, std::filesystem::file_time_type time, uint64_t hash)
+    {
+        seen = true;
+        lastSize = size;
+        lastTime = time;
+        lastHash = hash;
+    }
+
+    template <auto P>
+    static constexpr size_t indexOf()
+    {
+        size_t index = fieldCount;
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (..., [&]
+             {
+                 constexpr auto member = std::tuple_element_t<I, Fields>::memberPtr;
+                 if constexpr (std::is_same_v<std::remove_cv_t<decltype(member)>, std::remove_cv_t<decltype(P)>>)
+                 {
+                     if (member == P)
+                         index = I;
+                 }
+             }());
+        }(std::make_index_sequence<fieldCount>{});
+        return index;
+    }
+
+    // The sections of `next` that are new or differ from the published
+    // ones; false when a published key has gone
+    bool changedSections(const std::vector<config_detail::Section>& next,
+                         std::vector<const config_detail::Section*>& out) const
+    {
+        for (const auto& old : sections)
+        {
+            bool kept = false;
+            for (const auto& section : next)
+                kept |= section.key == old.key;
+            if (!kept)
+                return false;
+        }
+        for (const auto& section : next)
+        {
+            bool same = false;
+            for (const auto& old : sections)
+                same |= old.key == section.key && old.hash == section.hash;
+            if (!same)
+                out.push_back(&section);
+        }
+        return true;
+    }
+
+    // Field `index` read from its section, starting over from its default
+    // so keys taken out from under it don't linger
+    void readSection(T& obj, int index, Node* value, ValidationResult& result) const
+    {
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (..., [&]
+             {
+                 if (static_cast<int>(I) != index)
+                     return;
+                 const auto& field = std::get<I>(get_fields<T>());
+                 obj.*(field.memberPtr) = defaults.*(field.memberPtr);
+                 readField(obj, field, value, result);
+             }());
+        }(std::make_index_sequence<fieldCount>{});
+    }
+
+    // The changed sections read as one document, member by member: the
+    // members of the sections left out are already in obj
+    ValidationResult readSections(T& obj, std::string_view document) const
+    {
+        ValidationResult result;
+        try
+        {
+            YamlDocument doc(document);
+            YamlDocumentNode root(doc, 0);
+            root.forEachEntry([&](std::string_view key, Node* value)
+            {
+                int index = FieldIndex<T>::find(key);
+                if (index < 0)
+                    unknownField<T>(key, result, true);
+                else
+                    readSection(obj, index, value, result);
+                return !FailFast::stop(result);
+            });
+        }
+        catch (const std::exception& e)
+        {
+            result.addError("yaml", std::string(e.what()));
+        }
+        return result;
+    }
+
+    // The fields among `check` that differ between the versions, found by
+    // the diff() walk one field at a time; their ops go to out
+    std::array<bool, fieldCount> changedFields(const T& before, const T& after,
+                                               const std::array<bool, fieldCount>& check, PatchWriter& out) const
+    {
+        std::array<bool, fieldCount> changed{};
+        std::string path;
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (..., [&]
+             {
+                 if (!check[I])
+                     return;
+                 const auto& field = std::get<I>(get_fields<T>());
+                 size_t ops = out.size();
+                 appendPointerToken(path, field.getJsonProperty());
+                 diffValue(before.*(field.memberPtr), after.*(field.memberPtr), path, out);
+                 path.clear();
+                 changed[I] = out.size() != ops;
+             }());
+        }(std::make_index_sequence<fieldCount>{});
+        return changed;
+    }
+
+  public:
+    // get() returns `defaults` until the first reload() succeeds; full
+    // reads start from a copy of it, so a key missing from the file keeps
+    // its default
+    explicit ConfigCache(std::filesystem::path path, T defaults = T{})
+        : file(std::move(path)), defaults(std::move(defaults)), current(std::make_shared<const T>(this->defaults))
+    {
+    }
+
+    ~ConfigCache() { stop(); }
+    ConfigCache(const ConfigCache&) = delete;
+    ConfigCache& operator=(const ConfigCache&) = delete;
+
+    // The current version; never blocks on a reload
+    std::shared_ptr<const T> get() const { return current.load(std::memory_order_acquire); }
+
+    // Bumped each time a new version is published
+    uint64_t version() const { return published.load(std::memory_order_acquire); }
+
+    const std::filesystem::path& path() const { return file; }
+
+    ConfigStats stats() const
+    {
+        std::lock_guard lock(writer);
+        return counts;
+    }
+
+    // Runs fn(before, after) with the old and new values of member P
+    // whenever a reload changes it
+    template <auto P, typename F>
+    void onChange(F fn)
+    {
+        constexpr size_t index = indexOf<P>();
+        static_assert(index < fieldCount, "Member is not listed in FieldsMeta");
+        std::lock_guard lock(writer);
+        fieldListeners[index].push_back([fn = std::move(fn)](const T& before, const T& after)
+                                        { fn(before.*P, after.*P); });
+    }
+
+    // Runs fn(before, after, patch) whenever a reload changes anything;
+    // patch is diff(before, after)
+    void onChange(Listener fn)
+    {
+        std::lock_guard lock(writer);
+        listeners.push_back(std::move(fn));
+    }
+
+    // Checks the file and publishes a new version if it has changed in
+    // a way that matters. The result holds the errors of a version that
+    // wasn't published, and any reifyFromYaml lists for one that was.
+    ValidationResult reload()
+    {
+        std::unique_lock lock(writer);
+        ValidationResult result;
+        ++counts.polls;
+
+        std::error_code error;
+        uintmax_t size = std::filesystem::file_size(file, error);
+        auto time = error ? std::filesystem::file_time_type{} : std::filesystem::last_write_time(file, error);
+        if (error)
+        {
+            ++counts.failed;
+            result.addError("file", file.string() + ": " + error.message());
+            return result;
+        }
+        if (seen && size == lastSize && time == lastTime)
+        {
+            ++counts.notModified;
+            return result;
+        }
+
+        std::string content;
+        if (!config_detail::readFile(file, content))
+        {
+            ++counts.failed;
+            result.addError("file", file.string() + ": Cannot read file");
+            return result;
+        }
+        uint64_t hash = hashBytes(content.data(), content.size(), 0);
+        if (seen && hash == lastHash)
+        {
+            ++counts.sameContent;
+            accept(size, time, hash);
+            return result;
+        }
+
+        std::vector<config_detail::Section> split;
+        if (!config_detail::splitSections(content, split) || config_detail::mayAlias(content))
+            split.clear();
+
+        std::shared_ptr<const T> before = get();
+        std::vector<const config_detail::Section*> changed;
+        bool partial = !CustomDeser<T> && version() > 0 && !sections.empty() && !split.empty() && changedSections(split, changed);
+        if (partial && changed.empty())
+        {
+            // Only comments or blank lines changed
+            ++counts.sameContent;
+            accept(size, time, hash);
+            text = std::move(content);
+            config_detail::splitSections(text, sections);
+            return result;
+        }
+
+        std::shared_ptr<T> next;
+        std::array<bool, fieldCount> check{};
+        if (partial)
+        {
+            next = std::make_shared<T>(*before);
+            std::string document;
+            for (const auto* section : changed)
+            {
+                if (int index = FieldIndex<T>::find(section->key); index >= 0)
+                    check[index] = true;
+                document.append(section->text);
+                if (document.back() != '\n')
+                    document.push_back('\n');
+            }
+            result = readSections(*next, document);
+        }
+        else
+        {
+            check.fill(true);
+            next = std::make_shared<T>(defaults);
+            result = reifyFromYaml(*next, std::string_view(content));
+        }
+        if (!result.valid)
+        {
+            ++counts.failed;
+            return result;
+        }
+        if (partial)
+        {
+            ++counts.partialReads;
+            counts.sectionsRead += changed.size();
+        }
+        else
+            ++counts.fullReads;
+
+        accept(size, time, hash);
+        text = std::move(content);
+        if (split.empty() || !config_detail::splitSections(text, sections))
+            sections.clear();
+
+        PatchWriter out;
+        auto differs = changedFields(*before, *next, check, out);
+        if (out.size() == 0)
+            return result;
+
+        current.store(next, std::memory_order_release);
+        published.fetch_add(1, std::memory_order_acq_rel);
+
+        // Callbacks run outside `writer`, on copies of the lists, in the
+        // order their versions were published
+        std::vector<FieldListener> fieldCalls;
+        for (size_t i = 0; i < fieldCount; ++i)
+            if (differs[i])
+                fieldCalls.insert(fieldCalls.end(), fieldListeners[i].begin(), fieldListeners[i].end());
+        std::vector<Listener> calls = listeners;
+        std::string patch = calls.empty() ? std::string() : out.take();
+        std::lock_guard order(notifying);
+        lock.unlock();
+
+        for (const auto& listener : fieldCalls)
+            listener(*before, *next);
+        for (const auto& listener : calls)
+            listener(*before, *next, patch);
+        return result;
+    }
+
+    // Calls reload() every `interval` on a thread of its own until stop()
+    // or destruction; onError gets the result of each reload that failed
+    void watch(std::chrono::milliseconds interval, std::function<void(const ValidationResult&)> onError = {})
+    {
+        stop();
+        watcher = std::jthread(
+            [this, interval, onError = std::move(onError)](std::stop_token token)
+            {
+                std::mutex sleep;
+                std::condition_variable_any wake;
+                std::unique_lock lock(sleep);
+                while (!wake.wait_for(lock, token, interval, [] { return false; }) && !token.stop_requested())
+                {
+                    ValidationResult result = reload();
+                    if (!result.valid && onError)
+                        onError(result);
+                }
+            });
+    }
+
+    void stop()
+    {
+        if (watcher.joinable())
+        {
+            watcher.request_stop();
+            watcher.join();
+        }
+    }
+};
+
+} // namespace meta
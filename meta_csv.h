@@ -6,8 +6,10 @@
  * - Basic types (int, double, bool, string)
  * - Nested structures (flattened to key=value pairs)
  * - Vectors (inline with semicolon separators)
- * - CSV header generation from field metadata
- * - Batch serialization from vector of objects
+ * - CSV header generation from field metadata (CsvColumn renames a column)
+ * - Batch serialization from any range of objects, streamed into one sink
+ * - Reading CSV back into std::vector<T> with parseCSV, from a string or
+ *   a stream, with the field validation attributes applied to every row
  *
  * Usage:
  *   #include "meta.h"
@@ -18,15 +20,27 @@
  *   
  *   std::string csv = meta::serialize(people);
  *   std::string csv = meta::serializeAdvanced(people, ",", true, true);
+ *
+ *   auto [loaded, result] = meta::parseCSV<Person>(csv);
+ *   std::ifstream file("people.csv");
+ *   auto [fromFile, fileResult] = meta::parseCSV<Person>(file);
  */
 
 #pragma once
+#include <bit>
+#include <charconv>
+#include <cstring>
 #include <iostream>
+#include <ranges>
 #include <sstream>
 #include <string>
 #include <vector>
 #include <type_traits>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 // Forward declare if meta.h not included yet
 namespace meta { class Builder; }
 
@@ -35,49 +49,84 @@ namespace meta { class Builder; }
 namespace meta
 {
 
+// ============================================================================
+// ESCAPING
+// ============================================================================
+
+// Writes s with every quote doubled (CSV standard). Clean runs between
+// quotes go out in one write; text without quotes is a single memchr and
+// a single copy.
+inline void writeCSVEscaped(OutputSink& os, std::string_view s)
+{
+    const char* p = s.data();
+    const char* end = p + s.size();
+    while (const char* q = static_cast<const char*>(std::memchr(p, '"', static_cast<size_t>(end - p))))
+    {
+        os.write(p, static_cast<size_t>(q - p + 1));
+        os.put('"');
+        p = q + 1;
+    }
+    os.write(p, static_cast<size_t>(end - p));
+}
+
+inline void writeCSVQuoted(OutputSink& os, std::string_view s)
+{
+    os.put('"');
+    writeCSVEscaped(os, s);
+    os.put('"');
+}
+
 // ============================================================================
 // CSV BUILDER - Implements Builder interface for CSV output
 // ============================================================================
 
-class CSVBuilder : public Builder
+class CSVBuilder final : public Builder
 {
   private:
-    std::ostringstream out;
+    StringSink buffer;
+    OutputSink& out;
     int mapDepth = 0;
     bool firstInCurrentLevel = true;
     std::vector<bool> isActualMap; // Track if each level is actual map vs struct
 
   public:
+    CSVBuilder() : out(buffer) {}
+    explicit CSVBuilder(OutputSink& sink) : out(sink) {}
+
     void writeInt(int v) override
     {
         outputSeparator();
-        out << v;
+        out.writeInteger(v);
+    }
+
+    void writeInt64(int64_t v) override
+    {
+        outputSeparator();
+        out.writeInteger(v);
+    }
+
+    void writeUInt64(uint64_t v) override
+    {
+        outputSeparator();
+        out.writeInteger(v);
     }
 
     void writeDouble(double v) override
     {
         outputSeparator();
-        out << v;
+        out.writeDouble(v);
     }
 
     void writeBool(bool v) override
     {
         outputSeparator();
-        out << (v ? "true" : "false");
+        out.write(v ? "true" : "false");
     }
 
     void writeString(const std::string& v) override
     {
         outputSeparator();
-        // Escape quotes by doubling them (CSV standard)
-        std::string escaped = v;
-        size_t pos = 0;
-        while ((pos = escaped.find('"', pos)) != std::string::npos)
-        {
-            escaped.replace(pos, 1, "\"\"");
-            pos += 2;
-        }
-        out << "\"" << escaped << "\"";
+        writeCSVQuoted(out, v);
     }
 
     void writeNull() override
@@ -89,22 +138,22 @@ class CSVBuilder : public Builder
     void startSeq(const std::string& = "") override
     {
         // Sequences inline - bracket notation
-        out << "[";
+        out.put('[');
     }
 
     void endSeq() override
     {
-        out << "]";
+        out.put(']');
     }
 
     void startFlowSeq() override
     {
-        out << "[";
+        out.put('[');
     }
 
     void endFlowSeq() override
     {
-        out << "]";
+        out.put(']');
     }
 
     void startMap(const std::string& = "") override
@@ -114,13 +163,13 @@ class CSVBuilder : public Builder
         firstInCurrentLevel = true;
         
         if (mapDepth > 1)
-            out << "{";
+            out.put('{');
     }
 
     void endMap() override
     {
         if (mapDepth > 1)
-            out << "}";
+            out.put('}');
         mapDepth--;
         isActualMap.pop_back();
     }
@@ -131,7 +180,7 @@ class CSVBuilder : public Builder
         if (mapDepth == 1)
         {
             if (!firstInCurrentLevel)
-                out << ",";
+                out.put(',');
             firstInCurrentLevel = false;
         }
         // Nested maps: semicolon-separated key=value pairs
@@ -139,25 +188,37 @@ class CSVBuilder : public Builder
         {
             isActualMap[mapDepth - 1] = true;
             if (!firstInCurrentLevel)
-                out << ";";
+                out.put(';');
             
-            std::string escaped = k;
-            size_t pos = 0;
-            while ((pos = escaped.find('"', pos)) != std::string::npos)
-            {
-                escaped.replace(pos, 1, "\"\"");
-                pos += 2;
-            }
-            out << escaped << "=";
+            writeCSVEscaped(out, k);
+            out.put('=');
             firstInCurrentLevel = false;
         }
     }
 
+    // Ready for the next row; the buffer and the level stack keep their
+    // capacity
+    void reset()
+    {
+        buffer.clear();
+        mapDepth = 0;
+        firstInCurrentLevel = true;
+        isActualMap.clear();
+    }
+
+    // What has been written so far into the builder's own buffer
+    std::string_view view() const { return buffer.view(); }
+    size_t capacity() const { return buffer.capacity(); }
+
+    void finish() override { out.flush(); }
+
     std::string result() override
     {
-        return out.str();
+        return buffer.take();
     }
 
+    size_t bytesWritten() const override { return out.bytesWritten(); }
+
   private:
     void outputSeparator()
     {
@@ -173,9 +234,26 @@ class CSVBuilder : public Builder
 template <typename T> 
 std::string toCSV(const T& obj)
 {
-    CSVBuilder builder;
-    to(obj, &builder);
-    return builder.result();
+    auto builder = BuilderPool<CSVBuilder>::lease();
+    to(obj, *builder);
+    return builder.take();
+}
+
+// Replaces out's contents, reusing its capacity (see toYaml(obj, out) in meta.h)
+template <typename T>
+void toCSV(const T& obj, std::string& out)
+{
+    auto builder = BuilderPool<CSVBuilder>::lease();
+    to(obj, *builder);
+    out.assign(builder->view());
+}
+
+template <typename T>
+void toCSV(const T& obj, OutputSink& sink)
+{
+    CSVBuilder builder(sink);
+    to(obj, builder);
+    builder.finish();
 }
 
 // ============================================================================
@@ -185,7 +263,7 @@ std::string toCSV(const T& obj)
 template <HasFields T>
 std::string toCSVHeader()
 {
-    std::ostringstream oss;
+    StringSink sink;
     bool first = true;
     
     std::apply(
@@ -195,44 +273,48 @@ std::string toCSVHeader()
              [&](auto& field)
              {
                  if (!first)
-                     oss << ",";
-                 
-                 // Escape field name
-                 std::string escaped = std::string(field.fieldName);
-                 size_t pos = 0;
-                 while ((pos = escaped.find('"', pos)) != std::string::npos)
-                 {
-                     escaped.replace(pos, 1, "\"\"");
-                     pos += 2;
-                 }
-                 oss << "\"" << escaped << "\"";
+                     sink.put(',');
+                 writeCSVQuoted(sink, field.getCsvColumn());
                  first = false;
              }(fields));
         },
         get_fields<T>());
         
-    return oss.str();
+    return sink.take();
 }
 
 // ============================================================================
 // BATCH CSV EXPORT - Multiple objects with header
 // ============================================================================
 
-template <HasFields T>
-std::string toCSVWithHeader(const std::vector<T>& objects)
+template <typename R>
+concept CSVRecordRange = std::ranges::input_range<R> && HasFields<std::ranges::range_value_t<R>>;
+
+// Header plus one row per element, all through a single CSVBuilder
+template <CSVRecordRange R>
+void toCSVWithHeader(R&& objects, OutputSink& sink)
 {
-    std::ostringstream oss;
-    
-    // Header row
-    oss << toCSVHeader<T>() << "\n";
-    
-    // Data rows
+    using T = std::ranges::range_value_t<R>;
+
+    sink.write(toCSVHeader<T>());
+    sink.put('\n');
+
+    CSVBuilder builder(sink);
     for (const auto& obj : objects)
     {
-        oss << toCSV(obj) << "\n";
+        to(obj, builder);
+        sink.put('\n');
     }
-    
-    return oss.str();
+    builder.finish();
+}
+
+template <CSVRecordRange R>
+std::string toCSVWithHeader(R&& objects)
+{
+    StringSink sink;
+    sink.reserve(estimateBatchSize(objects, [](const auto& obj) { return toCSV(obj).size() + 1; }));
+    toCSVWithHeader(objects, sink);
+    return sink.take();
 }
 
 // ============================================================================
@@ -255,59 +337,78 @@ constexpr bool shouldSkipField(const FieldType& field)
 template <typename FieldType>
 std::string getCSVColumnName(const FieldType& field)
 {
-    // Use field name directly
-    return std::string(field.fieldName);
+    // CsvColumn overrides the field name
+    return std::string(field.getCsvColumn());
+}
+
+// Helper: Integers in full, floating point as the shortest digits that
+// read back as the same T (character types as characters)
+template <typename T>
+void writeCSVNumber(OutputSink& os, T value)
+{
+    if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>)
+        os.put(static_cast<char>(value));
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        char buf[64];
+        auto r = std::to_chars(buf, buf + sizeof(buf), value);
+        os.write(buf, static_cast<size_t>(r.ptr - buf));
+    }
+    else
+        os.writeInteger(value);
 }
 
 // Helper: Write CSV value with proper escaping
 template <typename T>
-void writeCSVValue(std::ostringstream& os, const T& value)
+void writeCSVValue(OutputSink& os, const T& value)
 {
     if constexpr (std::is_same_v<T, std::string>)
     {
-        // Escape quotes and wrap in quotes
-        std::string escaped = value;
-        size_t pos = 0;
-        while ((pos = escaped.find('"', pos)) != std::string::npos)
-        {
-            escaped.replace(pos, 1, "\"\"");
-            pos += 2;
-        }
-        os << "\"" << escaped << "\"";
+        writeCSVQuoted(os, value);
     }
     else if constexpr (std::is_same_v<T, bool>)
     {
-        os << (value ? "true" : "false");
+        os.write(value ? "true" : "false");
     }
     else if constexpr (std::is_arithmetic_v<T>)
     {
-        os << value;
+        writeCSVNumber(os, value);
+    }
+    else
+    {
+        // For complex types, stream the Builder-based serialization in place
+        os.put('"');
+        CSVBuilder builder(os);
+        to(value, builder);
+        os.put('"');
     }
+}
+
+// Helper: Write a value as-is (serializeAdvanced without escaping)
+template <typename T>
+void writeCSVRaw(OutputSink& os, const T& value)
+{
+    if constexpr (std::is_same_v<T, std::string>)
+        os.write(value);
+    else if constexpr (std::is_same_v<T, bool>)
+        os.write(value ? "true" : "false");
+    else if constexpr (std::is_arithmetic_v<T>)
+        writeCSVNumber(os, value);
     else
     {
-        // For complex types, use Builder-based serialization
-        CSVBuilder builder;
-        to(value, &builder);
-        os << "\"" << builder.result() << "\"";
+        CSVBuilder builder(os);
+        to(value, builder);
     }
 }
 
 // ============================================================================
-// Main CSV serialization function from vector
+// CSV rows - shared by serialize() and serializeAdvanced()
 // ============================================================================
 
+// Header line: column names joined by delimiter
 template <HasFields ObjectType>
-std::string serialize(const std::vector<ObjectType>& objects, const std::string& delimiter = ",")
+void writeCSVHeaderRow(OutputSink& os, const std::string& delimiter)
 {
-    std::ostringstream os;
-    if (objects.empty())
-    {
-        return "";
-    }
-    
-    const auto& fields = get_fields<ObjectType>();
-    
-    // Write header
     std::apply([&](auto&&... fieldMeta)
     {
         bool first = true;
@@ -315,120 +416,112 @@ std::string serialize(const std::vector<ObjectType>& objects, const std::string&
         {
             if (!shouldSkipField(field))
             {
-                if (!first) os << delimiter;
+                if (!first) os.write(delimiter);
                 first = false;
-                os << getCSVColumnName(field);
+                os.write(getCSVColumnName(field));
             }
         };
         (writeHeader(fieldMeta), ...);
-        os << "\n";
-    }, fields);
-    
-    // Write data rows
-    for (const auto& obj : objects)
+        os.put('\n');
+    }, get_fields<ObjectType>());
+}
+
+// One data line
+template <HasFields ObjectType>
+void writeCSVRow(OutputSink& os, const ObjectType& obj, const std::string& delimiter, bool escapeStrings = true)
+{
+    std::apply([&](auto&&... fieldMeta)
     {
-        std::apply([&](auto&&... fieldMeta)
+        bool first = true;
+        auto writeData = [&](const auto& field)
         {
-            bool first = true;
-            auto writeData = [&](const auto& field)
+            if (!shouldSkipField(field))
             {
-                if (!shouldSkipField(field))
+                if (!first) os.write(delimiter);
+                first = false;
+                
+                if constexpr (requires { field.memberPtr; })
                 {
-                    if (!first) os << delimiter;
-                    first = false;
-                    
-                    if constexpr (requires { field.memberPtr; })
+                    if constexpr (field.memberPtr != nullptr)
                     {
-                        if constexpr (field.memberPtr != nullptr)
+                        const auto& value = obj.*(field.memberPtr);
+                        if (escapeStrings)
                         {
-                            auto value = obj.*(field.memberPtr);
                             writeCSVValue(os, value);
                         }
+                        else
+                        {
+                            writeCSVRaw(os, value);
+                        }
                     }
                 }
-            };
-            (writeData(fieldMeta), ...);
-            os << "\n";
-        }, fields);
-    }
-    
-    return os.str();
+            }
+        };
+        (writeData(fieldMeta), ...);
+        os.put('\n');
+    }, get_fields<ObjectType>());
 }
 
 // ============================================================================
 // Advanced CSV serialization with more options
 // ============================================================================
 
-template <HasFields ObjectType>
-std::string serializeAdvanced(const std::vector<ObjectType>& objects, 
-                              const std::string& delimiter = ",",
-                              bool includeHeader = true,
-                              bool escapeStrings = true)
+template <CSVRecordRange R>
+void serializeAdvanced(R&& objects, 
+                       OutputSink& os,
+                       const std::string& delimiter = ",",
+                       bool includeHeader = true,
+                       bool escapeStrings = true)
 {
-    std::ostringstream os;
-    if (objects.empty())
+    using ObjectType = std::ranges::range_value_t<R>;
+
+    auto it = std::ranges::begin(objects);
+    auto last = std::ranges::end(objects);
+    if (it == last)
     {
-        return "";
+        return;
     }
     
-    const auto& fields = get_fields<ObjectType>();
-    
     // Write header if requested
     if (includeHeader)
     {
-        std::apply([&](auto&&... fieldMeta)
-        {
-            bool first = true;
-            auto writeHeader = [&](const auto& field)
-            {
-                if (!shouldSkipField(field))
-                {
-                    if (!first) os << delimiter;
-                    first = false;
-                    os << getCSVColumnName(field);
-                }
-            };
-            (writeHeader(fieldMeta), ...);
-            os << "\n";
-        }, fields);
+        writeCSVHeaderRow<ObjectType>(os, delimiter);
     }
     
     // Write data rows
-    for (const auto& obj : objects)
+    for (; it != last; ++it)
     {
-        std::apply([&](auto&&... fieldMeta)
-        {
-            bool first = true;
-            auto writeData = [&](const auto& field)
-            {
-                if (!shouldSkipField(field))
-                {
-                    if (!first) os << delimiter;
-                    first = false;
-                    
-                    if constexpr (requires { field.memberPtr; })
-                    {
-                        if constexpr (field.memberPtr != nullptr)
-                        {
-                            auto value = obj.*(field.memberPtr);
-                            if (escapeStrings)
-                            {
-                                writeCSVValue(os, value);
-                            }
-                            else
-                            {
-                                os << value;
-                            }
-                        }
-                    }
-                }
-            };
-            (writeData(fieldMeta), ...);
-            os << "\n";
-        }, fields);
+        writeCSVRow(os, *it, delimiter, escapeStrings);
     }
-    
-    return os.str();
+    os.flush();
+}
+
+template <CSVRecordRange R>
+std::string serializeAdvanced(R&& objects, 
+                              const std::string& delimiter = ",",
+                              bool includeHeader = true,
+                              bool escapeStrings = true)
+{
+    StringSink sink;
+    sink.reserve(estimateBatchSize(objects, [](const auto& obj) { return toCSV(obj).size() + 1; }));
+    serializeAdvanced(objects, sink, delimiter, includeHeader, escapeStrings);
+    return sink.take();
+}
+
+// ============================================================================
+// Main CSV serialization function from a range
+// ============================================================================
+
+template <CSVRecordRange R>
+void serialize(R&& objects, OutputSink& os, const std::string& delimiter = ",")
+{
+    serializeAdvanced(objects, os, delimiter, true, true);
+}
+
+template <CSVRecordRange R>
+std::string serialize(R&& objects, const std::string& delimiter = ",")
+{
+    return serializeAdvanced(objects, delimiter, true, true);
 }
 
 // ============================================================================
@@ -456,5 +549,477 @@ std::vector<std::string> getHeaders()
     return headers;
 }
 
+// ============================================================================
+// CSV READING - parseCSV<T> into std::vector<T>
+// ============================================================================
+
+// Columns are matched to fields through getCSVColumnName() (CsvColumn
+// overrides the field name). Each record is split into cells that point
+// into the input, then every cell is converted straight into its member;
+// the only per-row allocations are the row's own strings.
+
+struct CSVReadOptions
+{
+    char delimiter = ',';
+    char quote = '"';
+    // Without a header, columns are taken in field order
+    bool hasHeader = true;
+};
+
+// Fields parseCSV can fill from a single cell
+template <typename T>
+concept CSVCellType = IntegerType<T> || FloatingPointType<T> || std::is_same_v<T, bool> ||
+                      std::is_same_v<T, std::string> || std::is_same_v<T, std::filesystem::path> ||
+                      RegisteredEnum<T>;
+
+template <typename T>
+concept CSVFieldType = CSVCellType<T> || (is_optional_v<T> && CSVCellType<typename T::value_type>);
+
+// The first delimiter, quote or line break in [p, end), or end
+inline const char* findCSVSpecial(const char* p, const char* end, char delimiter, char quote)
+{
+#if defined(__SSE2__)
+    const __m128i d = _mm_set1_epi8(delimiter);
+    const __m128i q = _mm_set1_epi8(quote);
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    for (; end - p >= 16; p += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, d), _mm_cmpeq_epi8(v, q)),
+                                   _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+        if (mask)
+            return p + std::countr_zero(mask);
+    }
+#endif
+    for (; p < end; ++p)
+        if (*p == delimiter || *p == quote || *p == '\n' || *p == '\r')
+            return p;
+    return end;
+}
+
+// One cell of the current record; text excludes the surrounding quotes
+struct CSVCell
+{
+    std::string_view text;
+    bool quoted = false;
+    bool escaped = false; // text still contains doubled quotes
+};
+
+// Splits the record starting at p into cells. Returns the start of the
+// next record, or nullptr if the record may continue past end: when more
+// input is coming, or at EOF when a quoted cell never closes. malformed
+// is set for text after a closing quote.
+inline const char* scanCSVRecord(const char* p, const char* end, bool atEof, const CSVReadOptions& options,
+                                 std::vector<CSVCell>& cells, bool& malformed)
+{
+    cells.clear();
+    malformed = false;
+    while (true)
+    {
+        CSVCell cell;
+        if (p < end && *p == options.quote)
+        {
+            const char* q = p + 1;
+            while (true)
+            {
+                const char* r = static_cast<const char*>(std::memchr(q, options.quote, static_cast<size_t>(end - q)));
+                if (!r || (r + 1 == end && !atEof))
+                    return nullptr;
+                if (r + 1 < end && r[1] == options.quote)
+                {
+                    cell.escaped = true;
+                    q = r + 2;
+                    continue;
+                }
+                cell.text = std::string_view(p + 1, static_cast<size_t>(r - p - 1));
+                cell.quoted = true;
+                p = r + 1;
+                break;
+            }
+            if (p < end && *p != options.delimiter && *p != '\n' && *p != '\r')
+            {
+                malformed = true;
+                p = findCSVSpecial(p, end, '\n', '\n');
+            }
+        }
+        else
+        {
+            const char* start = p;
+            p = findCSVSpecial(p, end, options.delimiter, options.quote);
+            // A quote inside an unquoted cell is kept as text
+            while (p < end && *p == options.quote)
+                p = findCSVSpecial(p + 1, end, options.delimiter, options.quote);
+            cell.text = std::string_view(start, static_cast<size_t>(p - start));
+        }
+        cells.push_back(cell);
+
+        if (p == end)
+            return atEof ? end : nullptr;
+        if (*p == options.delimiter)
+        {
+            ++p;
+            continue;
+        }
+        if (*p == '\r')
+        {
+            if (p + 1 == end)
+                return atEof ? end : nullptr;
+            return p[1] == '\n' ? p + 2 : p + 1;
+        }
+        return p + 1; // '\n'
+    }
+}
+
+// Cell conversions: false with error set when text doesn't fit the member
+template <IntegerType T>
+bool readCSVCell(T& obj, std::string_view text, std::string& error)
+{
+    // Character types are written as the character itself
+    if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>)
+    {
+        if (text.size() == 1)
+        {
+            obj = static_cast<T>(text[0]);
+            return true;
+        }
+    }
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), obj);
+    if (ec == std::errc::result_out_of_range)
+        error = "Value out of range";
+    else if (ec != std::errc() || ptr != text.data() + text.size())
+        error = "Expected integer";
+    else
+        return true;
+    return false;
+}
+
+template <FloatingPointType T>
+bool readCSVCell(T& obj, std::string_view text, std::string& error)
+{
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), obj);
+    if (ec != std::errc() || ptr != text.data() + text.size())
+    {
+        error = "Expected number";
+        return false;
+    }
+    return true;
+}
+
+inline bool readCSVCell(bool& obj, std::string_view text, std::string& error)
+{
+    if (text == "true" || text == "1")
+        obj = true;
+    else if (text == "false" || text == "0")
+        obj = false;
+    else
+    {
+        error = "Expected boolean";
+        return false;
+    }
+    return true;
+}
+
+inline bool readCSVCell(std::string& obj, std::string_view text, std::string&)
+{
+    obj.assign(text);
+    return true;
+}
+
+inline bool readCSVCell(std::filesystem::path& obj, std::string_view text, std::string&)
+{
+    obj = std::filesystem::path(text);
+    return true;
+}
+
+template <RegisteredEnum EnumT>
+bool readCSVCell(EnumT& obj, std::string_view text, std::string& error)
+{
+    if (auto value = EnumMapping<EnumT>::Type::fromString(text))
+    {
+        obj = *value;
+        return true;
+    }
+    error = "Unknown enum value: '" + std::string(text) + "'. Valid values are: " +
+            EnumMapping<EnumT>::Type::validValues();
+    return false;
+}
+
+// Row-by-row parser state; parseCSV() drives it over one buffer or a stream
+template <HasFields T>
+class CSVReader
+{
+    static constexpr size_t fieldCount = field_count_v<T>;
+
+    template <size_t I>
+    using Member = typename std::decay_t<decltype(std::get<I>(get_fields<T>()))>::MemberType;
+
+    static_assert([]<size_t... I>(std::index_sequence<I...>) { return (CSVFieldType<Member<I>> && ...); }(
+                      std::make_index_sequence<fieldCount>{}),
+                  "parseCSV fields must be numbers, bool, strings, paths, registered enums or optionals of them");
+
+  public:
+    explicit CSVReader(const CSVReadOptions& options) : options(options)
+    {
+        if (!options.hasHeader)
+        {
+            for (size_t i = 0; i < fieldCount; ++i)
+                columnReaders.push_back(readerFor(i));
+            headerDone = true;
+        }
+    }
+
+    // Parses every complete record in [p, end) and returns how many bytes
+    // were used; the rest must be passed again with more input appended
+    size_t consume(const char* p, const char* end, bool atEof)
+    {
+        const char* begin = p;
+        if (!bomChecked)
+        {
+            if (end - p < 3 && !atEof)
+            {
+                pending = static_cast<size_t>(end - p);
+                return 0;
+            }
+            bomChecked = true;
+            if (end - p >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0)
+                p += 3;
+        }
+        while (p < end && !stopped)
+        {
+            bool malformed = false;
+            const char* next = scanCSVRecord(p, end, atEof, options, cells, malformed);
+            if (!next)
+            {
+                // Nothing more is coming to close the quote: the rest of
+                // the input is that one record
+                if (atEof)
+                {
+                    readUnterminated();
+                    p = end;
+                }
+                break;
+            }
+            // Blank lines carry no record
+            if (!(cells.size() == 1 && !cells[0].quoted && cells[0].text.empty()))
+            {
+                if (!headerDone)
+                    readHeader();
+                else
+                    readRow(malformed);
+                // With the whole input at hand, size the result from the first row
+                if (atEof && !reserved && !rows.empty())
+                {
+                    reserved = true;
+                    size_t remaining = static_cast<size_t>(end - next) / static_cast<size_t>(next - p);
+                    rows.reserve(rows.size() + remaining + remaining / 8);
+                }
+            }
+            p = next;
+        }
+        pending = stopped ? 0 : static_cast<size_t>(end - p);
+        return static_cast<size_t>(p - begin);
+    }
+
+    std::pair<std::vector<T>, ValidationResult> finish()
+    {
+        if (pending && !stopped)
+            result.addError("", "Incomplete record at end of input (" + std::to_string(pending) + " bytes not read)");
+        else if (!headerDone && !stopped)
+            result.addError("", "Missing CSV header");
+        return {std::move(rows), std::move(result)};
+    }
+
+  private:
+    using CellReader = void (CSVReader::*)(T&, const CSVCell&);
+
+    static constexpr CellReader readerFor(size_t index)
+    {
+        return [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            constexpr std::array<CellReader, fieldCount> readers{&CSVReader::readField<I>...};
+            return readers[index];
+        }(std::make_index_sequence<fieldCount>{});
+    }
+
+    CSVReadOptions options;
+    std::vector<CSVCell> cells;
+    std::vector<CellReader> columnReaders; // per column, nullptr if unknown
+    std::vector<T> rows;
+    ValidationResult result;
+    ValidationResult rowResult;
+    std::string scratch;
+    std::string error;
+    size_t rowIndex = 0;
+    size_t pending = 0; // bytes the last consume() left for more input
+    bool headerDone = false;
+    bool bomChecked = false;
+    bool reserved = false;
+    bool stopped = false;
+
+    std::string_view cellText(const CSVCell& cell)
+    {
+        if (!cell.escaped)
+            return cell.text;
+        scratch.clear();
+        for (size_t i = 0; i < cell.text.size(); ++i)
+        {
+            scratch.push_back(cell.text[i]);
+            if (cell.text[i] == options.quote)
+                ++i;
+        }
+        return scratch;
+    }
+
+    void readHeader()
+    {
+        headerDone = true;
+        std::array<bool, fieldCount> present{};
+        for (const CSVCell& cell : cells)
+        {
+            std::string_view name = cellText(cell);
+            int index = -1;
+            [&]<size_t... I>(std::index_sequence<I...>)
+            {
+                ((index < 0 && !present[I] && getCSVColumnName(std::get<I>(get_fields<T>())) == name
+                      ? (void)(index = static_cast<int>(I))
+                      : (void)0),
+                 ...);
+            }(std::make_index_sequence<fieldCount>{});
+            if (index >= 0)
+                present[index] = true;
+            columnReaders.push_back(index >= 0 ? readerFor(static_cast<size_t>(index)) : nullptr);
+        }
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (..., [&]
+             {
+                 const auto& field = std::get<I>(get_fields<T>());
+                 if (!present[I] && field.requirement == Requirement::Required)
+                     result.addError(field.fieldName, "Missing column " + getCSVColumnName(field));
+             }());
+        }(std::make_index_sequence<fieldCount>{});
+        stopped = !result.valid;
+    }
+
+    template <size_t I>
+    void readField(T& obj, const CSVCell& cell)
+    {
+        const auto& field = std::get<I>(get_fields<T>());
+        auto& member = obj.*(field.memberPtr);
+        using M = Member<I>;
+        bool ok;
+        if constexpr (is_optional_v<M>)
+        {
+            if (cell.text.empty() && !cell.quoted)
+            {
+                member.reset();
+                return;
+            }
+            ok = readCSVCell(member.emplace(), cellText(cell), error);
+        }
+        else
+        {
+            ok = readCSVCell(member, cellText(cell), error);
+        }
+        if (!ok)
+        {
+            rowResult.addError(field.fieldName, error);
+            return;
+        }
+        validateFieldAttributes(obj, field, rowResult);
+    }
+
+    // A record that reached the end of the input inside a quoted cell
+    void readUnterminated()
+    {
+        if (!headerDone)
+        {
+            result.addError("", "Unterminated quoted field in CSV header");
+            stopped = true;
+            return;
+        }
+        ValidationResult unterminated;
+        unterminated.addError("", "Unterminated quoted field");
+        appendElementErrors(result, rowIndex++, std::move(unterminated));
+        stopped = FailFast::active();
+    }
+
+    void readRow(bool malformed)
+    {
+        const size_t i = rowIndex++;
+        rowResult.valid = true;
+        rowResult.errors.clear();
+        if (malformed)
+            rowResult.addError("", "Unexpected text after a closing quote");
+        else if (cells.size() != columnReaders.size())
+            rowResult.addError("", "Expected " + std::to_string(columnReaders.size()) + " columns, found " +
+                                       std::to_string(cells.size()));
+        if (!rowResult.valid)
+        {
+            appendElementErrors(result, i, std::move(rowResult));
+            stopped = FailFast::active();
+            return;
+        }
+
+        T obj{};
+        for (size_t c = 0; c < cells.size() && !FailFast::stop(rowResult); ++c)
+            if (columnReaders[c])
+                (this->*columnReaders[c])(obj, cells[c]);
+        if (rowResult.valid)
+            rows.push_back(std::move(obj));
+        else
+        {
+            appendElementErrors(result, i, std::move(rowResult));
+            stopped = FailFast::active();
+        }
+    }
+};
+
+// Rows that fail conversion or validation are left out and reported
+// under "[row].field", counting data rows from 0 like from(std::vector)
+template <HasFields T>
+std::pair<std::vector<T>, ValidationResult> parseCSV(std::string_view csv, const CSVReadOptions& options = {})
+{
+    CSVReader<T> reader(options);
+    reader.consume(csv.data(), csv.data() + csv.size(), true);
+    return reader.finish();
+}
+
+// Reads the stream in fixed-size chunks; only a partial trailing record is
+// carried over between chunks
+template <HasFields T>
+std::pair<std::vector<T>, ValidationResult> parseCSV(std::istream& in, const CSVReadOptions& options = {},
+                                                     size_t chunkSize = 64 * 1024)
+{
+    CSVReader<T> reader(options);
+    std::string buffer;
+    size_t filled = 0;
+    while (true)
+    {
+        if (buffer.size() < filled + chunkSize)
+            buffer.resize(std::max(buffer.size() * 2, filled + chunkSize));
+        in.read(buffer.data() + filled, static_cast<std::streamsize>(chunkSize));
+        filled += static_cast<size_t>(in.gcount());
+        const bool atEof = !in;
+        size_t used = reader.consume(buffer.data(), buffer.data() + filled, atEof);
+        if (atEof)
+            break;
+        std::memmove(buffer.data(), buffer.data() + used, filled - used);
+        filled -= used;
+    }
+    return reader.finish();
+}
+
+// toCSV and parseCSV, for META_EXTERN_TEMPLATES / META_INSTANTIATE_TEMPLATES in meta.h
+#define META_CSV_TEMPLATES(prefix, ...)                                                                               \
+    prefix std::string meta::toCSV<__VA_ARGS__>(const __VA_ARGS__&);                                                  \
+    prefix void meta::toCSV<__VA_ARGS__>(const __VA_ARGS__&, meta::OutputSink&);                                      \
+    prefix void meta::toCSV<__VA_ARGS__>(const __VA_ARGS__&, std::string&);                                           \
+    prefix std::string meta::toCSVHeader<__VA_ARGS__>();                                                              \
+    prefix std::pair<std::vector<__VA_ARGS__>, meta::ValidationResult> meta::parseCSV<__VA_ARGS__>(                   \
+        std::string_view, const meta::CSVReadOptions&)
+
 } // namespace meta
 
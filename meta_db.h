@@ -2,11 +2,9 @@
 #include <string>
 #include <sstream>
 #include <string_view>
+#include <vector>
 
-namespace meta {
-    template <typename T>
-    struct MetaTuple;
-}
+#include "meta.h"
 
 namespace meta {
 
@@ -18,15 +16,23 @@ std::string getFieldName(const FieldMeta& fieldMeta) {
     return std::string(sqlCol);
 }
 
-// Helper to get table name
+// Table name from MetaTuple<T>::tableName or T::tableName ("" when neither)
 template<typename T>
-std::string getTableName() {
+constexpr std::string_view sqlTableName() {
     if constexpr (requires { meta::MetaTuple<T>::tableName; }) {
-        return std::string(meta::MetaTuple<T>::tableName);
+        return meta::MetaTuple<T>::tableName;
+    } else if constexpr (requires { T::tableName; }) {
+        return T::tableName;
     }
     return "";
 }
 
+// Helper to get table name
+template<typename T>
+std::string getTableName() {
+    return std::string(sqlTableName<T>());
+}
+
 // SQL type mapping
 template<typename T>
 std::string mapCppTypeToSQL() {
@@ -205,5 +211,596 @@ std::string deleteSQL() {
     return "DELETE FROM " + tableName + " WHERE id = ?";
 }
 
-} // namespace db
+// PREPARED STATEMENTS
+//
+// insertStatement<T>() is `INSERT INTO t (a, b, c) VALUES (?, ?, ?)`, with
+// SqlColumn names, built once per type (at compile time when the field
+// table and tableName are constexpr). bindFields() hands an object's
+// values to a binder by type, so nothing is formatted or quoted:
+//
+//   struct SqliteBinder {
+//       sqlite3_stmt* stmt;
+//       void bindNull(int i) { sqlite3_bind_null(stmt, i); }
+//       void bindInt(int i, int64_t v) { sqlite3_bind_int64(stmt, i, v); }
+//       void bindDouble(int i, double v) { sqlite3_bind_double(stmt, i, v); }
+//       void bindText(int i, std::string_view v)
+//       { sqlite3_bind_text(stmt, i, v.data(), int(v.size()), SQLITE_TRANSIENT); }
+//   };
+//
+// Parameters are numbered from 1, as in SQLite, ODBC and libpq's $n.
+
+enum class SqlParamStyle { Question, Dollar }; // ?, ? or $1, $2
+
+template<typename B>
+concept SqlBinder = requires(B& b, int i, int64_t n, double d, std::string_view s) {
+    b.bindNull(i);
+    b.bindInt(i, n);
+    b.bindDouble(i, d);
+    b.bindText(i, s);
+};
+
+template<typename T>
+concept SqlTable = HasFields<T> && !sqlTableName<T>().empty();
+
+// Rows of `(?, ?, ?)` after "INSERT INTO t (a, b, c) VALUES ". Writes
+// through out(std::string_view), so the same code counts, fills a
+// constexpr buffer or appends to a std::string.
+template<typename T, typename Out>
+constexpr void writeInsertStatement(Out&& out, SqlParamStyle style, size_t rows) {
+    out("INSERT INTO ");
+    out(sqlTableName<T>());
+    out(" (");
+    bool first = true;
+    std::apply([&](const auto&... field) {
+        (..., (out(first ? "" : ", "), out(field.getSqlColumn()), first = false));
+    }, get_fields<T>());
+    out(") VALUES ");
+
+    constexpr size_t columns = field_count_v<T>;
+    size_t param = 1;
+    for (size_t r = 0; r < rows; ++r) {
+        out(r ? ", (" : "(");
+        for (size_t c = 0; c < columns; ++c, ++param) {
+            if (c)
+                out(", ");
+            if (style == SqlParamStyle::Question) {
+                out("?");
+                continue;
+            }
+            char digits[20];
+            size_t n = 0;
+            for (size_t v = param; v; v /= 10)
+                digits[n++] = static_cast<char>('0' + v % 10);
+            out("$");
+            while (n)
+                out(std::string_view(&digits[--n], 1));
+        }
+        out(")");
+    }
+}
+
+template<typename T, SqlParamStyle Style>
+struct InsertStatementText {
+    static constexpr size_t size() {
+        size_t n = 0;
+        writeInsertStatement<T>([&](std::string_view s) { n += s.size(); }, Style, 1);
+        return n;
+    }
+
+    static constexpr std::array<char, size()> build() {
+        std::array<char, size()> text{};
+        size_t pos = 0;
+        writeInsertStatement<T>([&](std::string_view s) {
+            for (char c : s)
+                text[pos++] = c;
+        }, Style, 1);
+        return text;
+    }
+};
+
+// `INSERT ... VALUES (?, ...)` for `rows` rows; insertStatement<T>() caches the one-row form
+template<SqlTable T>
+std::string insertStatement(size_t rows, SqlParamStyle style = SqlParamStyle::Question) {
+    std::string sql;
+    writeInsertStatement<T>([&](std::string_view s) { sql += s; }, style, rows);
+    return sql;
+}
+
+template<SqlTable T, SqlParamStyle Style = SqlParamStyle::Question>
+std::string_view insertStatement() {
+    if constexpr (ConstexprFields<T> && requires { typename std::bool_constant<sqlTableName<T>().empty()>; }) {
+        static constexpr auto text = InsertStatementText<T, Style>::build();
+        return {text.data(), text.size()};
+    } else {
+        static const std::string text = insertStatement<T>(1, Style);
+        return text;
+    }
+}
+
+// Binds one value at parameter i: integers and bools as bindInt, floating
+// point as bindDouble, strings and registered enums as bindText, an empty
+// optional as bindNull
+template<typename V, SqlBinder B>
+void bindValue(B& binder, int i, const V& value) {
+    if constexpr (requires { value.has_value(); *value; }) {
+        if (value.has_value())
+            bindValue(binder, i, *value);
+        else
+            binder.bindNull(i);
+    } else if constexpr (std::is_same_v<V, bool> || std::is_integral_v<V>) {
+        binder.bindInt(i, static_cast<int64_t>(value));
+    } else if constexpr (std::is_floating_point_v<V>) {
+        binder.bindDouble(i, static_cast<double>(value));
+    } else if constexpr (std::is_convertible_v<const V&, std::string_view>) {
+        binder.bindText(i, std::string_view(value));
+    } else if constexpr (RegisteredEnum<V>) {
+        binder.bindText(i, EnumMapping<V>::Type::name(value));
+    } else {
+        static_assert(sizeof(V) == 0, "bindValue: no SQL parameter type for this field");
+    }
+}
+
+// Binds every field of obj in declaration order from parameter `first`;
+// returns the next free parameter
+template<SqlTable T, SqlBinder B>
+int bindFields(const T& obj, B& binder, int first = 1) {
+    std::apply([&](const auto&... field) {
+        (..., bindValue(binder, first++, obj.*(field.memberPtr)));
+    }, get_fields<T>());
+    return first;
+}
+
+struct SqlBatchOptions {
+    // SQLite allows 32766 parameters per statement (999 before 3.32)
+    size_t rowsPerStatement = 100;
+    SqlParamStyle style = SqlParamStyle::Question;
+};
+
+// Multi-row insert: for every slice of up to rowsPerStatement rows, calls
+// exec(sql, bind). exec prepares sql - every full slice gets the same
+// string, so a prepared handle can be reused until the last, shorter one -
+// then calls bind(binder) with a SqlBinder for it and executes. Returns
+// the number of statements.
+//
+//   meta::insertBatch(people, [&](std::string_view sql, auto&& bind) {
+//       Statement& stmt = cache.prepare(sql);
+//       SqliteBinder binder{stmt.handle};
+//       bind(binder);
+//       stmt.step();
+//   });
+template<SqlTable T, typename Exec>
+size_t insertBatch(const std::vector<T>& rows, Exec&& exec, const SqlBatchOptions& options = {}) {
+    const size_t perStatement = options.rowsPerStatement ? options.rowsPerStatement : 1;
+    std::string full;
+    size_t statements = 0;
+    for (size_t begin = 0; begin < rows.size(); begin += perStatement) {
+        const size_t count = std::min(perStatement, rows.size() - begin);
+        if (full.empty() && count == perStatement)
+            full = insertStatement<T>(perStatement, options.style);
+        std::string last = count == perStatement ? std::string() : insertStatement<T>(count, options.style);
+        exec(std::string_view(count == perStatement ? full : last), [&](auto& binder) {
+            int param = 1;
+            for (size_t r = begin; r < begin + count; ++r)
+                param = bindFields(rows[r], binder, param);
+        });
+        ++statements;
+    }
+    return statements;
+}
+
+// COPY
+//
+// copyStatement<T>() is `COPY t (a, b, c) FROM STDIN`, plus
+// `WITH (FORMAT binary)` for the binary variant; CopyWriter<T> streams
+// rows for it into an OutputSink. With a CallbackSink each full buffer
+// goes straight to the connection, so memory stays the same for any
+// number of rows:
+//
+//   PQexec(conn, std::string(meta::copyStatement<Trade>(meta::CopyFormat::Binary)).c_str());
+//   meta::CallbackSink sink([&](std::string_view block) {
+//       PQputCopyData(conn, block.data(), int(block.size()));
+//   });
+//   meta::writeCopy(trades, sink, meta::CopyFormat::Binary);
+//   PQputCopyEnd(conn, nullptr);
+//
+// Columns are in createTable<T>() order with its types: INTEGER goes as
+// int4, BIGINT int8, DOUBLE float8, FLOAT float4, BOOLEAN bool and
+// everything else (strings, other integer widths, enums, optionals) as
+// text. Empty optionals are NULL.
+
+enum class CopyFormat { Text, Binary };
+
+enum class CopyColumn { Int4, Int8, Float4, Float8, Bool, Text };
+
+// The same cases as mapCppTypeToSQL
+template<typename M>
+constexpr CopyColumn copyColumnOf() {
+    using Type = std::remove_cv_t<std::remove_reference_t<M>>;
+    if constexpr (std::is_same_v<Type, int> || std::is_same_v<Type, int32_t>) return CopyColumn::Int4;
+    else if constexpr (std::is_same_v<Type, int64_t>) return CopyColumn::Int8;
+    else if constexpr (std::is_same_v<Type, double>) return CopyColumn::Float8;
+    else if constexpr (std::is_same_v<Type, float>) return CopyColumn::Float4;
+    else if constexpr (std::is_same_v<Type, bool>) return CopyColumn::Bool;
+    else return CopyColumn::Text;
+}
+
+template<SqlTable T>
+std::string_view copyStatement(CopyFormat format = CopyFormat::Text) {
+    static const std::array<std::string, 2> text = [] {
+        std::string sql = "COPY " + std::string(sqlTableName<T>()) + " (";
+        bool first = true;
+        std::apply([&](const auto&... field) {
+            (..., (sql += first ? "" : ", ", sql += field.getSqlColumn(), first = false));
+        }, get_fields<T>());
+        sql += ") FROM STDIN";
+        return std::array<std::string, 2>{sql, sql + " WITH (FORMAT binary)"};
+    }();
+    return text[format == CopyFormat::Binary];
+}
+
+// Text-format escapes: backslash, and the delimiter/line characters
+inline void writeCopyEscaped(OutputSink& out, std::string_view s) {
+    const char* p = s.data();
+    const char* end = p + s.size();
+    while (p < end) {
+        const char* q = p;
+        while (q < end && *q != '\\' && *q != '\t' && *q != '\n' && *q != '\r')
+            ++q;
+        out.write(p, static_cast<size_t>(q - p));
+        if (q == end)
+            break;
+        out.put('\\');
+        out.put(*q == '\\' ? '\\' : *q == '\t' ? 't' : *q == '\n' ? 'n' : 'r');
+        p = q + 1;
+    }
+}
+
+inline void writeBigEndian(OutputSink& out, uint64_t v, int bytes) {
+    char buf[8];
+    for (int i = bytes - 1; i >= 0; --i, v >>= 8)
+        buf[i] = static_cast<char>(v & 0xFF);
+    out.write(buf, static_cast<size_t>(bytes));
+}
+
+template<SqlTable T>
+class CopyWriter {
+public:
+    // Writes the binary signature and header right away
+    explicit CopyWriter(OutputSink& out, CopyFormat format = CopyFormat::Text) : out(out), format(format) {
+        if (format == CopyFormat::Binary) {
+            out.write("PGCOPY\n\377\r\n\0", 11);
+            writeBigEndian(out, 0, 4); // flags
+            writeBigEndian(out, 0, 4); // header extension length
+        }
+    }
+
+    void write(const T& row) {
+        if (format == CopyFormat::Binary) {
+            writeBigEndian(out, field_count_v<T>, 2);
+            std::apply([&](const auto&... field) {
+                (..., writeBinary(row.*(field.memberPtr)));
+            }, get_fields<T>());
+        } else {
+            bool first = true;
+            std::apply([&](const auto&... field) {
+                (..., (first ? void() : out.put('\t'), writeText(row.*(field.memberPtr)), first = false));
+            }, get_fields<T>());
+            out.put('\n');
+        }
+        ++count;
+    }
+
+    template<std::ranges::input_range R>
+    void write(R&& rows) {
+        for (const T& row : rows)
+            write(row);
+    }
+
+    // Binary trailer, then flush the sink
+    void finish() {
+        if (format == CopyFormat::Binary)
+            writeBigEndian(out, 0xFFFF, 2);
+        out.flush();
+    }
+
+    size_t rows() const { return count; }
+
+private:
+    OutputSink& out;
+    CopyFormat format;
+    size_t count = 0;
+
+    template<typename V>
+    static constexpr bool isOptional = requires(const V& v) { v.has_value(); *v; };
+
+    // Text form of a value that isn't a string. Numbers are formatted into
+    // buf; enum names point into the mapping.
+    template<typename V>
+    static std::string_view textOf(const V& value, char (&buf)[64]) {
+        if constexpr (std::is_same_v<V, bool>) {
+            return value ? "t" : "f";
+        } else if constexpr (std::is_arithmetic_v<V>) {
+            auto r = std::to_chars(buf, buf + sizeof(buf), value);
+            return {buf, static_cast<size_t>(r.ptr - buf)};
+        } else if constexpr (RegisteredEnum<V>) {
+            return EnumMapping<V>::Type::name(value);
+        } else {
+            static_assert(sizeof(V) == 0, "CopyWriter: no COPY representation for this field");
+        }
+    }
+
+    template<typename V>
+    void writeTextValue(const V& value) {
+        if constexpr (std::is_convertible_v<const V&, std::string_view>) {
+            writeCopyEscaped(out, std::string_view(value));
+        } else if constexpr (std::is_integral_v<V> && !std::is_same_v<V, bool>) {
+            out.writeInteger(value);
+        } else {
+            char buf[64];
+            writeCopyEscaped(out, textOf(value, buf));
+        }
+    }
+
+    template<typename V>
+    void writeText(const V& value) {
+        if constexpr (isOptional<V>) {
+            if (value.has_value())
+                writeTextValue(*value);
+            else
+                out.write("\\N", 2);
+        } else {
+            writeTextValue(value);
+        }
+    }
+
+    template<typename V>
+    void writeBinary(const V& value) {
+        if constexpr (isOptional<V>) {
+            if (value.has_value())
+                writeTextField(*value);
+            else
+                writeBigEndian(out, 0xFFFFFFFF, 4);
+        } else if constexpr (copyColumnOf<V>() == CopyColumn::Int4) {
+            writeBigEndian(out, 4, 4);
+            writeBigEndian(out, static_cast<uint32_t>(value), 4);
+        } else if constexpr (copyColumnOf<V>() == CopyColumn::Int8) {
+            writeBigEndian(out, 8, 4);
+            writeBigEndian(out, static_cast<uint64_t>(value), 8);
+        } else if constexpr (copyColumnOf<V>() == CopyColumn::Float4) {
+            writeBigEndian(out, 4, 4);
+            writeBigEndian(out, std::bit_cast<uint32_t>(value), 4);
+        } else if constexpr (copyColumnOf<V>() == CopyColumn::Float8) {
+            writeBigEndian(out, 8, 4);
+            writeBigEndian(out, std::bit_cast<uint64_t>(value), 8);
+        } else if constexpr (copyColumnOf<V>() == CopyColumn::Bool) {
+            writeBigEndian(out, 1, 4);
+            out.put(value ? 1 : 0);
+        } else {
+            writeTextField(value);
+        }
+    }
+
+    // A text column in binary format: length, then the unescaped text
+    template<typename V>
+    void writeTextField(const V& value) {
+        char buf[64];
+        std::string_view s;
+        if constexpr (std::is_convertible_v<const V&, std::string_view>)
+            s = value;
+        else
+            s = textOf(value, buf);
+        writeBigEndian(out, s.size(), 4);
+        out.write(s);
+    }
+};
+
+// Streams every row of `rows` into out in the given format, then finishes
+template<typename R, typename T = std::ranges::range_value_t<R>>
+    requires SqlTable<T>
+size_t writeCopy(R&& rows, OutputSink& out, CopyFormat format = CopyFormat::Text) {
+    CopyWriter<T> writer(out, format);
+    writer.write(rows);
+    writer.finish();
+    return writer.rows();
+}
+
+// ROW MAPPING
+//
+// mapRows<T>(result) fills a std::vector<T> from a query result through
+// typed cell accessors - no Node, no strings for numeric cells. Result
+// columns are matched against getSqlColumn() once (ASCII case-insensitive,
+// since PostgreSQL folds unquoted names); columns that aren't fields are
+// skipped. A result set is anything with:
+//
+//   int columnCount() const;
+//   std::string_view columnName(int c) const;
+//   bool next();                        // advance to the next row; false at the end
+//   bool isNull(int c) const;
+//   int64_t getInt(int c) const;
+//   double getDouble(int c) const;
+//   std::string_view getText(int c) const;
+//   size_t rowCount() const;            // optional: rows are reserved ahead
+//
+// Rows with a bad cell are left out and reported under "[row].field", as
+// parseCSV does; a required field with no column fails before any row is
+// read.
+
+template<typename R>
+concept SqlResultSet = requires(R& r, const R& cr, int c) {
+    { cr.columnCount() } -> std::convertible_to<int>;
+    { cr.columnName(c) } -> std::convertible_to<std::string_view>;
+    { r.next() } -> std::convertible_to<bool>;
+    { cr.isNull(c) } -> std::convertible_to<bool>;
+    { cr.getInt(c) } -> std::convertible_to<int64_t>;
+    { cr.getDouble(c) } -> std::convertible_to<double>;
+    { cr.getText(c) } -> std::convertible_to<std::string_view>;
+};
+
+struct RowMapOptions {
+    size_t expectedRows = 0; // reserve this many when the result has no rowCount()
+};
+
+inline bool sqlNameEquals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        char x = a[i] >= 'A' && a[i] <= 'Z' ? static_cast<char>(a[i] - 'A' + 'a') : a[i];
+        char y = b[i] >= 'A' && b[i] <= 'Z' ? static_cast<char>(b[i] - 'A' + 'a') : b[i];
+        if (x != y)
+            return false;
+    }
+    return true;
+}
+
+// One cell into a member: false with error set when it doesn't fit
+template<typename M, SqlResultSet R>
+bool readSqlCell(M& obj, const R& row, int c, std::string& error) {
+    if constexpr (requires { obj.has_value(); obj.reset(); typename M::value_type; }) {
+        if (row.isNull(c)) {
+            obj.reset();
+            return true;
+        }
+        return readSqlCell(obj.emplace(), row, c, error);
+    } else {
+        if (row.isNull(c)) {
+            error = "Unexpected NULL";
+            return false;
+        }
+        if constexpr (std::is_same_v<M, bool>) {
+            obj = row.getInt(c) != 0;
+        } else if constexpr (std::is_integral_v<M>) {
+            int64_t v = row.getInt(c);
+            if (!std::in_range<StandardInteger<M>>(v)) {
+                error = "Value out of range";
+                return false;
+            }
+            obj = static_cast<M>(v);
+        } else if constexpr (std::is_floating_point_v<M>) {
+            obj = static_cast<M>(row.getDouble(c));
+        } else if constexpr (std::is_same_v<M, std::string>) {
+            obj.assign(row.getText(c));
+        } else if constexpr (RegisteredEnum<M>) {
+            std::string_view text = row.getText(c);
+            if (auto value = EnumMapping<M>::Type::fromString(text)) {
+                obj = *value;
+                return true;
+            }
+            error = "Unknown enum value: '" + std::string(text) + "'. Valid values are: " +
+                    EnumMapping<M>::Type::validValues();
+            return false;
+        } else {
+            static_assert(sizeof(M) == 0, "mapRows: fields must be numbers, bool, std::string, registered enums or optionals of them");
+        }
+        return true;
+    }
+}
+
+template<HasFields T, SqlResultSet R>
+class RowMapper {
+public:
+    // Matches the result's columns to fields; errors() lists required fields without one
+    explicit RowMapper(const R& result) {
+        const int columns = result.columnCount();
+        std::array<bool, fieldCount> matched{};
+        for (int c = 0; c < columns; ++c) {
+            std::string_view name = result.columnName(c);
+            size_t i = 0;
+            std::apply([&](const auto&... field) {
+                (..., [&] {
+                    if (!matched[i] && sqlNameEquals(field.getSqlColumn(), name)) {
+                        matched[i] = true;
+                        readers.push_back({c, readerFor(i)});
+                    }
+                    ++i;
+                }());
+            }, get_fields<T>());
+        }
+        size_t i = 0;
+        std::apply([&](const auto&... field) {
+            (..., [&] {
+                if (!matched[i++] && field.requirement == Requirement::Required)
+                    missing.addError(field.fieldName, "Missing column " + std::string(field.getSqlColumn()));
+            }());
+        }, get_fields<T>());
+    }
+
+    const ValidationResult& errors() const { return missing; }
+
+    // Fills obj from the current row; each bad cell becomes an error under its field name
+    ValidationResult read(const R& row, T& obj) const {
+        ValidationResult result;
+        std::string error;
+        for (const Column& col : readers) {
+            if (FailFast::stop(result))
+                break;
+            col.read(obj, row, col.index, error, result);
+        }
+        return result;
+    }
+
+private:
+    static constexpr size_t fieldCount = field_count_v<T>;
+    using Reader = void (*)(T&, const R&, int, std::string&, ValidationResult&);
+
+    struct Column {
+        int index;
+        Reader read;
+    };
+
+    std::vector<Column> readers;
+    ValidationResult missing;
+
+    template<size_t I>
+    static void readAt(T& obj, const R& row, int c, std::string& error, ValidationResult& result) {
+        const auto& field = std::get<I>(get_fields<T>());
+        if (!readSqlCell(obj.*(field.memberPtr), row, c, error))
+            result.addError(field.fieldName, error);
+        else
+            validateFieldAttributes(obj, field, result);
+    }
+
+    static constexpr Reader readerFor(size_t index) {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            constexpr Reader table[] = {&readAt<I>...};
+            return table[index];
+        }(std::make_index_sequence<fieldCount>{});
+    }
+};
+
+template<HasFields T, SqlResultSet R>
+std::pair<std::vector<T>, ValidationResult> mapRows(R& result, const RowMapOptions& options = {}) {
+    std::vector<T> rows;
+    RowMapper<T, R> mapper(result);
+    if (!mapper.errors().valid)
+        return {std::move(rows), mapper.errors()};
+
+    if constexpr (requires { result.rowCount(); })
+        rows.reserve(static_cast<size_t>(result.rowCount()));
+    else
+        rows.reserve(options.expectedRows);
+
+    ValidationResult errors;
+    for (size_t i = 0; result.next(); ++i) {
+        T obj{};
+        auto rowResult = mapper.read(result, obj);
+        if (rowResult.valid) {
+            rows.push_back(std::move(obj));
+        } else {
+            appendElementErrors(errors, i, std::move(rowResult));
+            if (FailFast::active())
+                break;
+        }
+    }
+    return {std::move(rows), std::move(errors)};
+}
+
+// SQL statements, for META_EXTERN_TEMPLATES / META_INSTANTIATE_TEMPLATES in meta.h
+#define META_DB_TEMPLATES(prefix, ...)                                                                                \
+    prefix std::string meta::createTable<__VA_ARGS__>();                                                              \
+    prefix std::string meta::insertSQL<__VA_ARGS__>(const __VA_ARGS__&);                                              \
+    prefix std::string meta::selectSQL<__VA_ARGS__>();                                                                \
+    prefix std::string meta::updateSQL<__VA_ARGS__>(const __VA_ARGS__&);                                              \
+    prefix std::string meta::deleteSQL<__VA_ARGS__>()
+
+} // namespace meta
 
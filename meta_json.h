@@ -0,0 +1,695 @@
+/*
+ * meta_json.h - Native JSON reader for meta.h
+ *
+ * Parses JSON in a single pass into a flat token tape and exposes the tape
+ * through the meta::Node interface, so the existing from() overloads read
+ * JSON directly instead of routing it through YAML::Load.
+ *
+ * Supports:
+ * - Full JSON grammar (RFC 8259), including \uXXXX escapes and surrogate pairs
+ * - O(1) subtree skipping (every container records where its subtree ends)
+ * - Zero-copy scalars: strings without escapes and numbers are slices of the input
+ *
+ * Usage:
+ *   #include "meta.h"
+ *   #include "meta_json.h"
+ *
+ *   auto [person, result] = meta::fromJson<Person>(R"({"name":"Alice","age":28})");
+ *
+ * The parsed document refers to the input buffer; the buffer must outlive
+ * any JsonDocument / JsonNode built from it.
+ *
+ * std::string_view and std::span<const std::byte> fields are read without
+ * copying: they point at the string's bytes inside the input buffer and are
+ * valid for as long as that buffer is, whether or not the JsonDocument is
+ * kept. Strings containing escapes have no verbatim copy to point at and
+ * are reported as errors; declare those fields as std::string.
+ */
+
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "meta.h"
+
+namespace meta
+{
+
+// ============================================================================
+// JSON TAPE
+// ============================================================================
+// The tokenizer emits one JsonToken per value in document order. Containers
+// are followed by their children (objects as key, value, key, value, ...)
+// and store the index one past their last descendant in `next`.
+
+enum class JsonType : uint8_t
+{
+    Null,
+    False,
+    True,
+    Number,
+    String,
+    Array,
+    Object
+};
+
+struct JsonToken
+{
+    uint32_t begin = 0;  // offset into the source (first char inside the quotes for strings)
+    uint32_t length = 0; // byte length for scalars, element/pair count for containers
+    uint32_t next = 0;   // index of the first token after this value's subtree
+    JsonType type = JsonType::Null;
+    bool escaped = false; // string contains backslash escapes
+};
+
+class JsonParseError : public std::runtime_error
+{
+  public:
+    JsonParseError(const std::string& message, size_t at)
+        : std::runtime_error(message + " at offset " + std::to_string(at)), offset(at)
+    {
+    }
+
+    size_t offset;
+};
+
+class JsonDocument
+{
+  public:
+    static constexpr int maxDepth = 512;
+
+    JsonDocument() = default;
+    explicit JsonDocument(std::string_view json) { parse(json); }
+
+    // Tokenizes `json`; throws JsonParseError on malformed input
+    void parse(std::string_view json)
+    {
+        if (json.size() > std::numeric_limits<uint32_t>::max())
+            throw JsonParseError("Document too large", 0);
+
+        src = json;
+        pos = 0;
+        tape.clear();
+        tape.reserve(json.size() / 8 + 1);
+
+        parseValue(0);
+        skipWhitespace();
+        if (pos != src.size())
+            fail("Trailing characters after JSON value");
+    }
+
+    const JsonToken& operator[](uint32_t i) const { return tape[i]; }
+    size_t tokenCount() const { return tape.size(); }
+    std::string_view source() const { return src; }
+
+    std::string_view raw(const JsonToken& t) const { return src.substr(t.begin, t.length); }
+
+    // Decode the escapes in a raw string slice; returns false on a malformed \u escape
+    static bool unescape(std::string_view raw, std::string& out)
+    {
+        out.clear();
+        out.reserve(raw.size());
+        for (size_t i = 0; i < raw.size(); ++i)
+        {
+            char c = raw[i];
+            if (c != '\\')
+            {
+                out += c;
+                continue;
+            }
+            if (++i >= raw.size())
+                return false;
+            switch (raw[i])
+            {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u':
+            {
+                uint32_t cp = 0;
+                if (!readHex4(raw, i + 1, cp))
+                    return false;
+                i += 4;
+                if (cp >= 0xD800 && cp <= 0xDBFF)
+                {
+                    uint32_t low = 0;
+                    if (i + 2 >= raw.size() || raw[i + 1] != '\\' || raw[i + 2] != 'u' ||
+                        !readHex4(raw, i + 3, low) || low < 0xDC00 || low > 0xDFFF)
+                        return false;
+                    i += 6;
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                }
+                else if (cp >= 0xDC00 && cp <= 0xDFFF)
+                {
+                    return false;
+                }
+                appendUtf8(out, cp);
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        return true;
+    }
+
+  private:
+    std::string_view src;
+    size_t pos = 0;
+    std::vector<JsonToken> tape;
+
+    [[noreturn]] void fail(const char* message) const { throw JsonParseError(message, pos); }
+
+    void skipWhitespace()
+    {
+        while (pos < src.size())
+        {
+            char c = src[pos];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+                break;
+            ++pos;
+        }
+    }
+
+    uint32_t push(JsonType type, size_t begin, size_t length)
+    {
+        JsonToken t;
+        t.type = type;
+        t.begin = static_cast<uint32_t>(begin);
+        t.length = static_cast<uint32_t>(length);
+        t.next = static_cast<uint32_t>(tape.size() + 1);
+        tape.push_back(t);
+        return static_cast<uint32_t>(tape.size() - 1);
+    }
+
+    void parseValue(int depth)
+    {
+        if (depth > maxDepth)
+            fail("Maximum nesting depth exceeded");
+
+        skipWhitespace();
+        if (pos >= src.size())
+            fail("Unexpected end of input");
+
+        switch (src[pos])
+        {
+        case '{': parseObject(depth); break;
+        case '[': parseArray(depth); break;
+        case '"': parseString(); break;
+        case 't': parseLiteral("true", JsonType::True); break;
+        case 'f': parseLiteral("false", JsonType::False); break;
+        case 'n': parseLiteral("null", JsonType::Null); break;
+        default:
+            if (src[pos] == '-' || (src[pos] >= '0' && src[pos] <= '9'))
+                parseNumber();
+            else
+                fail("Unexpected character");
+        }
+    }
+
+    void parseObject(int depth)
+    {
+        uint32_t self = push(JsonType::Object, pos, 0);
+        ++pos;
+        uint32_t count = 0;
+
+        skipWhitespace();
+        if (pos < src.size() && src[pos] == '}')
+        {
+            ++pos;
+        }
+        else
+        {
+            for (;;)
+            {
+                skipWhitespace();
+                if (pos >= src.size() || src[pos] != '"')
+                    fail("Expected string key");
+                parseString();
+
+                skipWhitespace();
+                if (pos >= src.size() || src[pos] != ':')
+                    fail("Expected ':'");
+                ++pos;
+
+                parseValue(depth + 1);
+                ++count;
+
+                skipWhitespace();
+                if (pos < src.size() && src[pos] == ',')
+                {
+                    ++pos;
+                    continue;
+                }
+                if (pos < src.size() && src[pos] == '}')
+                {
+                    ++pos;
+                    break;
+                }
+                fail("Expected ',' or '}'");
+            }
+        }
+
+        tape[self].length = count;
+        tape[self].next = static_cast<uint32_t>(tape.size());
+    }
+
+    void parseArray(int depth)
+    {
+        uint32_t self = push(JsonType::Array, pos, 0);
+        ++pos;
+        uint32_t count = 0;
+
+        skipWhitespace();
+        if (pos < src.size() && src[pos] == ']')
+        {
+            ++pos;
+        }
+        else
+        {
+            for (;;)
+            {
+                parseValue(depth + 1);
+                ++count;
+
+                skipWhitespace();
+                if (pos < src.size() && src[pos] == ',')
+                {
+                    ++pos;
+                    continue;
+                }
+                if (pos < src.size() && src[pos] == ']')
+                {
+                    ++pos;
+                    break;
+                }
+                fail("Expected ',' or ']'");
+            }
+        }
+
+        tape[self].length = count;
+        tape[self].next = static_cast<uint32_t>(tape.size());
+    }
+
+    void parseString()
+    {
+        ++pos; // opening quote
+        size_t begin = pos;
+        bool escaped = false;
+
+        for (;;)
+        {
+            if (pos >= src.size())
+                fail("Unterminated string");
+
+            unsigned char c = static_cast<unsigned char>(src[pos]);
+            if (c == '"')
+                break;
+            if (c < 0x20)
+                fail("Unescaped control character in string");
+            if (c == '\\')
+            {
+                escaped = true;
+                if (pos + 1 >= src.size())
+                    fail("Unterminated string");
+                char e = src[pos + 1];
+                if (e == 'u')
+                {
+                    uint32_t cp = 0;
+                    if (!readHex4(src, pos + 2, cp))
+                        fail("Invalid \\u escape");
+                    pos += 6;
+                    continue;
+                }
+                if (e != '"' && e != '\\' && e != '/' && e != 'b' && e != 'f' && e != 'n' &&
+                    e != 'r' && e != 't')
+                    fail("Invalid escape sequence");
+                pos += 2;
+                continue;
+            }
+            ++pos;
+        }
+
+        uint32_t self = push(JsonType::String, begin, pos - begin);
+        tape[self].escaped = escaped;
+        ++pos; // closing quote
+    }
+
+    void parseNumber()
+    {
+        size_t begin = pos;
+        auto digits = [&]
+        {
+            size_t start = pos;
+            while (pos < src.size() && src[pos] >= '0' && src[pos] <= '9')
+                ++pos;
+            return pos - start;
+        };
+
+        if (src[pos] == '-')
+            ++pos;
+        if (pos < src.size() && src[pos] == '0')
+            ++pos;
+        else if (digits() == 0)
+            fail("Invalid number");
+
+        if (pos < src.size() && src[pos] == '.')
+        {
+            ++pos;
+            if (digits() == 0)
+                fail("Invalid number");
+        }
+        if (pos < src.size() && (src[pos] == 'e' || src[pos] == 'E'))
+        {
+            ++pos;
+            if (pos < src.size() && (src[pos] == '+' || src[pos] == '-'))
+                ++pos;
+            if (digits() == 0)
+                fail("Invalid number");
+        }
+
+        push(JsonType::Number, begin, pos - begin);
+    }
+
+    void parseLiteral(std::string_view word, JsonType type)
+    {
+        if (src.substr(pos, word.size()) != word)
+            fail("Invalid literal");
+        push(type, pos, word.size());
+        pos += word.size();
+    }
+
+    static bool readHex4(std::string_view s, size_t at, uint32_t& out)
+    {
+        if (at + 4 > s.size())
+            return false;
+        auto [ptr, ec] = std::from_chars(s.data() + at, s.data() + at + 4, out, 16);
+        return ec == std::errc() && ptr == s.data() + at + 4;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t cp)
+    {
+        if (cp < 0x80)
+        {
+            out += static_cast<char>(cp);
+        }
+        else if (cp < 0x800)
+        {
+            out += static_cast<char>(0xC0 | (cp >> 6));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else if (cp < 0x10000)
+        {
+            out += static_cast<char>(0xE0 | (cp >> 12));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        else
+        {
+            out += static_cast<char>(0xF0 | (cp >> 18));
+            out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    }
+};
+
+// ============================================================================
+// JSON NODE - meta::Node view over one tape entry
+// ============================================================================
+
+class JsonNode : public Node
+{
+    const JsonDocument* doc;
+    uint32_t index;
+
+    // Sequential at(i) calls resume from the last element instead of
+    // re-walking the array from the start
+    mutable uint32_t cachedElement = 0;
+    mutable uint32_t cachedToken = 0;
+
+    // at(key) searches from the member after the last hit, wrapping around,
+    // so fields read in document order skip the members in between once
+    // instead of rescanning them for every field
+    mutable uint32_t cachedMember = 0;
+    mutable uint32_t cachedKey = 0;
+
+    const JsonToken& token() const { return (*doc)[index]; }
+
+    template <typename N>
+    static std::optional<N> parseNumber(std::string_view raw)
+    {
+        N value{};
+        auto [ptr, ec] = std::from_chars(raw.data(), raw.data() + raw.size(), value);
+        if (ec != std::errc() || ptr != raw.data() + raw.size())
+            return {};
+        return value;
+    }
+
+    bool keyEquals(const JsonToken& key, std::string_view k) const
+    {
+        if (!key.escaped)
+            return doc->raw(key) == k;
+        std::string decoded;
+        return JsonDocument::unescape(doc->raw(key), decoded) && decoded == k;
+    }
+
+  public:
+    JsonNode(const JsonDocument& d, uint32_t i) : doc(&d), index(i) {}
+
+    JsonType type() const { return token().type; }
+
+    std::optional<int> asInt() const override
+    {
+        if (token().type != JsonType::Number)
+            return {};
+        return parseNumber<int>(doc->raw(token()));
+    }
+
+    std::optional<int64_t> asInt64() const override
+    {
+        if (token().type != JsonType::Number)
+            return {};
+        return parseNumber<int64_t>(doc->raw(token()));
+    }
+
+    std::optional<uint64_t> asUInt64() const override
+    {
+        if (token().type != JsonType::Number)
+            return {};
+        return parseNumber<uint64_t>(doc->raw(token()));
+    }
+
+    std::optional<double> asDouble() const override
+    {
+        if (token().type != JsonType::Number)
+            return {};
+        return parseNumber<double>(doc->raw(token()));
+    }
+
+    std::optional<bool> asBool() const override
+    {
+        if (token().type == JsonType::True)
+            return true;
+        if (token().type == JsonType::False)
+            return false;
+        return {};
+    }
+
+    std::optional<std::string> asString() const override
+    {
+        const JsonToken& t = token();
+        if (t.type != JsonType::String)
+            return {};
+        if (!t.escaped)
+            return std::string(doc->raw(t));
+        std::string decoded;
+        if (!JsonDocument::unescape(doc->raw(t), decoded))
+            return {};
+        return decoded;
+    }
+
+    std::optional<std::string_view> asSourceView() const override
+    {
+        const JsonToken& t = token();
+        if (t.type != JsonType::String || t.escaped)
+            return {};
+        return doc->raw(t);
+    }
+
+    std::optional<std::string_view> asStringView(std::string& scratch) const override
+    {
+        const JsonToken& t = token();
+        if (t.type != JsonType::String)
+            return {};
+        if (!t.escaped)
+            return doc->raw(t);
+        if (!JsonDocument::unescape(doc->raw(t), scratch))
+            return {};
+        return std::string_view(scratch);
+    }
+
+    size_t subtreeSize() const override { return token().next - index; }
+    bool isSequence() const override { return token().type == JsonType::Array; }
+    bool isMap() const override { return token().type == JsonType::Object; }
+    bool isNull() const override { return token().type == JsonType::Null; }
+
+    size_t size() const override
+    {
+        const JsonToken& t = token();
+        return (t.type == JsonType::Array || t.type == JsonType::Object) ? t.length : 0;
+    }
+
+    Node* at(size_t i, NodeCursor& out) const override
+    {
+        const JsonToken& t = token();
+        if (t.type != JsonType::Array || i >= t.length)
+            return nullptr;
+
+        uint32_t element = 0;
+        uint32_t tok = index + 1;
+        if (cachedToken != 0 && i >= cachedElement)
+        {
+            element = cachedElement;
+            tok = cachedToken;
+        }
+        for (; element < i; ++element)
+            tok = (*doc)[tok].next;
+
+        cachedElement = element;
+        cachedToken = tok;
+        return out.emplace<JsonNode>(*doc, tok);
+    }
+
+    Node* at(std::string_view k, NodeCursor& out) const override
+    {
+        const JsonToken& t = token();
+        if (t.type != JsonType::Object)
+            return nullptr;
+
+        uint32_t member = cachedKey ? cachedMember : 0;
+        uint32_t tok = cachedKey ? cachedKey : index + 1;
+        for (uint32_t n = 0; n < t.length; ++n, ++member)
+        {
+            if (member == t.length)
+            {
+                member = 0;
+                tok = index + 1;
+            }
+            uint32_t value = tok + 1;
+            const JsonToken& key = (*doc)[tok];
+            tok = (*doc)[value].next;
+            if (keyEquals(key, k))
+            {
+                cachedMember = member + 1;
+                cachedKey = tok;
+                return out.emplace<JsonNode>(*doc, value);
+            }
+        }
+        return nullptr;
+    }
+
+    KeyNames keyNames() const override { return KeyNames::Json; }
+
+    // The tape is immutable once parsed; only the at(i) cache is per view,
+    // and the copy starts from the same position
+    Node* concurrentView(NodeCursor& out) const override
+    {
+        return out.emplace<JsonNode>(*this);
+    }
+
+    void visitEntries(EntryVisitor& visitor) const override
+    {
+        const JsonToken& t = token();
+        if (t.type != JsonType::Object)
+            return;
+
+        NodeCursor value;
+        std::string decoded;
+        uint32_t tok = index + 1;
+        for (uint32_t n = 0; n < t.length; ++n)
+        {
+            const JsonToken& key = (*doc)[tok];
+            std::string_view name = doc->raw(key);
+            if (key.escaped)
+            {
+                JsonDocument::unescape(name, decoded);
+                name = decoded;
+            }
+            if (!visitor.entry(name, value.emplace<JsonNode>(*doc, tok + 1)))
+                return;
+            tok = (*doc)[tok + 1].next;
+        }
+    }
+};
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+// Reads into an existing object; see reifyFromYaml(T&, ...) in meta.h
+template <typename T>
+ValidationResult fromJson(T& obj, const JsonDocument& doc)
+{
+    JsonNode root(doc, 0);
+    return from(obj, &root);
+}
+
+template <typename T>
+ValidationResult fromJson(T& obj, std::string_view json)
+{
+    try
+    {
+        JsonDocument doc(json);
+        return fromJson(obj, doc);
+    }
+    catch (const std::exception& e)
+    {
+        ValidationResult result;
+        result.addError("json", std::string(e.what()));
+        return result;
+    }
+}
+
+template <typename T>
+std::pair<std::optional<T>, ValidationResult> fromJson(const JsonDocument& doc)
+{
+    return readInPlace<T>([&](T& obj) { return fromJson(obj, doc); });
+}
+
+template <typename T>
+std::pair<std::optional<T>, ValidationResult> fromJson(std::string_view json)
+{
+    return readInPlace<T>([&](T& obj) { return fromJson(obj, json); });
+}
+
+// Every std::pmr string and container in the result is allocated from
+// resource (see ArenaScope in meta.h)
+template <typename T>
+std::pair<std::optional<T>, ValidationResult> fromJson(std::string_view json, std::pmr::memory_resource* resource)
+{
+    ArenaScope arena(resource);
+    return fromJson<T>(json);
+}
+
+// fromJson, for META_EXTERN_TEMPLATES / META_INSTANTIATE_TEMPLATES in meta.h
+#define META_JSON_TEMPLATES(prefix, ...)                                                                              \
+    prefix meta::ValidationResult meta::fromJson<__VA_ARGS__>(__VA_ARGS__&, const meta::JsonDocument&);               \
+    prefix meta::ValidationResult meta::fromJson<__VA_ARGS__>(__VA_ARGS__&, std::string_view);                        \
+    prefix std::pair<std::optional<__VA_ARGS__>, meta::ValidationResult> meta::fromJson<__VA_ARGS__>(                 \
+        const meta::JsonDocument&);                                                                                   \
+    prefix std::pair<std::optional<__VA_ARGS__>, meta::ValidationResult> meta::fromJson<__VA_ARGS__>(                 \
+        std::string_view)
+
+} // namespace meta
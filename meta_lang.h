@@ -1,4 +1,3 @@
-
 /**
  * @file meta_lang.h
  * @brief Cross-Language Type Mapping and Reflection System
@@ -7,24 +6,8 @@
  *
  * Idea by John Grillo
  * Database of languages by Claude AI
-
- * A C++ template metaprogramming systestruct LanguageConfig<Language::PERL> {
-    struct Types {
-        static constexpr const char* int_val = "Int";
-        static constexpr const char* int16_val = "Int";
-        static constexpr const char* string_val = "Str";
-        static constexpr const char* bool_val = "Bool";
-        static constexpr const char* double_val = "Num";
-        static constexpr const char* float_val = "Num";
-    };
-
-    struct Containers {
-        static constexpr const char* vector_fmt = "ArrayRef[{}]";
-        static constexpr const char* map_fmt = "HashRef[{}]";
-        static constexpr const char* optional_fmt = "Maybe[{}]";
-    };
-};
- * Automatically maps C++ types
+ *
+ * A C++ template metaprogramming system that automatically maps C++ types
  * to equivalent types in different programming languages. Uses compile-time
  * reflection to generate language-specific type definitions from a single
  * C++ source of truth.
@@ -34,7 +17,8 @@
  * - Compile-time type safety and validation
  * - Extensible language configuration system
  * - Support for primitives, containers, and optionals
- * - Zero runtime overhead (all template metaprogramming)
+ * - Complete schema documents built at compile time (see SCHEMA ARTIFACTS):
+ *   JSON Schema, proto3, and Python / Rust decoders for meta_binary.h
  *
  * Supported Languages:
  * C++, Java, Python, TypeScript, Rust, Go, C#, Kotlin, Swift, JavaScript,
@@ -47,23 +31,33 @@
  *     int id;
  *     std::string name;
  *     std::vector<double> values;
+ *     static constexpr auto FieldsMeta = std::make_tuple(
+ *         meta::field<&MyData::id>("id"),
+ *         meta::field<&MyData::name>("name"),
+ *         meta::field<&MyData::values>("values"));
  * };
  *
- * // Generate type definitions for all languages
- * std::string cpp_def = meta::reflect<MyData, Language::CPP>();
- * std::string java_def = meta::reflect<MyData, Language::JAVA>();
+ * // Type declarations for one language
  * std::string rust_def = meta::reflect<MyData, Language::RUST>();
+ *
+ * // Whole documents, as constexpr std::string_view
+ * constexpr auto schema = meta::jsonSchema<MyData>();
+ * constexpr auto proto = meta::protoSchema<MyData>();
+ * constexpr auto codec = meta::pythonCodec<MyData>();
  * @endcode
  *
  * Architecture:
  * - LanguageConfig<Lang>: Type mapping configurations per language
  * - CleanTypeMapper<T, Lang>: Template-based type resolution
  * - meta::reflect<T, Lang>(): Main reflection entry point
+ * - meta::jsonSchema / protoSchema / pythonCodec / rustCodec<T>()
  *
- * @note Requires C++17 or later for constexpr if and fold expressions
+ * @note Requires C++20 (constexpr std::string and std::vector)
  */
 
 #pragma once
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <iostream>
 #include <map>
@@ -71,8 +65,13 @@
 #include <sstream>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include "meta.h"
+#include "meta_binary.h"
+#include "meta_proto.h"
+
 enum class Language
 {
     CPP,
@@ -104,7 +103,7 @@ enum class Language
 
 #include <unordered_map>
 
-const std::unordered_map<Language, std::string> languageMap = {
+inline const std::unordered_map<Language, std::string> languageMap = {
     {Language::CPP, "C++"},
     {Language::JAVA, "Java"},
     {Language::PYTHON, "Python"},
@@ -131,7 +130,7 @@ const std::unordered_map<Language, std::string> languageMap = {
     {Language::MATLAB, "MATLAB"},
     {Language::JULIA, "Julia"}};
 
-std::string languageToString(Language lang)
+inline std::string languageToString(Language lang)
 {
     auto it = languageMap.find(lang);
     return (it != languageMap.end()) ? it->second : "Unknown";
@@ -186,7 +185,7 @@ template <typename T, Language Lang> struct TypeMapper
     }
 };
 
-std::string format_string(const std::string& format, const std::string& replacement)
+inline std::string format_string(const std::string& format, const std::string& replacement)
 {
     std::string result = format;
     size_t pos = result.find("{}");
@@ -197,9 +196,9 @@ std::string format_string(const std::string& format, const std::string& replacem
     return result;
 }
 
-std::string format_string(const std::string& format,
-                          const std::string& first,
-                          const std::string& second)
+inline std::string format_string(const std::string& format,
+                                 const std::string& first,
+                                 const std::string& second)
 {
     std::string result = format;
     size_t pos = result.find("{}");
@@ -796,7 +795,7 @@ namespace meta
 template <typename ObjectType, Language Lang> std::string reflect()
 {
     std::ostringstream os;
-    auto& tpl = meta::MetaTuple<ObjectType>::fields;
+    auto& tpl = get_fields<ObjectType>();
     os << languageMap.at(Lang) << "\n";
     std::apply(
         [&](auto&&... fieldMeta) -> void
@@ -811,3 +810,1550 @@ template <typename ObjectType, Language Lang> std::string reflect()
     return os.str();
 }
 } // namespace meta
+
+// ============================================================================
+// SCHEMA ARTIFACTS
+// ============================================================================
+// Complete documents generated from FieldsMeta at compile time and stored
+// as constant strings in the binary:
+//
+//   jsonSchema<T>()   JSON Schema (2020-12) for what toJson writes
+//   protoSchema<T>()  proto3 messages for what toProto writes
+//   pythonCodec<T>()  Python dataclasses and a decoder for toBinary output
+//   rustCodec<T>()    Rust structs and a decoder for toBinary output
+//
+// Each covers T and every struct and enum it reaches, defined before they
+// are used. The codecs read the binary layout described in meta_binary.h:
+// they skip unknown tags and read a packed sequence as one block (through
+// struct.iter_unpack in Python), but leave validation attributes and
+// missing required fields to the C++ side. The field tables must be
+// `static constexpr`.
+//
+//   static constexpr std::string_view schema = meta::jsonSchema<Order>();
+//   std::ofstream("order.py") << meta::pythonCodec<Order>();
+
+namespace meta
+{
+namespace lang_detail
+{
+
+template <typename T> struct SequenceOf : std::false_type {};
+template <typename T> struct SequenceOf<std::vector<T>> : std::true_type { using Element = T; static constexpr bool unique = false; };
+template <typename T> struct SequenceOf<std::deque<T>> : std::true_type { using Element = T; static constexpr bool unique = false; };
+template <typename T> struct SequenceOf<std::set<T>> : std::true_type { using Element = T; static constexpr bool unique = true; };
+
+template <typename T> struct MapOf : std::false_type {};
+template <typename K, typename V> struct MapOf<std::map<K, V>> : std::true_type { using Key = K; using Value = V; static constexpr bool ordered = true; };
+template <typename K, typename V> struct MapOf<std::unordered_map<K, V>> : std::true_type { using Key = K; using Value = V; static constexpr bool ordered = false; };
+
+// Calls f(std::type_identity<Element>{}, index) for each element type of a
+// pair, tuple or variant
+template <typename T> struct ElementsOf : std::false_type {};
+
+template <template <typename...> class L, typename... A>
+struct ElementsOfList : std::true_type
+{
+    static constexpr size_t count = sizeof...(A);
+
+    template <typename F> static constexpr void each(F&& f)
+    {
+        size_t i = 0;
+        (..., f(std::type_identity<A>{}, i++));
+    }
+};
+
+template <typename A, typename B> struct ElementsOf<std::pair<A, B>> : ElementsOfList<std::pair, A, B> {};
+template <typename... A> struct ElementsOf<std::tuple<A...>> : ElementsOfList<std::tuple, A...> {};
+
+template <typename T> struct Unwrapped { using type = T; };
+template <typename T> struct Unwrapped<std::optional<T>> { using type = T; };
+
+template <typename T> struct PackedSequence : std::false_type {};
+template <typename T> requires SequenceOf<T>::value struct PackedSequence<T> : std::bool_constant<PackedBinary<typename SequenceOf<T>::Element>> {};
+
+template <typename T> struct VariantOf : std::false_type {};
+template <typename... A> struct VariantOf<std::variant<A...>> : ElementsOfList<std::variant, A...> {};
+
+template <typename T>
+concept TextType = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+                   std::is_same_v<T, std::filesystem::path>;
+
+template <typename T>
+concept BlobType = std::is_same_v<T, std::span<const std::byte>>;
+
+template <typename A> struct BoundsOf : std::false_type {};
+template <auto Min, auto Max>
+struct BoundsOf<BoundsCheck<Min, Max>> : std::bool_constant<IntegerType<decltype(Min)> && IntegerType<decltype(Max)>>
+{
+    static constexpr auto min = Min;
+    static constexpr auto max = Max;
+};
+
+template <typename A> struct LengthOf : std::false_type {};
+template <size_t Min, size_t Max> struct LengthOf<StringLength<Min, Max>> : std::true_type {};
+
+template <typename A> struct WhitelistOf : std::false_type {};
+template <const auto& Allowed> struct WhitelistOf<Whitelist<Allowed>> : std::true_type { static constexpr auto& values = Allowed; };
+
+// ----------------------------------------------------------------------------
+// Text helpers (std::to_chars isn't constexpr)
+// ----------------------------------------------------------------------------
+
+template <typename I>
+constexpr void appendInteger(std::string& out, I value)
+{
+    uint64_t v = static_cast<uint64_t>(value);
+    if constexpr (std::is_signed_v<I>)
+    {
+        if (value < 0)
+        {
+            out += '-';
+            v = 0 - v;
+        }
+    }
+    char digits[20]{};
+    size_t n = 0;
+    do
+    {
+        digits[n++] = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v != 0);
+    while (n > 0)
+        out += digits[--n];
+}
+
+template <typename I>
+constexpr std::string integerText(I value)
+{
+    std::string out;
+    appendInteger(out, value);
+    return out;
+}
+
+constexpr std::string hexText(uint64_t v)
+{
+    std::string out = "0x";
+    for (int shift = 60; shift >= 0; shift -= 4)
+        out += "0123456789abcdef"[(v >> shift) & 0xF];
+    return out;
+}
+
+// The smaller / larger of two integers of any signedness, as text. (GCC 12
+// can't evaluate `?:` between std::string prvalues at compile time, so
+// there are none in this section.)
+template <typename A, typename B>
+constexpr std::string smallerText(A a, B b)
+{
+    if (std::cmp_less(a, b))
+        return integerText(a);
+    return integerText(b);
+}
+
+template <typename A, typename B>
+constexpr std::string largerText(A a, B b)
+{
+    if (std::cmp_less(a, b))
+        return integerText(b);
+    return integerText(a);
+}
+
+// A JSON string literal
+constexpr std::string jsonString(std::string_view s)
+{
+    std::string out = "\"";
+    for (char c : s)
+    {
+        auto u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if (u < 0x20)
+        {
+            out += "\\u00";
+            out += "0123456789abcdef"[u >> 4];
+            out += "0123456789abcdef"[u & 0xF];
+        }
+        else
+            out += c;
+    }
+    return out + "\"";
+}
+
+constexpr bool isWordChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+inline constexpr std::string_view reservedWords[] = {
+    // Python
+    "False", "None", "True", "and", "as", "assert", "async", "await", "break", "class", "continue", "def", "del",
+    "elif", "else", "except", "finally", "for", "from", "global", "if", "import", "in", "is", "lambda",
+    "nonlocal", "not", "or", "pass", "raise", "return", "try", "while", "with", "yield",
+    // Rust
+    "Self", "abstract", "become", "box", "const", "crate", "do", "dyn", "enum", "extern", "false", "final", "fn",
+    "impl", "let", "loop", "macro", "match", "mod", "move", "mut", "override", "priv", "pub", "ref", "self",
+    "static", "struct", "super", "trait", "true", "type", "typeof", "unsafe", "unsized", "use", "virtual",
+    "where"};
+
+// name as an identifier: other characters become '_', and names that
+// are keywords in the generated languages get a '_' appended
+constexpr std::string identifier(std::string_view name)
+{
+    std::string out;
+    for (char c : name)
+        out += isWordChar(c) ? c : '_';
+    if (out.empty() || (out[0] >= '0' && out[0] <= '9'))
+        out.insert(out.begin(), '_');
+    for (std::string_view word : reservedWords)
+        if (out == word)
+            return out + "_";
+    return out;
+}
+
+// "ns::Outer<ns::Inner, 3>" -> "Outer_ns_Inner_3"
+template <typename T>
+constexpr std::string typeIdentifier()
+{
+    std::string_view full = type_name<T>();
+    size_t start = 0;
+    int depth = 0;
+    for (size_t i = 0; i < full.size(); ++i)
+    {
+        if (full[i] == '<')
+            ++depth;
+        else if (full[i] == '>')
+            --depth;
+        else if (full[i] == ':' && depth == 0)
+            start = i + 1;
+    }
+    std::string out;
+    bool gap = false;
+    for (char c : full.substr(start))
+    {
+        if (!isWordChar(c))
+        {
+            gap = true;
+            continue;
+        }
+        if (gap && !out.empty())
+            out += '_';
+        out += c;
+        gap = false;
+    }
+    return identifier(out);
+}
+
+// "OrderStatus" / "in-transit" -> "ORDER_STATUS" / "IN_TRANSIT"
+constexpr std::string upperSnake(std::string_view name)
+{
+    std::string out;
+    char prev = 0;
+    for (char c : name)
+    {
+        bool upper = c >= 'A' && c <= 'Z';
+        if (upper && ((prev >= 'a' && prev <= 'z') || (prev >= '0' && prev <= '9')))
+            out += '_';
+        if (c >= 'a' && c <= 'z')
+            out += static_cast<char>(c - 'a' + 'A');
+        else
+            out += isWordChar(c) ? c : '_';
+        prev = c;
+    }
+    return out;
+}
+
+constexpr std::string indented(std::string_view text, std::string_view prefix)
+{
+    std::string out;
+    bool lineStart = true;
+    for (char c : text)
+    {
+        if (lineStart && c != '\n')
+            out += prefix;
+        out += c;
+        lineStart = c == '\n';
+    }
+    return out;
+}
+
+// ----------------------------------------------------------------------------
+// Shared state of one generated document
+// ----------------------------------------------------------------------------
+
+struct SchemaText
+{
+    // Definitions so far, each complete before the ones that use it
+    std::vector<std::string> definitions;
+    std::vector<std::string_view> defined;
+    std::vector<std::string_view> types;
+    std::vector<std::string> names;
+    int anonymous = 0;
+
+    // True the first time it is called for T
+    template <typename T>
+    constexpr bool claim()
+    {
+        for (auto key : defined)
+            if (key == type_name<T>())
+                return false;
+        defined.push_back(type_name<T>());
+        return true;
+    }
+
+    template <typename T>
+    constexpr bool named() const
+    {
+        for (auto key : types)
+            if (key == type_name<T>())
+                return true;
+        return false;
+    }
+
+    // T's short name, made unique within the document
+    template <typename T>
+    constexpr std::string nameOf()
+    {
+        return nameOf<T>(typeIdentifier<T>());
+    }
+
+    template <typename T>
+    constexpr std::string nameOf(std::string base)
+    {
+        for (size_t i = 0; i < types.size(); ++i)
+            if (types[i] == type_name<T>())
+                return names[i];
+        std::string name = base;
+        for (int n = 2;; ++n)
+        {
+            bool taken = false;
+            for (const auto& other : names)
+                taken = taken || other == name;
+            if (!taken)
+                break;
+            name = base + "_" + integerText(n);
+        }
+        types.push_back(type_name<T>());
+        names.push_back(name);
+        return name;
+    }
+
+    constexpr std::string joined(std::string_view separator) const
+    {
+        std::string out;
+        for (size_t i = 0; i < definitions.size(); ++i)
+        {
+            if (i)
+                out += separator;
+            out += definitions[i];
+        }
+        return out;
+    }
+};
+
+template <typename S>
+constexpr void requireConstexprFields()
+{
+    static_assert(ConstexprFields<S>, "Schemas are built at compile time: declare FieldsMeta static constexpr");
+}
+
+// Calls f(field, index) for each field of S
+template <typename S, typename F>
+constexpr void forEachField(F&& f)
+{
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (..., f(std::get<I>(get_fields<S>()), std::integral_constant<size_t, I>{}));
+    }(std::make_index_sequence<field_count_v<S>>{});
+}
+
+// {value, name} pairs of a registered enum, first name per value first
+template <RegisteredEnum E>
+constexpr auto enumEntries()
+{
+    using U = std::underlying_type_t<E>;
+    std::vector<std::pair<U, std::string_view>> entries;
+    for (const auto& [value, name] : EnumMapping<E>::Type::mapping)
+        entries.emplace_back(static_cast<U>(value), std::string_view(name));
+    return entries;
+}
+
+// Turns Gen::build() into static storage
+template <typename Gen>
+struct Baked
+{
+    static constexpr size_t size = Gen::build().size();
+
+    static constexpr std::array<char, size> text = []
+    {
+        std::array<char, size> out{};
+        std::string built = Gen::build();
+        std::copy(built.begin(), built.end(), out.begin());
+        return out;
+    }();
+
+    static constexpr std::string_view view() { return {text.data(), size}; }
+};
+
+// ----------------------------------------------------------------------------
+// JSON Schema
+// ----------------------------------------------------------------------------
+// Matches toJson: enums as their names, maps as objects (integer keys as
+// digit strings), pairs and tuples as fixed arrays, optionals as the value
+// or null, tagged variants as {"<key>": "<tag>", "<valueKey>": value}.
+// Integral BoundsCheck, StringLength and Whitelist attributes become
+// constraints; structs with a Ser hook are left unconstrained.
+
+struct JsonSchemaWriter
+{
+    SchemaText& s;
+
+    static constexpr std::string ref(std::string_view name) { return "{\"$ref\": \"#/$defs/" + std::string(name) + "\"}"; }
+
+    template <typename L, typename H>
+    static constexpr std::string integer(L lo, H hi)
+    {
+        return "{\"type\": \"integer\", \"minimum\": " + integerText(lo) + ", \"maximum\": " + integerText(hi) + "}";
+    }
+
+    template <typename T>
+    constexpr std::string of()
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return "{\"type\": \"boolean\"}";
+        else if constexpr (IntegerType<T>)
+            return integer(std::numeric_limits<StandardInteger<T>>::min(), std::numeric_limits<StandardInteger<T>>::max());
+        else if constexpr (FloatingPointType<T>)
+            return "{\"type\": \"number\"}";
+        else if constexpr (TextType<T> || BlobType<T> || StringType<T>)
+            return "{\"type\": \"string\"}";
+        else if constexpr (std::is_same_v<T, std::monostate>)
+            return "{\"type\": \"null\"}";
+        else if constexpr (RegisteredEnum<T>)
+        {
+            std::string name = s.nameOf<T>();
+            if (s.claim<T>())
+            {
+                std::string values;
+                for (auto [value, valueName] : enumEntries<T>())
+                    values += (values.empty() ? "" : ", ") + jsonString(valueName);
+                s.definitions.push_back(jsonString(name) + ": {\"type\": \"string\", \"enum\": [" + values + "]}");
+            }
+            return ref(name);
+        }
+        else if constexpr (HasFields<T>)
+        {
+            std::string name = s.nameOf<T>();
+            if (s.claim<T>())
+                s.definitions.push_back(jsonString(name) + ": " + structure<T>());
+            return ref(name);
+        }
+        else if constexpr (is_optional_v<T>)
+            return "{\"anyOf\": [" + of<typename T::value_type>() + ", {\"type\": \"null\"}]}";
+        else if constexpr (SequenceOf<T>::value)
+            return "{\"type\": \"array\", \"items\": " + of<typename SequenceOf<T>::Element>() +
+                   (SequenceOf<T>::unique ? ", \"uniqueItems\": true}" : "}");
+        else if constexpr (MapOf<T>::value)
+        {
+            using K = typename MapOf<T>::Key;
+            static_assert(IntegerType<K> || StringType<K>, "JSON object keys are strings or integers");
+            std::string keys = IntegerType<K> ? "\"propertyNames\": {\"pattern\": \"^-?[0-9]+$\"}, " : "";
+            return "{\"type\": \"object\", " + keys + "\"additionalProperties\": " + of<typename MapOf<T>::Value>() + "}";
+        }
+        else if constexpr (ElementsOf<T>::value)
+        {
+            std::string items;
+            ElementsOf<T>::each([&](auto id, size_t i) { items += (i ? ", " : "") + of<typename decltype(id)::type>(); });
+            return "{\"type\": \"array\", \"prefixItems\": [" + items + "], \"items\": false}";
+        }
+        else if constexpr (VariantOf<T>::value && TaggedVariant<T>)
+        {
+            std::string tag = jsonString(variantTagKey<T>());
+            std::string valueKey = jsonString(variantValueKey<T>());
+            std::string alternatives;
+            VariantOf<T>::each([&](auto id, size_t i)
+            {
+                using A = typename decltype(id)::type;
+                std::string alternative = "{\"type\": \"object\", \"properties\": {" + tag + ": {\"const\": " +
+                                          jsonString(VariantTags<T>::names[i]) + "}";
+                if constexpr (std::is_same_v<A, std::monostate>)
+                    alternative += "}, \"required\": [" + tag + "]}";
+                else
+                    alternative += ", " + valueKey + ": " + of<A>() + "}, \"required\": [" + tag + ", " + valueKey + "]}";
+                alternatives += (i ? ", " : "") + alternative;
+            });
+            return "{\"oneOf\": [" + alternatives + "]}";
+        }
+        else if constexpr (VariantOf<T>::value)
+        {
+            std::string alternatives;
+            VariantOf<T>::each([&](auto id, size_t i) { alternatives += (i ? ", " : "") + of<typename decltype(id)::type>(); });
+            return "{\"anyOf\": [" + alternatives + "]}";
+        }
+        else
+        {
+            static_assert(HasFields<T>, "type has no JSON Schema equivalent");
+            return {};
+        }
+    }
+
+    // One field's schema with its validation attributes applied
+    template <typename M, typename F>
+    constexpr std::string property(const F& field)
+    {
+        if constexpr (is_optional_v<M>)
+            return "{\"anyOf\": [" + property<typename M::value_type>(field) + ", {\"type\": \"null\"}]}";
+        else
+        {
+            std::string out = of<M>();
+            std::string constraints;
+            std::apply([&](const auto&... attrs)
+            {
+                (..., [&]<typename A>(const A&)
+                {
+                    if constexpr (BoundsOf<A>::value && IntegerType<M>)
+                        out = "{\"type\": \"integer\", \"minimum\": " +
+                              largerText(BoundsOf<A>::min, std::numeric_limits<StandardInteger<M>>::min()) +
+                              ", \"maximum\": " +
+                              smallerText(BoundsOf<A>::max, std::numeric_limits<StandardInteger<M>>::max()) + "}";
+                    else if constexpr (LengthOf<A>::value && TextType<M>)
+                        constraints += ", \"minLength\": " + integerText(A::min) + ", \"maxLength\": " + integerText(A::max);
+                    else if constexpr (WhitelistOf<A>::value)
+                    {
+                        std::string values;
+                        for (const auto& allowed : WhitelistOf<A>::values)
+                        {
+                            if constexpr (std::is_convertible_v<decltype(allowed), std::string_view>)
+                                values += (values.empty() ? "" : ", ") + jsonString(std::string_view(allowed));
+                            else if constexpr (IntegerType<std::remove_cvref_t<decltype(allowed)>>)
+                                values += (values.empty() ? "" : ", ") + integerText(allowed);
+                        }
+                        if (!values.empty())
+                            constraints += ", \"enum\": [" + values + "]";
+                    }
+                }(attrs));
+            }, field.attributes);
+            if (!constraints.empty())
+                out.insert(out.size() - 1, constraints);
+            return out;
+        }
+    }
+
+    template <typename S>
+    constexpr std::string structure()
+    {
+        if constexpr (requires { typename S::Ser; })
+            return "{\"description\": \"written by a custom serializer\"}";
+        else
+        {
+            requireConstexprFields<S>();
+            std::string properties;
+            std::string required;
+            forEachField<S>([&](const auto& field, auto)
+            {
+                using M = typename std::decay_t<decltype(field)>::MemberType;
+                std::string key = jsonString(field.getJsonProperty());
+                properties += (properties.empty() ? "\n" : ",\n") + ("    " + key) + ": " + property<M>(field);
+                if (field.requirement == Requirement::Required)
+                    required += (required.empty() ? "" : ", ") + key;
+            });
+            std::string out = "{\n  \"type\": \"object\",\n  \"properties\": {" + properties + "\n  }";
+            if (!required.empty())
+                out += ",\n  \"required\": [" + required + "]";
+            return out + "\n}";
+        }
+    }
+};
+
+template <typename T>
+struct JsonSchemaGen
+{
+    static constexpr std::string build()
+    {
+        SchemaText s;
+        JsonSchemaWriter writer{s};
+        std::string root = writer.of<T>();
+        std::string out = "{\n  \"$schema\": \"https://json-schema.org/draft/2020-12/schema\"";
+        if (root.size() > 2)
+            out += ",\n  " + root.substr(1, root.size() - 2);
+        if (!s.definitions.empty())
+            out += ",\n  \"$defs\": {\n" + indented(s.joined(",\n"), "    ") + "\n  }";
+        return out + "\n}\n";
+    }
+};
+
+// ----------------------------------------------------------------------------
+// proto3
+// ----------------------------------------------------------------------------
+// Field numbers and integer encodings come from ProtoField<N, E>, as in
+// meta_proto.h. Enum values are prefixed with the enum's name, and an
+// <ENUM>_UNSPECIFIED = 0 is added when no value is zero.
+
+struct ProtoWriter
+{
+    SchemaText& s;
+
+    template <typename T, ProtoEncoding E>
+    constexpr std::string scalar()
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return "bool";
+        else if constexpr (std::is_same_v<T, float>)
+            return "float";
+        else if constexpr (FloatingPointType<T>)
+            return "double";
+        else if constexpr (IntegerType<T>)
+        {
+            std::string bits = sizeof(T) <= 4 ? "32" : "64";
+            if constexpr (E == ProtoEncoding::Fixed)
+                return (std::is_signed_v<T> ? "sfixed" : "fixed") + bits;
+            else if constexpr (E == ProtoEncoding::ZigZag)
+                return "sint" + bits;
+            else
+                return (std::is_signed_v<T> ? "int" : "uint") + bits;
+        }
+        else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::filesystem::path>)
+            return "string";
+        else if constexpr (RegisteredEnum<T>)
+        {
+            std::string name = s.nameOf<T>();
+            if (s.claim<T>())
+                s.definitions.push_back(enumeration<T>(name));
+            return name;
+        }
+        else if constexpr (HasFields<T>)
+        {
+            std::string name = s.nameOf<T>();
+            if (s.claim<T>())
+                s.definitions.push_back(message<T>(name));
+            return name;
+        }
+        else
+        {
+            static_assert(ProtoScalar<T> || HasFields<T>, "type has no protobuf equivalent");
+            return {};
+        }
+    }
+
+    template <typename M, ProtoEncoding E>
+    constexpr std::string fieldType()
+    {
+        if constexpr (is_optional_v<M>)
+        {
+            using V = typename M::value_type;
+            static_assert(!ProtoRepeated<V>::value && !ProtoMap<V>::value, "protobuf has no optional repeated fields");
+            return (HasFields<V> ? "" : "optional ") + scalar<V, E>();
+        }
+        else if constexpr (ProtoRepeated<M>::value)
+        {
+            using X = typename ProtoRepeated<M>::Element;
+            static_assert(!ProtoRepeated<X>::value && !ProtoMap<X>::value,
+                          "protobuf has no nested repeated fields; wrap the inner container in a struct");
+            return "repeated " + scalar<X, E>();
+        }
+        else if constexpr (ProtoMap<M>::value)
+        {
+            using K = typename MapOf<M>::Key;
+            static_assert(IntegerType<K> || std::is_same_v<K, bool> || std::is_same_v<K, std::string>,
+                          "protobuf map keys are integers, bool or string");
+            return "map<" + scalar<K, ProtoEncoding::Default>() + ", " + scalar<typename MapOf<M>::Value, E>() + ">";
+        }
+        else
+            return scalar<M, E>();
+    }
+
+    template <typename T>
+    constexpr std::string enumeration(const std::string& name)
+    {
+        std::string prefix = upperSnake(name) + "_";
+        auto entries = enumEntries<T>();
+        std::string zero;
+        std::string rest;
+        bool alias = false;
+        for (size_t i = 0; i < entries.size(); ++i)
+        {
+            for (size_t j = 0; j < i; ++j)
+                alias = alias || entries[j].first == entries[i].first;
+            std::string line = "  " + prefix + upperSnake(entries[i].second) + " = " + integerText(entries[i].first) + ";\n";
+            if (entries[i].first == 0 && zero.empty())
+                zero = line;
+            else
+                rest += line;
+        }
+        if (zero.empty())
+            zero = "  " + prefix + "UNSPECIFIED = 0;\n";
+        return "enum " + name + " {\n" + (alias ? "  option allow_alias = true;\n" : "") + zero + rest + "}\n";
+    }
+
+    template <typename S>
+    constexpr std::string message(const std::string& name)
+    {
+        requireConstexprFields<S>();
+        std::string body;
+        forEachField<S>([&](const auto& field, auto index)
+        {
+            using F = std::decay_t<decltype(field)>;
+            constexpr uint32_t number = F::getProtoField(decltype(index)::value + 1);
+            body += "  " + fieldType<typename F::MemberType, F::getProtoEncoding()>() + " " +
+                    identifier(field.fieldName) + " = " + integerText(number) + ";\n";
+        });
+        return "message " + name + " {\n" + body + "}\n";
+    }
+};
+
+template <typename T>
+struct ProtoSchemaGen
+{
+    static_assert(HasFields<T>, "protoSchema<T>() needs a struct with FieldsMeta");
+
+    static constexpr std::string build()
+    {
+        SchemaText s;
+        ProtoWriter{s}.scalar<T, ProtoEncoding::Default>();
+        return "syntax = \"proto3\";\n\n" + s.joined("\n");
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Binary codecs
+// ----------------------------------------------------------------------------
+
+template <typename T>
+constexpr void requireBinaryEncoding()
+{
+    static_assert(std::is_same_v<T, bool> || IntegerType<T> || FloatingPointType<T> || TextType<T> || BlobType<T> ||
+                      RegisteredEnum<T> || HasFields<T> || is_optional_v<T> || SequenceOf<T>::value ||
+                      MapOf<T>::value || ElementsOf<T>::value || VariantOf<T>::value,
+                  "type has no binary encoding");
+}
+
+// Wire type of a struct field, as in binaryFieldWireOf
+template <typename M>
+constexpr uint64_t fieldKey(uint32_t tag)
+{
+    return (static_cast<uint64_t>(tag) << 2) | static_cast<uint64_t>(binaryFieldWireOf<M>());
+}
+
+template <typename T>
+constexpr const char* pythonFormat()
+{
+    if constexpr (RegisteredEnum<T>)
+        return pythonFormat<std::underlying_type_t<T>>();
+    else if constexpr (std::is_same_v<T, bool>)
+        return "?";
+    else if constexpr (std::is_same_v<T, float>)
+        return "f";
+    else if constexpr (std::is_same_v<T, double>)
+        return "d";
+    else if constexpr (sizeof(T) == 1)
+        return std::is_signed_v<T> ? "b" : "B";
+    else if constexpr (sizeof(T) == 2)
+        return std::is_signed_v<T> ? "h" : "H";
+    else if constexpr (sizeof(T) == 4)
+        return std::is_signed_v<T> ? "i" : "I";
+    else
+    {
+        static_assert(sizeof(T) == 8, "packed field has no fixed-width equivalent");
+        return std::is_signed_v<T> ? "q" : "Q";
+    }
+}
+
+inline constexpr std::string_view pythonPrelude = R"py(from __future__ import annotations
+
+import enum
+import itertools
+import struct
+from dataclasses import dataclass, field as _field
+from typing import Dict, List, Optional, Set, Tuple, Union
+
+
+class DecodeError(ValueError):
+    pass
+
+
+_F32 = struct.Struct("<f")
+_F64 = struct.Struct("<d")
+
+
+class Reader:
+    __slots__ = ("buf", "pos")
+
+    def __init__(self, buf, pos=0):
+        self.buf = memoryview(buf).cast("B")
+        self.pos = pos
+
+    def varint(self) -> int:
+        buf, pos = self.buf, self.pos
+        result = shift = 0
+        while True:
+            if pos >= len(buf):
+                raise DecodeError("Truncated binary data")
+            b = buf[pos]
+            pos += 1
+            result |= (b & 0x7F) << shift
+            if b < 0x80:
+                break
+            shift += 7
+            if shift > 63:
+                raise DecodeError("Malformed varint")
+        self.pos = pos
+        return result
+
+    def sint(self) -> int:
+        v = self.varint()
+        return (v >> 1) ^ -(v & 1)
+
+    def boolean(self) -> bool:
+        v = self.varint()
+        if v > 1:
+            raise DecodeError("Invalid bool")
+        return v == 1
+
+    def _fixed(self, layout):
+        if self.pos + layout.size > len(self.buf):
+            raise DecodeError("Truncated binary data")
+        (v,) = layout.unpack_from(self.buf, self.pos)
+        self.pos += layout.size
+        return v
+
+    def f32(self) -> float:
+        return self._fixed(_F32)
+
+    def f64(self) -> float:
+        return self._fixed(_F64)
+
+    # Reads a length prefix; returns where the value ends
+    def enter(self) -> int:
+        size = self.varint()
+        end = self.pos + size
+        if end > len(self.buf):
+            raise DecodeError("Truncated binary data")
+        return end
+
+    # Moves past the value ending at end, skipping what it didn't read
+    def leave(self, end: int) -> None:
+        if self.pos > end:
+            raise DecodeError("Value overruns its length")
+        self.pos = end
+
+    def blob(self) -> bytes:
+        end = self.enter()
+        out = self.buf[self.pos:end].tobytes()
+        self.pos = end
+        return out
+
+    def string(self) -> str:
+        end = self.enter()
+        out = str(self.buf[self.pos:end], "utf-8")
+        self.pos = end
+        return out
+
+    def seq(self, item) -> list:
+        end = self.enter()
+        out = [item(self) for _ in range(self.varint())]
+        self.leave(end)
+        return out
+
+    def map(self, key, value) -> dict:
+        end = self.enter()
+        out = {}
+        for _ in range(self.varint()):
+            k = key(self)
+            out[k] = value(self)
+        self.leave(end)
+        return out
+
+    def opt(self, item):
+        end = self.enter()
+        out = item(self) if self.boolean() else None
+        self.leave(end)
+        return out
+
+    def tuple(self, items) -> tuple:
+        end = self.enter()
+        out = tuple(item(self) for item in items)
+        self.leave(end)
+        return out
+
+    # (alternative index, value)
+    def variant(self, items) -> tuple:
+        end = self.enter()
+        index = self.varint()
+        if index >= len(items):
+            raise DecodeError("Unknown variant alternative")
+        out = (index, items[index](self))
+        self.leave(end)
+        return out
+
+    # One packed struct: its fields as a tuple
+    def record(self, layout) -> tuple:
+        end = self.enter()
+        if end - self.pos != layout.size:
+            raise DecodeError("Packed struct size mismatch")
+        out = layout.unpack_from(self.buf, self.pos)
+        self.pos = end
+        return out
+
+    # A sequence of packed structs, read as one block
+    def records(self, layout, make) -> list:
+        end = self.enter()
+        count = self.varint()
+        if self.pos + count * layout.size != end:
+            raise DecodeError("Packed sequence size mismatch")
+        out = list(itertools.starmap(make, layout.iter_unpack(self.buf[self.pos:end])))
+        self.pos = end
+        return out
+
+    def skip(self, wire: int) -> None:
+        if wire == 0:
+            self.varint()
+        elif wire == 2:
+            self.pos = self.enter()
+        else:
+            self.pos += 8 if wire == 1 else 4
+            if self.pos > len(self.buf):
+                raise DecodeError("Truncated binary data")
+)py";
+
+struct PythonWriter
+{
+    SchemaText& s;
+
+    // An expression for a function that reads a T from a Reader
+    template <typename T>
+    constexpr std::string reader()
+    {
+        requireBinaryEncoding<T>();
+        if constexpr (std::is_same_v<T, bool>)
+            return "Reader.boolean";
+        else if constexpr (IntegerType<T>)
+            return std::is_signed_v<T> ? "Reader.sint" : "Reader.varint";
+        else if constexpr (std::is_same_v<T, float>)
+            return "Reader.f32";
+        else if constexpr (FloatingPointType<T>)
+            return "Reader.f64";
+        else if constexpr (TextType<T>)
+            return "Reader.string";
+        else if constexpr (BlobType<T>)
+            return "Reader.blob";
+        else if constexpr (RegisteredEnum<T> || HasFields<T>)
+            return define<T>() + ".decode";
+        else
+            return "lambda r: " + read<T>();
+    }
+
+    // An expression reading a T from the Reader r
+    template <typename T>
+    constexpr std::string read()
+    {
+        if constexpr (is_optional_v<T>)
+            return "r.opt(" + reader<typename T::value_type>() + ")";
+        else if constexpr (PackedSequence<T>::value)
+        {
+            std::string name = define<typename SequenceOf<T>::Element>();
+            return std::string(SequenceOf<T>::unique ? "set(" : "") + "r.records(" + name + "._LAYOUT, " + name +
+                   "._row)" + (SequenceOf<T>::unique ? ")" : "");
+        }
+        else if constexpr (SequenceOf<T>::value)
+            return std::string(SequenceOf<T>::unique ? "set(" : "") + "r.seq(" +
+                   reader<typename SequenceOf<T>::Element>() + ")" + (SequenceOf<T>::unique ? ")" : "");
+        else if constexpr (MapOf<T>::value)
+            return "r.map(" + reader<typename MapOf<T>::Key>() + ", " + reader<typename MapOf<T>::Value>() + ")";
+        else if constexpr (ElementsOf<T>::value || VariantOf<T>::value)
+        {
+            std::string items;
+            std::conditional_t<ElementsOf<T>::value, ElementsOf<T>, VariantOf<T>>::each(
+                [&](auto id, size_t i) { items += (i ? ", " : "") + reader<typename decltype(id)::type>(); });
+            return std::string(ElementsOf<T>::value ? "r.tuple((" : "r.variant((") + items + ",))";
+        }
+        else
+        {
+            std::string fn = reader<T>();
+            if (fn.starts_with("Reader."))
+                return "r." + fn.substr(7) + "()";
+            return fn + "(r)";
+        }
+    }
+
+    template <typename T>
+    constexpr std::string annotation()
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return "bool";
+        else if constexpr (IntegerType<T>)
+            return "int";
+        else if constexpr (FloatingPointType<T>)
+            return "float";
+        else if constexpr (TextType<T>)
+            return "str";
+        else if constexpr (BlobType<T>)
+            return "bytes";
+        else if constexpr (RegisteredEnum<T> || HasFields<T>)
+            return define<T>();
+        else if constexpr (is_optional_v<T>)
+            return "Optional[" + annotation<typename T::value_type>() + "]";
+        else if constexpr (SequenceOf<T>::value)
+            return (SequenceOf<T>::unique ? "Set[" : "List[") + annotation<typename SequenceOf<T>::Element>() + "]";
+        else if constexpr (MapOf<T>::value)
+            return "Dict[" + annotation<typename MapOf<T>::Key>() + ", " + annotation<typename MapOf<T>::Value>() + "]";
+        else if constexpr (ElementsOf<T>::value)
+        {
+            std::string items;
+            ElementsOf<T>::each([&](auto id, size_t i) { items += (i ? ", " : "") + annotation<typename decltype(id)::type>(); });
+            return "Tuple[" + items + "]";
+        }
+        else
+        {
+            std::string items;
+            VariantOf<T>::each([&](auto id, size_t i) { items += (i ? ", " : "") + annotation<typename decltype(id)::type>(); });
+            return "Tuple[int, Union[" + items + "]]";
+        }
+    }
+
+    template <typename T>
+    constexpr std::string defaultValue()
+    {
+        if constexpr (std::is_same_v<T, bool>)
+            return "False";
+        else if constexpr (IntegerType<T>)
+            return "0";
+        else if constexpr (FloatingPointType<T>)
+            return "0.0";
+        else if constexpr (TextType<T>)
+            return "\"\"";
+        else if constexpr (BlobType<T>)
+            return "b\"\"";
+        else if constexpr (RegisteredEnum<T>)
+        {
+            auto entries = enumEntries<T>();
+            if (entries.empty())
+                return "0";
+            return define<T>() + "." + identifier(entries[0].second);
+        }
+        else if constexpr (HasFields<T>)
+            return "_field(default_factory=" + define<T>() + ")";
+        else if constexpr (SequenceOf<T>::value)
+            return SequenceOf<T>::unique ? "_field(default_factory=set)" : "_field(default_factory=list)";
+        else if constexpr (MapOf<T>::value)
+            return "_field(default_factory=dict)";
+        else
+            return "None";
+    }
+
+    template <typename T>
+    constexpr std::string define()
+    {
+        std::string name = s.nameOf<T>();
+        if (s.claim<T>())
+            s.definitions.push_back(definition<T>(name));
+        return name;
+    }
+
+    template <typename T>
+    constexpr std::string definition(const std::string& name)
+    {
+        if constexpr (RegisteredEnum<T>)
+        {
+            std::string out = "class " + name + "(enum.IntEnum):\n";
+            for (auto [value, valueName] : enumEntries<T>())
+                out += "    " + identifier(valueName) + " = " + integerText(value) + "\n";
+            return out + "\n    @staticmethod\n    def decode(r: Reader) -> " + name + ":\n        return " + name +
+                   "(r.sint())\n";
+        }
+        else
+        {
+            requireConstexprFields<T>();
+            std::string declarations;
+            std::string cases;
+            std::string format = "<";
+            std::string params;
+            std::string arguments;
+            forEachField<T>([&](const auto& field, auto index)
+            {
+                using M = typename std::decay_t<decltype(field)>::MemberType;
+                std::string member = identifier(field.fieldName);
+                std::string type = annotation<M>();
+                declarations += "    " + member + ": " + type + " = " + defaultValue<M>() + "\n";
+                if constexpr (PackedBinary<T>)
+                {
+                    format += pythonFormat<M>();
+                    params += (params.empty() ? "" : ", ") + member;
+                    std::string argument = member;
+                    if constexpr (RegisteredEnum<M>)
+                        argument = type + "(" + member + ")";
+                    arguments += (arguments.empty() ? "" : ", ") + argument;
+                }
+                else
+                {
+                    using Value = typename Unwrapped<M>::type;
+                    std::string key = integerText(fieldKey<M>(BinaryFields<T>::tags[decltype(index)::value]));
+                    cases += std::string(cases.empty() ? "            if" : "            elif") + " key == " + key +
+                             ":\n                obj." + member + " = " + read<Value>() + "\n";
+                }
+            });
+            std::string out = "@dataclass\nclass " + name + ":\n" + declarations;
+            if constexpr (PackedBinary<T>)
+                return out + "\n    _LAYOUT = struct.Struct(\"" + format + "\")\n\n    @staticmethod\n    def _row(" +
+                       params + ") -> " + name + ":\n        return " + name + "(" + arguments +
+                       ")\n\n    @staticmethod\n    def decode(r: Reader) -> " + name + ":\n        return " + name +
+                       "._row(*r.record(" + name + "._LAYOUT))\n";
+            else
+                return out + "\n    @staticmethod\n    def decode(r: Reader) -> " + name +
+                       ":\n        end = r.enter()\n        obj = " + name +
+                       "()\n        while r.pos < end:\n            key = r.varint()\n" + cases +
+                       (cases.empty() ? "            r.skip(key & 3)\n" : "            else:\n                r.skip(key & 3)\n") +
+                       "        r.leave(end)\n        return obj\n";
+        }
+    }
+};
+
+template <typename T>
+struct PythonCodecGen
+{
+    static constexpr std::string build()
+    {
+        SchemaText s;
+        PythonWriter writer{s};
+        std::string read = writer.read<T>();
+        std::string type = writer.annotation<T>();
+        return "# Reads meta binary documents (toBinary) holding a " + type + "\n" + std::string(pythonPrelude) + "\n\nFINGERPRINT = " + hexText(binarySchemaHash<T>()) + "\n\n\n" +
+               s.joined("\n\n") + (s.definitions.empty() ? "" : "\n\n") +
+               "def from_binary(data, require_same_schema: bool = False) -> " + type +
+               ":\n    r = Reader(data)\n    if len(r.buf) < 11 or r.buf[:3].tobytes() != b\"MB\\x01\":\n"
+               "        raise DecodeError(\"Not a meta binary document\")\n"
+               "    if require_same_schema and int.from_bytes(r.buf[3:11], \"little\") != FINGERPRINT:\n"
+               "        raise DecodeError(\"Schema fingerprint mismatch\")\n    r.pos = 11\n    value = " +
+               read + "\n    if r.pos != len(r.buf):\n        raise DecodeError(\"Unexpected data after the value\")\n"
+               "    return value\n";
+    }
+};
+
+inline constexpr std::string_view rustPrelude = R"rs(#![allow(dead_code, non_camel_case_types, non_snake_case, clippy::all)]
+
+use std::collections::{BTreeMap, BTreeSet, HashMap};
+
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub enum DecodeError {
+    NotMetaBinary,
+    SchemaMismatch,
+    Truncated,
+    Invalid(&'static str),
+}
+
+pub struct Reader<'a> {
+    buf: &'a [u8],
+    pub pos: usize,
+}
+
+impl<'a> Reader<'a> {
+    pub fn new(buf: &'a [u8], pos: usize) -> Self {
+        Reader { buf, pos }
+    }
+
+    #[inline]
+    pub fn varint(&mut self) -> Result<u64, DecodeError> {
+        let mut result = 0u64;
+        let mut shift = 0u32;
+        loop {
+            let b = *self.buf.get(self.pos).ok_or(DecodeError::Truncated)?;
+            self.pos += 1;
+            result |= u64::from(b & 0x7f) << shift;
+            if b < 0x80 {
+                return Ok(result);
+            }
+            shift += 7;
+            if shift > 63 {
+                return Err(DecodeError::Invalid("malformed varint"));
+            }
+        }
+    }
+
+    #[inline]
+    pub fn sint(&mut self) -> Result<i64, DecodeError> {
+        let v = self.varint()?;
+        Ok((v >> 1) as i64 ^ -((v & 1) as i64))
+    }
+
+    #[inline]
+    pub fn fixed<const N: usize>(&mut self) -> Result<[u8; N], DecodeError> {
+        let bytes = self.buf.get(self.pos..self.pos + N).ok_or(DecodeError::Truncated)?;
+        self.pos += N;
+        Ok(bytes.try_into().unwrap())
+    }
+
+    /// Reads a length prefix; returns where the value ends
+    #[inline]
+    pub fn enter(&mut self) -> Result<usize, DecodeError> {
+        let len = usize::try_from(self.varint()?).map_err(|_| DecodeError::Truncated)?;
+        match self.pos.checked_add(len) {
+            Some(end) if end <= self.buf.len() => Ok(end),
+            _ => Err(DecodeError::Truncated),
+        }
+    }
+
+    /// Moves past the value ending at end, skipping what it didn't read
+    #[inline]
+    pub fn leave(&mut self, end: usize) -> Result<(), DecodeError> {
+        if self.pos > end {
+            return Err(DecodeError::Invalid("value overruns its length"));
+        }
+        self.pos = end;
+        Ok(())
+    }
+
+    pub fn bytes(&mut self) -> Result<&'a [u8], DecodeError> {
+        let end = self.enter()?;
+        let out = &self.buf[self.pos..end];
+        self.pos = end;
+        Ok(out)
+    }
+
+    pub fn skip(&mut self, wire: u64) -> Result<(), DecodeError> {
+        match wire {
+            0 => drop(self.varint()?),
+            1 => drop(self.fixed::<8>()?),
+            2 => self.pos = self.enter()?,
+            _ => drop(self.fixed::<4>()?),
+        }
+        Ok(())
+    }
+}
+
+pub trait Decode: Sized {
+    fn decode(r: &mut Reader) -> Result<Self, DecodeError>;
+
+    /// A sequence of Self: its count, then the elements
+    fn decode_seq(r: &mut Reader) -> Result<Vec<Self>, DecodeError> {
+        let end = r.enter()?;
+        let count = r.varint()? as usize;
+        let mut out = Vec::with_capacity(count.min(end - r.pos));
+        for _ in 0..count {
+            out.push(Self::decode(r)?);
+        }
+        r.leave(end)?;
+        Ok(out)
+    }
+}
+
+macro_rules! decode_integers {
+    ($read:ident: $($t:ty),*) => {$(
+        impl Decode for $t {
+            #[inline]
+            fn decode(r: &mut Reader) -> Result<Self, DecodeError> {
+                <$t>::try_from(r.$read()?).map_err(|_| DecodeError::Invalid("integer out of range"))
+            }
+        }
+    )*};
+}
+decode_integers!(varint: u8, u16, u32, u64);
+decode_integers!(sint: i8, i16, i32, i64);
+
+impl Decode for bool {
+    fn decode(r: &mut Reader) -> Result<Self, DecodeError> {
+        match r.varint()? {
+            0 => Ok(false),
+            1 => Ok(true),
+            _ => Err(DecodeError::Invalid("invalid bool")),
+        }
+    }
+}
+
+impl Decode for f32 {
+    fn decode(r: &mut Reader) -> Result<Self, DecodeError> {
+        Ok(f32::from_le_bytes(r.fixed()?))
+    }
+}
+
+impl Decode for f64 {
+    fn decode(r: &mut Reader) -> Result<Self, DecodeError> {
+        Ok(f64::from_le_bytes(r.fixed()?))
+    }
+}
+
+impl Decode for String {
+    fn decode(r: &mut Reader) -> Result<Self, DecodeError> {
+        std::str::from_utf8(r.bytes()?).map(str::to_owned).map_err(|_| DecodeError::Invalid("invalid UTF-8"))
+    }
+}
+
+/// std::span<const std::byte>
+#[derive(Debug, Clone, Default, PartialEq, Eq, Hash, PartialOrd, Ord)]
+pub struct Bytes(pub Vec<u8>);
+
+impl Decode for Bytes {
+    fn decode(r: &mut Reader) -> Result<Self, DecodeError> {
+        Ok(Bytes(r.bytes()?.to_vec()))
+    }
+}
+
+impl<T: Decode> Decode for Vec<T> {
+    fn decode(r: &mut Reader) -> Result<Self, DecodeError> {
+        T::decode_seq(r)
+    }
+}
+
+impl<T: Decode + Ord> Decode for BTreeSet<T> {
+    fn decode(r: &mut Reader) -> Result<Self, DecodeError> {
+        Ok(T::decode_seq(r)?.into_iter().collect())
+    }
+}
+
+impl<T: Decode> Decode for Option<T> {
+    fn decode(r: &mut Reader) -> Result<Self, DecodeError> {
+        let end = r.enter()?;
+        let out = if bool::decode(r)? { Some(T::decode(r)?) } else { None };
+        r.leave(end)?;
+        Ok(out)
+    }
+}
+
+macro_rules! decode_maps {
+    ($($map:ident: $($bound:path),*);*) => {$(
+        impl<K: Decode $(+ $bound)*, V: Decode> Decode for $map<K, V> {
+            fn decode(r: &mut Reader) -> Result<Self, DecodeError> {
+                let end = r.enter()?;
+                let count = r.varint()?;
+                let mut out = $map::new();
+                for _ in 0..count {
+                    let k = K::decode(r)?;
+                    out.insert(k, V::decode(r)?);
+                }
+                r.leave(end)?;
+                Ok(out)
+            }
+        }
+    )*};
+}
+decode_maps!(BTreeMap: Ord; HashMap: Eq, std::hash::Hash);
+
+macro_rules! decode_tuples {
+    ($(($($t:ident),+))*) => {$(
+        impl<$($t: Decode),+> Decode for ($($t,)+) {
+            fn decode(r: &mut Reader) -> Result<Self, DecodeError> {
+                let end = r.enter()?;
+                let out = ($($t::decode(r)?,)+);
+                r.leave(end)?;
+                Ok(out)
+            }
+        }
+    )*};
+}
+decode_tuples!((A) (A, B) (A, B, C) (A, B, C, D) (A, B, C, D, E) (A, B, C, D, E, F) (A, B, C, D, E, F, G) (A, B, C, D, E, F, G, H));
+)rs";
+
+struct RustWriter
+{
+    SchemaText& s;
+
+    template <typename T>
+    static constexpr std::string integer()
+    {
+        return (std::is_signed_v<T> ? "i" : "u") + integerText(sizeof(T) * 8);
+    }
+
+    template <typename T>
+    constexpr std::string type()
+    {
+        requireBinaryEncoding<T>();
+        if constexpr (std::is_same_v<T, bool>)
+            return "bool";
+        else if constexpr (IntegerType<T>)
+            return integer<T>();
+        else if constexpr (std::is_same_v<T, float>)
+            return "f32";
+        else if constexpr (FloatingPointType<T>)
+            return "f64";
+        else if constexpr (TextType<T>)
+            return "String";
+        else if constexpr (BlobType<T>)
+            return "Bytes";
+        else if constexpr (RegisteredEnum<T> || HasFields<T> || VariantOf<T>::value)
+            return define<T>();
+        else if constexpr (is_optional_v<T>)
+            return "Option<" + type<typename T::value_type>() + ">";
+        else if constexpr (SequenceOf<T>::value)
+            return (SequenceOf<T>::unique ? "BTreeSet<" : "Vec<") + type<typename SequenceOf<T>::Element>() + ">";
+        else if constexpr (MapOf<T>::value)
+            return (MapOf<T>::ordered ? "BTreeMap<" : "HashMap<") + type<typename MapOf<T>::Key>() + ", " +
+                   type<typename MapOf<T>::Value>() + ">";
+        else
+        {
+            std::string items;
+            ElementsOf<T>::each([&](auto id, size_t) { items += type<typename decltype(id)::type>() + ", "; });
+            return "(" + items.substr(0, items.size() - 1) + ")";
+        }
+    }
+
+    template <typename T>
+    constexpr std::string define()
+    {
+        // Variants are named by position: their type names are unreadable
+        std::string name;
+        if (VariantOf<T>::value && !s.named<T>())
+            name = s.nameOf<T>("OneOf" + integerText(++s.anonymous));
+        else
+            name = s.nameOf<T>();
+        if (s.claim<T>())
+            s.definitions.push_back(definition<T>(name));
+        return name;
+    }
+
+    template <typename T>
+    constexpr std::string definition(const std::string& name)
+    {
+        if constexpr (RegisteredEnum<T>)
+        {
+            auto entries = enumEntries<T>();
+            std::string variants;
+            std::string arms;
+            for (size_t i = 0; i < entries.size(); ++i)
+            {
+                bool alias = false;
+                for (size_t j = 0; j < i; ++j)
+                    alias = alias || entries[j].first == entries[i].first;
+                if (alias)
+                    continue;
+                std::string variant = identifier(entries[i].second);
+                variants += "    " + variant + " = " + integerText(entries[i].first) + ",\n";
+                arms += "            " + integerText(entries[i].first) + " => Ok(" + name + "::" + variant + "),\n";
+            }
+            std::string first;
+            if (!entries.empty())
+                first = identifier(entries[0].second);
+            return "#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash, PartialOrd, Ord)]\n#[repr(" +
+                   integer<std::underlying_type_t<T>>() + ")]\npub enum " + name + " {\n" + variants + "}\n\nimpl " +
+                   name + " {\n    pub fn from_value(v: i64) -> Result<Self, DecodeError> {\n        match v {\n" + arms +
+                   "            _ => Err(DecodeError::Invalid(\"unknown " + name + " value\")),\n        }\n    }\n}\n\n"
+                   "impl Default for " + name + " {\n    fn default() -> Self {\n        " + name + "::" + first +
+                   "\n    }\n}\n\nimpl Decode for " + name +
+                   " {\n    fn decode(r: &mut Reader) -> Result<Self, DecodeError> {\n        Self::from_value(r.sint()?)\n    }\n}\n";
+        }
+        else if constexpr (VariantOf<T>::value)
+        {
+            std::string variants;
+            std::string arms;
+            std::string first;
+            VariantOf<T>::each([&](auto id, size_t i)
+            {
+                std::string variant = "V" + integerText(i);
+                if constexpr (TaggedVariant<T>)
+                    variant = identifier(VariantTags<T>::names[i]);
+                if (i == 0)
+                    first = variant;
+                variants += "    " + variant + "(" + type<typename decltype(id)::type>() + "),\n";
+                arms += "            " + integerText(i) + " => " + name + "::" + variant + "(Decode::decode(r)?),\n";
+            });
+            return "#[derive(Debug, Clone, PartialEq)]\npub enum " + name + " {\n" + variants + "}\n\nimpl Default for " +
+                   name + " {\n    fn default() -> Self {\n        " + name + "::" + first +
+                   "(Default::default())\n    }\n}\n\nimpl Decode for " + name +
+                   " {\n    fn decode(r: &mut Reader) -> Result<Self, DecodeError> {\n        let end = r.enter()?;\n"
+                   "        let out = match r.varint()? {\n" + arms +
+                   "            _ => return Err(DecodeError::Invalid(\"unknown variant alternative\")),\n        };\n"
+                   "        r.leave(end)?;\n        Ok(out)\n    }\n}\n";
+        }
+        else
+        {
+            requireConstexprFields<T>();
+            std::string members;
+            std::string arms;
+            std::string unpacked;
+            forEachField<T>([&](const auto& field, auto index)
+            {
+                using M = typename std::decay_t<decltype(field)>::MemberType;
+                std::string member = identifier(field.fieldName);
+                members += "    pub " + member + ": " + type<M>() + ",\n";
+                if constexpr (PackedBinary<T>)
+                {
+                    if constexpr (std::is_same_v<M, bool>)
+                        unpacked += "            " + member + ": match r.fixed::<1>()?[0] {\n                0 => false,\n"
+                                    "                1 => true,\n                _ => return Err(DecodeError::Invalid(\"invalid bool\")),\n"
+                                    "            },\n";
+                    else if constexpr (RegisteredEnum<M>)
+                        unpacked += "            " + member + ": " + type<M>() + "::from_value(" +
+                                    integer<std::underlying_type_t<M>>() + "::from_le_bytes(r.fixed()?) as i64)?,\n";
+                    else
+                        unpacked += "            " + member + ": " + type<M>() + "::from_le_bytes(r.fixed()?),\n";
+                }
+                else
+                {
+                    std::string key = integerText(fieldKey<M>(BinaryFields<T>::tags[decltype(index)::value]));
+                    arms += "                " + key + " => obj." + member +
+                            (is_optional_v<M> ? " = Some(Decode::decode(r)?),\n" : " = Decode::decode(r)?,\n");
+                }
+            });
+            std::string out = "#[derive(Debug, Clone, Default, PartialEq)]\npub struct " + name + " {\n" + members + "}\n\n";
+            if constexpr (PackedBinary<T>)
+                return out + "impl " + name + " {\n    pub const PACKED_SIZE: usize = " + integerText(sizeof(T)) +
+                       ";\n\n    fn unpack(r: &mut Reader) -> Result<Self, DecodeError> {\n        Ok(" + name + " {\n" +
+                       unpacked + "        })\n    }\n}\n\nimpl Decode for " + name +
+                       " {\n    fn decode(r: &mut Reader) -> Result<Self, DecodeError> {\n        let end = r.enter()?;\n"
+                       "        if end - r.pos != Self::PACKED_SIZE {\n"
+                       "            return Err(DecodeError::Invalid(\"packed struct size mismatch\"));\n        }\n"
+                       "        Self::unpack(r)\n    }\n\n"
+                       "    fn decode_seq(r: &mut Reader) -> Result<Vec<Self>, DecodeError> {\n        let end = r.enter()?;\n"
+                       "        let count = r.varint()? as usize;\n"
+                       "        if count.checked_mul(Self::PACKED_SIZE) != Some(end - r.pos) {\n"
+                       "            return Err(DecodeError::Invalid(\"packed sequence size mismatch\"));\n        }\n"
+                       "        let mut out = Vec::with_capacity(count);\n        for _ in 0..count {\n"
+                       "            out.push(Self::unpack(r)?);\n        }\n        Ok(out)\n    }\n}\n";
+            else
+                return out + "impl Decode for " + name +
+                       " {\n    fn decode(r: &mut Reader) -> Result<Self, DecodeError> {\n        let end = r.enter()?;\n"
+                       "        let mut obj = Self::default();\n        while r.pos < end {\n            let key = r.varint()?;\n"
+                       "            match key {\n" + arms + "                _ => r.skip(key & 3)?,\n            }\n        }\n"
+                       "        r.leave(end)?;\n        Ok(obj)\n    }\n}\n";
+        }
+    }
+};
+
+template <typename T>
+struct RustCodecGen
+{
+    static constexpr std::string build()
+    {
+        SchemaText s;
+        std::string type = RustWriter{s}.type<T>();
+        return "// Reads meta binary documents (toBinary) holding a " + type + "\n" + std::string(rustPrelude) +
+               "\npub const FINGERPRINT: u64 = " + hexText(binarySchemaHash<T>()) + ";\n\n" + s.joined("\n") +
+               (s.definitions.empty() ? "" : "\n") + "pub fn from_binary(data: &[u8], require_same_schema: bool) -> Result<" +
+               type + ", DecodeError> {\n    if data.len() < 11 || &data[..3] != b\"MB\\x01\" {\n"
+               "        return Err(DecodeError::NotMetaBinary);\n    }\n"
+               "    if require_same_schema && u64::from_le_bytes(data[3..11].try_into().unwrap()) != FINGERPRINT {\n"
+               "        return Err(DecodeError::SchemaMismatch);\n    }\n    let mut r = Reader::new(data, 11);\n"
+               "    let value = <" + type + " as Decode>::decode(&mut r)?;\n    if r.pos != data.len() {\n"
+               "        return Err(DecodeError::Invalid(\"unexpected data after the value\"));\n    }\n    Ok(value)\n}\n";
+    }
+};
+
+} // namespace lang_detail
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+template <typename T>
+constexpr std::string_view jsonSchema()
+{
+    return lang_detail::Baked<lang_detail::JsonSchemaGen<T>>::view();
+}
+
+template <typename T>
+constexpr std::string_view protoSchema()
+{
+    return lang_detail::Baked<lang_detail::ProtoSchemaGen<T>>::view();
+}
+
+template <typename T>
+constexpr std::string_view pythonCodec()
+{
+    return lang_detail::Baked<lang_detail::PythonCodecGen<T>>::view();
+}
+
+template <typename T>
+constexpr std::string_view rustCodec()
+{
+    return lang_detail::Baked<lang_detail::RustCodecGen<T>>::view();
+}
+
+} // namespace meta
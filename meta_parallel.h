@@ -0,0 +1,422 @@
+/*
+ * meta_parallel.h - Parallel batch serialization and deserialization for meta.h
+ *
+ * Splits a random-access range into chunks, serializes the chunks on
+ * worker threads into chunk-local buffers and writes them to the output
+ * in order, so the result is byte-for-byte the sequential one. Top-level
+ * sequences are read the same way, into a pre-sized vector.
+ * Supports:
+ * - serializeJsonParallel (same layout as serializeJson)
+ * - toCSVWithHeaderParallel, serializeParallel (CSV, see meta_csv.h)
+ * - fromParallel / fromJsonParallel for std::vector<T> roots, with errors
+ *   merged in element order under their "[i]" paths, and skipped keys
+ *   into the caller's UnknownFieldLog
+ * - Configurable thread count and chunk size
+ * - Finished chunks are written while later ones are still running
+ *
+ * Usage:
+ *   #include "meta_parallel.h"
+ *
+ *   std::string json = meta::serializeJsonParallel(rows);
+ *
+ *   meta::FdSink out(fd);
+ *   meta::serializeParallel(rows, out, ",", {.threads = 8, .chunkSize = 50000});
+ *
+ *   auto [records, result] = meta::fromJsonParallel<Record>(json);
+ *
+ * Reading in parallel needs a Node with concurrentView() (JsonNode);
+ * other documents (YAML) are read sequentially. So is anything read
+ * under an ArenaScope: the arena is the calling thread's, and a
+ * monotonic_buffer_resource can't be shared between workers.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+#include "meta.h"
+#include "meta_csv.h"
+#include "meta_json.h"
+
+namespace meta
+{
+
+struct ParallelOptions
+{
+    unsigned threads = 0;  // 0 = std::thread::hardware_concurrency()
+    size_t chunkSize = 0;  // elements per chunk, 0 = about 8 chunks per thread
+};
+
+template <typename R>
+concept ParallelRange = std::ranges::random_access_range<R> && std::ranges::sized_range<R>;
+
+struct ChunkPlan
+{
+    unsigned threads;
+    size_t chunkSize;
+    size_t chunks;
+
+    size_t begin(size_t c) const { return c * chunkSize; }
+    size_t end(size_t c, size_t n) const { return std::min(n, (c + 1) * chunkSize); }
+};
+
+inline ChunkPlan planChunks(size_t n, const ParallelOptions& options)
+{
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    size_t chunkSize = options.chunkSize ? options.chunkSize
+                                         : std::max<size_t>(1, (n + threads * 8 - 1) / (threads * 8));
+    return {threads, chunkSize, (n + chunkSize - 1) / chunkSize};
+}
+
+// Runs f(begin, end, chunkIndex) for every chunk on up to plan.threads
+// workers; the first exception stops the remaining chunks and is rethrown
+template <typename F>
+void parallelChunks(const ChunkPlan& plan, size_t n, F&& f)
+{
+    std::atomic<size_t> next{0};
+    std::mutex mutex;
+    std::exception_ptr error;
+
+    auto worker = [&]
+    {
+        for (size_t c; (c = next.fetch_add(1)) < plan.chunks;)
+        {
+            try
+            {
+                f(plan.begin(c), plan.end(c, n), c);
+            }
+            catch (...)
+            {
+                std::lock_guard lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+                next = plan.chunks;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    size_t workers = std::min<size_t>(plan.threads, plan.chunks);
+    pool.reserve(workers);
+    for (size_t i = 0; i < workers; ++i)
+        pool.emplace_back(worker);
+    for (auto& t : pool)
+        t.join();
+    if (error)
+        std::rethrow_exception(error);
+}
+
+// Calls writeChunk(sink, subrange, indexOfFirstElement) for consecutive
+// chunks of objects, on options.threads workers, and copies each chunk's
+// output to sink in order. measure(element) sizes the chunk buffers.
+template <ParallelRange R, typename Measure, typename WriteChunk>
+void forEachChunkInOrder(R& objects, OutputSink& sink, const ParallelOptions& options,
+                         Measure&& measure, WriteChunk&& writeChunk)
+{
+    size_t n = static_cast<size_t>(std::ranges::size(objects));
+    const ChunkPlan plan = planChunks(n, options);
+
+    auto chunkAt = [&](size_t c)
+    {
+        auto first = std::ranges::begin(objects);
+        return std::ranges::subrange(first + static_cast<std::ptrdiff_t>(plan.begin(c)),
+                                     first + static_cast<std::ptrdiff_t>(plan.end(c, n)));
+    };
+
+    if (plan.threads == 1 || plan.chunks <= 1)
+    {
+        for (size_t c = 0; c < plan.chunks; ++c)
+            writeChunk(sink, chunkAt(c), plan.begin(c));
+        return;
+    }
+
+    struct Slot
+    {
+        StringSink buffer{0};
+        bool ready = false;
+    };
+    std::vector<Slot> slots(plan.chunks);
+    std::atomic<size_t> next{0};
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+
+    auto worker = [&]
+    {
+        for (size_t c; (c = next.fetch_add(1)) < plan.chunks;)
+        {
+            try
+            {
+                auto chunk = chunkAt(c);
+                slots[c].buffer.reserve(estimateBatchSize(chunk, measure));
+                writeChunk(slots[c].buffer, chunk, plan.begin(c));
+            }
+            catch (...)
+            {
+                std::lock_guard lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+                next = plan.chunks;
+            }
+            {
+                std::lock_guard lock(mutex);
+                slots[c].ready = true;
+            }
+            done.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(std::min<size_t>(plan.threads, plan.chunks));
+    for (size_t i = 0; i < std::min<size_t>(plan.threads, plan.chunks); ++i)
+        pool.emplace_back(worker);
+
+    try
+    {
+        for (size_t c = 0; c < plan.chunks; ++c)
+        {
+            {
+                std::unique_lock lock(mutex);
+                done.wait(lock, [&] { return slots[c].ready || error; });
+                if (error)
+                    break;
+            }
+            sink.write(slots[c].buffer.view());
+            slots[c].buffer.take();  // release the chunk's memory
+        }
+    }
+    catch (...)
+    {
+        next = plan.chunks;
+        for (auto& t : pool)
+            t.join();
+        throw;
+    }
+
+    for (auto& t : pool)
+        t.join();
+    if (error)
+        std::rethrow_exception(error);
+}
+
+// ============================================================================
+// JSON
+// ============================================================================
+
+template <ParallelRange R>
+void serializeJsonParallel(R&& objects, OutputSink& sink, const ParallelOptions& options = {})
+{
+    sink.write("[\n");
+    forEachChunkInOrder(
+        objects, sink, options, [](const auto& obj) { return toJson(obj).size() + 4; },
+        [](OutputSink& out, auto chunk, size_t index)
+        {
+            JsonBuilder builder(out);
+            for (const auto& obj : chunk)
+            {
+                out.write(index++ == 0 ? "  " : ",\n  ");
+                builder.resetSeparator();
+                to(obj, builder);
+            }
+        });
+    sink.write(std::ranges::empty(objects) ? "]\n" : "\n]\n");
+    sink.flush();
+}
+
+template <ParallelRange R>
+std::string serializeJsonParallel(R&& objects, const ParallelOptions& options = {})
+{
+    StringSink sink;
+    sink.reserve(estimateBatchSize(objects, [](const auto& obj) { return toJson(obj).size() + 4; }));
+    serializeJsonParallel(objects, sink, options);
+    return sink.take();
+}
+
+// ============================================================================
+// CSV
+// ============================================================================
+
+template <ParallelRange R>
+    requires CSVRecordRange<R>
+void toCSVWithHeaderParallel(R&& objects, OutputSink& sink, const ParallelOptions& options = {})
+{
+    sink.write(toCSVHeader<std::ranges::range_value_t<R>>());
+    sink.put('\n');
+    forEachChunkInOrder(
+        objects, sink, options, [](const auto& obj) { return toCSV(obj).size() + 1; },
+        [](OutputSink& out, auto chunk, size_t)
+        {
+            CSVBuilder builder(out);
+            for (const auto& obj : chunk)
+            {
+                to(obj, builder);
+                out.put('\n');
+            }
+        });
+    sink.flush();
+}
+
+template <ParallelRange R>
+    requires CSVRecordRange<R>
+std::string toCSVWithHeaderParallel(R&& objects, const ParallelOptions& options = {})
+{
+    StringSink sink;
+    sink.reserve(estimateBatchSize(objects, [](const auto& obj) { return toCSV(obj).size() + 1; }));
+    toCSVWithHeaderParallel(objects, sink, options);
+    return sink.take();
+}
+
+template <ParallelRange R>
+    requires CSVRecordRange<R>
+void serializeParallel(R&& objects, OutputSink& sink, const std::string& delimiter = ",",
+                       const ParallelOptions& options = {})
+{
+    if (std::ranges::empty(objects))
+        return;
+
+    writeCSVHeaderRow<std::ranges::range_value_t<R>>(sink, delimiter);
+    forEachChunkInOrder(
+        objects, sink, options, [](const auto& obj) { return toCSV(obj).size() + 1; },
+        [&](OutputSink& out, auto chunk, size_t)
+        {
+            for (const auto& obj : chunk)
+                writeCSVRow(out, obj, delimiter);
+        });
+    sink.flush();
+}
+
+template <ParallelRange R>
+    requires CSVRecordRange<R>
+std::string serializeParallel(R&& objects, const std::string& delimiter = ",", const ParallelOptions& options = {})
+{
+    StringSink sink;
+    sink.reserve(estimateBatchSize(objects, [](const auto& obj) { return toCSV(obj).size() + 1; }));
+    serializeParallel(objects, sink, delimiter, options);
+    return sink.take();
+}
+
+// ============================================================================
+// DESERIALIZATION - top-level sequences
+// ============================================================================
+
+// Same result as from(obj, node): invalid elements are left out and their
+// errors reported under "[i]", in element order. Falls back to from()
+// when node has no concurrentView(), there is only one chunk or an
+// ArenaScope is alive on the calling thread.
+template <typename T>
+ValidationResult fromParallel(std::vector<T>& obj, Node* node, const ParallelOptions& options = {})
+{
+    NodeCursor probe;
+    if (!node->isSequence() || ArenaScope::resource() || !node->concurrentView(probe))
+        return from(obj, node);
+
+    const size_t n = node->size();
+    const ChunkPlan plan = planChunks(n, options);
+    if (plan.threads == 1 || plan.chunks <= 1)
+        return from(obj, node);
+
+    obj.clear();
+    obj.resize(n);
+    std::vector<char> ok(n, 0);
+    std::vector<std::vector<std::pair<size_t, ValidationResult>>> failures(plan.chunks);
+
+    // One sequential pass positions a view at the start of every chunk, so
+    // workers don't each re-walk the sequence from element 0
+    std::vector<NodeCursor> views(plan.chunks);
+    NodeCursor child;
+    for (size_t c = 0; c < plan.chunks; ++c)
+    {
+        node->at(plan.begin(c), child);
+        node->concurrentView(views[c]);
+    }
+
+    // FailFast is per thread: workers take the caller's setting and each
+    // stops at its own first error, so the lowest failing index is known.
+    // So is UnknownFieldLog: with one alive, each chunk notes its keys in
+    // a log of its own, merged into the caller's in chunk order.
+    const bool failFast = FailFast::active();
+    UnknownFieldLog* log = UnknownFieldLog::active();
+    std::vector<std::vector<UnknownFieldLog::Entry>> noted(log ? plan.chunks : 0);
+    parallelChunks(plan, n, [&](size_t begin, size_t end, size_t c)
+    {
+        FailFast scope(failFast);
+        std::optional<UnknownFieldLog> chunkLog;
+        if (log)
+            chunkLog.emplace();
+        NodeCursor child;
+        Node* root = views[c].get();
+        for (size_t i = begin; i < end; ++i)
+        {
+            auto elemResult = from(obj[i], root->at(i, child));
+            if (elemResult.valid)
+                ok[i] = 1;
+            else
+            {
+                failures[c].emplace_back(i, std::move(elemResult));
+                if (failFast)
+                    break;
+            }
+        }
+        if (log)
+            noted[c] = chunkLog->entries();
+    });
+
+    ValidationResult result;
+    size_t last = n;
+    for (size_t c = 0; c < plan.chunks; ++c)
+    {
+        auto& chunk = failures[c];
+        for (auto& [i, elemResult] : chunk)
+            appendElementErrors(result, i, std::move(elemResult));
+        if (log)
+            log->merge(noted[c]);
+        if (failFast && !chunk.empty())
+        {
+            last = chunk.front().first;
+            break;
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < last; ++i)
+    {
+        if (!ok[i])
+            continue;
+        if (kept != i)
+            obj[kept] = std::move(obj[i]);
+        ++kept;
+    }
+    obj.erase(obj.begin() + static_cast<std::ptrdiff_t>(kept), obj.end());
+    return result;
+}
+
+// fromJson<std::vector<T>> with the elements read in parallel
+template <typename T>
+std::pair<std::optional<std::vector<T>>, ValidationResult> fromJsonParallel(std::string_view json,
+                                                                           const ParallelOptions& options = {})
+{
+    try
+    {
+        JsonDocument doc(json);
+        JsonNode root(doc, 0);
+        std::vector<T> obj;
+        auto result = fromParallel(obj, &root, options);
+        if (!result.valid)
+            return {std::nullopt, std::move(result)};
+        return {std::optional<std::vector<T>>(std::move(obj)), std::move(result)};
+    }
+    catch (const std::exception& e)
+    {
+        ValidationResult result;
+        result.addError("json", std::string(e.what()));
+        return {std::nullopt, result};
+    }
+}
+
+} // namespace meta
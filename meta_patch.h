@@ -0,0 +1,588 @@
+/*
+ * meta_patch.h - JSON Patch (RFC 6902) between two reflected objects
+ *
+ * diff(a, b) walks the FieldsMeta tables of both objects and emits only what
+ * changed, as a JSON Patch document; apply(obj, patch) replays one onto an
+ * object through the same from() overloads the readers use.
+ *
+ * Supports:
+ * - Structs field by field, down through vectors, deques, maps keyed by
+ *   strings or integers and optionals
+ * - Appended elements as "add", dropped ones as "remove" (highest index
+ *   first), new and removed map keys as "add" / "remove"
+ * - Everything else (scalars, sets, variants, tuples, structs with a Ser
+ *   hook) as a "replace" of the whole value when it differs
+ * - Field validation attributes re-checked along the patched path
+ *
+ * Usage:
+ *   #include "meta_patch.h"
+ *
+ *   std::string patch = meta::diff(before, after);   // "[]" when equal
+ *   auto result = meta::apply(replica, patch);
+ *
+ * Pointers use the names from() reads. apply() stops at the first op that
+ * fails; the ops before it stay applied, as does a value that was read but
+ * failed validation, so patch a copy when the update must be all or
+ * nothing. Only add, remove and replace are understood.
+ * Borrowed std::string_view fields set by a patch point into the patch text.
+ */
+
+#pragma once
+
+#include <charconv>
+#include <string>
+#include <string_view>
+
+#include "meta.h"
+#include "meta_json.h"
+
+namespace meta
+{
+
+// ============================================================================
+// JSON POINTERS
+// ============================================================================
+
+// Appends "/token" with '~' and '/' escaped as "~0" and "~1"
+inline void appendPointerToken(std::string& pointer, std::string_view token)
+{
+    pointer += '/';
+    for (char c : token)
+    {
+        if (c == '~')
+            pointer += "~0";
+        else if (c == '/')
+            pointer += "~1";
+        else
+            pointer += c;
+    }
+}
+
+inline void appendPointerIndex(std::string& pointer, size_t i)
+{
+    char digits[24];
+    auto r = std::to_chars(digits, digits + sizeof(digits), i);
+    pointer += '/';
+    pointer.append(digits, r.ptr);
+}
+
+// Takes the next reference token off the front of rest, unescaped into
+// token; false at the end of the pointer or on a malformed escape
+inline bool nextPointerToken(std::string_view& rest, std::string& token, ValidationResult& result)
+{
+    if (rest.empty())
+        return false;
+    if (rest.front() != '/')
+    {
+        result.addError("", "JSON Pointer must start with '/'");
+        return false;
+    }
+    size_t end = rest.find('/', 1);
+    std::string_view raw = rest.substr(1, end == std::string_view::npos ? rest.npos : end - 1);
+    rest.remove_prefix(raw.size() + 1);
+    token.clear();
+    for (size_t i = 0; i < raw.size(); ++i)
+    {
+        if (raw[i] != '~')
+            token += raw[i];
+        else if (i + 1 < raw.size() && (raw[i + 1] == '0' || raw[i + 1] == '1'))
+            token += raw[++i] == '0' ? '~' : '/';
+        else
+        {
+            result.addError("", "Invalid '~' escape in JSON Pointer");
+            return false;
+        }
+    }
+    return true;
+}
+
+// Map keys a pointer can address: written as their text, or as decimal
+template <typename K>
+concept PatchKey = StringType<K> || (std::is_integral_v<K> && !std::is_same_v<K, bool>);
+
+template <PatchKey K>
+void appendPointerKey(std::string& pointer, const K& key)
+{
+    if constexpr (StringType<K>)
+        appendPointerToken(pointer, std::string_view(key.data(), key.size()));
+    else
+        appendPointerToken(pointer, std::to_string(key));
+}
+
+template <PatchKey K, typename A>
+bool parsePointerKey(std::string_view token, K& key, const A& alloc)
+{
+    if constexpr (StringType<K>)
+    {
+        key = makeElement<K>(alloc);
+        key.assign(token.data(), token.size());
+        return true;
+    }
+    else
+    {
+        return parseIntegerKey(token, key);
+    }
+}
+
+// ============================================================================
+// DIFF
+// ============================================================================
+
+// Streams ops into one JSON array as diff() finds them
+class PatchWriter
+{
+    StringSink sink;
+    JsonBuilder json{sink};
+    size_t ops = 0;
+
+    void begin(const char* op, const std::string& path)
+    {
+        ++ops;
+        json.startMap();
+        json.key("op");
+        json.writeString(op);
+        json.key("path");
+        json.writeString(path);
+    }
+
+  public:
+    PatchWriter() { json.startSeq(); }
+
+    template <typename T>
+    void write(const char* op, const std::string& path, const T& value)
+    {
+        begin(op, path);
+        json.key("value");
+        to(value, json);
+        json.endMap();
+    }
+
+    void remove(const std::string& path)
+    {
+        begin("remove", path);
+        json.endMap();
+    }
+
+    size_t size() const { return ops; }
+
+    std::string take()
+    {
+        json.endSeq();
+        json.finish();
+        return sink.take();
+    }
+};
+
+// Scalars compare directly; any other value compares by its JSON, which
+// works for element types without operator==
+template <typename T>
+bool sameValue(const T& a, const T& b)
+{
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T> || StringType<T> ||
+                  std::is_same_v<T, std::string_view>)
+        return a == b;
+    else
+        return toJson(a) == toJson(b);
+}
+
+template <typename T> void diffValue(const T& a, const T& b, std::string& path, PatchWriter& out);
+template <typename T, typename A> void diffValue(const std::vector<T, A>& a, const std::vector<T, A>& b, std::string& path, PatchWriter& out);
+template <typename T, typename A> void diffValue(const std::deque<T, A>& a, const std::deque<T, A>& b, std::string& path, PatchWriter& out);
+template <typename K, typename V, typename C, typename A>
+void diffValue(const std::map<K, V, C, A>& a, const std::map<K, V, C, A>& b, std::string& path, PatchWriter& out);
+template <typename K, typename V, typename H, typename E, typename A>
+void diffValue(const std::unordered_map<K, V, H, E, A>& a, const std::unordered_map<K, V, H, E, A>& b, std::string& path, PatchWriter& out);
+template <typename T> void diffValue(const std::optional<T>& a, const std::optional<T>& b, std::string& path, PatchWriter& out);
+template <HasFields T> void diffValue(const T& a, const T& b, std::string& path, PatchWriter& out);
+
+template <typename T>
+void diffValue(const T& a, const T& b, std::string& path, PatchWriter& out)
+{
+    if (!sameValue(a, b))
+        out.write("replace", path, b);
+}
+
+// Common prefix element by element, then the tail added or removed
+template <typename Seq>
+void diffSequence(const Seq& a, const Seq& b, std::string& path, PatchWriter& out)
+{
+    size_t parent = path.size();
+    size_t common = std::min(a.size(), b.size());
+    for (size_t i = 0; i < common; ++i)
+    {
+        appendPointerIndex(path, i);
+        diffValue(a[i], b[i], path, out);
+        path.resize(parent);
+    }
+    for (size_t i = common; i < b.size(); ++i)
+    {
+        appendPointerIndex(path, i);
+        out.write("add", path, b[i]);
+        path.resize(parent);
+    }
+    for (size_t i = a.size(); i-- > common;)
+    {
+        appendPointerIndex(path, i);
+        out.remove(path);
+        path.resize(parent);
+    }
+}
+
+template <typename T, typename A>
+void diffValue(const std::vector<T, A>& a, const std::vector<T, A>& b, std::string& path, PatchWriter& out)
+{
+    diffSequence(a, b, path, out);
+}
+
+template <typename T, typename A>
+void diffValue(const std::deque<T, A>& a, const std::deque<T, A>& b, std::string& path, PatchWriter& out)
+{
+    diffSequence(a, b, path, out);
+}
+
+// Keys only in a are removed, keys only in b added, the rest diffed
+template <typename Map>
+void diffMap(const Map& a, const Map& b, std::string& path, PatchWriter& out)
+{
+    if constexpr (!PatchKey<typename Map::key_type>)
+        diffValue<Map>(a, b, path, out);
+    else
+    {
+        size_t parent = path.size();
+        for (const auto& [k, v] : a)
+        {
+            appendPointerKey(path, k);
+            if (auto it = b.find(k); it == b.end())
+                out.remove(path);
+            else
+                diffValue(v, it->second, path, out);
+            path.resize(parent);
+        }
+        for (const auto& [k, v] : b)
+        {
+            if (a.find(k) != a.end())
+                continue;
+            appendPointerKey(path, k);
+            out.write("add", path, v);
+            path.resize(parent);
+        }
+    }
+}
+
+template <typename K, typename V, typename C, typename A>
+void diffValue(const std::map<K, V, C, A>& a, const std::map<K, V, C, A>& b, std::string& path, PatchWriter& out)
+{
+    diffMap(a, b, path, out);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+void diffValue(const std::unordered_map<K, V, H, E, A>& a, const std::unordered_map<K, V, H, E, A>& b,
+               std::string& path, PatchWriter& out)
+{
+    diffMap(a, b, path, out);
+}
+
+// Optionals are written as null when empty, so the field is replaced
+template <typename T>
+void diffValue(const std::optional<T>& a, const std::optional<T>& b, std::string& path, PatchWriter& out)
+{
+    if (a && b)
+        diffValue(*a, *b, path, out);
+    else if (a || b)
+        out.write("replace", path, b);
+}
+
+template <HasFields T>
+void diffValue(const T& a, const T& b, std::string& path, PatchWriter& out)
+{
+    if constexpr (requires { typename T::Ser; })
+    {
+        if (!sameValue(a, b))
+            out.write("replace", path, b);
+    }
+    else
+    {
+        size_t parent = path.size();
+        std::apply(
+            [&](auto&&... fields)
+            {
+                (..., [&](auto& field)
+                 {
+                     appendPointerToken(path, field.getJsonProperty());
+                     diffValue(a.*(field.memberPtr), b.*(field.memberPtr), path, out);
+                     path.resize(parent);
+                 }(fields));
+            },
+            get_fields<T>());
+    }
+}
+
+// ============================================================================
+// APPLY
+// ============================================================================
+
+enum class PatchOp
+{
+    Add,
+    Remove,
+    Replace
+};
+
+// One op being applied: what it does, its value, and the part of its
+// pointer not walked yet
+struct PatchStep
+{
+    PatchOp op;
+    Node* value;
+    std::string_view rest;
+    std::string token;
+};
+
+template <typename T> ValidationResult applyAt(T& obj, PatchStep& step);
+template <typename T, typename A> ValidationResult applyAt(std::vector<T, A>& obj, PatchStep& step);
+template <typename T, typename A> ValidationResult applyAt(std::deque<T, A>& obj, PatchStep& step);
+template <typename K, typename V, typename C, typename A> ValidationResult applyAt(std::map<K, V, C, A>& obj, PatchStep& step);
+template <typename K, typename V, typename H, typename E, typename A>
+ValidationResult applyAt(std::unordered_map<K, V, H, E, A>& obj, PatchStep& step);
+template <typename T> ValidationResult applyAt(std::optional<T>& obj, PatchStep& step);
+template <HasFields T> ValidationResult applyAt(T& obj, PatchStep& step);
+
+inline ValidationResult patchError(std::string_view message)
+{
+    ValidationResult r;
+    r.addError("", message);
+    return r;
+}
+
+// The pointer ends at obj: add and replace read the op's value into it
+template <typename T>
+ValidationResult applyHere(T& obj, const PatchStep& step)
+{
+    if (step.op == PatchOp::Remove)
+        return patchError("Can't remove a required value");
+    return from(obj, step.value);
+}
+
+template <typename T>
+ValidationResult applyAt(T& obj, PatchStep& step)
+{
+    if (!step.rest.empty())
+        return patchError("Path not found");
+    return applyHere(obj, step);
+}
+
+template <typename Seq>
+ValidationResult applySequence(Seq& obj, PatchStep& step)
+{
+    ValidationResult r;
+    if (!nextPointerToken(step.rest, step.token, r))
+        return r.valid ? applyHere(obj, step) : r;
+
+    bool last = step.rest.empty();
+    size_t i = obj.size();
+    if (step.token != "-" || !last || step.op != PatchOp::Add)
+    {
+        auto [end, ec] = std::from_chars(step.token.data(), step.token.data() + step.token.size(), i);
+        if (ec != std::errc() || end != step.token.data() + step.token.size())
+            return patchError("Expected an array index");
+    }
+    bool inserting = last && step.op == PatchOp::Add;
+    if (i > obj.size() || (i == obj.size() && !inserting))
+    {
+        appendElementErrors(r, i, patchError("Index out of range"));
+        return r;
+    }
+
+    ValidationResult elem;
+    if (inserting)
+    {
+        auto value = makeElement<typename Seq::value_type>(obj.get_allocator());
+        elem = from(value, step.value);
+        if (elem.valid)
+            obj.insert(obj.begin() + static_cast<std::ptrdiff_t>(i), std::move(value));
+    }
+    else if (last && step.op == PatchOp::Remove)
+        obj.erase(obj.begin() + static_cast<std::ptrdiff_t>(i));
+    else
+        elem = applyAt(obj[i], step);
+    appendElementErrors(r, i, std::move(elem));
+    return r;
+}
+
+template <typename T, typename A>
+ValidationResult applyAt(std::vector<T, A>& obj, PatchStep& step)
+{
+    return applySequence(obj, step);
+}
+
+template <typename T, typename A>
+ValidationResult applyAt(std::deque<T, A>& obj, PatchStep& step)
+{
+    return applySequence(obj, step);
+}
+
+template <typename Map>
+ValidationResult applyMap(Map& obj, PatchStep& step)
+{
+    using K = typename Map::key_type;
+    if constexpr (!PatchKey<K>)
+        return applyAt<Map>(obj, step);
+    else
+    {
+        ValidationResult r;
+        if (!nextPointerToken(step.rest, step.token, r))
+            return r.valid ? applyHere(obj, step) : r;
+
+        K key{};
+        std::string name = step.token;
+        if (!parsePointerKey(name, key, obj.get_allocator()))
+            return patchError("Expected an integer key");
+        bool last = step.rest.empty();
+        auto it = obj.find(key);
+        ValidationResult value;
+        if (last && step.op == PatchOp::Add)
+        {
+            if (it == obj.end())
+                it = obj.emplace(std::move(key), makeElement<typename Map::mapped_type>(obj.get_allocator())).first;
+            value = from(it->second, step.value);
+        }
+        else if (it == obj.end())
+            value = patchError("Path not found");
+        else if (last && step.op == PatchOp::Remove)
+            obj.erase(it);
+        else
+            value = applyAt(it->second, step);
+        r.addErrorsUnder(name, std::move(value));
+        return r;
+    }
+}
+
+template <typename K, typename V, typename C, typename A>
+ValidationResult applyAt(std::map<K, V, C, A>& obj, PatchStep& step)
+{
+    return applyMap(obj, step);
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+ValidationResult applyAt(std::unordered_map<K, V, H, E, A>& obj, PatchStep& step)
+{
+    return applyMap(obj, step);
+}
+
+// Removing an optional field empties it
+template <typename T>
+ValidationResult applyAt(std::optional<T>& obj, PatchStep& step)
+{
+    if (step.rest.empty())
+    {
+        if (step.op == PatchOp::Remove)
+        {
+            obj.reset();
+            return {};
+        }
+        return from(obj, step.value);
+    }
+    if (!obj)
+        return patchError("Path not found");
+    return applyAt(*obj, step);
+}
+
+template <HasFields T>
+ValidationResult applyAt(T& obj, PatchStep& step)
+{
+    ValidationResult r;
+    if (!nextPointerToken(step.rest, step.token, r))
+        return r.valid ? applyHere(obj, step) : r;
+
+    bool found = false;
+    std::apply(
+        [&](auto&&... fields)
+        {
+            (..., [&](auto& field)
+             {
+                 if (found || step.token != field.getJsonProperty())
+                     return;
+                 found = true;
+                 r.addErrorsUnder(field.getJsonProperty(), applyAt(obj.*(field.memberPtr), step));
+                 if (r.valid)
+                     validateFieldAttributes(obj, field, r);
+             }(fields));
+        },
+        get_fields<T>());
+    if (!found)
+        r.addError(step.token, "Path not found");
+    return r;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+// The JSON Patch that turns a into b; "[]" when nothing differs
+template <typename T>
+std::string diff(const T& a, const T& b)
+{
+    PatchWriter out;
+    std::string path;
+    diffValue(a, b, path, out);
+    return out.take();
+}
+
+// Applies a JSON Patch to obj, op by op. Errors are reported at the path
+// the op targets (e.g. "services.[0].replicas").
+template <typename T>
+ValidationResult apply(T& obj, std::string_view patch)
+{
+    ValidationResult result;
+    try
+    {
+        JsonDocument doc(patch);
+        JsonNode root(doc, 0);
+        if (!root.isSequence())
+        {
+            result.addError("patch", "Expected a JSON Patch array");
+            return result;
+        }
+
+        NodeCursor opCursor, fieldCursor, valueCursor;
+        std::string scratch;
+        for (size_t i = 0; i < root.size(); ++i)
+        {
+            Node* opNode = root.at(i, opCursor);
+            Node* name = opNode->isMap() ? opNode->at("op", fieldCursor) : nullptr;
+            std::optional<std::string_view> op = name ? name->asStringView(scratch) : std::nullopt;
+            PatchStep step{};
+            if (op == "add")
+                step.op = PatchOp::Add;
+            else if (op == "remove")
+                step.op = PatchOp::Remove;
+            else if (op == "replace")
+                step.op = PatchOp::Replace;
+            else
+            {
+                result.addError("patch", op ? "Unsupported patch op: " + std::string(*op) : "Expected an op");
+                return result;
+            }
+
+            Node* pathNode = opNode->at("path", fieldCursor);
+            auto path = pathNode ? pathNode->asString() : std::nullopt;
+            step.value = opNode->at("value", valueCursor);
+            if (!path || (step.op != PatchOp::Remove && !step.value))
+            {
+                result.addError("patch", "Patch op needs a path and, unless it removes, a value");
+                return result;
+            }
+            step.rest = *path;
+            result = applyAt(obj, step);
+            if (!result.valid)
+                return result;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        result.addError("patch", std::string(e.what()));
+    }
+    return result;
+}
+
+} // namespace meta
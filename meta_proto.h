@@ -0,0 +1,852 @@
+/*
+ * meta_proto.h - Protobuf wire format for meta.h
+ *
+ * Writes and reads the protobuf binary wire format (proto3 rules) straight
+ * from structs with FieldsMeta, so they can be exchanged with protoc
+ * generated code and gRPC services without generated message classes.
+ *
+ * Supports:
+ * - Field numbers from meta::ProtoField<N> (default: declaration position)
+ * - int32/int64/uint32/uint64; sint32/sint64 and (s)fixed32/64 through
+ *   ProtoField<N, meta::ProtoEncoding::ZigZag> / <N, ...::Fixed>
+ * - bool, float, double, std::string, registered enums, nested messages
+ * - std::optional fields (proto3 `optional`, always written when set)
+ * - Repeated fields from std::vector / std::deque / std::set; scalars are
+ *   written packed, and both packed and unpacked input is accepted
+ * - std::map / std::unordered_map as protobuf map fields
+ * - Length prefixes computed before writing: fixed-size parts fold to
+ *   compile-time constants, messages whose size is bounded at compile
+ *   time below 128 bytes are never measured, and the others are measured
+ *   once each, nested ones included, just before they are written
+ *
+ * Usage:
+ *   // message Point { int32 x = 1; sint32 y = 2; repeated double w = 3; }
+ *   struct Point {
+ *       int32_t x;
+ *       int32_t y;
+ *       std::vector<double> w;
+ *       static constexpr auto FieldsMeta = std::make_tuple(
+ *           meta::field<&Point::x>("x", meta::ProtoField<1>{}),
+ *           meta::field<&Point::y>("y", meta::ProtoField<2, meta::ProtoEncoding::ZigZag>{}),
+ *           meta::field<&Point::w>("w", meta::ProtoField<3>{}));
+ *   };
+ *
+ *   std::string bytes = meta::toProto(point);
+ *   auto [copy, result] = meta::fromProto<Point>(bytes);
+ *
+ * As in proto3, non-optional scalars, strings and repeated fields holding
+ * their default value are not written, and fields missing from the input
+ * keep their defaults (there are no "Missing required field" errors).
+ * Enums are open: numbers missing from the EnumMapping are read into the
+ * enum as they are, so newer values survive a round trip.
+ * Validation attributes run on every decoded message. Unknown fields are
+ * skipped, or handled by the message's meta::UnknownFieldPolicy. Ser/Deser
+ * hooks are not consulted.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "meta.h"
+#include "meta_binary.h"
+
+namespace meta
+{
+
+// ============================================================================
+// WIRE FORMAT
+// ============================================================================
+
+enum class ProtoWire : uint8_t
+{
+    Varint = 0,
+    I64 = 1,
+    Len = 2,
+    I32 = 5
+};
+
+template <uint32_t N, ProtoWire W>
+inline constexpr uint64_t protoKey = (uint64_t(N) << 3) | uint64_t(W);
+
+template <typename T>
+concept ProtoScalar = std::is_same_v<T, bool> || IntegerType<T> || FloatingPointType<T> || RegisteredEnum<T>;
+
+template <typename T> struct ProtoRepeated : std::false_type {};
+template <typename T> struct ProtoRepeated<std::vector<T>> : std::true_type { using Element = T; };
+template <typename T> struct ProtoRepeated<std::deque<T>> : std::true_type { using Element = T; };
+template <typename T> struct ProtoRepeated<std::set<T>> : std::true_type { using Element = T; };
+
+template <typename T> struct ProtoMap : std::false_type {};
+template <typename K, typename V> struct ProtoMap<std::map<K, V>> : std::true_type {};
+template <typename K, typename V> struct ProtoMap<std::unordered_map<K, V>> : std::true_type {};
+
+template <typename T, ProtoEncoding E>
+constexpr ProtoWire protoScalarWire()
+{
+    if constexpr (std::is_same_v<T, float>)
+        return ProtoWire::I32;
+    else if constexpr (FloatingPointType<T>)
+        return ProtoWire::I64;
+    else if constexpr (IntegerType<T> && E == ProtoEncoding::Fixed)
+        return sizeof(T) <= 4 ? ProtoWire::I32 : ProtoWire::I64;
+    else
+        return ProtoWire::Varint;
+}
+
+// Largest encoding of a scalar, in bytes
+template <typename T, ProtoEncoding E>
+constexpr size_t protoScalarMaxSize()
+{
+    constexpr ProtoWire wire = protoScalarWire<T, E>();
+    if constexpr (wire == ProtoWire::I32)
+        return 4;
+    else if constexpr (wire == ProtoWire::I64)
+        return 8;
+    else if constexpr (std::is_same_v<T, bool>)
+        return 1;
+    else if constexpr (IntegerType<T> && sizeof(T) <= 4 && (std::is_unsigned_v<T> || E == ProtoEncoding::ZigZag))
+        return 5;
+    else
+        return 10;  // 64-bit values, and negative int32 / enums (sign-extended)
+}
+
+// ============================================================================
+// SCALARS
+// ============================================================================
+// Out is a BinaryWriter, a ProtoSizer that only adds up the bytes, or a
+// ProtoLengthWriter (below)
+
+struct ProtoSizer
+{
+    size_t size = 0;
+    // Where delimited() notes the lengths it measures, in the order the
+    // encoder reaches them; nullptr to only add up
+    std::vector<size_t>* lengths = nullptr;
+
+    void put(uint8_t) { ++size; }
+    void varint(uint64_t v) { size += varintSize(v); }
+    void fixed32(uint32_t) { size += 4; }
+    void fixed64(uint64_t) { size += 8; }
+    void bytes(const char*, size_t n) { size += n; }
+
+    // A length prefix and the payload write() puts after it
+    template <typename F>
+    void delimited(F&& write, bool note)
+    {
+        size_t slot = 0;
+        if (note && lengths)
+        {
+            slot = lengths->size();
+            lengths->push_back(0);
+        }
+        size_t start = size;
+        write();
+        size_t len = size - start;
+        size += varintSize(len);
+        if (note && lengths)
+            (*lengths)[slot] = len;
+    }
+};
+
+// A BinaryWriter that measures each outermost message it can't size from
+// the types just before writing it, noting the lengths of the messages
+// inside for when it reaches them, so each subtree is measured once
+// however deep it sits
+class ProtoLengthWriter
+{
+    BinaryWriter& w;
+    std::vector<size_t> lengths;
+    size_t next = 0;
+
+  public:
+    explicit ProtoLengthWriter(BinaryWriter& w) : w(w) {}
+
+    void put(uint8_t c) { w.put(c); }
+    void varint(uint64_t v) { w.varint(v); }
+    void fixed32(uint32_t v) { w.fixed32(v); }
+    void fixed64(uint64_t v) { w.fixed64(v); }
+    void bytes(const char* data, size_t n) { w.bytes(data, n); }
+    size_t beginDelimited() { return w.beginDelimited(); }
+    void endDelimited(size_t start) { w.endDelimited(start); }
+
+    // Lengths noted by the last measure and not yet written
+    bool noted() const { return next < lengths.size(); }
+    std::vector<size_t>& measure()
+    {
+        lengths.clear();
+        next = 0;
+        return lengths;
+    }
+    size_t nextLength() { return lengths[next++]; }
+};
+
+template <ProtoEncoding E, typename Out, ProtoScalar T>
+void writeProtoScalar(Out& out, const T& v)
+{
+    static_assert(E != ProtoEncoding::ZigZag || std::is_signed_v<T>, "ZigZag encoding is for signed integers");
+
+    if constexpr (std::is_same_v<T, bool>)
+        out.put(v ? 1 : 0);
+    else if constexpr (RegisteredEnum<T>)
+        out.varint(static_cast<uint64_t>(static_cast<int64_t>(static_cast<std::underlying_type_t<T>>(v))));
+    else if constexpr (std::is_same_v<T, float>)
+        out.fixed32(std::bit_cast<uint32_t>(v));
+    else if constexpr (FloatingPointType<T>)
+        out.fixed64(std::bit_cast<uint64_t>(static_cast<double>(v)));
+    else if constexpr (E == ProtoEncoding::Fixed && sizeof(T) <= 4)
+        out.fixed32(static_cast<uint32_t>(v));
+    else if constexpr (E == ProtoEncoding::Fixed)
+        out.fixed64(static_cast<uint64_t>(v));
+    else if constexpr (E == ProtoEncoding::ZigZag)
+        out.varint(zigzagEncode(v));
+    else if constexpr (std::is_signed_v<T>)
+        out.varint(static_cast<uint64_t>(static_cast<int64_t>(v)));
+    else
+        out.varint(v);
+}
+
+// Stores a decoded integer; 32- and 64-bit fields truncate like protobuf,
+// narrower C++ types are range checked
+template <IntegerType T, typename V>
+void assignProtoInteger(T& obj, V v, ValidationResult& result)
+{
+    if constexpr (sizeof(T) < 4)
+    {
+        if (v < static_cast<V>(std::numeric_limits<T>::min()) || v > static_cast<V>(std::numeric_limits<T>::max()))
+            return result.addError("", "Integer out of range: " + std::to_string(v));
+    }
+    obj = static_cast<T>(v);
+}
+
+template <ProtoEncoding E, ProtoScalar T>
+void readProtoScalar(BinaryReader& r, T& obj, ValidationResult& result)
+{
+    constexpr ProtoWire wire = protoScalarWire<T, E>();
+    if constexpr (wire == ProtoWire::I32)
+    {
+        uint32_t bits;
+        if (!r.fixed32(bits, result))
+            return;
+        if constexpr (std::is_same_v<T, float>)
+            obj = std::bit_cast<float>(bits);
+        else if constexpr (std::is_signed_v<T>)
+            assignProtoInteger(obj, static_cast<int32_t>(bits), result);
+        else
+            assignProtoInteger(obj, bits, result);
+    }
+    else if constexpr (wire == ProtoWire::I64)
+    {
+        uint64_t bits;
+        if (!r.fixed64(bits, result))
+            return;
+        if constexpr (FloatingPointType<T>)
+            obj = static_cast<T>(std::bit_cast<double>(bits));
+        else
+            obj = static_cast<T>(bits);
+    }
+    else
+    {
+        uint64_t raw;
+        if (!r.varint(raw, result))
+            return;
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            obj = raw != 0;
+        }
+        else if constexpr (RegisteredEnum<T>)
+        {
+            // proto3 enums are open: a number the mapping doesn't list is
+            // kept as it is, and written back unchanged
+            using U = std::underlying_type_t<T>;
+            auto number = static_cast<int32_t>(raw);
+            if (std::in_range<U>(number))
+                obj = static_cast<T>(static_cast<U>(number));
+            else
+                result.addError("", "Enum value " + std::to_string(number) + " out of range for the enum's type");
+        }
+        else if constexpr (E == ProtoEncoding::ZigZag)
+        {
+            int64_t v = zigzagDecode(raw);
+            if constexpr (sizeof(T) <= 4)
+                assignProtoInteger(obj, static_cast<int32_t>(v), result);
+            else
+                obj = static_cast<T>(v);
+        }
+        else if constexpr (std::is_signed_v<T>)
+        {
+            if constexpr (sizeof(T) <= 4)
+                assignProtoInteger(obj, static_cast<int32_t>(raw), result);
+            else
+                obj = static_cast<T>(raw);
+        }
+        else
+        {
+            if constexpr (sizeof(T) <= 4)
+                assignProtoInteger(obj, static_cast<uint32_t>(raw), result);
+            else
+                obj = static_cast<T>(raw);
+        }
+    }
+}
+
+// ============================================================================
+// FIELD NUMBERS AND SIZES
+// ============================================================================
+
+template <typename T>
+struct ProtoFields
+{
+    using Tuple = std::decay_t<decltype(get_fields<T>())>;
+    static constexpr size_t count = std::tuple_size_v<Tuple>;
+
+    template <size_t I>
+    using FieldAt = std::tuple_element_t<I, Tuple>;
+
+    template <size_t I>
+    using Member = typename FieldAt<I>::MemberType;
+
+    template <size_t I>
+    static constexpr uint32_t number = FieldAt<I>::getProtoField(I + 1);
+
+    template <size_t I>
+    static constexpr ProtoEncoding encoding = FieldAt<I>::getProtoEncoding();
+
+    static constexpr auto numbers = []<size_t... I>(std::index_sequence<I...>)
+    {
+        return std::array<uint32_t, count>{number<I>...};
+    }(std::make_index_sequence<count>{});
+
+    static constexpr bool uniqueNumbers()
+    {
+        for (size_t i = 0; i < count; ++i)
+            for (size_t j = i + 1; j < count; ++j)
+                if (numbers[i] == numbers[j])
+                    return false;
+        return true;
+    }
+    static_assert(uniqueNumbers(), "Two fields share a protobuf field number; check the ProtoField<N> attributes");
+
+    // Fields usually arrive in declaration order, so the one after the
+    // previous match is tried first
+    static int find(uint32_t n, size_t hint)
+    {
+        if (hint < count && numbers[hint] == n)
+            return static_cast<int>(hint);
+        for (size_t i = 0; i < count; ++i)
+            if (numbers[i] == n)
+                return static_cast<int>(i);
+        return -1;
+    }
+};
+
+inline constexpr size_t protoUnbounded = std::numeric_limits<size_t>::max();
+
+template <typename T> constexpr size_t protoMaxSize();
+
+template <uint32_t N, ProtoEncoding E, typename V>
+constexpr size_t protoFieldMaxSize()
+{
+    if constexpr (is_optional_v<V>)
+    {
+        return protoFieldMaxSize<N, E, typename V::value_type>();
+    }
+    else if constexpr (ProtoScalar<V>)
+    {
+        return varintSize(protoKey<N, protoScalarWire<V, E>()>) + protoScalarMaxSize<V, E>();
+    }
+    else if constexpr (HasFields<V>)
+    {
+        constexpr size_t inner = protoMaxSize<V>();
+        if constexpr (inner == protoUnbounded)
+            return protoUnbounded;
+        else
+            return varintSize(protoKey<N, ProtoWire::Len>) + varintSize(inner) + inner;
+    }
+    else
+    {
+        return protoUnbounded;
+    }
+}
+
+// Upper bound on T's encoded size, or protoUnbounded when it holds strings,
+// repeated fields or maps. Depends only on the types, so it is a constant
+// even for `inline const` field tables.
+template <typename T>
+constexpr size_t protoMaxSize()
+{
+    using Fields = ProtoFields<T>;
+    return []<size_t... I>(std::index_sequence<I...>)
+    {
+        size_t total = 0;
+        for (size_t s : {size_t(0), protoFieldMaxSize<Fields::template number<I>, Fields::template encoding<I>,
+                                                        typename Fields::template Member<I>>()...})
+        {
+            if (s == protoUnbounded)
+                return protoUnbounded;
+            total += s;
+        }
+        return total;
+    }(std::make_index_sequence<Fields::count>{});
+}
+
+// ============================================================================
+// ENCODING
+// ============================================================================
+
+template <HasFields T, typename Out> void encodeProtoMessage(const T& obj, Out& out);
+
+template <HasFields T>
+size_t protoSize(const T& obj)
+{
+    ProtoSizer sizer;
+    encodeProtoMessage(obj, sizer);
+    return sizer.size;
+}
+
+// Whether a field of type V is written with a length only a sizing pass
+// can know: messages that may take 128 bytes or more, and repeated fields
+// and map entries holding them. A message's bound covers everything
+// inside it, so checking the fields of T alone is enough.
+template <typename V>
+constexpr bool protoFieldMeasured()
+{
+    if constexpr (is_optional_v<V>)
+        return protoFieldMeasured<typename V::value_type>();
+    else if constexpr (ProtoMap<V>::value)
+        return protoFieldMeasured<typename V::mapped_type>();
+    else if constexpr (ProtoRepeated<V>::value)
+        return protoFieldMeasured<typename ProtoRepeated<V>::Element>();
+    else if constexpr (HasFields<V>)
+        return protoMaxSize<V>() >= 0x80;
+    else
+        return false;
+}
+
+template <typename T>
+constexpr bool protoMeasured()
+{
+    using Fields = ProtoFields<T>;
+    return []<size_t... I>(std::index_sequence<I...>)
+    {
+        return (false || ... || protoFieldMeasured<typename Fields::template Member<I>>());
+    }(std::make_index_sequence<Fields::count>{});
+}
+
+// A length prefix and the payload write(out) puts after it. Measured ones
+// take a length noted by ProtoLengthWriter's measure; the rest are
+// back-patched, which costs nothing while they stay under 128 bytes.
+template <bool Measured, typename Out, typename F>
+void writeProtoDelimited(Out& out, F&& write)
+{
+    if constexpr (std::is_same_v<Out, ProtoSizer>)
+    {
+        out.delimited([&] { write(out); }, Measured);
+    }
+    else if constexpr (Measured && requires { out.nextLength(); })
+    {
+        if (!out.noted())
+        {
+            ProtoSizer sizer{0, &out.measure()};
+            sizer.delimited([&] { write(sizer); }, true);
+        }
+        out.varint(out.nextLength());
+        write(out);
+    }
+    else
+    {
+        size_t start = out.beginDelimited();
+        write(out);
+        out.endDelimited(start);
+    }
+}
+
+template <uint32_t N, typename Out, HasFields M>
+void writeProtoMessageField(Out& out, const M& m)
+{
+    out.varint(protoKey<N, ProtoWire::Len>);
+    writeProtoDelimited<(protoMaxSize<M>() >= 0x80)>(out, [&](auto& to) { encodeProtoMessage(m, to); });
+}
+
+// -0.0 is not the default, as in protobuf's own serializers
+template <ProtoScalar V>
+bool isProtoDefault(const V& v)
+{
+    if constexpr (std::is_same_v<V, float>)
+        return std::bit_cast<uint32_t>(v) == 0;
+    else if constexpr (FloatingPointType<V>)
+        return std::bit_cast<uint64_t>(static_cast<double>(v)) == 0;
+    else
+        return v == V{};
+}
+
+// Writes one field. Values equal to their default are skipped unless the
+// field has explicit presence (optional fields, repeated elements, map
+// entries).
+template <uint32_t N, ProtoEncoding E, typename Out, typename V>
+void writeProtoValue(Out& out, const V& v, bool explicitPresence)
+{
+    if constexpr (ProtoScalar<V>)
+    {
+        if (!explicitPresence && isProtoDefault(v))
+            return;
+        out.varint(protoKey<N, protoScalarWire<V, E>()>);
+        writeProtoScalar<E>(out, v);
+    }
+    else if constexpr (std::is_same_v<V, std::string>)
+    {
+        if (!explicitPresence && v.empty())
+            return;
+        out.varint(protoKey<N, ProtoWire::Len>);
+        out.varint(v.size());
+        out.bytes(v.data(), v.size());
+    }
+    else if constexpr (std::is_same_v<V, std::filesystem::path>)
+    {
+        writeProtoValue<N, E>(out, v.string(), explicitPresence);
+    }
+    else if constexpr (HasFields<V>)
+    {
+        writeProtoMessageField<N>(out, v);
+    }
+    else if constexpr (ProtoRepeated<V>::value)
+    {
+        using X = typename ProtoRepeated<V>::Element;
+        if constexpr (ProtoScalar<X>)
+        {
+            // Packed: one length-prefixed run of values
+            if (v.empty())
+                return;
+            out.varint(protoKey<N, ProtoWire::Len>);
+            constexpr ProtoWire wire = protoScalarWire<X, E>();
+            if constexpr (wire == ProtoWire::I32 || wire == ProtoWire::I64 || std::is_same_v<X, bool>)
+            {
+                out.varint(v.size() * protoScalarMaxSize<X, E>());
+            }
+            else
+            {
+                ProtoSizer sizer;
+                for (const auto& x : v)
+                    writeProtoScalar<E>(sizer, x);
+                out.varint(sizer.size);
+            }
+            for (const auto& x : v)
+                writeProtoScalar<E>(out, x);
+        }
+        else
+        {
+            static_assert(!ProtoRepeated<X>::value && !ProtoMap<X>::value,
+                          "protobuf has no nested repeated fields; wrap the inner container in a struct");
+            for (const auto& x : v)
+                writeProtoValue<N, E>(out, x, true);
+        }
+    }
+    else if constexpr (ProtoMap<V>::value)
+    {
+        // Each entry is a message { key = 1; value = 2; }
+        constexpr bool measured = protoFieldMeasured<typename V::mapped_type>();
+        for (const auto& [k, x] : v)
+        {
+            out.varint(protoKey<N, ProtoWire::Len>);
+            if constexpr (measured || std::is_same_v<Out, ProtoSizer>)
+            {
+                writeProtoDelimited<measured>(out, [&](auto& to)
+                {
+                    writeProtoValue<1, ProtoEncoding::Default>(to, k, true);
+                    writeProtoValue<2, E>(to, x, true);
+                });
+            }
+            else
+            {
+                // Scalar and string entries are cheaper to add up here
+                ProtoSizer sizer;
+                writeProtoValue<1, ProtoEncoding::Default>(sizer, k, true);
+                writeProtoValue<2, E>(sizer, x, true);
+                out.varint(sizer.size);
+                writeProtoValue<1, ProtoEncoding::Default>(out, k, true);
+                writeProtoValue<2, E>(out, x, true);
+            }
+        }
+    }
+    else
+    {
+        static_assert(ProtoScalar<V> || HasFields<V>, "type has no protobuf equivalent");
+    }
+}
+
+template <HasFields T, typename Out>
+void encodeProtoMessage(const T& obj, Out& out)
+{
+    using Fields = ProtoFields<T>;
+    [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        (..., [&]
+         {
+             using M = typename Fields::template Member<I>;
+             constexpr uint32_t n = Fields::template number<I>;
+             constexpr ProtoEncoding e = Fields::template encoding<I>;
+             const auto& value = obj.*(std::get<I>(get_fields<T>()).memberPtr);
+             if constexpr (is_optional_v<M>)
+             {
+                 if (value)
+                     writeProtoValue<n, e>(out, *value, true);
+             }
+             else
+             {
+                 writeProtoValue<n, e>(out, value, false);
+             }
+         }());
+    }(std::make_index_sequence<Fields::count>{});
+}
+
+// ============================================================================
+// DECODING
+// ============================================================================
+
+inline bool skipProto(BinaryReader& r, uint64_t wire, ValidationResult& result)
+{
+    uint64_t v;
+    std::string_view bytes;
+    switch (wire)
+    {
+    case 0:
+        return r.varint(v, result);
+    case 1:
+        return r.fixed64(v, result);
+    case 2:
+        return r.lengthPrefixed(bytes, result);
+    case 5:
+    {
+        uint32_t w;
+        return r.fixed32(w, result);
+    }
+    default:
+        return r.fail(result, "Unsupported protobuf wire type " + std::to_string(wire));
+    }
+}
+
+template <HasFields T> void decodeProtoMessage(T& obj, BinaryReader& r, ValidationResult& result);
+
+// Reads one occurrence of a field into v. Scalars and strings are
+// replaced, messages merged, repeated fields and maps appended to.
+template <ProtoEncoding E, typename V>
+void readProtoValue(V& v, BinaryReader& r, uint64_t wire, ValidationResult& result)
+{
+    auto expect = [&](ProtoWire w)
+    {
+        if (wire == uint64_t(w))
+            return true;
+        result.addError("", "Wire type mismatch");
+        skipProto(r, wire, result);
+        return false;
+    };
+
+    if constexpr (is_optional_v<V>)
+    {
+        if (!v)
+            v.emplace();
+        readProtoValue<E>(*v, r, wire, result);
+    }
+    else if constexpr (ProtoScalar<V>)
+    {
+        if (expect(protoScalarWire<V, E>()))
+            readProtoScalar<E>(r, v, result);
+    }
+    else if constexpr (std::is_same_v<V, std::string> || std::is_same_v<V, std::filesystem::path>)
+    {
+        std::string_view bytes;
+        if (expect(ProtoWire::Len) && r.lengthPrefixed(bytes, result))
+            v = V(bytes);
+    }
+    else if constexpr (HasFields<V>)
+    {
+        const char* outer;
+        if (expect(ProtoWire::Len) && r.enter(outer, result))
+        {
+            decodeProtoMessage(v, r, result);
+            r.leave(outer);
+        }
+    }
+    else if constexpr (ProtoRepeated<V>::value)
+    {
+        using X = typename ProtoRepeated<V>::Element;
+        auto append = [&](auto&& readOne)
+        {
+            size_t first = result.errors.size();
+            X x{};
+            readOne(x);
+            if (result.errors.size() != first)
+                prefixErrors(result, first, elementPath(v.size()));
+            else if constexpr (requires { v.push_back(std::move(x)); })
+                v.push_back(std::move(x));
+            else
+                v.insert(std::move(x));
+        };
+
+        if constexpr (ProtoScalar<X>)
+        {
+            if (wire == uint64_t(ProtoWire::Len))
+            {
+                const char* outer;
+                if (!r.enter(outer, result))
+                    return;
+                while (!r.atEnd() && !r.failed())
+                    append([&](X& x) { readProtoScalar<E>(r, x, result); });
+                r.leave(outer);
+            }
+            else if (expect(protoScalarWire<X, E>()))
+            {
+                append([&](X& x) { readProtoScalar<E>(r, x, result); });
+            }
+        }
+        else
+        {
+            append([&](X& x) { readProtoValue<E>(x, r, wire, result); });
+        }
+    }
+    else if constexpr (ProtoMap<V>::value)
+    {
+        typename V::key_type key{};
+        typename V::mapped_type value{};
+        const char* outer;
+        if (!expect(ProtoWire::Len) || !r.enter(outer, result))
+            return;
+        size_t first = result.errors.size();
+        while (!r.atEnd())
+        {
+            uint64_t k;
+            if (!r.varint(k, result))
+                return;
+            if (k >> 3 == 1)
+                readProtoValue<ProtoEncoding::Default>(key, r, k & 7, result);
+            else if (k >> 3 == 2)
+                readProtoValue<E>(value, r, k & 7, result);
+            else if (!skipProto(r, k & 7, result))
+                return;
+        }
+        r.leave(outer);
+        if (result.errors.size() != first)
+        {
+            if constexpr (std::is_same_v<typename V::key_type, std::string>)
+                prefixErrors(result, first, key);
+            else
+                prefixErrors(result, first, elementPath(v.size()));
+            return;
+        }
+        v[std::move(key)] = std::move(value);
+    }
+}
+
+template <HasFields T>
+struct ProtoFieldReader
+{
+    using Handler = void (*)(T&, BinaryReader&, uint64_t, ValidationResult&);
+    using Fields = ProtoFields<T>;
+
+    template <size_t I>
+    static void readAt(T& obj, BinaryReader& r, uint64_t wire, ValidationResult& result)
+    {
+        const auto& field = std::get<I>(get_fields<T>());
+        size_t first = result.errors.size();
+        readProtoValue<Fields::template encoding<I>>(obj.*(field.memberPtr), r, wire, result);
+        prefixErrors(result, first, field.fieldName);
+    }
+
+    static constexpr auto handlers = []<size_t... I>(std::index_sequence<I...>)
+    {
+        return std::array<Handler, sizeof...(I)>{&readAt<I>...};
+    }(std::make_index_sequence<Fields::count>{});
+};
+
+// Reads fields until the end of the reader's current bound (the whole
+// input, or a nested message's payload)
+template <HasFields T>
+void decodeProtoMessage(T& obj, BinaryReader& r, ValidationResult& result)
+{
+    using Fields = ProtoFields<T>;
+    size_t hint = 0;
+    while (!r.atEnd())
+    {
+        uint64_t key;
+        if (!r.varint(key, result))
+            return;
+        int idx = key >> 3 <= UINT32_MAX ? Fields::find(static_cast<uint32_t>(key >> 3), hint) : -1;
+        if (idx < 0)
+        {
+            if (!skipProto(r, key & 7, result))
+                return;
+            unknownField<T>(key >> 3, result);
+            continue;
+        }
+        hint = static_cast<size_t>(idx) + 1;
+        ProtoFieldReader<T>::handlers[idx](obj, r, key & 7, result);
+        if (r.failed())
+            return;
+    }
+
+    // A field may occur several times, so attributes are checked once the
+    // message is complete
+    std::apply([&](auto&&... fields) { (..., validateFieldAttributes(obj, fields, result)); }, get_fields<T>());
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+// Messages with lengths that can't be known from the types go through a
+// ProtoLengthWriter
+template <HasFields T>
+void toProto(const T& obj, BinaryWriter& w)
+{
+    if constexpr (protoMeasured<T>())
+    {
+        ProtoLengthWriter out(w);
+        encodeProtoMessage(obj, out);
+    }
+    else
+    {
+        encodeProtoMessage(obj, w);
+    }
+}
+
+template <HasFields T>
+std::string toProto(const T& obj)
+{
+    BinaryWriter w;
+    toProto(obj, w);
+    return w.take();
+}
+
+template <HasFields T>
+void toProto(const T& obj, OutputSink& sink)
+{
+    BinaryWriter w;
+    toProto(obj, w);
+    sink.write(w.view());
+    sink.flush();
+}
+
+template <HasFields T>
+std::pair<std::optional<T>, ValidationResult> fromProto(std::string_view data)
+{
+    ValidationResult result;
+    BinaryReader r(data.data(), data.size());
+    T obj{};
+    decodeProtoMessage(obj, r, result);
+    if (!result.valid)
+        return {std::nullopt, std::move(result)};
+    return {std::optional<T>(std::move(obj)), std::move(result)};
+}
+
+// toProto and fromProto, for META_EXTERN_TEMPLATES / META_INSTANTIATE_TEMPLATES in meta.h
+#define META_PROTO_TEMPLATES(prefix, ...)                                                                             \
+    prefix std::string meta::toProto<__VA_ARGS__>(const __VA_ARGS__&);                                                \
+    prefix void meta::toProto<__VA_ARGS__>(const __VA_ARGS__&, meta::OutputSink&);                                    \
+    prefix std::pair<std::optional<__VA_ARGS__>, meta::ValidationResult> meta::fromProto<__VA_ARGS__>(                \
+        std::string_view)
+
+} // namespace meta
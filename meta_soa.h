@@ -0,0 +1,535 @@
+/*
+ * meta_soa.h - Struct-of-arrays container for reflected structs
+ *
+ * meta::soa_vector<T> stores each field listed in FieldsMeta in its own
+ * contiguous column, so a pass over one or two fields of millions of
+ * records reads only those fields' memory and vectorizes like a loop over
+ * a plain array.
+ *
+ * Supports:
+ * - push_back / emplace_back / pop_back of whole records, reserve, resize
+ * - Row proxies: soa[i].get<&T::field>(), conversion to T, assignment
+ * - Per-column std::span access: soa.column<&T::price>()
+ * - Random-access iteration, so the range-based serializers (serializeJson,
+ *   toCSVWithHeader, the parallel variants) accept it unchanged
+ * - to()/from() overloads: toJson/toYaml/fromJson of a soa_vector read and
+ *   write the same documents as std::vector<T>
+ * - Conversion to and from std::vector<T>
+ * - meta::validate / meta::isValid checking one column at a time
+ *
+ * Usage:
+ *   #include "meta_soa.h"
+ *
+ *   meta::soa_vector<Person> people(loadPeople());
+ *   double total = 0;
+ *   for (double salary : people.column<&Person::salary>())
+ *       total += salary;
+ *   people[3].get<&Person::name>() = "Ada";
+ *   std::string json = meta::toJson(people);
+ *
+ * bool columns are stored as bool arrays rather than std::vector<bool>, so
+ * they too can be handed out as std::span<bool>. The Ser hook of T is
+ * used when a row is serialized, which materializes that row as a T.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "meta.h"
+
+namespace meta
+{
+
+// ============================================================================
+// COLUMN STORAGE
+// ============================================================================
+
+// A growable bool array: std::vector<bool> packs bits and has no data()
+class soa_bool_column
+{
+  public:
+    soa_bool_column() = default;
+    soa_bool_column(const soa_bool_column& other) { *this = other; }
+    soa_bool_column(soa_bool_column&& other) noexcept = default;
+    soa_bool_column& operator=(soa_bool_column&& other) noexcept = default;
+
+    soa_bool_column& operator=(const soa_bool_column& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            reserve(other.count);
+            std::copy_n(other.values.get(), other.count, values.get());
+            count = other.count;
+        }
+        return *this;
+    }
+
+    bool* data() { return values.get(); }
+    const bool* data() const { return values.get(); }
+    size_t size() const { return count; }
+    size_t capacity() const { return cap; }
+
+    bool& operator[](size_t i) { return values[i]; }
+    const bool& operator[](size_t i) const { return values[i]; }
+
+    void reserve(size_t n)
+    {
+        if (n <= cap)
+            return;
+        std::unique_ptr<bool[]> grown(new bool[n]);
+        std::copy_n(values.get(), count, grown.get());
+        values = std::move(grown);
+        cap = n;
+    }
+
+    void resize(size_t n)
+    {
+        reserve(n);
+        std::fill(values.get() + std::min(count, n), values.get() + n, false);
+        count = n;
+    }
+
+    void push_back(bool v)
+    {
+        if (count == cap)
+            reserve(std::max<size_t>(cap * 2, 16));
+        values[count++] = v;
+    }
+
+    void pop_back() { --count; }
+    void clear() { count = 0; }
+
+  private:
+    std::unique_ptr<bool[]> values;
+    size_t count = 0;
+    size_t cap = 0;
+};
+
+template <typename M>
+using soa_column_t = std::conditional_t<std::is_same_v<M, bool>, soa_bool_column, std::vector<M>>;
+
+template <HasFields T> class soa_vector;
+
+// ============================================================================
+// ROW PROXIES AND ITERATORS
+// ============================================================================
+
+// soa[i]: refers to row i of a soa_vector, like std::vector<bool>::reference
+template <HasFields T, bool Const>
+class soa_row
+{
+    using Container = std::conditional_t<Const, const soa_vector<T>, soa_vector<T>>;
+
+  public:
+    soa_row(Container& soa, size_t index) : soa(&soa), row(index) {}
+    soa_row(const soa_row&) = default;
+
+    // Mutable rows convert to const ones
+    template <bool C = Const>
+        requires C
+    soa_row(const soa_row<T, false>& other) : soa(other.soa), row(other.row)
+    {
+    }
+
+    template <auto P>
+    decltype(auto) get() const
+    {
+        return soa->template column<P>()[row];
+    }
+
+    template <size_t I>
+    decltype(auto) getAt() const
+    {
+        return soa->template columnAt<I>()[row];
+    }
+
+    size_t index() const { return row; }
+
+    operator T() const
+    {
+        T obj{};
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            ((obj.*(std::get<I>(get_fields<T>()).memberPtr) = getAt<I>()), ...);
+        }(std::make_index_sequence<field_count_v<T>>{});
+        return obj;
+    }
+
+    // Assignment writes through to the container, it never rebinds
+    const soa_row& operator=(const T& obj) const
+        requires(!Const)
+    {
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            ((getAt<I>() = obj.*(std::get<I>(get_fields<T>()).memberPtr)), ...);
+        }(std::make_index_sequence<field_count_v<T>>{});
+        return *this;
+    }
+
+    const soa_row& operator=(const soa_row& other) const
+        requires(!Const)
+    {
+        return *this = static_cast<T>(other);
+    }
+
+  private:
+    friend class soa_row<T, !Const>;
+
+    Container* soa;
+    size_t row;
+};
+
+template <HasFields T, bool Const>
+class soa_iterator
+{
+    using Container = std::conditional_t<Const, const soa_vector<T>, soa_vector<T>>;
+
+  public:
+    using value_type = T;
+    using reference = soa_row<T, Const>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+
+    soa_iterator() = default;
+    soa_iterator(Container* soa, size_t index) : soa(soa), row(index) {}
+
+    reference operator*() const { return reference(*soa, row); }
+    reference operator[](difference_type n) const { return reference(*soa, row + n); }
+
+    soa_iterator& operator++() { ++row; return *this; }
+    soa_iterator operator++(int) { auto old = *this; ++row; return old; }
+    soa_iterator& operator--() { --row; return *this; }
+    soa_iterator operator--(int) { auto old = *this; --row; return old; }
+    soa_iterator& operator+=(difference_type n) { row += n; return *this; }
+    soa_iterator& operator-=(difference_type n) { row -= n; return *this; }
+
+    friend soa_iterator operator+(soa_iterator it, difference_type n) { return it += n; }
+    friend soa_iterator operator+(difference_type n, soa_iterator it) { return it += n; }
+    friend soa_iterator operator-(soa_iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const soa_iterator& a, const soa_iterator& b)
+    {
+        return static_cast<difference_type>(a.row) - static_cast<difference_type>(b.row);
+    }
+
+    friend bool operator==(const soa_iterator& a, const soa_iterator& b) { return a.row == b.row; }
+    friend auto operator<=>(const soa_iterator& a, const soa_iterator& b) { return a.row <=> b.row; }
+
+  private:
+    Container* soa = nullptr;
+    size_t row = 0;
+};
+
+// ============================================================================
+// SOA_VECTOR
+// ============================================================================
+
+template <HasFields T>
+class soa_vector
+{
+    using Tuple = std::decay_t<decltype(get_fields<T>())>;
+    static constexpr size_t fieldCount = field_count_v<T>;
+    static_assert(fieldCount > 0, "soa_vector needs at least one field");
+
+    template <size_t I>
+    using Member = typename std::tuple_element_t<I, Tuple>::MemberType;
+
+    template <size_t... I>
+    static auto columnsOf(std::index_sequence<I...>) -> std::tuple<soa_column_t<Member<I>>...>;
+    using Columns = decltype(columnsOf(std::make_index_sequence<fieldCount>{}));
+
+  public:
+    using value_type = T;
+    using size_type = size_t;
+    using reference = soa_row<T, false>;
+    using const_reference = soa_row<T, true>;
+    using iterator = soa_iterator<T, false>;
+    using const_iterator = soa_iterator<T, true>;
+
+    soa_vector() = default;
+
+    explicit soa_vector(const std::vector<T>& rows)
+    {
+        reserve(rows.size());
+        for (const T& row : rows)
+            push_back(row);
+    }
+
+    explicit soa_vector(std::vector<T>&& rows)
+    {
+        reserve(rows.size());
+        for (T& row : rows)
+            push_back(std::move(row));
+        rows.clear();
+    }
+
+    std::vector<T> to_vector() const
+    {
+        std::vector<T> out;
+        out.reserve(size());
+        for (size_t i = 0; i < size(); ++i)
+            out.push_back((*this)[i]);
+        return out;
+    }
+
+    // ------------------------------------------------------------------------
+    // Columns
+    // ------------------------------------------------------------------------
+
+    // Position of the field declared with member pointer P
+    template <auto P>
+    static constexpr size_t indexOf()
+    {
+        size_t index = fieldCount;
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (..., [&]
+             {
+                 constexpr auto member = std::tuple_element_t<I, Tuple>::memberPtr;
+                 if constexpr (std::is_same_v<std::remove_cv_t<decltype(member)>, std::remove_cv_t<decltype(P)>>)
+                 {
+                     if (member == P)
+                         index = I;
+                 }
+             }());
+        }(std::make_index_sequence<fieldCount>{});
+        return index;
+    }
+
+    template <size_t I>
+    std::span<Member<I>> columnAt()
+    {
+        auto& c = std::get<I>(columns);
+        return {c.data(), c.size()};
+    }
+
+    template <size_t I>
+    std::span<const Member<I>> columnAt() const
+    {
+        const auto& c = std::get<I>(columns);
+        return {c.data(), c.size()};
+    }
+
+    template <auto P>
+    auto column()
+    {
+        static_assert(indexOf<P>() < fieldCount, "Member is not listed in FieldsMeta");
+        return columnAt<indexOf<P>()>();
+    }
+
+    template <auto P>
+    auto column() const
+    {
+        static_assert(indexOf<P>() < fieldCount, "Member is not listed in FieldsMeta");
+        return columnAt<indexOf<P>()>();
+    }
+
+    // ------------------------------------------------------------------------
+    // Rows
+    // ------------------------------------------------------------------------
+
+    size_t size() const { return std::get<0>(columns).size(); }
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return std::get<0>(columns).capacity(); }
+
+    reference operator[](size_t i) { return reference(*this, i); }
+    const_reference operator[](size_t i) const { return const_reference(*this, i); }
+
+    reference at(size_t i)
+    {
+        if (i >= size())
+            throw std::out_of_range("soa_vector::at");
+        return (*this)[i];
+    }
+
+    const_reference at(size_t i) const
+    {
+        if (i >= size())
+            throw std::out_of_range("soa_vector::at");
+        return (*this)[i];
+    }
+
+    reference front() { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+    reference back() { return (*this)[size() - 1]; }
+    const_reference back() const { return (*this)[size() - 1]; }
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, size()}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size()}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    void reserve(size_t n)
+    {
+        std::apply([&](auto&... c) { (c.reserve(n), ...); }, columns);
+    }
+
+    void resize(size_t n)
+    {
+        std::apply([&](auto&... c) { (c.resize(n), ...); }, columns);
+    }
+
+    void clear()
+    {
+        std::apply([&](auto&... c) { (c.clear(), ...); }, columns);
+    }
+
+    void push_back(const T& obj)
+    {
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (std::get<I>(columns).push_back(obj.*(std::get<I>(get_fields<T>()).memberPtr)), ...);
+        }(std::make_index_sequence<fieldCount>{});
+    }
+
+    void push_back(T&& obj)
+    {
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (std::get<I>(columns).push_back(std::move(obj.*(std::get<I>(get_fields<T>()).memberPtr))), ...);
+        }(std::make_index_sequence<fieldCount>{});
+    }
+
+    // Builds the record from args, then moves each field into its column
+    template <typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        if constexpr (std::is_constructible_v<T, Args...>)
+            push_back(T(std::forward<Args>(args)...));
+        else
+            push_back(T{std::forward<Args>(args)...});
+        return back();
+    }
+
+    void pop_back()
+    {
+        std::apply([](auto&... c) { (c.pop_back(), ...); }, columns);
+    }
+
+  private:
+    Columns columns;
+};
+
+// ============================================================================
+// SERIALIZATION
+// ============================================================================
+
+// A row serializes exactly like the T it stands for
+template <HasFields T, bool Const, BuilderLike B>
+void to(const soa_row<T, Const>& row, B& b)
+{
+    if constexpr (requires { typename T::Ser; })
+    {
+        to(static_cast<T>(row), b);
+    }
+    else
+    {
+        b.startMap("");
+        [&]<size_t... I>(std::index_sequence<I...>)
+        {
+            (..., [&]
+             {
+                 const auto& field = std::get<I>(get_fields<T>());
+                 const FieldKey k{field.fieldName, JsonKeys<T>::fragment(I)};
+                 if constexpr (requires { b.fieldKey(k); })
+                     b.fieldKey(k);
+                 else
+                     b.key(std::string(k.name));
+                 to(row.template getAt<I>(), b);
+             }());
+        }(std::make_index_sequence<field_count_v<T>>{});
+        b.endMap();
+    }
+}
+
+template <HasFields T, BuilderLike B>
+void to(const soa_vector<T>& obj, B& b)
+{
+    b.startSeq(typeid(T).name());
+    for (const auto& row : obj)
+        to(row, b);
+    b.endSeq();
+}
+
+// Same document shape and error paths as std::vector<T>
+template <HasFields T>
+ValidationResult from(soa_vector<T>& obj, Node* node)
+{
+    if (!node->isSequence())
+    {
+        ValidationResult r;
+        r.addError("", "Expected sequence");
+        return r;
+    }
+
+    obj.clear();
+    obj.reserve(node->size());
+    ValidationResult result;
+    const size_t count = node->size();
+    NodeCursor child;
+    for (size_t i = 0; i < count; ++i)
+    {
+        T elem{};
+        auto elemResult = from(elem, node->at(i, child));
+        if (!elemResult.valid)
+        {
+            appendElementErrors(result, i, std::move(elemResult));
+            if (FailFast::active())
+                break;
+        }
+        else
+        {
+            obj.push_back(std::move(elem));
+        }
+    }
+    return result;
+}
+
+// meta::validate over the columns: every check is a loop over one
+// contiguous array, which is what lets BoundsCheck on numbers vectorize.
+// Rows that fail are rebuilt as T for their messages.
+template <HasFields T, typename F>
+void scanInvalid(const soa_vector<T>& obj, F&& invalid)
+{
+    auto columns = [&]<size_t... I>(std::index_sequence<I...>)
+    {
+        return std::make_tuple(obj.template columnAt<I>().data()...);
+    }(std::make_index_sequence<field_count_v<T>>{});
+    ValidationPlan<T>::scan(obj.size(), [columns]<size_t I>(std::integral_constant<size_t, I>, size_t i) -> decltype(auto)
+    {
+        return std::get<I>(columns)[i];
+    }, invalid);
+}
+
+template <HasFields T>
+ValidationResult validate(const soa_vector<T>& obj)
+{
+    ValidationResult result;
+    scanInvalid(obj, [&](size_t i)
+    {
+        ValidationResult r;
+        checkValue<true>(static_cast<T>(obj[i]), &r);
+        appendElementErrors(result, i, std::move(r));
+        return true;
+    });
+    return result;
+}
+
+template <HasFields T>
+bool isValid(const soa_vector<T>& obj)
+{
+    bool valid = true;
+    scanInvalid(obj, [&](size_t) { return valid = false; });
+    return valid;
+}
+
+} // namespace meta
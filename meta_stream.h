@@ -0,0 +1,831 @@
+/*
+ * meta_stream.h - Incremental JSON and YAML readers for input that arrives in chunks
+ *
+ * Reads a document while it is still arriving: feed() takes each chunk as
+ * it comes off the socket and does all the parsing it can, so the work
+ * overlaps with the I/O and the last chunk is followed by one last step
+ * instead of the whole parse.
+ *
+ * Supports:
+ * - A top-level JSON array or YAML block sequence, handed over one element
+ *   at a time as each one completes (JsonArrayStream, YamlSequenceStream)
+ * - A top-level JSON object or YAML mapping read into a struct, each member
+ *   filled as soon as its value is complete (JsonObjectStream, YamlObjectStream)
+ * - Chunks cut anywhere: inside strings, escapes, numbers or UTF-8 sequences
+ *
+ * Usage:
+ *   #include "meta.h"
+ *   #include "meta_stream.h"
+ *
+ *   auto orders = meta::streamJsonArray<Order>([&](Order&& order) { queue.push(std::move(order)); });
+ *   while (size_t n = socket.read(buffer, sizeof(buffer)))
+ *       orders.feed(std::string_view(buffer, n));
+ *   meta::ValidationResult result = orders.finish();
+ *
+ *   meta::JsonObjectStream<Config> config;
+ *   ...
+ *   auto [loaded, configResult] = config.finish();
+ *
+ * The readers only keep the element or member being received, so memory is
+ * bounded by the largest one rather than by the document. Each is parsed on
+ * its own once complete, with the same from() overloads and validation as
+ * fromJson / reifyFromYaml: an element that fails is left out and its errors
+ * are reported under "[i]", and the rest of the stream is still read. With
+ * FailFast alive, reading stops at the first error.
+ *
+ * An element's bytes are gone once its callback returns: std::string_view
+ * and std::span<const std::byte> fields must be copied inside it.
+ *
+ * YAML is split at column 0 ("- " items, or keys), so an alias can only
+ * refer to an anchor within the same top-level entry. Input that does not
+ * start that way (a flow sequence, an indented root) is buffered and read
+ * by finish() in one go.
+ */
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "meta.h"
+#include "meta_json.h"
+
+namespace meta
+{
+
+// ============================================================================
+// SHARED
+// ============================================================================
+
+namespace stream_detail
+{
+
+// onElement(T&&) or onElement(T&&, size_t index)
+template <typename T, typename F>
+void deliver(F& onElement, T&& value, size_t index)
+{
+    if constexpr (std::is_invocable_v<F&, T&&, size_t>)
+        onElement(std::move(value), index);
+    else
+        onElement(std::move(value));
+}
+
+// A JSON parse error with the offset moved from the element to the stream
+inline std::string relocate(const JsonParseError& e, size_t at)
+{
+    std::string_view what = e.what();
+    what = what.substr(0, what.rfind(" at offset "));
+    return JsonParseError(std::string(what), at + e.offset).what();
+}
+
+// A YAML parse error with the mark moved from the entry to the stream
+inline std::string relocate(const YAML::Exception& e, size_t at, size_t line)
+{
+    if (e.mark.is_null())
+        return e.what();
+    YAML::Mark mark = e.mark;
+    mark.pos += static_cast<int>(at);
+    mark.line += static_cast<int>(line);
+    return YAML::Exception(mark, e.msg).what();
+}
+
+} // namespace stream_detail
+
+// Fills a struct one top-level entry at a time and remembers which fields
+// it has seen, so the required ones still missing can be listed at the end
+template <typename T>
+class StructFiller
+{
+    static_assert(HasFields<T> && !CustomDeser<T>,
+                  "Streaming a struct needs T::FieldsMeta or meta::MetaTuple<T>::FieldsMeta and no custom Deser");
+
+  public:
+    // Reads the entries of `node` (a map) into their fields
+    void read(T& obj, Node* node, ValidationResult& result, bool reportUnknown)
+    {
+        static constexpr auto handlers = KeyDispatch<T>::makeHandlers(std::make_index_sequence<field_count_v<T>>{});
+        node->forEachEntry([&](std::string_view key, Node* value)
+        {
+            int idx = findField<T>(key, node);
+            if (idx < 0)
+            {
+                unknownField<T>(key, result, reportUnknown);
+                return !FailFast::stop(result);
+            }
+            seen[idx] = true;
+            handlers[idx](obj, value, result);
+            return !FailFast::stop(result);
+        });
+    }
+
+    void checkRequired(ValidationResult& result) const
+    {
+        size_t i = 0;
+        std::apply([&](auto&&... fields) {
+            (..., [&](auto& field) {
+                if (!seen[i++] && field.requirement == Requirement::Required)
+                    result.addError(field.fieldName, "Missing required field");
+            }(fields));
+        }, get_fields<T>());
+    }
+
+  private:
+    std::array<bool, field_count_v<T>> seen{};
+};
+
+// ============================================================================
+// JSON
+// ============================================================================
+
+// Splits a top-level JSON array or object into its items as the bytes
+// arrive. It only follows strings and bracket nesting; each item is parsed
+// by JsonDocument once its closing ',' or bracket has been seen. Object
+// members are handed over wrapped as a one-member object, {"key": value}.
+class JsonItemScanner
+{
+  public:
+    explicit JsonItemScanner(char open) : opener(open), closer(open == '[' ? ']' : '}')
+    {
+        if (opener == '{')
+            item.push_back('{');
+    }
+
+    // Scans chunk and calls emit(text, offset) for every item it completes;
+    // offset is where text's first byte sits in the stream. emit returns
+    // false to stop reading.
+    template <typename F>
+    void feed(std::string_view chunk, F&& emit)
+    {
+        chunkBegin = chunk.data();
+        chunkEnd = chunkBegin + chunk.size();
+        const char* p = chunkBegin;
+        const char* end = chunkEnd;
+        while (p < end && stage != Stage::Failed && stage != Stage::Stopped)
+        {
+            if (stage == Stage::Before)
+                p = scanBefore(p, end);
+            else if (stage == Stage::Within)
+                p = scanWithin(p, end, emit);
+            else
+                p = scanAfter(p, end);
+        }
+        offset += chunk.size();
+    }
+
+    // Call once the input has ended
+    void finish()
+    {
+        if (stage == Stage::Before || stage == Stage::Within)
+            fail("Unexpected end of input", offset);
+    }
+
+    bool failed() const { return stage == Stage::Failed; }
+    const std::string& error() const { return message; }
+
+    // Bytes held for the item in progress
+    size_t buffered() const { return item.size(); }
+
+  private:
+    enum class Stage : uint8_t
+    {
+        Before,
+        Within,
+        After,
+        Stopped,
+        Failed
+    };
+
+    char opener;
+    char closer;
+    Stage stage = Stage::Before;
+    std::string item;
+    std::vector<char> nesting; // brackets open below the root
+    bool inString = false;
+    bool escaped = false;
+    bool hasItem = false;
+    bool afterComma = false;
+    size_t itemStart = 0;
+    size_t offset = 0; // stream offset of the current chunk
+    const char* chunkBegin = nullptr;
+    const char* chunkEnd = nullptr;
+    std::string message;
+
+    static bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+    size_t at(const char* p) const { return offset + static_cast<size_t>(p - chunkBegin); }
+
+    const char* fail(const char* what, size_t where)
+    {
+        message = JsonParseError(what, where).what();
+        stage = Stage::Failed;
+        return chunkEnd;
+    }
+
+    const char* scanBefore(const char* p, const char* end)
+    {
+        while (p < end && isSpace(*p))
+            ++p;
+        if (p == end)
+            return p;
+        if (*p != opener)
+            return fail(opener == '[' ? "Expected a JSON array" : "Expected a JSON object", at(p));
+        stage = Stage::Within;
+        return p + 1;
+    }
+
+    const char* scanAfter(const char* p, const char* end)
+    {
+        while (p < end && isSpace(*p))
+            ++p;
+        if (p != end)
+            return fail("Trailing characters after JSON value", at(p));
+        return p;
+    }
+
+    const char* startItem(const char* p, const char* run)
+    {
+        if (hasItem)
+            return run;
+        hasItem = true;
+        itemStart = at(p);
+        return p;
+    }
+
+    // Hands over the item that ends at p; run is where its bytes in this
+    // chunk begin. An array element that lies within one chunk is passed
+    // as a view of it, anything else is assembled in item first.
+    template <typename F>
+    bool emitItem(F& emit, const char* run, const char* p)
+    {
+        bool more;
+        if (opener == '[' && item.empty())
+            more = emit(std::string_view(run, static_cast<size_t>(p - run)), itemStart);
+        else
+        {
+            item.append(run, p);
+            if (opener == '{')
+                item.push_back('}');
+            size_t prefix = opener == '{' ? 1 : 0;
+            more = emit(std::string_view(item), itemStart - prefix);
+            item.resize(prefix);
+        }
+        hasItem = false;
+        if (!more)
+            stage = Stage::Stopped;
+        return more;
+    }
+
+    template <typename F>
+    const char* scanWithin(const char* p, const char* end, F& emit)
+    {
+        const char* run = p;
+        if (inString && escaped && p < end)
+        {
+            escaped = false;
+            ++p;
+        }
+        while (p < end)
+        {
+            if (inString)
+            {
+                while (p < end && *p != '"' && *p != '\\')
+                    ++p;
+                if (p == end)
+                    break;
+                if (*p == '\\')
+                {
+                    if (++p == end)
+                    {
+                        escaped = true;
+                        break;
+                    }
+                }
+                else
+                    inString = false;
+                ++p;
+                continue;
+            }
+
+            char c = *p;
+            if (c == '"')
+            {
+                run = startItem(p, run);
+                inString = true;
+            }
+            else if (c == '{' || c == '[')
+            {
+                if (nesting.size() + 1 >= JsonDocument::maxDepth)
+                    return fail("JSON nested too deeply", at(p));
+                run = startItem(p, run);
+                nesting.push_back(c);
+            }
+            else if (c == '}' || c == ']')
+            {
+                if (nesting.empty())
+                {
+                    if (c != closer)
+                        return fail("Mismatched bracket", at(p));
+                    if (hasItem)
+                    {
+                        if (!emitItem(emit, run, p))
+                            return end;
+                    }
+                    else if (afterComma)
+                        return fail("Trailing comma", at(p));
+                    stage = Stage::After;
+                    return p + 1;
+                }
+                if ((nesting.back() == '{') != (c == '}'))
+                    return fail("Mismatched bracket", at(p));
+                nesting.pop_back();
+            }
+            else if (c == ',' && nesting.empty())
+            {
+                if (!hasItem)
+                    return fail("Unexpected ','", at(p));
+                afterComma = true;
+                if (!emitItem(emit, run, p))
+                    return end;
+            }
+            else if (!isSpace(c))
+            {
+                run = startItem(p, run);
+            }
+            ++p;
+        }
+        if (hasItem)
+            item.append(run, p);
+        return p;
+    }
+};
+
+// Elements of a top-level JSON array, read one at a time and handed to
+// onElement as each completes. Make one with streamJsonArray<T>(onElement).
+template <typename T, typename F>
+class JsonArrayStream
+{
+  public:
+    explicit JsonArrayStream(F onElement) : scanner('['), onElement(std::move(onElement)) {}
+
+    // Reads every element chunk completes; onElement runs inside this call
+    void feed(std::string_view chunk)
+    {
+        scanner.feed(chunk, [this](std::string_view text, size_t at) { return readElement(text, at); });
+    }
+
+    // Call once the input has ended. Reports a malformed or unfinished
+    // array along with the errors of the elements that were left out.
+    ValidationResult finish()
+    {
+        scanner.finish();
+        if (scanner.failed())
+            result.addError("json", scanner.error());
+        return std::move(result);
+    }
+
+    // Elements seen so far, delivered or not
+    size_t count() const { return index; }
+
+    // Bytes held for the element in progress
+    size_t buffered() const { return scanner.buffered(); }
+
+  private:
+    JsonItemScanner scanner;
+    JsonDocument doc;
+    F onElement;
+    ValidationResult result;
+    size_t index = 0;
+
+    bool readElement(std::string_view text, size_t at)
+    {
+        size_t i = index++;
+        T value{};
+        ValidationResult elemResult;
+        try
+        {
+            doc.parse(text);
+            JsonNode root(doc, 0);
+            elemResult = from(value, &root);
+        }
+        catch (const JsonParseError& e)
+        {
+            elemResult.addError("", stream_detail::relocate(e, at));
+        }
+        if (elemResult.valid)
+            stream_detail::deliver(onElement, std::move(value), i);
+        else
+            appendElementErrors(result, i, std::move(elemResult));
+        return !FailFast::stop(result);
+    }
+};
+
+template <typename T, typename F>
+JsonArrayStream<T, F> streamJsonArray(F onElement)
+{
+    return JsonArrayStream<T, F>(std::move(onElement));
+}
+
+// A top-level JSON object read into T; each member is read into its field
+// as soon as its value is complete. Keys that are not fields are skipped,
+// as fromJson does.
+template <typename T>
+class JsonObjectStream
+{
+  public:
+    JsonObjectStream() : scanner('{') { value.emplace(); }
+
+    void feed(std::string_view chunk)
+    {
+        scanner.feed(chunk, [this](std::string_view text, size_t at) { return readMember(text, at); });
+    }
+
+    // The struct, or nullopt when the input or one of its fields was invalid
+    std::pair<std::optional<T>, ValidationResult> finish()
+    {
+        std::pair<std::optional<T>, ValidationResult> out;
+        scanner.finish();
+        if (scanner.failed())
+            result.addError("json", scanner.error());
+        else if (!FailFast::stop(result))
+            filler.checkRequired(result);
+        out.second = std::move(result);
+        if (out.second.valid)
+            out.first = std::move(value);
+        return out;
+    }
+
+  private:
+    JsonItemScanner scanner;
+    JsonDocument doc;
+    StructFiller<T> filler;
+    std::optional<T> value;
+    ValidationResult result;
+
+    bool readMember(std::string_view text, size_t at)
+    {
+        try
+        {
+            doc.parse(text);
+            JsonNode root(doc, 0);
+            filler.read(*value, &root, result, false);
+        }
+        catch (const JsonParseError& e)
+        {
+            result.addError("json", stream_detail::relocate(e, at));
+        }
+        return !FailFast::stop(result);
+    }
+};
+
+// ============================================================================
+// YAML
+// ============================================================================
+
+// Splits a YAML document into its top-level entries line by line: a
+// sequence entry starts with "-" at column 0, a mapping entry with a key
+// at column 0. Indented lines, blank lines and comments belong to the entry
+// before them. Input that does not begin that way is kept whole.
+class YamlItemScanner
+{
+  public:
+    explicit YamlItemScanner(bool sequence) : sequence(sequence) {}
+
+    // Scans chunk and calls emit(text, offset, line) for every entry it
+    // completes; offset and line (0-based) are where text starts in the
+    // stream. emit returns false to stop reading.
+    template <typename F>
+    void feed(std::string_view chunk, F&& emit)
+    {
+        while (!chunk.empty() && stage != Stage::Stopped)
+        {
+            size_t nl = chunk.find('\n');
+            if (nl == std::string_view::npos)
+            {
+                partial.append(chunk);
+                return;
+            }
+            std::string_view line = chunk.substr(0, nl + 1);
+            chunk.remove_prefix(nl + 1);
+            if (partial.empty())
+                scanLine(line, emit);
+            else
+            {
+                partial.append(line);
+                scanLine(partial, emit);
+                partial.clear();
+            }
+        }
+    }
+
+    // Call once the input has ended; emits the last entry
+    template <typename F>
+    void finish(F&& emit)
+    {
+        if (!partial.empty())
+        {
+            scanLine(partial, emit);
+            partial.clear();
+        }
+        if (hasItem && stage == Stage::Within)
+            emitItem(emit);
+    }
+
+    // Input that could not be split, to be read in one go, and where it starts
+    bool whole() const { return stage == Stage::Whole; }
+    std::string_view text() const { return item; }
+    size_t wholeOffset() const { return itemOffset; }
+    size_t wholeLine() const { return itemLine; }
+
+    size_t buffered() const { return item.size() + partial.size(); }
+
+  private:
+    enum class Stage : uint8_t
+    {
+        Before,
+        Within,
+        Whole,
+        After,
+        Stopped
+    };
+
+    bool sequence;
+    Stage stage = Stage::Before;
+    std::string item;
+    std::string partial; // a line still waiting for its newline
+    bool hasItem = false;
+    size_t itemOffset = 0;
+    size_t itemLine = 0;
+    size_t offset = 0; // stream offset of the next line
+    size_t lineNo = 0;
+
+    static bool isBreak(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    static bool marker(std::string_view line, std::string_view m)
+    {
+        return line.substr(0, 3) == m && (line.size() == 3 || isBreak(line[3]));
+    }
+
+    bool startsItem(std::string_view line) const
+    {
+        char c = line[0];
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '#')
+            return false;
+        bool dash = c == '-' && (line.size() == 1 || isBreak(line[1]));
+        return sequence ? dash : !dash;
+    }
+
+    static bool blank(std::string_view line)
+    {
+        size_t i = line.find_first_not_of(" \t\r\n");
+        return i == std::string_view::npos || line[i] == '#';
+    }
+
+    template <typename F>
+    void emitItem(F& emit)
+    {
+        bool more = emit(std::string_view(item), itemOffset, itemLine);
+        item.clear();
+        hasItem = false;
+        if (!more)
+            stage = Stage::Stopped;
+    }
+
+    template <typename F>
+    void scanLine(std::string_view line, F& emit)
+    {
+        size_t lineOffset = offset;
+        size_t line0 = lineNo++;
+        offset += line.size();
+
+        if (stage == Stage::Whole)
+        {
+            item.append(line);
+            return;
+        }
+        if (stage == Stage::After || stage == Stage::Stopped)
+            return;
+
+        // Directives come before the document
+        if (stage == Stage::Before && line[0] == '%')
+            return;
+
+        // Only the first document is read, as YamlDocument does
+        bool start = marker(line, "---");
+        if (start || marker(line, "..."))
+        {
+            if (start && stage == Stage::Before)
+            {
+                if (!blank(line.substr(3)))
+                    keepWhole(line.substr(3), lineOffset + 3, line0);
+                return;
+            }
+            if (hasItem)
+                emitItem(emit);
+            if (stage != Stage::Stopped)
+                stage = Stage::After;
+            return;
+        }
+
+        if (startsItem(line))
+        {
+            if (hasItem)
+            {
+                emitItem(emit);
+                if (stage == Stage::Stopped)
+                    return;
+            }
+            if (stage == Stage::Before && !sequence && (line[0] == '{' || line[0] == '['))
+            {
+                keepWhole(line, lineOffset, line0);
+                return;
+            }
+            stage = Stage::Within;
+            hasItem = true;
+            itemOffset = lineOffset;
+            itemLine = line0;
+            item.append(line);
+        }
+        else if (hasItem)
+        {
+            item.append(line);
+        }
+        else if (!blank(line))
+        {
+            keepWhole(line, lineOffset, line0);
+        }
+    }
+
+    void keepWhole(std::string_view line, size_t at, size_t line0)
+    {
+        stage = Stage::Whole;
+        itemOffset = at;
+        itemLine = line0;
+        item.assign(line);
+    }
+};
+
+// Elements of a top-level YAML sequence, read one "- " entry at a time and
+// handed to onElement as each completes. Make one with
+// streamYamlSequence<T>(onElement).
+template <typename T, typename F>
+class YamlSequenceStream
+{
+  public:
+    explicit YamlSequenceStream(F onElement) : scanner(true), onElement(std::move(onElement)) {}
+
+    void feed(std::string_view chunk)
+    {
+        scanner.feed(chunk, [this](std::string_view text, size_t at, size_t line) { return readEntry(text, at, line); });
+    }
+
+    ValidationResult finish()
+    {
+        scanner.finish([this](std::string_view text, size_t at, size_t line) { return readEntry(text, at, line); });
+        if (scanner.whole())
+            readWhole();
+        return std::move(result);
+    }
+
+    size_t count() const { return index; }
+    size_t buffered() const { return scanner.buffered(); }
+
+  private:
+    YamlItemScanner scanner;
+    YamlDocument doc;
+    F onElement;
+    ValidationResult result;
+    size_t index = 0;
+
+    bool readElement(Node* node)
+    {
+        size_t i = index++;
+        T value{};
+        ValidationResult elemResult = from(value, node);
+        if (elemResult.valid)
+            stream_detail::deliver(onElement, std::move(value), i);
+        else
+            appendElementErrors(result, i, std::move(elemResult));
+        return !FailFast::stop(result);
+    }
+
+    bool readEntry(std::string_view text, size_t at, size_t line)
+    {
+        try
+        {
+            doc.parse(text);
+        }
+        catch (const YAML::Exception& e)
+        {
+            appendElementErrors(result, index++, [&] {
+                ValidationResult r;
+                r.addError("", stream_detail::relocate(e, at, line));
+                return r;
+            }());
+            return !FailFast::stop(result);
+        }
+        YamlDocumentNode root(doc, 0);
+        NodeCursor cursor;
+        Node* element = root.at(size_t(0), cursor);
+        if (!element)
+        {
+            appendElementErrors(result, index++, [] {
+                ValidationResult r;
+                r.addError("", "Expected sequence");
+                return r;
+            }());
+            return !FailFast::stop(result);
+        }
+        return readElement(element);
+    }
+
+    // A flow sequence or other input the scanner could not split
+    void readWhole()
+    {
+        try
+        {
+            doc.parse(scanner.text());
+        }
+        catch (const YAML::Exception& e)
+        {
+            result.addError("yaml", stream_detail::relocate(e, scanner.wholeOffset(), scanner.wholeLine()));
+            return;
+        }
+        YamlDocumentNode root(doc, 0);
+        if (!root.isSequence())
+        {
+            result.addError("", "Expected sequence");
+            return;
+        }
+        NodeCursor cursor;
+        for (size_t i = 0, n = root.size(); i < n; ++i)
+            if (!readElement(root.at(i, cursor)))
+                return;
+    }
+};
+
+template <typename T, typename F>
+YamlSequenceStream<T, F> streamYamlSequence(F onElement)
+{
+    return YamlSequenceStream<T, F>(std::move(onElement));
+}
+
+// A top-level YAML mapping read into T one key at a time. Keys that are
+// not fields are listed and leave the result valid, as in reifyFromYaml.
+template <typename T>
+class YamlObjectStream
+{
+  public:
+    YamlObjectStream() : scanner(false) { value.emplace(); }
+
+    void feed(std::string_view chunk)
+    {
+        scanner.feed(chunk, [this](std::string_view text, size_t at, size_t line) { return readEntry(text, at, line); });
+    }
+
+    std::pair<std::optional<T>, ValidationResult> finish()
+    {
+        scanner.finish([this](std::string_view text, size_t at, size_t line) { return readEntry(text, at, line); });
+        if (scanner.whole())
+            readEntry(scanner.text(), scanner.wholeOffset(), scanner.wholeLine());
+        if (!FailFast::stop(result))
+            filler.checkRequired(result);
+
+        std::pair<std::optional<T>, ValidationResult> out;
+        out.second = std::move(result);
+        if (out.second.valid)
+            out.first = std::move(value);
+        return out;
+    }
+
+  private:
+    YamlItemScanner scanner;
+    YamlDocument doc;
+    StructFiller<T> filler;
+    std::optional<T> value;
+    ValidationResult result;
+
+    bool readEntry(std::string_view text, size_t at, size_t line)
+    {
+        try
+        {
+            doc.parse(text);
+        }
+        catch (const YAML::Exception& e)
+        {
+            result.addError("yaml", stream_detail::relocate(e, at, line));
+            return !FailFast::stop(result);
+        }
+        YamlDocumentNode root(doc, 0);
+        if (!root.isMap())
+            result.addError("", "Expected map for struct");
+        else
+            filler.read(*value, &root, result, true);
+        return !FailFast::stop(result);
+    }
+};
+
+} // namespace meta
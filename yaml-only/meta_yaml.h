@@ -488,22 +488,30 @@ inline YAML::Node to(const T &obj) {
 // PUBLIC API
 // ============================================================================
 
+// Reads into an existing object, reusing its containers. Keys absent from
+// the document leave their members as they were.
 template <typename T>
-inline std::pair<std::optional<T>, ValidationResult>
-fromYaml(const std::string &yaml) {
+inline ValidationResult fromYaml(T &obj, const std::string &yaml) {
   try {
     YAML::Node node = YAML::Load(yaml);
-    T obj{};
-    auto result = from(obj, Node(node));
-    return result.valid ? std::make_pair(std::optional(obj), result)
-                        : std::make_pair(std::nullopt, result);
+    return from(obj, Node(node));
   } catch (const std::exception &e) {
     ValidationResult result;
     result.addError("yaml", std::string(e.what()));
-    return {std::nullopt, result};
+    return result;
   }
 }
 
+// The object is built inside the returned optional, never copied
+template <typename T>
+inline std::pair<std::optional<T>, ValidationResult>
+fromYaml(const std::string &yaml) {
+  std::pair<std::optional<T>, ValidationResult> out;
+  out.second = fromYaml(out.first.emplace(), yaml);
+  if (!out.second.valid) out.first.reset();
+  return out;
+}
+
 template <typename T>
 inline std::string toYaml(const T &obj) {
   YAML::Emitter emitter;